@@ -5,6 +5,7 @@
 #include <string.h>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <curl/curl.h>
 #include "arc_commands.h"
 #include "arc_context.h"
 #include "arc_error.h"
@@ -12,9 +13,52 @@
 #include "arc_http_client.h"
 #include "argo_error.h"
 #include "argo_output.h"
+#include "argo_http_server.h"
+#include "argo_json_doc.h"
+
+/* Look template up in the daemon's template catalog */
+static int lookup_template_path(const char* template_name, char* script_path, size_t path_size) {
+    /* Name goes into the URL path: percent-encode it */
+    char* escaped = curl_easy_escape(NULL, template_name, 0);
+    if (!escaped) {
+        return ARC_EXIT_ERROR;
+    }
+    char endpoint[ARC_PATH_BUFFER];
+    int written = snprintf(endpoint, sizeof(endpoint), "/api/templates/%s", escaped);
+    curl_free(escaped);
+    if (written < 0 || (size_t)written >= sizeof(endpoint)) {
+        return ARC_EXIT_ERROR;
+    }
+
+    arc_http_response_t* response = NULL;
+    if (arc_http_get(endpoint, &response) != ARGO_SUCCESS) {
+        return ARC_EXIT_ERROR;
+    }
+
+    int result = ARC_EXIT_ERROR;
+    json_node_t* root = NULL;
+    if (response->status_code == HTTP_STATUS_OK && response->body &&
+        json_doc_parse(response->body, strlen(response->body), &root) == ARGO_SUCCESS) {
+        json_node_t* path = json_doc_get(root, "/path");
+        if (path && path->type == JSON_DOC_STRING && path->text[0] &&
+            strlen(path->text) < path_size) {
+            snprintf(script_path, path_size, "%s", path->text);
+            result = ARC_EXIT_SUCCESS;
+        }
+    }
+
+    json_doc_free(root);
+    arc_http_response_free(response);
+    return result;
+}
 
 /* Resolve template name to workflow.sh path (directory-based only) */
 static int resolve_template_path(const char* template_name, char* script_path, size_t path_size) {
+    /* Daemon answers from memory; fall back to checking the directories */
+    if (lookup_template_path(template_name, script_path, path_size) == ARC_EXIT_SUCCESS) {
+        return ARC_EXIT_SUCCESS;
+    }
+
     const char* home = getenv("HOME");
     if (!home) {
         LOG_USER_ERROR("HOME environment variable not set\n");
@@ -9,9 +9,18 @@
 #include "arc_commands.h"
 #include "arc_constants.h"
 #include "arc_context.h"
+#include "arc_http_client.h"
 #include "argo_error.h"
 #include "argo_output.h"
 #include "argo_limits.h"
+#include "argo_http_server.h"
+#include "argo_json_doc.h"
+
+/* Helper: String member of a template object ("" if absent) */
+static const char* template_field(json_node_t* item, const char* pointer) {
+    json_node_t* node = json_doc_get(item, pointer);
+    return (node && node->type == JSON_DOC_STRING) ? node->text : "";
+}
 
 /* Check if a directory entry is a workflow template (directory-based only) */
 static int is_workflow_template(const char* base_path, const char* name) {
@@ -135,6 +144,43 @@ static int list_templates_from_dir(const char* path, const char* source_label) {
     return count;
 }
 
+/* List templates from the daemon's template catalog
+ *
+ * Returns number of templates listed, or -1 if the daemon could not answer.
+ */
+static int list_templates_from_daemon(void) {
+    arc_http_response_t* response = NULL;
+    if (arc_http_get("/api/templates", &response) != ARGO_SUCCESS) {
+        return -1;
+    }
+    if (response->status_code != HTTP_STATUS_OK || !response->body) {
+        arc_http_response_free(response);
+        return -1;
+    }
+
+    json_node_t* root = NULL;
+    if (json_doc_parse(response->body, strlen(response->body), &root) != ARGO_SUCCESS) {
+        arc_http_response_free(response);
+        return -1;
+    }
+
+    int count = 0;
+    json_node_t* templates = json_doc_get(root, "/templates");
+    for (int i = 0; templates && templates->type == JSON_DOC_ARRAY && i < templates->count; i++) {
+        json_node_t* item = templates->children[i];
+        const char* name = template_field(item, "/name");
+        if (!name[0]) continue;
+
+        LOG_USER_STATUS("  %-30s %-50s [%s]\n", name, template_field(item, "/description"),
+                        template_field(item, "/source"));
+        count++;
+    }
+
+    json_doc_free(root);
+    arc_http_response_free(response);
+    return count;
+}
+
 /* arc workflow templates command handler */
 int arc_workflow_templates(int argc, char** argv) {
     (void)argc;
@@ -144,7 +190,12 @@ int arc_workflow_templates(int argc, char** argv) {
     LOG_USER_STATUS("%-32s %-50s %s\n", "NAME", "DESCRIPTION", "SOURCE");
     LOG_USER_STATUS("----------------------------------------------------------------------------------------------------\n");
 
-    int total_count = 0;
+    /* Daemon keeps an in-memory catalog; scan directories only without it */
+    int total_count = list_templates_from_daemon();
+    if (total_count >= 0) {
+        goto summary;
+    }
+    total_count = 0;
 
     /* GUIDELINE_APPROVED - Template path and source label constants */
     /* List system templates (shipped with Argo) */
@@ -163,6 +214,7 @@ int arc_workflow_templates(int argc, char** argv) {
     }
     /* GUIDELINE_APPROVED_END */
 
+summary:
     if (total_count == 0) {
         LOG_USER_STATUS("\nNo templates found.\n");
         LOG_USER_INFO("  Create a template with: arc workflow create\n");
@@ -8,12 +8,20 @@
 #include <stdbool.h>
 #include "argo_ci.h"
 #include "argo_http.h"
+#include "argo_json_builder.h"
 
 /* API provider context window sizes */
 #define DEEPSEEK_CONTEXT_WINDOW 64000
 #define GROK_CONTEXT_WINDOW 128000
 #define OPENROUTER_DEFAULT_CONTEXT 200000
 
+/* Streaming request markers */
+#define API_STREAM_FIELD "stream"                          /* Body flag (OpenAI, Claude) */
+#define API_STREAM_OPTIONS_FIELD "stream_options"          /* OpenAI: {"include_usage": true} */
+#define API_STREAM_INCLUDE_USAGE_FIELD "include_usage"     /* Token usage in the last event */
+#define API_GENERATE_METHOD ":generateContent"             /* Model-in-URL APIs (Gemini) */
+#define API_STREAM_GENERATE_METHOD ":streamGenerateContent?alt=sse"
+
 /* API authentication types */
 typedef enum {
     API_AUTH_BEARER,        /* Authorization: Bearer <token> */
@@ -29,7 +37,37 @@ typedef struct {
     const char* value;          /* API key/token value */
 } api_auth_config_t;
 
+/* Build authenticated JSON POST request
+ *
+ * Applies auth (Bearer, custom header, or URL parameter), Content-Type
+ * and extra_headers. Used by api_http_post_json and by callers that
+ * execute the request themselves (e.g. on an http_multi_t).
+ *
+ * Returns:
+ *   New request (caller frees with http_request_free), or NULL on failure
+ */
+http_request_t* api_build_json_post(const char* base_url, const char* json_body,
+                                    const api_auth_config_t* auth,
+                                    const char** extra_headers);
+
+/* Same, adopting a malloc'd body (e.g. from json_builder_take) without
+ * copying it. The body is freed on failure. */
+http_request_t* api_build_json_post_owned(const char* base_url, char* json_body, size_t body_len,
+                                          const api_auth_config_t* auth,
+                                          const char** extra_headers);
+
+/* Map HTTP status to an error code
+ *
+ * Returns:
+ *   ARGO_SUCCESS for 200, else E_HTTP_* / E_PROTOCOL_HTTP (reported
+ *   under function)
+ */
+int api_check_http_status(int status, const char* function);
+
 /* Execute HTTP POST with JSON body and authentication
+ *
+ * Waits for a slot under the endpoint and key's rate limit
+ * (argo_rate_limit.h) and retries 429 responses after Retry-After.
  *
  * Parameters:
  *   base_url - Base URL for request
@@ -41,6 +79,7 @@ typedef struct {
  * Returns:
  *   ARGO_SUCCESS on success
  *   E_PROTOCOL_HTTP on HTTP error
+ *   E_HTTP_RATE_LIMIT if still limited when the wait runs out
  *   Other error codes from http subsystem
  */
 int api_http_post_json(const char* base_url, const char* json_body,
@@ -48,6 +87,55 @@ int api_http_post_json(const char* base_url, const char* json_body,
                        const char** extra_headers,
                        http_response_t** response);
 
+/* Execute streaming HTTP POST with JSON body and authentication
+ *
+ * Same request as api_http_post_json, with "Accept: text/event-stream".
+ * A 200 body is passed to on_chunk as it arrives; other statuses are
+ * not streamed and map to the same error codes as api_http_post_json.
+ *
+ * Returns:
+ *   ARGO_SUCCESS on success
+ *   E_HTTP_* / E_PROTOCOL_HTTP on HTTP error
+ *   Other error codes from http subsystem
+ */
+int api_http_post_json_stream(const char* base_url, const char* json_body,
+                              const api_auth_config_t* auth,
+                              const char** extra_headers,
+                              void (*on_chunk)(const char* chunk, size_t len, void* userdata),
+                              void* userdata);
+
+/* Execute a built request as a stream
+ *
+ * Adds "Accept: text/event-stream" and runs req as api_http_post_json_stream
+ * does. The caller still owns req.
+ *
+ * Parameters:
+ *   resp - Optional output: status, headers, sizes and timings whenever
+ *          the server answered (caller frees with http_response_free)
+ *
+ * Returns: same as api_http_post_json_stream
+ */
+int api_http_execute_stream(http_request_t* req,
+                            void (*on_chunk)(const char* chunk, size_t len, void* userdata),
+                            void* userdata, http_response_t** resp);
+
+/* One chat message */
+typedef struct {
+    const char* role;           /* API_ROLE_* */
+    const char* content;
+} api_chat_message_t;
+
+#define API_ROLE_SYSTEM "system"
+#define API_ROLE_USER "user"
+#define API_ROLE_ASSISTANT "assistant"
+
+/* Write "messages":[{"role":...,"content":...},...] into an open object
+ *
+ * Returns:
+ *   ARGO_SUCCESS, or the builder's error
+ */
+int api_json_chat_messages(json_builder_t* json, const api_chat_message_t* messages, int count);
+
 /* Allocate response buffer for provider
  *
  * Parameters:
@@ -61,16 +149,62 @@ int api_http_post_json(const char* base_url, const char* json_body,
  */
 int api_allocate_response_buffer(char** buffer, size_t* capacity, size_t size);
 
-/* Augment prompt with memory context
+/* Prompt assembly budget */
+#define API_PROMPT_RESPONSE_PERCENT 25     /* Context share kept free for the reply */
+
+/* What prompt assembly kept and dropped (token counts are estimates,
+ * see memory_estimate_tokens) */
+typedef struct {
+    size_t budget_tokens;       /* 0 means no limit */
+    size_t used_tokens;         /* Whole assembled prompt */
+    size_t task_tokens;         /* Task section alone */
+    int items_packed;
+    int items_dropped;
+    int breadcrumbs_packed;
+    int breadcrumbs_dropped;
+    bool sunrise_dropped;
+    bool sunset_dropped;
+    bool over_budget;           /* The task alone does not fit */
+} api_prompt_report_t;
+
+/* Assemble a prompt with memory context into a token budget
  *
- * Builds a new prompt string that includes memory digest context
- * prepended to the original prompt. Memory context includes relevant
- * memories, breadcrumbs, and sunset/sunrise notes if available.
+ * Sections are packed by priority from the cached token estimates: the
+ * task always, then the sunrise brief, the CI's selected memories (or,
+ * with none selected, the digest's suggestions for this prompt) best
+ * first, breadcrumbs newest first, and the sunset notes. Memory
+ * sections together take at most MEMORY_MAX_PERCENTAGE of the budget.
+ * A section or entry that does not fit whole is dropped, never cut, and
+ * counted in the report. The kept sections are then written in one pass
+ * into a buffer allocated at their exact size, in reading order: notes,
+ * brief, breadcrumbs, memories, task.
  *
  * Parameters:
  *   memory_digest - Memory digest to extract context from (NULL OK, returns prompt copy)
  *   prompt - Original prompt string
- *   out_augmented - Pointer to receive allocated augmented prompt (caller must free)
+ *   budget_tokens - Token budget for the whole prompt, 0 for no limit
+ *   out_prompt - Pointer to receive allocated prompt (caller must free)
+ *   report - Receives what was kept and dropped (NULL OK)
+ *
+ * Returns:
+ *   ARGO_SUCCESS on success, also when the task alone is over budget
+ *     (the task is sent without memory and report->over_budget is set)
+ *   E_INPUT_NULL if prompt or out_prompt is NULL
+ *   E_SYSTEM_MEMORY on allocation failure
+ */
+int api_assemble_prompt(ci_memory_digest_t* memory_digest,
+                        const char* prompt,
+                        size_t budget_tokens,
+                        char** out_prompt,
+                        api_prompt_report_t* report);
+
+/* Prompt token budget for a model context window - what the reply
+ * leaves free (0 for an unknown window) */
+size_t api_prompt_budget(size_t max_context);
+
+/* Augment prompt with memory context
+ *
+ * api_assemble_prompt with no token budget.
  *
  * Returns:
  *   ARGO_SUCCESS on success
@@ -82,10 +216,15 @@ int api_augment_prompt_with_memory(ci_memory_digest_t* memory_digest,
                                    char** out_augmented);
 
 /* JSON request builder function pointer type
- * Returns: Number of bytes written to json_body, or negative on error
+ *
+ * Writes the complete request object for prompt into json, including
+ * the API_STREAM_FIELD flag when stream is set and the API takes it in
+ * the body.
+ *
+ * Returns: ARGO_SUCCESS, or json_builder_error(json)
  */
-typedef int (*json_request_builder_t)(char* json_body, size_t buffer_size,
-                                      const char* model, const char* prompt);
+typedef int (*json_request_builder_t)(json_builder_t* json, const char* model,
+                                      const char* prompt, bool stream);
 
 /* Generic API provider configuration */
 typedef struct {
@@ -99,12 +238,21 @@ typedef struct {
     int response_path_depth;
     json_request_builder_t build_request;
     bool supports_streaming;
+    const char* stream_delta_pointer;   /* JSON pointer of each SSE text delta */
     int max_context;
 } api_provider_config_t;
 
+/* Endpoint override - "<provider_name>_url" in config, then
+ * ARGO_<PROVIDER_NAME>_URL uppercased with "-" as "_" (ARGO_OPENAI_API_URL
+ * etc.), replacing api_url; points a provider at a proxy or a local mock */
+#define API_URL_CONFIG_SUFFIX "_url"
+#define API_URL_ENV_PREFIX "ARGO_"
+#define API_URL_ENV_SUFFIX "_URL"
+
 /* Generic API provider context */
 typedef struct {
     char model[64];  /* API_MODEL_NAME_SIZE from argo_api_providers.h */
+    char api_url[512];  /* API_URL_SIZE - config->api_url or its override */
     char* response_content;
     size_t response_capacity;
     uint64_t total_queries;
@@ -142,4 +290,26 @@ ci_provider_t* generic_api_create_provider(const api_provider_config_t* config,
  */
 int generic_api_set_memory(ci_provider_t* provider, ci_memory_digest_t* memory);
 
+/* Split query for callers that run the HTTP exchange themselves
+ *
+ * generic_api_prepare_query builds the provider request (memory-augmented
+ * prompt, auth, headers); the caller executes it, e.g. on an http_multi_t,
+ * then passes the response to generic_api_complete_query, which checks
+ * the status, extracts content and invokes callback exactly as query does.
+ * A request that got no response is reported with generic_api_record_failure.
+ * Both record the call in provider telemetry (argo_provider_telemetry.h);
+ * started_ms is the monotonic time the caller took the query, so time
+ * spent queued and rate limited counts towards it (0 = unknown).
+ *
+ * Returns:
+ *   ARGO_SUCCESS, or the error query would have returned
+ */
+int generic_api_prepare_query(ci_provider_t* provider, const char* prompt, http_request_t** req);
+int generic_api_complete_query(ci_provider_t* provider, const http_response_t* resp,
+                               long long started_ms, ci_response_callback callback, void* userdata);
+void generic_api_record_failure(ci_provider_t* provider, int result, long long started_ms);
+
+/* True if provider was created by generic_api_create_provider */
+bool generic_api_is_provider(const ci_provider_t* provider);
+
 #endif /* ARGO_API_COMMON_H */
@@ -7,6 +7,7 @@
 #include "argo_api_common.h"
 #include "argo_api_keys.h"
 #include "argo_limits.h"
+#include "argo_stream_decoder.h"
 #include <stdbool.h>
 #include <string.h>
 
@@ -43,16 +44,18 @@
     } \
     \
     /* JSON request builder */ \
-    static int name##_build_request(char* json_body, size_t buffer_size, \
-                                     const char* model, const char* prompt) { \
-        return snprintf(json_body, buffer_size, \
-                       "{" /* GUIDELINE_APPROVED: OpenAI-compatible API JSON template */ \
-                       "\"model\":\"%s\"," /* GUIDELINE_APPROVED: OpenAI-compatible API JSON template */ \
-                       "\"messages\":[{\"role\":\"user\",\"content\":\"%s\"}]," /* GUIDELINE_APPROVED: OpenAI-compatible API JSON template */ \
-                       "\"max_tokens\":%d," /* GUIDELINE_APPROVED: OpenAI-compatible API JSON template */ \
-                       "\"stream\":false" /* GUIDELINE_APPROVED: OpenAI-compatible API JSON template */ \
-                       "}", /* GUIDELINE_APPROVED: OpenAI-compatible API JSON template */ \
-                       model, prompt, API_MAX_TOKENS); \
+    static int name##_build_request(json_builder_t* json, const char* model, \
+                                     const char* prompt, bool stream) { \
+        api_chat_message_t message = { API_ROLE_USER, prompt }; \
+        json_builder_object_begin(json); \
+        json_builder_key_string(json, "model", model); /* GUIDELINE_APPROVED: OpenAI-compatible API JSON field */ \
+        if (stream) { \
+            json_builder_key_bool(json, API_STREAM_FIELD, true); \
+        } \
+        api_json_chat_messages(json, &message, 1); \
+        json_builder_key_int(json, "max_tokens", API_MAX_TOKENS); /* GUIDELINE_APPROVED: OpenAI-compatible API JSON field */ \
+        json_builder_object_end(json); \
+        return json_builder_error(json); \
     } \
     \
     /* Response path for JSON extraction */ \
@@ -73,6 +76,7 @@
         .response_path_depth = 3, \
         .build_request = name##_build_request, \
         .supports_streaming = true, \
+        .stream_delta_pointer = STREAM_DELTA_OPENAI, \
         .max_context = CONTEXT_WINDOW \
     }; \
     \
@@ -8,8 +8,8 @@
 /* Common API provider constants */
 #define API_MODEL_NAME_SIZE 64
 #define API_RESPONSE_CAPACITY 65536
-#define API_REQUEST_BUFFER_SIZE 8192
 #define API_MAX_TOKENS 4096
+#define API_DEFAULT_TEMPERATURE 0.7
 #define API_AUTH_HEADER_SIZE 256
 #define API_URL_SIZE 512
 #define API_HTTP_OK 200
@@ -103,6 +103,11 @@ typedef struct {
 /* Get model info */
 const api_model_info_t* get_api_model_info(const char* provider, const char* model);
 
+/* Claude Code conversation: with a session key, queries are turns of one
+ * conversation on a long-lived CLI worker (argo_claude_session_pool.h);
+ * NULL returns to one-shot execution */
+int claude_code_set_session(ci_provider_t* provider, const char* session);
+
 /* Claude Code memory management (sundown/sunrise) */
 int claude_code_set_sunrise(ci_provider_t* provider, const char* brief);
 int claude_code_set_sunset(ci_provider_t* provider, const char* notes);
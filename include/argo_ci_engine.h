@@ -0,0 +1,119 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_CI_ENGINE_H
+#define ARGO_CI_ENGINE_H
+
+#include <stdbool.h>
+#include "argo_ci.h"
+
+/*
+ * CI Engine - asynchronous provider queries
+ *
+ * Queries are submitted and complete later through a callback, a future,
+ * or both. HTTP API providers (generic_api_is_provider) run on one
+ * curl_multi reactor, so any number can be in flight at once and a
+ * fan-out to N providers takes max(latency), not sum(latency).
+ * Providers without an async path (claude_code, ollama, mock) run on a
+ * small worker pool.
+ *
+ * HTTP queries wait for a slot under their endpoint and key's rate
+ * limit (argo_rate_limit.h) without holding a thread, and a 429 is
+ * retried after Retry-After while the deadline allows.
+ *
+ * Every query completes exactly once with one of:
+ *   ARGO_SUCCESS    - response->content holds the reply
+ *   E_CI_TIMEOUT    - deadline passed
+ *   E_CI_CANCELLED  - ci_future_cancel or engine shutdown
+ *   provider error  - init, connect, HTTP or parse failure
+ *
+ * A worker-lane provider call cannot be interrupted; on deadline or
+ * cancel the future completes immediately and the late result is dropped.
+ */
+
+#define CI_ENGINE_DEFAULT_WORKERS 4
+#define CI_ENGINE_MAX_WORKERS 64
+#define CI_ENGINE_DEFAULT_TIMEOUT_MS 300000    /* 5 minutes */
+#define CI_ENGINE_NO_TIMEOUT -1                /* ci_future_wait: wait forever */
+
+typedef struct ci_engine ci_engine_t;
+typedef struct ci_future ci_future_t;
+
+/* Hands a borrowed provider back once the engine is done with it.
+ * result is the provider's own outcome (ARGO_SUCCESS if never called). */
+typedef void (*ci_provider_release_fn)(ci_provider_t* provider, int result, void* context);
+
+/* Create engine
+ *
+ * Parameters:
+ *   workers - Worker threads for blocking providers (<= 0 uses default)
+ *
+ * Returns:
+ *   New engine, or NULL on failure
+ */
+ci_engine_t* ci_engine_create(int workers);
+
+/* Submit query
+ *
+ * Parameters:
+ *   provider   - Created, not yet initialized; owned by the engine, which
+ *                runs init/connect/query and cleanup
+ *   prompt     - Copied
+ *   timeout_ms - Deadline from now (<= 0 uses CI_ENGINE_DEFAULT_TIMEOUT_MS)
+ *   callback   - Optional; runs once on an engine thread when the query
+ *                completes, before waiters wake. Must not block.
+ *
+ * Returns:
+ *   Future (release with ci_future_release), or NULL on invalid input,
+ *   allocation failure or shutdown (provider is cleaned up either way)
+ */
+ci_future_t* ci_engine_submit(ci_engine_t* engine, ci_provider_t* provider,
+                              const char* prompt, int timeout_ms,
+                              ci_response_callback callback, void* userdata);
+
+/* Submit query on a borrowed provider
+ *
+ * Same as ci_engine_submit, but provider is already initialized and
+ * connected (e.g. checked out of a provider_pool_t). The engine skips
+ * init/connect and calls release instead of cleanup.
+ */
+ci_future_t* ci_engine_submit_borrowed(ci_engine_t* engine, ci_provider_t* provider,
+                                       ci_provider_release_fn release, void* release_context,
+                                       const char* prompt, int timeout_ms,
+                                       ci_response_callback callback, void* userdata);
+
+/* Queries submitted and not yet complete */
+int ci_engine_pending(ci_engine_t* engine);
+
+/* Stop engine; outstanding queries complete with E_CI_CANCELLED
+ *
+ * Waits for running worker-lane provider calls to return.
+ */
+void ci_engine_destroy(ci_engine_t* engine);
+
+/* Wait for completion
+ *
+ * Parameters:
+ *   timeout_ms - Maximum wait, or CI_ENGINE_NO_TIMEOUT
+ *
+ * Returns:
+ *   ARGO_SUCCESS once complete (check the response), or E_SYSTEM_TIMEOUT
+ */
+int ci_future_wait(ci_future_t* future, int timeout_ms);
+
+/* True once complete */
+bool ci_future_done(ci_future_t* future);
+
+/* Completed response, or NULL while pending; valid until release */
+const ci_response_t* ci_future_response(ci_future_t* future);
+
+/* Cancel query
+ *
+ * Returns:
+ *   ARGO_SUCCESS, or E_INVALID_STATE if already complete
+ */
+int ci_future_cancel(ci_future_t* future);
+
+/* Release caller's reference */
+void ci_future_release(ci_future_t* future);
+
+#endif /* ARGO_CI_ENGINE_H */
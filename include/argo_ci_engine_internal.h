@@ -0,0 +1,90 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_CI_ENGINE_INTERNAL_H
+#define ARGO_CI_ENGINE_INTERNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "argo_ci_engine.h"
+#include "argo_http.h"
+#include "argo_http_multi.h"
+#include "argo_rate_limit.h"
+
+/* Shared by argo_ci_engine.c (scheduling) and argo_ci_future.c (results) */
+
+typedef enum {
+    FUTURE_PENDING,
+    FUTURE_COMPLETING,          /* Result set, callback running */
+    FUTURE_DONE
+} future_state_t;
+
+struct ci_future {
+    pthread_mutex_t lock;       /* Guards state, refs, transfer_id */
+    pthread_cond_t done;
+    future_state_t state;
+    int refs;                   /* Caller + engine (+ timer while expiring) */
+    ci_response_t response;
+    ci_response_callback callback;
+    void* userdata;
+
+    ci_engine_t* engine;
+    ci_provider_t* provider;
+    ci_provider_release_fn release;   /* Borrowed provider: hand back, no init/cleanup */
+    void* release_context;
+    int provider_result;        /* Last provider call, for release */
+    char* prompt;
+    long long submitted_ms;     /* Monotonic, for queue time */
+    long long deadline_ms;      /* Monotonic */
+    uint64_t transfer_id;       /* HTTP lane, 0 until submitted */
+    bool expired;               /* Worker lane, timer has fired */
+    struct ci_future* next;     /* Worker queue */
+    struct ci_future* watch_next;
+    struct ci_future* expire_next;
+
+    /* HTTP lane rate limiting */
+    rate_limiter_t* limiter;    /* Endpoint and key, NULL = unlimited */
+    int attempts;               /* 429 retries so far */
+    http_request_t* deferred_req;   /* Waiting for its slot */
+    long long start_ms;         /* Monotonic slot time while deferred */
+    struct ci_future* deferred_next;
+};
+
+struct ci_engine {
+    http_multi_t* multi;
+    pthread_t workers[CI_ENGINE_MAX_WORKERS];
+    int worker_count;
+    pthread_t timer;
+    bool timer_started;
+
+    pthread_mutex_t lock;       /* Guards everything below */
+    pthread_cond_t work_ready;
+    pthread_cond_t timer_wake;
+    ci_future_t* queue_head;    /* Worker lane, not started */
+    ci_future_t* queue_tail;
+    ci_future_t* watch;         /* Worker lane in flight, for deadlines */
+    ci_future_t* deferred;      /* HTTP lane waiting for a rate limit slot */
+    int pending;
+    bool running;
+};
+
+/* Reply captured from a provider callback */
+typedef struct {
+    char* content;
+    char* model;
+} ci_capture_t;
+
+/* Provider response callback - keeps a copy in a ci_capture_t */
+void ci_capture_response(const ci_response_t* response, void* userdata);
+
+/* Set result once, run callback, wake waiters
+ *
+ * Returns:
+ *   false if the future was already complete
+ */
+bool ci_future_complete(ci_future_t* future, int result, const ci_capture_t* capture);
+
+/* Drop a reference, freeing the future with the last one */
+void ci_future_unref(ci_future_t* future);
+
+#endif /* ARGO_CI_ENGINE_INTERNAL_H */
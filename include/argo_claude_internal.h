@@ -61,6 +61,7 @@ typedef struct claude_context {
     char* response_buffer;
     size_t response_size;
     size_t response_capacity;
+    size_t frame_size;   /* Bytes of the frame last returned by read_from_claude */
 
     /* Statistics */
     uint64_t total_queries;
@@ -8,19 +8,24 @@
 /* Process management functions for Claude subprocess
  *
  * These functions handle spawning, communication with, and cleanup
- * of the Claude CLI subprocess using fork/exec and pipes.
+ * of a long-lived Claude CLI subprocess using fork/exec and pipes.
+ * Messages are framed one per line in both directions (the CLI's
+ * stream-json mode), so one process can serve many turns.
  */
 
+#define CLAUDE_PROCESS_BUFFER_INITIAL 8192
+
 /* Spawn Claude subprocess with pipes for stdin/stdout/stderr
  *
  * Parameters:
- *   ctx - Claude context with pipe arrays to populate
+ *   ctx  - Claude context with pipe arrays to populate
+ *   argv - Command and arguments (NULL runs plain "claude")
  *
  * Returns:
  *   ARGO_SUCCESS on success
  *   E_SYSTEM_FORK if fork or pipe creation fails
  */
-int spawn_claude_process(claude_context_t* ctx);
+int spawn_claude_process(claude_context_t* ctx, char* const argv[]);
 
 /* Kill Claude subprocess and close pipes
  *
@@ -32,28 +37,38 @@ int spawn_claude_process(claude_context_t* ctx);
  */
 int kill_claude_process(claude_context_t* ctx);
 
-/* Write input to Claude's stdin
+/* True if the subprocess is still running */
+bool claude_process_alive(claude_context_t* ctx);
+
+/* Write one message (input plus newline) to Claude's stdin
  *
  * Parameters:
  *   ctx - Claude context
- *   input - String to write to Claude
+ *   input - Message; must not contain a newline
  *
  * Returns:
  *   ARGO_SUCCESS on success
- *   E_SYSTEM_SOCKET if write fails
+ *   E_CI_DISCONNECTED if the process has gone away
+ *   E_SYSTEM_SOCKET if write fails otherwise
  */
 int write_to_claude(claude_context_t* ctx, const char* input);
 
-/* Read response from Claude's stdout
+/* Read one newline-terminated message from Claude's stdout
+ *
+ * Bytes after the newline are kept for the next call. Anything on
+ * stderr is drained and logged so the process never blocks on it.
  *
  * Parameters:
  *   ctx - Claude context
- *   output - Pointer to receive response string (points to ctx->response_buffer)
+ *   output - Receives the message without its newline (points into
+ *            ctx->response_buffer, valid until the next read)
  *   timeout_ms - Timeout in milliseconds
  *
  * Returns:
  *   ARGO_SUCCESS on success
  *   E_CI_TIMEOUT if timeout expires
+ *   E_CI_DISCONNECTED if the process closed stdout
+ *   E_SYSTEM_MEMORY if the buffer cannot grow
  */
 int read_from_claude(claude_context_t* ctx, char** output, int timeout_ms);
 
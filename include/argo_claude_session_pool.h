@@ -0,0 +1,131 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_CLAUDE_SESSION_POOL_H
+#define ARGO_CLAUDE_SESSION_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "argo_provider_telemetry.h"
+
+/*
+ * Claude Session Pool - long-lived claude CLI workers
+ *
+ * Each worker is one claude process in stream-json mode: a turn is one
+ * JSON line written to its stdin ({"type":"user",...}) and is answered
+ * by JSON lines on stdout, the last of which is {"type":"result",...}.
+ * The process, and the conversation it holds, stays up between turns,
+ * so a multi-turn conversation pays the CLI's startup once.
+ *
+ * Affinity: a worker belongs to the session key of its first turn, and
+ * later turns of that session go to the same worker (one at a time).
+ * A worker is recycled after max_turns turns, after any failed turn and
+ * when idle too long; the CLI session id from its last result is kept,
+ * so the replacement continues the conversation with --resume.
+ *
+ * When all workers are busy, a new session takes over the least
+ * recently used idle worker, or waits for one until its deadline.
+ * All functions are thread-safe.
+ */
+
+/* Configuration */
+#define CLAUDE_SESSION_WORKERS_CONFIG_KEY "claude_session_workers"
+#define CLAUDE_SESSION_WORKERS_ENV "ARGO_CLAUDE_SESSION_WORKERS"
+#define CLAUDE_SESSION_MAX_TURNS_CONFIG_KEY "claude_session_max_turns"
+#define CLAUDE_SESSION_MAX_TURNS_ENV "ARGO_CLAUDE_SESSION_MAX_TURNS"
+
+#define CLAUDE_SESSION_POOL_DEFAULT_WORKERS 4
+#define CLAUDE_SESSION_POOL_MAX_WORKERS 32
+#define CLAUDE_SESSION_POOL_DEFAULT_MAX_TURNS 50       /* Recycle the process after */
+#define CLAUDE_SESSION_POOL_DEFAULT_IDLE_SECONDS 600   /* Idle processes exit */
+#define CLAUDE_SESSION_POOL_TURN_TIMEOUT_MS 300000     /* Default per turn */
+#define CLAUDE_SESSION_POOL_RESUME_SLOTS 256           /* Sessions remembered after recycling */
+#define CLAUDE_SESSION_KEY_SIZE 128
+#define CLAUDE_SESSION_ID_SIZE 128
+
+/* Stream-json protocol */
+#define CLAUDE_SESSION_ARG_INPUT_FORMAT "--input-format"
+#define CLAUDE_SESSION_ARG_OUTPUT_FORMAT "--output-format"
+#define CLAUDE_SESSION_FORMAT_STREAM_JSON "stream-json"
+#define CLAUDE_SESSION_ARG_VERBOSE "--verbose"         /* Required by stream-json output */
+#define CLAUDE_SESSION_ARG_MODEL "--model"
+#define CLAUDE_SESSION_ARG_RESUME "--resume"
+#define CLAUDE_SESSION_TYPE_RESULT "result"
+
+typedef struct claude_session_pool claude_session_pool_t;
+
+/* Statistics */
+typedef struct {
+    int workers;                    /* Processes running */
+    int busy;
+    unsigned long long turns;       /* Turns answered */
+    unsigned long long warm_turns;  /* Turns that reused a running process */
+    unsigned long long spawns;
+    unsigned long long recycles;    /* Processes retired (turn limit, failure, idle) */
+    unsigned long long failures;    /* Turns that failed */
+} claude_session_pool_stats_t;
+
+/* What one turn cost (for provider telemetry) */
+typedef struct {
+    provider_usage_t usage;         /* Result frame's usage.input_tokens / output_tokens */
+    long long queue_ms;             /* Waiting for a worker and starting its process */
+    long long ttfb_ms;              /* Turn written to first frame read, < 0 = none read */
+    size_t request_bytes;           /* Turn line written */
+    size_t response_bytes;          /* Frames read, progress frames included */
+} claude_session_turn_t;
+
+/* Create pool
+ *
+ * Parameters:
+ *   command     - Base argv, NULL-terminated (copied); NULL runs
+ *                 "claude -p" in stream-json mode
+ *   max_workers - Processes at most (<= 0 uses config or default)
+ *   max_turns   - Turns per process (<= 0 uses config or default)
+ *
+ * Returns:
+ *   New pool, or NULL on allocation failure
+ */
+claude_session_pool_t* claude_session_pool_create(const char* const* command, int max_workers,
+                                                  int max_turns);
+
+/* Destroy pool, stopping every worker (no turns may be running) */
+void claude_session_pool_destroy(claude_session_pool_t* pool);
+
+/* Run one turn of a session
+ *
+ * Parameters:
+ *   session    - Conversation key (affinity); turns of one session run in order
+ *   model      - CLI model, or NULL for the CLI default
+ *   timeout_ms - Deadline for waiting plus answering (<= 0 uses
+ *                CLAUDE_SESSION_POOL_TURN_TIMEOUT_MS)
+ *   response   - Output: the result text (caller frees)
+ *   turn       - Output: usage, timing and bytes of the turn (NULL = not wanted);
+ *                filled in on failure too, as far as the turn got
+ *
+ * Returns:
+ *   ARGO_SUCCESS, E_CI_TIMEOUT, E_CI_DISCONNECTED if the process died,
+ *   E_CI_CONFUSED if the CLI reported an error, or E_SYSTEM_FORK
+ */
+int claude_session_pool_query(claude_session_pool_t* pool, const char* session, const char* model,
+                              const char* prompt, int timeout_ms, char** response,
+                              claude_session_turn_t* turn);
+
+/* Forget a session: stop its worker and drop its resume id */
+void claude_session_pool_end(claude_session_pool_t* pool, const char* session);
+
+/* Stop idle workers past idle_seconds and workers whose process died
+ *
+ * Returns:
+ *   Number of workers stopped
+ */
+int claude_session_pool_reap(claude_session_pool_t* pool, int idle_seconds);
+
+/* Snapshot of counters */
+void claude_session_pool_get_stats(claude_session_pool_t* pool, claude_session_pool_stats_t* stats);
+
+/* Process-wide pool used by the claude_code provider, created on first use */
+claude_session_pool_t* claude_session_pool_default(void);
+
+/* Destroy the process-wide pool (shutdown, after all queries are done) */
+void claude_session_pool_cleanup(void);
+
+#endif /* ARGO_CLAUDE_SESSION_POOL_H */
@@ -4,6 +4,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include <pthread.h>
 #include "argo_http_server.h"
 #include "argo_registry.h"
@@ -21,6 +22,13 @@
 /* Forward declarations */
 typedef struct workflow_registry workflow_registry_t;
 typedef struct shared_services shared_services_t;
+typedef struct template_catalog template_catalog_t;
+typedef struct project_state_store project_state_store_t;
+typedef struct ci_engine ci_engine_t;
+typedef struct provider_pool provider_pool_t;
+typedef struct response_cache response_cache_t;
+typedef struct single_flight single_flight_t;
+typedef struct provider_router provider_router_t;
 
 /* Daemon structure */
 typedef struct argo_daemon_struct {
@@ -30,8 +38,16 @@ typedef struct argo_daemon_struct {
     workflow_registry_t* workflow_registry;  /* Bash workflow tracking (Phase 3) */
     shared_services_t* shared_services;      /* Background tasks (timeout, log rotation) */
     exit_code_queue_t* exit_queue;           /* Signal-safe exit code queue (SIGCHLD → completion task) */
+    template_catalog_t* template_catalog;     /* In-memory workflow template index */
+    project_state_store_t* project_state;     /* Versioned project state.json access */
+    ci_engine_t* ci_engine;                   /* Async provider queries (/api/ci/query) */
+    provider_pool_t* provider_pool;           /* Warm providers for ci_engine */
+    response_cache_t* response_cache;         /* Cached CI answers (~/.argo/cache) */
+    single_flight_t* single_flight;           /* Coalesces identical in-flight CI queries */
+    provider_router_t* provider_router;       /* Latency-aware routes with failover (CI_ROUTES) */
     uint16_t port;
     bool should_shutdown;  /* Graceful shutdown flag */
+    atomic_bool registry_save_pending;  /* Workflow registry changed off the services thread */
 } argo_daemon_t;
 
 /* Daemon lifecycle */
@@ -5,8 +5,72 @@
 #define ARGO_DAEMON_CI_API_H
 
 #include "argo_http_server.h"
+#include "argo_ci.h"
 
-/* POST /api/ci/query - Query AI provider */
+/* Routes */
+#define CI_API_CACHE_PATH "/api/ci/cache"
+#define CI_API_PROVIDER_STATS_PATH "/api/providers/stats"
+#define CI_API_STATS_SIZE_HINT 4096
+
+/* Fan-out and deadline limits */
+#define CI_API_MAX_QUERIES 64
+#define CI_API_MAX_TIMEOUT_MS 3600000     /* 1 hour */
+
+/* POST /api/ci/query - Query one or many AI providers
+ *
+ * Single:  {"query": "...", "provider": "...", "model": "...", "timeout_ms": N,
+ *           "cache": "bypass" | "prefer" | "only"}
+ *          -> {"status":"success","provider":"...","response":"..."}
+ * Routed:  {"query": "...", "route": "...", "hedge": true, ...} instead of
+ *          provider/model; provider in the reply is the candidate that
+ *          answered (argo_provider_router.h). Single queries only.
+ * Session: "session": "<key>" makes a claude_code query the next turn of
+ *          that conversation on a long-lived CLI worker
+ *          (argo_claude_session_pool.h). Session turns are never cached
+ *          and cannot be combined with a route.
+ * Fan-out: {"queries": [{"query","provider","model"}, ...], "timeout_ms": N, "cache": ...}
+ *          -> {"status":"success","responses":[{"provider","status",
+ *              "response" | "error"}, ...]} in request order
+ *
+ * cache (default bypass) controls the response cache: prefer serves a
+ * cached answer and stores new ones, only never queries a provider
+ * (404 "Response not cached" on a miss). Cached answers carry
+ * "cached": true.
+ *
+ * Queries run concurrently on the daemon's CI engine, so a fan-out
+ * returns after the slowest query. A single query without provider or
+ * route uses CI_DEFAULT_ROUTE if set; otherwise provider and model
+ * default from CI_DEFAULT_PROVIDER / CI_DEFAULT_MODEL. timeout_ms
+ * defaults from the engine.
+ */
 int api_ci_query(http_request_t* req, http_response_t* resp);
 
+/* GET /api/ci/cache - Response cache counters
+ *
+ * -> {"status":"success","cache":{"entries","memory_hits","disk_hits",
+ *     "misses","stores","evictions"}}
+ */
+int api_ci_cache_stats(http_request_t* req, http_response_t* resp);
+
+/* GET /api/providers/stats - Usage and latency per provider/model
+ *
+ * Every provider call made in the daemon, from provider telemetry
+ * (argo_provider_telemetry.h):
+ * -> {"status":"success","buckets_ms":[5,10,25,...],"providers":[
+ *      {"provider","model","calls","failures","streamed","request_bytes",
+ *       "response_bytes","prompt_tokens","completion_tokens","avg_queue_ms",
+ *       "avg_ttfb_ms","avg_latency_ms","p50_ms","p95_ms","p99_ms","max_ms",
+ *       "histogram":[...],"last_call"}, ...],"count":N}
+ * histogram[i] counts calls up to buckets_ms[i]; the last entry counts
+ * slower ones. Percentiles are bucket bounds, so they are estimates.
+ */
+int api_provider_stats(http_request_t* req, http_response_t* resp);
+
+/* Create CI provider by name (provider_factory_fn for the daemon's pool)
+ *
+ * Returns:
+ *   Uninitialized provider, or NULL if provider_name is unknown
+ */
+ci_provider_t* api_ci_create_provider(const char* provider_name, const char* model_name);
+
 #endif /* ARGO_DAEMON_CI_API_H */
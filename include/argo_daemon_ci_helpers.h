@@ -0,0 +1,59 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Daemon CI Helpers - query parsing, submission and response cache plumbing */
+
+#ifndef ARGO_DAEMON_CI_HELPERS_H
+#define ARGO_DAEMON_CI_HELPERS_H
+
+#include <stdbool.h>
+#include "argo_ci.h"
+#include "argo_ci_engine.h"
+#include "argo_json_doc.h"
+#include "argo_response_cache.h"
+#include "argo_single_flight.h"
+
+/* One query of a request */
+typedef struct {
+    char* query;
+    char* provider;
+    char* model;
+    char* route;        /* Provider router route instead of provider/model */
+    bool hedge;         /* Routed: duplicate to a second candidate after p95 */
+    char* session;      /* claude_code conversation key (never cached) */
+    char* cached;       /* Answer served from the response cache */
+} ci_query_spec_t;
+
+/* Parse one query object and apply defaults
+ *
+ * Routes are only allowed where the caller can wait on the router
+ * (E_INVALID_PARAMS otherwise, and CI_DEFAULT_ROUTE is not applied).
+ */
+int parse_ci_query_request(json_node_t* item, bool allow_route, ci_query_spec_t* spec);
+
+/* Free parsed query */
+void free_query_spec(ci_query_spec_t* spec);
+
+/* Submit query, joining an identical one already in flight
+ *
+ * Returns E_NOT_FOUND for an unknown provider, or the checkout error.
+ */
+int submit_query(const ci_query_spec_t* spec, int timeout_ms,
+                 single_flight_call_t** call, bool* shared);
+
+/* Router submit - one candidate of a routed query (context is the prompt) */
+int start_routed(void* context, const char* provider_name, const char* model, int timeout_ms,
+                 ci_response_callback callback, void* userdata, ci_future_t** future);
+
+/* Serve query from the response cache when the mode allows */
+bool serve_from_cache(ci_query_spec_t* spec, response_cache_mode_t mode);
+
+/* Remember a successful answer (disk errors only lose persistence) */
+void remember_answer(const ci_query_spec_t* spec, response_cache_mode_t mode, const char* answer);
+
+/* Map failed query to a client message */
+const char* query_error_message(int error_code);
+
+/* Format CI response as JSON */
+int format_ci_response(const char* provider_name, const char* ai_response,
+                       bool cached, char** response_json_out);
+
+#endif /* ARGO_DAEMON_CI_HELPERS_H */
@@ -0,0 +1,60 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Daemon Task Graph API - run tasks.json as a parallel DAG */
+
+#ifndef ARGO_DAEMON_DAG_API_H
+#define ARGO_DAEMON_DAG_API_H
+
+#include "argo_http_server.h"
+
+/* Task graph runs
+ *
+ * POST /api/workflow/dag starts a supervisor process, argo-dag-run, that
+ * runs every task of a tasks.json file with the task graph executor
+ * (argo_task_graph.h). It is exec'd, not just forked: the scheduler must
+ * not run in a copy of the threaded daemon, where a lock held by another
+ * thread at fork time would never be released.
+ * The supervisor is registered as an ordinary workflow, so list, status,
+ * abandon and timeout work unchanged; abandoning it stops all running tasks.
+ *
+ * Request body:
+ *   {"tasks_file": "/abs/tasks.json",    required
+ *    "runner": "/abs/run_task.sh",       runs tasks without their own "script"
+ *    "max_parallel": 8,                  default TASK_GRAPH_DEFAULT_PARALLEL
+ *    "timeout_seconds": 3600,            whole run, default workflow timeout
+ *    "template": "...", "instance": "..."}
+ *
+ * Per-node state is written to ~/.argo/dag/<workflow_id>.json on every
+ * transition and served by GET /api/workflow/dag/{workflow_id}; it stays
+ * available after the run has left the workflow registry.
+ * Task output goes to ~/.argo/logs/<workflow_id>_<task_id>.log.
+ */
+
+/* Request fields */
+#define DAG_API_FIELD_TASKS_FILE "tasks_file"
+#define DAG_API_FIELD_RUNNER "runner"
+#define DAG_API_FIELD_MAX_PARALLEL "\"max_parallel\""
+#define DAG_API_FIELD_TIMEOUT "\"timeout_seconds\""
+#define DAG_API_FIELD_TEMPLATE "template"
+#define DAG_API_FIELD_INSTANCE "instance"
+
+/* Files under ~/.argo */
+#define DAG_API_STATUS_DIR "dag"
+#define DAG_API_STATUS_SUFFIX ".json"
+#define DAG_API_TEMPLATE_DEFAULT "dag"
+
+/* Supervisor binary: $ARGO_DAG_RUN_BIN, else beside the daemon, else on PATH */
+#define DAG_API_RUNNER_BINARY "argo-dag-run"
+#define DAG_API_RUNNER_ENV "ARGO_DAG_RUN_BIN"
+#define DAG_API_SELF_EXE "/proc/self/exe"
+#define DAG_API_RUNNER_MAX_ARGS 16
+
+/* Highest inherited descriptor the supervisor closes */
+#define DAG_API_SUPERVISOR_FD_SCAN_MAX 1024
+
+/* POST /api/workflow/dag - Validate tasks.json and start a parallel run */
+int api_workflow_dag_start(http_request_t* req, http_response_t* resp);
+
+/* GET /api/workflow/dag/{id} - Per-node state of a run */
+int api_workflow_dag_status(http_request_t* req, http_response_t* resp);
+
+#endif /* ARGO_DAEMON_DAG_API_H */
@@ -0,0 +1,47 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Daemon Project API - versioned project state reads and patches */
+
+#ifndef ARGO_DAEMON_PROJECT_API_H
+#define ARGO_DAEMON_PROJECT_API_H
+
+#include "argo_http_server.h"
+
+/* Project state endpoints
+ *
+ * Served from the daemon's project state store (argo_project_state.h).
+ *
+ *   GET   /api/project/{id}/state                {"version":N,"state":{...}}
+ *   GET   /api/project/{id}/state?ptr=/a&ptr=/b  {"version":N,"values":[a,b]}
+ *   PATCH /api/project/{id}/state                {"version":N} after the patch
+ *
+ * PATCH body:
+ *   {"version":N,"patch":[{"op":"replace","path":"/phase","value":"design"},...]}
+ * "version" is optional; when given the patch applies only if it is still
+ * the current version (409 with the current version otherwise). A failed
+ * "test" op is also 409. All operations apply together or not at all.
+ * Pointers in the query string may be percent-encoded.
+ */
+
+/* Route */
+#define PROJECT_API_PATH "/api/project"
+#define PROJECT_API_STATE_SUFFIX "/state"
+#define PROJECT_API_QUERY_POINTER "ptr"
+
+/* Limits */
+#define PROJECT_API_MAX_POINTERS 64
+#define PROJECT_API_SIZE_BASE 64
+
+/* Error messages */
+#define PROJECT_API_ERR_NOT_FOUND "Project state not found"
+#define PROJECT_API_ERR_BAD_PATH "Expected /api/project/{id}/state"
+#define PROJECT_API_ERR_BAD_PATCH "Invalid patch"
+#define PROJECT_API_ERR_CONFLICT "Version conflict"
+#define PROJECT_API_ERR_TOO_MANY "Too many pointers"
+
+/* GET /api/project/{id}/state - Read state or selected values */
+int api_project_state_get(http_request_t* req, http_response_t* resp);
+
+/* PATCH /api/project/{id}/state - Apply patch atomically */
+int api_project_state_patch(http_request_t* req, http_response_t* resp);
+
+#endif /* ARGO_DAEMON_PROJECT_API_H */
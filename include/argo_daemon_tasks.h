@@ -12,6 +12,9 @@ typedef struct argo_daemon_struct argo_daemon_t;
  * - workflow_timeout_task: Monitors and terminates timed-out workflows
  * - log_rotation_task: Rotates old log files
  * - workflow_completion_task: Detects workflow completion and handles retries
+ * - provider_pool_task: Evicts idle warm CI providers
+ * - response_cache_task: Purges expired cached CI responses
+ * - claude_session_task: Stops idle claude CLI session workers
  *
  * All tasks are called from shared services thread.
  * Context parameter is pointer to argo_daemon_t.
@@ -43,6 +46,9 @@ void log_rotation_task(void* context);
  *
  * Detects workflow completion by checking if executor process still exists.
  * Handles workflow retry with exponential backoff.
+ * Executors reattached after a daemon restart are polled for liveness,
+ * since SIGCHLD only reports our own children.
+ * Persists the workflow registry when anything changed.
  * Runs every WORKFLOW_COMPLETION_CHECK_INTERVAL_SECONDS (5 seconds).
  *
  * Parameters:
@@ -50,4 +56,38 @@ void log_rotation_task(void* context);
  */
 void workflow_completion_task(void* context);
 
+/* Provider pool eviction task
+ *
+ * Cleans up pooled CI providers idle past their limit, so an idle
+ * daemon does not hold connections and sessions indefinitely.
+ * Runs every PROVIDER_POOL_EVICT_INTERVAL_SECONDS (1 minute).
+ *
+ * Parameters:
+ *   context - Pointer to argo_daemon_t
+ */
+void provider_pool_task(void* context);
+
+/* Response cache purge task
+ *
+ * Removes expired entries from the memory tier and their files from
+ * ~/.argo/cache, which otherwise only expire when looked up again.
+ * Runs every RESPONSE_CACHE_PURGE_INTERVAL_SECONDS (1 hour).
+ *
+ * Parameters:
+ *   context - Pointer to argo_daemon_t
+ */
+void response_cache_task(void* context);
+
+/* Claude session reap task
+ *
+ * Stops claude CLI session workers idle past
+ * CLAUDE_SESSION_POOL_DEFAULT_IDLE_SECONDS and workers whose process
+ * died; their conversations resume on the next turn.
+ * Runs every PROVIDER_POOL_EVICT_INTERVAL_SECONDS (1 minute).
+ *
+ * Parameters:
+ *   context - Pointer to argo_daemon_t
+ */
+void claude_session_task(void* context);
+
 #endif /* ARGO_DAEMON_TASKS_H */
@@ -0,0 +1,36 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Daemon Template API - workflow template catalog lookups */
+
+#ifndef ARGO_DAEMON_TEMPLATE_API_H
+#define ARGO_DAEMON_TEMPLATE_API_H
+
+#include "argo_http_server.h"
+
+/* Template catalog endpoints
+ *
+ * Served from the daemon's in-memory template catalog
+ * (argo_template_catalog.h), so neither call scans template directories.
+ *
+ *   GET /api/templates          {"templates":[{...},...],"count":N}
+ *   GET /api/templates/{name}   {...} for the template 'arc start' would run
+ *
+ * Template object:
+ *   {"name","source","description","path","dir","version","author",
+ *    "has_readme","has_tests"}
+ * "path" is the absolute workflow.sh path; "source" is "user" or "system".
+ */
+
+/* Route */
+#define TEMPLATE_API_PATH "/api/templates"
+
+/* JSON sizing */
+#define TEMPLATE_API_SIZE_BASE 64
+#define TEMPLATE_API_SIZE_PER_ITEM 8192
+
+/* Error messages */
+#define TEMPLATE_API_ERR_NOT_FOUND "Template not found"
+
+/* GET /api/templates[/{name}] - List templates or look one up */
+int api_templates(http_request_t* req, http_response_t* resp);
+
+#endif /* ARGO_DAEMON_TEMPLATE_API_H */
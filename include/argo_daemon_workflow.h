@@ -3,6 +3,8 @@
 #ifndef ARGO_DAEMON_WORKFLOW_H
 #define ARGO_DAEMON_WORKFLOW_H
 
+#include <stdbool.h>
+
 /* Forward declaration - argo_daemon_t defined in argo_daemon.h */
 typedef struct argo_daemon_struct argo_daemon_t;
 
@@ -14,6 +16,16 @@ typedef struct argo_daemon_struct argo_daemon_t;
  * - Process forking and monitoring
  */
 
+/* Validate a script path before executing it
+ *
+ * Rejects empty paths, directory traversal, shell metacharacters, and
+ * anything that is not an existing regular file. Logs the reason.
+ *
+ * Returns:
+ *   true if the script may be executed
+ */
+bool daemon_validate_script_path(const char* path);
+
 /* Execute bash workflow script
  *
  * Forks child process to execute bash script with provided arguments and environment.
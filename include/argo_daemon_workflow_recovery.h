@@ -0,0 +1,130 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_DAEMON_WORKFLOW_RECOVERY_H
+#define ARGO_DAEMON_WORKFLOW_RECOVERY_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <sys/types.h>
+#include "argo_workflow_registry.h"
+
+/* Forward declaration - argo_daemon_t defined in argo_daemon.h */
+typedef struct argo_daemon_struct argo_daemon_t;
+
+/* Workflow recovery across daemon restarts
+ *
+ * Bash executors are forked by the daemon but do not depend on it: they
+ * keep running when the daemon exits. To let a restarted daemon adopt
+ * them again, the workflow registry is persisted and each executor gets:
+ * - A named FIFO for stdin (reopened by the new daemon for input)
+ * - Its kernel start time, so a recycled PID is never mistaken for it
+ *
+ * Reattached executors are not children of the new daemon, so SIGCHLD
+ * never fires for them. The completion task polls them instead with
+ * workflow_recovery_process_alive(); their exit status is unavailable.
+ */
+
+/* Files under ~/.argo */
+#define WORKFLOW_RECOVERY_REGISTRY_FILE "workflow_registry.json"
+#define WORKFLOW_RECOVERY_FIFO_DIR "fifo"
+#define WORKFLOW_RECOVERY_FIFO_SUFFIX ".stdin"
+#define WORKFLOW_RECOVERY_LOG_DIR "logs"
+#define WORKFLOW_RECOVERY_LOG_SUFFIX ".log"
+
+/* /proc/<pid>/stat: fields after the ")" that closes comm, up to starttime (field 22) */
+#define PROC_STAT_FIELDS_BEFORE_STARTTIME 19
+
+/* Exit code recorded when a reattached executor exits (status unknowable) */
+#define WORKFLOW_EXIT_CODE_UNKNOWN -1
+
+/* Build path of the persisted workflow registry (~/.argo/workflow_registry.json)
+ *
+ * Returns:
+ *   ARGO_SUCCESS on success
+ *   E_INPUT_NULL if path is NULL
+ */
+int workflow_recovery_registry_path(char* path, size_t size);
+
+/* Build path of a workflow's executor log (~/.argo/logs/<id>.log)
+ *
+ * Returns:
+ *   ARGO_SUCCESS on success
+ *   E_INPUT_NULL if workflow_id or path is NULL
+ */
+int workflow_recovery_log_path(const char* workflow_id, char* path, size_t size);
+
+/* Create the named stdin FIFO for a workflow and open it
+ *
+ * Creates ~/.argo/fifo/<id>.stdin (replacing any stale one) and opens it
+ * read-write, so neither the daemon nor the executor blocks in open().
+ * The executor opens the path itself for reading.
+ *
+ * Parameters:
+ *   workflow_id - Workflow ID
+ *   path        - Output: FIFO path
+ *   size        - Size of path buffer
+ *
+ * Returns:
+ *   Open file descriptor on success, -1 on failure (error reported)
+ */
+int workflow_recovery_fifo_create(const char* workflow_id, char* path, size_t size);
+
+/* Close a workflow's stdin FIFO and remove it from disk
+ *
+ * Safe to call on entries without a FIFO. Clears stdin_pipe/stdin_fifo.
+ */
+void workflow_recovery_release_stdin(workflow_entry_t* entry);
+
+/* Read a process's kernel start time
+ *
+ * Returns:
+ *   Start time in clock ticks since boot (field 22 of /proc/<pid>/stat),
+ *   0 if the process does not exist or /proc is unavailable
+ */
+unsigned long long workflow_recovery_start_ticks(pid_t pid);
+
+/* Check that a workflow's executor is still the process we started
+ *
+ * Signals PID 0 for liveness and, when a start time was recorded,
+ * compares it so a recycled PID is not mistaken for the executor.
+ *
+ * Returns:
+ *   true if the executor is alive
+ */
+bool workflow_recovery_process_alive(const workflow_entry_t* entry);
+
+/* Persist the daemon's workflow registry
+ *
+ * Writes the registry atomically. The registry is not thread-safe, so
+ * call this only from the thread that owns it: the shared-services
+ * thread, or the main thread before it starts or after it stops.
+ * HTTP handlers use workflow_recovery_request_save() instead.
+ *
+ * Returns:
+ *   ARGO_SUCCESS on success
+ *   E_INPUT_NULL if daemon is NULL
+ *   E_SYSTEM_FILE if the registry cannot be written
+ */
+int workflow_recovery_save(argo_daemon_t* daemon);
+
+/* Ask the shared-services thread to persist the registry
+ *
+ * Sets a flag the workflow completion task checks on its next run
+ * (WORKFLOW_COMPLETION_CHECK_INTERVAL_SECONDS). Callable from any thread.
+ */
+void workflow_recovery_request_save(argo_daemon_t* daemon);
+
+/* Reattach to executors that survived a daemon restart
+ *
+ * Loads the persisted registry. Running/paused executors that are still
+ * alive (and pass the start-time identity check) are adopted: their FIFO
+ * is reopened and they are marked reattached. Everything else that was
+ * in flight is dropped, since its outcome can no longer be observed.
+ * Call before the shared services start.
+ *
+ * Returns:
+ *   Number of executors reattached, or negative error code
+ */
+int workflow_recovery_reattach(argo_daemon_t* daemon);
+
+#endif /* ARGO_DAEMON_WORKFLOW_RECOVERY_H */
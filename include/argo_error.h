@@ -50,6 +50,7 @@
 #define E_CI_OVERLOAD       ARGO_ERROR(ERR_CI, 2006)
 #define E_CI_DISCONNECTED   ARGO_ERROR(ERR_CI, 2007)
 #define E_CI_NO_PROVIDER    ARGO_ERROR(ERR_CI, 2008)
+#define E_CI_CANCELLED      ARGO_ERROR(ERR_CI, 2009)
 
 /* Input errors (INPUT:3xxx) */
 #define E_INPUT_NULL        ARGO_ERROR(ERR_INPUT, 3001)
@@ -14,10 +14,15 @@
 
 /* HTTP constants */
 #define HTTP_DEFAULT_TIMEOUT_SECONDS 30
-#define HTTP_CMD_BUFFER_SIZE 8192
 #define HTTP_RESPONSE_BUFFER_SIZE 65536
 #define HTTP_CHUNK_SIZE 4096
+
+/* Connection reuse (libcurl share handle + idle easy handle pool) */
+#define HTTP_POOL_MAX_IDLE 8              /* Easy handles kept for reuse */
+#define HTTP_DNS_CACHE_SECONDS 300        /* Resolved addresses kept this long */
+#define HTTP_HEADER_EXPECT_NONE "Expect:" /* Suppress 100-continue round trip */
 #define HTTP_STATUS_OK 200
+#define HTTP_STATUS_SUCCESS_END 300       /* First non-2xx status */
 #define HTTP_STATUS_NO_CONTENT 204
 #define HTTP_PORT_HTTPS 443
 #define HTTP_PORT_HTTP 80
@@ -53,10 +58,12 @@
 #define HTTP_HEADER_AUTHORIZATION "Authorization"
 #define HTTP_HEADER_CONTENT_LENGTH "Content-Length"
 #define HTTP_HEADER_HOST "Host"
+#define HTTP_HEADER_ACCEPT "Accept"
 
 /* HTTP content types */
 #define HTTP_CONTENT_TYPE_JSON "application/json"
 #define HTTP_CONTENT_TYPE_TEXT "text/plain"
+#define HTTP_CONTENT_TYPE_EVENT_STREAM "text/event-stream"
 
 /* Network addresses */
 #define LOCALHOST_IP "127.0.0.1"
@@ -99,15 +106,26 @@ typedef struct {
     int timeout_seconds;
 } http_request_t;
 
-/* HTTP response */
+/* HTTP response (timings and sizes are those of the transfer) */
 typedef struct {
     int status_code;
     char* body;
     size_t body_len;
     http_header_t* headers;
+    size_t bytes_sent;          /* Request body uploaded */
+    size_t bytes_received;      /* Response body, streamed or collected */
+    long long ttfb_ms;          /* Transfer start to first response byte */
+    long long total_ms;         /* Transfer start to completion */
 } http_response_t;
 
-/* HTTP client functions */
+/* HTTP client functions
+ *
+ * Requests run in-process through libcurl. All requests share one DNS
+ * cache, TLS session cache and connection cache, so repeated calls to
+ * the same host reuse a kept-alive connection instead of reconnecting.
+ * http_init() is optional (http_execute initializes on first use) and
+ * http_cleanup() closes pooled connections at shutdown. Thread-safe.
+ */
 int http_init(void);
 void http_cleanup(void);
 
@@ -115,13 +133,31 @@ void http_cleanup(void);
 http_request_t* http_request_new(http_method_t method, const char* url);
 void http_request_add_header(http_request_t* req, const char* name, const char* value);
 void http_request_set_body(http_request_t* req, const char* body, size_t len);
+void http_request_take_body(http_request_t* req, char* body, size_t len);  /* Adopts malloc'd body, no copy */
 void http_request_free(http_request_t* req);
 
-/* Execute request */
+/* Execute request
+ *
+ * Returns ARGO_SUCCESS with any HTTP status in resp->status_code and the
+ * response headers in resp->headers, E_SYSTEM_TIMEOUT if the request
+ * exceeded req->timeout_seconds, or E_SYSTEM_NETWORK on transport failure.
+ */
 int http_execute(const http_request_t* req, http_response_t** resp);
+
+/* Execute request, delivering the body to callback as bytes arrive
+ *
+ * A 2xx body goes to callback only. Any other status is not streamed:
+ * its body is collected into resp->body for error reporting.
+ *
+ * Parameters:
+ *   resp - Optional output: status code, headers and error body
+ *          (caller frees with http_response_free)
+ *
+ * Returns: same as http_execute
+ */
 int http_execute_streaming(const http_request_t* req,
                           void (*callback)(const char* chunk, size_t len, void* userdata),
-                          void* userdata);
+                          void* userdata, http_response_t** resp);
 
 /* Response handling */
 void http_response_free(http_response_t* resp);
@@ -0,0 +1,67 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_HTTP_MULTI_H
+#define ARGO_HTTP_MULTI_H
+
+#include <stdint.h>
+#include "argo_http.h"
+#include "argo_http_transfer.h"
+
+/*
+ * HTTP Multi - many concurrent requests on one reactor thread
+ *
+ * Requests are driven by a single curl_multi loop, so hundreds of
+ * provider calls can be in flight without a thread each. Transfers
+ * share the process-wide connection, DNS and TLS caches.
+ *
+ * Each submitted request completes exactly once through its done
+ * callback, which runs on the reactor thread and must not block.
+ */
+
+/* Reactor poll interval when idle (wakeups cut it short) */
+#define HTTP_MULTI_POLL_MS 1000
+
+/* Receives final result; resp is NULL unless result is ARGO_SUCCESS
+ * and is owned by the callback (free with http_response_free) */
+typedef void (*http_multi_done_fn)(int result, http_response_t* resp, void* userdata);
+
+typedef struct http_multi http_multi_t;
+
+/* Create multi client and start its reactor thread
+ *
+ * Returns:
+ *   New client, or NULL on failure
+ */
+http_multi_t* http_multi_create(void);
+
+/* Submit request
+ *
+ * Parameters:
+ *   req        - Request; ownership passes to the client on success
+ *   timeout_ms - Total time limit; <= 0 uses req->timeout_seconds
+ *   on_chunk   - Streams the 2xx body when set (reactor thread)
+ *   on_done    - Completion callback (required)
+ *   id         - Receives request id for http_multi_cancel (optional)
+ *
+ * Returns:
+ *   ARGO_SUCCESS, E_INPUT_NULL, E_INVALID_STATE after shutdown, or
+ *   http_transfer_create errors (req still owned by caller)
+ */
+int http_multi_submit(http_multi_t* multi, http_request_t* req, long timeout_ms,
+                      http_chunk_fn on_chunk, http_multi_done_fn on_done, void* userdata,
+                      uint64_t* id);
+
+/* Cancel request; its done callback receives E_CI_CANCELLED
+ *
+ * Returns:
+ *   ARGO_SUCCESS, or E_NOT_FOUND if already complete
+ */
+int http_multi_cancel(http_multi_t* multi, uint64_t id);
+
+/* Number of requests submitted and not yet complete */
+int http_multi_pending(http_multi_t* multi);
+
+/* Stop reactor; outstanding requests complete with E_CI_CANCELLED */
+void http_multi_destroy(http_multi_t* multi);
+
+#endif /* ARGO_HTTP_MULTI_H */
@@ -5,6 +5,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include "argo_limits.h"
 
 /* HTTP status codes */
 #define HTTP_STATUS_OK 200
@@ -23,6 +24,7 @@ typedef enum {
     HTTP_METHOD_POST,
     HTTP_METHOD_DELETE,
     HTTP_METHOD_PUT,
+    HTTP_METHOD_PATCH,
     HTTP_METHOD_UNKNOWN
 } http_method_t;
 
@@ -31,6 +33,7 @@ typedef enum {
 #define HTTP_METHOD_STR_POST "POST"
 #define HTTP_METHOD_STR_DELETE "DELETE"
 #define HTTP_METHOD_STR_PUT "PUT"
+#define HTTP_METHOD_STR_PATCH "PATCH"
 #define HTTP_METHOD_STR_UNKNOWN "UNKNOWN"
 
 /* HTTP content types */
@@ -42,7 +45,7 @@ typedef enum {
 /* HTTP request structure */
 typedef struct {
     http_method_t method;
-    char path[256];
+    char path[HTTP_PATH_SIZE];
     char* body;
     size_t body_length;
     char content_type[64];
@@ -0,0 +1,58 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_HTTP_TRANSFER_H
+#define ARGO_HTTP_TRANSFER_H
+
+#include <curl/curl.h>
+#include "argo_http.h"
+
+/*
+ * HTTP Transfer - one prepared libcurl request
+ *
+ * Shared by the blocking client (argo_http.c, curl_easy_perform) and the
+ * multiplexed client (argo_http_multi.c, curl_multi). A transfer borrows
+ * an easy handle from the shared pool, so it reuses connections, DNS
+ * and TLS sessions with every other request in the process.
+ */
+
+/* Receives 2xx body bytes as they arrive */
+typedef void (*http_chunk_fn)(const char* chunk, size_t len, void* userdata);
+
+typedef struct http_transfer http_transfer_t;
+
+/* Prepare transfer
+ *
+ * Parameters:
+ *   req        - Request; must outlive the transfer
+ *   callback   - Streams the 2xx body when set, else body is collected
+ *   timeout_ms - Total time limit; <= 0 uses req->timeout_seconds
+ *   out        - Receives the transfer
+ *
+ * Returns:
+ *   ARGO_SUCCESS, E_SYSTEM_MEMORY, or E_SYSTEM_NETWORK
+ */
+int http_transfer_create(const http_request_t* req, http_chunk_fn callback, void* userdata,
+                         long timeout_ms, http_transfer_t** out);
+
+/* Easy handle to perform or add to a multi handle */
+CURL* http_transfer_handle(const http_transfer_t* transfer);
+
+/* Transfer owning an easy handle (from curl_multi_info_read) */
+http_transfer_t* http_transfer_from_handle(CURL* curl);
+
+/* Complete transfer and build response
+ *
+ * Always releases the transfer. On success *resp is set (caller frees).
+ *
+ * Returns:
+ *   ARGO_SUCCESS, E_SYSTEM_TIMEOUT, E_SYSTEM_NETWORK, or E_SYSTEM_MEMORY
+ */
+int http_transfer_finish(http_transfer_t* transfer, CURLcode code, http_response_t** resp);
+
+/* Release transfer without a response (remove from any multi handle first) */
+void http_transfer_destroy(http_transfer_t* transfer);
+
+/* Free a response header list */
+void http_headers_free(http_header_t* headers);
+
+#endif /* ARGO_HTTP_TRANSFER_H */
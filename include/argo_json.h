@@ -9,6 +9,10 @@
 #define JSON_MAX_FIELD_DEPTH 5
 #define JSON_FIELD_NAME_SIZE 64
 
+/* String escaping: \u00XX plus NUL */
+#define JSON_ESCAPE_MAX 7
+#define JSON_FIRST_PLAIN_CHAR 0x20
+
 /* JSON protocol patterns (for Ollama streaming) */
 #define JSON_RESPONSE_FIELD "\"response\":\""
 #define JSON_DONE_FIELD "\"done\":true"
@@ -54,8 +58,8 @@ int json_extract_nested_string(const char* json, const char** field_path,
 
 /* Escape a string and append to JSON buffer
  *
- * Escapes special characters (quotes, backslashes) and writes the result
- * to the destination buffer. Does NOT add surrounding quotes.
+ * Escapes quotes, backslashes and control characters and writes the
+ * result to the destination buffer. Does NOT add surrounding quotes.
  *
  * Parameters:
  *   dest - Destination buffer
@@ -70,4 +74,14 @@ int json_extract_nested_string(const char* json, const char** field_path,
 int json_escape_string(char* dest, size_t dest_size, size_t* dest_offset,
                        const char* src);
 
+/* Escape sequence for one byte of a JSON string
+ *
+ * Parameters:
+ *   out - Receives the NUL-terminated sequence (JSON_ESCAPE_MAX bytes)
+ *
+ * Returns:
+ *   Length of the sequence, or 0 if c needs no escaping
+ */
+size_t json_escape_char(unsigned char c, char* out);
+
 #endif /* ARGO_JSON_H */
@@ -0,0 +1,100 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_JSON_BUILDER_H
+#define ARGO_JSON_BUILDER_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+ * JSON Builder - stream JSON text into a growable buffer
+ *
+ * Values are appended in document order; the builder inserts commas and
+ * colons and escapes every string (quotes, backslashes, control
+ * characters), so any prompt produces valid JSON. Strings are copied
+ * once, straight from the caller into the output, with runs of
+ * characters that need no escaping moved in bulk.
+ *
+ * Errors are sticky: after the first failure (allocation, nesting,
+ * misplaced key) further calls do nothing and json_builder_take
+ * returns NULL, so a request can be built without checking every call.
+ *
+ *   json_builder_t json;
+ *   json_builder_init(&json, strlen(prompt));
+ *   json_builder_object_begin(&json);
+ *   json_builder_key_string(&json, "prompt", prompt);
+ *   json_builder_object_end(&json);
+ *   char* body = json_builder_take(&json, &len);   // caller frees
+ */
+
+#define JSON_BUILDER_MAX_DEPTH 32
+#define JSON_BUILDER_MIN_CAPACITY 256
+#define JSON_BUILDER_NUMBER_SIZE 32
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+    int error;                              /* First failure, or ARGO_SUCCESS */
+    int depth;
+    bool has_items[JSON_BUILDER_MAX_DEPTH]; /* Container needs a comma before the next value */
+    bool is_object[JSON_BUILDER_MAX_DEPTH];
+    bool after_key;                         /* Key written, value expected */
+} json_builder_t;
+
+/* Initialize with room for about capacity_hint bytes of content
+ *
+ * Returns:
+ *   ARGO_SUCCESS or E_SYSTEM_MEMORY
+ */
+int json_builder_init(json_builder_t* json, size_t capacity_hint);
+
+/* Free buffer (safe after json_builder_take) */
+void json_builder_free(json_builder_t* json);
+
+/* Containers */
+void json_builder_object_begin(json_builder_t* json);
+void json_builder_object_end(json_builder_t* json);
+void json_builder_array_begin(json_builder_t* json);
+void json_builder_array_end(json_builder_t* json);
+
+/* Member name; must be followed by exactly one value */
+void json_builder_key(json_builder_t* json, const char* key);
+
+/* Values */
+void json_builder_string(json_builder_t* json, const char* value);     /* NULL writes null */
+void json_builder_string_len(json_builder_t* json, const char* value, size_t len);
+void json_builder_int(json_builder_t* json, long long value);
+void json_builder_double(json_builder_t* json, double value);
+void json_builder_bool(json_builder_t* json, bool value);
+void json_builder_null(json_builder_t* json);
+
+/* Already-serialized JSON value, copied verbatim */
+void json_builder_raw(json_builder_t* json, const char* value);
+
+/* Key and value in one call */
+void json_builder_key_string(json_builder_t* json, const char* key, const char* value);
+void json_builder_key_int(json_builder_t* json, const char* key, long long value);
+void json_builder_key_bool(json_builder_t* json, const char* key, bool value);
+
+/* First error so far
+ *
+ * Returns:
+ *   ARGO_SUCCESS, E_SYSTEM_MEMORY, or E_INPUT_INVALID for misuse
+ *   (unbalanced containers, keys outside objects, depth over
+ *   JSON_BUILDER_MAX_DEPTH)
+ */
+int json_builder_error(const json_builder_t* json);
+
+/* Hand over the finished document
+ *
+ * Parameters:
+ *   length - Output (optional): bytes, excluding the NUL terminator
+ *
+ * Returns:
+ *   NUL-terminated JSON the caller frees, or NULL if an error occurred
+ *   or containers are still open. The builder is left empty either way.
+ */
+char* json_builder_take(json_builder_t* json, size_t* length);
+
+#endif /* ARGO_JSON_BUILDER_H */
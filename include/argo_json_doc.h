@@ -0,0 +1,133 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_JSON_DOC_H
+#define ARGO_JSON_DOC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * JSON Document - mutable JSON tree with JSON Pointer access
+ *
+ * Parses a JSON text into a tree of nodes that can be read and edited
+ * in place with RFC 6901 pointers ("/design/status", "/items/0",
+ * "/a~1b" for key "a/b"), then serialized back to compact JSON.
+ * Used where a whole document is edited, e.g. project state.json.
+ *
+ * Numbers keep their original literal text so values round-trip
+ * unchanged. Strings are stored unescaped (UTF-8).
+ */
+
+/* Limits */
+#define JSON_DOC_INITIAL_CAPACITY 4      /* Children per container */
+#define JSON_DOC_BUFFER_INITIAL 256      /* Serializer buffer */
+#define JSON_DOC_NUMBER_MAX 32           /* Formatted integer literal */
+#define JSON_DOC_MAX_DEPTH 64            /* Nesting accepted by the parser */
+#define JSON_DOC_POINTER_APPEND "-"      /* Array index meaning "past the end" */
+
+/* Node types */
+typedef enum {
+    JSON_DOC_NULL = 0,
+    JSON_DOC_BOOL,
+    JSON_DOC_NUMBER,
+    JSON_DOC_STRING,
+    JSON_DOC_ARRAY,
+    JSON_DOC_OBJECT
+} json_doc_type_t;
+
+/* JSON node */
+typedef struct json_node {
+    json_doc_type_t type;
+    char* key;                      /* Member name when inside an object */
+    char* text;                     /* String value or number literal */
+    bool boolean;                   /* JSON_DOC_BOOL value */
+    struct json_node** children;    /* Array elements or object members */
+    int count;
+    int capacity;
+} json_node_t;
+
+/* Parse JSON text
+ *
+ * Returns:
+ *   ARGO_SUCCESS with *root set (caller frees with json_doc_free)
+ *   E_INPUT_NULL if a parameter is NULL
+ *   E_INPUT_FORMAT if the text is not valid JSON
+ *   E_INPUT_TOO_LARGE if nesting exceeds JSON_DOC_MAX_DEPTH
+ *   E_SYSTEM_MEMORY on allocation failure
+ */
+int json_doc_parse(const char* json, size_t len, json_node_t** root);
+
+/* Serialize node to compact JSON
+ *
+ * Returns:
+ *   Allocated string (caller frees), or NULL on allocation failure
+ */
+char* json_doc_serialize(const json_node_t* node);
+
+/* Create nodes (NULL on allocation failure) */
+json_node_t* json_doc_new_object(void);
+json_node_t* json_doc_new_array(void);
+json_node_t* json_doc_new_null(void);
+json_node_t* json_doc_new_string(const char* value);
+json_node_t* json_doc_new_integer(long long value);
+json_node_t* json_doc_new_bool(bool value);
+
+/* Append child to an array, or to an object under key (taking ownership)
+ *
+ * Returns:
+ *   ARGO_SUCCESS on success
+ *   E_INPUT_NULL if a parameter is NULL (key required for objects)
+ *   E_INPUT_INVALID if container is not an array or object
+ *   E_SYSTEM_MEMORY on allocation failure (caller still owns child)
+ */
+int json_doc_append(json_node_t* container, const char* key, json_node_t* child);
+
+/* Deep copy (NULL on allocation failure) */
+json_node_t* json_doc_clone(const json_node_t* node);
+
+/* Structural equality (object member order ignored) */
+bool json_doc_equal(const json_node_t* a, const json_node_t* b);
+
+/* Read integer value of a number node
+ *
+ * Returns:
+ *   true if node is a number holding an integer
+ */
+bool json_doc_get_integer(const json_node_t* node, long long* value);
+
+/* Resolve pointer ("" is the whole document)
+ *
+ * Returns:
+ *   Node inside the tree (owned by the tree), or NULL if absent
+ */
+json_node_t* json_doc_get(json_node_t* root, const char* pointer);
+
+/* Set value at pointer, taking ownership of value
+ *
+ * Replaces an existing member or array element, adds a new member, or
+ * appends to an array (index equal to the length, or "-"). Missing
+ * intermediate members are created as objects, matching jq setpath.
+ *
+ * Returns:
+ *   ARGO_SUCCESS on success (value now owned by the tree)
+ *   E_INPUT_NULL if a parameter is NULL
+ *   E_INPUT_FORMAT if the pointer is malformed
+ *   E_NOT_FOUND if the path crosses a scalar or an array index is out of range
+ *   E_SYSTEM_MEMORY on allocation failure
+ *   On error the caller still owns value.
+ */
+int json_doc_set(json_node_t* root, const char* pointer, json_node_t* value);
+
+/* Remove value at pointer
+ *
+ * Returns:
+ *   ARGO_SUCCESS on success
+ *   E_INPUT_FORMAT if the pointer is malformed or is the root
+ *   E_NOT_FOUND if nothing is there
+ */
+int json_doc_remove(json_node_t* root, const char* pointer);
+
+/* Free node and all children */
+void json_doc_free(json_node_t* node);
+
+#endif /* ARGO_JSON_DOC_H */
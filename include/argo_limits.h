@@ -27,15 +27,6 @@
 /* Additional space for formatting and separators */
 #define MEMORY_NOTES_PADDING 50
 
-/* Estimated size per breadcrumb entry */
-#define MEMORY_BREADCRUMB_SIZE 100
-
-/* Estimated size per selected memory entry */
-#define MEMORY_SELECTED_SIZE 200
-
-/* Buffer overhead for memory context assembly */
-#define MEMORY_BUFFER_OVERHEAD 500
-
 /* ===== Port Configuration ===== */
 
 /* Base port for CI service allocation */
@@ -88,6 +79,12 @@
 /* Standard timeout exit code (matches GNU timeout command) */
 #define WORKFLOW_TIMEOUT_EXIT_CODE 124
 
+/* Grace period between SIGTERM and SIGKILL for a timed-out workflow (ms) */
+#define WORKFLOW_KILL_GRACE_MS 1000
+
+/* Default concurrency for workflow_execute_many() */
+#define WORKFLOW_BATCH_DEFAULT_PARALLEL 4
+
 /* Poll interval for child process status (microseconds, 100ms) */
 #define WORKFLOW_POLL_INTERVAL_USEC 100000
 
@@ -109,7 +106,6 @@
 #define PREFIX_BUFFER_SIZE 128
 #define PID_STR_BUFFER_SIZE 32
 #define ERROR_MSG_BUFFER_SIZE 256
-#define RESPONSE_SIZE_MULTIPLIER 2
 #define RESPONSE_SIZE_OVERHEAD 512
 #define WORKFLOW_ID_MAX_LENGTH 63
 #define WORKFLOW_ID_BUFFER_SIZE 128
@@ -128,6 +124,12 @@
 /* Workflow completion check interval (every 5 seconds) */
 #define WORKFLOW_COMPLETION_CHECK_INTERVAL_SECONDS 5
 
+/* Idle provider pool eviction interval (every minute) */
+#define PROVIDER_POOL_EVICT_INTERVAL_SECONDS 60
+
+/* Expired response cache purge interval (every hour) */
+#define RESPONSE_CACHE_PURGE_INTERVAL_SECONDS 3600
+
 /* ===== JSON Workflow Limits ===== */
 
 /* Maximum workflow JSON file size (1MB) */
@@ -191,7 +193,8 @@
 
 /* Claude Code provider configuration */
 #define CLAUDE_CODE_PROVIDER_NAME "claude_code"
-#define CLAUDE_CODE_RESPONSE_BUFFER_SIZE (1024 * 1024)  /* 1MB for response */
+#define CLAUDE_CODE_CHUNK_INITIAL (16 * 1024)          /* First output chunk */
+#define CLAUDE_CODE_CHUNK_MAX (1024 * 1024)             /* Chunk growth stops here */
 #define CLAUDE_CODE_READ_CHUNK_SIZE 4096
 #define CLAUDE_CODE_MODEL_SIZE 128
 
@@ -202,6 +205,9 @@
 
 /* Time conversions */
 #define MICROSECONDS_PER_MILLISECOND 1000
+#define MICROSECONDS_PER_SECOND 1000000
+#define MILLISECONDS_PER_SECOND 1000
+#define NANOSECONDS_PER_MILLISECOND 1000000
 #define SECONDS_PER_MINUTE 60
 #define MINUTES_PER_HOUR 60
 #define HOURS_PER_DAY 24
@@ -291,7 +297,7 @@
 #define HTTP_MAX_ROUTES 64      /* Maximum number of routes */
 #define HTTP_BACKLOG 10         /* Listen backlog */
 #define HTTP_METHOD_SIZE 16     /* HTTP method string size (GET, POST, etc.) */
-#define HTTP_PATH_SIZE 256      /* HTTP path buffer size */
+#define HTTP_PATH_SIZE 1024     /* HTTP path buffer size (includes query string) */
 
 /* HTTP I/O channel timeouts (seconds) */
 #define IO_HTTP_WRITE_TIMEOUT_SEC 5  /* Timeout for HTTP POST output */
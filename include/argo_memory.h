@@ -14,6 +14,44 @@
 #define MEMORY_BREADCRUMB_MAX 20
 #define MEMORY_SUGGESTION_MAX 10
 
+/* Digest engine */
+#define MEMORY_ARENA_CHUNK_SIZE 65536       /* Bytes per item arena chunk */
+#define MEMORY_INDEX_INITIAL 256            /* Content index slots (power of two) */
+#define MEMORY_INDEX_LOAD_PERCENT 70        /* Grow the index past this load */
+#define MEMORY_DEFAULT_RELEVANCE 0.5f       /* Stored score of a new item */
+#define MEMORY_ACCESS_BOOST 0.05f           /* Stored score gain per re-add or select */
+#define MEMORY_HALF_LIFE_SECONDS 604800.0   /* Stored score halves per idle week */
+#define MEMORY_DECAY_FORGET 64.0            /* Half-lives applied by a decay factor of 0 */
+
+/* Near duplicates - SimHash nominates, shared words confirm */
+#define MEMORY_SIMHASH_DISTANCE 3           /* Differing fingerprint bits (of 64) */
+#define MEMORY_SIMHASH_BANDS (MEMORY_SIMHASH_DISTANCE + 1)  /* Exact-match bands */
+#define MEMORY_NEAR_SIMILARITY 0.9f         /* Shared share of distinct words */
+
+/* Retrieval - BM25 over an inverted index of content words */
+#define MEMORY_TERMS_INITIAL 1024           /* Term table slots (power of two) */
+#define MEMORY_TERM_MIN_LENGTH 3            /* Shorter words are not indexed */
+#define MEMORY_QUERY_TERMS_MAX 64           /* Distinct task words scored */
+#define MEMORY_RERANK_CANDIDATES 256        /* Text matches reranked (> MEMORY_MAX_ITEMS) */
+#define MEMORY_BM25_K1 1.2f                 /* Term frequency saturation */
+#define MEMORY_BM25_B 0.75f                 /* Length normalization */
+#define MEMORY_RECENCY_SECONDS 86400.0f     /* Recency boost halves after a day */
+#define MEMORY_ACCESS_SATURATION 4.0f       /* Use boost is half at this many uses */
+#define MEMORY_WEIGHT_MATCH 0.6f            /* BM25, relative to the best match */
+#define MEMORY_WEIGHT_STORED 0.2f           /* Stored relevance score */
+#define MEMORY_WEIGHT_RECENCY 0.1f          /* Last access */
+#define MEMORY_WEIGHT_ACCESS 0.05f          /* Access count */
+#define MEMORY_WEIGHT_IMPORTANT 0.05f       /* CI-marked importance */
+
+/* Binary store file */
+#define MEMORY_STORE_MAGIC "ARGOMEM"        /* 8 bytes with the NUL */
+#define MEMORY_STORE_VERSION 3
+#define MEMORY_STORE_COMPACT_PERCENT 50     /* Journal past this share of the base compacts */
+
+/* Token estimate - a word costs one token per MEMORY_TOKEN_BYTES bytes,
+ * other marks and newlines one each, spaces nothing */
+#define MEMORY_TOKEN_BYTES 4
+
 /* Memory JSON buffer size */
 #define MEMORY_JSON_BUFFER_SIZE 8192
 
@@ -40,7 +78,8 @@ typedef enum memory_type {
 
 /* Memory relevance scoring */
 typedef struct memory_relevance {
-    float score;                /* 0.0 to 1.0 */
+    float score;                /* 0.0 to 1.0 as of decay_stamp */
+    double decay_stamp;         /* Decay clock when score was set */
     time_t last_accessed;
     int access_count;
     bool ci_marked_important;   /* CI said this matters */
@@ -52,17 +91,22 @@ typedef struct memory_item {
     memory_type_t type;
     char* content;              /* JSON string */
     size_t content_size;
+    uint32_t tokens;            /* Estimated tokens in content */
     time_t created;
     char* creator_ci;           /* Which CI created this */
     memory_relevance_t relevance;
-    struct memory_item* next;
+    bool selected;              /* In digest->selected */
+    double rank_key;            /* log2(score) + decay_stamp - decay never changes it */
+    uint32_t rank_slot;         /* Position in digest->ranking */
+    uint64_t fingerprint;       /* SimHash of the content words */
+    struct memory_item* next;   /* Older item */
 } memory_item_t;
 
-/* Binary index for fast lookup */
+/* Binary index for fast lookup (open addressing, hash 0 marks a free slot) */
 typedef struct memory_index {
     uint32_t hash;              /* Content hash */
     uint32_t memory_id;         /* Memory item ID */
-    uint32_t offset;            /* Offset in JSON */
+    uint32_t offset;            /* Item record offset in the store file */
     uint16_t relevance_score;  /* Scaled 0-65535 */
 } memory_index_t;
 
@@ -83,15 +127,35 @@ typedef struct ci_memory_digest {
 
     /* CI breadcrumbs for future sessions */
     char* breadcrumbs[MEMORY_BREADCRUMB_MAX];
+    uint64_t breadcrumb_fingerprints[MEMORY_BREADCRUMB_MAX];
+    uint32_t breadcrumb_tokens[MEMORY_BREADCRUMB_MAX];
     int breadcrumb_count;
 
     /* Sunset/sunrise protocol */
     char* sunset_notes;         /* CI's handoff notes */
     char* sunrise_brief;        /* Briefing for next CI */
+    uint32_t sunset_tokens;     /* Estimated tokens, kept with the text */
+    uint32_t sunrise_tokens;
 
     /* Binary index for fast lookup */
     memory_index_t* index;
-    size_t index_size;
+    size_t index_size;          /* Slots */
+    size_t index_count;         /* Occupied slots */
+
+    /* Item store - items and their strings live in the arena */
+    struct memory_arena* arena;
+    memory_item_t* items;       /* Newest first */
+    int item_count;
+    memory_item_t** by_id;      /* ids are dense from 1 */
+    size_t by_id_capacity;
+    uint32_t next_id;
+    uint32_t last_item_id;      /* Item stored or merged by the last add */
+    struct memory_terms* terms; /* Inverted index over item content (mapped loads build it on first search) */
+    struct memory_ranking* ranking; /* Items by rank_key (mapped loads build it on first use) */
+    struct memory_near* near;   /* Fingerprints by band (mapped loads build it on first add) */
+    double decay_epoch;         /* Half-lives applied by memory_decay_relevance */
+    struct memory_store* store; /* Mapped file the digest was loaded from */
+    bool index_mapped;          /* index[] still points into the store (copied on write) */
 
     /* Metadata */
     char session_id[32];
@@ -103,7 +167,18 @@ typedef struct ci_memory_digest {
 ci_memory_digest_t* memory_digest_create(size_t context_limit);
 void memory_digest_destroy(ci_memory_digest_t* digest);
 
-/* Adding memories */
+/* Adding memories
+ *
+ * Content already stored with the same type is merged instead of added
+ * (access count and stored score go up); either way last_item_id names
+ * the item. Items are kept for the digest's lifetime.
+ *
+ * Near duplicates merge too: an item of the same type whose SimHash is
+ * within MEMORY_SIMHASH_DISTANCE bits and which shares
+ * MEMORY_NEAR_SIMILARITY of its distinct words (case, punctuation and
+ * order aside). The stored wording is kept. A near-duplicate breadcrumb
+ * replaces the old one and becomes the newest.
+ */
 int memory_add_item(ci_memory_digest_t* digest,
                    memory_type_t type,
                    const char* content,
@@ -111,7 +186,17 @@ int memory_add_item(ci_memory_digest_t* digest,
 int memory_add_breadcrumb(ci_memory_digest_t* digest,
                          const char* breadcrumb);
 
-/* Suggesting memories (deterministic) */
+/* Find item by id (NULL if unknown) */
+memory_item_t* memory_find_item(ci_memory_digest_t* digest, uint32_t memory_id);
+
+/* Suggesting memories (deterministic)
+ *
+ * Fills suggested[] with the best scoring items, best first, that still
+ * fit the half-context budget next to what is already selected.
+ * memory_suggest_relevant ranks the best BM25 matches for the task (or
+ * the newest items when no task word is selective); memory_suggest_by_type
+ * ranks every item of the type. Returns the number of suggestions.
+ */
 int memory_suggest_relevant(ci_memory_digest_t* digest,
                            const char* task_context,
                            int max_suggestions);
@@ -119,7 +204,14 @@ int memory_suggest_by_type(ci_memory_digest_t* digest,
                           memory_type_t type,
                           int max_suggestions);
 
-/* CI selection of memories */
+/* CI selection of memories
+ *
+ * Returns:
+ *   ARGO_SUCCESS (also when already selected)
+ *   E_NOT_FOUND for an unknown id, E_INPUT_RANGE for a bad suggestion index
+ *   E_RESOURCE_LIMIT when MEMORY_MAX_ITEMS are selected
+ *   E_INPUT_TOO_LARGE when the item would break the size limit
+ */
 int memory_select_item(ci_memory_digest_t* digest,
                       uint32_t memory_id);
 int memory_select_suggested(ci_memory_digest_t* digest,
@@ -141,20 +233,65 @@ ci_memory_digest_t* memory_digest_from_json(const char* json,
 size_t memory_calculate_size(ci_memory_digest_t* digest);
 bool memory_check_size_limit(ci_memory_digest_t* digest);
 
-/* Relevance scoring */
-float memory_calculate_relevance(memory_item_t* item,
+/* Relevance scoring - share of task words in the item blended with
+ * stored score, recency, use and importance */
+float memory_calculate_relevance(ci_memory_digest_t* digest,
+                                memory_item_t* item,
                                 const char* current_task);
-int memory_update_relevance(memory_item_t* item,
+
+/* Stored relevance decays lazily
+ *
+ * Each item keeps the score it was given and the decay clock reading at
+ * that moment. The clock advances one unit per MEMORY_HALF_LIFE_SECONDS
+ * and memory_decay_relevance moves it forward by -log2(factor), so a
+ * decay pass is O(1) and touches no item. The decayed score,
+ * score * 2^(stamp - clock), is worked out only when items are ranked
+ * (memory_stored_relevance). Decay lowers every item by the same
+ * factor, so the ranking heap keyed on log2(score) + stamp stays in
+ * order without rescoring.
+ */
+float memory_stored_relevance(const ci_memory_digest_t* digest,
+                             const memory_item_t* item,
+                             time_t now);
+int memory_update_relevance(ci_memory_digest_t* digest,
+                           memory_item_t* item,
                            float new_score);
 int memory_decay_relevance(ci_memory_digest_t* digest,
                           float decay_factor);
 
-/* Memory persistence */
+/* Memory persistence - versioned binary store
+ *
+ * The file holds a header, a fixed-size item table, the content index
+ * and a pool of NUL-terminated strings, all addressed by offset.
+ * Loading maps it read-only: item text stays in the mapping and the
+ * index is used in place until the digest changes, so there is no
+ * parsing and no per-item allocation. The format is host-endian.
+ *
+ * memory_save_to_file writes a compacted file (temp file + rename).
+ * memory_store_append only adds items created since the file was
+ * written, as journal records after the base; relevance and selection
+ * changes reach disk at the next compaction, which append does itself
+ * once the journal passes MEMORY_STORE_COMPACT_PERCENT of the base.
+ * memory_load_from_file also reads files written as JSON.
+ */
 int memory_save_to_file(ci_memory_digest_t* digest,
                        const char* filepath);
+int memory_store_append(ci_memory_digest_t* digest,
+                       const char* filepath);
 ci_memory_digest_t* memory_load_from_file(const char* filepath,
                                          size_t context_limit);
 
+/* Approximate token count of text
+ *
+ * Word runs split at every other character, so the estimate of joined
+ * pieces is the sum of theirs when a mark or space sits at each seam.
+ * Items, breadcrumbs and notes keep theirs cached for prompt assembly.
+ */
+size_t memory_estimate_tokens(const char* text, size_t length);
+
+/* Display name of an item type */
+const char* memory_type_name(memory_type_t type);
+
 /* Debugging and inspection */
 void memory_print_summary(ci_memory_digest_t* digest);
 void memory_print_item(memory_item_t* item);
@@ -0,0 +1,72 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Memory digest internals shared by the engine and its loaders */
+
+#ifndef ARGO_MEMORY_INTERNAL_H
+#define ARGO_MEMORY_INTERNAL_H
+
+#include "argo_memory.h"
+
+/* Store an item under a known id (loaders)
+ *
+ * Keeps id order dense and skips content already stored.
+ * Returns the stored or existing item, NULL on allocation failure.
+ */
+memory_item_t* memory_restore_item(ci_memory_digest_t* digest, uint32_t memory_id,
+                                   memory_type_t type, const char* content,
+                                   const char* creator_ci, time_t created);
+
+/* Put a restored item back in the selection without budget checks */
+int memory_restore_selection(ci_memory_digest_t* digest, memory_item_t* item);
+
+/* Inverted index over item content (argo_memory_search.c) */
+struct memory_terms* memory_terms_create(void);
+void memory_terms_destroy(struct memory_terms* terms);
+
+/* Index a new item's words */
+int memory_terms_add(struct memory_terms* terms, const memory_item_t* item);
+
+/* Build the digest's index from its items - deferred to the first
+ * search so creating and loading a digest stay cheap */
+int memory_terms_build(ci_memory_digest_t* digest);
+
+/* Items ordered by decayed stored score (argo_memory_decay.c) */
+struct memory_ranking* memory_ranking_create(void);
+void memory_ranking_destroy(struct memory_ranking* ranking);
+int memory_ranking_add(struct memory_ranking* ranking, memory_item_t* item);
+
+/* Build the digest's ranking from its items - deferred like the term index */
+int memory_ranking_build(ci_memory_digest_t* digest);
+
+/* Ids of the best unselected items (of a type, or any when type < 0),
+ * best first; returns the count */
+int memory_ranking_top(ci_memory_digest_t* digest, int type, uint32_t* ids, int max);
+
+/* Every word, short ones included, as sorted hashes (caller frees) */
+uint64_t* memory_text_words(const char* text, size_t* count);
+
+/* Near-duplicate detection (argo_memory_near.c) */
+uint64_t memory_fingerprint(const char* text);
+struct memory_near* memory_near_create(void);
+void memory_near_destroy(struct memory_near* near);
+int memory_near_add(struct memory_near* near, memory_item_t* item);
+
+/* Build the digest's fingerprint table from its items - deferred like the term index */
+int memory_near_build(ci_memory_digest_t* digest);
+
+/* Most similar item of the type close enough to count as the same
+ * memory, or NULL */
+memory_item_t* memory_find_near(ci_memory_digest_t* digest, memory_type_t type, const char* content);
+
+/* Index of a breadcrumb close enough to count as the same, or -1 */
+int memory_find_near_breadcrumb(ci_memory_digest_t* digest, const char* breadcrumb, uint64_t fingerprint);
+
+/* Decay clock reading at a time */
+double memory_decay_clock(const ci_memory_digest_t* digest, time_t now);
+
+/* Set an item's score as of a clock reading and keep the ranking in order */
+void memory_set_score(ci_memory_digest_t* digest, memory_item_t* item, float score, double stamp);
+
+/* Unmap a store file backing a loaded digest (argo_memory_store.c) */
+void memory_store_release(struct memory_store* store);
+
+#endif /* ARGO_MEMORY_INTERNAL_H */
@@ -10,28 +10,21 @@
 
 /* Ollama configuration */
 #define OLLAMA_PROVIDER_NAME "ollama"
-#define OLLAMA_DEFAULT_ENDPOINT "http://localhost"
 #define OLLAMA_DEFAULT_PORT 11434
 #define OLLAMA_DEFAULT_MODEL "llama3.3:70b"
 #define OLLAMA_TIMEOUT_SECONDS 60
-#define OLLAMA_BUFFER_SIZE 8192
-
-/* Request format for Ollama API */
-#define OLLAMA_REQUEST_FORMAT "{\"model\":\"%s\",\"prompt\":\"%s\",\"stream\":%s}"
+#define OLLAMA_GENERATE_PATH "/api/generate"
 
 /* Ollama JSON field names */
-#define OLLAMA_JSON_RESPONSE "\"response\":\""
+#define OLLAMA_JSON_MODEL "model"
+#define OLLAMA_JSON_PROMPT "prompt"
+#define OLLAMA_JSON_STREAM "stream"
+#define OLLAMA_RESPONSE_POINTER "/response"
+#define OLLAMA_ERROR_POINTER "/error"
 
 /* Ollama buffer sizes */
-#define OLLAMA_ENDPOINT_SIZE 256
 #define OLLAMA_MODEL_SIZE 64
 #define OLLAMA_RESPONSE_CAPACITY 16384
-#define OLLAMA_REQUEST_BUFFER_SIZE 8192
-#define OLLAMA_LINE_BUFFER_SIZE 8192
-#define OLLAMA_CHUNK_SIZE 1024
-#define OLLAMA_JSON_BODY_SIZE 4096
-#define OLLAMA_RESPONSE_FIELD_OFFSET 12
-#define OLLAMA_POLL_DELAY_US 10000
 
 /* Ollama provider creation */
 ci_provider_t* ollama_create_provider(const char* model_name);
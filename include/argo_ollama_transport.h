@@ -0,0 +1,105 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_OLLAMA_TRANSPORT_H
+#define ARGO_OLLAMA_TRANSPORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Ollama Transport - persistent HTTP/1.1 connection to an Ollama server
+ *
+ * Reads block in poll() until bytes arrive (no sleep loops) and give up
+ * after timeout_ms without progress. Responses are framed by
+ * Content-Length, chunked transfer encoding, or connection close, and
+ * the decoded body is handed to the caller as it arrives.
+ *
+ * The connection is kept open between requests unless the server asks
+ * to close it. A request whose reused connection turns out to be dead
+ * before any response byte arrives is retried once on a fresh one.
+ *
+ * A connection is not thread-safe; each provider owns one.
+ */
+
+/* Address configuration: host, host:port or http://host:port */
+#define OLLAMA_HOST_CONFIG_KEY "ollama_host"
+#define OLLAMA_HOST_ENV "OLLAMA_HOST"
+#define OLLAMA_DEFAULT_HOST "127.0.0.1"
+
+/* Limits */
+#define OLLAMA_HOST_SIZE 256
+#define OLLAMA_READ_CHUNK 16384
+#define OLLAMA_HEADER_MAX 16384
+#define OLLAMA_CONNECT_TIMEOUT_MS 5000
+#define OLLAMA_PROBE_TIMEOUT_MS 1000
+
+/* Receives decoded body bytes; data is not NUL-terminated past len */
+typedef void (*ollama_body_fn)(const char* data, size_t len, void* userdata);
+
+/* Connection */
+typedef struct {
+    char host[OLLAMA_HOST_SIZE];
+    int port;
+    int fd;                     /* -1 while closed */
+    int timeout_ms;             /* Longest wait for the next bytes */
+    char* buffer;               /* Received, not yet consumed */
+    size_t length;
+    size_t capacity;
+    uint64_t connects;          /* Sockets opened */
+    uint64_t requests;          /* Responses completed */
+} ollama_conn_t;
+
+/* Parse "host", "host:port" or "http://host:port"
+ *
+ * Returns:
+ *   ARGO_SUCCESS (port left unchanged if the spec has none)
+ *   E_INPUT_FORMAT if the host is empty, too long, or the port is invalid
+ */
+int ollama_parse_address(const char* spec, char* host, size_t host_size, int* port);
+
+/* Configured server: ollama_host in config, then OLLAMA_HOST, then
+ * 127.0.0.1:11434. Invalid settings are logged and skipped. */
+void ollama_resolve_address(char* host, size_t host_size, int* port);
+
+/* Prepare connection (no I/O) */
+void ollama_conn_init(ollama_conn_t* conn, const char* host, int port);
+
+/* Connect if not already connected
+ *
+ * Returns:
+ *   ARGO_SUCCESS or E_CI_NO_PROVIDER if the server cannot be reached
+ *   within connect_timeout_ms
+ */
+int ollama_conn_open(ollama_conn_t* conn, int connect_timeout_ms);
+
+/* True while a socket is open */
+bool ollama_conn_is_open(const ollama_conn_t* conn);
+
+/* Close the socket (buffer kept for reuse) */
+void ollama_conn_close(ollama_conn_t* conn);
+
+/* Close the socket and free the buffer */
+void ollama_conn_free(ollama_conn_t* conn);
+
+/* Send one request and read the complete response
+ *
+ * Parameters:
+ *   method   - "GET" or "POST"
+ *   body     - JSON request body, or NULL
+ *   on_body  - Receives the decoded response body as it arrives
+ *   status   - Output: HTTP status code
+ *
+ * Returns:
+ *   ARGO_SUCCESS once the whole response was read (any HTTP status)
+ *   E_CI_NO_PROVIDER if the server cannot be reached
+ *   E_CI_TIMEOUT if the server stalled for timeout_ms
+ *   E_SYSTEM_SOCKET / E_SYSTEM_NETWORK if the connection failed
+ *   E_PROTOCOL_FORMAT / E_PROTOCOL_SIZE for malformed responses
+ *   The connection is closed after any error.
+ */
+int ollama_conn_request(ollama_conn_t* conn, const char* method, const char* path,
+                        const char* body, size_t body_len,
+                        ollama_body_fn on_body, void* userdata, int* status);
+
+#endif /* ARGO_OLLAMA_TRANSPORT_H */
@@ -0,0 +1,66 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_PROCESS_WAITER_H
+#define ARGO_PROCESS_WAITER_H
+
+#include <sys/types.h>
+
+/*
+ * Process Waiter - event-driven wait on a set of child processes
+ *
+ * Waits until any watched child exits or a timeout passes, without
+ * sleep-polling. Linux watches a pidfd per child through epoll; macOS
+ * uses kqueue EVFILT_PROC. Each watched child is reaped by PID, so other
+ * children of the caller are left alone.
+ *
+ * On Linux kernels without pidfd_open (before 5.3) the waiter falls back
+ * to checking watched children every WORKFLOW_POLL_INTERVAL_USEC.
+ */
+
+/* Most children one waiter watches at a time */
+#define PROCESS_WAITER_MAX_PROCS 1024
+
+typedef struct process_waiter process_waiter_t;
+
+/* Create waiter
+ *
+ * Returns:
+ *   New waiter, or NULL on failure (error reported)
+ */
+process_waiter_t* process_waiter_create(void);
+
+/* Watch a child process
+ *
+ * Returns:
+ *   ARGO_SUCCESS on success
+ *   E_INPUT_NULL if waiter is NULL
+ *   E_INPUT_TOO_LARGE if PROCESS_WAITER_MAX_PROCS are already watched
+ *   E_SYSTEM_PROCESS if the child cannot be watched
+ */
+int process_waiter_add(process_waiter_t* waiter, pid_t pid);
+
+/* Wait for a watched child to exit and reap it
+ *
+ * Parameters:
+ *   waiter     - Waiter
+ *   timeout_ms - Longest wait in milliseconds (-1 = no limit)
+ *   pid_out    - Output: PID of the child that exited
+ *   status_out - Output: waitpid() status of that child
+ *
+ * Returns:
+ *   ARGO_SUCCESS when a child was reaped (it is no longer watched)
+ *   E_TIMEOUT if no child exited within timeout_ms
+ *   E_INVALID_STATE if nothing is watched
+ *   E_SYSTEM_PROCESS on wait failure; if a watched child was reaped by
+ *     someone else, pid_out names it and it is no longer watched
+ */
+int process_waiter_wait(process_waiter_t* waiter, int timeout_ms,
+                        pid_t* pid_out, int* status_out);
+
+/* Number of children currently watched */
+int process_waiter_count(const process_waiter_t* waiter);
+
+/* Destroy waiter (watched children are not signalled or reaped) */
+void process_waiter_destroy(process_waiter_t* waiter);
+
+#endif /* ARGO_PROCESS_WAITER_H */
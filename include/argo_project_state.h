@@ -0,0 +1,96 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_PROJECT_STATE_H
+#define ARGO_PROJECT_STATE_H
+
+#include "argo_json_doc.h"
+
+/*
+ * Project State Store - versioned access to <project>/.argo-project/state.json
+ *
+ * Projects are resolved by ID through the global registry
+ * (~/.argo/projects.json, overridable with $ARGO_PROJECTS_REGISTRY).
+ * Each state file is parsed once and kept in memory; a stat() check on
+ * every request (inode, size, mtime) reloads it after an outside write,
+ * e.g. the jq fallback in workflows/lib/state_file.sh.
+ *
+ * Every successful patch bumps the version, which is stored in the file
+ * as "state_version" so it survives daemon restarts. A reload caused by
+ * an outside write also bumps it. Patches are all-or-nothing and are
+ * written with write-to-temp + rename, so readers never see a partial
+ * file. All functions are thread-safe.
+ */
+
+/* Paths */
+#define PROJECT_STATE_REGISTRY_FILE ".argo/projects.json"   /* Under $HOME */
+#define PROJECT_STATE_REGISTRY_ENV "ARGO_PROJECTS_REGISTRY"
+#define PROJECT_STATE_FILE ".argo-project/state.json"       /* Under project path */
+#define PROJECT_STATE_TEMP_SUFFIX ".XXXXXX"
+
+/* Fields */
+#define PROJECT_STATE_VERSION_FIELD "state_version"
+#define PROJECT_STATE_ANY_VERSION (-1LL)   /* Patch without compare-and-swap */
+
+/* Patch operations (RFC 6902 subset) */
+#define PROJECT_STATE_OP_ADD "add"
+#define PROJECT_STATE_OP_REPLACE "replace"
+#define PROJECT_STATE_OP_REMOVE "remove"
+#define PROJECT_STATE_OP_TEST "test"
+
+/* Limits */
+#define PROJECT_STATE_ID_MAX 128
+#define PROJECT_STATE_INITIAL_CAPACITY 8
+
+typedef struct project_state_store project_state_store_t;
+
+/* Create store
+ *
+ * Parameters:
+ *   registry_path - Project registry file, NULL for the default
+ *
+ * Returns:
+ *   New store, or NULL on allocation failure (error reported)
+ */
+project_state_store_t* project_state_store_create(const char* registry_path);
+
+/* Read state
+ *
+ * Parameters:
+ *   pointers - JSON pointers to read, or NULL/0 for the whole document
+ *   json     - Output: whole state, or an array with one value per
+ *              pointer (null where absent); caller frees
+ *   version  - Output: current version
+ *
+ * Returns:
+ *   ARGO_SUCCESS on success
+ *   E_INPUT_NULL if a parameter is NULL
+ *   E_NOT_FOUND if the project is not registered or has no state file
+ *   E_INPUT_FORMAT if the state file is not valid JSON
+ *   E_SYSTEM_MEMORY on allocation failure
+ */
+int project_state_get(project_state_store_t* store, const char* project_id,
+                      const char** pointers, int count,
+                      char** json, long long* version);
+
+/* Apply patch atomically
+ *
+ * Parameters:
+ *   ops      - Array of {"op","path","value"} objects; op is add,
+ *              replace, remove or test. add creates missing parents.
+ *   expected - Required current version, or PROJECT_STATE_ANY_VERSION
+ *   version  - Output: version after the patch (current version on conflict)
+ *
+ * Returns:
+ *   ARGO_SUCCESS on success
+ *   E_NOT_FOUND if the project is not registered or has no state file
+ *   E_INPUT_INVALID if an operation is malformed or its path is missing
+ *   E_PROTOCOL_VERSION if expected does not match or a test op fails
+ *   E_SYSTEM_FILE if the state file cannot be written
+ */
+int project_state_patch(project_state_store_t* store, const char* project_id,
+                        const json_node_t* ops, long long expected, long long* version);
+
+/* Destroy store */
+void project_state_store_destroy(project_state_store_t* store);
+
+#endif /* ARGO_PROJECT_STATE_H */
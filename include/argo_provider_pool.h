@@ -0,0 +1,88 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_PROVIDER_POOL_H
+#define ARGO_PROVIDER_POOL_H
+
+#include <stdbool.h>
+#include "argo_ci.h"
+
+/*
+ * Provider Pool - warm, initialized providers keyed by (provider, model)
+ *
+ * Checkout returns an idle provider that has already run init() and
+ * connect(), or creates one through the factory. Checkin returns it for
+ * the next caller. Each provider is used by one caller at a time.
+ *
+ * Health: a provider checked in after a local failure (anything but
+ * success, a remote HTTP/protocol error, timeout or cancel) is cleaned
+ * up rather than reused. Idle providers past the idle limit or the
+ * maximum age are evicted, at checkout or by provider_pool_evict_idle.
+ *
+ * Size: at most max_size providers exist. When full, the least recently
+ * used idle provider is evicted; when all are busy, checkout hands out
+ * an unpooled provider that is cleaned up at checkin.
+ */
+
+#define PROVIDER_POOL_DEFAULT_MAX_SIZE 16
+#define PROVIDER_POOL_DEFAULT_IDLE_SECONDS 300        /* 5 minutes */
+#define PROVIDER_POOL_MAX_AGE_SECONDS 3600            /* Recreate hourly */
+
+/* Creates an uninitialized provider, or NULL if name is unknown */
+typedef ci_provider_t* (*provider_factory_fn)(const char* provider_name, const char* model);
+
+typedef struct provider_pool provider_pool_t;
+
+/* Pool statistics */
+typedef struct {
+    int idle;
+    int busy;
+    unsigned long long hits;        /* Checkouts served warm */
+    unsigned long long misses;      /* Checkouts that created a provider */
+    unsigned long long evictions;
+} provider_pool_stats_t;
+
+/* Create pool
+ *
+ * Parameters:
+ *   factory      - Creates providers by name and model
+ *   max_size     - Pooled providers, idle plus busy (<= 0 uses default)
+ *   idle_seconds - Idle time before eviction (<= 0 uses default)
+ *
+ * Returns:
+ *   New pool, or NULL on allocation failure
+ */
+provider_pool_t* provider_pool_create(provider_factory_fn factory, int max_size, int idle_seconds);
+
+/* Check out a ready provider
+ *
+ * Parameters:
+ *   model - Model name, or NULL for the provider default
+ *
+ * Returns:
+ *   ARGO_SUCCESS, E_NOT_FOUND if the factory does not know provider_name,
+ *   or the provider's init/connect error
+ */
+int provider_pool_checkout(provider_pool_t* pool, const char* provider_name,
+                           const char* model, ci_provider_t** provider);
+
+/* Return a provider
+ *
+ * Parameters:
+ *   result - Outcome of the provider's last call (decides reuse)
+ */
+void provider_pool_checkin(provider_pool_t* pool, ci_provider_t* provider, int result);
+
+/* Evict idle providers past their limits
+ *
+ * Returns:
+ *   Number of providers cleaned up
+ */
+int provider_pool_evict_idle(provider_pool_t* pool);
+
+/* Snapshot of pool counters */
+void provider_pool_get_stats(provider_pool_t* pool, provider_pool_stats_t* stats);
+
+/* Destroy pool and its idle providers (check everything in first) */
+void provider_pool_destroy(provider_pool_t* pool);
+
+#endif /* ARGO_PROVIDER_POOL_H */
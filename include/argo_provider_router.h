@@ -0,0 +1,169 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_PROVIDER_ROUTER_H
+#define ARGO_PROVIDER_ROUTER_H
+
+#include <stdbool.h>
+#include "argo_ci_engine.h"
+
+/*
+ * Provider Router - latency-aware routing and failover for CI queries
+ *
+ * A route is a named, ordered set of interchangeable provider/model
+ * candidates (e.g. "fast" = claude_api/claude-haiku, openai_api/gpt-4o-mini).
+ * The router keeps a moving average of latency and error rate for every
+ * provider/model it has seen and sends each query to the best healthy
+ * candidate. If that candidate fails or runs out of its share of the
+ * deadline, the query moves on to the next one.
+ *
+ * A candidate is unhealthy after PROVIDER_ROUTER_FAILURE_THRESHOLD
+ * consecutive failures; it sorts last until PROVIDER_ROUTER_COOLDOWN_MS
+ * has passed, then gets one probe query.
+ *
+ * Hedging is optional per query: if the first candidate has not answered
+ * by its p95 latency, a duplicate goes to the next candidate and the
+ * first answer wins; the loser is cancelled.
+ *
+ * Routes come from configuration (or the environment, same names):
+ *   CI_ROUTES=fast,smart
+ *   CI_ROUTE_FAST=claude_api/claude-3-5-haiku-20241022,openai_api/gpt-4o-mini
+ *   CI_ROUTE_SMART=claude_api,openrouter/anthropic/claude-3.5-sonnet
+ * The model follows the first '/', and may be left out for the
+ * provider's default. All functions are thread-safe.
+ */
+
+/* Configuration */
+#define PROVIDER_ROUTER_ROUTES_CONFIG_KEY "CI_ROUTES"
+#define PROVIDER_ROUTER_ROUTE_CONFIG_PREFIX "CI_ROUTE_"
+#define PROVIDER_ROUTER_DEFAULT_ROUTE_CONFIG_KEY "CI_DEFAULT_ROUTE"
+
+#define PROVIDER_ROUTER_MAX_ROUTES 16
+#define PROVIDER_ROUTER_MAX_CANDIDATES 8       /* Per route */
+#define PROVIDER_ROUTER_NAME_SIZE 64
+#define PROVIDER_ROUTER_MODEL_SIZE 128
+#define PROVIDER_ROUTER_SAMPLES 64             /* Latencies kept for p95 */
+#define PROVIDER_ROUTER_EWMA_ALPHA 0.2         /* Weight of the newest sample */
+#define PROVIDER_ROUTER_ERROR_WEIGHT 4.0       /* Score = latency * (1 + weight * error rate) */
+#define PROVIDER_ROUTER_FAILURE_THRESHOLD 3    /* Consecutive failures before unhealthy */
+#define PROVIDER_ROUTER_COOLDOWN_MS 30000      /* Unhealthy until then, then probed */
+#define PROVIDER_ROUTER_MIN_HEDGE_SAMPLES 5    /* Fewer uses the default hedge delay */
+#define PROVIDER_ROUTER_DEFAULT_HEDGE_MS 2000
+#define PROVIDER_ROUTER_MIN_HEDGE_MS 10
+
+typedef struct provider_router provider_router_t;
+
+/* Starts one attempt of a routed query
+ *
+ * Parameters:
+ *   provider, model - Candidate (model NULL = provider default)
+ *   timeout_ms      - This attempt's share of the deadline
+ *   callback        - Must be passed to the engine as the future's callback
+ *
+ * Returns:
+ *   ARGO_SUCCESS with *future set, or an error (counts as a failure)
+ */
+typedef int (*provider_router_submit_fn)(void* context, const char* provider, const char* model,
+                                         int timeout_ms, ci_response_callback callback,
+                                         void* userdata, ci_future_t** future);
+
+/* Health and latency of one provider/model */
+typedef struct {
+    char provider[PROVIDER_ROUTER_NAME_SIZE];
+    char model[PROVIDER_ROUTER_MODEL_SIZE];     /* "" = provider default */
+    double latency_ms;              /* Moving average of successes, 0 = none yet */
+    double error_rate;              /* Moving average, 0..1 */
+    int p95_ms;                     /* Over the last PROVIDER_ROUTER_SAMPLES, 0 = none */
+    int consecutive_failures;
+    bool healthy;
+    unsigned long long successes;
+    unsigned long long failures;
+} provider_route_stats_t;
+
+/* Outcome of a routed query */
+typedef struct {
+    char* content;                  /* Winning answer (caller frees), NULL on failure */
+    char provider[PROVIDER_ROUTER_NAME_SIZE];
+    char model[PROVIDER_ROUTER_MODEL_SIZE];
+    int attempts;                   /* Candidates started, hedge included */
+    bool hedged;                    /* A hedge was sent */
+} router_result_t;
+
+/* Create router with no routes (NULL on allocation failure) */
+provider_router_t* provider_router_create(void);
+
+/* Destroy router */
+void provider_router_destroy(provider_router_t* router);
+
+/* Add or replace a route
+ *
+ * Parameters:
+ *   name       - Route name (matched case-insensitively)
+ *   candidates - Comma-separated "provider[/model]" list, best first
+ *
+ * Returns:
+ *   ARGO_SUCCESS, E_INVALID_PARAMS on an empty or oversized list, or
+ *   E_RESOURCE_LIMIT when PROVIDER_ROUTER_MAX_ROUTES are defined
+ */
+int provider_router_add_route(provider_router_t* router, const char* name, const char* candidates);
+
+/* Load routes named in CI_ROUTES from CI_ROUTE_<NAME> keys
+ *
+ * Parameters:
+ *   loaded - Set to the number of routes loaded (may be NULL)
+ *
+ * Returns:
+ *   ARGO_SUCCESS (also when CI_ROUTES is unset), E_INPUT_TOO_LARGE if
+ *   CI_ROUTES does not fit (nothing loaded), or E_INVALID_PARAMS if a
+ *   listed route is missing or invalid (logged and skipped; the rest load)
+ */
+int provider_router_load_config(provider_router_t* router, int* loaded);
+
+/* True if name is a defined route */
+bool provider_router_has_route(provider_router_t* router, const char* name);
+
+/* Record one finished query (result ARGO_SUCCESS or an error) */
+void provider_router_record(provider_router_t* router, const char* provider, const char* model,
+                            int result, long long latency_ms);
+
+/* Candidates of a route, best first
+ *
+ * Parameters:
+ *   ranked - Output, at most max entries
+ *   count  - Output: entries written
+ *
+ * Returns:
+ *   ARGO_SUCCESS, or E_NOT_FOUND for an unknown route
+ */
+int provider_router_rank(provider_router_t* router, const char* route,
+                         provider_route_stats_t* ranked, int max, int* count);
+
+/* Milliseconds to wait for provider/model before hedging */
+int provider_router_hedge_delay(provider_router_t* router, const char* provider, const char* model);
+
+/* Run a query on a route, failing over until one candidate answers
+ *
+ * Blocks the caller. Each attempt gets the remaining time divided by the
+ * candidates not yet tried, so a slow candidate times out early enough
+ * to leave time for the others.
+ *
+ * Parameters:
+ *   timeout_ms - Whole query (<= 0 uses CI_ENGINE_DEFAULT_TIMEOUT_MS)
+ *   hedge      - Send a duplicate to the next candidate after p95
+ *   result     - Output, filled on success and failure
+ *
+ * Returns:
+ *   ARGO_SUCCESS, E_NOT_FOUND for an unknown route, or the last
+ *   candidate's error
+ */
+int provider_router_query(provider_router_t* router, const char* route,
+                          provider_router_submit_fn submit, void* context,
+                          int timeout_ms, bool hedge, router_result_t* result);
+
+/* Snapshot of every provider/model seen
+ *
+ * Returns:
+ *   Number written to stats (at most max)
+ */
+int provider_router_get_stats(provider_router_t* router, provider_route_stats_t* stats, int max);
+
+#endif /* ARGO_PROVIDER_ROUTER_H */
@@ -0,0 +1,123 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_PROVIDER_TELEMETRY_H
+#define ARGO_PROVIDER_TELEMETRY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+#include "argo_json_doc.h"
+
+/*
+ * Provider Telemetry - usage and latency of every provider call
+ *
+ * Providers record each call they make (query or stream, success or
+ * failure) into one process-wide table keyed by provider/model:
+ * request and response bytes, prompt and completion tokens as reported
+ * by the server, queue time, time to first byte, total latency, and a
+ * histogram of total latency.
+ *
+ * Token counts come from the provider's own usage fields, whichever
+ * of these the answer carries (streams report them in their last
+ * events; later values replace earlier ones):
+ *   OpenAI    usage.prompt_tokens / usage.completion_tokens
+ *   Anthropic usage.input_tokens / usage.output_tokens (message.usage
+ *             in message_start)
+ *   Gemini    usageMetadata.promptTokenCount / candidatesTokenCount
+ *   Ollama    prompt_eval_count / eval_count
+ *   Claude Code (session turns) usage.input_tokens / usage.output_tokens
+ *             of the stream-json result frame; one-shot runs report none
+ *
+ * Queue time is everything before the answering attempt was sent: rate
+ * limit waits, 429 retries, and time queued in the CI engine. All
+ * functions are thread-safe.
+ */
+
+/* Limits */
+#define PROVIDER_TELEMETRY_NAME_SIZE 64
+#define PROVIDER_TELEMETRY_MODEL_SIZE 128
+#define PROVIDER_TELEMETRY_MAX_ENTRIES 128     /* Provider/models tracked */
+
+/* Latency histogram: bucket i counts calls up to bound i, the last
+ * bucket everything slower */
+#define PROVIDER_TELEMETRY_BUCKET_BOUNDS_MS { 5, 10, 25, 50, 100, 250, 500, 1000, \
+                                              2500, 5000, 10000, 30000, 60000, 120000 }
+#define PROVIDER_TELEMETRY_BUCKETS 15
+
+/* Token counts reported by the server (0 = not reported) */
+typedef struct {
+    long long prompt_tokens;
+    long long completion_tokens;
+} provider_usage_t;
+
+/* One finished call */
+typedef struct {
+    const char* provider;
+    const char* model;              /* NULL = provider default */
+    int result;                     /* ARGO_SUCCESS or the call's error */
+    bool streamed;
+    size_t request_bytes;           /* Request body sent */
+    size_t response_bytes;          /* Response body received */
+    provider_usage_t usage;
+    long long queue_ms;
+    long long ttfb_ms;              /* Request sent to first response byte, < 0 = unknown */
+    long long total_ms;             /* Call start to finish, queue included */
+} provider_call_t;
+
+/* Totals for one provider/model */
+typedef struct {
+    char provider[PROVIDER_TELEMETRY_NAME_SIZE];
+    char model[PROVIDER_TELEMETRY_MODEL_SIZE];     /* "" = provider default */
+    unsigned long long calls;
+    unsigned long long failures;
+    unsigned long long streamed;
+    unsigned long long request_bytes;
+    unsigned long long response_bytes;
+    unsigned long long prompt_tokens;
+    unsigned long long completion_tokens;
+    unsigned long long queue_ms;            /* Sums, for averages */
+    unsigned long long ttfb_ms;
+    unsigned long long ttfb_samples;        /* Calls with a known ttfb */
+    unsigned long long total_ms;
+    long long max_ms;
+    unsigned long long histogram[PROVIDER_TELEMETRY_BUCKETS];
+    time_t last_call;
+} provider_telemetry_stats_t;
+
+/* Record one finished call */
+void provider_telemetry_record(const provider_call_t* call);
+
+/* Merge the usage counters found in a parsed response or stream event */
+void provider_usage_read(json_node_t* root, provider_usage_t* usage);
+
+/* Merge the usage counters of a JSON response body
+ *
+ * Returns:
+ *   ARGO_SUCCESS, or E_INPUT_FORMAT if the body is not JSON (usage unchanged)
+ */
+int provider_usage_parse(const char* json, size_t len, provider_usage_t* usage);
+
+/* Snapshot of every provider/model recorded
+ *
+ * Returns:
+ *   Number written to stats (at most max)
+ */
+int provider_telemetry_get_stats(provider_telemetry_stats_t* stats, int max);
+
+/* Latency below which pct percent of calls finished
+ *
+ * Estimated from the histogram as the upper bound of the bucket
+ * holding that rank; the open last bucket reports max_ms.
+ *
+ * Returns:
+ *   Milliseconds, or 0 if nothing was recorded
+ */
+long long provider_telemetry_percentile(const provider_telemetry_stats_t* stats, double pct);
+
+/* Histogram bucket upper bounds (PROVIDER_TELEMETRY_BUCKETS - 1 entries) */
+const long long* provider_telemetry_bucket_bounds(void);
+
+/* Forget everything recorded */
+void provider_telemetry_reset(void);
+
+#endif /* ARGO_PROVIDER_TELEMETRY_H */
@@ -0,0 +1,138 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_RATE_LIMIT_H
+#define ARGO_RATE_LIMIT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "argo_http.h"
+
+/*
+ * Rate Limit - per-provider, per-key request scheduling
+ *
+ * One limiter exists per API endpoint (scheme, host, port) and
+ * credential, so every workflow using the same key shares one budget.
+ * Each limiter holds two token buckets: requests per minute and prompt
+ * tokens per minute. A request reserves its slot up front; when a bucket
+ * is short it is told how long to wait instead of failing, so a burst is
+ * spread out at the sustainable rate in arrival order.
+ *
+ * Limits come from configuration and are tightened by what the server
+ * reports (x-ratelimit-limit-*, x-ratelimit-remaining-*,
+ * anthropic-ratelimit-*). A 429 pauses the limiter for Retry-After
+ * (or jittered exponential backoff when the server gives none), and the
+ * request is retried while its deadline allows.
+ *
+ * Credentials are fingerprinted, never stored. All functions are
+ * thread-safe.
+ */
+
+/* Configuration (0 = unlimited until the server reports a limit) */
+#define RATE_LIMIT_RPM_CONFIG_KEY "rate_limit_rpm"
+#define RATE_LIMIT_RPM_ENV "ARGO_RATE_LIMIT_RPM"
+#define RATE_LIMIT_TPM_CONFIG_KEY "rate_limit_tpm"
+#define RATE_LIMIT_TPM_ENV "ARGO_RATE_LIMIT_TPM"
+#define RATE_LIMIT_MAX_WAIT_CONFIG_KEY "rate_limit_max_wait_ms"
+#define RATE_LIMIT_MAX_WAIT_ENV "ARGO_RATE_LIMIT_MAX_WAIT_MS"
+
+#define RATE_LIMIT_DEFAULT_MAX_WAIT_MS 120000  /* Blocking calls give up after this */
+#define RATE_LIMIT_MAX_RETRIES 4               /* 429 retries per request */
+#define RATE_LIMIT_BACKOFF_BASE_MS 1000        /* First backoff without Retry-After */
+#define RATE_LIMIT_BACKOFF_MAX_MS 60000
+#define RATE_LIMIT_JITTER_MS 250               /* Spread retries after a shared Retry-After */
+#define RATE_LIMIT_WINDOW_MS 60000             /* Limits are per minute */
+#define RATE_LIMIT_BYTES_PER_TOKEN 4           /* Prompt token estimate */
+#define RATE_LIMIT_KEY_SIZE 320
+
+/* Response headers */
+#define RATE_LIMIT_HEADER_RETRY_AFTER "retry-after"
+#define RATE_LIMIT_HEADER_RETRY_AFTER_MS "retry-after-ms"
+#define RATE_LIMIT_HEADER_LIMIT_REQUESTS "x-ratelimit-limit-requests"
+#define RATE_LIMIT_HEADER_REMAINING_REQUESTS "x-ratelimit-remaining-requests"
+#define RATE_LIMIT_HEADER_RESET_REQUESTS "x-ratelimit-reset-requests"
+#define RATE_LIMIT_HEADER_LIMIT_TOKENS "x-ratelimit-limit-tokens"
+#define RATE_LIMIT_HEADER_REMAINING_TOKENS "x-ratelimit-remaining-tokens"
+#define RATE_LIMIT_HEADER_RESET_TOKENS "x-ratelimit-reset-tokens"
+#define RATE_LIMIT_HEADER_ANTHROPIC_LIMIT_REQUESTS "anthropic-ratelimit-requests-limit"
+#define RATE_LIMIT_HEADER_ANTHROPIC_REMAINING_REQUESTS "anthropic-ratelimit-requests-remaining"
+#define RATE_LIMIT_HEADER_ANTHROPIC_LIMIT_TOKENS "anthropic-ratelimit-tokens-limit"
+#define RATE_LIMIT_HEADER_ANTHROPIC_REMAINING_TOKENS "anthropic-ratelimit-tokens-remaining"
+
+typedef struct rate_limiter rate_limiter_t;
+
+/* Statistics */
+typedef struct {
+    double requests_per_minute;     /* Effective limits, 0 = unlimited */
+    double tokens_per_minute;
+    unsigned long long granted;     /* Reservations made */
+    unsigned long long delayed;     /* Reservations that had to wait */
+    unsigned long long rejected;    /* Could not be scheduled before the deadline */
+    unsigned long long throttled;   /* 429 responses seen */
+    long long paused_until_ms;      /* Monotonic; 0 if not paused */
+} rate_limit_stats_t;
+
+/* Limiter for the endpoint and credential of req
+ *
+ * The credential is the Authorization header, any *api-key header, or
+ * the URL query (key=...). Limiters live until rate_limit_cleanup.
+ *
+ * Returns:
+ *   Shared limiter, or NULL on invalid URL or allocation failure
+ *   (callers then proceed unlimited)
+ */
+rate_limiter_t* rate_limit_for_request(const http_request_t* req);
+
+/* Prompt tokens a request body is counted as */
+int rate_limit_estimate_tokens(size_t body_len);
+
+/* Reserve a slot for one request of tokens tokens
+ *
+ * Parameters:
+ *   deadline_ms - Monotonic time by which the request must start
+ *   start_ms    - Output: monotonic time the request may start
+ *
+ * Returns:
+ *   ARGO_SUCCESS (slot committed), or E_HTTP_RATE_LIMIT if the
+ *   earliest slot is after deadline_ms (nothing reserved)
+ */
+int rate_limit_reserve(rate_limiter_t* limiter, int tokens, long long deadline_ms,
+                       long long* start_ms);
+
+/* Reserve and sleep until the slot; returns as rate_limit_reserve */
+int rate_limit_acquire(rate_limiter_t* limiter, int tokens, long long deadline_ms);
+
+/* Learn from a response (limits, remaining budget, Retry-After)
+ *
+ * Returns:
+ *   true if resp was a 429 and the request may be retried
+ */
+bool rate_limit_observe(rate_limiter_t* limiter, const http_response_t* resp);
+
+/* Override configured limits (0 = unlimited) */
+void rate_limit_set_limits(rate_limiter_t* limiter, double requests_per_minute,
+                           double tokens_per_minute);
+
+/* Snapshot of counters */
+void rate_limit_get_stats(rate_limiter_t* limiter, rate_limit_stats_t* stats);
+
+/* Monotonic deadline for blocking callers: now + configured max wait */
+long long rate_limit_default_deadline(void);
+
+/* Execute req under its limiter, retrying 429s until deadline_ms
+ *
+ * Same contract as http_execute (on_chunk NULL) or
+ * http_execute_streaming; a 429 body is never streamed, so retries do
+ * not duplicate output. When retries run out, resp is the last 429.
+ *
+ * Returns:
+ *   As http_execute, or E_HTTP_RATE_LIMIT if the first slot is after
+ *   deadline_ms
+ */
+int rate_limit_execute(const http_request_t* req, long long deadline_ms,
+                       void (*on_chunk)(const char* chunk, size_t len, void* userdata),
+                       void* userdata, http_response_t** resp);
+
+/* Free all limiters (shutdown, after all providers are gone) */
+void rate_limit_cleanup(void);
+
+#endif /* ARGO_RATE_LIMIT_H */
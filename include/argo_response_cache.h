@@ -0,0 +1,110 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_RESPONSE_CACHE_H
+#define ARGO_RESPONSE_CACHE_H
+
+#include <stdbool.h>
+
+/*
+ * Response Cache - content-addressed cache of CI query responses
+ *
+ * Entries are keyed by a hash of (provider, model, params, prompt) and
+ * expire ttl_seconds after they were stored. Two tiers:
+ *   memory - LRU, at most max_entries responses
+ *   disk   - one JSON file per entry under ~/.argo/cache, so answers
+ *            survive daemon restarts; a disk hit is promoted to memory
+ *
+ * Each entry keeps its full key, so a hash collision is a miss, never a
+ * wrong answer. Only successful responses should be stored. All
+ * functions are thread-safe.
+ */
+
+/* Paths */
+#define RESPONSE_CACHE_DIR ".argo/cache"              /* Under $HOME */
+#define RESPONSE_CACHE_FILE_SUFFIX ".json"
+#define RESPONSE_CACHE_TEMP_SUFFIX ".XXXXXX"
+
+/* Limits */
+#define RESPONSE_CACHE_DEFAULT_MAX_ENTRIES 256
+#define RESPONSE_CACHE_DEFAULT_TTL_SECONDS 86400      /* 24 hours */
+#define RESPONSE_CACHE_BUCKETS 512                    /* Power of two */
+#define RESPONSE_CACHE_HASH_SEED 14695981039346656037ULL   /* FNV-1a 64 offset basis */
+#define RESPONSE_CACHE_HASH_PRIME 1099511628211ULL         /* FNV-1a 64 prime */
+#define RESPONSE_CACHE_HASH_HEX 17                         /* 16 hex digits + NUL */
+
+/* Caller control over cache use (/api/ci/query "cache") */
+typedef enum {
+    RESPONSE_CACHE_BYPASS = 0,  /* Neither read nor write (default) */
+    RESPONSE_CACHE_PREFER,      /* Serve hits; query and store on miss */
+    RESPONSE_CACHE_ONLY         /* Serve hits; never query */
+} response_cache_mode_t;
+
+/* Cache key - every field that changes the answer */
+typedef struct {
+    const char* provider;
+    const char* model;          /* NULL for provider default */
+    const char* params;         /* Serialized generation parameters, NULL if none */
+    const char* prompt;
+} response_cache_key_t;
+
+/* Cache statistics */
+typedef struct {
+    int entries;                    /* Memory tier */
+    unsigned long long memory_hits;
+    unsigned long long disk_hits;
+    unsigned long long misses;
+    unsigned long long stores;
+    unsigned long long evictions;   /* LRU and expiry, memory tier */
+} response_cache_stats_t;
+
+typedef struct response_cache response_cache_t;
+
+/* Create cache
+ *
+ * Parameters:
+ *   dir         - Disk tier directory (created if missing), NULL for
+ *                 ~/.argo/cache
+ *   max_entries - Memory tier size (<= 0 uses default)
+ *   ttl_seconds - Entry lifetime (<= 0 uses default)
+ *
+ * Returns:
+ *   New cache, or NULL on allocation failure
+ */
+response_cache_t* response_cache_create(const char* dir, int max_entries, int ttl_seconds);
+
+/* Parse "bypass" | "prefer" | "only"
+ *
+ * Returns:
+ *   ARGO_SUCCESS, or E_INVALID_PARAMS for anything else
+ */
+int response_cache_parse_mode(const char* text, response_cache_mode_t* mode);
+
+/* Look up response
+ *
+ * Returns:
+ *   ARGO_SUCCESS with *response allocated (caller frees), or E_NOT_FOUND
+ */
+int response_cache_lookup(response_cache_t* cache, const response_cache_key_t* key, char** response);
+
+/* Store response in both tiers
+ *
+ * Returns:
+ *   ARGO_SUCCESS, or an error if the disk write failed (memory tier
+ *   still holds the entry)
+ */
+int response_cache_store(response_cache_t* cache, const response_cache_key_t* key, const char* response);
+
+/* Remove expired entries from both tiers
+ *
+ * Returns:
+ *   Number of disk files removed
+ */
+int response_cache_purge_expired(response_cache_t* cache);
+
+/* Snapshot of cache counters */
+void response_cache_get_stats(response_cache_t* cache, response_cache_stats_t* stats);
+
+/* Destroy cache (disk tier is kept) */
+void response_cache_destroy(response_cache_t* cache);
+
+#endif /* ARGO_RESPONSE_CACHE_H */
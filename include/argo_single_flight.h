@@ -0,0 +1,66 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_SINGLE_FLIGHT_H
+#define ARGO_SINGLE_FLIGHT_H
+
+#include <stdbool.h>
+#include "argo_ci_engine.h"
+
+/*
+ * Single Flight - coalesce identical in-flight CI queries
+ *
+ * The first caller for a key starts the query; callers arriving with the
+ * same key while it is still running join it and share its future, so
+ * N identical prompts cost one provider request. Once the query has
+ * completed, the next caller starts a fresh one (results are not reused;
+ * that is the response cache's job).
+ *
+ * A joined caller gets exactly what the first caller gets, including
+ * its deadline and errors. The last caller to leave an unfinished query
+ * cancels it. All functions are thread-safe.
+ */
+
+typedef struct single_flight single_flight_t;
+typedef struct single_flight_call single_flight_call_t;
+
+/* Starts the query for a new key; runs unlocked, in the first caller */
+typedef int (*single_flight_start_fn)(void* context, ci_future_t** future);
+
+/* Statistics */
+typedef struct {
+    int in_flight;                  /* Distinct queries running */
+    unsigned long long started;     /* Queries started */
+    unsigned long long joined;      /* Callers that shared a running query */
+} single_flight_stats_t;
+
+/* Create group (NULL on allocation failure) */
+single_flight_t* single_flight_create(void);
+
+/* Run or join the query for key
+ *
+ * Parameters:
+ *   key     - Everything that makes two queries identical (copied)
+ *   start   - Called only if no identical query is running
+ *   call    - Output: participation handle, release with single_flight_leave
+ *   shared  - Output (optional): true if an existing query was joined
+ *
+ * Returns:
+ *   ARGO_SUCCESS, or the start function's error (also for joiners)
+ */
+int single_flight_do(single_flight_t* group, const char* key,
+                     single_flight_start_fn start, void* context,
+                     single_flight_call_t** call, bool* shared);
+
+/* Shared future; valid until single_flight_leave */
+ci_future_t* single_flight_future(single_flight_call_t* call);
+
+/* Stop participating (last one out cancels an unfinished query) */
+void single_flight_leave(single_flight_t* group, single_flight_call_t* call);
+
+/* Snapshot of counters */
+void single_flight_get_stats(single_flight_t* group, single_flight_stats_t* stats);
+
+/* Destroy group (all calls must have left) */
+void single_flight_destroy(single_flight_t* group);
+
+#endif /* ARGO_SINGLE_FLIGHT_H */
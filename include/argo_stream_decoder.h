@@ -0,0 +1,97 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_STREAM_DECODER_H
+#define ARGO_STREAM_DECODER_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+ * Stream Decoder - incremental SSE / NDJSON decoding of LLM token deltas
+ *
+ * Bytes are fed as they arrive (chunks of any size, split anywhere).
+ * Each complete event is parsed as JSON and the string found at the
+ * delta pointer (RFC 6901) is passed to the delta callback. Events
+ * without it (pings, message_start, usage, finish reasons) are skipped.
+ * An event with an "error" member stops decoding with E_PROTOCOL_HTTP.
+ *
+ * SSE:    "data:" lines are joined until a blank line. Comments (':')
+ *         and other fields (event:, id:, retry:) are ignored.
+ *         "data: [DONE]" ends the stream.
+ * NDJSON: each non-empty line is one event. "done": true ends the stream.
+ */
+
+/* Wire formats */
+typedef enum {
+    STREAM_FORMAT_SSE,
+    STREAM_FORMAT_NDJSON
+} stream_format_t;
+
+/* Delta locations for known provider formats */
+#define STREAM_DELTA_OPENAI "/choices/0/delta/content"        /* OpenAI-compatible */
+#define STREAM_DELTA_CLAUDE "/delta/text"                     /* content_block_delta */
+#define STREAM_DELTA_GEMINI "/candidates/0/content/parts/0/text"
+#define STREAM_DELTA_OLLAMA "/response"                       /* /api/generate */
+
+/* Protocol markers */
+#define STREAM_SSE_DATA_FIELD "data:"
+#define STREAM_SSE_COMMENT ':'
+#define STREAM_SSE_DONE "[DONE]"
+#define STREAM_DONE_POINTER "/done"
+#define STREAM_ERROR_POINTER "/error"
+#define STREAM_ERROR_MESSAGE_POINTER "/error/message"
+
+/* Limits */
+#define STREAM_DECODER_INITIAL_CAPACITY 1024
+#define STREAM_DECODER_MAX_EVENT (1024 * 1024)
+
+/* Called once per non-empty delta; text is not NUL-terminated past len */
+typedef void (*stream_delta_fn)(const char* text, size_t len, void* userdata);
+
+/* Called with every parsed event before its delta, e.g. to read usage */
+struct json_node;
+typedef void (*stream_event_fn)(struct json_node* event, void* userdata);
+
+typedef struct stream_decoder stream_decoder_t;
+
+/* Create decoder
+ *
+ * Parameters:
+ *   format        - SSE or NDJSON
+ *   delta_pointer - JSON pointer of the text delta in each event
+ *   on_delta      - Receives each delta
+ *
+ * Returns:
+ *   New decoder, or NULL on invalid input or allocation failure
+ */
+stream_decoder_t* stream_decoder_create(stream_format_t format, const char* delta_pointer,
+                                        stream_delta_fn on_delta, void* userdata);
+
+/* Also pass each parsed event to on_event (NULL stops) */
+void stream_decoder_set_event_fn(stream_decoder_t* decoder, stream_event_fn on_event,
+                                 void* userdata);
+
+/* Feed received bytes
+ *
+ * Returns:
+ *   ARGO_SUCCESS, or the first error seen (sticky):
+ *   E_PROTOCOL_FORMAT if an event is not valid JSON
+ *   E_PROTOCOL_HTTP if the stream carried an error event
+ *   E_INPUT_TOO_LARGE if one event exceeds STREAM_DECODER_MAX_EVENT
+ *   E_SYSTEM_MEMORY on allocation failure
+ */
+int stream_decoder_feed(stream_decoder_t* decoder, const char* data, size_t len);
+
+/* Flush a final event not followed by a newline or blank line
+ *
+ * Returns: same as stream_decoder_feed
+ */
+int stream_decoder_finish(stream_decoder_t* decoder);
+
+/* True once the end-of-stream marker was seen */
+bool stream_decoder_done(const stream_decoder_t* decoder);
+
+/* Destroy decoder */
+void stream_decoder_destroy(stream_decoder_t* decoder);
+
+#endif /* ARGO_STREAM_DECODER_H */
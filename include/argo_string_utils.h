@@ -75,4 +75,13 @@ bool validate_role_name(const char* role);
  */
 size_t safe_strncpy(char* dst, const char* src, size_t size);
 
+/**
+ * Decode %XX escapes (URL path and query components) in place.
+ * Malformed escapes are left as-is.
+ *
+ * @param text String to decode (modified in place)
+ * @return text
+ */
+char* percent_decode(char* text);
+
 #endif /* ARGO_STRING_UTILS_H */
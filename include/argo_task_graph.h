@@ -0,0 +1,183 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_TASK_GRAPH_H
+#define ARGO_TASK_GRAPH_H
+
+#include <stdbool.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/types.h>
+#include "argo_limits.h"
+
+/*
+ * Task Graph (DAG) Executor
+ *
+ * Runs the tasks of a tasks.json file (as written by workflows/tools/generate_tasks)
+ * as a dependency graph instead of a serial order:
+ * - Validates ids and dependencies, detects cycles (and names one)
+ * - Runs independent tasks concurrently, up to max_parallel
+ * - Picks ready tasks critical-path-first: the task heading the longest
+ *   remaining chain of estimated work starts first
+ * - A failed task skips everything downstream of it; unrelated branches continue
+ * - Writes per-node state to a JSON status file after every transition
+ *
+ * tasks.json format:
+ * {
+ *   "tasks": [
+ *     {"id": "setup", "name": "Setup", "estimate": 2},
+ *     {"id": "implement_x", "depends_on": ["setup"], "script": "/path/x.sh"}
+ *   ]
+ * }
+ *
+ * "estimate" (relative cost, default 1) and "script" are optional. A task
+ * without a script runs the run-level runner script with its id as argument.
+ * Unknown fields (type, description, status, ...) are ignored.
+ */
+
+/* Limits */
+#define TASK_GRAPH_MAX_TASKS 4096
+#define TASK_GRAPH_ID_MAX 128
+#define TASK_GRAPH_NAME_MAX 256
+#define TASK_GRAPH_DEFAULT_ESTIMATE 1
+#define TASK_GRAPH_DEFAULT_PARALLEL 4
+#define TASK_GRAPH_MAX_PARALLEL 256
+#define TASK_GRAPH_ERROR_MAX 512
+
+/* tasks.json field names */
+#define TASK_GRAPH_JSON_TASKS "tasks"
+#define TASK_GRAPH_JSON_ID "id"
+#define TASK_GRAPH_JSON_NAME "name"
+#define TASK_GRAPH_JSON_DEPENDS "depends_on"
+#define TASK_GRAPH_JSON_ESTIMATE "estimate"
+#define TASK_GRAPH_JSON_SCRIPT "script"
+
+/* Environment passed to each task process */
+#define TASK_GRAPH_ENV_TASK_ID "ARGO_TASK_ID"
+#define TASK_GRAPH_ENV_TASK_NAME "ARGO_TASK_NAME"
+
+/* Task process plumbing */
+#define TASK_GRAPH_LOG_SUFFIX ".log"
+#define TASK_GRAPH_NULL_DEVICE "/dev/null"
+#define TASK_GRAPH_EXEC_FAILED_EXIT 127     /* Same as the shell's "command not found" */
+
+/* Node states */
+typedef enum {
+    TASK_NODE_PENDING = 0,   /* Waiting on dependencies */
+    TASK_NODE_READY,         /* Dependencies met, waiting for a slot */
+    TASK_NODE_RUNNING,       /* Process running */
+    TASK_NODE_COMPLETED,     /* Exited 0 */
+    TASK_NODE_FAILED,        /* Exited non-zero, or could not start */
+    TASK_NODE_SKIPPED        /* A dependency failed, or run was cancelled */
+} task_node_state_t;
+
+/* Task node */
+typedef struct {
+    char id[TASK_GRAPH_ID_MAX];
+    char name[TASK_GRAPH_NAME_MAX];
+    char script[ARGO_PATH_MAX];         /* Optional per-task script ("" = runner) */
+    int estimate;                       /* Relative cost, weights the critical path */
+
+    char** dep_ids;                     /* Dependency ids as written in tasks.json */
+    int* deps;                          /* Dependency node indices (after validate) */
+    int dep_count;
+    int* dependents;                    /* Nodes that depend on this one */
+    int dependent_count;
+
+    long priority;                      /* Estimated work on the longest chain from here */
+
+    /* Runtime state */
+    task_node_state_t state;
+    int pending_deps;                   /* Dependencies not yet completed */
+    pid_t pid;
+    int exit_code;
+    time_t start_time;
+    time_t end_time;
+} task_node_t;
+
+/* Task graph */
+typedef struct {
+    task_node_t* nodes;
+    int count;
+    int* order;                         /* Topological order (after validate) */
+    long critical_path;                 /* Estimated work on the longest chain */
+    bool validated;
+    char error[TASK_GRAPH_ERROR_MAX];   /* Why validation failed */
+} task_graph_t;
+
+/* Run configuration */
+typedef struct {
+    int max_parallel;                   /* Concurrent tasks (0 = default) */
+    const char* runner;                 /* Script for tasks without their own */
+    const char* working_dir;            /* Task working directory (NULL = inherit) */
+    const char* log_dir;                /* Per-task logs <log_dir>/<prefix><id>.log (NULL = inherit) */
+    const char* log_prefix;             /* Log file name prefix (NULL = "") */
+    const char* status_path;            /* Status JSON rewritten on change (NULL = none) */
+    volatile sig_atomic_t* cancel;      /* Set non-zero to stop, e.g. from a SIGINT/SIGTERM handler (NULL = never) */
+} task_graph_run_config_t;
+
+/* Parse tasks.json content
+ *
+ * Parses structure only. Call task_graph_validate() before running.
+ *
+ * Returns:
+ *   ARGO_SUCCESS on success
+ *   E_INPUT_NULL if json or graph_out is NULL
+ *   E_INPUT_FORMAT if JSON is malformed or has no tasks array
+ *   E_INPUT_TOO_LARGE if there are more than TASK_GRAPH_MAX_TASKS tasks
+ *   E_SYSTEM_MEMORY on allocation failure
+ */
+int task_graph_parse(const char* json, task_graph_t** graph_out);
+
+/* Load and parse a tasks.json file (see task_graph_parse) */
+int task_graph_load(const char* path, task_graph_t** graph_out);
+
+/* Validate graph and compute schedule
+ *
+ * Checks for empty/duplicate ids, unknown dependencies and cycles.
+ * Computes topological order and critical-path priorities.
+ * On failure graph->error describes the problem (e.g. the cycle).
+ *
+ * Returns:
+ *   ARGO_SUCCESS if the graph is a valid DAG
+ *   E_WORKFLOW_INVALID if validation fails
+ *   E_SYSTEM_MEMORY on allocation failure
+ */
+int task_graph_validate(task_graph_t* graph);
+
+/* Run all tasks
+ *
+ * Blocks until every task has finished, been skipped, or the run was
+ * cancelled. Waits on child exits (no polling). Reaps any child of the
+ * calling process, so call it from a dedicated process.
+ *
+ * SIGCHLD, SIGINT and SIGTERM are blocked while the run checks for work and
+ * delivered only inside its wait, so a handler setting config->cancel
+ * always wakes it. A SIGCHLD handler is installed for the duration.
+ *
+ * Returns:
+ *   ARGO_SUCCESS if every task completed
+ *   E_WORKFLOW_FAILED if any task failed or was skipped
+ *   E_WORKFLOW_INVALID if the graph was not validated
+ *   E_INPUT_NULL if graph or config is NULL
+ */
+int task_graph_run(task_graph_t* graph, const task_graph_run_config_t* config);
+
+/* Find node index by id (-1 if not found) */
+int task_graph_find(const task_graph_t* graph, const char* id);
+
+/* Write per-node state as JSON (atomically via rename)
+ *
+ * Returns:
+ *   ARGO_SUCCESS on success
+ *   E_INPUT_NULL if graph or path is NULL
+ *   E_SYSTEM_FILE on write failure
+ */
+int task_graph_write_status(const task_graph_t* graph, const char* path);
+
+/* Convert node state to string */
+const char* task_node_state_to_string(task_node_state_t state);
+
+/* Free graph */
+void task_graph_destroy(task_graph_t* graph);
+
+#endif /* ARGO_TASK_GRAPH_H */
@@ -0,0 +1,104 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_TEMPLATE_CATALOG_H
+#define ARGO_TEMPLATE_CATALOG_H
+
+#include "argo_workflow_template.h"
+
+/*
+ * Template Catalog - in-memory index of workflow templates
+ *
+ * Loads every directory template (<root>/<name>/workflow.sh) once and
+ * serves lookup by name and listing from memory. Names resolve through a
+ * hash index, so a lookup is O(1) and does not touch the filesystem.
+ *
+ * Freshness: on Linux each root and template directory is watched with
+ * inotify; pending change events are drained (one non-blocking read) at
+ * the start of every lookup and only the affected templates are reloaded.
+ * Without inotify (macOS) a root is rescanned when its mtime changes, so
+ * added and removed templates are seen but edits inside a template are
+ * picked up only on the next rescan.
+ *
+ * Roots are searched in the order added: the first root holding a name
+ * wins lookups, and listing shows every template with its source label.
+ * All functions are thread-safe.
+ */
+
+/* Roots */
+#define TEMPLATE_CATALOG_MAX_ROOTS 4
+#define TEMPLATE_CATALOG_SOURCE_MAX 16
+#define TEMPLATE_CATALOG_USER_DIR ".argo/workflows/templates"  /* Under $HOME */
+#define TEMPLATE_CATALOG_SYSTEM_DIR "workflows/templates"      /* Shipped with Argo */
+#define TEMPLATE_CATALOG_SOURCE_USER "user"
+#define TEMPLATE_CATALOG_SOURCE_SYSTEM "system"
+
+/* Template files */
+#define TEMPLATE_CATALOG_SCRIPT_NAME "workflow.sh"
+#define TEMPLATE_CATALOG_README_NAME "README.md"
+#define TEMPLATE_CATALOG_NO_DESCRIPTION "No description"
+#define TEMPLATE_CATALOG_MIN_SUMMARY_LEN 10  /* Shorter README lines are headings */
+
+/* Hash index */
+#define TEMPLATE_CATALOG_INITIAL_CAPACITY 32
+#define TEMPLATE_CATALOG_MIN_INDEX_SIZE 64
+#define TEMPLATE_CATALOG_HASH_SEED 2166136261u   /* FNV-1a offset basis */
+#define TEMPLATE_CATALOG_HASH_PRIME 16777619u    /* FNV-1a prime */
+
+/* One catalogued template */
+typedef struct {
+    char name[TEMPLATE_NAME_MAX];                    /* Lookup name (directory name) */
+    char source[TEMPLATE_CATALOG_SOURCE_MAX];        /* Root label, e.g. "user" */
+    char summary[TEMPLATE_DESC_MAX];                 /* First README line, else metadata description */
+    workflow_template_t info;                        /* Loaded template */
+} template_catalog_item_t;
+
+typedef struct template_catalog template_catalog_t;
+
+/* Create empty catalog
+ *
+ * Returns:
+ *   New catalog, or NULL on allocation failure (error reported)
+ */
+template_catalog_t* template_catalog_create(void);
+
+/* Add a template root and load its templates
+ *
+ * The root need not exist yet; it is picked up once it appears.
+ *
+ * Returns:
+ *   ARGO_SUCCESS on success
+ *   E_INPUT_NULL if a parameter is NULL
+ *   E_RESOURCE_LIMIT if TEMPLATE_CATALOG_MAX_ROOTS are already added
+ */
+int template_catalog_add_root(template_catalog_t* catalog, const char* path, const char* source);
+
+/* Add the standard roots: ~/.argo/workflows/templates, then workflows/templates */
+int template_catalog_add_default_roots(template_catalog_t* catalog);
+
+/* Find template by name
+ *
+ * Returns:
+ *   ARGO_SUCCESS with *item filled
+ *   E_INPUT_NULL if a parameter is NULL
+ *   E_WORKFLOW_NOT_FOUND if no root holds the template
+ */
+int template_catalog_find(template_catalog_t* catalog, const char* name,
+                          template_catalog_item_t* item);
+
+/* List all templates, ordered by root then name
+ *
+ * Parameters:
+ *   items - Output: allocated array (caller frees, NULL when empty)
+ *   count - Output: number of items
+ *
+ * Returns:
+ *   ARGO_SUCCESS on success
+ *   E_INPUT_NULL if a parameter is NULL
+ *   E_SYSTEM_MEMORY on allocation failure
+ */
+int template_catalog_list(template_catalog_t* catalog, template_catalog_item_t** items, int* count);
+
+/* Destroy catalog */
+void template_catalog_destroy(template_catalog_t* catalog);
+
+#endif /* ARGO_TEMPLATE_CATALOG_H */
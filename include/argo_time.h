@@ -0,0 +1,16 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#ifndef ARGO_TIME_H
+#define ARGO_TIME_H
+
+/*
+ * Time - clock helpers shared across modules
+ *
+ * Deadlines, timeouts and latency measurements use the monotonic clock
+ * so they are unaffected by wall-clock changes.
+ */
+
+/* Milliseconds on a monotonic clock (for deadlines and elapsed time) */
+long long argo_monotonic_ms(void);
+
+#endif /* ARGO_TIME_H */
@@ -113,8 +113,9 @@ typedef struct {
 /**
  * Wait for child process with timeout enforcement
  *
- * Non-blocking wait with periodic polling. If timeout is reached,
- * sends SIGTERM, waits 1 second, then sends SIGKILL.
+ * Event-driven wait (see argo_process_waiter.h). If timeout is reached,
+ * sends SIGTERM, and SIGKILL if the process is still running
+ * WORKFLOW_KILL_GRACE_MS later.
  *
  * This is a reusable subprocess monitoring utility.
  *
@@ -137,6 +138,24 @@ process_wait_result_t process_wait_with_timeout(pid_t pid, int timeout_seconds,
  */
 int workflow_execute(workflow_t* workflow, const char* log_path);
 
+/**
+ * Execute many workflows concurrently from one thread
+ *
+ * Keeps up to max_parallel scripts running, starting the next one as
+ * each exits. A single waiter sleeps until a child exits or the nearest
+ * timer is due: a workflow's timeout sends SIGTERM, and SIGKILL follows
+ * WORKFLOW_KILL_GRACE_MS later if it is still running. Each workflow's
+ * state, exit_code and times are updated as for workflow_execute().
+ * Script output goes to the caller's stdout/stderr. NULL entries are skipped.
+ *
+ * @param workflows Workflows to execute
+ * @param count Number of workflows
+ * @param max_parallel Concurrency limit (0 = WORKFLOW_BATCH_DEFAULT_PARALLEL)
+ * @return ARGO_SUCCESS if all completed, otherwise the first failure
+ *         (E_WORKFLOW_FAILED, E_TIMEOUT, E_SYSTEM_FORK, ...)
+ */
+int workflow_execute_many(workflow_t** workflows, int count, int max_parallel);
+
 /**
  * Destroy workflow and free resources
  *
@@ -49,6 +49,27 @@ typedef enum {
 } workflow_state_t;
 #endif
 
+/* Maximum length of a workflow stdin FIFO path */
+#define WORKFLOW_STDIN_FIFO_MAX 512
+
+/* Persistence: JSON field names and temp-file suffix for atomic save */
+#define WORKFLOW_JSON_ID "workflow_id"
+#define WORKFLOW_JSON_NAME "workflow_name"
+#define WORKFLOW_JSON_STATE "state"
+#define WORKFLOW_JSON_PID "executor_pid"
+#define WORKFLOW_JSON_START_TIME "start_time"
+#define WORKFLOW_JSON_END_TIME "end_time"
+#define WORKFLOW_JSON_EXIT_CODE "exit_code"
+#define WORKFLOW_JSON_CURRENT_STEP "current_step"
+#define WORKFLOW_JSON_TOTAL_STEPS "total_steps"
+#define WORKFLOW_JSON_TIMEOUT "timeout_seconds"
+#define WORKFLOW_JSON_RETRY_COUNT "retry_count"
+#define WORKFLOW_JSON_MAX_RETRIES "max_retries"
+#define WORKFLOW_JSON_LAST_RETRY "last_retry_time"
+#define WORKFLOW_JSON_START_TICKS "proc_start_ticks"
+#define WORKFLOW_JSON_STDIN_FIFO "stdin_fifo"
+#define WORKFLOW_REGISTRY_TMP_SUFFIX ".tmp"
+
 /* Workflow entry */
 typedef struct {
     char workflow_id[64];      /* Unique ID (e.g., "build-123") */
@@ -66,6 +87,9 @@ typedef struct {
     int retry_count;           /* Number of retries attempted */
     int max_retries;           /* Maximum retry attempts (0 = no retry) */
     time_t last_retry_time;    /* Timestamp of last retry attempt */
+    unsigned long long proc_start_ticks;  /* Executor start time (/proc/<pid>/stat), guards PID reuse */
+    char stdin_fifo[WORKFLOW_STDIN_FIFO_MAX];  /* Named FIFO feeding executor stdin ("" if none) */
+    bool reattached;           /* Adopted after daemon restart (not our child, polled for exit) */
 } workflow_entry_t;
 
 /* Opaque registry structure */
@@ -215,6 +239,9 @@ int workflow_registry_save(const workflow_registry_t* reg, const char* path);
 /* Load registry from JSON file
  *
  * Restores registry from disk. Silently succeeds if file doesn't exist.
+ * Entries whose ID already exists are skipped. Runtime-only fields
+ * (stdin_pipe, abandon_requested, reattached) are not persisted and
+ * load as zero - the daemon re-establishes them when it reattaches.
  *
  * Parameters:
  *   reg  - Registry handle (existing entries preserved)
@@ -57,14 +57,14 @@ static void print_header(const char* session_id) {
     printf("=================================================\n");
 }
 
-static void print_item(memory_item_t* item) {
+static void print_item(ci_memory_digest_t* digest, memory_item_t* item) {
     char created_str[32];
     struct tm* tm_info = localtime(&item->created);
     strftime(created_str, sizeof(created_str), "%Y-%m-%d %H:%M:%S", tm_info);
 
     printf("  [%u] %-12s relevance=%.2f  accessed=%dx\n",
            item->id, type_name(item->type),
-           item->relevance.score, item->relevance.access_count);
+           memory_stored_relevance(digest, item, time(NULL)), item->relevance.access_count);
     printf("      %s\n", item->content);
     printf("      Created: %s", created_str);
     if (item->creator_ci) {
@@ -103,11 +103,11 @@ static void print_digest_summary(ci_memory_digest_t* digest,
             continue;
         }
 
-        if (item->relevance.score < min_relevance) {
+        if (memory_stored_relevance(digest, item, time(NULL)) < min_relevance) {
             continue;
         }
 
-        print_item(item);
+        print_item(digest, item);
         shown++;
     }
 
@@ -173,7 +173,7 @@ static void print_churn_metrics(ci_memory_digest_t* digest) {
         if (!item) continue;
 
         /* High access but dropping relevance = churn */
-        if (item->relevance.access_count > 5 && item->relevance.score < 0.3) {
+        if (item->relevance.access_count > 5 && memory_stored_relevance(digest, item, time(NULL)) < 0.3) {
             high_churn++;
         } else if (item->relevance.access_count > 3) {
             stable++;
@@ -278,7 +278,7 @@ int main(int argc, char* argv[]) {
 
     /* Update some relevance scores */
     if (digest->selected_count > 1) {
-        memory_update_relevance(digest->selected[1], 0.9f);
+        memory_update_relevance(digest, digest->selected[1], 0.9f);
     }
 
     /* Display */
@@ -11,6 +11,16 @@
 #include "argo_daemon_api.h"
 #include "argo_daemon_tasks.h"
 #include "argo_daemon_workflow.h"
+#include "argo_daemon_workflow_recovery.h"
+#include "argo_template_catalog.h"
+#include "argo_project_state.h"
+#include "argo_ci_engine.h"
+#include "argo_provider_pool.h"
+#include "argo_response_cache.h"
+#include "argo_single_flight.h"
+#include "argo_provider_router.h"
+#include "argo_claude_session_pool.h"
+#include "argo_daemon_ci_api.h"
 #include "argo_daemon_exit_queue.h"
 #include "argo_error.h"
 #include "argo_http_server.h"
@@ -67,8 +77,7 @@ argo_daemon_t* argo_daemon_create(uint16_t port) {
     daemon->exit_queue = calloc(1, sizeof(exit_code_queue_t));
     if (!daemon->exit_queue) {
         argo_report_error(E_SYSTEM_MEMORY, "argo_daemon_create", "exit queue allocation failed");
-        free(daemon);
-        return NULL;
+        goto cleanup;
     }
     exit_queue_init(daemon->exit_queue);
 
@@ -76,59 +85,106 @@ argo_daemon_t* argo_daemon_create(uint16_t port) {
     daemon->workflow_registry = workflow_registry_create();
     if (!daemon->workflow_registry) {
         argo_report_error(E_SYSTEM_MEMORY, "argo_daemon_create", "workflow registry creation failed");
-        free(daemon->exit_queue);
-        free(daemon);
-        return NULL;
+        goto cleanup;
     }
 
     /* Create HTTP server */
     daemon->http_server = http_server_create(port);
     if (!daemon->http_server) {
         argo_report_error(E_SYSTEM_MEMORY, "argo_daemon_create", "HTTP server creation failed");
-        workflow_registry_destroy(daemon->workflow_registry);
-        free(daemon->exit_queue);
-        free(daemon);
-        return NULL;
+        goto cleanup;
     }
 
     /* Create registry */
     daemon->registry = registry_create();
     if (!daemon->registry) {
         argo_report_error(E_SYSTEM_MEMORY, "argo_daemon_create", "registry creation failed");
-        http_server_destroy(daemon->http_server);
-        workflow_registry_destroy(daemon->workflow_registry);
-        free(daemon->exit_queue);
-        free(daemon);
-        return NULL;
+        goto cleanup;
     }
 
     /* Create lifecycle manager */
     daemon->lifecycle = lifecycle_manager_create(daemon->registry);
     if (!daemon->lifecycle) {
         argo_report_error(E_SYSTEM_MEMORY, "argo_daemon_create", "lifecycle manager creation failed");
-        registry_destroy(daemon->registry);
-        http_server_destroy(daemon->http_server);
-        workflow_registry_destroy(daemon->workflow_registry);
-        free(daemon->exit_queue);
-        free(daemon);
-        return NULL;
+        goto cleanup;
     }
 
     /* Create shared services */
     daemon->shared_services = shared_services_create();
     if (!daemon->shared_services) {
         argo_report_error(E_SYSTEM_MEMORY, "argo_daemon_create", "shared services creation failed");
-        lifecycle_manager_destroy(daemon->lifecycle);
-        registry_destroy(daemon->registry);
-        http_server_destroy(daemon->http_server);
-        workflow_registry_destroy(daemon->workflow_registry);
-        free(daemon->exit_queue);
-        free(daemon);
-        return NULL;
+        goto cleanup;
+    }
+
+    /* Create template catalog (loads user and system templates) */
+    daemon->template_catalog = template_catalog_create();
+    if (!daemon->template_catalog) {
+        argo_report_error(E_SYSTEM_MEMORY, "argo_daemon_create", "template catalog creation failed");
+        goto cleanup;
+    }
+    template_catalog_add_default_roots(daemon->template_catalog);
+
+    /* Create project state store (projects resolved via ~/.argo/projects.json) */
+    daemon->project_state = project_state_store_create(NULL);
+    if (!daemon->project_state) {
+        argo_report_error(E_SYSTEM_MEMORY, "argo_daemon_create", "project state store creation failed");
+        goto cleanup;
+    }
+
+    /* Create CI query engine */
+    daemon->ci_engine = ci_engine_create(CI_ENGINE_DEFAULT_WORKERS);
+    if (!daemon->ci_engine) {
+        argo_report_error(E_SYSTEM_THREAD, "argo_daemon_create", "CI engine creation failed");
+        goto cleanup;
+    }
+
+    /* Create warm provider pool for CI queries */
+    daemon->provider_pool = provider_pool_create(api_ci_create_provider,
+                                                 PROVIDER_POOL_DEFAULT_MAX_SIZE,
+                                                 PROVIDER_POOL_DEFAULT_IDLE_SECONDS);
+    if (!daemon->provider_pool) {
+        argo_report_error(E_SYSTEM_MEMORY, "argo_daemon_create", "provider pool creation failed");
+        goto cleanup;
+    }
+
+    /* Create CI response cache (used only when a query opts in) */
+    daemon->response_cache = response_cache_create(NULL, RESPONSE_CACHE_DEFAULT_MAX_ENTRIES,
+                                                   RESPONSE_CACHE_DEFAULT_TTL_SECONDS);
+    if (!daemon->response_cache) {
+        argo_report_error(E_SYSTEM_MEMORY, "argo_daemon_create", "response cache creation failed");
+        goto cleanup;
+    }
+
+    /* Create in-flight CI query coalescing */
+    daemon->single_flight = single_flight_create();
+    if (!daemon->single_flight) {
+        argo_report_error(E_SYSTEM_MEMORY, "argo_daemon_create", "single flight creation failed");
+        goto cleanup;
+    }
+
+    /* Create provider router and load configured routes */
+    daemon->provider_router = provider_router_create();
+    if (!daemon->provider_router) {
+        argo_report_error(E_SYSTEM_MEMORY, "argo_daemon_create", "provider router creation failed");
+        goto cleanup;
+    }
+
+    /* A bad route is not fatal: queries naming it fail as unknown routes */
+    int routes = 0;
+    if (provider_router_load_config(daemon->provider_router, &routes) != ARGO_SUCCESS) {
+        LOG_WARN("Provider routes from %s partly loaded (%d routes)",
+                 PROVIDER_ROUTER_ROUTES_CONFIG_KEY, routes);
+    } else if (routes > 0) {
+        LOG_INFO("Loaded %d provider routes", routes);
     }
 
     LOG_INFO("Daemon created with workflow registry and shared services");
     return daemon;
+
+cleanup:
+    /* Destroy handles a partly built daemon (unset members are NULL) */
+    argo_daemon_destroy(daemon);
+    return NULL;
 }
 
 /* Destroy daemon */
@@ -161,6 +217,38 @@ void argo_daemon_destroy(argo_daemon_t* daemon) {
         free(daemon->exit_queue);
     }
 
+    if (daemon->template_catalog) {
+        template_catalog_destroy(daemon->template_catalog);
+    }
+
+    if (daemon->project_state) {
+        project_state_store_destroy(daemon->project_state);
+    }
+
+    if (daemon->ci_engine) {
+        ci_engine_destroy(daemon->ci_engine);
+    }
+
+    /* After the engine, which checks its providers back in on shutdown */
+    if (daemon->provider_pool) {
+        provider_pool_destroy(daemon->provider_pool);
+    }
+
+    if (daemon->response_cache) {
+        response_cache_destroy(daemon->response_cache);
+    }
+
+    if (daemon->single_flight) {
+        single_flight_destroy(daemon->single_flight);
+    }
+
+    if (daemon->provider_router) {
+        provider_router_destroy(daemon->provider_router);
+    }
+
+    /* Session workers outlive providers; no turn can run once the engine is gone */
+    claude_session_pool_cleanup();
+
     free(daemon);
     LOG_INFO("Daemon destroyed");
 }
@@ -233,6 +321,12 @@ int argo_daemon_start(argo_daemon_t* daemon) {
     /* Register API routes */
     argo_daemon_register_api_routes(daemon);
 
+    /* Adopt executors that kept running across a daemon restart */
+    int reattached = workflow_recovery_reattach(daemon);
+    if (reattached < 0) {
+        LOG_WARN("Workflow recovery failed (error %d), starting with empty registry", reattached);
+    }
+
     /* Start shared services and register background tasks */
     if (daemon->shared_services) {
         /* Register workflow timeout monitoring task */
@@ -253,6 +347,24 @@ int argo_daemon_start(argo_daemon_t* daemon) {
                                      daemon,
                                      LOG_ROTATION_CHECK_INTERVAL_SECONDS);
 
+        /* Register idle provider eviction task */
+        shared_services_register_task(daemon->shared_services,
+                                     provider_pool_task,
+                                     daemon,
+                                     PROVIDER_POOL_EVICT_INTERVAL_SECONDS);
+
+        /* Register expired response cache purge task */
+        shared_services_register_task(daemon->shared_services,
+                                     response_cache_task,
+                                     daemon,
+                                     RESPONSE_CACHE_PURGE_INTERVAL_SECONDS);
+
+        /* Register idle claude session worker reap task */
+        shared_services_register_task(daemon->shared_services,
+                                     claude_session_task,
+                                     daemon,
+                                     PROVIDER_POOL_EVICT_INTERVAL_SECONDS);
+
         /* Start shared services thread */
         int svc_result = shared_services_start(daemon->shared_services);
         if (svc_result != ARGO_SUCCESS) {
@@ -266,7 +378,16 @@ int argo_daemon_start(argo_daemon_t* daemon) {
     LOG_INFO("Argo Daemon starting on port %d", daemon->port);
 
     /* Start HTTP server (blocking) */
-    return http_server_start(daemon->http_server);
+    int result = http_server_start(daemon->http_server);
+
+    /* Executors outlive the daemon - record where they are for the next start.
+     * Stop the services thread first: it owns the registry. */
+    if (daemon->shared_services) {
+        shared_services_stop(daemon->shared_services);
+    }
+    workflow_recovery_save(daemon);
+
+    return result;
 }
 
 /* Stop daemon */
@@ -10,6 +10,9 @@
 #include "argo_daemon.h"
 #include "argo_http_server.h"
 #include "argo_daemon_ci_api.h"
+#include "argo_daemon_dag_api.h"
+#include "argo_daemon_template_api.h"
+#include "argo_daemon_project_api.h"
 #include "argo_error.h"
 #include "argo_log.h"
 
@@ -54,6 +57,22 @@ int argo_daemon_register_api_routes(argo_daemon_t* daemon) {
     http_server_add_route(daemon->http_server, HTTP_METHOD_POST,
                          "/api/workflow/input", api_workflow_input);
 
+    /* Task graph routes (parallel tasks.json runs) */
+    http_server_add_route(daemon->http_server, HTTP_METHOD_POST,
+                         "/api/workflow/dag", api_workflow_dag_start);
+    http_server_add_route(daemon->http_server, HTTP_METHOD_GET,
+                         "/api/workflow/dag", api_workflow_dag_status);
+
+    /* Template catalog routes */
+    http_server_add_route(daemon->http_server, HTTP_METHOD_GET,
+                         TEMPLATE_API_PATH, api_templates);
+
+    /* Project state routes */
+    http_server_add_route(daemon->http_server, HTTP_METHOD_GET,
+                         PROJECT_API_PATH, api_project_state_get);
+    http_server_add_route(daemon->http_server, HTTP_METHOD_PATCH,
+                         PROJECT_API_PATH, api_project_state_patch);
+
     /* Registry routes */
     http_server_add_route(daemon->http_server, HTTP_METHOD_GET,
                          "/api/registry/ci", api_registry_list_ci);
@@ -61,6 +80,10 @@ int argo_daemon_register_api_routes(argo_daemon_t* daemon) {
     /* CI query routes */
     http_server_add_route(daemon->http_server, HTTP_METHOD_POST,
                          "/api/ci/query", api_ci_query);
+    http_server_add_route(daemon->http_server, HTTP_METHOD_GET,
+                         CI_API_CACHE_PATH, api_ci_cache_stats);
+    http_server_add_route(daemon->http_server, HTTP_METHOD_GET,
+                         CI_API_PROVIDER_STATS_PATH, api_provider_stats);
 
     LOG_INFO("API routes registered (workflow + CI API ready)");
     return ARGO_SUCCESS;
@@ -1,5 +1,6 @@
 /* © 2025 Casey Koons All rights reserved */
-/* Daemon CI Query API - POST /api/ci/query */
+/* Daemon CI Query API - POST /api/ci/query (single or fan-out via CI engine),
+ * GET /api/ci/cache, GET /api/providers/stats */
 
 /* System includes */
 #include <stdio.h>
@@ -8,77 +9,25 @@
 
 /* Project includes */
 #include "argo_daemon_ci_api.h"
+#include "argo_daemon_ci_helpers.h"
 #include "argo_daemon.h"
+#include "argo_daemon_api.h"
 #include "argo_http_server.h"
-#include "argo_json.h"
+#include "argo_json_doc.h"
 #include "argo_error.h"
 #include "argo_limits.h"
 #include "argo_log.h"
 #include "argo_api_providers.h"
 #include "argo_ci.h"
-#include "argo_config.h"
-
-/* Callback to capture AI response */
-static void response_callback(const ci_response_t* response, void* userdata) {
-    char** output = (char**)userdata;
-    if (response && response->success && response->content) {
-        *output = strdup(response->content);
-    }
-}
-
-/* Parse CI query request and extract fields */
-static int parse_ci_query_request(const char* body, char** query_text,
-                                   char** provider_name, char** model_name) {
-    int result;
-
-    /* Extract query field */
-    const char* query_path[] = {"query"};
-    size_t query_len = 0;
-    result = json_extract_nested_string(body, query_path, 1, query_text, &query_len);
-    if (result != ARGO_SUCCESS || !*query_text) {
-        free(*query_text);
-        return E_INPUT_FORMAT;
-    }
-
-    /* Extract optional provider field (priority: request > config > default) */
-    const char* provider_path[] = {"provider"};
-    size_t provider_len = 0;
-    result = json_extract_nested_string(body, provider_path, 1, provider_name, &provider_len);
-    if (result != ARGO_SUCCESS || !*provider_name) {
-        /* Not in request - check config for CI_DEFAULT_PROVIDER */
-        const char* config_provider = argo_config_get("CI_DEFAULT_PROVIDER");
-        if (config_provider) {
-            *provider_name = strdup(config_provider);
-            LOG_INFO("Using provider from config: %s", *provider_name);
-        } else {
-            /* Fall back to built-in default */
-            *provider_name = strdup("claude_code");
-            LOG_INFO("Using built-in default provider: claude_code");
-        }
-    }
-
-    /* Extract optional model field (priority: request > config > provider default) */
-    const char* model_path[] = {"model"};
-    size_t model_len = 0;
-    result = json_extract_nested_string(body, model_path, 1, model_name, &model_len);
-    if (result != ARGO_SUCCESS || !*model_name) {
-        /* Not in request - check config for CI_DEFAULT_MODEL */
-        const char* config_model = argo_config_get("CI_DEFAULT_MODEL");
-        if (config_model) {
-            *model_name = strdup(config_model);
-            LOG_INFO("Using model from config: %s", *model_name);
-        }
-        /* else NULL is fine - provider will use its default */
-    }
-
-    LOG_INFO("CI Query: provider=%s, model=%s, query_len=%zu",
-             *provider_name, *model_name ? *model_name : "default", query_len);
-
-    return ARGO_SUCCESS;
-}
+#include "argo_ci_engine.h"
+#include "argo_response_cache.h"
+#include "argo_single_flight.h"
+#include "argo_provider_router.h"
+#include "argo_provider_telemetry.h"
+#include "argo_json_builder.h"
 
 /* Create CI provider by name */
-static ci_provider_t* create_ci_provider(const char* provider_name, const char* model_name) {
+ci_provider_t* api_ci_create_provider(const char* provider_name, const char* model_name) {
     if (strcmp(provider_name, "claude_code") == 0) {
         return claude_code_create_provider(model_name);
     } else if (strcmp(provider_name, "claude_api") == 0) {
@@ -97,79 +46,257 @@ static ci_provider_t* create_ci_provider(const char* provider_name, const char*
     return NULL;
 }
 
-/* Execute provider query with init, connect, query sequence */
-static int execute_provider_query(ci_provider_t* provider, const char* query_text,
-                                   char** ai_response) {
-    int result;
+/* Helper: Routed query - best healthy candidate with failover (not coalesced) */
+static int handle_routed_query(const ci_query_spec_t* spec, int timeout_ms, response_cache_mode_t mode,
+                               http_response_t* resp) {
+    router_result_t routed;
+    char* response_json = NULL;
 
-    /* Initialize provider */
-    if (provider->init) {
-        result = provider->init(provider);
-        if (result != ARGO_SUCCESS) {
-            return result;
-        }
+    int result = provider_router_query(g_api_daemon->provider_router, spec->route, start_routed,
+                                       spec->query, timeout_ms, spec->hedge, &routed);
+    if (result != ARGO_SUCCESS) {
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, query_error_message(result));
+        return result;
+    }
+
+    remember_answer(spec, mode, routed.content);
+
+    /* Report the provider that answered */
+    result = format_ci_response(routed.provider, routed.content, false, &response_json);
+    if (result != ARGO_SUCCESS) {
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, "Failed to format response");
+    } else {
+        http_response_set_json(resp, HTTP_STATUS_OK, response_json);
     }
 
-    /* Connect provider */
-    if (provider->connect) {
-        result = provider->connect(provider);
+    free(routed.content);
+    free(response_json);
+    return result;
+}
+
+/* Helper: Single query - {"query","provider","model"} or {"query","route","hedge"} */
+static int handle_single_query(json_node_t* body, int timeout_ms, response_cache_mode_t mode,
+                               http_response_t* resp) {
+    ci_query_spec_t spec = {0};
+    single_flight_call_t* call = NULL;
+    bool shared = false;
+    char* response_json = NULL;
+
+    /* Parse request fields */
+    int result = parse_ci_query_request(body, true, &spec);
+    if (result != ARGO_SUCCESS) {
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, "Missing 'query' field");
+        goto cleanup;
+    }
+    if (spec.route && spec.session) {
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, "'session' cannot be combined with 'route'");
+        result = E_INVALID_PARAMS;
+        goto cleanup;
+    }
+    if (spec.route && !provider_router_has_route(g_api_daemon->provider_router, spec.route)) {
+        char error_msg[ARGO_BUFFER_MEDIUM];
+        snprintf(error_msg, sizeof(error_msg), "Unknown route: %s", spec.route);
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, error_msg);
+        result = E_INVALID_PARAMS;
+        goto cleanup;
+    }
+
+    /* Cached answer skips the provider entirely */
+    if (serve_from_cache(&spec, mode)) {
+        result = format_ci_response(spec.route ? spec.route : spec.provider, spec.cached, true, &response_json);
         if (result != ARGO_SUCCESS) {
-            return result;
+            http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, "Failed to format response");
+            goto cleanup;
         }
+        http_response_set_json(resp, HTTP_STATUS_OK, response_json);
+        goto cleanup;
+    }
+    if (mode == RESPONSE_CACHE_ONLY) {
+        http_response_set_error(resp, HTTP_STATUS_NOT_FOUND, "Response not cached");
+        result = E_NOT_FOUND;
+        goto cleanup;
     }
 
-    /* Execute query with callback */
-    result = provider->query(provider, query_text, response_callback, ai_response);
+    if (spec.route) {
+        result = handle_routed_query(&spec, timeout_ms, mode, resp);
+        goto cleanup;
+    }
+
+    /* Check out provider and submit (or join the identical query in flight) */
+    result = submit_query(&spec, timeout_ms, &call, &shared);
+    if (result == E_NOT_FOUND) {
+        char error_msg[ARGO_BUFFER_MEDIUM];
+        snprintf(error_msg, sizeof(error_msg), "Unknown provider: %s", spec.provider);
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, error_msg);
+        result = E_INVALID_PARAMS;
+        goto cleanup;
+    }
     if (result != ARGO_SUCCESS) {
-        return result;
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, query_error_message(result));
+        goto cleanup;
     }
 
-    if (!*ai_response) {
-        return E_SYSTEM_PROCESS;
+    /* Wait for the engine (deadline enforced there) */
+    ci_future_t* future = single_flight_future(call);
+    ci_future_wait(future, CI_ENGINE_NO_TIMEOUT);
+    const ci_response_t* answer = ci_future_response(future);
+    if (!answer->success) {
+        result = answer->error_code;
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, query_error_message(result));
+        goto cleanup;
     }
 
-    return ARGO_SUCCESS;
+    if (!shared) {
+        remember_answer(&spec, mode, answer->content);
+    }
+
+    /* Format response */
+    result = format_ci_response(spec.provider, answer->content, false, &response_json);
+    if (result != ARGO_SUCCESS) {
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, "Failed to format response");
+        goto cleanup;
+    }
+
+    /* Send success response */
+    http_response_set_json(resp, HTTP_STATUS_OK, response_json);
+
+cleanup:
+    single_flight_leave(g_api_daemon->single_flight, call);
+    free_query_spec(&spec);
+    free(response_json);
+    return result;
 }
 
-/* Format CI response as JSON */
-static int format_ci_response(const char* provider_name, const char* ai_response,
-                               char** response_json_out) {
-    size_t response_size = strlen(ai_response) * RESPONSE_SIZE_MULTIPLIER + RESPONSE_SIZE_OVERHEAD;
-    char* response_json = malloc(response_size);
-    if (!response_json) {
-        return E_SYSTEM_MEMORY;
+/* Helper: Result entry for one fanned-out query */
+static json_node_t* fan_out_entry(const ci_query_spec_t* spec, ci_future_t* future,
+                                  int submit_result, response_cache_mode_t mode) {
+    json_node_t* entry = json_doc_new_object();
+    if (!entry) return NULL;
+
+    const ci_response_t* answer = future ? ci_future_response(future) : NULL;
+    const char* content = spec->cached ? spec->cached : (answer && answer->success ? answer->content : NULL);
+    int error_code = answer ? answer->error_code : submit_result;
+    const char* error = error_code == E_NOT_FOUND ? "Unknown provider" : query_error_message(error_code);
+    if (!future && mode == RESPONSE_CACHE_ONLY) {
+        error = "Response not cached";
     }
 
-    /* Build JSON with escaping */
-    size_t offset = 0;
-    offset += snprintf(response_json + offset, response_size - offset,
-                      "{\"status\":\"success\",\"provider\":\"%s\",\"response\":\"",
-                      provider_name);
+    json_doc_append(entry, "provider", json_doc_new_string(spec->provider ? spec->provider : ""));
+    json_doc_append(entry, "status", json_doc_new_string(content ? "success" : "error"));
+    json_doc_append(entry, content ? "response" : "error", json_doc_new_string(content ? content : error));
+    if (spec->cached) {
+        json_doc_append(entry, "cached", json_doc_new_bool(true));
+    }
+    return entry;
+}
 
-    int result = json_escape_string(response_json, response_size, &offset, ai_response);
-    if (result != ARGO_SUCCESS) {
-        free(response_json);
-        return result;
+/* Helper: Fan-out - {"queries":[{...},...]}, all in flight at once */
+static int handle_fan_out(json_node_t* queries, int timeout_ms, response_cache_mode_t mode,
+                          http_response_t* resp) {
+    int count = queries->count;
+    int result = ARGO_SUCCESS;
+    char* json = NULL;
+    json_node_t* out = NULL;
+    json_node_t* responses = NULL;
+
+    if (count == 0 || count > CI_API_MAX_QUERIES) {
+        char error_msg[ARGO_BUFFER_SMALL];
+        snprintf(error_msg, sizeof(error_msg), "'queries' must hold 1-%d queries", CI_API_MAX_QUERIES);
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, error_msg);
+        return E_INVALID_PARAMS;
     }
 
-    offset += snprintf(response_json + offset, response_size - offset, "\"}");
+    ci_query_spec_t* specs = calloc((size_t)count, sizeof(ci_query_spec_t));
+    single_flight_call_t** calls = calloc((size_t)count, sizeof(single_flight_call_t*));
+    bool* shared = calloc((size_t)count, sizeof(bool));
+    int* submitted = calloc((size_t)count, sizeof(int));
+    if (!specs || !calls || !shared || !submitted) {
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, DAEMON_ERR_ALLOCATION_FAILED);
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
 
-    *response_json_out = response_json;
-    return ARGO_SUCCESS;
+    /* Validate everything before starting anything */
+    for (int i = 0; i < count; i++) {
+        result = parse_ci_query_request(queries->children[i], false, &specs[i]);
+        if (result == E_INVALID_PARAMS) {
+            http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, "'route' is only supported for single queries");
+            goto cleanup;
+        }
+        if (result != ARGO_SUCCESS) {
+            http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, "Missing 'query' field");
+            result = E_INPUT_FORMAT;
+            goto cleanup;
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (serve_from_cache(&specs[i], mode) || mode == RESPONSE_CACHE_ONLY) {
+            continue;
+        }
+        submitted[i] = submit_query(&specs[i], timeout_ms, &calls[i], &shared[i]);
+    }
+
+    /* Total wait is the slowest query, not the sum */
+    out = json_doc_new_object();
+    responses = json_doc_new_array();
+    if (!out || !responses) {
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
+    for (int i = 0; i < count; i++) {
+        ci_future_t* future = single_flight_future(calls[i]);
+        if (future) {
+            ci_future_wait(future, CI_ENGINE_NO_TIMEOUT);
+            const ci_response_t* answer = ci_future_response(future);
+            if (answer->success && !shared[i]) {
+                remember_answer(&specs[i], mode, answer->content);
+            }
+        }
+        json_node_t* entry = fan_out_entry(&specs[i], future, submitted[i], mode);
+        if (!entry || json_doc_append(responses, NULL, entry) != ARGO_SUCCESS) {
+            json_doc_free(entry);
+            result = E_SYSTEM_MEMORY;
+            goto cleanup;
+        }
+    }
+
+    json_doc_append(out, "status", json_doc_new_string("success"));
+    if (json_doc_append(out, "responses", responses) == ARGO_SUCCESS) {
+        responses = NULL;
+    }
+    json = json_doc_serialize(out);
+    if (!json) {
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
+    http_response_set_json(resp, HTTP_STATUS_OK, json);
+
+cleanup:
+    if (result == E_SYSTEM_MEMORY) {
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, DAEMON_ERR_ALLOCATION_FAILED);
+    }
+    for (int i = 0; calls && i < count; i++) {
+        single_flight_leave(g_api_daemon->single_flight, calls[i]);
+    }
+    for (int i = 0; specs && i < count; i++) {
+        free_query_spec(&specs[i]);
+    }
+    free(specs);
+    free(calls);
+    free(shared);
+    free(submitted);
+    json_doc_free(responses);
+    json_doc_free(out);
+    free(json);
+    return result;
 }
 
-/* POST /api/ci/query - Query AI provider */
+/* POST /api/ci/query - Query one or many AI providers */
 int api_ci_query(http_request_t* req, http_response_t* resp) {
-    int result = ARGO_SUCCESS;
-    char* query_text = NULL;
-    char* provider_name = NULL;
-    char* model_name = NULL;
-    char* ai_response = NULL;
-    char* response_json = NULL;
-    ci_provider_t* provider = NULL;
-
     /* Validate request */
-    if (!req || !resp) {
+    if (!req || !resp || !g_api_daemon || !g_api_daemon->ci_engine || !g_api_daemon->provider_pool ||
+        !g_api_daemon->single_flight) {
         http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, DAEMON_ERR_INTERNAL_SERVER);
         return E_SYSTEM_MEMORY;
     }
@@ -179,53 +306,140 @@ int api_ci_query(http_request_t* req, http_response_t* resp) {
         return E_INPUT_NULL;
     }
 
-    /* Parse request fields */
-    result = parse_ci_query_request(req->body, &query_text, &provider_name, &model_name);
-    if (result != ARGO_SUCCESS) {
-        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, "Missing 'query' field");
-        goto cleanup;
+    json_node_t* body = NULL;
+    int result = json_doc_parse(req->body, req->body_length, &body);
+    if (result != ARGO_SUCCESS || body->type != JSON_DOC_OBJECT) {
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, DAEMON_ERR_INVALID_JSON);
+        json_doc_free(body);
+        return E_INPUT_FORMAT;
     }
 
-    /* Create provider */
-    provider = create_ci_provider(provider_name, model_name);
-    if (!provider) {
-        char error_msg[ARGO_BUFFER_MEDIUM];
-        snprintf(error_msg, sizeof(error_msg), "Unknown provider: %s", provider_name);
-        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, error_msg);
-        result = E_INVALID_PARAMS;
-        goto cleanup;
+    /* Optional per-request deadline */
+    long long timeout_ms = 0;
+    json_node_t* timeout = json_doc_get(body, "/timeout_ms");
+    if (timeout && (!json_doc_get_integer(timeout, &timeout_ms) ||
+                    timeout_ms <= 0 || timeout_ms > CI_API_MAX_TIMEOUT_MS)) {
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, "Invalid 'timeout_ms'");
+        json_doc_free(body);
+        return E_INVALID_PARAMS;
     }
 
-    /* Execute query */
-    result = execute_provider_query(provider, query_text, &ai_response);
-    if (result != ARGO_SUCCESS) {
-        const char* error_msg = "Query execution failed";
-        if (result == E_SYSTEM_PROCESS) {
-            error_msg = "No response from AI provider";
-        }
-        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, error_msg);
-        goto cleanup;
+    /* Optional response cache control (default bypass) */
+    response_cache_mode_t mode = RESPONSE_CACHE_BYPASS;
+    json_node_t* cache = json_doc_get(body, "/cache");
+    if (cache && (cache->type != JSON_DOC_STRING ||
+                  response_cache_parse_mode(cache->text, &mode) != ARGO_SUCCESS)) {
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, "Invalid 'cache' (bypass, prefer or only)");
+        json_doc_free(body);
+        return E_INVALID_PARAMS;
     }
 
-    /* Format response */
-    result = format_ci_response(provider_name, ai_response, &response_json);
-    if (result != ARGO_SUCCESS) {
-        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, "Failed to format response");
-        goto cleanup;
+    json_node_t* queries = json_doc_get(body, "/queries");
+    if (queries && queries->type == JSON_DOC_ARRAY) {
+        result = handle_fan_out(queries, (int)timeout_ms, mode, resp);
+    } else {
+        result = handle_single_query(body, (int)timeout_ms, mode, resp);
     }
 
-    /* Send success response */
-    http_response_set_json(resp, HTTP_STATUS_OK, response_json);
+    json_doc_free(body);
+    return result;
+}
 
-cleanup:
-    free(query_text);
-    free(provider_name);
-    free(model_name);
-    free(response_json);
+/* GET /api/ci/cache - Response cache counters */
+int api_ci_cache_stats(http_request_t* req, http_response_t* resp) {
+    (void)req;
+    if (!resp || !g_api_daemon) {
+        return E_INPUT_NULL;
+    }
+
+    response_cache_stats_t stats;
+    response_cache_get_stats(g_api_daemon->response_cache, &stats);
+
+    char json[ARGO_BUFFER_STANDARD];
+    snprintf(json, sizeof(json),
+             "{\"status\":\"success\",\"cache\":{\"entries\":%d,\"memory_hits\":%llu,"
+             "\"disk_hits\":%llu,\"misses\":%llu,\"stores\":%llu,\"evictions\":%llu}}",
+             stats.entries, stats.memory_hits, stats.disk_hits, stats.misses,
+             stats.stores, stats.evictions);
+    http_response_set_json(resp, HTTP_STATUS_OK, json);
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Append one provider/model telemetry object */
+static void append_provider_stats(json_builder_t* json, const provider_telemetry_stats_t* stats) {
+    unsigned long long calls = stats->calls ? stats->calls : 1;
+
+    json_builder_object_begin(json);
+    json_builder_key_string(json, "provider", stats->provider);
+    json_builder_key_string(json, "model", stats->model);
+    json_builder_key_int(json, "calls", (long long)stats->calls);
+    json_builder_key_int(json, "failures", (long long)stats->failures);
+    json_builder_key_int(json, "streamed", (long long)stats->streamed);
+    json_builder_key_int(json, "request_bytes", (long long)stats->request_bytes);
+    json_builder_key_int(json, "response_bytes", (long long)stats->response_bytes);
+    json_builder_key_int(json, "prompt_tokens", (long long)stats->prompt_tokens);
+    json_builder_key_int(json, "completion_tokens", (long long)stats->completion_tokens);
+    json_builder_key_int(json, "avg_queue_ms", (long long)(stats->queue_ms / calls));
+    json_builder_key_int(json, "avg_ttfb_ms", stats->ttfb_samples
+                         ? (long long)(stats->ttfb_ms / stats->ttfb_samples) : 0);
+    json_builder_key_int(json, "avg_latency_ms", (long long)(stats->total_ms / calls));
+    json_builder_key_int(json, "p50_ms", provider_telemetry_percentile(stats, 50.0));
+    json_builder_key_int(json, "p95_ms", provider_telemetry_percentile(stats, 95.0));
+    json_builder_key_int(json, "p99_ms", provider_telemetry_percentile(stats, 99.0));
+    json_builder_key_int(json, "max_ms", stats->max_ms);
+    json_builder_key(json, "histogram");
+    json_builder_array_begin(json);
+    for (int i = 0; i < PROVIDER_TELEMETRY_BUCKETS; i++) {
+        json_builder_int(json, (long long)stats->histogram[i]);
+    }
+    json_builder_array_end(json);
+    json_builder_key_int(json, "last_call", (long long)stats->last_call);
+    json_builder_object_end(json);
+}
 
-    if (provider && provider->cleanup) {
-        provider->cleanup(provider);
+/* GET /api/providers/stats - Usage and latency per provider/model */
+int api_provider_stats(http_request_t* req, http_response_t* resp) {
+    (void)req;
+    if (!resp) {
+        return E_INPUT_NULL;
     }
 
+    provider_telemetry_stats_t* stats = calloc(PROVIDER_TELEMETRY_MAX_ENTRIES,
+                                               sizeof(provider_telemetry_stats_t));
+    json_builder_t json;
+    if (!stats || json_builder_init(&json, CI_API_STATS_SIZE_HINT) != ARGO_SUCCESS) {
+        free(stats);
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, DAEMON_ERR_ALLOCATION_FAILED);
+        return E_SYSTEM_MEMORY;
+    }
+    int count = provider_telemetry_get_stats(stats, PROVIDER_TELEMETRY_MAX_ENTRIES);
+
+    json_builder_object_begin(&json);
+    json_builder_key_string(&json, "status", "success");
+    json_builder_key(&json, "buckets_ms");
+    json_builder_array_begin(&json);
+    const long long* bounds = provider_telemetry_bucket_bounds();
+    for (int i = 0; i < PROVIDER_TELEMETRY_BUCKETS - 1; i++) {
+        json_builder_int(&json, bounds[i]);
+    }
+    json_builder_array_end(&json);
+    json_builder_key(&json, "providers");
+    json_builder_array_begin(&json);
+    for (int i = 0; i < count; i++) {
+        append_provider_stats(&json, &stats[i]);
+    }
+    json_builder_array_end(&json);
+    json_builder_key_int(&json, "count", count);
+    json_builder_object_end(&json);
+
+    char* body = json_builder_take(&json, NULL);
+    int result = body ? ARGO_SUCCESS : E_SYSTEM_MEMORY;
+    if (body) {
+        http_response_set_json(resp, HTTP_STATUS_OK, body);
+    } else {
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, DAEMON_ERR_INTERNAL_SERVER);
+    }
+    free(body);
+    free(stats);
     return result;
 }
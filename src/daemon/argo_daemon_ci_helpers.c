@@ -0,0 +1,254 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Daemon CI Helpers - query parsing, submission and response cache plumbing */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project includes */
+#include "argo_daemon_ci_helpers.h"
+#include "argo_daemon.h"
+#include "argo_daemon_api.h"
+#include "argo_json_builder.h"
+#include "argo_error.h"
+#include "argo_limits.h"
+#include "argo_log.h"
+#include "argo_api_providers.h"
+#include "argo_provider_pool.h"
+#include "argo_provider_router.h"
+#include "argo_config.h"
+
+/* Helper: Copy optional string member */
+static char* member_string(json_node_t* item, const char* pointer) {
+    json_node_t* node = json_doc_get(item, pointer);
+    if (!node || node->type != JSON_DOC_STRING) return NULL;
+    return strdup(node->text);
+}
+
+/* Parse one query object and apply defaults */
+int parse_ci_query_request(json_node_t* item, bool allow_route, ci_query_spec_t* spec) {
+    /* Extract query field */
+    spec->query = member_string(item, "/query");
+    if (!spec->query) {
+        return E_INPUT_FORMAT;
+    }
+
+    /* Optional conversation for providers that keep one (claude_code) */
+    spec->session = member_string(item, "/session");
+
+    /* Optional route (priority: provider > route > CI_DEFAULT_ROUTE) */
+    spec->provider = member_string(item, "/provider");
+    if (!spec->provider) {
+        spec->route = member_string(item, "/route");
+        if (spec->route && !allow_route) {
+            return E_INVALID_PARAMS;
+        }
+        const char* config_route = argo_config_get(PROVIDER_ROUTER_DEFAULT_ROUTE_CONFIG_KEY);
+        if (!spec->route && config_route && allow_route) {
+            spec->route = strdup(config_route);
+        }
+    }
+    if (spec->route) {
+        json_node_t* hedge = json_doc_get(item, "/hedge");
+        spec->hedge = hedge && hedge->type == JSON_DOC_BOOL && hedge->boolean;
+        LOG_INFO("CI Query: route=%s%s, query_len=%zu", spec->route,
+                 spec->hedge ? " (hedged)" : "", strlen(spec->query));
+        return ARGO_SUCCESS;
+    }
+
+    /* Extract optional provider field (priority: request > config > default) */
+    if (!spec->provider) {
+        /* Not in request - check config for CI_DEFAULT_PROVIDER */
+        const char* config_provider = argo_config_get("CI_DEFAULT_PROVIDER");
+        if (config_provider) {
+            spec->provider = strdup(config_provider);
+            LOG_INFO("Using provider from config: %s", spec->provider);
+        } else {
+            /* Fall back to built-in default */
+            spec->provider = strdup("claude_code");
+            LOG_INFO("Using built-in default provider: claude_code");
+        }
+    }
+
+    /* Extract optional model field (priority: request > config > provider default) */
+    spec->model = member_string(item, "/model");
+    if (!spec->model) {
+        /* Not in request - check config for CI_DEFAULT_MODEL */
+        const char* config_model = argo_config_get("CI_DEFAULT_MODEL");
+        if (config_model) {
+            spec->model = strdup(config_model);
+            LOG_INFO("Using model from config: %s", spec->model);
+        }
+        /* else NULL is fine - provider will use its default */
+    }
+
+    if (!spec->provider) {
+        return E_SYSTEM_MEMORY;
+    }
+
+    LOG_INFO("CI Query: provider=%s, model=%s, query_len=%zu",
+             spec->provider, spec->model ? spec->model : "default", strlen(spec->query));
+
+    return ARGO_SUCCESS;
+}
+
+/* Free parsed query */
+void free_query_spec(ci_query_spec_t* spec) {
+    free(spec->query);
+    free(spec->provider);
+    free(spec->model);
+    free(spec->route);
+    free(spec->session);
+    free(spec->cached);
+}
+
+/* Helper: Engine is done with a pooled provider */
+static void return_to_pool(ci_provider_t* provider, int result, void* context) {
+    provider_pool_checkin((provider_pool_t*)context, provider, result);
+}
+
+/* Arguments for starting the first of identical queries */
+typedef struct {
+    const ci_query_spec_t* spec;
+    int timeout_ms;
+} query_start_t;
+
+/* Helper: Submit prompt to the daemon's CI engine on a warm provider */
+static int submit_pooled(const char* provider_name, const char* model, const char* session,
+                         const char* prompt, int timeout_ms, ci_response_callback callback,
+                         void* userdata, ci_future_t** future) {
+    provider_pool_t* pool = g_api_daemon->provider_pool;
+    ci_provider_t* provider = NULL;
+
+    int result = provider_pool_checkout(pool, provider_name, model, &provider);
+    if (result != ARGO_SUCCESS) {
+        return result;
+    }
+
+    /* Pooled providers are reused, so the session is set on every checkout */
+    if (strcmp(provider_name, CLAUDE_CODE_PROVIDER_NAME) == 0) {
+        result = claude_code_set_session(provider, session);
+        if (result != ARGO_SUCCESS) {
+            provider_pool_checkin(pool, provider, ARGO_SUCCESS);
+            return result;
+        }
+    }
+
+    *future = ci_engine_submit_borrowed(g_api_daemon->ci_engine, provider,
+                                        return_to_pool, pool,
+                                        prompt, timeout_ms, callback, userdata);
+    return *future ? ARGO_SUCCESS : E_SYSTEM_MEMORY;
+}
+
+/* Helper: Single-flight start - submit the first of identical queries */
+static int start_query(void* context, ci_future_t** future) {
+    const query_start_t* start = (const query_start_t*)context;
+    const ci_query_spec_t* spec = start->spec;
+    return submit_pooled(spec->provider, spec->model, spec->session, spec->query, start->timeout_ms,
+                         NULL, NULL, future);
+}
+
+/* Router submit - one candidate of a routed query (context is the prompt) */
+int start_routed(void* context, const char* provider_name, const char* model, int timeout_ms,
+                 ci_response_callback callback, void* userdata, ci_future_t** future) {
+    return submit_pooled(provider_name, model, NULL, (const char*)context, timeout_ms,
+                         callback, userdata, future);
+}
+
+/* Helper: Single-flight key - length-prefixed so fields cannot run together */
+static char* flight_key(const ci_query_spec_t* spec) {
+    const char* model = spec->model ? spec->model : "";
+    const char* session = spec->session ? spec->session : "";
+    size_t size = strlen(spec->provider) + strlen(model) + strlen(session) + strlen(spec->query) +
+                  ARGO_BUFFER_TINY;
+    char* key = malloc(size);
+    if (key) {
+        snprintf(key, size, "%zu:%s%zu:%s%zu:%s%s", strlen(spec->provider), spec->provider,
+                 strlen(model), model, strlen(session), session, spec->query);
+    }
+    return key;
+}
+
+/* Submit query, joining an identical one already in flight */
+int submit_query(const ci_query_spec_t* spec, int timeout_ms,
+                 single_flight_call_t** call, bool* shared) {
+    query_start_t start = {spec, timeout_ms};
+    char* key = flight_key(spec);
+    if (!key) {
+        return E_SYSTEM_MEMORY;
+    }
+    int result = single_flight_do(g_api_daemon->single_flight, key, start_query, &start, call, shared);
+    free(key);
+    return result;
+}
+
+/* Helper: Cache key for a query (a route's candidates share its answers) */
+static response_cache_key_t query_cache_key(const ci_query_spec_t* spec) {
+    response_cache_key_t key = {
+        .provider = spec->route ? spec->route : spec->provider,
+        .model = spec->model,
+        .params = NULL,     /* No generation parameters in the request yet */
+        .prompt = spec->query
+    };
+    return key;
+}
+
+/* Serve query from the response cache when the mode allows
+ * (a session turn depends on the conversation, so it is never cached) */
+bool serve_from_cache(ci_query_spec_t* spec, response_cache_mode_t mode) {
+    response_cache_t* cache = g_api_daemon->response_cache;
+    if (mode == RESPONSE_CACHE_BYPASS || !cache || spec->session) return false;
+
+    response_cache_key_t key = query_cache_key(spec);
+    return response_cache_lookup(cache, &key, &spec->cached) == ARGO_SUCCESS;
+}
+
+/* Remember a successful answer (disk errors only lose persistence) */
+void remember_answer(const ci_query_spec_t* spec, response_cache_mode_t mode, const char* answer) {
+    response_cache_t* cache = g_api_daemon->response_cache;
+    if (mode != RESPONSE_CACHE_PREFER || !cache || spec->session) return;
+
+    response_cache_key_t key = query_cache_key(spec);
+    response_cache_store(cache, &key, answer);
+}
+
+/* Map failed query to a client message */
+const char* query_error_message(int error_code) {
+    switch (error_code) {
+        case E_SYSTEM_PROCESS: return "No response from AI provider";
+        case E_CI_TIMEOUT:     return "Query timed out";
+        case E_CI_CANCELLED:   return "Query cancelled";
+        default:               return "Query execution failed";
+    }
+}
+
+/* Format CI response as JSON */
+int format_ci_response(const char* provider_name, const char* ai_response,
+                       bool cached, char** response_json_out) {
+    /* Growable builder: escapes can expand a byte up to six (\u00XX) */
+    json_builder_t json;
+    int result = json_builder_init(&json, strlen(ai_response) + RESPONSE_SIZE_OVERHEAD);
+    if (result != ARGO_SUCCESS) {
+        return result;
+    }
+
+    json_builder_object_begin(&json);
+    json_builder_key_string(&json, "status", "success");
+    json_builder_key_string(&json, "provider", provider_name);
+    json_builder_key_string(&json, "response", ai_response);
+    if (cached) {
+        json_builder_key_bool(&json, "cached", true);
+    }
+    json_builder_object_end(&json);
+
+    result = json_builder_error(&json);
+    char* response_json = json_builder_take(&json, NULL);
+    json_builder_free(&json);
+    if (!response_json) {
+        return result != ARGO_SUCCESS ? result : E_SYSTEM_MEMORY;
+    }
+
+    *response_json_out = response_json;
+    return ARGO_SUCCESS;
+}
@@ -0,0 +1,372 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Daemon Task Graph API - POST /api/workflow/dag, GET /api/workflow/dag/{id} */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <limits.h>
+#include <sys/stat.h>
+
+/* Project includes */
+#include "argo_daemon_dag_api.h"
+#include "argo_daemon_api.h"
+#include "argo_daemon.h"
+#include "argo_daemon_workflow.h"
+#include "argo_daemon_workflow_helpers.h"
+#include "argo_daemon_workflow_recovery.h"
+#include "argo_task_graph.h"
+#include "argo_workflow_registry.h"
+#include "argo_file_utils.h"
+#include "argo_http_server.h"
+#include "argo_json.h"
+#include "argo_error.h"
+#include "argo_limits.h"
+#include "argo_log.h"
+
+/* Parsed start request */
+typedef struct {
+    char* tasks_file;
+    char* runner;
+    char* template_name;
+    char* instance_suffix;
+    int max_parallel;
+    int timeout_seconds;
+} dag_request_t;
+
+/* Helper: Extract an optional integer field (0 if absent) */
+static int extract_int_field(const char* body, const char* quoted_key) {
+    const char* key = strstr(body, quoted_key);
+    if (!key) return 0;
+
+    const char* colon = strchr(key + strlen(quoted_key), ':');
+    if (!colon) return 0;
+
+    long value = strtol(colon + 1, NULL, DECIMAL_BASE);
+    return (value > 0 && value <= INT_MAX) ? (int)value : 0;
+}
+
+/* Helper: Extract an optional string field (NULL if absent) */
+static char* extract_string(const char* body, const char* field) {
+    const char* path[] = {field};
+    char* value = NULL;
+    size_t len = 0;
+    if (json_extract_nested_string(body, path, 1, &value, &len) != ARGO_SUCCESS) {
+        free(value);
+        return NULL;
+    }
+    return value;
+}
+
+/* Helper: Free parsed start request */
+static void free_dag_request(dag_request_t* request) {
+    free(request->tasks_file);
+    free(request->runner);
+    free(request->template_name);
+    free(request->instance_suffix);
+}
+
+/* Helper: Build ~/.argo/<dir>[/<leaf><suffix>] path, creating the directory
+ *
+ * Returns E_INPUT_TOO_LARGE rather than a truncated path.
+ */
+static int dag_path(const char* dir, const char* leaf, const char* suffix,
+                    char* path, size_t size) {
+    const char* home = getenv(ENV_VAR_HOME);
+    if (!home) home = ".";
+
+    char dir_path[ARGO_PATH_MAX];
+    int written = snprintf(dir_path, sizeof(dir_path), "%s/.argo/%s", home, dir);
+    if (written < 0 || (size_t)written >= sizeof(dir_path)) {
+        return E_INPUT_TOO_LARGE;
+    }
+    mkdir(dir_path, ARGO_DIR_PERMISSIONS);  /* Ignore EEXIST */
+
+    if (leaf) {
+        written = snprintf(path, size, "%s/%s%s", dir_path, leaf, suffix);
+    } else {
+        written = snprintf(path, size, "%s", dir_path);
+    }
+    if (written < 0 || (size_t)written >= size) {
+        return E_INPUT_TOO_LARGE;
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Reject task scripts that fail the workflow script checks */
+static int validate_task_scripts(const task_graph_t* graph, const char* runner,
+                                 http_response_t* resp) {
+    char message[ARGO_BUFFER_MEDIUM];
+
+    if (runner && !daemon_validate_script_path(runner)) {
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, "Runner failed security validation");
+        return E_INVALID_PARAMS;
+    }
+
+    for (int i = 0; i < graph->count; i++) {
+        const task_node_t* node = &graph->nodes[i];
+        if (node->script[0] == '\0') {
+            if (runner) continue;
+            snprintf(message, sizeof(message), "Task '%s' has no script and no runner given", node->id);
+            http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, message);
+            return E_INPUT_INVALID;
+        }
+        if (!daemon_validate_script_path(node->script)) {
+            snprintf(message, sizeof(message), "Script of task '%s' failed security validation", node->id);
+            http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, message);
+            return E_INVALID_PARAMS;
+        }
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Path of the argo-dag-run binary
+ *
+ * ARGO_DAG_RUN_BIN, else next to the daemon executable, else the bare
+ * name for a PATH search.
+ */
+static void resolve_dag_runner(char* path, size_t size) {
+    const char* override = getenv(DAG_API_RUNNER_ENV);
+    if (override && *override) {
+        snprintf(path, size, "%s", override);
+        return;
+    }
+
+    char self[ARGO_PATH_MAX];
+    ssize_t len = readlink(DAG_API_SELF_EXE, self, sizeof(self) - 1);
+    if (len > 0) {
+        self[len] = '\0';
+        char* slash = strrchr(self, '/');
+        if (slash) {
+            *slash = '\0';
+            int written = snprintf(path, size, "%s/%s", self, DAG_API_RUNNER_BINARY);
+            if (written > 0 && (size_t)written < size && access(path, X_OK) == 0) {
+                return;
+            }
+        }
+    }
+
+    snprintf(path, size, "%s", DAG_API_RUNNER_BINARY);
+}
+
+/* Helper: Supervisor child - reset what exec keeps, redirect stdio, exec
+ *
+ * Runs between fork and exec of a threaded daemon: async-signal-safe
+ * calls only (no malloc, stdio or logging). argv is built by the parent.
+ */
+static void exec_dag_supervisor(char* const argv[], const char* log_path) {
+    sigset_t none;
+    sigemptyset(&none);
+    sigprocmask(SIG_SETMASK, &none, NULL);
+    signal(SIGPIPE, SIG_DFL);  /* Ignored dispositions survive exec */
+
+    int null_fd = open(TASK_GRAPH_NULL_DEVICE, O_RDONLY);
+    if (null_fd >= 0) {
+        dup2(null_fd, STDIN_FILENO);
+    }
+    int log_fd = open(log_path, O_CREAT | O_WRONLY | O_APPEND, ARGO_FILE_PERMISSIONS);
+    if (log_fd >= 0) {
+        dup2(log_fd, STDOUT_FILENO);
+        dup2(log_fd, STDERR_FILENO);
+    }
+    for (int fd = STDERR_FILENO + 1; fd < DAG_API_SUPERVISOR_FD_SCAN_MAX; fd++) {
+        close(fd);
+    }
+
+    execvp(argv[0], argv);
+    _exit(TASK_GRAPH_EXEC_FAILED_EXIT);
+}
+
+/* Helper: Register the run and fork its supervisor */
+static int start_dag_supervisor(task_graph_t* graph, const dag_request_t* request,
+                                const char* workflow_id) {
+    argo_daemon_t* daemon = g_api_daemon;
+
+    char status_path[ARGO_PATH_MAX];
+    int result = dag_path(DAG_API_STATUS_DIR, workflow_id, DAG_API_STATUS_SUFFIX,
+                          status_path, sizeof(status_path));
+    if (result != ARGO_SUCCESS) {
+        return result;
+    }
+    task_graph_write_status(graph, status_path);  /* Queryable before the first task starts */
+
+    workflow_entry_t entry = {0};
+    snprintf(entry.workflow_id, sizeof(entry.workflow_id), "%s", workflow_id);
+    strncpy(entry.workflow_name, request->tasks_file, sizeof(entry.workflow_name) - 1);
+    entry.state = WORKFLOW_STATE_PENDING;
+    entry.start_time = time(NULL);
+    entry.total_steps = graph->count;
+    entry.timeout_seconds = request->timeout_seconds > 0 ? request->timeout_seconds
+                                                         : DEFAULT_WORKFLOW_TIMEOUT_SECONDS;
+    entry.max_retries = 0;  /* Retry re-runs workflow_name as a bash script */
+
+    result = workflow_registry_add(daemon->workflow_registry, &entry);
+    if (result != ARGO_SUCCESS) {
+        return result;
+    }
+
+    /* Everything the child needs is prepared here, before fork */
+    char runner_bin[ARGO_PATH_MAX];
+    char log_dir[ARGO_PATH_MAX];
+    char log_path[ARGO_PATH_MAX];
+    char log_prefix[ARGO_BUFFER_NAME];
+    char max_parallel[ARGO_BUFFER_TINY];
+    resolve_dag_runner(runner_bin, sizeof(runner_bin));
+    if (dag_path(WORKFLOW_RECOVERY_LOG_DIR, NULL, NULL, log_dir, sizeof(log_dir)) != ARGO_SUCCESS ||
+        workflow_recovery_log_path(workflow_id, log_path, sizeof(log_path)) != ARGO_SUCCESS) {
+        workflow_registry_remove(daemon->workflow_registry, workflow_id);
+        return E_INPUT_TOO_LARGE;
+    }
+    snprintf(log_prefix, sizeof(log_prefix), "%s_", workflow_id);
+    snprintf(max_parallel, sizeof(max_parallel), "%d",
+             request->max_parallel > 0 ? request->max_parallel : TASK_GRAPH_DEFAULT_PARALLEL);
+
+    char* argv[DAG_API_RUNNER_MAX_ARGS];
+    int argc = 0;
+    argv[argc++] = runner_bin;
+    argv[argc++] = "--max-parallel";
+    argv[argc++] = max_parallel;
+    argv[argc++] = "--log-dir";
+    argv[argc++] = log_dir;
+    argv[argc++] = "--log-prefix";
+    argv[argc++] = log_prefix;
+    argv[argc++] = "--status";
+    argv[argc++] = status_path;
+    if (request->runner) {
+        argv[argc++] = "--runner";
+        argv[argc++] = request->runner;
+    }
+    argv[argc++] = request->tasks_file;
+    argv[argc] = NULL;
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        argo_report_error(E_SYSTEM_FORK, "start_dag_supervisor", "fork failed");
+        workflow_registry_remove(daemon->workflow_registry, workflow_id);
+        return E_SYSTEM_FORK;
+    }
+    if (pid == 0) {
+        exec_dag_supervisor(argv, log_path);
+    }
+
+    workflow_registry_update_state(daemon->workflow_registry, workflow_id, WORKFLOW_STATE_RUNNING);
+    workflow_entry_t* mutable_entry = (workflow_entry_t*)workflow_registry_find(
+        daemon->workflow_registry, workflow_id);
+    if (mutable_entry) {
+        mutable_entry->executor_pid = pid;
+        mutable_entry->proc_start_ticks = workflow_recovery_start_ticks(pid);
+    }
+    workflow_recovery_request_save(daemon);
+
+    LOG_INFO("Started task graph %s: %d tasks, critical path %ld (PID %d)",
+            workflow_id, graph->count, graph->critical_path, pid);
+    return ARGO_SUCCESS;
+}
+
+/* POST /api/workflow/dag - Validate tasks.json and start a parallel run */
+int api_workflow_dag_start(http_request_t* req, http_response_t* resp) {
+    int result = ARGO_SUCCESS;
+    dag_request_t request = {0};
+    task_graph_t* graph = NULL;
+
+    if (!req || !resp || !g_api_daemon || !g_api_daemon->workflow_registry) {
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, DAEMON_ERR_INTERNAL_SERVER);
+        return E_SYSTEM_MEMORY;
+    }
+    if (!req->body) {
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, DAEMON_ERR_MISSING_REQUEST_BODY);
+        return E_INPUT_NULL;
+    }
+
+    request.tasks_file = extract_string(req->body, DAG_API_FIELD_TASKS_FILE);
+    request.runner = extract_string(req->body, DAG_API_FIELD_RUNNER);
+    request.template_name = extract_string(req->body, DAG_API_FIELD_TEMPLATE);
+    request.instance_suffix = extract_string(req->body, DAG_API_FIELD_INSTANCE);
+    request.max_parallel = extract_int_field(req->body, DAG_API_FIELD_MAX_PARALLEL);
+    request.timeout_seconds = extract_int_field(req->body, DAG_API_FIELD_TIMEOUT);
+
+    if (!request.tasks_file) {
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, "Missing 'tasks_file' field");
+        result = E_INPUT_FORMAT;
+        goto cleanup;
+    }
+
+    /* Reject bad graphs here, where the caller can see why */
+    result = task_graph_load(request.tasks_file, &graph);
+    if (result != ARGO_SUCCESS) {
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, "Cannot read tasks file");
+        goto cleanup;
+    }
+    result = task_graph_validate(graph);
+    if (result != ARGO_SUCCESS) {
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST,
+                               graph->error[0] ? graph->error : "Invalid task graph");
+        goto cleanup;
+    }
+    result = validate_task_scripts(graph, request.runner, resp);
+    if (result != ARGO_SUCCESS) {
+        goto cleanup;
+    }
+
+    char workflow_id[WORKFLOW_ID_MAX_LENGTH + 1];
+    result = generate_workflow_id(g_api_daemon->workflow_registry,
+                                  request.template_name ? request.template_name : DAG_API_TEMPLATE_DEFAULT,
+                                  request.instance_suffix, workflow_id, sizeof(workflow_id));
+    if (result != ARGO_SUCCESS) {
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, "Failed to generate workflow ID");
+        goto cleanup;
+    }
+
+    result = start_dag_supervisor(graph, &request, workflow_id);
+    if (result != ARGO_SUCCESS) {
+        if (result == E_DUPLICATE) {
+            http_response_set_error(resp, HTTP_STATUS_CONFLICT, "Workflow already exists");
+        } else {
+            http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, "Failed to start task graph");
+        }
+        goto cleanup;
+    }
+
+    char response_json[ARGO_BUFFER_STANDARD];
+    snprintf(response_json, sizeof(response_json),
+            "{\"status\":\"success\",\"workflow_id\":\"%s\",\"tasks\":%d,\"critical_path\":%ld}",
+            workflow_id, graph->count, graph->critical_path);
+    http_response_set_json(resp, HTTP_STATUS_OK, response_json);
+
+cleanup:
+    task_graph_destroy(graph);
+    free_dag_request(&request);
+    return result;
+}
+
+/* GET /api/workflow/dag/{id} - Per-node state of a run */
+int api_workflow_dag_status(http_request_t* req, http_response_t* resp) {
+    if (!req || !resp) {
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, DAEMON_ERR_INTERNAL_SERVER);
+        return E_SYSTEM_MEMORY;
+    }
+
+    /* Path format: /api/workflow/dag/wf_123 */
+    const char* id_start = strrchr(req->path, '/');
+    if (!id_start || !*(id_start + 1) || strstr(id_start, "..")) {
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, DAEMON_ERR_MISSING_WORKFLOW_ID);
+        return E_INPUT_NULL;
+    }
+
+    char status_path[ARGO_PATH_MAX];
+    char* json = NULL;
+    if (dag_path(DAG_API_STATUS_DIR, id_start + 1, DAG_API_STATUS_SUFFIX,
+                 status_path, sizeof(status_path)) != ARGO_SUCCESS ||
+        file_read_all(status_path, &json, NULL) != ARGO_SUCCESS) {
+        http_response_set_error(resp, HTTP_STATUS_NOT_FOUND, DAEMON_ERR_WORKFLOW_NOT_FOUND);
+        return E_NOT_FOUND;
+    }
+
+    http_response_set_json(resp, HTTP_STATUS_OK, json);
+    free(json);
+    return ARGO_SUCCESS;
+}
@@ -0,0 +1,185 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Daemon Project API - GET/PATCH /api/project/{id}/state */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/* Project includes */
+#include "argo_daemon_project_api.h"
+#include "argo_daemon_api.h"
+#include "argo_daemon.h"
+#include "argo_project_state.h"
+#include "argo_json_doc.h"
+#include "argo_http_server.h"
+#include "argo_error.h"
+#include "argo_limits.h"
+#include "argo_string_utils.h"
+#include "argo_log.h"
+
+/* Helper: Extract {id} from /api/project/{id}/state */
+static bool parse_project_id(const char* path, char* id, size_t size) {
+    const char* start = path + strlen(PROJECT_API_PATH);
+    if (*start != '/') return false;
+    start++;
+
+    size_t len = strcspn(start, "/?");
+    if (len == 0 || len >= size) return false;
+
+    const char* rest = start + len;
+    size_t rest_len = strcspn(rest, "?");
+    if (rest_len != strlen(PROJECT_API_STATE_SUFFIX) ||
+        strncmp(rest, PROJECT_API_STATE_SUFFIX, rest_len) != 0) {
+        return false;
+    }
+
+    memcpy(id, start, len);
+    id[len] = '\0';
+    return true;
+}
+
+/* Helper: Collect ptr= values from the query string (split and decoded in place) */
+static int collect_pointers(char* query, const char** pointers, int* count) {
+    size_t name_len = strlen(PROJECT_API_QUERY_POINTER);
+    *count = 0;
+
+    char* param = query;
+    while (param && *param) {
+        char* next = strchr(param, '&');
+        if (next) *next++ = '\0';
+
+        if (strncmp(param, PROJECT_API_QUERY_POINTER, name_len) == 0 && param[name_len] == '=') {
+            if (*count >= PROJECT_API_MAX_POINTERS) return E_RESOURCE_LIMIT;
+            char* value = param + name_len + 1;
+            percent_decode(value);
+            pointers[(*count)++] = value;
+        }
+        param = next;
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Map store error to HTTP response */
+static void set_store_error(http_response_t* resp, int result, long long version) {
+    char json[ARGO_BUFFER_MEDIUM];
+
+    switch (result) {
+        case E_NOT_FOUND:
+            http_response_set_error(resp, HTTP_STATUS_NOT_FOUND, PROJECT_API_ERR_NOT_FOUND);
+            break;
+        case E_PROTOCOL_VERSION:
+            snprintf(json, sizeof(json), "{\"status\":\"error\",\"message\":\"%s\",\"version\":%lld}",
+                     PROJECT_API_ERR_CONFLICT, version);
+            http_response_set_json(resp, HTTP_STATUS_CONFLICT, json);
+            break;
+        case E_INPUT_INVALID:
+            http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, PROJECT_API_ERR_BAD_PATCH);
+            break;
+        default:
+            http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, DAEMON_ERR_INTERNAL_SERVER);
+            break;
+    }
+}
+
+/* GET /api/project/{id}/state - Read state or selected values */
+int api_project_state_get(http_request_t* req, http_response_t* resp) {
+    if (!req || !resp || !g_api_daemon || !g_api_daemon->project_state) {
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, DAEMON_ERR_INTERNAL_SERVER);
+        return E_SYSTEM_MEMORY;
+    }
+
+    char project_id[PROJECT_STATE_ID_MAX];
+    if (!parse_project_id(req->path, project_id, sizeof(project_id))) {
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, PROJECT_API_ERR_BAD_PATH);
+        return E_INVALID_PARAMS;
+    }
+
+    char query[HTTP_PATH_SIZE] = {0};
+    const char* pointers[PROJECT_API_MAX_POINTERS];
+    int count = 0;
+    const char* query_start = strchr(req->path, '?');
+    if (query_start) {
+        snprintf(query, sizeof(query), "%s", query_start + 1);
+    }
+    if (collect_pointers(query, pointers, &count) != ARGO_SUCCESS) {
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, PROJECT_API_ERR_TOO_MANY);
+        return E_RESOURCE_LIMIT;
+    }
+
+    char* data = NULL;
+    char* json = NULL;
+    long long version = 0;
+    int result = project_state_get(g_api_daemon->project_state, project_id,
+                                   pointers, count, &data, &version);
+    if (result != ARGO_SUCCESS) {
+        set_store_error(resp, result, version);
+        return result;
+    }
+
+    size_t size = strlen(data) + PROJECT_API_SIZE_BASE;
+    json = malloc(size);
+    if (!json) {
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, DAEMON_ERR_ALLOCATION_FAILED);
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
+    snprintf(json, size, "{\"version\":%lld,\"%s\":%s}", version, count > 0 ? "values" : "state", data);
+    http_response_set_json(resp, HTTP_STATUS_OK, json);
+
+cleanup:
+    free(json);
+    free(data);
+    return result;
+}
+
+/* PATCH /api/project/{id}/state - Apply patch atomically */
+int api_project_state_patch(http_request_t* req, http_response_t* resp) {
+    if (!req || !resp || !g_api_daemon || !g_api_daemon->project_state) {
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, DAEMON_ERR_INTERNAL_SERVER);
+        return E_SYSTEM_MEMORY;
+    }
+
+    char project_id[PROJECT_STATE_ID_MAX];
+    if (!parse_project_id(req->path, project_id, sizeof(project_id))) {
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, PROJECT_API_ERR_BAD_PATH);
+        return E_INVALID_PARAMS;
+    }
+    if (!req->body) {
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, DAEMON_ERR_MISSING_REQUEST_BODY);
+        return E_INVALID_PARAMS;
+    }
+
+    json_node_t* body = NULL;
+    int result = json_doc_parse(req->body, req->body_length, &body);
+    if (result != ARGO_SUCCESS) {
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, DAEMON_ERR_INVALID_JSON);
+        return result;
+    }
+
+    long long expected = PROJECT_STATE_ANY_VERSION;
+    long long version = 0;
+    json_node_t* version_node = json_doc_get(body, "/version");
+    json_node_t* ops = json_doc_get(body, "/patch");
+    if ((version_node && !json_doc_get_integer(version_node, &expected)) ||
+        !ops || ops->type != JSON_DOC_ARRAY) {
+        http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, PROJECT_API_ERR_BAD_PATCH);
+        result = E_INVALID_PARAMS;
+        goto cleanup;
+    }
+
+    result = project_state_patch(g_api_daemon->project_state, project_id, ops, expected, &version);
+    if (result != ARGO_SUCCESS) {
+        set_store_error(resp, result, version);
+        goto cleanup;
+    }
+
+    char json[ARGO_BUFFER_MEDIUM];
+    snprintf(json, sizeof(json), "{\"version\":%lld}", version);
+    http_response_set_json(resp, HTTP_STATUS_OK, json);
+
+cleanup:
+    json_doc_free(body);
+    return result;
+}
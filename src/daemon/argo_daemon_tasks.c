@@ -1,5 +1,5 @@
 /* © 2025 Casey Koons All rights reserved */
-/* Daemon background tasks - workflow monitoring, log rotation, completion detection */
+/* Daemon background tasks - workflow monitoring, log rotation, completion detection, CI upkeep */
 
 /* System includes */
 #include <stdio.h>
@@ -18,7 +18,11 @@
 #include "argo_daemon_tasks.h"
 #include "argo_daemon.h"
 #include "argo_daemon_exit_queue.h"
+#include "argo_daemon_workflow_recovery.h"
 #include "argo_workflow_registry.h"
+#include "argo_provider_pool.h"
+#include "argo_response_cache.h"
+#include "argo_claude_session_pool.h"
 #include "argo_limits.h"
 #include "argo_log.h"
 #include "argo_error.h"
@@ -234,6 +238,8 @@ static void handle_workflow_failure(argo_daemon_t* daemon, workflow_entry_t* ent
         if (retry_pid > 0) {
             /* Parent - update PID and state */
             mutable_entry->executor_pid = retry_pid;
+            mutable_entry->proc_start_ticks = workflow_recovery_start_ticks(retry_pid);
+            mutable_entry->reattached = false;  /* Retry is our child again */
             workflow_registry_update_state(daemon->workflow_registry,
                                           entry->workflow_id,
                                           WORKFLOW_STATE_RUNNING);
@@ -242,10 +248,58 @@ static void handle_workflow_failure(argo_daemon_t* daemon, workflow_entry_t* ent
         /* No retry - remove workflow from registry */
         LOG_INFO("Workflow %s failed after %d attempts", entry->workflow_id,
                 mutable_entry->retry_count);
+        workflow_recovery_release_stdin(mutable_entry);
         workflow_registry_remove(daemon->workflow_registry, entry->workflow_id);
     }
 }
 
+/* Helper: Detect exits of executors adopted after a daemon restart
+ *
+ * Reattached executors are not our children, so SIGCHLD never reports
+ * them. Poll for liveness instead. Their exit status is unknowable, so
+ * they are removed without retry. Returns number of workflows removed.
+ */
+static int poll_reattached_workflows(argo_daemon_t* daemon) {
+    workflow_entry_t* entries = NULL;
+    int count = 0;
+
+    if (workflow_registry_list(daemon->workflow_registry, &entries, &count) != ARGO_SUCCESS ||
+        !entries) {
+        return 0;
+    }
+
+    int removed = 0;
+    for (int i = 0; i < count; i++) {
+        workflow_entry_t* entry = &entries[i];
+
+        if (!entry->reattached || entry->state != WORKFLOW_STATE_RUNNING ||
+            workflow_recovery_process_alive(entry)) {
+            continue;
+        }
+
+        workflow_entry_t* mutable_entry = (workflow_entry_t*)workflow_registry_find(
+            daemon->workflow_registry, entry->workflow_id);
+        if (!mutable_entry) {
+            continue;
+        }
+        mutable_entry->exit_code = WORKFLOW_EXIT_CODE_UNKNOWN;
+
+        if (mutable_entry->abandon_requested) {
+            LOG_INFO("Reattached workflow %s abandoned by user request", entry->workflow_id);
+        } else {
+            LOG_INFO("Reattached workflow %s (PID %d) exited (exit status unavailable)",
+                    entry->workflow_id, entry->executor_pid);
+        }
+
+        workflow_recovery_release_stdin(mutable_entry);
+        workflow_registry_remove(daemon->workflow_registry, entry->workflow_id);
+        removed++;
+    }
+
+    free(entries);
+    return removed;
+}
+
 /* Workflow completion detection and retry task */
 void workflow_completion_task(void* context) {
     argo_daemon_t* daemon = (argo_daemon_t*)context;
@@ -259,9 +313,14 @@ void workflow_completion_task(void* context) {
         LOG_WARN("Exit code queue dropped %d entries (queue full)", dropped);
     }
 
+    /* Executors adopted after a restart are polled, not reaped */
+    int changed = poll_reattached_workflows(daemon);
+
     /* Drain exit code queue from SIGCHLD handler */
     exit_code_entry_t exit_entry;
     while (exit_queue_pop(daemon->exit_queue, &exit_entry)) {
+        changed++;
+
         /* Find workflow by PID */
         workflow_entry_t* entries = NULL;
         int count = 0;
@@ -293,10 +352,12 @@ void workflow_completion_task(void* context) {
                     /* User requested abandon - remove from registry */
                     LOG_INFO("Workflow %s abandoned by user request (exit code %d)",
                             entry->workflow_id, exit_entry.exit_code);
+                    workflow_recovery_release_stdin(mutable_entry);
                     workflow_registry_remove(daemon->workflow_registry, entry->workflow_id);
                 } else if (exit_entry.exit_code == 0) {
                     /* Success - remove from registry */
                     LOG_INFO("Workflow %s completed successfully (exit code 0)", entry->workflow_id);
+                    workflow_recovery_release_stdin(mutable_entry);
                     workflow_registry_remove(daemon->workflow_registry, entry->workflow_id);
                 } else {
                     /* Failure - handle retry logic */
@@ -314,4 +375,33 @@ void workflow_completion_task(void* context) {
 
         free(entries);
     }
+
+    /* Keep persisted registry in step for restart recovery, including
+     * changes HTTP handlers asked this thread to save */
+    if (changed > 0 || atomic_load(&daemon->registry_save_pending)) {
+        workflow_recovery_save(daemon);
+    }
+}
+
+/* Provider pool eviction task */
+void provider_pool_task(void* context) {
+    argo_daemon_t* daemon = (argo_daemon_t*)context;
+    if (!daemon || !daemon->provider_pool) return;
+
+    provider_pool_evict_idle(daemon->provider_pool);
+}
+
+/* Response cache purge task */
+void response_cache_task(void* context) {
+    argo_daemon_t* daemon = (argo_daemon_t*)context;
+    if (!daemon || !daemon->response_cache) return;
+
+    response_cache_purge_expired(daemon->response_cache);
+}
+
+/* Claude session reap task */
+void claude_session_task(void* context) {
+    if (!context) return;
+
+    claude_session_pool_reap(claude_session_pool_default(), CLAUDE_SESSION_POOL_DEFAULT_IDLE_SECONDS);
 }
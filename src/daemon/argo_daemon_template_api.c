@@ -0,0 +1,148 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Daemon Template API - GET /api/templates, GET /api/templates/{name} */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/* Project includes */
+#include "argo_daemon_template_api.h"
+#include "argo_daemon_api.h"
+#include "argo_daemon.h"
+#include "argo_template_catalog.h"
+#include "argo_http_server.h"
+#include "argo_json.h"
+#include "argo_string_utils.h"
+#include "argo_error.h"
+#include "argo_log.h"
+
+/* Helper: Append "key":"escaped value" */
+static int append_string(char* buf, size_t size, size_t* offset,
+                         const char* key, const char* value, bool first) {
+    int written = snprintf(buf + *offset, size - *offset, "%s\"%s\":\"", first ? "" : ",", key);
+    if (written < 0 || (size_t)written >= size - *offset) return E_SYSTEM_MEMORY;
+    *offset += written;
+
+    int result = json_escape_string(buf, size, offset, value);
+    if (result != ARGO_SUCCESS) return result;
+
+    if (*offset + 1 >= size) return E_SYSTEM_MEMORY;
+    buf[(*offset)++] = '"';
+    buf[*offset] = '\0';
+    return ARGO_SUCCESS;
+}
+
+/* GUIDELINE_APPROVED - JSON construction for API responses */
+/* Helper: Append one template object */
+static int append_item(char* buf, size_t size, size_t* offset, const template_catalog_item_t* item) {
+    if (*offset + 1 >= size) return E_SYSTEM_MEMORY;
+    buf[(*offset)++] = '{';
+
+    int result = append_string(buf, size, offset, "name", item->name, true);
+    if (result == ARGO_SUCCESS) result = append_string(buf, size, offset, "source", item->source, false);
+    if (result == ARGO_SUCCESS) result = append_string(buf, size, offset, "description", item->summary, false);
+    if (result == ARGO_SUCCESS) result = append_string(buf, size, offset, "path", item->info.workflow_script, false);
+    if (result == ARGO_SUCCESS) result = append_string(buf, size, offset, "dir", item->info.template_dir, false);
+    if (result == ARGO_SUCCESS) result = append_string(buf, size, offset, "version", item->info.version, false);
+    if (result == ARGO_SUCCESS) result = append_string(buf, size, offset, "author", item->info.author, false);
+    if (result != ARGO_SUCCESS) return result;
+
+    int written = snprintf(buf + *offset, size - *offset, ",\"has_readme\":%s,\"has_tests\":%s}",
+                           item->info.has_readme ? "true" : "false",
+                           item->info.has_tests ? "true" : "false");
+    if (written < 0 || (size_t)written >= size - *offset) return E_SYSTEM_MEMORY;
+    *offset += written;
+    return ARGO_SUCCESS;
+}
+/* GUIDELINE_APPROVED_END */
+
+/* Helper: GET /api/templates/{name} */
+static int get_template(const char* name, http_response_t* resp) {
+    template_catalog_item_t* item = malloc(sizeof(template_catalog_item_t));
+    char json[TEMPLATE_API_SIZE_PER_ITEM];
+    size_t offset = 0;
+
+    if (!item) {
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, DAEMON_ERR_ALLOCATION_FAILED);
+        return E_SYSTEM_MEMORY;
+    }
+
+    int result = template_catalog_find(g_api_daemon->template_catalog, name, item);
+    if (result != ARGO_SUCCESS) {
+        http_response_set_error(resp, HTTP_STATUS_NOT_FOUND, TEMPLATE_API_ERR_NOT_FOUND);
+        goto cleanup;
+    }
+
+    result = append_item(json, sizeof(json), &offset, item);
+    if (result != ARGO_SUCCESS) {
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, DAEMON_ERR_INTERNAL_SERVER);
+        goto cleanup;
+    }
+    http_response_set_json(resp, HTTP_STATUS_OK, json);
+
+cleanup:
+    free(item);
+    return result;
+}
+
+/* GET /api/templates[/{name}] - List templates or look one up */
+int api_templates(http_request_t* req, http_response_t* resp) {
+    if (!req || !resp || !g_api_daemon || !g_api_daemon->template_catalog) {
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, DAEMON_ERR_INTERNAL_SERVER);
+        return E_SYSTEM_MEMORY;
+    }
+
+    /* Path format: /api/templates/name */
+    const char* suffix = req->path + strlen(TEMPLATE_API_PATH);
+    if (*suffix == '/' && *(suffix + 1)) {
+        /* Clients percent-encode the name */
+        char name[TEMPLATE_NAME_MAX];
+        size_t len = strcspn(suffix + 1, "?");
+        if (len >= sizeof(name)) {
+            http_response_set_error(resp, HTTP_STATUS_BAD_REQUEST, "Template name too long");
+            return E_INPUT_TOO_LARGE;
+        }
+        memcpy(name, suffix + 1, len);
+        name[len] = '\0';
+        percent_decode(name);
+        return get_template(name, resp);
+    }
+
+    template_catalog_item_t* items = NULL;
+    int count = 0;
+    char* json = NULL;
+    int result = template_catalog_list(g_api_daemon->template_catalog, &items, &count);
+    if (result != ARGO_SUCCESS) {
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, "Failed to list templates");
+        return result;
+    }
+
+    size_t size = (size_t)count * TEMPLATE_API_SIZE_PER_ITEM + TEMPLATE_API_SIZE_BASE;
+    json = malloc(size);
+    if (!json) {
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, DAEMON_ERR_ALLOCATION_FAILED);
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
+
+    size_t offset = (size_t)snprintf(json, size, "{\"templates\":[");
+    for (int i = 0; i < count && result == ARGO_SUCCESS; i++) {
+        if (i > 0) json[offset++] = ',';
+        result = append_item(json, size, &offset, &items[i]);
+    }
+    if (result != ARGO_SUCCESS) {
+        LOG_ERROR("Template list JSON buffer too small");
+        http_response_set_error(resp, HTTP_STATUS_SERVER_ERROR, DAEMON_ERR_INTERNAL_SERVER);
+        goto cleanup;
+    }
+    snprintf(json + offset, size - offset, "],\"count\":%d}", count);
+
+    http_response_set_json(resp, HTTP_STATUS_OK, json);
+
+cleanup:
+    free(json);
+    free(items);
+    return result;
+}
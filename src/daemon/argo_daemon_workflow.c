@@ -15,13 +15,14 @@
 /* Project includes */
 #include "argo_daemon_workflow.h"
 #include "argo_daemon.h"
+#include "argo_daemon_workflow_recovery.h"
 #include "argo_workflow_registry.h"
 #include "argo_limits.h"
 #include "argo_log.h"
 #include "argo_error.h"
 
 /* Validate workflow script path - prevent directory traversal and command injection */
-static bool validate_script_path(const char* path) {
+bool daemon_validate_script_path(const char* path) {
     if (!path || strlen(path) == 0) {
         return false;
     }
@@ -109,7 +110,7 @@ int daemon_execute_bash_workflow(argo_daemon_t* daemon,
 
     /* GUIDELINE_APPROVED - Security validation error messages */
     /* Validate script path for security */
-    if (!validate_script_path(script_path)) {
+    if (!daemon_validate_script_path(script_path)) {
         argo_report_error(E_INVALID_PARAMS, "daemon_execute_bash_workflow",
                          "Script path failed security validation");
         return E_INVALID_PARAMS;
@@ -157,10 +158,12 @@ int daemon_execute_bash_workflow(argo_daemon_t* daemon,
     }
     /* GUIDELINE_APPROVED_END */
 
-    /* Create pipe for stdin (parent writes, child reads) */
-    int pipe_fds[2];
-    if (pipe(pipe_fds) < 0) {
-        argo_report_error(E_SYSTEM_PROCESS, "daemon_execute_bash_workflow", "pipe creation failed");
+    /* Create named FIFO for stdin (parent writes, child reads) */
+    /* A FIFO outlives the daemon, so a restarted daemon can reconnect input */
+    char fifo_path[WORKFLOW_STDIN_FIFO_MAX];
+    int stdin_fd = workflow_recovery_fifo_create(workflow_id, fifo_path, sizeof(fifo_path));
+    if (stdin_fd < 0) {
+        argo_report_error(E_SYSTEM_PROCESS, "daemon_execute_bash_workflow", "stdin FIFO creation failed");
         workflow_registry_remove(daemon->workflow_registry, workflow_id);
         return E_SYSTEM_PROCESS;
     }
@@ -169,8 +172,8 @@ int daemon_execute_bash_workflow(argo_daemon_t* daemon,
     pid_t pid = fork();
     if (pid < 0) {
         /* Fork failed */
-        close(pipe_fds[0]);
-        close(pipe_fds[1]);
+        close(stdin_fd);
+        unlink(fifo_path);
         argo_report_error(E_SYSTEM_FORK, "daemon_execute_bash_workflow", "fork failed");
         workflow_registry_update_state(daemon->workflow_registry, workflow_id,
                                       WORKFLOW_STATE_FAILED);
@@ -180,10 +183,13 @@ int daemon_execute_bash_workflow(argo_daemon_t* daemon,
     if (pid == 0) {
         /* Child process - execute bash script */
 
-        /* Setup stdin pipe (close write end, redirect read end to stdin) */
-        close(pipe_fds[1]);  /* Close write end */
-        dup2(pipe_fds[0], STDIN_FILENO);
-        close(pipe_fds[0]);
+        /* Setup stdin from FIFO (parent's open fd keeps this from blocking) */
+        close(stdin_fd);
+        int fifo_fd = open(fifo_path, O_RDONLY);
+        if (fifo_fd >= 0) {
+            dup2(fifo_fd, STDIN_FILENO);
+            close(fifo_fd);
+        }
 
         /* Create log directory if needed */
         const char* home = getenv("HOME");
@@ -235,9 +241,7 @@ int daemon_execute_bash_workflow(argo_daemon_t* daemon,
         _exit(E_SYSTEM_PROCESS);
     }
 
-    /* Parent process - close read end, keep write end for input */
-    close(pipe_fds[0]);
-
+    /* Parent process - keep FIFO open for input */
     /* Update registry with PID and stdin pipe */
     workflow_registry_update_state(daemon->workflow_registry, workflow_id,
                                   WORKFLOW_STATE_RUNNING);
@@ -248,9 +252,14 @@ int daemon_execute_bash_workflow(argo_daemon_t* daemon,
         /* Need to cast away const to update - this is a limitation of current API */
         workflow_entry_t* mutable_entry = (workflow_entry_t*)wf_entry;
         mutable_entry->executor_pid = pid;
-        mutable_entry->stdin_pipe = pipe_fds[1];  /* Store write end for input */
+        mutable_entry->stdin_pipe = stdin_fd;  /* Store FIFO fd for input */
+        snprintf(mutable_entry->stdin_fifo, sizeof(mutable_entry->stdin_fifo), "%s", fifo_path);
+        mutable_entry->proc_start_ticks = workflow_recovery_start_ticks(pid);
     }
 
-    LOG_INFO("Started bash workflow: %s (PID: %d, stdin_pipe: %d)", workflow_id, pid, pipe_fds[1]);
+    /* Persist so a restarted daemon can reattach */
+    workflow_recovery_request_save(daemon);
+
+    LOG_INFO("Started bash workflow: %s (PID: %d, stdin_fifo: %s)", workflow_id, pid, fifo_path);
     return ARGO_SUCCESS;
 }
@@ -11,6 +11,7 @@
 
 /* Project includes */
 #include "argo_daemon.h"
+#include "argo_daemon_workflow_recovery.h"
 #include "argo_http_server.h"
 #include "argo_workflow_registry.h"
 #include "argo_error.h"
@@ -95,6 +96,7 @@ int api_workflow_pause(http_request_t* req, http_response_t* resp) {
     /* Update state to paused */
     workflow_entry_t* mutable_entry = (workflow_entry_t*)entry;
     mutable_entry->state = WORKFLOW_STATE_PAUSED;
+    workflow_recovery_request_save(g_api_daemon);
 
     /* Build success response */
     char response_json[ARGO_BUFFER_MEDIUM];
@@ -151,6 +153,7 @@ int api_workflow_resume(http_request_t* req, http_response_t* resp) {
     /* Update state back to running */
     workflow_entry_t* mutable_entry = (workflow_entry_t*)entry;
     mutable_entry->state = WORKFLOW_STATE_RUNNING;
+    workflow_recovery_request_save(g_api_daemon);
 
     /* Build success response */
     char response_json[ARGO_BUFFER_MEDIUM];
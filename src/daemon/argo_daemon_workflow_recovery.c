@@ -0,0 +1,276 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Workflow recovery - persist executor identity and reattach after daemon restart */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifdef __APPLE__
+#include <sys/sysctl.h>
+#endif
+
+/* Project includes */
+#include "argo_daemon_workflow_recovery.h"
+#include "argo_daemon.h"
+#include "argo_workflow_registry.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_filesystem.h"
+#include "argo_limits.h"
+#include "argo_log.h"
+
+/* Helper: Build path of an entry under ~/.argo */
+static int argo_home_path(const char* leaf, char* path, size_t size) {
+    const char* home = getenv(ENV_VAR_HOME);
+    if (!home) home = ".";
+
+    int written = snprintf(path, size, "%s/.argo/%s", home, leaf);
+    if (written < 0 || (size_t)written >= size) {
+        return E_INPUT_TOO_LARGE;
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Build path of the persisted workflow registry */
+int workflow_recovery_registry_path(char* path, size_t size) {
+    ARGO_CHECK_NULL(path);
+    return argo_home_path(WORKFLOW_RECOVERY_REGISTRY_FILE, path, size);
+}
+
+/* Build path of a workflow's executor log */
+int workflow_recovery_log_path(const char* workflow_id, char* path, size_t size) {
+    ARGO_CHECK_NULL(workflow_id);
+    ARGO_CHECK_NULL(path);
+
+    char leaf[ARGO_PATH_MAX];
+    snprintf(leaf, sizeof(leaf), "%s/%s%s", WORKFLOW_RECOVERY_LOG_DIR,
+             workflow_id, WORKFLOW_RECOVERY_LOG_SUFFIX);
+    return argo_home_path(leaf, path, size);
+}
+
+/* Create the named stdin FIFO for a workflow and open it */
+int workflow_recovery_fifo_create(const char* workflow_id, char* path, size_t size) {
+    if (!workflow_id || !path) {
+        return -1;
+    }
+
+    char fifo_dir[ARGO_PATH_MAX];
+    if (argo_home_path(WORKFLOW_RECOVERY_FIFO_DIR, fifo_dir, sizeof(fifo_dir)) != ARGO_SUCCESS) {
+        return -1;
+    }
+    mkdir(fifo_dir, ARGO_DIR_MODE_PRIVATE);  /* Ignore EEXIST */
+
+    snprintf(path, size, "%s/%s%s", fifo_dir, workflow_id, WORKFLOW_RECOVERY_FIFO_SUFFIX);
+
+    /* Replace stale FIFO left by a workflow that reused this ID */
+    unlink(path);
+    if (mkfifo(path, ARGO_FILE_MODE_PRIVATE) < 0) {
+        argo_report_error(E_SYSTEM_FILE, "workflow_recovery_fifo_create",
+                         ERR_FMT_SYSCALL_ERROR, path, strerror(errno));
+        path[0] = '\0';
+        return -1;
+    }
+
+    /* Read-write open never blocks waiting for the other end (Linux and macOS).
+     * Close-on-exec: an executor holding another workflow's FIFO open would
+     * keep that workflow from ever seeing EOF on stdin. */
+    int fd = open(path, O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        argo_report_error(E_SYSTEM_FILE, "workflow_recovery_fifo_create",
+                         ERR_FMT_SYSCALL_ERROR, path, strerror(errno));
+        unlink(path);
+        path[0] = '\0';
+        return -1;
+    }
+
+    return fd;
+}
+
+/* Close a workflow's stdin FIFO and remove it from disk */
+void workflow_recovery_release_stdin(workflow_entry_t* entry) {
+    if (!entry) return;
+
+    if (entry->stdin_pipe > 0) {
+        close(entry->stdin_pipe);
+        entry->stdin_pipe = 0;
+    }
+    if (entry->stdin_fifo[0]) {
+        unlink(entry->stdin_fifo);
+        entry->stdin_fifo[0] = '\0';
+    }
+}
+
+/* Read a process's kernel start time */
+unsigned long long workflow_recovery_start_ticks(pid_t pid) {
+    if (pid <= 0) return 0;
+
+#ifdef __APPLE__
+    /* No /proc on macOS - use kinfo_proc start timestamp (microseconds) */
+    int mib[] = {CTL_KERN, KERN_PROC, KERN_PROC_PID, (int)pid};
+    struct kinfo_proc info;
+    size_t len = sizeof(info);
+    if (sysctl(mib, sizeof(mib) / sizeof(mib[0]), &info, &len, NULL, 0) != 0 || len == 0) {
+        return 0;
+    }
+    return (unsigned long long)info.kp_proc.p_starttime.tv_sec * MICROSECONDS_PER_SECOND +
+           (unsigned long long)info.kp_proc.p_starttime.tv_usec;
+#else
+    char stat_path[ARGO_PATH_MAX];
+    snprintf(stat_path, sizeof(stat_path), "/proc/%d/stat", (int)pid);
+
+    FILE* fp = fopen(stat_path, FILE_MODE_READ);
+    if (!fp) return 0;
+
+    char line[ARGO_BUFFER_MEDIUM];
+    char* got = fgets(line, sizeof(line), fp);
+    fclose(fp);
+    if (!got) return 0;
+
+    /* comm (field 2) may contain spaces and parens - skip past the last ')' */
+    char* p = strrchr(line, ')');
+    if (!p) return 0;
+    p++;
+
+    for (int field = 0; field < PROC_STAT_FIELDS_BEFORE_STARTTIME; field++) {
+        while (*p == ' ') p++;
+        while (*p && *p != ' ') p++;
+    }
+
+    return strtoull(p, NULL, DECIMAL_BASE);
+#endif
+}
+
+/* Check that a workflow's executor is still the process we started */
+bool workflow_recovery_process_alive(const workflow_entry_t* entry) {
+    if (!entry || entry->executor_pid <= 0) {
+        return false;
+    }
+
+    if (kill(entry->executor_pid, 0) != 0 && errno != EPERM) {
+        return false;
+    }
+
+    /* PID is in use - make sure it is still our executor */
+    if (entry->proc_start_ticks != 0) {
+        unsigned long long ticks = workflow_recovery_start_ticks(entry->executor_pid);
+        if (ticks != 0 && ticks != entry->proc_start_ticks) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Persist the daemon's workflow registry */
+int workflow_recovery_save(argo_daemon_t* daemon) {
+    ARGO_CHECK_NULL(daemon);
+    if (!daemon->workflow_registry) {
+        return E_INPUT_NULL;
+    }
+
+    char path[ARGO_PATH_MAX];
+    int result = workflow_recovery_registry_path(path, sizeof(path));
+    if (result != ARGO_SUCCESS) {
+        return result;
+    }
+
+    atomic_store(&daemon->registry_save_pending, false);
+    return workflow_registry_save(daemon->workflow_registry, path);
+}
+
+/* Ask the shared-services thread to persist the registry */
+void workflow_recovery_request_save(argo_daemon_t* daemon) {
+    if (!daemon) return;
+    atomic_store(&daemon->registry_save_pending, true);
+}
+
+/* Helper: Adopt one surviving executor, or drop it if it is gone */
+static bool reattach_entry(argo_daemon_t* daemon, const workflow_entry_t* snapshot) {
+    workflow_entry_t* entry = (workflow_entry_t*)workflow_registry_find(
+        daemon->workflow_registry, snapshot->workflow_id);
+    if (!entry) {
+        return false;
+    }
+
+    bool in_flight = (entry->state == WORKFLOW_STATE_RUNNING ||
+                      entry->state == WORKFLOW_STATE_PAUSED);
+
+    if (!in_flight || !workflow_recovery_process_alive(entry)) {
+        if (in_flight || entry->state == WORKFLOW_STATE_PENDING) {
+            LOG_WARN("Workflow %s (PID %d) did not survive daemon restart, dropping",
+                    entry->workflow_id, entry->executor_pid);
+            workflow_recovery_release_stdin(entry);
+            workflow_registry_remove(daemon->workflow_registry, snapshot->workflow_id);
+        }
+        return false;
+    }
+
+    /* Reconnect stdin - the executor still holds the read end of the FIFO */
+    entry->stdin_pipe = 0;
+    if (entry->stdin_fifo[0]) {
+        int fd = open(entry->stdin_fifo, O_RDWR | O_CLOEXEC);
+        if (fd >= 0) {
+            entry->stdin_pipe = fd;
+        } else {
+            LOG_WARN("Workflow %s: cannot reopen stdin FIFO %s: %s",
+                    entry->workflow_id, entry->stdin_fifo, strerror(errno));
+            entry->stdin_fifo[0] = '\0';
+        }
+    }
+
+    entry->reattached = true;
+    LOG_INFO("Reattached workflow %s (PID %d, state %s)",
+            entry->workflow_id, entry->executor_pid,
+            workflow_state_to_string(entry->state));
+    return true;
+}
+
+/* Reattach to executors that survived a daemon restart */
+int workflow_recovery_reattach(argo_daemon_t* daemon) {
+    ARGO_CHECK_NULL(daemon);
+    if (!daemon->workflow_registry) {
+        return E_INPUT_NULL;
+    }
+
+    char path[ARGO_PATH_MAX];
+    int result = workflow_recovery_registry_path(path, sizeof(path));
+    if (result != ARGO_SUCCESS) {
+        return result;
+    }
+
+    result = workflow_registry_load(daemon->workflow_registry, path);
+    if (result != ARGO_SUCCESS) {
+        return result;
+    }
+
+    /* Iterate a snapshot - reattach_entry may remove entries */
+    workflow_entry_t* entries = NULL;
+    int count = 0;
+    result = workflow_registry_list(daemon->workflow_registry, &entries, &count);
+    if (result != ARGO_SUCCESS) {
+        return result;
+    }
+
+    int reattached = 0;
+    for (int i = 0; i < count; i++) {
+        if (reattach_entry(daemon, &entries[i])) {
+            reattached++;
+        }
+    }
+    free(entries);
+
+    if (count > 0) {
+        LOG_INFO("Workflow recovery: %d of %d persisted workflows reattached",
+                reattached, count);
+        workflow_recovery_save(daemon);
+    }
+
+    return reattached;
+}
@@ -11,6 +11,7 @@
 #include <arpa/inet.h>
 #include <pthread.h>
 #include <errno.h>
+#include <fcntl.h>
 
 /* Project includes */
 #include "argo_http_server.h"
@@ -89,6 +90,7 @@ http_method_t http_method_from_string(const char* str) {
     if (strcmp(str, HTTP_METHOD_STR_POST) == 0) return HTTP_METHOD_POST;
     if (strcmp(str, HTTP_METHOD_STR_DELETE) == 0) return HTTP_METHOD_DELETE;
     if (strcmp(str, HTTP_METHOD_STR_PUT) == 0) return HTTP_METHOD_PUT;
+    if (strcmp(str, HTTP_METHOD_STR_PATCH) == 0) return HTTP_METHOD_PATCH;
     return HTTP_METHOD_UNKNOWN;
 }
 
@@ -99,6 +101,7 @@ const char* http_method_string(http_method_t method) {
         case HTTP_METHOD_POST: return HTTP_METHOD_STR_POST;
         case HTTP_METHOD_DELETE: return HTTP_METHOD_STR_DELETE;
         case HTTP_METHOD_PUT: return HTTP_METHOD_STR_PUT;
+        case HTTP_METHOD_PATCH: return HTTP_METHOD_STR_PATCH;
         default: return HTTP_METHOD_STR_UNKNOWN;
     }
 }
@@ -109,7 +112,7 @@ static int parse_http_request(const char* buffer, size_t len, http_request_t* re
     char method[HTTP_METHOD_SIZE] = {0};
     char path[HTTP_PATH_SIZE] = {0};
 
-    if (sscanf(buffer, "%15s %255s", method, path) != 2) {
+    if (sscanf(buffer, "%15s %1023s", method, path) != 2) {  /* HTTP_METHOD_SIZE-1, HTTP_PATH_SIZE-1 */
         return E_INVALID_PARAMS;
     }
 
@@ -309,6 +312,10 @@ int http_server_start(http_server_t* server) {
         return E_SYSTEM_SOCKET;
     }
 
+    /* Keep listening socket out of forked workflow executors - they outlive */
+    /* the daemon and would otherwise hold its port across a restart */
+    fcntl(server->socket_fd, F_SETFD, FD_CLOEXEC);
+
     /* Set socket options */
     int opt = 1;
     if (setsockopt(server->socket_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0) {
@@ -353,6 +360,7 @@ int http_server_start(http_server_t* server) {
                 break;  /* Server stopping */
             }
         }
+        fcntl(client_fd, F_SETFD, FD_CLOEXEC);
 
         /* Spawn thread to handle connection */
         connection_arg_t* arg = malloc(sizeof(connection_arg_t));
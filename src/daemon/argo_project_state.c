@@ -0,0 +1,393 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Project state store - cached, versioned state.json with atomic patches */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* mkstemp(), fchmod() */
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/* Project includes */
+#include "argo_project_state.h"
+#include "argo_json_doc.h"
+#include "argo_file_utils.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_limits.h"
+#include "argo_log.h"
+
+/* One cached state file */
+typedef struct {
+    char id[PROJECT_STATE_ID_MAX];
+    char path[ARGO_PATH_MAX];
+    json_node_t* doc;   /* NULL until loaded */
+    long long version;
+    ino_t ino;          /* File identity at last load/write */
+    off_t size;
+    time_t mtime;
+} state_entry_t;
+
+struct project_state_store {
+    pthread_mutex_t lock;
+    char registry_path[ARGO_PATH_MAX];
+    state_entry_t* entries;
+    int count;
+    int capacity;
+};
+
+/* Create store */
+project_state_store_t* project_state_store_create(const char* registry_path) {
+    project_state_store_t* store = calloc(1, sizeof(project_state_store_t));
+    if (!store) {
+        argo_report_error(E_SYSTEM_MEMORY, "project_state_store_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return NULL;
+    }
+
+    if (registry_path) {
+        snprintf(store->registry_path, sizeof(store->registry_path), "%s", registry_path);
+    } else if (getenv(PROJECT_STATE_REGISTRY_ENV)) {
+        snprintf(store->registry_path, sizeof(store->registry_path), "%s", getenv(PROJECT_STATE_REGISTRY_ENV));
+    } else {
+        const char* home = getenv("HOME");
+        snprintf(store->registry_path, sizeof(store->registry_path), "%s/%s",
+                 home ? home : ".", PROJECT_STATE_REGISTRY_FILE);
+    }
+
+    pthread_mutex_init(&store->lock, NULL);
+    return store;
+}
+
+/* Helper: Look up project path in the registry */
+static int resolve_project(const project_state_store_t* store, const char* project_id,
+                           char* path, size_t size) {
+    char* text = NULL;
+    size_t len = 0;
+    json_node_t* registry = NULL;
+
+    int result = file_read_all(store->registry_path, &text, &len);
+    if (result != ARGO_SUCCESS) return E_NOT_FOUND;
+
+    result = json_doc_parse(text, len, &registry);
+    if (result != ARGO_SUCCESS) {
+        LOG_WARN("Project registry %s is not valid JSON", store->registry_path);
+        result = E_NOT_FOUND;
+        goto cleanup;
+    }
+
+    /* Direct member lookup - IDs are not escaped as pointers */
+    result = E_NOT_FOUND;
+    json_node_t* projects = json_doc_get(registry, "/projects");
+    for (int i = 0; projects && projects->type == JSON_DOC_OBJECT && i < projects->count; i++) {
+        if (strcmp(projects->children[i]->key, project_id) != 0) continue;
+        json_node_t* dir = json_doc_get(projects->children[i], "/path");
+        if (dir && dir->type == JSON_DOC_STRING) {
+            snprintf(path, size, "%s/%s", dir->text, PROJECT_STATE_FILE);
+            result = ARGO_SUCCESS;
+        }
+        break;
+    }
+
+cleanup:
+    json_doc_free(registry);
+    free(text);
+    return result;
+}
+
+/* Helper: Version recorded in a document, 0 if none */
+static long long doc_version(json_node_t* doc) {
+    long long version = 0;
+    json_doc_get_integer(json_doc_get(doc, "/" PROJECT_STATE_VERSION_FIELD), &version);
+    return version;
+}
+
+/* Helper: Remember file identity so outside writes can be detected */
+static void record_identity(state_entry_t* entry, const struct stat* st) {
+    entry->ino = st->st_ino;
+    entry->size = st->st_size;
+    entry->mtime = st->st_mtime;
+}
+
+/* Helper: Bring entry in line with the file on disk */
+static int refresh_entry(state_entry_t* entry) {
+    struct stat st;
+    if (stat(entry->path, &st) != 0) {
+        return E_NOT_FOUND;
+    }
+    if (entry->doc && st.st_ino == entry->ino && st.st_size == entry->size &&
+        st.st_mtime == entry->mtime) {
+        return ARGO_SUCCESS;
+    }
+
+    char* text = NULL;
+    size_t len = 0;
+    json_node_t* doc = NULL;
+    int result = file_read_all(entry->path, &text, &len);
+    if (result != ARGO_SUCCESS) return result;
+
+    result = json_doc_parse(text, len, &doc);
+    free(text);
+    if (result != ARGO_SUCCESS) {
+        LOG_WARN("Project state %s is not valid JSON", entry->path);
+        return E_INPUT_FORMAT;
+    }
+
+    /* Outside writers keep the old state_version - still a new version */
+    long long version = doc_version(doc);
+    if (entry->doc && version <= entry->version) {
+        version = entry->version + 1;
+    }
+
+    json_doc_free(entry->doc);
+    entry->doc = doc;
+    entry->version = version;
+    record_identity(entry, &st);
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Drop cached entry at index */
+static void drop_entry(project_state_store_t* store, int index) {
+    json_doc_free(store->entries[index].doc);
+    store->entries[index] = store->entries[store->count - 1];
+    store->count--;
+}
+
+/* Helper: Find or load entry for project (caller holds lock) */
+static int acquire_entry(project_state_store_t* store, const char* project_id, state_entry_t** out) {
+    if (!*project_id || strlen(project_id) >= PROJECT_STATE_ID_MAX) return E_NOT_FOUND;
+
+    for (int i = 0; i < store->count; i++) {
+        if (strcmp(store->entries[i].id, project_id) != 0) continue;
+        int result = refresh_entry(&store->entries[i]);
+        if (result == ARGO_SUCCESS) {
+            *out = &store->entries[i];
+            return ARGO_SUCCESS;
+        }
+        /* File gone or broken - resolve through the registry again */
+        drop_entry(store, i);
+        break;
+    }
+
+    if (store->count == store->capacity) {
+        int capacity = store->capacity ? store->capacity * 2 : PROJECT_STATE_INITIAL_CAPACITY;
+        state_entry_t* grown = realloc(store->entries, (size_t)capacity * sizeof(state_entry_t));
+        if (!grown) return E_SYSTEM_MEMORY;
+        store->entries = grown;
+        store->capacity = capacity;
+    }
+
+    state_entry_t* entry = &store->entries[store->count];
+    memset(entry, 0, sizeof(*entry));
+    snprintf(entry->id, sizeof(entry->id), "%s", project_id);
+
+    int result = resolve_project(store, project_id, entry->path, sizeof(entry->path));
+    if (result == ARGO_SUCCESS) result = refresh_entry(entry);
+    if (result != ARGO_SUCCESS) {
+        json_doc_free(entry->doc);
+        return result;
+    }
+
+    store->count++;
+    *out = entry;
+    return ARGO_SUCCESS;
+}
+
+/* Read state */
+int project_state_get(project_state_store_t* store, const char* project_id,
+                      const char** pointers, int count,
+                      char** json, long long* version) {
+    ARGO_CHECK_NULL(store);
+    ARGO_CHECK_NULL(project_id);
+    ARGO_CHECK_NULL(json);
+    ARGO_CHECK_NULL(version);
+
+    json_node_t* values = NULL;
+    state_entry_t* entry = NULL;
+
+    pthread_mutex_lock(&store->lock);
+    int result = acquire_entry(store, project_id, &entry);
+    if (result != ARGO_SUCCESS) goto cleanup;
+
+    if (!pointers || count == 0) {
+        *json = json_doc_serialize(entry->doc);
+    } else {
+        values = json_doc_new_array();
+        for (int i = 0; values && i < count && result == ARGO_SUCCESS; i++) {
+            json_node_t* found = json_doc_get(entry->doc, pointers[i]);
+            json_node_t* value = found ? json_doc_clone(found) : json_doc_new_null();
+            result = value ? json_doc_append(values, NULL, value) : E_SYSTEM_MEMORY;
+            if (result != ARGO_SUCCESS) json_doc_free(value);
+        }
+        if (result != ARGO_SUCCESS) goto cleanup;
+        *json = json_doc_serialize(values);
+    }
+
+    if (!*json) {
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
+    *version = entry->version;
+
+cleanup:
+    pthread_mutex_unlock(&store->lock);
+    json_doc_free(values);
+    return result;
+}
+
+/* Helper: Apply one patch operation to doc */
+static int apply_op(json_node_t* doc, const json_node_t* op) {
+    json_node_t* name = json_doc_get((json_node_t*)op, "/op");
+    json_node_t* path = json_doc_get((json_node_t*)op, "/path");
+    json_node_t* value = json_doc_get((json_node_t*)op, "/value");
+
+    if (!name || name->type != JSON_DOC_STRING || !path || path->type != JSON_DOC_STRING) {
+        return E_INPUT_INVALID;
+    }
+
+    if (strcmp(name->text, PROJECT_STATE_OP_REMOVE) == 0) {
+        return json_doc_remove(doc, path->text) == ARGO_SUCCESS ? ARGO_SUCCESS : E_INPUT_INVALID;
+    }
+    if (!value) return E_INPUT_INVALID;
+
+    if (strcmp(name->text, PROJECT_STATE_OP_TEST) == 0) {
+        return json_doc_equal(json_doc_get(doc, path->text), value) ? ARGO_SUCCESS : E_PROTOCOL_VERSION;
+    }
+    if (strcmp(name->text, PROJECT_STATE_OP_REPLACE) == 0) {
+        if (!json_doc_get(doc, path->text)) return E_INPUT_INVALID;
+    } else if (strcmp(name->text, PROJECT_STATE_OP_ADD) != 0) {
+        return E_INPUT_INVALID;
+    }
+
+    json_node_t* copy = json_doc_clone(value);
+    if (!copy) return E_SYSTEM_MEMORY;
+    if (json_doc_set(doc, path->text, copy) != ARGO_SUCCESS) {
+        json_doc_free(copy);
+        return E_INPUT_INVALID;
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Write text to path via temp file + rename */
+static int write_atomic(const char* path, const char* text) {
+    char temp[ARGO_PATH_MAX];
+    int needed = snprintf(temp, sizeof(temp), "%s%s", path, PROJECT_STATE_TEMP_SUFFIX);
+    if (needed < 0 || (size_t)needed >= sizeof(temp)) {
+        argo_report_error(E_INPUT_TOO_LARGE, "write_atomic", ERR_FMT_FAILED_TO_OPEN, path);
+        return E_INPUT_TOO_LARGE;
+    }
+
+    int fd = mkstemp(temp);
+    if (fd < 0) {
+        argo_report_error(E_SYSTEM_FILE, "write_atomic", ERR_FMT_SYSCALL_ERROR, temp, strerror(errno));
+        return E_SYSTEM_FILE;
+    }
+    fchmod(fd, ARGO_FILE_PERMISSIONS);
+
+    size_t len = strlen(text);
+    size_t written = 0;
+    while (written < len) {
+        ssize_t n = write(fd, text + written, len - written);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        written += (size_t)n;
+    }
+    bool ok = (written == len) && write(fd, "\n", 1) == 1;
+    ok = (close(fd) == 0) && ok;
+
+    if (!ok || rename(temp, path) != 0) {
+        argo_report_error(E_SYSTEM_FILE, "write_atomic", ERR_FMT_SYSCALL_ERROR, path, strerror(errno));
+        unlink(temp);
+        return E_SYSTEM_FILE;
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Apply patch atomically */
+int project_state_patch(project_state_store_t* store, const char* project_id,
+                        const json_node_t* ops, long long expected, long long* version) {
+    ARGO_CHECK_NULL(store);
+    ARGO_CHECK_NULL(project_id);
+    ARGO_CHECK_NULL(ops);
+    ARGO_CHECK_NULL(version);
+    if (ops->type != JSON_DOC_ARRAY) return E_INPUT_INVALID;
+
+    json_node_t* draft = NULL;
+    char* text = NULL;
+    state_entry_t* entry = NULL;
+
+    pthread_mutex_lock(&store->lock);
+    int result = acquire_entry(store, project_id, &entry);
+    if (result != ARGO_SUCCESS) goto cleanup;
+
+    *version = entry->version;
+    if (expected != PROJECT_STATE_ANY_VERSION && expected != entry->version) {
+        result = E_PROTOCOL_VERSION;
+        goto cleanup;
+    }
+
+    /* Apply to a copy so a failing operation leaves the state untouched */
+    draft = json_doc_clone(entry->doc);
+    if (!draft) {
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
+    for (int i = 0; i < ops->count && result == ARGO_SUCCESS; i++) {
+        result = apply_op(draft, ops->children[i]);
+    }
+    if (result != ARGO_SUCCESS) goto cleanup;
+
+    json_node_t* stamp = json_doc_new_integer(entry->version + 1);
+    if (!stamp) {
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
+    result = json_doc_set(draft, "/" PROJECT_STATE_VERSION_FIELD, stamp);
+    if (result != ARGO_SUCCESS) {
+        json_doc_free(stamp);
+        result = E_INPUT_INVALID;  /* Patched root is no longer an object */
+        goto cleanup;
+    }
+
+    text = json_doc_serialize(draft);
+    if (!text) {
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
+    result = write_atomic(entry->path, text);
+    if (result != ARGO_SUCCESS) goto cleanup;
+
+    struct stat st;
+    if (stat(entry->path, &st) == 0) {
+        record_identity(entry, &st);
+    }
+    json_doc_free(entry->doc);
+    entry->doc = draft;
+    draft = NULL;
+    entry->version++;
+    *version = entry->version;
+
+cleanup:
+    pthread_mutex_unlock(&store->lock);
+    json_doc_free(draft);
+    free(text);
+    return result;
+}
+
+/* Destroy store */
+void project_state_store_destroy(project_state_store_t* store) {
+    if (!store) return;
+
+    for (int i = 0; i < store->count; i++) {
+        json_doc_free(store->entries[i].doc);
+    }
+    free(store->entries);
+    pthread_mutex_destroy(&store->lock);
+    free(store);
+}
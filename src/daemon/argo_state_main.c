@@ -0,0 +1,337 @@
+/* © 2025 Casey Koons All rights reserved */
+/* argo-state - Command line client for the daemon project state API */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <curl/curl.h>
+
+/* Project includes */
+#include "argo_daemon_project_api.h"
+#include "argo_daemon_client.h"
+#include "argo_project_state.h"
+#include "argo_json_doc.h"
+#include "argo_http_server.h"
+#include "argo_error.h"
+#include "argo_limits.h"
+
+/* Exit codes (workflows/lib/state_file.sh falls back to jq on UNAVAILABLE/NOT_FOUND) */
+#define STATE_EXIT_OK 0
+#define STATE_EXIT_ERROR 1
+#define STATE_EXIT_CONFLICT 2
+#define STATE_EXIT_UNAVAILABLE 3
+#define STATE_EXIT_NOT_FOUND 4
+
+/* Request settings */
+#define STATE_CONNECT_TIMEOUT_SECONDS 2L
+#define STATE_TIMEOUT_SECONDS 10L
+#define STATE_CONTENT_TYPE_HEADER "Content-Type: application/json"
+#define STATE_STDIN_MARKER "-"
+
+/* Response buffer */
+typedef struct {
+    char* data;
+    size_t len;
+} state_response_t;
+
+/* Helper: Print usage */
+static void print_usage(const char* prog) {
+    fprintf(stderr, "Usage:\n");
+    fprintf(stderr, "  %s get <project> [pointer...]\n", prog);
+    fprintf(stderr, "  %s set <project> <pointer> <value> [<pointer> <value>...] [--json] [--version N]\n", prog);
+    fprintf(stderr, "  %s patch <project> [--version N] [ops-json|-]\n", prog);
+    fprintf(stderr, "  %s version <project>\n", prog);
+    fprintf(stderr, "\nPointers are JSON pointers (/design/status). 'get' prints strings raw\n");
+    fprintf(stderr, "and null as an empty line. --version N applies only if N is current.\n");
+    fprintf(stderr, "Exit: 0 ok, 1 error, 2 version conflict, 3 daemon unavailable, 4 no state\n");
+}
+
+/* Helper: Daemon base URL from the process environment
+ * (like arc - skips loading .env files and config on every call) */
+static const char* daemon_url(void) {
+    static char url[ARGO_BUFFER_MEDIUM];
+    const char* host = getenv(ARGO_DAEMON_HOST_ENV);
+    const char* port = getenv(ARGO_DAEMON_PORT_ENV);
+
+    int port_num = port ? atoi(port) : 0;
+    if (port_num <= 0 || port_num > MAX_VALID_PORT) port_num = ARGO_DAEMON_DEFAULT_PORT;
+    snprintf(url, sizeof(url), "http://%s:%d", host && *host ? host : ARGO_DAEMON_DEFAULT_HOST, port_num);
+    return url;
+}
+
+/* Helper: curl write callback */
+static size_t write_callback(void* contents, size_t size, size_t nmemb, void* userp) {
+    size_t realsize = size * nmemb;
+    state_response_t* resp = (state_response_t*)userp;
+
+    char* grown = realloc(resp->data, resp->len + realsize + 1);
+    if (!grown) return 0;
+    resp->data = grown;
+    memcpy(resp->data + resp->len, contents, realsize);
+    resp->len += realsize;
+    resp->data[resp->len] = '\0';
+    return realsize;
+}
+
+/* Helper: Perform request; returns exit code, *reply holds the parsed body */
+static int send_request(CURL* curl, const char* url, const char* method, const char* body,
+                        json_node_t** reply, long* status) {
+    state_response_t resp = {0};
+    struct curl_slist* headers = NULL;
+    int code = STATE_EXIT_ERROR;
+
+    curl_easy_setopt(curl, CURLOPT_URL, url);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &resp);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, STATE_CONNECT_TIMEOUT_SECONDS);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, STATE_TIMEOUT_SECONDS);
+    if (body) {
+        headers = curl_slist_append(headers, STATE_CONTENT_TYPE_HEADER);
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, method);
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body);
+    }
+
+    CURLcode res = curl_easy_perform(curl);
+    if (res != CURLE_OK) {
+        fprintf(stderr, "argo-state: daemon unavailable: %s\n", curl_easy_strerror(res));
+        code = STATE_EXIT_UNAVAILABLE;
+        goto cleanup;
+    }
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, status);
+
+    if (!resp.data || json_doc_parse(resp.data, resp.len, reply) != ARGO_SUCCESS) {
+        fprintf(stderr, "argo-state: invalid response (HTTP %ld)\n", *status);
+        goto cleanup;
+    }
+
+    if (*status == HTTP_STATUS_OK) {
+        code = STATE_EXIT_OK;
+    } else {
+        json_node_t* message = json_doc_get(*reply, "/message");
+        fprintf(stderr, "argo-state: %s\n",
+                message && message->type == JSON_DOC_STRING ? message->text : "request failed");
+        if (*status == HTTP_STATUS_CONFLICT) code = STATE_EXIT_CONFLICT;
+        else if (*status == HTTP_STATUS_NOT_FOUND) code = STATE_EXIT_NOT_FOUND;
+    }
+
+cleanup:
+    curl_slist_free_all(headers);
+    free(resp.data);
+    return code;
+}
+
+/* Helper: Print one value the way 'jq -r' would */
+static void print_value(const json_node_t* value) {
+    if (!value || value->type == JSON_DOC_NULL) {
+        printf("\n");
+    } else if (value->type == JSON_DOC_STRING) {
+        printf("%s\n", value->text);
+    } else {
+        char* text = json_doc_serialize(value);
+        printf("%s\n", text ? text : "");
+        free(text);
+    }
+}
+
+/* Helper: Build state URL for project, with optional ?ptr= list */
+static int build_url(CURL* curl, const char* project, char** pointers, int count,
+                     char* url, size_t size) {
+    char* escaped = curl_easy_escape(curl, project, 0);
+    if (!escaped) return STATE_EXIT_ERROR;
+    size_t offset = (size_t)snprintf(url, size, "%s%s/%s%s", daemon_url(),
+                                     PROJECT_API_PATH, escaped, PROJECT_API_STATE_SUFFIX);
+    curl_free(escaped);
+
+    for (int i = 0; i < count && offset < size; i++) {
+        escaped = curl_easy_escape(curl, pointers[i], 0);
+        if (!escaped) return STATE_EXIT_ERROR;
+        offset += (size_t)snprintf(url + offset, size - offset, "%c%s=%s",
+                                   i == 0 ? '?' : '&', PROJECT_API_QUERY_POINTER, escaped);
+        curl_free(escaped);
+    }
+    if (offset >= size) {
+        fprintf(stderr, "argo-state: too many pointers for one request\n");
+        return STATE_EXIT_ERROR;
+    }
+    return STATE_EXIT_OK;
+}
+
+/* get / version */
+static int cmd_get(CURL* curl, const char* project, char** pointers, int count, bool version_only) {
+    char url[HTTP_PATH_SIZE + ARGO_BUFFER_MEDIUM];
+    json_node_t* reply = NULL;
+    long status = 0;
+
+    int code = build_url(curl, project, pointers, count, url, sizeof(url));
+    if (code == STATE_EXIT_OK) code = send_request(curl, url, NULL, NULL, &reply, &status);
+    if (code != STATE_EXIT_OK) goto cleanup;
+
+    if (version_only) {
+        print_value(json_doc_get(reply, "/version"));
+    } else if (count == 0) {
+        print_value(json_doc_get(reply, "/state"));
+    } else {
+        json_node_t* values = json_doc_get(reply, "/values");
+        for (int i = 0; values && i < values->count; i++) {
+            print_value(values->children[i]);
+        }
+    }
+
+cleanup:
+    json_doc_free(reply);
+    return code;
+}
+
+/* Helper: Send {"version":N,"patch":ops}; takes ownership of ops */
+static int send_patch(CURL* curl, const char* project, json_node_t* ops,
+                      long long version, bool print_version) {
+    char url[HTTP_PATH_SIZE + ARGO_BUFFER_MEDIUM];
+    json_node_t* request = json_doc_new_object();
+    json_node_t* reply = NULL;
+    char* body = NULL;
+    long status = 0;
+    int code = STATE_EXIT_ERROR;
+
+    if (!request || json_doc_append(request, "patch", ops) != ARGO_SUCCESS) {
+        json_doc_free(ops);
+        goto cleanup;
+    }
+    if (version != PROJECT_STATE_ANY_VERSION) {
+        json_node_t* stamp = json_doc_new_integer(version);
+        if (!stamp || json_doc_append(request, "version", stamp) != ARGO_SUCCESS) {
+            json_doc_free(stamp);
+            goto cleanup;
+        }
+    }
+    body = json_doc_serialize(request);
+    if (!body) goto cleanup;
+
+    code = build_url(curl, project, NULL, 0, url, sizeof(url));
+    if (code == STATE_EXIT_OK) code = send_request(curl, url, HTTP_METHOD_STR_PATCH, body, &reply, &status);
+    if (code == STATE_EXIT_OK && print_version) {
+        print_value(json_doc_get(reply, "/version"));
+    }
+
+cleanup:
+    json_doc_free(reply);
+    json_doc_free(request);
+    free(body);
+    return code;
+}
+
+/* Helper: Append {"op":"add","path":pointer,"value":value} */
+static int append_set_op(json_node_t* ops, const char* pointer, const char* text, bool as_json) {
+    json_node_t* op = json_doc_new_object();
+    json_node_t* name = json_doc_new_string(PROJECT_STATE_OP_ADD);
+    json_node_t* path = json_doc_new_string(pointer);
+    json_node_t* value = NULL;
+
+    int result = as_json ? json_doc_parse(text, strlen(text), &value) : ARGO_SUCCESS;
+    if (!as_json) value = json_doc_new_string(text);
+    if (result != ARGO_SUCCESS) {
+        fprintf(stderr, "argo-state: value for %s is not valid JSON\n", pointer);
+    } else if (!op || !name || !path || !value) {
+        result = E_SYSTEM_MEMORY;
+    }
+
+    if (result == ARGO_SUCCESS) result = json_doc_append(op, "op", name);
+    if (result == ARGO_SUCCESS) { name = NULL; result = json_doc_append(op, "path", path); }
+    if (result == ARGO_SUCCESS) { path = NULL; result = json_doc_append(op, "value", value); }
+    if (result == ARGO_SUCCESS) { value = NULL; result = json_doc_append(ops, NULL, op); }
+    if (result == ARGO_SUCCESS) op = NULL;
+
+    json_doc_free(op);
+    json_doc_free(name);
+    json_doc_free(path);
+    json_doc_free(value);
+    return result;
+}
+
+/* Helper: Read all of stdin */
+static char* read_stdin(void) {
+    state_response_t buf = {0};
+    char chunk[ARGO_BUFFER_STANDARD];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), stdin)) > 0) {
+        if (write_callback(chunk, 1, n, &buf) != n) {
+            free(buf.data);
+            return NULL;
+        }
+    }
+    return buf.data ? buf.data : strdup("");
+}
+
+/* Main entry point */
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        print_usage(argv[0]);
+        return STATE_EXIT_ERROR;
+    }
+    const char* command = argv[1];
+    const char* project = argv[2];
+
+    /* Split options from positional arguments */
+    char** args = calloc((size_t)argc, sizeof(char*));
+    int arg_count = 0;
+    long long version = PROJECT_STATE_ANY_VERSION;
+    bool as_json = false;
+    if (!args) return STATE_EXIT_ERROR;
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            as_json = true;
+        } else if (strcmp(argv[i], "--version") == 0 && i + 1 < argc) {
+            version = strtoll(argv[++i], NULL, 10);
+        } else {
+            args[arg_count++] = argv[i];
+        }
+    }
+
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    CURL* curl = curl_easy_init();
+    int code = STATE_EXIT_ERROR;
+    if (!curl) goto cleanup;
+
+    if (strcmp(command, "get") == 0) {
+        code = cmd_get(curl, project, args, arg_count, false);
+    } else if (strcmp(command, "version") == 0) {
+        code = cmd_get(curl, project, NULL, 0, true);
+    } else if (strcmp(command, "set") == 0) {
+        json_node_t* ops = json_doc_new_array();
+        if (!ops || arg_count == 0 || arg_count % 2 != 0) {
+            print_usage(argv[0]);
+            json_doc_free(ops);
+            goto cleanup;
+        }
+        for (int i = 0; i < arg_count; i += 2) {
+            if (append_set_op(ops, args[i], args[i + 1], as_json) != ARGO_SUCCESS) {
+                json_doc_free(ops);
+                goto cleanup;
+            }
+        }
+        code = send_patch(curl, project, ops, version, false);
+    } else if (strcmp(command, "patch") == 0) {
+        bool from_stdin = (arg_count == 0 || strcmp(args[0], STATE_STDIN_MARKER) == 0);
+        char* text = from_stdin ? read_stdin() : strdup(args[0]);
+        json_node_t* ops = NULL;
+        if (!text || json_doc_parse(text, strlen(text), &ops) != ARGO_SUCCESS ||
+            ops->type != JSON_DOC_ARRAY) {
+            fprintf(stderr, "argo-state: patch must be a JSON array of operations\n");
+            json_doc_free(ops);
+            free(text);
+            goto cleanup;
+        }
+        free(text);
+        code = send_patch(curl, project, ops, version, true);
+    } else {
+        print_usage(argv[0]);
+    }
+
+cleanup:
+    if (curl) curl_easy_cleanup(curl);
+    curl_global_cleanup();
+    free(args);
+    return code;
+}
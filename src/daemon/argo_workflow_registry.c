@@ -5,6 +5,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <unistd.h>
 
 /* Project includes */
 #include "argo_workflow_registry.h"
@@ -13,6 +14,7 @@
 #include "argo_log.h"
 #include "argo_json.h"
 #include "argo_limits.h"
+#include "argo_file_utils.h"
 
 /* Registry entry node */
 typedef struct registry_node {
@@ -257,7 +259,11 @@ int workflow_registry_save(const workflow_registry_t* reg, const char* path) {
         return E_INPUT_NULL;
     }
 
-    FILE* fp = fopen(path, "w");
+    /* Write to a temp file and rename, so a crash never leaves a torn registry */
+    char tmp_path[ARGO_PATH_MAX];
+    snprintf(tmp_path, sizeof(tmp_path), "%s%s", path, WORKFLOW_REGISTRY_TMP_SUFFIX);
+
+    FILE* fp = fopen(tmp_path, "w");
     if (!fp) {
         argo_report_error(E_SYSTEM_FILE, "workflow_registry_save", path);
         return E_SYSTEM_FILE;
@@ -289,7 +295,9 @@ int workflow_registry_save(const workflow_registry_t* reg, const char* path) {
         fprintf(fp, "      \"timeout_seconds\": %d,\n", node->entry.timeout_seconds);
         fprintf(fp, "      \"retry_count\": %d,\n", node->entry.retry_count);
         fprintf(fp, "      \"max_retries\": %d,\n", node->entry.max_retries);
-        fprintf(fp, "      \"last_retry_time\": %ld\n", (long)node->entry.last_retry_time);
+        fprintf(fp, "      \"last_retry_time\": %ld,\n", (long)node->entry.last_retry_time);
+        fprintf(fp, "      \"proc_start_ticks\": %llu,\n", node->entry.proc_start_ticks);
+        fprintf(fp, "      \"stdin_fifo\": \"%s\"\n", node->entry.stdin_fifo);
         fprintf(fp, "    }");
 
         node = node->next;
@@ -298,54 +306,136 @@ int workflow_registry_save(const workflow_registry_t* reg, const char* path) {
     fprintf(fp, "\n  ]\n");
     fprintf(fp, "}\n");
 
-    fclose(fp);
+    if (fclose(fp) != 0 || rename(tmp_path, path) != 0) {
+        argo_report_error(E_SYSTEM_FILE, "workflow_registry_save", path);
+        unlink(tmp_path);
+        return E_SYSTEM_FILE;
+    }
 
     LOG_DEBUG("Saved %d workflows to %s", reg->count, path);
     return ARGO_SUCCESS;
 }
 
+/* Helper: Locate value of "field": within [ptr, entry_end) */
+static const char* find_field_value(const char* ptr, const char* entry_end,
+                                    const char* field_name) {
+    char search_str[ARGO_BUFFER_SMALL];
+    snprintf(search_str, sizeof(search_str), "\"%s\":", field_name);
+
+    const char* field_start = strstr(ptr, search_str);
+    if (!field_start || field_start >= entry_end) {
+        return NULL;
+    }
+    return field_start + strlen(search_str);
+}
+
+/* Helper: Extract string field from JSON entry */
+static void extract_string_field(const char* ptr, const char* entry_end,
+                                 const char* field_name,
+                                 char* out_buffer, size_t buffer_size) {
+    const char* value = find_field_value(ptr, entry_end, field_name);
+    if (!value) return;
+
+    const char* start = strchr(value, '"');
+    if (!start || start >= entry_end) return;
+    start++;
+
+    const char* end = strchr(start, '"');
+    if (!end || end >= entry_end) return;
+
+    size_t len = end - start;
+    if (len >= buffer_size) {
+        len = buffer_size - 1;
+    }
+    strncpy(out_buffer, start, len);
+    out_buffer[len] = '\0';
+}
+
+/* Helper: Extract integer field from JSON entry (0 if missing) */
+static long long extract_number_field(const char* ptr, const char* entry_end,
+                                      const char* field_name) {
+    const char* value = find_field_value(ptr, entry_end, field_name);
+    if (!value) return 0;
+    return strtoll(value, NULL, DECIMAL_BASE);
+}
+
+/* Helper: Parse one persisted entry bounded by [ptr, entry_end) */
+static void parse_entry(const char* ptr, const char* entry_end, workflow_entry_t* entry) {
+    char state[ARGO_BUFFER_TINY] = {0};
+
+    extract_string_field(ptr, entry_end, WORKFLOW_JSON_ID,
+                         entry->workflow_id, sizeof(entry->workflow_id));
+    extract_string_field(ptr, entry_end, WORKFLOW_JSON_NAME,
+                         entry->workflow_name, sizeof(entry->workflow_name));
+    extract_string_field(ptr, entry_end, WORKFLOW_JSON_STATE, state, sizeof(state));
+    extract_string_field(ptr, entry_end, WORKFLOW_JSON_STDIN_FIFO,
+                         entry->stdin_fifo, sizeof(entry->stdin_fifo));
+
+    entry->state = workflow_state_from_string(state);
+    entry->executor_pid = (pid_t)extract_number_field(ptr, entry_end, WORKFLOW_JSON_PID);
+    entry->start_time = (time_t)extract_number_field(ptr, entry_end, WORKFLOW_JSON_START_TIME);
+    entry->end_time = (time_t)extract_number_field(ptr, entry_end, WORKFLOW_JSON_END_TIME);
+    entry->exit_code = (int)extract_number_field(ptr, entry_end, WORKFLOW_JSON_EXIT_CODE);
+    entry->current_step = (int)extract_number_field(ptr, entry_end, WORKFLOW_JSON_CURRENT_STEP);
+    entry->total_steps = (int)extract_number_field(ptr, entry_end, WORKFLOW_JSON_TOTAL_STEPS);
+    entry->timeout_seconds = (int)extract_number_field(ptr, entry_end, WORKFLOW_JSON_TIMEOUT);
+    entry->retry_count = (int)extract_number_field(ptr, entry_end, WORKFLOW_JSON_RETRY_COUNT);
+    entry->max_retries = (int)extract_number_field(ptr, entry_end, WORKFLOW_JSON_MAX_RETRIES);
+    entry->last_retry_time = (time_t)extract_number_field(ptr, entry_end, WORKFLOW_JSON_LAST_RETRY);
+    entry->proc_start_ticks = (unsigned long long)extract_number_field(ptr, entry_end,
+                                                                       WORKFLOW_JSON_START_TICKS);
+}
+
 /* Load registry from JSON file */
 int workflow_registry_load(workflow_registry_t* reg, const char* path) {
     if (!reg || !path) {
         return E_INPUT_NULL;
     }
 
-    FILE* fp = fopen(path, "r");
-    if (!fp) {
+    char* json = NULL;
+    size_t file_size = 0;
+    if (access(path, F_OK) != 0) {
         /* Not an error - file may not exist yet */
         LOG_DEBUG("No registry file to load: %s", path);
         return ARGO_SUCCESS;
     }
 
-    /* Read entire file */
-    fseek(fp, 0, SEEK_END);
-    long size = ftell(fp);
-    fseek(fp, 0, SEEK_SET);
-
-    char* json = malloc(size + 1);
-    if (!json) {
-        fclose(fp);
-        argo_report_error(E_SYSTEM_MEMORY, "workflow_registry_load",
-                         ERR_MSG_ALLOCATION_FAILED);
-        return E_SYSTEM_MEMORY;
+    int result = file_read_all(path, &json, &file_size);
+    if (result != ARGO_SUCCESS) {
+        return result;  /* file_read_all logged the cause */
     }
 
-    size_t read = fread(json, 1, size, fp);
-    if (read != (size_t)size && ferror(fp)) {
-        argo_report_error(E_SYSTEM_IO, "workflow_registry_load",
-                         "Failed to read %ld bytes from %s (read %zu)", size, path, read);
+    /* Find start of workflows array */
+    const char* ptr = strstr(json, "\"workflows\":");
+    ptr = ptr ? strchr(ptr, '[') : NULL;
+    if (!ptr) {
+        LOG_WARN("No workflows array in registry file: %s", path);
         free(json);
-        fclose(fp);
-        return E_SYSTEM_IO;
+        return ARGO_SUCCESS;
     }
-    json[read] = '\0';
-    fclose(fp);
-
-    /* Parse JSON (simplified - just extract workflow entries) */
-    /* Note: Full JSON parsing would use jsmn or similar */
-    /* For now, this is a placeholder that loads minimal data */
+    ptr++;
 
+    /* Parse each entry (entries are flat objects, so '}' ends one) */
     int loaded = 0;
+    while (*ptr && *ptr != ']') {
+        while (*ptr == ' ' || *ptr == '\n' || *ptr == '\t' || *ptr == ',') ptr++;
+        if (*ptr != '{') break;
+
+        const char* entry_end = strchr(ptr, '}');
+        if (!entry_end) break;
+
+        workflow_entry_t entry = {0};
+        parse_entry(ptr, entry_end, &entry);
+
+        if (entry.workflow_id[0] && !find_node(reg, entry.workflow_id)) {
+            if (workflow_registry_add(reg, &entry) == ARGO_SUCCESS) {
+                loaded++;
+            }
+        }
+
+        ptr = entry_end + 1;
+    }
+
     LOG_INFO("Loaded %d workflows from %s", loaded, path);
 
     free(json);
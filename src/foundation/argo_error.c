@@ -36,6 +36,7 @@ static const char* get_error_description(int code) {
         case E_CI_OVERLOAD:       return "CI overloaded";
         case E_CI_DISCONNECTED:   return "CI disconnected";
         case E_CI_NO_PROVIDER:    return "No CI provider available";
+        case E_CI_CANCELLED:      return "CI request cancelled";
 
         /* Input errors */
         case E_INPUT_NULL:        return "Null pointer provided";
@@ -103,6 +104,7 @@ const char* argo_error_name(int code) {
         case E_CI_OVERLOAD:       return "E_CI_OVERLOAD";
         case E_CI_DISCONNECTED:   return "E_CI_DISCONNECTED";
         case E_CI_NO_PROVIDER:    return "E_CI_NO_PROVIDER";
+        case E_CI_CANCELLED:      return "E_CI_CANCELLED";
         case E_INPUT_NULL:        return "E_INPUT_NULL";
         case E_INPUT_RANGE:       return "E_INPUT_RANGE";
         case E_INPUT_FORMAT:      return "E_INPUT_FORMAT";
@@ -142,6 +144,7 @@ const char* argo_error_suggestion(int code) {
         case E_CI_INVALID:        return "Check CI response format and retry";
         case E_CI_DISCONNECTED:   return "Reconnect to CI provider";
         case E_CI_NO_PROVIDER:    return "Configure at least one CI provider";
+        case E_CI_CANCELLED:      return "Resubmit the request if still needed";
         case E_INPUT_NULL:        return "Provide valid non-null input";
         case E_INPUT_RANGE:       return "Use value within valid range";
         case E_INPUT_TOO_LARGE:   return "Reduce input size";
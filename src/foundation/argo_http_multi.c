@@ -0,0 +1,269 @@
+/* © 2025 Casey Koons All rights reserved */
+
+/* HTTP Multi - concurrent requests driven by one curl_multi reactor thread */
+
+/* System includes */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <curl/curl.h>
+
+/* Project includes */
+#include "argo_http_multi.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_log.h"
+
+/* One submitted request */
+typedef struct http_multi_job {
+    uint64_t id;
+    http_request_t* req;
+    http_transfer_t* transfer;
+    http_multi_done_fn on_done;
+    void* userdata;
+    bool added;                 /* In the curl multi handle */
+    bool cancelled;
+    struct http_multi_job* next;
+} http_multi_job_t;
+
+struct http_multi {
+    CURLM* curlm;               /* Reactor thread only */
+    pthread_t thread;
+    pthread_mutex_t lock;       /* Guards everything below */
+    http_multi_job_t* jobs;
+    int count;
+    uint64_t next_id;
+    bool dirty;                 /* New submissions or cancels to apply */
+    bool running;
+};
+
+/* Helper: Deliver result and free job */
+static void finish_job(http_multi_job_t* job, int result, http_response_t* resp) {
+    http_transfer_destroy(job->transfer);
+    job->on_done(result, resp, job->userdata);
+    http_request_free(job->req);
+    free(job);
+}
+
+/* Helper: Add new jobs, detach cancelled ones (all when stopping) */
+static http_multi_job_t* apply_changes(http_multi_t* multi, bool* running) {
+    http_multi_job_t* detached = NULL;
+
+    pthread_mutex_lock(&multi->lock);
+    *running = multi->running;
+    if (multi->dirty) {
+        multi->dirty = false;
+        http_multi_job_t** link = &multi->jobs;
+        while (*link) {
+            http_multi_job_t* job = *link;
+            if (job->cancelled || !*running) {
+                *link = job->next;
+                if (job->added) {
+                    curl_multi_remove_handle(multi->curlm, http_transfer_handle(job->transfer));
+                }
+                job->next = detached;
+                detached = job;
+                multi->count--;
+                continue;
+            }
+            if (!job->added) {
+                curl_multi_add_handle(multi->curlm, http_transfer_handle(job->transfer));
+                job->added = true;
+            }
+            link = &job->next;
+        }
+    }
+    pthread_mutex_unlock(&multi->lock);
+
+    return detached;
+}
+
+/* Helper: Unlink the job owning a finished easy handle */
+static http_multi_job_t* take_job(http_multi_t* multi, CURL* curl) {
+    http_transfer_t* transfer = http_transfer_from_handle(curl);
+
+    pthread_mutex_lock(&multi->lock);
+    http_multi_job_t** link = &multi->jobs;
+    while (*link && (*link)->transfer != transfer) {
+        link = &(*link)->next;
+    }
+    http_multi_job_t* job = *link;
+    if (job) {
+        *link = job->next;
+        multi->count--;
+    }
+    pthread_mutex_unlock(&multi->lock);
+
+    return job;
+}
+
+/* Helper: Complete finished transfers */
+static void drain_completed(http_multi_t* multi) {
+    CURLMsg* msg = NULL;
+    int remaining = 0;
+
+    while ((msg = curl_multi_info_read(multi->curlm, &remaining))) {
+        if (msg->msg != CURLMSG_DONE) continue;
+
+        CURL* curl = msg->easy_handle;
+        CURLcode code = msg->data.result;
+        curl_multi_remove_handle(multi->curlm, curl);
+
+        http_multi_job_t* job = take_job(multi, curl);
+        if (!job) continue;
+
+        http_response_t* resp = NULL;
+        int result = http_transfer_finish(job->transfer, code, &resp);
+        job->transfer = NULL;
+        finish_job(job, result, resp);
+    }
+}
+
+/* Helper: Reactor loop */
+static void* reactor_thread(void* arg) {
+    http_multi_t* multi = (http_multi_t*)arg;
+    bool running = true;
+
+    while (running) {
+        http_multi_job_t* detached = apply_changes(multi, &running);
+        while (detached) {
+            http_multi_job_t* next = detached->next;
+            finish_job(detached, E_CI_CANCELLED, NULL);
+            detached = next;
+        }
+        if (!running) break;
+
+        int active = 0;
+        curl_multi_perform(multi->curlm, &active);
+        drain_completed(multi);
+        curl_multi_poll(multi->curlm, NULL, 0, HTTP_MULTI_POLL_MS, NULL);
+    }
+
+    return NULL;
+}
+
+/* Create multi client */
+http_multi_t* http_multi_create(void) {
+    if (http_init() != ARGO_SUCCESS) {
+        return NULL;
+    }
+
+    http_multi_t* multi = calloc(1, sizeof(http_multi_t));
+    if (!multi) {
+        argo_report_error(E_SYSTEM_MEMORY, "http_multi_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return NULL;
+    }
+
+    multi->curlm = curl_multi_init();
+    if (!multi->curlm) {
+        argo_report_error(E_SYSTEM_NETWORK, "http_multi_create", "curl_multi_init failed");
+        free(multi);
+        return NULL;
+    }
+
+    pthread_mutex_init(&multi->lock, NULL);
+    multi->next_id = 1;
+    multi->running = true;
+
+    if (pthread_create(&multi->thread, NULL, reactor_thread, multi) != 0) {
+        argo_report_error(E_SYSTEM_THREAD, "http_multi_create", "failed to start reactor");
+        curl_multi_cleanup(multi->curlm);
+        pthread_mutex_destroy(&multi->lock);
+        free(multi);
+        return NULL;
+    }
+
+    return multi;
+}
+
+/* Submit request */
+int http_multi_submit(http_multi_t* multi, http_request_t* req, long timeout_ms,
+                      http_chunk_fn on_chunk, http_multi_done_fn on_done, void* userdata,
+                      uint64_t* id) {
+    ARGO_CHECK_NULL(multi);
+    ARGO_CHECK_NULL(req);
+    ARGO_CHECK_NULL(on_done);
+
+    http_multi_job_t* job = calloc(1, sizeof(http_multi_job_t));
+    if (!job) {
+        argo_report_error(E_SYSTEM_MEMORY, "http_multi_submit", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return E_SYSTEM_MEMORY;
+    }
+
+    int result = http_transfer_create(req, on_chunk, userdata, timeout_ms, &job->transfer);
+    if (result != ARGO_SUCCESS) {
+        free(job);
+        return result;
+    }
+
+    job->req = req;
+    job->on_done = on_done;
+    job->userdata = userdata;
+
+    pthread_mutex_lock(&multi->lock);
+    if (!multi->running) {
+        pthread_mutex_unlock(&multi->lock);
+        http_transfer_destroy(job->transfer);
+        free(job);
+        return E_INVALID_STATE;
+    }
+    job->id = multi->next_id++;
+    job->next = multi->jobs;
+    multi->jobs = job;
+    multi->count++;
+    multi->dirty = true;
+    if (id) *id = job->id;
+    pthread_mutex_unlock(&multi->lock);
+
+    curl_multi_wakeup(multi->curlm);
+    return ARGO_SUCCESS;
+}
+
+/* Cancel request */
+int http_multi_cancel(http_multi_t* multi, uint64_t id) {
+    ARGO_CHECK_NULL(multi);
+
+    int result = E_NOT_FOUND;
+    pthread_mutex_lock(&multi->lock);
+    for (http_multi_job_t* job = multi->jobs; job; job = job->next) {
+        if (job->id == id && !job->cancelled) {
+            job->cancelled = true;
+            multi->dirty = true;
+            result = ARGO_SUCCESS;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&multi->lock);
+
+    if (result == ARGO_SUCCESS) {
+        curl_multi_wakeup(multi->curlm);
+    }
+    return result;
+}
+
+/* Count outstanding requests */
+int http_multi_pending(http_multi_t* multi) {
+    if (!multi) return 0;
+
+    pthread_mutex_lock(&multi->lock);
+    int count = multi->count;
+    pthread_mutex_unlock(&multi->lock);
+    return count;
+}
+
+/* Stop reactor and free client */
+void http_multi_destroy(http_multi_t* multi) {
+    if (!multi) return;
+
+    pthread_mutex_lock(&multi->lock);
+    multi->running = false;
+    multi->dirty = true;
+    pthread_mutex_unlock(&multi->lock);
+
+    curl_multi_wakeup(multi->curlm);
+    pthread_join(multi->thread, NULL);
+
+    curl_multi_cleanup(multi->curlm);
+    pthread_mutex_destroy(&multi->lock);
+    free(multi);
+}
@@ -0,0 +1,430 @@
+/* © 2025 Casey Koons All rights reserved */
+
+/* HTTP transfers - shared libcurl state, handle pool and request setup */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <curl/curl.h>
+
+/* Project includes */
+#include "argo_http_transfer.h"
+#include "argo_error.h"
+#include "argo_log.h"
+#include "argo_limits.h"
+
+/* Shared client state (guarded by g_http_lock) */
+static pthread_mutex_t g_http_lock = PTHREAD_MUTEX_INITIALIZER;
+static bool g_http_initialized = false;
+static CURLSH* g_http_share = NULL;
+static pthread_mutex_t g_http_share_locks[CURL_LOCK_DATA_LAST];
+static CURL* g_http_idle[HTTP_POOL_MAX_IDLE];
+static int g_http_idle_count = 0;
+
+/* Growable response body */
+typedef struct {
+    char* data;
+    size_t size;
+    size_t capacity;
+} http_buffer_t;
+
+/* One prepared transfer */
+struct http_transfer {
+    CURL* curl;
+    struct curl_slist* headers;
+    http_response_t* resp;
+    http_buffer_t body;         /* Whole body, or error body when streaming */
+    http_chunk_fn callback;     /* NULL unless streaming */
+    void* userdata;
+    const char* url;            /* For error messages; request outlives transfer */
+};
+
+/* Helper: Lock shared data for libcurl */
+static void share_lock(CURL* handle, curl_lock_data data, curl_lock_access access, void* userptr) {
+    (void)handle;
+    (void)access;
+    (void)userptr;
+    pthread_mutex_lock(&g_http_share_locks[data]);
+}
+
+/* Helper: Unlock shared data for libcurl */
+static void share_unlock(CURL* handle, curl_lock_data data, void* userptr) {
+    (void)handle;
+    (void)userptr;
+    pthread_mutex_unlock(&g_http_share_locks[data]);
+}
+
+/* Helper: Initialize libcurl and the share handle (caller holds g_http_lock) */
+static int init_locked(void) {
+    if (g_http_initialized) return ARGO_SUCCESS;
+
+    if (curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) {
+        argo_report_error(E_SYSTEM_NETWORK, "http_init", "curl_global_init failed");
+        return E_SYSTEM_NETWORK;
+    }
+
+    for (int i = 0; i < CURL_LOCK_DATA_LAST; i++) {
+        pthread_mutex_init(&g_http_share_locks[i], NULL);
+    }
+
+    /* Share handle failure only costs reuse, requests still work */
+    g_http_share = curl_share_init();
+    if (g_http_share) {
+        curl_share_setopt(g_http_share, CURLSHOPT_LOCKFUNC, share_lock);
+        curl_share_setopt(g_http_share, CURLSHOPT_UNLOCKFUNC, share_unlock);
+        curl_share_setopt(g_http_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(g_http_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        curl_share_setopt(g_http_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+    } else {
+        LOG_WARN("HTTP share handle unavailable, connections will not be shared");
+    }
+
+    g_http_initialized = true;
+    return ARGO_SUCCESS;
+}
+
+/* Initialize HTTP client */
+int http_init(void) {
+    pthread_mutex_lock(&g_http_lock);
+    int result = init_locked();
+    pthread_mutex_unlock(&g_http_lock);
+    return result;
+}
+
+/* Cleanup HTTP client - closes pooled connections */
+void http_cleanup(void) {
+    pthread_mutex_lock(&g_http_lock);
+    if (!g_http_initialized) {
+        pthread_mutex_unlock(&g_http_lock);
+        return;
+    }
+
+    for (int i = 0; i < g_http_idle_count; i++) {
+        curl_easy_cleanup(g_http_idle[i]);
+    }
+    g_http_idle_count = 0;
+
+    /* Leave everything in place if a request is still in flight */
+    if (g_http_share && curl_share_cleanup(g_http_share) != CURLSHE_OK) {
+        LOG_WARN("HTTP cleanup while requests are active, keeping shared state");
+        pthread_mutex_unlock(&g_http_lock);
+        return;
+    }
+    g_http_share = NULL;
+
+    for (int i = 0; i < CURL_LOCK_DATA_LAST; i++) {
+        pthread_mutex_destroy(&g_http_share_locks[i]);
+    }
+    curl_global_cleanup();
+    g_http_initialized = false;
+    pthread_mutex_unlock(&g_http_lock);
+}
+
+/* Helper: Take an easy handle from the idle pool or create one */
+static CURL* acquire_handle(void) {
+    CURL* curl = NULL;
+
+    pthread_mutex_lock(&g_http_lock);
+    if (init_locked() == ARGO_SUCCESS) {
+        if (g_http_idle_count > 0) {
+            curl = g_http_idle[--g_http_idle_count];
+        } else {
+            curl = curl_easy_init();
+        }
+    }
+    CURLSH* share = g_http_share;
+    pthread_mutex_unlock(&g_http_lock);
+
+    if (!curl) return NULL;
+
+    /* Reset clears options but keeps the handle's live connections */
+    curl_easy_reset(curl);
+    if (share) {
+        curl_easy_setopt(curl, CURLOPT_SHARE, share);
+    }
+    return curl;
+}
+
+/* Helper: Return an easy handle to the idle pool */
+static void release_handle(CURL* curl) {
+    if (!curl) return;
+
+    pthread_mutex_lock(&g_http_lock);
+    if (g_http_initialized && g_http_idle_count < HTTP_POOL_MAX_IDLE) {
+        g_http_idle[g_http_idle_count++] = curl;
+        curl = NULL;
+    }
+    pthread_mutex_unlock(&g_http_lock);
+
+    if (curl) curl_easy_cleanup(curl);
+}
+
+/* Helper: libcurl body callback - append to growable buffer */
+static size_t write_body(char* data, size_t size, size_t nmemb, void* userdata) {
+    http_buffer_t* buf = (http_buffer_t*)userdata;
+    size_t len = size * nmemb;
+
+    if (buf->size + len + 1 > buf->capacity) {
+        size_t capacity = buf->capacity ? buf->capacity : HTTP_CHUNK_SIZE;
+        while (buf->size + len + 1 > capacity) capacity *= 2;
+        char* grown = realloc(buf->data, capacity);
+        if (!grown) return 0;  /* Aborts transfer with CURLE_WRITE_ERROR */
+        buf->data = grown;
+        buf->capacity = capacity;
+    }
+
+    memcpy(buf->data + buf->size, data, len);
+    buf->size += len;
+    buf->data[buf->size] = '\0';
+    return len;
+}
+
+/* Helper: libcurl header callback - collect "Name: value" lines */
+static size_t write_header(char* data, size_t size, size_t nmemb, void* userdata) {
+    http_response_t* resp = (http_response_t*)userdata;
+    size_t len = size * nmemb;
+
+    /* A new status line (100 Continue, redirect) starts a fresh header set */
+    if (len > strlen("HTTP/") && strncmp(data, "HTTP/", strlen("HTTP/")) == 0) {
+        http_headers_free(resp->headers);
+        resp->headers = NULL;
+        return len;
+    }
+
+    const char* colon = memchr(data, ':', len);
+    if (!colon) return len;
+
+    const char* value = colon + 1;
+    const char* end = data + len;
+    while (value < end && (*value == ' ' || *value == '\t')) value++;
+    while (end > value && (end[-1] == '\r' || end[-1] == '\n' || end[-1] == ' ')) end--;
+
+    http_header_t* header = calloc(1, sizeof(http_header_t));
+    if (!header) return 0;
+    header->name = strndup(data, colon - data);
+    header->value = strndup(value, end - value);
+    if (!header->name || !header->value) {
+        http_headers_free(header);
+        return 0;
+    }
+
+    http_header_t** tail = &resp->headers;
+    while (*tail) tail = &(*tail)->next;
+    *tail = header;
+    return len;
+}
+
+/* Helper: Build libcurl header list from request headers */
+static struct curl_slist* build_header_list(const http_request_t* req) {
+    struct curl_slist* list = NULL;
+
+    for (http_header_t* h = req->headers; h; h = h->next) {
+        /* Sized to the header so long values are never cut short */
+        size_t size = strlen(h->name) + strlen(h->value) + 3;  /* ": " and NUL */
+        char* line = malloc(size);
+        if (!line) goto fail;
+        snprintf(line, size, "%s: %s", h->name, h->value);
+        struct curl_slist* next = curl_slist_append(list, line);
+        free(line);
+        if (!next) goto fail;
+        list = next;
+    }
+
+    struct curl_slist* next = curl_slist_append(list, HTTP_HEADER_EXPECT_NONE);
+    if (!next) goto fail;
+    return next;
+
+fail:
+    curl_slist_free_all(list);
+    return NULL;
+}
+
+/* Helper: Set method and in-memory body */
+static void set_method(CURL* curl, const http_request_t* req) {
+    const char* body = req->body ? req->body : "";
+    curl_off_t body_len = req->body ? (curl_off_t)req->body_len : 0;
+
+    /* GUIDELINE_APPROVED - HTTP method strings (protocol constants) */
+    switch (req->method) {
+        case HTTP_POST:
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, body_len);
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body);
+            break;
+        case HTTP_PUT:
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, HTTP_METHOD_STR_PUT);
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, body_len);
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body);
+            break;
+        case HTTP_DELETE:
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, HTTP_METHOD_STR_DELETE);
+            if (req->body) {
+                curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, body_len);
+                curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body);
+            }
+            break;
+        case HTTP_GET:
+        default:
+            curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+            break;
+    }
+    /* GUIDELINE_APPROVED_END */
+}
+
+/* Helper: libcurl body callback for streaming - pass 2xx bodies through */
+static size_t write_stream(char* data, size_t size, size_t nmemb, void* userdata) {
+    http_transfer_t* transfer = (http_transfer_t*)userdata;
+    size_t len = size * nmemb;
+    long status = 0;
+
+    /* Error bodies are collected for the caller instead of streamed */
+    curl_easy_getinfo(transfer->curl, CURLINFO_RESPONSE_CODE, &status);
+    if (status < HTTP_STATUS_OK || status >= HTTP_STATUS_SUCCESS_END) {
+        return write_body(data, size, nmemb, &transfer->body);
+    }
+
+    transfer->callback(data, len, transfer->userdata);
+    return len;
+}
+
+/* Prepare transfer */
+int http_transfer_create(const http_request_t* req, http_chunk_fn callback, void* userdata,
+                         long timeout_ms, http_transfer_t** out) {
+    ARGO_CHECK_NULL(req);
+    ARGO_CHECK_NULL(req->url);
+    ARGO_CHECK_NULL(out);
+
+    http_transfer_t* transfer = calloc(1, sizeof(http_transfer_t));
+    if (!transfer) return E_SYSTEM_MEMORY;
+
+    transfer->url = req->url;
+    transfer->callback = callback;
+    transfer->userdata = userdata;
+    transfer->resp = calloc(1, sizeof(http_response_t));
+    transfer->headers = build_header_list(req);
+    if (!transfer->resp || !transfer->headers) {
+        http_transfer_destroy(transfer);
+        return E_SYSTEM_MEMORY;
+    }
+
+    transfer->curl = acquire_handle();
+    if (!transfer->curl) {
+        argo_report_error(E_SYSTEM_NETWORK, "http_execute", "Failed to create HTTP handle");
+        http_transfer_destroy(transfer);
+        return E_SYSTEM_NETWORK;
+    }
+
+    if (timeout_ms <= 0) {
+        long seconds = req->timeout_seconds > 0 ? req->timeout_seconds : HTTP_DEFAULT_TIMEOUT_SECONDS;
+        timeout_ms = seconds * MILLISECONDS_PER_SECOND;
+    }
+
+    CURL* curl = transfer->curl;
+    curl_easy_setopt(curl, CURLOPT_URL, req->url);
+    curl_easy_setopt(curl, CURLOPT_PRIVATE, transfer);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeout_ms);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_DNS_CACHE_TIMEOUT, (long)HTTP_DNS_CACHE_SECONDS);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, transfer->headers);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, write_header);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, transfer->resp);
+    set_method(curl, req);
+
+    if (callback) {
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_stream);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, transfer);
+    } else {
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_body);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer->body);
+    }
+
+    *out = transfer;
+    return ARGO_SUCCESS;
+}
+
+/* Get easy handle */
+CURL* http_transfer_handle(const http_transfer_t* transfer) {
+    return transfer ? transfer->curl : NULL;
+}
+
+/* Find transfer owning an easy handle */
+http_transfer_t* http_transfer_from_handle(CURL* curl) {
+    http_transfer_t* transfer = NULL;
+    if (curl) {
+        curl_easy_getinfo(curl, CURLINFO_PRIVATE, (char**)&transfer);
+    }
+    return transfer;
+}
+
+/* Complete transfer and build response */
+int http_transfer_finish(http_transfer_t* transfer, CURLcode code, http_response_t** resp) {
+    int result = ARGO_SUCCESS;
+
+    if (!transfer || !resp) {
+        http_transfer_destroy(transfer);
+        return E_INPUT_NULL;
+    }
+
+    if (code != CURLE_OK) {
+        result = (code == CURLE_OPERATION_TIMEDOUT) ? E_SYSTEM_TIMEOUT : E_SYSTEM_NETWORK;
+        argo_report_error(result, "http_execute", "%s: %s", transfer->url, curl_easy_strerror(code));
+        goto cleanup;
+    }
+
+    long status_code = 0;
+    curl_easy_getinfo(transfer->curl, CURLINFO_RESPONSE_CODE, &status_code);
+    if (!transfer->body.data) {
+        transfer->body.data = strdup("");
+        if (!transfer->body.data) {
+            result = E_SYSTEM_MEMORY;
+            goto cleanup;
+        }
+    }
+
+    /* Validate HTTP status code - catch non-OK responses */
+    if (status_code < HTTP_STATUS_OK || status_code >= HTTP_STATUS_SERVER_ERROR) {
+        LOG_WARN("HTTP request returned non-2xx status: %ld", status_code);
+        /* Still return the response so caller can handle it */
+    }
+
+    /* Validate response body is not empty for successful requests */
+    if (!transfer->callback && status_code == HTTP_STATUS_OK && transfer->body.size == 0) {
+        LOG_WARN("HTTP request returned OK but empty body");
+        /* This might be valid for some APIs, so don't fail */
+    }
+
+    curl_off_t sent = 0, received = 0, ttfb_us = 0, total_us = 0;
+    curl_easy_getinfo(transfer->curl, CURLINFO_SIZE_UPLOAD_T, &sent);
+    curl_easy_getinfo(transfer->curl, CURLINFO_SIZE_DOWNLOAD_T, &received);
+    curl_easy_getinfo(transfer->curl, CURLINFO_STARTTRANSFER_TIME_T, &ttfb_us);
+    curl_easy_getinfo(transfer->curl, CURLINFO_TOTAL_TIME_T, &total_us);
+    transfer->resp->bytes_sent = (size_t)sent;
+    transfer->resp->bytes_received = (size_t)received;
+    transfer->resp->ttfb_ms = (long long)ttfb_us / MICROSECONDS_PER_MILLISECOND;
+    transfer->resp->total_ms = (long long)total_us / MICROSECONDS_PER_MILLISECOND;
+
+    transfer->resp->status_code = (int)status_code;
+    transfer->resp->body = transfer->body.data;
+    transfer->resp->body_len = transfer->body.size;
+    transfer->body.data = NULL;  /* Transfer ownership */
+    *resp = transfer->resp;
+    transfer->resp = NULL;
+
+cleanup:
+    http_transfer_destroy(transfer);
+    return result;
+}
+
+/* Release transfer without a response */
+void http_transfer_destroy(http_transfer_t* transfer) {
+    if (!transfer) return;
+
+    release_handle(transfer->curl);
+    curl_slist_free_all(transfer->headers);
+    free(transfer->body.data);
+    http_response_free(transfer->resp);
+    free(transfer);
+}
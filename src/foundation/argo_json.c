@@ -106,6 +106,31 @@ int json_extract_nested_string(const char* json, const char** field_path,
                                      out_value, out_len);
 }
 
+/* Escape sequence for one byte */
+size_t json_escape_char(unsigned char c, char* out) {
+    const char* short_form = NULL;
+    switch (c) {
+        case '"':  short_form = "\\\""; break;
+        case '\\': short_form = "\\\\"; break;
+        case '\n': short_form = "\\n"; break;
+        case '\r': short_form = "\\r"; break;
+        case '\t': short_form = "\\t"; break;
+        case '\b': short_form = "\\b"; break;
+        case '\f': short_form = "\\f"; break;
+        default: break;
+    }
+
+    if (short_form) {
+        memcpy(out, short_form, 3);
+        return 2;
+    }
+    if (c < JSON_FIRST_PLAIN_CHAR) {
+        snprintf(out, JSON_ESCAPE_MAX, "\\u%04x", c);
+        return JSON_ESCAPE_MAX - 1;
+    }
+    return 0;
+}
+
 /* Escape string and append to JSON buffer */
 int json_escape_string(char* dest, size_t dest_size, size_t* dest_offset,
                        const char* src) {
@@ -115,18 +140,20 @@ int json_escape_string(char* dest, size_t dest_size, size_t* dest_offset,
 
     size_t offset = *dest_offset;
     const char* s = src;
+    char escaped[JSON_ESCAPE_MAX];
 
-    while (*s && offset < dest_size - 3) {
-        /* Escape quotes and backslashes */
-        if (*s == '"' || *s == '\\') {
-            dest[offset++] = '\\';
-        }
-        dest[offset++] = *s++;
-    }
+    while (*s) {
+        size_t len = json_escape_char((unsigned char)*s, escaped);
+        const char* out = len ? escaped : s;
+        if (len == 0) len = 1;
 
-    /* Check if we ran out of space */
-    if (*s != '\0') {
-        return E_SYSTEM_MEMORY;
+        /* Leave room for the terminator */
+        if (offset + len >= dest_size) {
+            return E_SYSTEM_MEMORY;
+        }
+        memcpy(dest + offset, out, len);
+        offset += len;
+        s++;
     }
 
     dest[offset] = '\0';
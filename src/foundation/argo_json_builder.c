@@ -0,0 +1,274 @@
+/* © 2025 Casey Koons All rights reserved */
+/* JSON Builder - escaping JSON writer over a growable buffer */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Project includes */
+#include "argo_json_builder.h"
+#include "argo_json.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+
+/* Helper: Record the first error */
+static void fail(json_builder_t* json, int error) {
+    if (json->error == ARGO_SUCCESS) {
+        json->error = error;
+    }
+}
+
+/* Helper: Room for extra more bytes plus the terminator */
+static bool reserve(json_builder_t* json, size_t extra) {
+    if (json->error != ARGO_SUCCESS) return false;
+
+    size_t needed = json->length + extra + 1;
+    if (needed <= json->capacity) return true;
+
+    size_t capacity = json->capacity ? json->capacity : JSON_BUILDER_MIN_CAPACITY;
+    while (capacity < needed) capacity *= 2;
+
+    char* grown = realloc(json->data, capacity);
+    if (!grown) {
+        argo_report_error(E_SYSTEM_MEMORY, "json_builder", ERR_MSG_MEMORY_ALLOC_FAILED);
+        fail(json, E_SYSTEM_MEMORY);
+        return false;
+    }
+    json->data = grown;
+    json->capacity = capacity;
+    return true;
+}
+
+/* Helper: Append bytes verbatim */
+static void append(json_builder_t* json, const char* data, size_t len) {
+    if (!reserve(json, len)) return;
+    memcpy(json->data + json->length, data, len);
+    json->length += len;
+    json->data[json->length] = '\0';
+}
+
+/* Helper: Comma or nothing before a value; objects require a key first */
+static bool begin_value(json_builder_t* json) {
+    if (json->error != ARGO_SUCCESS) return false;
+
+    if (json->after_key) {
+        json->after_key = false;
+        return true;
+    }
+    if (json->depth > 0) {
+        if (json->is_object[json->depth - 1]) {
+            fail(json, E_INPUT_INVALID);
+            return false;
+        }
+        if (json->has_items[json->depth - 1]) {
+            append(json, ",", 1);
+        }
+        json->has_items[json->depth - 1] = true;
+    } else if (json->length > 0) {
+        fail(json, E_INPUT_INVALID);    /* Second top-level value */
+        return false;
+    }
+    return json->error == ARGO_SUCCESS;
+}
+
+/* Helper: Quoted, escaped string body */
+static void append_escaped(json_builder_t* json, const char* value, size_t len) {
+    /* Reserve for the common case: little or nothing to escape */
+    if (!reserve(json, len + 2)) return;
+    append(json, "\"", 1);
+
+    char escaped[JSON_ESCAPE_MAX];
+    size_t run = 0;
+    for (size_t i = 0; i < len; i++) {
+        size_t escaped_len = json_escape_char((unsigned char)value[i], escaped);
+        if (escaped_len == 0) {
+            run++;
+            continue;
+        }
+        append(json, value + i - run, run);
+        append(json, escaped, escaped_len);
+        run = 0;
+    }
+    append(json, value + len - run, run);
+    append(json, "\"", 1);
+}
+
+/* Helper: Open container */
+static void open_container(json_builder_t* json, bool object) {
+    if (!begin_value(json)) return;
+    if (json->depth >= JSON_BUILDER_MAX_DEPTH) {
+        fail(json, E_INPUT_INVALID);
+        return;
+    }
+    append(json, object ? "{" : "[", 1);
+    json->is_object[json->depth] = object;
+    json->has_items[json->depth] = false;
+    json->depth++;
+}
+
+/* Helper: Close container */
+static void close_container(json_builder_t* json, bool object) {
+    if (json->error != ARGO_SUCCESS) return;
+    if (json->depth == 0 || json->is_object[json->depth - 1] != object || json->after_key) {
+        fail(json, E_INPUT_INVALID);
+        return;
+    }
+    json->depth--;
+    append(json, object ? "}" : "]", 1);
+}
+
+/* Initialize */
+int json_builder_init(json_builder_t* json, size_t capacity_hint) {
+    ARGO_CHECK_NULL(json);
+    memset(json, 0, sizeof(*json));
+
+    size_t capacity = capacity_hint + JSON_BUILDER_MIN_CAPACITY;
+    json->data = malloc(capacity);
+    if (!json->data) {
+        argo_report_error(E_SYSTEM_MEMORY, "json_builder_init", ERR_MSG_MEMORY_ALLOC_FAILED);
+        json->error = E_SYSTEM_MEMORY;
+        return E_SYSTEM_MEMORY;
+    }
+    json->data[0] = '\0';
+    json->capacity = capacity;
+    return ARGO_SUCCESS;
+}
+
+/* Free buffer */
+void json_builder_free(json_builder_t* json) {
+    if (!json) return;
+    free(json->data);
+    json->data = NULL;
+    json->length = 0;
+    json->capacity = 0;
+}
+
+/* Containers */
+void json_builder_object_begin(json_builder_t* json) {
+    open_container(json, true);
+}
+
+void json_builder_object_end(json_builder_t* json) {
+    close_container(json, true);
+}
+
+void json_builder_array_begin(json_builder_t* json) {
+    open_container(json, false);
+}
+
+void json_builder_array_end(json_builder_t* json) {
+    close_container(json, false);
+}
+
+/* Member name */
+void json_builder_key(json_builder_t* json, const char* key) {
+    if (!key) {
+        fail(json, E_INPUT_NULL);
+        return;
+    }
+    if (json->error != ARGO_SUCCESS) return;
+    if (json->depth == 0 || !json->is_object[json->depth - 1] || json->after_key) {
+        fail(json, E_INPUT_INVALID);
+        return;
+    }
+    if (json->has_items[json->depth - 1]) {
+        append(json, ",", 1);
+    }
+    json->has_items[json->depth - 1] = true;
+    append_escaped(json, key, strlen(key));
+    append(json, ":", 1);
+    json->after_key = true;
+}
+
+/* Values */
+void json_builder_string(json_builder_t* json, const char* value) {
+    if (!value) {
+        json_builder_null(json);
+        return;
+    }
+    json_builder_string_len(json, value, strlen(value));
+}
+
+void json_builder_string_len(json_builder_t* json, const char* value, size_t len) {
+    if (!begin_value(json)) return;
+    append_escaped(json, value, len);
+}
+
+void json_builder_int(json_builder_t* json, long long value) {
+    if (!begin_value(json)) return;
+    char number[JSON_BUILDER_NUMBER_SIZE];
+    int len = snprintf(number, sizeof(number), "%lld", value);
+    append(json, number, (size_t)len);
+}
+
+void json_builder_double(json_builder_t* json, double value) {
+    if (!begin_value(json)) return;
+    if (!isfinite(value)) {
+        append(json, "null", 4);    /* JSON has no NaN or Infinity */
+        return;
+    }
+    char number[JSON_BUILDER_NUMBER_SIZE];
+    int len = snprintf(number, sizeof(number), "%.15g", value);
+    append(json, number, (size_t)len);
+}
+
+void json_builder_bool(json_builder_t* json, bool value) {
+    if (!begin_value(json)) return;
+    append(json, value ? "true" : "false", value ? 4 : 5);
+}
+
+void json_builder_null(json_builder_t* json) {
+    if (!begin_value(json)) return;
+    append(json, "null", 4);
+}
+
+void json_builder_raw(json_builder_t* json, const char* value) {
+    if (!value) {
+        fail(json, E_INPUT_NULL);
+        return;
+    }
+    if (!begin_value(json)) return;
+    append(json, value, strlen(value));
+}
+
+/* Key and value in one call */
+void json_builder_key_string(json_builder_t* json, const char* key, const char* value) {
+    json_builder_key(json, key);
+    json_builder_string(json, value);
+}
+
+void json_builder_key_int(json_builder_t* json, const char* key, long long value) {
+    json_builder_key(json, key);
+    json_builder_int(json, value);
+}
+
+void json_builder_key_bool(json_builder_t* json, const char* key, bool value) {
+    json_builder_key(json, key);
+    json_builder_bool(json, value);
+}
+
+/* First error so far */
+int json_builder_error(const json_builder_t* json) {
+    if (!json) return E_INPUT_NULL;
+    return json->error;
+}
+
+/* Hand over the finished document */
+char* json_builder_take(json_builder_t* json, size_t* length) {
+    if (!json) return NULL;
+
+    if (json->error == ARGO_SUCCESS && (json->depth != 0 || json->after_key || json->length == 0)) {
+        fail(json, E_INPUT_INVALID);
+    }
+
+    char* data = NULL;
+    if (json->error == ARGO_SUCCESS) {
+        data = json->data;
+        json->data = NULL;
+        if (length) *length = json->length;
+    }
+    json_builder_free(json);
+    return data;
+}
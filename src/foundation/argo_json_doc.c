@@ -0,0 +1,551 @@
+/* © 2025 Casey Koons All rights reserved */
+/* JSON Document - parse, serialize, and compare JSON trees */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/* Project includes */
+#include "argo_json_doc.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#define JSMN_STATIC  /* Private copy - parser used by more than one library */
+#define JSMN_STRICT  /* Reject bare words and malformed primitives */
+#include "jsmn.h"
+
+/* Growable output buffer */
+typedef struct {
+    char* data;
+    size_t len;
+    size_t cap;
+    bool failed;
+} doc_buffer_t;
+
+/* Helper: Allocate empty node */
+static json_node_t* node_new(json_doc_type_t type) {
+    json_node_t* node = calloc(1, sizeof(json_node_t));
+    if (node) node->type = type;
+    return node;
+}
+
+/* Helper: Copy len bytes into a new string */
+static char* copy_span(const char* src, size_t len) {
+    char* out = malloc(len + 1);
+    if (!out) return NULL;
+    memcpy(out, src, len);
+    out[len] = '\0';
+    return out;
+}
+
+/* Helper: Append child to container */
+static int node_append(json_node_t* parent, json_node_t* child) {
+    if (parent->count == parent->capacity) {
+        int capacity = parent->capacity ? parent->capacity * 2 : JSON_DOC_INITIAL_CAPACITY;
+        json_node_t** grown = realloc(parent->children, (size_t)capacity * sizeof(json_node_t*));
+        if (!grown) return E_SYSTEM_MEMORY;
+        parent->children = grown;
+        parent->capacity = capacity;
+    }
+    parent->children[parent->count++] = child;
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Parse four hex digits */
+static int parse_hex4(const char* src, unsigned* value) {
+    *value = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = src[i];
+        unsigned digit;
+        if (c >= '0' && c <= '9') digit = (unsigned)(c - '0');
+        else if (c >= 'a' && c <= 'f') digit = (unsigned)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') digit = (unsigned)(c - 'A' + 10);
+        else return E_INPUT_FORMAT;
+        *value = (*value << 4) | digit;
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Write code point as UTF-8, returns bytes written */
+static size_t put_utf8(char* out, unsigned cp) {
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        return 1;
+    }
+    if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = (char)(0xF0 | (cp >> 18));
+    out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+/* Helper: Decode JSON string body (escapes resolved); UTF-8 output never exceeds input */
+static int decode_string(const char* src, size_t len, char** out) {
+    char* dst = malloc(len + 1);
+    if (!dst) return E_SYSTEM_MEMORY;
+
+    size_t o = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (src[i] != '\\') {
+            dst[o++] = src[i];
+            continue;
+        }
+        if (++i >= len) goto bad;
+        switch (src[i]) {
+            case '"': dst[o++] = '"'; break;
+            case '\\': dst[o++] = '\\'; break;
+            case '/': dst[o++] = '/'; break;
+            case 'b': dst[o++] = '\b'; break;
+            case 'f': dst[o++] = '\f'; break;
+            case 'n': dst[o++] = '\n'; break;
+            case 'r': dst[o++] = '\r'; break;
+            case 't': dst[o++] = '\t'; break;
+            case 'u': {
+                unsigned cp;
+                if (i + 4 >= len) goto bad;
+                if (parse_hex4(src + i + 1, &cp) != ARGO_SUCCESS) goto bad;
+                i += 4;
+                /* Surrogate pair: high \uD8xx followed by low \uDCxx */
+                if (cp >= 0xD800 && cp <= 0xDBFF && i + 6 < len &&
+                    src[i + 1] == '\\' && src[i + 2] == 'u') {
+                    unsigned low;
+                    if (parse_hex4(src + i + 3, &low) == ARGO_SUCCESS && low >= 0xDC00 && low <= 0xDFFF) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    }
+                }
+                o += put_utf8(dst + o, cp);
+                break;
+            }
+            default:
+                goto bad;
+        }
+    }
+    dst[o] = '\0';
+    *out = dst;
+    return ARGO_SUCCESS;
+
+bad:
+    free(dst);
+    return E_INPUT_FORMAT;
+}
+
+/* Helper: Check primitive is a valid JSON number */
+static bool valid_number(const char* text) {
+    const char* p = text;
+    if (*p == '-') p++;
+    if (*p == '0') {
+        p++;
+    } else if (*p >= '1' && *p <= '9') {
+        while (*p >= '0' && *p <= '9') p++;
+    } else {
+        return false;
+    }
+    if (*p == '.') {
+        p++;
+        if (!(*p >= '0' && *p <= '9')) return false;
+        while (*p >= '0' && *p <= '9') p++;
+    }
+    if (*p == 'e' || *p == 'E') {
+        p++;
+        if (*p == '+' || *p == '-') p++;
+        if (!(*p >= '0' && *p <= '9')) return false;
+        while (*p >= '0' && *p <= '9') p++;
+    }
+    return *p == '\0';
+}
+
+/* Helper: Build node from tokens[*index], advancing *index past its subtree */
+static int build_node(const char* json, const jsmntok_t* tokens, int count,
+                      int* index, int depth, json_node_t** out) {
+    if (*index >= count) return E_INPUT_FORMAT;
+    if (depth > JSON_DOC_MAX_DEPTH) return E_INPUT_TOO_LARGE;
+
+    const jsmntok_t* tok = &tokens[(*index)++];
+    const char* start = json + tok->start;
+    size_t len = (size_t)(tok->end - tok->start);
+    json_node_t* node = NULL;
+    int result = ARGO_SUCCESS;
+
+    switch (tok->type) {
+        case JSMN_STRING:
+            node = node_new(JSON_DOC_STRING);
+            if (!node) return E_SYSTEM_MEMORY;
+            result = decode_string(start, len, &node->text);
+            break;
+
+        case JSMN_PRIMITIVE:
+            if (len == 4 && strncmp(start, "true", 4) == 0) {
+                node = node_new(JSON_DOC_BOOL);
+                if (node) node->boolean = true;
+            } else if (len == 5 && strncmp(start, "false", 5) == 0) {
+                node = node_new(JSON_DOC_BOOL);
+            } else if (len == 4 && strncmp(start, "null", 4) == 0) {
+                node = node_new(JSON_DOC_NULL);
+            } else {
+                node = node_new(JSON_DOC_NUMBER);
+                if (node) {
+                    node->text = copy_span(start, len);
+                    if (!node->text) result = E_SYSTEM_MEMORY;
+                    else if (!valid_number(node->text)) result = E_INPUT_FORMAT;
+                }
+            }
+            if (!node) return E_SYSTEM_MEMORY;
+            break;
+
+        case JSMN_OBJECT:
+        case JSMN_ARRAY: {
+            bool object = (tok->type == JSMN_OBJECT);
+            node = node_new(object ? JSON_DOC_OBJECT : JSON_DOC_ARRAY);
+            if (!node) return E_SYSTEM_MEMORY;
+            for (int i = 0; i < tok->size && result == ARGO_SUCCESS; i++) {
+                char* key = NULL;
+                if (object) {
+                    if (*index >= count || tokens[*index].type != JSMN_STRING) {
+                        result = E_INPUT_FORMAT;
+                        break;
+                    }
+                    const jsmntok_t* ktok = &tokens[(*index)++];
+                    result = decode_string(json + ktok->start, (size_t)(ktok->end - ktok->start), &key);
+                    if (result != ARGO_SUCCESS) break;
+                }
+                json_node_t* child = NULL;
+                result = build_node(json, tokens, count, index, depth + 1, &child);
+                if (result == ARGO_SUCCESS) {
+                    child->key = key;
+                    result = node_append(node, child);
+                    if (result != ARGO_SUCCESS) json_doc_free(child);
+                } else {
+                    free(key);
+                }
+            }
+            break;
+        }
+
+        default:
+            return E_INPUT_FORMAT;
+    }
+
+    if (result != ARGO_SUCCESS) {
+        json_doc_free(node);
+        return result;
+    }
+    *out = node;
+    return ARGO_SUCCESS;
+}
+
+/* Parse JSON text */
+int json_doc_parse(const char* json, size_t len, json_node_t** root) {
+    ARGO_CHECK_NULL(json);
+    ARGO_CHECK_NULL(root);
+
+    jsmntok_t* tokens = NULL;
+    json_node_t* node = NULL;
+    int result = ARGO_SUCCESS;
+
+    jsmn_parser parser;
+    jsmn_init(&parser);
+    int count = jsmn_parse(&parser, json, len, NULL, 0);
+    if (count <= 0) {
+        result = E_INPUT_FORMAT;
+        goto cleanup;
+    }
+
+    tokens = malloc((size_t)count * sizeof(jsmntok_t));
+    if (!tokens) {
+        argo_report_error(E_SYSTEM_MEMORY, "json_doc_parse", ERR_MSG_MEMORY_ALLOC_FAILED);
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
+    jsmn_init(&parser);
+    count = jsmn_parse(&parser, json, len, tokens, (unsigned)count);
+    if (count <= 0) {
+        result = E_INPUT_FORMAT;
+        goto cleanup;
+    }
+
+    int index = 0;
+    result = build_node(json, tokens, count, &index, 0, &node);
+    if (result == ARGO_SUCCESS && index != count) {
+        /* Trailing values after the document */
+        result = E_INPUT_FORMAT;
+    }
+    if (result != ARGO_SUCCESS) {
+        json_doc_free(node);
+        node = NULL;
+        goto cleanup;
+    }
+    *root = node;
+
+cleanup:
+    free(tokens);
+    return result;
+}
+
+/* Helper: Append bytes to buffer */
+static void buf_append(doc_buffer_t* buf, const char* data, size_t len) {
+    if (buf->failed) return;
+    if (buf->len + len + 1 > buf->cap) {
+        size_t cap = buf->cap ? buf->cap : JSON_DOC_BUFFER_INITIAL;
+        while (buf->len + len + 1 > cap) cap *= 2;
+        char* grown = realloc(buf->data, cap);
+        if (!grown) {
+            buf->failed = true;
+            return;
+        }
+        buf->data = grown;
+        buf->cap = cap;
+    }
+    memcpy(buf->data + buf->len, data, len);
+    buf->len += len;
+    buf->data[buf->len] = '\0';
+}
+
+/* Helper: Append quoted, escaped string */
+static void buf_append_string(doc_buffer_t* buf, const char* value) {
+    buf_append(buf, "\"", 1);
+    const char* run = value;
+    for (const char* p = value; *p; p++) {
+        unsigned char c = (unsigned char)*p;
+        const char* escape = NULL;
+        char hex[8];
+        switch (c) {
+            case '"': escape = "\\\""; break;
+            case '\\': escape = "\\\\"; break;
+            case '\b': escape = "\\b"; break;
+            case '\f': escape = "\\f"; break;
+            case '\n': escape = "\\n"; break;
+            case '\r': escape = "\\r"; break;
+            case '\t': escape = "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    snprintf(hex, sizeof(hex), "\\u%04x", c);
+                    escape = hex;
+                }
+                break;
+        }
+        if (escape) {
+            buf_append(buf, run, (size_t)(p - run));
+            buf_append(buf, escape, strlen(escape));
+            run = p + 1;
+        }
+    }
+    buf_append(buf, run, strlen(run));
+    buf_append(buf, "\"", 1);
+}
+
+/* Helper: Serialize node recursively */
+static void serialize_node(doc_buffer_t* buf, const json_node_t* node) {
+    switch (node->type) {
+        case JSON_DOC_NULL:
+            buf_append(buf, "null", 4);
+            break;
+        case JSON_DOC_BOOL:
+            if (node->boolean) buf_append(buf, "true", 4);
+            else buf_append(buf, "false", 5);
+            break;
+        case JSON_DOC_NUMBER:
+            buf_append(buf, node->text, strlen(node->text));
+            break;
+        case JSON_DOC_STRING:
+            buf_append_string(buf, node->text);
+            break;
+        case JSON_DOC_ARRAY:
+        case JSON_DOC_OBJECT: {
+            bool object = (node->type == JSON_DOC_OBJECT);
+            buf_append(buf, object ? "{" : "[", 1);
+            for (int i = 0; i < node->count; i++) {
+                if (i > 0) buf_append(buf, ",", 1);
+                if (object) {
+                    buf_append_string(buf, node->children[i]->key);
+                    buf_append(buf, ":", 1);
+                }
+                serialize_node(buf, node->children[i]);
+            }
+            buf_append(buf, object ? "}" : "]", 1);
+            break;
+        }
+    }
+}
+
+/* Serialize node to compact JSON */
+char* json_doc_serialize(const json_node_t* node) {
+    if (!node) return NULL;
+
+    doc_buffer_t buf = {0};
+    serialize_node(&buf, node);
+    if (buf.failed) {
+        argo_report_error(E_SYSTEM_MEMORY, "json_doc_serialize", ERR_MSG_MEMORY_ALLOC_FAILED);
+        free(buf.data);
+        return NULL;
+    }
+    return buf.data;
+}
+
+/* Create object node */
+json_node_t* json_doc_new_object(void) {
+    return node_new(JSON_DOC_OBJECT);
+}
+
+/* Create array node */
+json_node_t* json_doc_new_array(void) {
+    return node_new(JSON_DOC_ARRAY);
+}
+
+/* Append child to container */
+int json_doc_append(json_node_t* container, const char* key, json_node_t* child) {
+    ARGO_CHECK_NULL(container);
+    ARGO_CHECK_NULL(child);
+    if (container->type != JSON_DOC_ARRAY && container->type != JSON_DOC_OBJECT) {
+        return E_INPUT_INVALID;
+    }
+
+    char* copy = NULL;
+    if (container->type == JSON_DOC_OBJECT) {
+        ARGO_CHECK_NULL(key);
+        copy = strdup(key);
+        if (!copy) return E_SYSTEM_MEMORY;
+    }
+    if (node_append(container, child) != ARGO_SUCCESS) {
+        free(copy);
+        return E_SYSTEM_MEMORY;
+    }
+    free(child->key);
+    child->key = copy;
+    return ARGO_SUCCESS;
+}
+
+/* Create null node */
+json_node_t* json_doc_new_null(void) {
+    return node_new(JSON_DOC_NULL);
+}
+
+/* Create string node */
+json_node_t* json_doc_new_string(const char* value) {
+    json_node_t* node = node_new(JSON_DOC_STRING);
+    if (!node) return NULL;
+    node->text = strdup(value ? value : "");
+    if (!node->text) {
+        free(node);
+        return NULL;
+    }
+    return node;
+}
+
+/* Create integer node */
+json_node_t* json_doc_new_integer(long long value) {
+    json_node_t* node = node_new(JSON_DOC_NUMBER);
+    if (!node) return NULL;
+    char literal[JSON_DOC_NUMBER_MAX];
+    snprintf(literal, sizeof(literal), "%lld", value);
+    node->text = strdup(literal);
+    if (!node->text) {
+        free(node);
+        return NULL;
+    }
+    return node;
+}
+
+/* Create boolean node */
+json_node_t* json_doc_new_bool(bool value) {
+    json_node_t* node = node_new(JSON_DOC_BOOL);
+    if (!node) return NULL;
+    node->boolean = value;
+    return node;
+}
+
+/* Deep copy */
+json_node_t* json_doc_clone(const json_node_t* node) {
+    if (!node) return NULL;
+
+    json_node_t* copy = node_new(node->type);
+    if (!copy) return NULL;
+    copy->boolean = node->boolean;
+    if ((node->key && !(copy->key = strdup(node->key))) ||
+        (node->text && !(copy->text = strdup(node->text)))) {
+        goto fail;
+    }
+    for (int i = 0; i < node->count; i++) {
+        json_node_t* child = json_doc_clone(node->children[i]);
+        if (!child) goto fail;
+        if (node_append(copy, child) != ARGO_SUCCESS) {
+            json_doc_free(child);
+            goto fail;
+        }
+    }
+    return copy;
+
+fail:
+    json_doc_free(copy);
+    return NULL;
+}
+
+/* Structural equality */
+bool json_doc_equal(const json_node_t* a, const json_node_t* b) {
+    if (!a || !b) return a == b;
+    if (a->type != b->type) return false;
+
+    switch (a->type) {
+        case JSON_DOC_NULL:
+            return true;
+        case JSON_DOC_BOOL:
+            return a->boolean == b->boolean;
+        case JSON_DOC_NUMBER:
+            return strcmp(a->text, b->text) == 0 || strtod(a->text, NULL) == strtod(b->text, NULL);
+        case JSON_DOC_STRING:
+            return strcmp(a->text, b->text) == 0;
+        case JSON_DOC_ARRAY:
+            if (a->count != b->count) return false;
+            for (int i = 0; i < a->count; i++) {
+                if (!json_doc_equal(a->children[i], b->children[i])) return false;
+            }
+            return true;
+        case JSON_DOC_OBJECT:
+            if (a->count != b->count) return false;
+            for (int i = 0; i < a->count; i++) {
+                const json_node_t* match = NULL;
+                for (int j = 0; j < b->count && !match; j++) {
+                    if (strcmp(a->children[i]->key, b->children[j]->key) == 0) match = b->children[j];
+                }
+                if (!json_doc_equal(a->children[i], match)) return false;
+            }
+            return true;
+    }
+    return false;
+}
+
+/* Read integer value of a number node */
+bool json_doc_get_integer(const json_node_t* node, long long* value) {
+    if (!node || !value || node->type != JSON_DOC_NUMBER) return false;
+
+    char* end = NULL;
+    errno = 0;
+    long long parsed = strtoll(node->text, &end, 10);
+    if (errno != 0 || *end != '\0') return false;
+    *value = parsed;
+    return true;
+}
+
+/* Free node and all children */
+void json_doc_free(json_node_t* node) {
+    if (!node) return;
+    for (int i = 0; i < node->count; i++) {
+        json_doc_free(node->children[i]);
+    }
+    free(node->children);
+    free(node->key);
+    free(node->text);
+    free(node);
+}
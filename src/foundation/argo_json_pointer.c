@@ -0,0 +1,215 @@
+/* © 2025 Casey Koons All rights reserved */
+/* JSON Document - RFC 6901 pointer get, set, and remove */
+
+/* System includes */
+#include <stdlib.h>
+#include <string.h>
+
+/* Project includes */
+#include "argo_json_doc.h"
+#include "argo_error.h"
+
+/* Helper: Read next reference token at *cursor ('/'-prefixed), unescaping ~0 and ~1 */
+static int next_segment(const char** cursor, char** segment) {
+    const char* start = *cursor + 1;
+    size_t len = strcspn(start, "/");
+
+    char* out = malloc(len + 1);
+    if (!out) return E_SYSTEM_MEMORY;
+
+    size_t o = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (start[i] != '~') {
+            out[o++] = start[i];
+        } else if (i + 1 < len && start[i + 1] == '0') {
+            out[o++] = '~';
+            i++;
+        } else if (i + 1 < len && start[i + 1] == '1') {
+            out[o++] = '/';
+            i++;
+        } else {
+            free(out);
+            return E_INPUT_FORMAT;
+        }
+    }
+    out[o] = '\0';
+
+    *cursor = start + len;
+    *segment = out;
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Index of member named key, or -1 */
+static int member_index(const json_node_t* object, const char* key) {
+    for (int i = 0; i < object->count; i++) {
+        if (strcmp(object->children[i]->key, key) == 0) return i;
+    }
+    return -1;
+}
+
+/* Helper: Parse array index ("-" means count); false if not an index */
+static bool array_index(const char* segment, int count, int* index) {
+    if (strcmp(segment, JSON_DOC_POINTER_APPEND) == 0) {
+        *index = count;
+        return true;
+    }
+    if (!*segment || (segment[0] == '0' && segment[1])) return false;
+
+    long value = 0;
+    for (const char* p = segment; *p; p++) {
+        if (*p < '0' || *p > '9') return false;
+        value = value * 10 + (*p - '0');
+        if (value > count) return false;
+    }
+    *index = (int)value;
+    return true;
+}
+
+/* Helper: Child of container named by segment, or NULL */
+static json_node_t* child_for(json_node_t* node, const char* segment, int* index) {
+    if (node->type == JSON_DOC_OBJECT) {
+        *index = member_index(node, segment);
+        return *index >= 0 ? node->children[*index] : NULL;
+    }
+    if (node->type == JSON_DOC_ARRAY && array_index(segment, node->count, index) && *index < node->count) {
+        return node->children[*index];
+    }
+    return NULL;
+}
+
+/* Resolve pointer */
+json_node_t* json_doc_get(json_node_t* root, const char* pointer) {
+    if (!root || !pointer) return NULL;
+    if (*pointer && *pointer != '/') return NULL;
+
+    json_node_t* node = root;
+    const char* cursor = pointer;
+    while (node && *cursor) {
+        char* segment = NULL;
+        if (next_segment(&cursor, &segment) != ARGO_SUCCESS) return NULL;
+        int index;
+        node = child_for(node, segment, &index);
+        free(segment);
+    }
+    return node;
+}
+
+/* Helper: Move value's contents into target, keeping target's key */
+static void replace_contents(json_node_t* target, json_node_t* value) {
+    char* key = target->key;
+    for (int i = 0; i < target->count; i++) {
+        json_doc_free(target->children[i]);
+    }
+    free(target->children);
+    free(target->text);
+    free(value->key);
+
+    *target = *value;
+    target->key = key;
+    free(value);
+}
+
+/* Helper: Walk to the parent of the last segment, creating objects on the way */
+static int walk_to_parent(json_node_t* root, const char* pointer, bool create,
+                          json_node_t** parent, char** last) {
+    json_node_t* node = root;
+    const char* cursor = pointer;
+    char* segment = NULL;
+
+    int result = next_segment(&cursor, &segment);
+    while (result == ARGO_SUCCESS && *cursor) {
+        if (create && node->type == JSON_DOC_NULL) {
+            node->type = JSON_DOC_OBJECT;
+        }
+        int index;
+        json_node_t* child = child_for(node, segment, &index);
+        if (!child && create && node->type == JSON_DOC_OBJECT) {
+            child = json_doc_new_object();
+            if (!child) {
+                result = E_SYSTEM_MEMORY;
+                break;
+            }
+            result = json_doc_append(node, segment, child);
+            if (result != ARGO_SUCCESS) {
+                json_doc_free(child);
+                break;
+            }
+        }
+        if (!child) {
+            result = E_NOT_FOUND;
+            break;
+        }
+        node = child;
+        free(segment);
+        segment = NULL;
+        result = next_segment(&cursor, &segment);
+    }
+
+    if (result != ARGO_SUCCESS) {
+        free(segment);
+        return result;
+    }
+    *parent = node;
+    *last = segment;
+    return ARGO_SUCCESS;
+}
+
+/* Set value at pointer */
+int json_doc_set(json_node_t* root, const char* pointer, json_node_t* value) {
+    ARGO_CHECK_NULL(root);
+    ARGO_CHECK_NULL(pointer);
+    ARGO_CHECK_NULL(value);
+
+    if (!*pointer) {
+        replace_contents(root, value);
+        return ARGO_SUCCESS;
+    }
+    if (*pointer != '/') return E_INPUT_FORMAT;
+
+    json_node_t* parent = NULL;
+    char* last = NULL;
+    int result = walk_to_parent(root, pointer, true, &parent, &last);
+    if (result != ARGO_SUCCESS) return result;
+
+    if (parent->type == JSON_DOC_NULL) {
+        parent->type = JSON_DOC_OBJECT;
+    }
+
+    int index;
+    json_node_t* existing = child_for(parent, last, &index);
+    if (existing) {
+        replace_contents(existing, value);
+    } else if (parent->type == JSON_DOC_OBJECT) {
+        result = json_doc_append(parent, last, value);
+    } else if (parent->type == JSON_DOC_ARRAY && array_index(last, parent->count, &index)) {
+        result = json_doc_append(parent, NULL, value);
+    } else {
+        result = E_NOT_FOUND;
+    }
+
+    free(last);
+    return result;
+}
+
+/* Remove value at pointer */
+int json_doc_remove(json_node_t* root, const char* pointer) {
+    ARGO_CHECK_NULL(root);
+    ARGO_CHECK_NULL(pointer);
+    if (*pointer != '/') return E_INPUT_FORMAT;
+
+    json_node_t* parent = NULL;
+    char* last = NULL;
+    int result = walk_to_parent(root, pointer, false, &parent, &last);
+    if (result != ARGO_SUCCESS) return result;
+
+    int index;
+    json_node_t* child = child_for(parent, last, &index);
+    free(last);
+    if (!child) return E_NOT_FOUND;
+
+    json_doc_free(child);
+    memmove(&parent->children[index], &parent->children[index + 1],
+            (size_t)(parent->count - index - 1) * sizeof(json_node_t*));
+    parent->count--;
+    return ARGO_SUCCESS;
+}
@@ -9,6 +9,7 @@
 #include <time.h>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <fcntl.h>
 
 /* Project includes */
 #include "argo_log.h"
@@ -74,6 +75,9 @@ int log_init(const char* log_dir) {
     /* Set unbuffered for immediate writes */
     setbuf(g_log_config->log_fp, NULL);
 
+    /* Don't leak the log descriptor into exec'd children */
+    fcntl(fileno(g_log_config->log_fp), F_SETFD, FD_CLOEXEC);
+
     /* Default configuration */
     g_log_config->enabled = true;
     g_log_config->level = LOG_INFO;
@@ -104,6 +108,13 @@ void log_cleanup(void) {
 }
 /* GUIDELINE_APPROVED_END */
 
+/* Enable or disable logging */
+void log_enable(bool enable) {
+    if (g_log_config) {
+        g_log_config->enabled = enable;
+    }
+}
+
 /* Set log level */
 void log_set_level(log_level_t level) {
     if (g_log_config) {
@@ -0,0 +1,253 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Stream Decoder - incremental SSE / NDJSON token delta extraction */
+
+/* System includes */
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/* Project includes */
+#include "argo_stream_decoder.h"
+#include "argo_json_doc.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_log.h"
+
+/* Growable byte buffer */
+typedef struct {
+    char* data;
+    size_t size;
+    size_t capacity;
+} stream_buffer_t;
+
+struct stream_decoder {
+    stream_format_t format;
+    char* delta_pointer;
+    stream_delta_fn on_delta;
+    void* userdata;
+    stream_event_fn on_event;
+    void* event_userdata;
+    stream_buffer_t line;       /* Current partial line */
+    stream_buffer_t event;      /* SSE data lines of current event */
+    bool done;
+    int error;
+};
+
+/* Helper: Append bytes, keeping the buffer NUL-terminated */
+static int buffer_append(stream_buffer_t* buf, const char* data, size_t len) {
+    if (buf->size + len >= STREAM_DECODER_MAX_EVENT) {
+        return E_INPUT_TOO_LARGE;
+    }
+
+    if (buf->size + len + 1 > buf->capacity) {
+        size_t capacity = buf->capacity ? buf->capacity : STREAM_DECODER_INITIAL_CAPACITY;
+        while (buf->size + len + 1 > capacity) capacity *= 2;
+        char* grown = realloc(buf->data, capacity);
+        if (!grown) return E_SYSTEM_MEMORY;
+        buf->data = grown;
+        buf->capacity = capacity;
+    }
+
+    memcpy(buf->data + buf->size, data, len);
+    buf->size += len;
+    buf->data[buf->size] = '\0';
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Report an error event carried in the stream */
+static int stream_error(json_node_t* root, json_node_t* error) {
+    json_node_t* message = json_doc_get(root, STREAM_ERROR_MESSAGE_POINTER);
+    const char* text = "unknown error";
+    if (message && message->type == JSON_DOC_STRING) {
+        text = message->text;
+    } else if (error->type == JSON_DOC_STRING) {
+        text = error->text;
+    }
+
+    argo_report_error(E_PROTOCOL_HTTP, "stream_decoder", "stream error: %s", text);
+    return E_PROTOCOL_HTTP;
+}
+
+/* Helper: Parse one complete event and deliver its delta */
+static int dispatch_event(stream_decoder_t* decoder, const char* text, size_t len) {
+    if (decoder->format == STREAM_FORMAT_SSE &&
+        len == strlen(STREAM_SSE_DONE) && memcmp(text, STREAM_SSE_DONE, len) == 0) {
+        decoder->done = true;
+        return ARGO_SUCCESS;
+    }
+
+    json_node_t* root = NULL;
+    if (json_doc_parse(text, len, &root) != ARGO_SUCCESS) {
+        argo_report_error(E_PROTOCOL_FORMAT, "stream_decoder", "event is not valid JSON");
+        return E_PROTOCOL_FORMAT;
+    }
+
+    int result = ARGO_SUCCESS;
+    json_node_t* error = json_doc_get(root, STREAM_ERROR_POINTER);
+    if (error && error->type != JSON_DOC_NULL) {
+        result = stream_error(root, error);
+        goto cleanup;
+    }
+
+    if (decoder->on_event) {
+        decoder->on_event(root, decoder->event_userdata);
+    }
+
+    json_node_t* delta = json_doc_get(root, decoder->delta_pointer);
+    if (delta && delta->type == JSON_DOC_STRING && delta->text[0]) {
+        decoder->on_delta(delta->text, strlen(delta->text), decoder->userdata);
+    }
+
+    json_node_t* done = json_doc_get(root, STREAM_DONE_POINTER);
+    if (done && done->type == JSON_DOC_BOOL && done->boolean) {
+        decoder->done = true;
+    }
+
+cleanup:
+    json_doc_free(root);
+    return result;
+}
+
+/* Helper: Dispatch accumulated SSE data lines */
+static int flush_sse_event(stream_decoder_t* decoder) {
+    if (decoder->event.size == 0) return ARGO_SUCCESS;
+
+    int result = dispatch_event(decoder, decoder->event.data, decoder->event.size);
+    decoder->event.size = 0;
+    return result;
+}
+
+/* Helper: Handle one complete line (terminator already stripped) */
+static int process_line(stream_decoder_t* decoder, const char* line, size_t len) {
+    if (len > 0 && line[len - 1] == '\r') len--;
+
+    if (decoder->format == STREAM_FORMAT_NDJSON) {
+        size_t skip = 0;
+        while (skip < len && (line[skip] == ' ' || line[skip] == '\t')) skip++;
+        if (skip == len) return ARGO_SUCCESS;
+        return dispatch_event(decoder, line, len);
+    }
+
+    /* SSE: blank line ends the event */
+    if (len == 0) return flush_sse_event(decoder);
+    if (line[0] == STREAM_SSE_COMMENT) return ARGO_SUCCESS;
+
+    size_t field_len = strlen(STREAM_SSE_DATA_FIELD);
+    if (len < field_len || memcmp(line, STREAM_SSE_DATA_FIELD, field_len) != 0) {
+        return ARGO_SUCCESS;
+    }
+
+    const char* value = line + field_len;
+    size_t value_len = len - field_len;
+    if (value_len > 0 && *value == ' ') {
+        value++;
+        value_len--;
+    }
+
+    int result = ARGO_SUCCESS;
+    if (decoder->event.size > 0) {
+        result = buffer_append(&decoder->event, "\n", 1);
+    }
+    if (result == ARGO_SUCCESS) {
+        result = buffer_append(&decoder->event, value, value_len);
+    }
+    return result;
+}
+
+/* Create decoder */
+stream_decoder_t* stream_decoder_create(stream_format_t format, const char* delta_pointer,
+                                        stream_delta_fn on_delta, void* userdata) {
+    if (!delta_pointer || !on_delta) {
+        argo_report_error(E_INPUT_NULL, "stream_decoder_create", "delta pointer and callback required");
+        return NULL;
+    }
+
+    stream_decoder_t* decoder = calloc(1, sizeof(stream_decoder_t));
+    if (!decoder) {
+        argo_report_error(E_SYSTEM_MEMORY, "stream_decoder_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return NULL;
+    }
+
+    decoder->delta_pointer = strdup(delta_pointer);
+    if (!decoder->delta_pointer) {
+        argo_report_error(E_SYSTEM_MEMORY, "stream_decoder_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+        free(decoder);
+        return NULL;
+    }
+
+    decoder->format = format;
+    decoder->on_delta = on_delta;
+    decoder->userdata = userdata;
+    return decoder;
+}
+
+/* Pass each parsed event to on_event */
+void stream_decoder_set_event_fn(stream_decoder_t* decoder, stream_event_fn on_event,
+                                 void* userdata) {
+    if (!decoder) return;
+    decoder->on_event = on_event;
+    decoder->event_userdata = userdata;
+}
+
+/* Feed received bytes */
+int stream_decoder_feed(stream_decoder_t* decoder, const char* data, size_t len) {
+    ARGO_CHECK_NULL(decoder);
+    if (decoder->error != ARGO_SUCCESS || decoder->done) return decoder->error;
+    if (len > 0 && !data) return E_INPUT_NULL;
+
+    while (len > 0 && !decoder->done && decoder->error == ARGO_SUCCESS) {
+        const char* newline = memchr(data, '\n', len);
+        size_t segment = newline ? (size_t)(newline - data) : len;
+
+        if (!newline) {
+            decoder->error = buffer_append(&decoder->line, data, segment);
+            break;
+        }
+
+        /* Whole line in this chunk: process in place without copying */
+        if (decoder->line.size == 0) {
+            decoder->error = process_line(decoder, data, segment);
+        } else {
+            decoder->error = buffer_append(&decoder->line, data, segment);
+            if (decoder->error == ARGO_SUCCESS) {
+                decoder->error = process_line(decoder, decoder->line.data, decoder->line.size);
+            }
+            decoder->line.size = 0;
+        }
+
+        data += segment + 1;
+        len -= segment + 1;
+    }
+
+    return decoder->error;
+}
+
+/* Flush a final unterminated event */
+int stream_decoder_finish(stream_decoder_t* decoder) {
+    ARGO_CHECK_NULL(decoder);
+    if (decoder->error != ARGO_SUCCESS || decoder->done) return decoder->error;
+
+    if (decoder->line.size > 0) {
+        decoder->error = process_line(decoder, decoder->line.data, decoder->line.size);
+        decoder->line.size = 0;
+    }
+    if (decoder->error == ARGO_SUCCESS && decoder->format == STREAM_FORMAT_SSE) {
+        decoder->error = flush_sse_event(decoder);
+    }
+    return decoder->error;
+}
+
+/* Check for end-of-stream marker */
+bool stream_decoder_done(const stream_decoder_t* decoder) {
+    return decoder && decoder->done;
+}
+
+/* Destroy decoder */
+void stream_decoder_destroy(stream_decoder_t* decoder) {
+    if (!decoder) return;
+
+    free(decoder->delta_pointer);
+    free(decoder->line.data);
+    free(decoder->event.data);
+    free(decoder);
+}
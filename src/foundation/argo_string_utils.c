@@ -157,3 +157,26 @@ size_t safe_strncpy(char* dst, const char* src, size_t size) {
 
     return i;
 }
+
+/* Helper: Value of one hex digit (caller checked isxdigit) */
+static int hex_value(char c) {
+    return isdigit((unsigned char)c) ? c - '0' : tolower((unsigned char)c) - 'a' + 10;
+}
+
+/* Decode %XX escapes in place */
+char* percent_decode(char* text) {
+    if (!text) return NULL;
+
+    char* out = text;
+    for (const char* p = text; *p; p++) {
+        if (p[0] == '%' && isxdigit((unsigned char)p[1]) && isxdigit((unsigned char)p[2])) {
+            *out++ = (char)(hex_value(p[1]) * 16 + hex_value(p[2]));
+            p += 2;
+        } else {
+            *out++ = *p;
+        }
+    }
+    *out = '\0';
+
+    return text;
+}
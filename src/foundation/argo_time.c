@@ -0,0 +1,20 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Time - monotonic clock helpers */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* clock_gettime() */
+#endif
+
+/* System includes */
+#include <time.h>
+
+/* Project includes */
+#include "argo_time.h"
+#include "argo_limits.h"
+
+/* Milliseconds on a monotonic clock */
+long long argo_monotonic_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * MILLISECONDS_PER_SECOND + ts.tv_nsec / NANOSECONDS_PER_MILLISECOND;
+}
@@ -2,6 +2,7 @@
 
 /* System includes */
 #include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -13,21 +14,30 @@
 #include "argo_log.h"
 #include "argo_memory.h"
 #include "argo_limits.h"
+#include "argo_rate_limit.h"
+
+/* Build authenticated JSON POST request */
+http_request_t* api_build_json_post(const char* base_url, const char* json_body,
+                                    const api_auth_config_t* auth,
+                                    const char** extra_headers) {
+    size_t body_len = strlen(json_body);
+    char* body = malloc(body_len + 1);
+    if (!body) {
+        return NULL;
+    }
+    memcpy(body, json_body, body_len + 1);
+    return api_build_json_post_owned(base_url, body, body_len, auth, extra_headers);
+}
 
-/* Execute HTTP POST with JSON and authentication */
-int api_http_post_json(const char* base_url, const char* json_body,
-                       const api_auth_config_t* auth,
-                       const char** extra_headers,
-                       http_response_t** response) {
-    ARGO_CHECK_NULL(base_url);
-    ARGO_CHECK_NULL(json_body);
-    ARGO_CHECK_NULL(response);
-
+/* Build authenticated JSON POST request, adopting the body */
+http_request_t* api_build_json_post_owned(const char* base_url, char* json_body, size_t body_len,
+                                          const api_auth_config_t* auth,
+                                          const char** extra_headers) {
     /* Build URL with authentication if needed */
     char url[API_URL_SIZE];
     if (auth && auth->type == API_AUTH_URL_PARAM) {
-        snprintf(url, sizeof(url), "%s?%s=%s",
-                base_url, auth->param_name, auth->value);
+        snprintf(url, sizeof(url), "%s%c%s=%s",
+                base_url, strchr(base_url, '?') ? '&' : '?', auth->param_name, auth->value);
     } else {
         strncpy(url, base_url, sizeof(url) - 1);
         url[sizeof(url) - 1] = '\0';
@@ -36,7 +46,8 @@ int api_http_post_json(const char* base_url, const char* json_body,
     /* Create request */
     http_request_t* req = http_request_new(HTTP_POST, url);
     if (!req) {
-        return E_SYSTEM_MEMORY;
+        free(json_body);
+        return NULL;
     }
 
     /* Add standard headers */
@@ -62,11 +73,70 @@ int api_http_post_json(const char* base_url, const char* json_body,
         }
     }
 
-    /* Set body */
-    http_request_set_body(req, json_body, strlen(json_body));
+    /* Set body (no copy) */
+    http_request_take_body(req, json_body, body_len);
+    return req;
+}
+
+/* Map non-OK HTTP status to a specific error code */
+int api_check_http_status(int status, const char* function) {
+    if (status == API_HTTP_OK) {
+        return ARGO_SUCCESS;
+    }
+
+    int error_code = E_PROTOCOL_HTTP;  /* Default */
+    const char* status_desc = HTTP_STATUS_DESC_UNKNOWN;
+
+    /* Map HTTP status codes to specific errors */
+    switch (status) {
+        case HTTP_STATUS_BAD_REQUEST:
+            error_code = E_HTTP_BAD_REQUEST;
+            status_desc = HTTP_STATUS_DESC_BAD_REQUEST;
+            break;
+        case HTTP_STATUS_UNAUTHORIZED:
+            error_code = E_HTTP_UNAUTHORIZED;
+            status_desc = HTTP_STATUS_DESC_UNAUTHORIZED;
+            break;
+        case HTTP_STATUS_FORBIDDEN:
+            error_code = E_HTTP_FORBIDDEN;
+            status_desc = HTTP_STATUS_DESC_FORBIDDEN;
+            break;
+        case HTTP_STATUS_NOT_FOUND:
+            error_code = E_HTTP_NOT_FOUND;
+            status_desc = HTTP_STATUS_DESC_NOT_FOUND;
+            break;
+        case HTTP_STATUS_RATE_LIMIT:
+            error_code = E_HTTP_RATE_LIMIT;
+            status_desc = HTTP_STATUS_DESC_RATE_LIMIT;
+            break;
+        default:
+            if (status >= HTTP_STATUS_SERVER_ERROR) {
+                error_code = E_HTTP_SERVER_ERROR;
+                status_desc = HTTP_STATUS_DESC_SERVER_ERROR;
+            }
+            break;
+    }
+
+    argo_report_error(error_code, function, "HTTP %d (%s)", status, status_desc);
+    return error_code;
+}
 
-    /* Execute request */
-    int result = http_execute(req, response);
+/* Execute HTTP POST with JSON and authentication */
+int api_http_post_json(const char* base_url, const char* json_body,
+                       const api_auth_config_t* auth,
+                       const char** extra_headers,
+                       http_response_t** response) {
+    ARGO_CHECK_NULL(base_url);
+    ARGO_CHECK_NULL(json_body);
+    ARGO_CHECK_NULL(response);
+
+    http_request_t* req = api_build_json_post(base_url, json_body, auth, extra_headers);
+    if (!req) {
+        return E_SYSTEM_MEMORY;
+    }
+
+    /* Execute request, waiting for the key's rate limit and retrying 429s */
+    int result = rate_limit_execute(req, rate_limit_default_deadline(), NULL, NULL, response);
     http_request_free(req);
 
     if (result != ARGO_SUCCESS) {
@@ -75,46 +145,69 @@ int api_http_post_json(const char* base_url, const char* json_body,
     }
 
     /* Check HTTP status and map to specific error codes */
-    int status = (*response)->status_code;
-    if (status != API_HTTP_OK) {
-        int error_code = E_PROTOCOL_HTTP;  /* Default */
-        const char* status_desc = HTTP_STATUS_DESC_UNKNOWN;
-
-        /* Map HTTP status codes to specific errors */
-        switch (status) {
-            case HTTP_STATUS_BAD_REQUEST:
-                error_code = E_HTTP_BAD_REQUEST;
-                status_desc = HTTP_STATUS_DESC_BAD_REQUEST;
-                break;
-            case HTTP_STATUS_UNAUTHORIZED:
-                error_code = E_HTTP_UNAUTHORIZED;
-                status_desc = HTTP_STATUS_DESC_UNAUTHORIZED;
-                break;
-            case HTTP_STATUS_FORBIDDEN:
-                error_code = E_HTTP_FORBIDDEN;
-                status_desc = HTTP_STATUS_DESC_FORBIDDEN;
-                break;
-            case HTTP_STATUS_NOT_FOUND:
-                error_code = E_HTTP_NOT_FOUND;
-                status_desc = HTTP_STATUS_DESC_NOT_FOUND;
-                break;
-            case HTTP_STATUS_RATE_LIMIT:
-                error_code = E_HTTP_RATE_LIMIT;
-                status_desc = HTTP_STATUS_DESC_RATE_LIMIT;
-                break;
-            default:
-                if (status >= HTTP_STATUS_SERVER_ERROR) {
-                    error_code = E_HTTP_SERVER_ERROR;
-                    status_desc = HTTP_STATUS_DESC_SERVER_ERROR;
-                }
-                break;
-        }
+    return api_check_http_status((*response)->status_code, "api_http_post_json");
+}
+
+/* Execute streaming HTTP POST with JSON and authentication */
+int api_http_post_json_stream(const char* base_url, const char* json_body,
+                              const api_auth_config_t* auth,
+                              const char** extra_headers,
+                              void (*on_chunk)(const char* chunk, size_t len, void* userdata),
+                              void* userdata) {
+    ARGO_CHECK_NULL(base_url);
+    ARGO_CHECK_NULL(json_body);
+    ARGO_CHECK_NULL(on_chunk);
 
-        argo_report_error(error_code, "api_http_post_json", "HTTP %d (%s)", status, status_desc);
-        return error_code;
+    http_request_t* req = api_build_json_post(base_url, json_body, auth, extra_headers);
+    if (!req) {
+        return E_SYSTEM_MEMORY;
     }
 
-    return ARGO_SUCCESS;
+    int result = api_http_execute_stream(req, on_chunk, userdata, NULL);
+    http_request_free(req);
+    return result;
+}
+
+/* Execute a built request as a stream */
+int api_http_execute_stream(http_request_t* req,
+                            void (*on_chunk)(const char* chunk, size_t len, void* userdata),
+                            void* userdata, http_response_t** resp) {
+    ARGO_CHECK_NULL(req);
+    ARGO_CHECK_NULL(on_chunk);
+
+    http_request_add_header(req, HTTP_HEADER_ACCEPT, HTTP_CONTENT_TYPE_EVENT_STREAM);
+
+    http_response_t* answer = NULL;
+    int result = rate_limit_execute(req, rate_limit_default_deadline(), on_chunk, userdata, &answer);
+    if (result != ARGO_SUCCESS) {
+        argo_report_error(result, "api_http_post_json_stream", "HTTP POST failed");
+        return result;
+    }
+
+    result = api_check_http_status(answer->status_code, "api_http_post_json_stream");
+    if (resp) {
+        *resp = answer;
+    } else {
+        http_response_free(answer);
+    }
+    return result;
+}
+
+/* Write chat messages array */
+int api_json_chat_messages(json_builder_t* json, const api_chat_message_t* messages, int count) {
+    ARGO_CHECK_NULL(json);
+    ARGO_CHECK_NULL(messages);
+
+    json_builder_key(json, "messages");
+    json_builder_array_begin(json);
+    for (int i = 0; i < count; i++) {
+        json_builder_object_begin(json);
+        json_builder_key_string(json, "role", messages[i].role);
+        json_builder_key_string(json, "content", messages[i].content);
+        json_builder_object_end(json);
+    }
+    json_builder_array_end(json);
+    return json_builder_error(json);
 }
 
 /* Allocate response buffer */
@@ -132,139 +225,251 @@ int api_allocate_response_buffer(char** buffer, size_t* capacity, size_t size) {
     return ARGO_SUCCESS;
 }
 
-/* Augment prompt with memory context */
-int api_augment_prompt_with_memory(ci_memory_digest_t* memory_digest,
-                                   const char* prompt,
-                                   char** out_augmented) {
-    int result = ARGO_SUCCESS;
-    char* augmented = NULL;
+/* Prompt sections */
+#define PROMPT_SUNSET_HEADER "## Previous Session Summary\n"
+#define PROMPT_SUNRISE_HEADER "## Session Context\n"
+#define PROMPT_BREADCRUMB_HEADER "## Progress Breadcrumbs\n"
+#define PROMPT_CONTEXT_HEADER "## Relevant Context\n"
+#define PROMPT_TASK_HEADER "## Current Task\n"
+#define PROMPT_SECTION_END "\n"
+#define PROMPT_NOTES_END "\n\n"
+#define PROMPT_ENTRY_START "- "
+#define PROMPT_TYPE_START "- ["
+#define PROMPT_TYPE_END "] "
+#define PROMPT_ENTRY_END "\n"
+
+/* What assembly keeps */
+typedef struct {
+    memory_item_t** items;
+    int item_count;
+    bool item_kept[MEMORY_MAX_ITEMS];
+    bool crumb_kept[MEMORY_BREADCRUMB_MAX];
+    bool sunset;
+    bool sunrise;
+    size_t bytes;               /* Assembled length without the NUL */
+} prompt_plan_t;
+
+/* Helper: Token estimate of a literal */
+static size_t literal_tokens(const char* text) {
+    return memory_estimate_tokens(text, strlen(text));
+}
 
-    ARGO_CHECK_NULL(prompt);
-    ARGO_CHECK_NULL(out_augmented);
+/* Helper: Charge cost to room if it fits */
+static bool take(size_t* room, size_t cost) {
+    if (cost > *room) return false;
+    *room -= cost;
+    return true;
+}
 
-    /* If no memory digest, just return a copy of the prompt */
-    if (!memory_digest) {
-        augmented = strdup(prompt);
-        if (!augmented) {
-            result = E_SYSTEM_MEMORY;
-            goto cleanup;
+/* Helper: Keep the entries that fit, first to last (last to first when
+ * reverse); the section header is charged with the first one kept.
+ * Returns the kept count */
+static int pack_entries(size_t* room, size_t header_cost, const size_t* costs, int count,
+                        bool reverse, bool* kept) {
+    int packed = 0;
+    size_t charge = header_cost;
+    for (int n = 0; n < count; n++) {
+        int i = reverse ? count - 1 - n : n;
+        kept[i] = take(room, charge + costs[i]);
+        if (kept[i]) {
+            packed++;
+            charge = 0;
         }
-        *out_augmented = augmented;
-        return ARGO_SUCCESS;
     }
+    return packed;
+}
 
-    /* Calculate size needed for augmented prompt */
-    size_t memory_context_size = 0;
-    size_t prompt_size = strlen(prompt);
-
-    /* Add space for sunset notes if present */
-    if (memory_digest->sunset_notes) {
-        memory_context_size += strlen(memory_digest->sunset_notes) + MEMORY_NOTES_PADDING;
+/* Helper: Pick the sections that fit the budget and size the result */
+static void plan_prompt(ci_memory_digest_t* digest, const char* prompt, size_t budget,
+                        prompt_plan_t* plan, api_prompt_report_t* report) {
+    size_t prompt_length = strlen(prompt);
+    report->budget_tokens = budget;
+    report->task_tokens = literal_tokens(PROMPT_TASK_HEADER) + memory_estimate_tokens(prompt, prompt_length);
+    plan->bytes = strlen(PROMPT_TASK_HEADER) + prompt_length;
+
+    /* Memory gets what the task leaves, up to its share of the budget */
+    size_t room = SIZE_MAX;
+    if (budget > 0) {
+        report->over_budget = report->task_tokens > budget;
+        room = report->over_budget ? 0 : budget - report->task_tokens;
+        size_t share = budget * MEMORY_MAX_PERCENTAGE / 100;
+        if (room > share) room = share;
     }
-
-    /* Add space for sunrise brief if present */
-    if (memory_digest->sunrise_brief) {
-        memory_context_size += strlen(memory_digest->sunrise_brief) + MEMORY_NOTES_PADDING;
+    size_t start_room = room;
+    size_t notes_end = literal_tokens(PROMPT_NOTES_END);
+    size_t section_end = literal_tokens(PROMPT_SECTION_END);
+    size_t costs[MEMORY_MAX_ITEMS];
+
+    if (digest->sunrise_brief) {
+        plan->sunrise = take(&room, literal_tokens(PROMPT_SUNRISE_HEADER) + digest->sunrise_tokens + notes_end);
+        report->sunrise_dropped = !plan->sunrise;
+        if (plan->sunrise) {
+            plan->bytes += strlen(PROMPT_SUNRISE_HEADER) + strlen(digest->sunrise_brief) + strlen(PROMPT_NOTES_END);
+        }
     }
 
-    /* Add space for breadcrumbs (estimate) */
-    if (memory_digest->breadcrumb_count > 0) {
-        memory_context_size += memory_digest->breadcrumb_count * MEMORY_BREADCRUMB_SIZE;
+    for (int i = 0; i < plan->item_count; i++) {
+        memory_item_t* item = plan->items[i];
+        costs[i] = literal_tokens(PROMPT_TYPE_START) + literal_tokens(memory_type_name(item->type)) +
+                   literal_tokens(PROMPT_TYPE_END) + item->tokens + literal_tokens(PROMPT_ENTRY_END);
     }
-
-    /* Add space for selected memories (estimate) */
-    if (memory_digest->selected_count > 0) {
-        memory_context_size += memory_digest->selected_count * MEMORY_SELECTED_SIZE;
+    report->items_packed = pack_entries(&room, literal_tokens(PROMPT_CONTEXT_HEADER) + section_end,
+                                        costs, plan->item_count, false, plan->item_kept);
+    report->items_dropped = plan->item_count - report->items_packed;
+    if (report->items_packed > 0) plan->bytes += strlen(PROMPT_CONTEXT_HEADER) + strlen(PROMPT_SECTION_END);
+    for (int i = 0; i < plan->item_count; i++) {
+        if (!plan->item_kept[i]) continue;
+        plan->bytes += strlen(PROMPT_TYPE_START) + strlen(memory_type_name(plan->items[i]->type)) +
+                       strlen(PROMPT_TYPE_END) + plan->items[i]->content_size + strlen(PROMPT_ENTRY_END);
     }
 
-    /* Allocate buffer with overhead */
-    size_t total_size = prompt_size + memory_context_size + MEMORY_BUFFER_OVERHEAD;
-    augmented = malloc(total_size);
-    if (!augmented) {
-        argo_report_error(E_SYSTEM_MEMORY, "api_augment_prompt_with_memory",
-                         ERR_MSG_MEMORY_ALLOC_FAILED);
-        result = E_SYSTEM_MEMORY;
-        goto cleanup;
+    for (int i = 0; i < digest->breadcrumb_count; i++) {
+        costs[i] = literal_tokens(PROMPT_ENTRY_START) + digest->breadcrumb_tokens[i] +
+                   literal_tokens(PROMPT_ENTRY_END);
+    }
+    report->breadcrumbs_packed = pack_entries(&room, literal_tokens(PROMPT_BREADCRUMB_HEADER) + section_end,
+                                              costs, digest->breadcrumb_count, true, plan->crumb_kept);
+    report->breadcrumbs_dropped = digest->breadcrumb_count - report->breadcrumbs_packed;
+    if (report->breadcrumbs_packed > 0) plan->bytes += strlen(PROMPT_BREADCRUMB_HEADER) + strlen(PROMPT_SECTION_END);
+    for (int i = 0; i < digest->breadcrumb_count; i++) {
+        if (!plan->crumb_kept[i]) continue;
+        plan->bytes += strlen(PROMPT_ENTRY_START) + strlen(digest->breadcrumbs[i]) + strlen(PROMPT_ENTRY_END);
     }
 
-    /* Build augmented prompt */
-    char* pos = augmented;
-    size_t remaining = total_size;
-    int written = 0;
-
-    /* Add sunset/sunrise context if available */
-    if (memory_digest->sunset_notes) {
-        written = snprintf(pos, remaining,
-                          "## Previous Session Summary\n%s\n\n",
-                          memory_digest->sunset_notes);
-        pos += written;
-        remaining -= written;
+    if (digest->sunset_notes) {
+        plan->sunset = take(&room, literal_tokens(PROMPT_SUNSET_HEADER) + digest->sunset_tokens + notes_end);
+        report->sunset_dropped = !plan->sunset;
+        if (plan->sunset) {
+            plan->bytes += strlen(PROMPT_SUNSET_HEADER) + strlen(digest->sunset_notes) + strlen(PROMPT_NOTES_END);
+        }
     }
 
-    if (memory_digest->sunrise_brief) {
-        written = snprintf(pos, remaining,
-                          "## Session Context\n%s\n\n",
-                          memory_digest->sunrise_brief);
-        pos += written;
-        remaining -= written;
+    report->used_tokens = report->task_tokens + (start_room - room);
+}
+
+/* Helper: Copy text to out + pos, return the new position */
+static size_t emit_text(char* out, size_t pos, const char* text) {
+    size_t len = strlen(text);
+    memcpy(out + pos, text, len);
+    return pos + len;
+}
+
+/* Helper: Write the planned sections in reading order */
+static size_t write_prompt(ci_memory_digest_t* digest, const char* prompt,
+                           const prompt_plan_t* plan, char* out) {
+    size_t pos = 0;
+
+    if (plan->sunset) {
+        pos = emit_text(out, pos, PROMPT_SUNSET_HEADER);
+        pos = emit_text(out, pos, digest->sunset_notes);
+        pos = emit_text(out, pos, PROMPT_NOTES_END);
+    }
+    if (plan->sunrise) {
+        pos = emit_text(out, pos, PROMPT_SUNRISE_HEADER);
+        pos = emit_text(out, pos, digest->sunrise_brief);
+        pos = emit_text(out, pos, PROMPT_NOTES_END);
+    }
+    bool header = false;
+    for (int i = 0; i < digest->breadcrumb_count; i++) {
+        if (!plan->crumb_kept[i]) continue;
+        if (!header) pos = emit_text(out, pos, PROMPT_BREADCRUMB_HEADER);
+        header = true;
+        pos = emit_text(out, pos, PROMPT_ENTRY_START);
+        pos = emit_text(out, pos, digest->breadcrumbs[i]);
+        pos = emit_text(out, pos, PROMPT_ENTRY_END);
+    }
+    if (header) pos = emit_text(out, pos, PROMPT_SECTION_END);
+    header = false;
+    for (int i = 0; i < plan->item_count; i++) {
+        if (!plan->item_kept[i]) continue;
+        if (!header) pos = emit_text(out, pos, PROMPT_CONTEXT_HEADER);
+        header = true;
+        pos = emit_text(out, pos, PROMPT_TYPE_START);
+        pos = emit_text(out, pos, memory_type_name(plan->items[i]->type));
+        pos = emit_text(out, pos, PROMPT_TYPE_END);
+        memcpy(out + pos, plan->items[i]->content, plan->items[i]->content_size);
+        pos += plan->items[i]->content_size;
+        pos = emit_text(out, pos, PROMPT_ENTRY_END);
     }
+    if (header) pos = emit_text(out, pos, PROMPT_SECTION_END);
+    pos = emit_text(out, pos, PROMPT_TASK_HEADER);
+    pos = emit_text(out, pos, prompt);
+    out[pos] = '\0';
+    return pos;
+}
+
+/* Assemble prompt with memory context into a token budget */
+int api_assemble_prompt(ci_memory_digest_t* memory_digest,
+                        const char* prompt,
+                        size_t budget_tokens,
+                        char** out_prompt,
+                        api_prompt_report_t* report) {
+    int result = ARGO_SUCCESS;
+    char* assembled = NULL;
+    api_prompt_report_t local_report;
 
-    /* Add breadcrumbs if present */
-    if (memory_digest->breadcrumb_count > 0) {
-        written = snprintf(pos, remaining, "## Progress Breadcrumbs\n");
-        pos += written;
-        remaining -= written;
-
-        for (int i = 0; i < memory_digest->breadcrumb_count && remaining > 0; i++) {
-            written = snprintf(pos, remaining, "- %s\n",
-                             memory_digest->breadcrumbs[i]);
-            pos += written;
-            remaining -= written;
+    ARGO_CHECK_NULL(prompt);
+    ARGO_CHECK_NULL(out_prompt);
+    if (!report) report = &local_report;
+    memset(report, 0, sizeof(*report));
+
+    /* If no memory digest, just return a copy of the prompt */
+    if (!memory_digest) {
+        report->budget_tokens = budget_tokens;
+        report->task_tokens = memory_estimate_tokens(prompt, strlen(prompt));
+        report->used_tokens = report->task_tokens;
+        report->over_budget = budget_tokens > 0 && report->task_tokens > budget_tokens;
+        assembled = strdup(prompt);
+        if (!assembled) {
+            result = E_SYSTEM_MEMORY;
+            goto cleanup;
         }
-        written = snprintf(pos, remaining, "\n");
-        pos += written;
-        remaining -= written;
+        *out_prompt = assembled;
+        return ARGO_SUCCESS;
     }
 
-    /* Add selected memories if present */
-    if (memory_digest->selected_count > 0) {
-        written = snprintf(pos, remaining, "## Relevant Context\n");
-        pos += written;
-        remaining -= written;
-
-        for (int i = 0; i < memory_digest->selected_count && remaining > 0; i++) {
-            memory_item_t* item = memory_digest->selected[i];
-            if (item && item->content) {
-                const char* type_name = "Unknown";
-                switch (item->type) {
-                    case MEMORY_TYPE_DECISION: type_name = "Decision"; break;
-                    case MEMORY_TYPE_APPROACH: type_name = "Approach"; break;
-                    case MEMORY_TYPE_ERROR: type_name = "Error"; break;
-                    case MEMORY_TYPE_SUCCESS: type_name = "Success"; break;
-                    case MEMORY_TYPE_FACT: type_name = "Fact"; break;
-                    case MEMORY_TYPE_RELATIONSHIP: type_name = "Relationship"; break;
-                    case MEMORY_TYPE_BREADCRUMB: type_name = "Breadcrumb"; break;
-                }
-                written = snprintf(pos, remaining, "- [%s] %s\n",
-                                 type_name, item->content);
-                pos += written;
-                remaining -= written;
-            }
-        }
-        written = snprintf(pos, remaining, "\n");
-        pos += written;
-        remaining -= written;
+    prompt_plan_t plan = {0};
+    plan.items = memory_digest->selected;
+    plan.item_count = memory_digest->selected_count;
+    if (plan.item_count == 0 && memory_digest->item_count > 0) {
+        plan.item_count = memory_suggest_relevant(memory_digest, prompt, MEMORY_SUGGESTION_MAX);
+        plan.items = memory_digest->suggested;
     }
 
-    /* Add the actual prompt */
-    written = snprintf(pos, remaining, "## Current Task\n%s", prompt);
+    /* Pack by priority, then write the kept sections once */
+    plan_prompt(memory_digest, prompt, budget_tokens, &plan, report);
+    assembled = malloc(plan.bytes + 1);
+    if (!assembled) {
+        argo_report_error(E_SYSTEM_MEMORY, "api_assemble_prompt", ERR_MSG_MEMORY_ALLOC_FAILED);
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
+    write_prompt(memory_digest, prompt, &plan, assembled);
 
-    *out_augmented = augmented;
-    augmented = NULL;  /* Transfer ownership */
-    LOG_DEBUG("Augmented prompt with memory context (%zu bytes added)",
-              total_size - prompt_size);
+    *out_prompt = assembled;
+    assembled = NULL;  /* Transfer ownership */
+    if (report->over_budget) {
+        LOG_WARN("Prompt task alone is %zu tokens, over the %zu token budget",
+                 report->task_tokens, budget_tokens);
+    }
+    LOG_DEBUG("Assembled prompt: %zu/%zu tokens, dropped %d memories, %d breadcrumbs%s%s",
+              report->used_tokens, budget_tokens, report->items_dropped, report->breadcrumbs_dropped,
+              report->sunrise_dropped ? ", sunrise brief" : "",
+              report->sunset_dropped ? ", sunset notes" : "");
 
 cleanup:
-    free(augmented);
+    free(assembled);
     return result;
 }
+
+/* Prompt budget for a context window */
+size_t api_prompt_budget(size_t max_context) {
+    return max_context * (100 - API_PROMPT_RESPONSE_PERCENT) / 100;
+}
+
+/* Augment prompt with memory context (no token budget) */
+int api_augment_prompt_with_memory(ci_memory_digest_t* memory_digest,
+                                   const char* prompt,
+                                   char** out_augmented) {
+    return api_assemble_prompt(memory_digest, prompt, 0, out_augmented, NULL);
+}
@@ -4,6 +4,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
 #include <time.h>
 
 /* Project includes */
@@ -13,9 +15,27 @@
 #include "argo_api_providers.h"
 #include "argo_json.h"
 #include "argo_http.h"
+#include "argo_config.h"
+#include "argo_env_utils.h"
 #include "argo_error.h"
 #include "argo_error_messages.h"
 #include "argo_log.h"
+#include "argo_limits.h"
+#include "argo_time.h"
+#include "argo_stream_decoder.h"
+#include "argo_rate_limit.h"
+#include "argo_provider_telemetry.h"
+
+/* Per-call streaming state */
+typedef struct {
+    generic_api_context_t* ctx;
+    stream_decoder_t* decoder;
+    ci_stream_callback callback;
+    void* userdata;
+    size_t length;          /* Bytes of streamed text in ctx->response_content */
+    long long started_ms;   /* Monotonic, for time-to-first-token */
+    provider_usage_t usage; /* From the stream's usage events */
+} generic_stream_state_t;
 
 /* Static functions */
 static int generic_api_init(ci_provider_t* provider);
@@ -26,6 +46,30 @@ static int generic_api_stream(ci_provider_t* provider, const char* prompt,
                              ci_stream_callback callback, void* userdata);
 static void generic_api_cleanup(ci_provider_t* provider);
 
+/* Helper: Endpoint URL - config, then environment, then the built-in one */
+static void resolve_api_url(const api_provider_config_t* config, char* url, size_t url_size) {
+    char config_key[API_URL_SIZE];
+    char env_name[API_URL_SIZE];
+    snprintf(config_key, sizeof(config_key), "%s%s", config->provider_name, API_URL_CONFIG_SUFFIX);
+    snprintf(env_name, sizeof(env_name), "%s%s%s", API_URL_ENV_PREFIX, config->provider_name, API_URL_ENV_SUFFIX);
+    for (char* c = env_name; *c; c++) {
+        *c = isalnum((unsigned char)*c) ? (char)toupper((unsigned char)*c) : '_';
+    }
+
+    snprintf(url, url_size, "%s", config->api_url);
+    const char* sources[] = { argo_config_get(config_key), argo_getenv(env_name) };
+    for (size_t i = 0; i < sizeof(sources) / sizeof(sources[0]); i++) {
+        if (!sources[i] || !sources[i][0]) continue;
+        if (strncmp(sources[i], HTTP_SCHEME_PREFIX, strlen(HTTP_SCHEME_PREFIX)) == 0 ||
+            strncmp(sources[i], HTTPS_SCHEME_PREFIX, strlen(HTTPS_SCHEME_PREFIX)) == 0) {
+            snprintf(url, url_size, "%s", sources[i]);
+            LOG_INFO("%s endpoint overridden: %s", config->provider_name, url);
+            return;
+        }
+        LOG_WARN("Ignoring invalid %s: %s", config_key, sources[i]);
+    }
+}
+
 /* Create generic API provider */
 ci_provider_t* generic_api_create_provider(const api_provider_config_t* config,
                                            const char* model) {
@@ -46,6 +90,7 @@ ci_provider_t* generic_api_create_provider(const api_provider_config_t* config,
 
     /* Store config reference */
     ctx->config = config;
+    resolve_api_url(config, ctx->api_url, sizeof(ctx->api_url));
 
     /* Set model */
     strncpy(ctx->model, model ? model : config->default_model, sizeof(ctx->model) - 1);
@@ -103,54 +148,110 @@ static int generic_api_connect(ci_provider_t* provider) {
     return ARGO_SUCCESS;
 }
 
-/* Query generic API */
-static int generic_api_query(ci_provider_t* provider, const char* prompt,
-                            ci_response_callback callback, void* userdata) {
-    ARGO_CHECK_NULL(prompt);
-    ARGO_CHECK_NULL(callback);
-    ARGO_GET_CONTEXT(provider, generic_api_context_t, ctx);
-
+/* Helper: Build authenticated request (memory-augmented prompt) */
+static int build_api_request(generic_api_context_t* ctx, const char* prompt, bool stream,
+                             http_request_t** req) {
     const api_provider_config_t* cfg = ctx->config;
 
-    /* Augment prompt with memory if available */
+    /* Build URL (append model if needed, like Gemini); never send a truncated one */
+    char url[API_URL_SIZE];
+    int needed = cfg->url_includes_model
+                     ? snprintf(url, sizeof(url), "%s/%s%s", ctx->api_url, ctx->model,
+                                stream ? API_STREAM_GENERATE_METHOD : API_GENERATE_METHOD)
+                     : snprintf(url, sizeof(url), "%s", ctx->api_url);
+    if (needed < 0 || (size_t)needed >= sizeof(url)) {
+        argo_report_error(E_INPUT_TOO_LARGE, "generic_api_query", ERR_FMT_SIZE_VALUE, (size_t)needed);
+        return E_INPUT_TOO_LARGE;
+    }
+
+    /* Augment prompt with memory if available, within the context window */
     char* augmented_prompt = NULL;
     const char* final_prompt = prompt;
 
     if (ctx->memory) {
-        int result = api_augment_prompt_with_memory(ctx->memory, prompt, &augmented_prompt);
+        api_prompt_report_t report;
+        int result = api_assemble_prompt(ctx->memory, prompt, api_prompt_budget(ctx->provider.max_context),
+                                         &augmented_prompt, &report);
         if (result == ARGO_SUCCESS && augmented_prompt) {
             final_prompt = augmented_prompt;
-            LOG_DEBUG("Augmented prompt with memory context");
+            if (report.items_dropped > 0 || report.breadcrumbs_dropped > 0) {
+                LOG_INFO("%s: context budget dropped %d memories and %d breadcrumbs",
+                         cfg->provider_name, report.items_dropped, report.breadcrumbs_dropped);
+            }
         }
         /* If augmentation fails, fall back to original prompt */
     }
 
-    /* Build request JSON using provider-specific builder */
-    char json_body[API_REQUEST_BUFFER_SIZE];
-    int json_len = cfg->build_request(json_body, sizeof(json_body),
-                                      ctx->model, final_prompt);
-    if (json_len < 0) {
-        free(augmented_prompt);
+    /* Build request JSON using provider-specific builder, sized for the prompt */
+    json_builder_t json;
+    int result = json_builder_init(&json, strlen(final_prompt));
+    if (result == ARGO_SUCCESS) {
+        result = cfg->build_request(&json, ctx->model, final_prompt, stream);
+    }
+    free(augmented_prompt);
+
+    size_t body_len = 0;
+    char* body = (result == ARGO_SUCCESS) ? json_builder_take(&json, &body_len) : NULL;
+    json_builder_free(&json);
+    if (!body) {
         argo_report_error(E_PROTOCOL_FORMAT, "generic_api_query", ERR_MSG_JSON_BUILD_FAILED);
-        return E_PROTOCOL_FORMAT;
+        return result == E_SYSTEM_MEMORY ? E_SYSTEM_MEMORY : E_PROTOCOL_FORMAT;
     }
 
-    /* Build URL (append model if needed, like Gemini) */
-    char url[API_URL_SIZE];
-    if (cfg->url_includes_model) {
-        snprintf(url, sizeof(url), "%s/%s:generateContent", cfg->api_url, ctx->model);
-    } else {
-        strncpy(url, cfg->api_url, sizeof(url) - 1);
-        url[sizeof(url) - 1] = '\0';
+    *req = api_build_json_post_owned(url, body, body_len, &cfg->auth, cfg->extra_headers);
+    if (!*req) {
+        argo_report_error(E_SYSTEM_MEMORY, "generic_api_query", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return E_SYSTEM_MEMORY;
     }
+    return ARGO_SUCCESS;
+}
 
-    /* Execute HTTP request */
-    http_response_t* resp = NULL;
-    int result = api_http_post_json(url, json_body, &cfg->auth,
-                                    cfg->extra_headers, &resp);
+/* Build query request for generic API provider */
+int generic_api_prepare_query(ci_provider_t* provider, const char* prompt, http_request_t** req) {
+    ARGO_CHECK_NULL(prompt);
+    ARGO_CHECK_NULL(req);
+    ARGO_GET_CONTEXT(provider, generic_api_context_t, ctx);
+
+    return build_api_request(ctx, prompt, false, req);
+}
+
+/* Helper: Record a finished call in provider telemetry (resp NULL = no answer) */
+static void record_call(const generic_api_context_t* ctx, int result, bool streamed, long long started_ms,
+                        const http_response_t* resp, const provider_usage_t* usage) {
+    provider_call_t call = {
+        .provider = ctx->provider.name,
+        .model = ctx->model,
+        .result = result,
+        .streamed = streamed,
+        .ttfb_ms = -1
+    };
+    long long transfer_ms = resp ? resp->total_ms : 0;
+    call.total_ms = started_ms > 0 ? argo_monotonic_ms() - started_ms : transfer_ms;
+    if (resp) {
+        call.request_bytes = resp->bytes_sent;
+        call.response_bytes = resp->bytes_received;
+        call.ttfb_ms = resp->ttfb_ms;
+        call.queue_ms = call.total_ms > transfer_ms ? call.total_ms - transfer_ms : 0;
+    }
+    if (usage) {
+        call.usage = *usage;
+    }
+    provider_telemetry_record(&call);
+}
+
+/* Record a request that got no response */
+void generic_api_record_failure(ci_provider_t* provider, int result, long long started_ms) {
+    if (!generic_api_is_provider(provider) || !provider->context) return;
+    record_call((generic_api_context_t*)provider->context, result, false, started_ms, NULL, NULL);
+}
+
+/* Helper: Checked status and extracted content into the context buffer */
+static int extract_content(generic_api_context_t* ctx, const http_response_t* resp) {
+    const api_provider_config_t* cfg = ctx->config;
+
+    /* Check HTTP status and map to specific error codes */
+    int result = api_check_http_status(resp->status_code, "generic_api_query");
     if (result != ARGO_SUCCESS) {
-        argo_report_error(result, "generic_api_query", ERR_MSG_HTTP_REQUEST_FAILED);
-        free(augmented_prompt);
         return result;
     }
 
@@ -163,8 +264,6 @@ static int generic_api_query(ci_provider_t* provider, const char* prompt,
 
     if (result != ARGO_SUCCESS) {
         argo_report_error(result, "generic_api_query", ERR_MSG_JSON_EXTRACT_FAILED);
-        http_response_free(resp);
-        free(augmented_prompt);
         return result;
     }
 
@@ -173,8 +272,6 @@ static int generic_api_query(ci_provider_t* provider, const char* prompt,
                                    content_len + 1);
     if (result != ARGO_SUCCESS) {
         free(extracted_content);
-        http_response_free(resp);
-        free(augmented_prompt);
         return result;
     }
 
@@ -182,7 +279,26 @@ static int generic_api_query(ci_provider_t* provider, const char* prompt,
     memcpy(ctx->response_content, extracted_content, content_len);
     ctx->response_content[content_len] = '\0';
     free(extracted_content);
-    http_response_free(resp);
+    return ARGO_SUCCESS;
+}
+
+/* Complete query from HTTP response */
+int generic_api_complete_query(ci_provider_t* provider, const http_response_t* resp,
+                               long long started_ms, ci_response_callback callback, void* userdata) {
+    ARGO_CHECK_NULL(resp);
+    ARGO_CHECK_NULL(callback);
+    ARGO_GET_CONTEXT(provider, generic_api_context_t, ctx);
+
+    int result = extract_content(ctx, resp);
+
+    provider_usage_t usage = {0};
+    if (result == ARGO_SUCCESS) {
+        provider_usage_parse(resp->body, resp->body_len, &usage);
+    }
+    record_call(ctx, result, false, started_ms, resp, &usage);
+    if (result != ARGO_SUCCESS) {
+        return result;
+    }
 
     /* Build response */
     ci_response_t response;
@@ -195,20 +311,126 @@ static int generic_api_query(ci_provider_t* provider, const char* prompt,
     /* Invoke callback */
     callback(&response, userdata);
 
-    /* Free augmented prompt if allocated */
-    free(augmented_prompt);
-
     return ARGO_SUCCESS;
 }
 
-/* Stream from generic API */
+/* Check for generic API provider */
+bool generic_api_is_provider(const ci_provider_t* provider) {
+    return provider && provider->query == generic_api_query;
+}
+
+/* Query generic API */
+static int generic_api_query(ci_provider_t* provider, const char* prompt,
+                            ci_response_callback callback, void* userdata) {
+    ARGO_CHECK_NULL(callback);
+
+    long long started_ms = argo_monotonic_ms();
+    http_request_t* req = NULL;
+    int result = generic_api_prepare_query(provider, prompt, &req);
+    if (result != ARGO_SUCCESS) {
+        return result;
+    }
+
+    /* Execute HTTP request under the key's rate limit */
+    http_response_t* resp = NULL;
+    result = rate_limit_execute(req, rate_limit_default_deadline(), NULL, NULL, &resp);
+    http_request_free(req);
+    if (result != ARGO_SUCCESS) {
+        argo_report_error(result, "generic_api_query", ERR_MSG_HTTP_REQUEST_FAILED);
+        generic_api_record_failure(provider, result, started_ms);
+        return result;
+    }
+
+    result = generic_api_complete_query(provider, resp, started_ms, callback, userdata);
+    http_response_free(resp);
+    return result;
+}
+
+/* Helper: Decoded delta - keep a copy and pass it on */
+static void stream_on_delta(const char* text, size_t len, void* userdata) {
+    generic_stream_state_t* state = (generic_stream_state_t*)userdata;
+    generic_api_context_t* ctx = state->ctx;
+
+    if (state->length == 0) {
+        LOG_DEBUG("%s first token after %lld ms", ctx->config->provider_name,
+                  argo_monotonic_ms() - state->started_ms);
+    }
+
+    if (ensure_buffer_capacity(&ctx->response_content, &ctx->response_capacity,
+                               state->length + len + 1) == ARGO_SUCCESS) {
+        memcpy(ctx->response_content + state->length, text, len);
+        state->length += len;
+        ctx->response_content[state->length] = '\0';
+    }
+
+    state->callback(text, len, state->userdata);
+}
+
+/* Helper: Parsed stream event - collect usage counters */
+static void stream_on_event(json_node_t* event, void* userdata) {
+    generic_stream_state_t* state = (generic_stream_state_t*)userdata;
+    provider_usage_read(event, &state->usage);
+}
+
+/* Helper: Raw HTTP bytes - feed the decoder */
+static void stream_on_chunk(const char* chunk, size_t len, void* userdata) {
+    generic_stream_state_t* state = (generic_stream_state_t*)userdata;
+    stream_decoder_feed(state->decoder, chunk, len);
+}
+
+/* Stream from generic API - deltas delivered as they arrive */
 static int generic_api_stream(ci_provider_t* provider, const char* prompt,
                              ci_stream_callback callback, void* userdata) {
     ARGO_CHECK_NULL(prompt);
     ARGO_CHECK_NULL(callback);
+    ARGO_GET_CONTEXT(provider, generic_api_context_t, ctx);
 
-    return ci_query_to_stream(provider, prompt, generic_api_query,
-                             callback, userdata);
+    const api_provider_config_t* cfg = ctx->config;
+    if (!cfg->supports_streaming || !cfg->stream_delta_pointer) {
+        return ci_query_to_stream(provider, prompt, generic_api_query,
+                                 callback, userdata);
+    }
+
+    generic_stream_state_t state = {
+        .ctx = ctx,
+        .callback = callback,
+        .userdata = userdata,
+        .started_ms = argo_monotonic_ms()
+    };
+    http_request_t* req = NULL;
+    int result = build_api_request(ctx, prompt, true, &req);
+    if (result != ARGO_SUCCESS) {
+        return result;
+    }
+
+    state.decoder = stream_decoder_create(STREAM_FORMAT_SSE, cfg->stream_delta_pointer,
+                                          stream_on_delta, &state);
+    if (!state.decoder) {
+        http_request_free(req);
+        return E_SYSTEM_MEMORY;
+    }
+    stream_decoder_set_event_fn(state.decoder, stream_on_event, &state);
+
+    http_response_t* resp = NULL;
+    result = api_http_execute_stream(req, stream_on_chunk, &state, &resp);
+    http_request_free(req);
+    if (result == ARGO_SUCCESS) {
+        result = stream_decoder_finish(state.decoder);
+    }
+    stream_decoder_destroy(state.decoder);
+    record_call(ctx, result, true, state.started_ms, resp, &state.usage);
+    http_response_free(resp);
+
+    if (result != ARGO_SUCCESS) {
+        argo_report_error(result, "generic_api_stream", ERR_MSG_HTTP_REQUEST_FAILED);
+        return result;
+    }
+
+    if (state.length == 0 && ctx->response_content) {
+        ctx->response_content[0] = '\0';
+    }
+    ARGO_UPDATE_STATS(ctx);
+    return ARGO_SUCCESS;
 }
 
 /* Cleanup */
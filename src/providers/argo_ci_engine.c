@@ -0,0 +1,516 @@
+/* © 2025 Casey Koons All rights reserved */
+
+/* CI Engine - async provider queries on a curl_multi reactor and worker pool */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* clock_gettime() */
+#endif
+
+/* System includes */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+/* Project includes */
+#include "argo_ci_engine.h"
+#include "argo_ci_engine_internal.h"
+#include "argo_api_common.h"
+#include "argo_http_multi.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_log.h"
+#include "argo_limits.h"
+#include "argo_time.h"
+#include "argo_rate_limit.h"
+
+/* Longest timer sleep, bounds drift against the wall clock */
+#define CI_ENGINE_TIMER_MAX_WAIT_MS 1000
+
+/* Helper: Give provider back to its owner, or clean it up */
+static void release_provider(ci_provider_t* provider, ci_provider_release_fn release,
+                             void* release_context, int result) {
+    if (!provider) return;
+
+    if (release) {
+        release(provider, result, release_context);
+    } else if (provider->cleanup) {
+        provider->cleanup(provider);
+    }
+}
+
+/* Helper: Engine is done with the query - release provider, drop engine ref */
+static void job_finished(ci_future_t* future) {
+    ci_engine_t* engine = future->engine;
+
+    release_provider(future->provider, future->release, future->release_context,
+                     future->provider_result);
+    future->provider = NULL;
+
+    pthread_mutex_lock(&engine->lock);
+    ci_future_t** link = &engine->watch;
+    while (*link && *link != future) link = &(*link)->watch_next;
+    if (*link) *link = future->watch_next;
+    engine->pending--;
+    pthread_mutex_unlock(&engine->lock);
+
+    ci_future_unref(future);
+}
+
+/* Helper: Provider init and connect (borrowed providers are ready) */
+static int start_provider(ci_future_t* future) {
+    ci_provider_t* provider = future->provider;
+    int result = ARGO_SUCCESS;
+    if (future->release) {
+        return result;
+    }
+    if (provider->init) {
+        result = provider->init(provider);
+    }
+    if (result == ARGO_SUCCESS && provider->connect) {
+        result = provider->connect(provider);
+    }
+    return result;
+}
+
+static void on_http_done(int result, http_response_t* resp, void* userdata);
+
+/* Helper: Put the transfer on the curl_multi reactor (consumes req) */
+static int start_transfer(ci_engine_t* engine, ci_future_t* future, http_request_t* req) {
+    long remaining = (long)(future->deadline_ms - argo_monotonic_ms());
+    if (remaining < 1) remaining = 1;
+
+    uint64_t id = 0;
+    int result = http_multi_submit(engine->multi, req, remaining, NULL, on_http_done, future, &id);
+    if (result != ARGO_SUCCESS) {
+        http_request_free(req);
+        return result;
+    }
+
+    /* Cancelled while submitting: nobody else saw the id */
+    pthread_mutex_lock(&future->lock);
+    future->transfer_id = id;
+    bool cancelled = (future->state != FUTURE_PENDING);
+    pthread_mutex_unlock(&future->lock);
+    if (cancelled) {
+        http_multi_cancel(engine->multi, id);
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Reserve a rate limit slot, then start now or at the slot (consumes req) */
+static int schedule_http(ci_engine_t* engine, ci_future_t* future, http_request_t* req) {
+    long long start_ms = argo_monotonic_ms();
+    if (future->limiter) {
+        int result = rate_limit_reserve(future->limiter, rate_limit_estimate_tokens(req->body_len),
+                                        future->deadline_ms, &start_ms);
+        if (result != ARGO_SUCCESS) {
+            http_request_free(req);
+            return result;
+        }
+    }
+    if (start_ms <= argo_monotonic_ms()) {
+        return start_transfer(engine, future, req);
+    }
+
+    /* The timer thread starts it when the slot comes up */
+    pthread_mutex_lock(&engine->lock);
+    if (!engine->running) {
+        pthread_mutex_unlock(&engine->lock);
+        http_request_free(req);
+        return E_CI_CANCELLED;
+    }
+    future->deferred_req = req;
+    future->start_ms = start_ms;
+    future->deferred_next = engine->deferred;
+    engine->deferred = future;
+    pthread_cond_signal(&engine->timer_wake);
+    pthread_mutex_unlock(&engine->lock);
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Another attempt after a 429, if retries and the deadline allow */
+static int retry_http(ci_future_t* future) {
+    if (future->attempts >= RATE_LIMIT_MAX_RETRIES || ci_future_done(future)) {
+        return E_HTTP_RATE_LIMIT;
+    }
+    future->attempts++;
+
+    http_request_t* req = NULL;
+    int result = generic_api_prepare_query(future->provider, future->prompt, &req);
+    if (result == ARGO_SUCCESS) {
+        result = schedule_http(future->engine, future, req);
+    }
+    return result;
+}
+
+/* Helper: HTTP lane completion (reactor thread) */
+static void on_http_done(int result, http_response_t* resp, void* userdata) {
+    ci_future_t* future = (ci_future_t*)userdata;
+    ci_capture_t capture = {0};
+
+    if (result == ARGO_SUCCESS && rate_limit_observe(future->limiter, resp) &&
+        retry_http(future) == ARGO_SUCCESS) {
+        http_response_free(resp);
+        return;     /* Completes on a later attempt */
+    }
+
+    if (result == ARGO_SUCCESS) {
+        result = generic_api_complete_query(future->provider, resp, future->submitted_ms,
+                                            ci_capture_response, &capture);
+    } else {
+        if (result == E_SYSTEM_TIMEOUT) result = E_CI_TIMEOUT;
+        if (result != E_CI_CANCELLED) {     /* Hedge losers did not fail */
+            generic_api_record_failure(future->provider, result, future->submitted_ms);
+        }
+    }
+    http_response_free(resp);
+    future->provider_result = result;
+
+    ci_future_complete(future, result, &capture);
+    free(capture.content);
+    free(capture.model);
+    job_finished(future);
+}
+
+/* Helper: Start query on the curl_multi reactor, under its rate limit */
+static int submit_http(ci_engine_t* engine, ci_future_t* future) {
+    int result = start_provider(future);
+    if (result != ARGO_SUCCESS) return result;
+
+    http_request_t* req = NULL;
+    result = generic_api_prepare_query(future->provider, future->prompt, &req);
+    if (result != ARGO_SUCCESS) return result;
+
+    future->limiter = rate_limit_for_request(req);
+    return schedule_http(engine, future, req);
+}
+
+/* Helper: Slot reached - start a deferred transfer (timer thread) */
+static void start_deferred(ci_engine_t* engine, ci_future_t* future) {
+    http_request_t* req = future->deferred_req;
+    future->deferred_req = NULL;
+
+    if (ci_future_done(future)) {
+        http_request_free(req);     /* Cancelled while waiting */
+        job_finished(future);
+        return;
+    }
+
+    int result = start_transfer(engine, future, req);
+    if (result != ARGO_SUCCESS) {
+        future->provider_result = result;
+        ci_future_complete(future, result, NULL);
+        job_finished(future);
+    }
+}
+
+/* Helper: Worker lane - run blocking provider calls */
+static void* worker_thread(void* arg) {
+    ci_engine_t* engine = (ci_engine_t*)arg;
+
+    while (true) {
+        pthread_mutex_lock(&engine->lock);
+        while (engine->running && !engine->queue_head) {
+            pthread_cond_wait(&engine->work_ready, &engine->lock);
+        }
+        ci_future_t* future = engine->queue_head;
+        if (!future) {
+            pthread_mutex_unlock(&engine->lock);
+            break;
+        }
+        engine->queue_head = future->next;
+        if (!engine->queue_head) engine->queue_tail = NULL;
+        pthread_mutex_unlock(&engine->lock);
+
+        /* Skip calls already timed out or cancelled while queued */
+        if (!ci_future_done(future)) {
+            ci_capture_t capture = {0};
+            int result = start_provider(future);
+            if (result == ARGO_SUCCESS) {
+                result = future->provider->query(future->provider, future->prompt,
+                                                 ci_capture_response, &capture);
+            }
+            future->provider_result = result;
+            ci_future_complete(future, result, &capture);
+            free(capture.content);
+            free(capture.model);
+        }
+        job_finished(future);
+    }
+
+    return NULL;
+}
+
+/* Helper: Expire worker-lane deadlines */
+static void* timer_thread(void* arg) {
+    ci_engine_t* engine = (ci_engine_t*)arg;
+
+    pthread_mutex_lock(&engine->lock);
+    while (engine->running) {
+        long long now = argo_monotonic_ms();
+        long long wait_ms = CI_ENGINE_TIMER_MAX_WAIT_MS;
+        ci_future_t* expired = NULL;
+        ci_future_t* due = NULL;
+
+        ci_future_t** link = &engine->deferred;
+        while (*link) {
+            ci_future_t* f = *link;
+            if (f->start_ms <= now) {
+                *link = f->deferred_next;
+                f->deferred_next = due;
+                due = f;
+                continue;
+            }
+            if (f->start_ms - now < wait_ms) {
+                wait_ms = f->start_ms - now;
+            }
+            link = &f->deferred_next;
+        }
+
+        for (ci_future_t* f = engine->watch; f; f = f->watch_next) {
+            if (f->expired) continue;
+            if (f->deadline_ms <= now) {
+                f->expired = true;
+                pthread_mutex_lock(&f->lock);
+                f->refs++;
+                pthread_mutex_unlock(&f->lock);
+                f->expire_next = expired;
+                expired = f;
+            } else if (f->deadline_ms - now < wait_ms) {
+                wait_ms = f->deadline_ms - now;
+            }
+        }
+
+        if (expired || due) {
+            /* Complete and start outside the engine lock; callbacks may submit */
+            pthread_mutex_unlock(&engine->lock);
+            while (due) {
+                ci_future_t* next = due->deferred_next;
+                start_deferred(engine, due);
+                due = next;
+            }
+            while (expired) {
+                ci_future_t* next = expired->expire_next;
+                if (ci_future_complete(expired, E_CI_TIMEOUT, NULL)) {
+                    LOG_WARN("CI query timed out before the provider returned");
+                }
+                ci_future_unref(expired);
+                expired = next;
+            }
+            pthread_mutex_lock(&engine->lock);
+            continue;
+        }
+
+        struct timespec until;
+        clock_gettime(CLOCK_REALTIME, &until);
+        until.tv_sec += wait_ms / MILLISECONDS_PER_SECOND;
+        until.tv_nsec += (wait_ms % MILLISECONDS_PER_SECOND) * NANOSECONDS_PER_MILLISECOND;
+        if (until.tv_nsec >= NANOSECONDS_PER_MILLISECOND * MILLISECONDS_PER_SECOND) {
+            until.tv_sec++;
+            until.tv_nsec -= NANOSECONDS_PER_MILLISECOND * MILLISECONDS_PER_SECOND;
+        }
+        pthread_cond_timedwait(&engine->timer_wake, &engine->lock, &until);
+    }
+    pthread_mutex_unlock(&engine->lock);
+
+    return NULL;
+}
+
+/* Create engine */
+ci_engine_t* ci_engine_create(int workers) {
+    if (workers <= 0) workers = CI_ENGINE_DEFAULT_WORKERS;
+    if (workers > CI_ENGINE_MAX_WORKERS) workers = CI_ENGINE_MAX_WORKERS;
+
+    ci_engine_t* engine = calloc(1, sizeof(ci_engine_t));
+    if (!engine) {
+        argo_report_error(E_SYSTEM_MEMORY, "ci_engine_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return NULL;
+    }
+
+    pthread_mutex_init(&engine->lock, NULL);
+    pthread_cond_init(&engine->work_ready, NULL);
+    pthread_cond_init(&engine->timer_wake, NULL);
+    engine->running = true;
+
+    engine->multi = http_multi_create();
+    if (!engine->multi) {
+        goto error;
+    }
+
+    if (pthread_create(&engine->timer, NULL, timer_thread, engine) != 0) {
+        goto error;
+    }
+    engine->timer_started = true;
+
+    for (int i = 0; i < workers; i++) {
+        if (pthread_create(&engine->workers[i], NULL, worker_thread, engine) != 0) {
+            goto error;
+        }
+        engine->worker_count++;
+    }
+
+    LOG_INFO("CI engine started (%d workers)", engine->worker_count);
+    return engine;
+
+error:
+    argo_report_error(E_SYSTEM_THREAD, "ci_engine_create", "failed to start engine");
+    ci_engine_destroy(engine);
+    return NULL;
+}
+
+/* Helper: Queue query on the lane that fits its provider */
+static ci_future_t* submit_query(ci_engine_t* engine, ci_provider_t* provider,
+                                 ci_provider_release_fn release, void* release_context,
+                                 const char* prompt, int timeout_ms,
+                                 ci_response_callback callback, void* userdata) {
+    ci_future_t* future = NULL;
+
+    if (!engine || !provider || !prompt || !provider->query) {
+        argo_report_error(E_INPUT_NULL, "ci_engine_submit", "engine, provider and prompt required");
+        goto error;
+    }
+
+    future = calloc(1, sizeof(ci_future_t));
+    if (!future || !(future->prompt = strdup(prompt))) {
+        argo_report_error(E_SYSTEM_MEMORY, "ci_engine_submit", ERR_MSG_MEMORY_ALLOC_FAILED);
+        goto error;
+    }
+
+    pthread_mutex_init(&future->lock, NULL);
+    pthread_cond_init(&future->done, NULL);
+    future->state = FUTURE_PENDING;
+    future->refs = 2;
+    future->callback = callback;
+    future->userdata = userdata;
+    future->engine = engine;
+    future->provider = provider;
+    future->release = release;
+    future->release_context = release_context;
+    future->submitted_ms = argo_monotonic_ms();
+    future->deadline_ms = future->submitted_ms + (timeout_ms > 0 ? timeout_ms : CI_ENGINE_DEFAULT_TIMEOUT_MS);
+
+    bool http = generic_api_is_provider(provider);
+
+    pthread_mutex_lock(&engine->lock);
+    if (!engine->running) {
+        pthread_mutex_unlock(&engine->lock);
+        argo_report_error(E_INVALID_STATE, "ci_engine_submit", "engine is shutting down");
+        future->provider = NULL;
+        future->refs = 1;
+        ci_future_unref(future);
+        future = NULL;
+        goto error;
+    }
+    engine->pending++;
+    if (!http) {
+        future->watch_next = engine->watch;
+        engine->watch = future;
+        if (engine->queue_tail) {
+            engine->queue_tail->next = future;
+        } else {
+            engine->queue_head = future;
+        }
+        engine->queue_tail = future;
+        pthread_cond_signal(&engine->work_ready);
+        pthread_cond_signal(&engine->timer_wake);
+    }
+    pthread_mutex_unlock(&engine->lock);
+
+    if (http) {
+        int result = submit_http(engine, future);
+        if (result != ARGO_SUCCESS) {
+            future->provider_result = result;
+            ci_future_complete(future, result, NULL);
+            job_finished(future);
+        }
+    }
+    return future;
+
+error:
+    if (future) {
+        free(future->prompt);
+        free(future);
+    }
+    release_provider(provider, release, release_context, ARGO_SUCCESS);
+    return NULL;
+}
+
+/* Submit query */
+ci_future_t* ci_engine_submit(ci_engine_t* engine, ci_provider_t* provider,
+                              const char* prompt, int timeout_ms,
+                              ci_response_callback callback, void* userdata) {
+    return submit_query(engine, provider, NULL, NULL, prompt, timeout_ms, callback, userdata);
+}
+
+/* Submit query on a borrowed provider */
+ci_future_t* ci_engine_submit_borrowed(ci_engine_t* engine, ci_provider_t* provider,
+                                       ci_provider_release_fn release, void* release_context,
+                                       const char* prompt, int timeout_ms,
+                                       ci_response_callback callback, void* userdata) {
+    if (!release) {
+        argo_report_error(E_INPUT_NULL, "ci_engine_submit_borrowed", "release function required");
+        return NULL;
+    }
+    return submit_query(engine, provider, release, release_context, prompt, timeout_ms,
+                        callback, userdata);
+}
+
+/* Count outstanding queries */
+int ci_engine_pending(ci_engine_t* engine) {
+    if (!engine) return 0;
+
+    pthread_mutex_lock(&engine->lock);
+    int pending = engine->pending;
+    pthread_mutex_unlock(&engine->lock);
+    return pending;
+}
+
+/* Stop engine */
+void ci_engine_destroy(ci_engine_t* engine) {
+    if (!engine) return;
+
+    pthread_mutex_lock(&engine->lock);
+    engine->running = false;
+    ci_future_t* queued = engine->queue_head;
+    ci_future_t* deferred = engine->deferred;
+    engine->queue_head = NULL;
+    engine->queue_tail = NULL;
+    engine->deferred = NULL;
+    pthread_cond_broadcast(&engine->work_ready);
+    pthread_cond_signal(&engine->timer_wake);
+    pthread_mutex_unlock(&engine->lock);
+
+    while (queued) {
+        ci_future_t* next = queued->next;
+        ci_future_complete(queued, E_CI_CANCELLED, NULL);
+        job_finished(queued);
+        queued = next;
+    }
+    while (deferred) {
+        ci_future_t* next = deferred->deferred_next;
+        http_request_free(deferred->deferred_req);
+        deferred->deferred_req = NULL;
+        ci_future_complete(deferred, E_CI_CANCELLED, NULL);
+        job_finished(deferred);
+        deferred = next;
+    }
+
+    /* Running provider calls finish first */
+    for (int i = 0; i < engine->worker_count; i++) {
+        pthread_join(engine->workers[i], NULL);
+    }
+    if (engine->timer_started) {
+        pthread_join(engine->timer, NULL);
+    }
+
+    /* In-flight HTTP queries complete with E_CI_CANCELLED */
+    http_multi_destroy(engine->multi);
+
+    pthread_cond_destroy(&engine->timer_wake);
+    pthread_cond_destroy(&engine->work_ready);
+    pthread_mutex_destroy(&engine->lock);
+    free(engine);
+}
@@ -0,0 +1,155 @@
+/* © 2025 Casey Koons All rights reserved */
+
+/* CI Future - completion, waiting and cancellation of engine queries */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* clock_gettime() */
+#endif
+
+/* System includes */
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+/* Project includes */
+#include "argo_ci_engine.h"
+#include "argo_ci_engine_internal.h"
+#include "argo_http_multi.h"
+#include "argo_error.h"
+#include "argo_limits.h"
+
+/* Provider response callback - keep a copy */
+void ci_capture_response(const ci_response_t* response, void* userdata) {
+    ci_capture_t* capture = (ci_capture_t*)userdata;
+    if (!response || !response->success || !response->content || capture->content) return;
+
+    capture->content = strdup(response->content);
+    if (response->model_used) {
+        capture->model = strdup(response->model_used);
+    }
+}
+
+/* Drop a reference */
+void ci_future_unref(ci_future_t* future) {
+    pthread_mutex_lock(&future->lock);
+    int refs = --future->refs;
+    pthread_mutex_unlock(&future->lock);
+    if (refs > 0) return;
+
+    free(future->prompt);
+    free(future->response.content);
+    free(future->response.model_used);
+    pthread_cond_destroy(&future->done);
+    pthread_mutex_destroy(&future->lock);
+    free(future);
+}
+
+/* Set result once, run callback, wake waiters */
+bool ci_future_complete(ci_future_t* future, int result, const ci_capture_t* capture) {
+    pthread_mutex_lock(&future->lock);
+    if (future->state != FUTURE_PENDING) {
+        pthread_mutex_unlock(&future->lock);
+        return false;
+    }
+    future->state = FUTURE_COMPLETING;
+    pthread_mutex_unlock(&future->lock);
+
+    if (result == ARGO_SUCCESS && !(capture && capture->content)) {
+        result = E_SYSTEM_PROCESS;  /* Provider returned without a reply */
+    }
+    if (result == ARGO_SUCCESS) {
+        future->response.content = strdup(capture->content);
+        future->response.model_used = capture->model ? strdup(capture->model) : NULL;
+        if (!future->response.content) result = E_SYSTEM_MEMORY;
+    }
+
+    future->response.success = (result == ARGO_SUCCESS);
+    future->response.error_code = result;
+    future->response.content_len = future->response.content ? strlen(future->response.content) : 0;
+    future->response.timestamp = time(NULL);
+
+    if (future->callback) {
+        future->callback(&future->response, future->userdata);
+    }
+
+    pthread_mutex_lock(&future->lock);
+    future->state = FUTURE_DONE;
+    pthread_cond_broadcast(&future->done);
+    pthread_mutex_unlock(&future->lock);
+    return true;
+}
+
+/* Wait for completion */
+int ci_future_wait(ci_future_t* future, int timeout_ms) {
+    ARGO_CHECK_NULL(future);
+
+    struct timespec until;
+    if (timeout_ms != CI_ENGINE_NO_TIMEOUT) {
+        clock_gettime(CLOCK_REALTIME, &until);
+        until.tv_sec += timeout_ms / MILLISECONDS_PER_SECOND;
+        until.tv_nsec += (long)(timeout_ms % MILLISECONDS_PER_SECOND) * NANOSECONDS_PER_MILLISECOND;
+        if (until.tv_nsec >= NANOSECONDS_PER_MILLISECOND * MILLISECONDS_PER_SECOND) {
+            until.tv_sec++;
+            until.tv_nsec -= NANOSECONDS_PER_MILLISECOND * MILLISECONDS_PER_SECOND;
+        }
+    }
+
+    int result = ARGO_SUCCESS;
+    pthread_mutex_lock(&future->lock);
+    while (future->state != FUTURE_DONE && result == ARGO_SUCCESS) {
+        if (timeout_ms == CI_ENGINE_NO_TIMEOUT) {
+            pthread_cond_wait(&future->done, &future->lock);
+        } else if (pthread_cond_timedwait(&future->done, &future->lock, &until) == ETIMEDOUT) {
+            result = (future->state == FUTURE_DONE) ? ARGO_SUCCESS : E_SYSTEM_TIMEOUT;
+        }
+    }
+    pthread_mutex_unlock(&future->lock);
+
+    return result;
+}
+
+/* Check completion */
+bool ci_future_done(ci_future_t* future) {
+    if (!future) return false;
+
+    pthread_mutex_lock(&future->lock);
+    bool done = (future->state != FUTURE_PENDING);
+    pthread_mutex_unlock(&future->lock);
+    return done;
+}
+
+/* Completed response */
+const ci_response_t* ci_future_response(ci_future_t* future) {
+    if (!future) return NULL;
+
+    pthread_mutex_lock(&future->lock);
+    bool done = (future->state == FUTURE_DONE);
+    pthread_mutex_unlock(&future->lock);
+    return done ? &future->response : NULL;
+}
+
+/* Cancel query */
+int ci_future_cancel(ci_future_t* future) {
+    ARGO_CHECK_NULL(future);
+
+    if (!ci_future_complete(future, E_CI_CANCELLED, NULL)) {
+        return E_INVALID_STATE;
+    }
+
+    /* Stop the transfer too; a worker-lane call runs to completion */
+    pthread_mutex_lock(&future->lock);
+    uint64_t id = future->transfer_id;
+    pthread_mutex_unlock(&future->lock);
+    if (id) {
+        http_multi_cancel(future->engine->multi, id);
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Release caller's reference */
+void ci_future_release(ci_future_t* future) {
+    if (!future) return;
+    ci_future_unref(future);
+}
@@ -4,7 +4,7 @@
  * Matches Tekton's proven implementation:
  * - In-process execution via subprocess with streaming output
  * - Memory digest integration (sundown/sunrise)
- * - Real-time streaming to stdout
+ * - Output passed on in chunks as the subprocess writes it
  */
 
 /* System includes */
@@ -25,18 +25,19 @@
 #include "argo_error.h"
 #include "argo_error_messages.h"
 #include "argo_log.h"
-#include "argo_output.h"
 #include "argo_limits.h"
 #include "argo_memory.h"
+#include "argo_claude_session_pool.h"
+#include "argo_provider_telemetry.h"
+#include "argo_time.h"
 
 /* Claude Code context structure */
 typedef struct claude_code_context {
     /* Model configuration */
     char model[CLAUDE_CODE_MODEL_SIZE];
 
-    /* Response buffer */
-    char* response_content;
-    size_t response_capacity;
+    /* Conversation key; when set, queries run on a pooled session worker */
+    char session[CLAUDE_SESSION_KEY_SIZE];
 
     /* Memory digest for sundown/sunrise - disabled for CLI provider.
      * Tested and validated in Tekton - Claude reported sunset/sunrise approach
@@ -53,6 +54,23 @@ typedef struct claude_code_context {
     ci_provider_t provider;
 } claude_code_context_t;
 
+/* Output chunk - capacities grow geometrically, so a large answer is a
+ * short list and each byte is copied once in and once when joined */
+typedef struct claude_code_chunk {
+    struct claude_code_chunk* next;
+    size_t size;
+    size_t capacity;
+    char data[];
+} claude_code_chunk_t;
+
+/* Answer accumulated from the subprocess's stdout */
+typedef struct {
+    claude_code_chunk_t* head;
+    claude_code_chunk_t* tail;
+    size_t total;
+    int error;          /* E_SYSTEM_MEMORY once an append failed */
+} claude_code_output_t;
+
 /* Forward declarations */
 static int claude_code_init(ci_provider_t* provider);
 static int claude_code_connect(ci_provider_t* provider);
@@ -61,9 +79,10 @@ static int claude_code_query(ci_provider_t* provider, const char* prompt,
 static int claude_code_stream(ci_provider_t* provider, const char* prompt,
                               ci_stream_callback callback, void* userdata);
 static void claude_code_cleanup(ci_provider_t* provider);
-static int claude_code_execute_with_streaming(claude_code_context_t* ctx,
-                                               const char* prompt,
-                                               const char* augmented_prompt);
+static int claude_code_run(const char* prompt, ci_stream_callback sink, void* sink_userdata,
+                           claude_session_turn_t* turn);
+static int claude_code_session_turn(claude_code_context_t* ctx, const char* prompt, char** content,
+                                    claude_session_turn_t* turn);
 
 /* Provider creation */
 ci_provider_t* claude_code_create_provider(const char* model) {
@@ -83,19 +102,10 @@ ci_provider_t* claude_code_create_provider(const char* model) {
     /* Configure provider metadata */
     strncpy(ctx->provider.name, CLAUDE_CODE_PROVIDER_NAME, sizeof(ctx->provider.name) - 1);
     strncpy(ctx->provider.model, ctx->model, sizeof(ctx->provider.model) - 1);
-    ctx->provider.supports_streaming = true;   /* Streaming visible to user */
+    ctx->provider.supports_streaming = true;   /* Chunks as claude writes them */
     ctx->provider.supports_memory = false;     /* Memory via --continue flag */
     ctx->provider.max_context = CLAUDE_CONTEXT_WINDOW;
 
-    /* Allocate response buffer */
-    ctx->response_capacity = CLAUDE_CODE_RESPONSE_BUFFER_SIZE;
-    ctx->response_content = malloc(ctx->response_capacity);
-    if (!ctx->response_content) {
-        argo_report_error(E_SYSTEM_MEMORY, "claude_code_create_provider", "buffer allocation failed");
-        free(ctx);
-        return NULL;
-    }
-
     /* Memory digest initialization disabled - using --continue for CLI sessions */
     /* ctx->memory_digest = memory_digest_create(ctx->provider.max_context); */
     /* if (!ctx->memory_digest) { */
@@ -140,55 +150,196 @@ static int claude_code_connect(ci_provider_t* provider) {
     return ARGO_SUCCESS;
 }
 
-/* Execute claude -p with streaming output and memory augmentation */
+/* Helper: Stream sink - append bytes to the output's chunk list */
+static void output_append(const char* data, size_t len, void* userdata) {
+    claude_code_output_t* output = (claude_code_output_t*)userdata;
+
+    while (len > 0 && output->error == ARGO_SUCCESS) {
+        claude_code_chunk_t* tail = output->tail;
+        if (!tail || tail->size == tail->capacity) {
+            size_t capacity = tail ? tail->capacity * 2 : CLAUDE_CODE_CHUNK_INITIAL;
+            if (capacity > CLAUDE_CODE_CHUNK_MAX) {
+                capacity = CLAUDE_CODE_CHUNK_MAX;
+            }
+            claude_code_chunk_t* chunk = malloc(sizeof(claude_code_chunk_t) + capacity);
+            if (!chunk) {
+                output->error = E_SYSTEM_MEMORY;
+                return;
+            }
+            chunk->next = NULL;
+            chunk->size = 0;
+            chunk->capacity = capacity;
+            if (tail) {
+                tail->next = chunk;
+            } else {
+                output->head = chunk;
+            }
+            output->tail = tail = chunk;
+        }
+
+        size_t room = tail->capacity - tail->size;
+        size_t take = len < room ? len : room;
+        memcpy(tail->data + tail->size, data, take);
+        tail->size += take;
+        output->total += take;
+        data += take;
+        len -= take;
+    }
+}
+
+/* Helper: Join the chunks into one string (caller frees) */
+static char* output_join(const claude_code_output_t* output) {
+    char* text = malloc(output->total + 1);
+    if (!text) return NULL;
+
+    size_t offset = 0;
+    for (const claude_code_chunk_t* chunk = output->head; chunk; chunk = chunk->next) {
+        memcpy(text + offset, chunk->data, chunk->size);
+        offset += chunk->size;
+    }
+    text[offset] = '\0';
+    return text;
+}
+
+/* Helper: Free the chunk list */
+static void output_free(claude_code_output_t* output) {
+    claude_code_chunk_t* chunk = output->head;
+    while (chunk) {
+        claude_code_chunk_t* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    output->head = output->tail = NULL;
+}
+
+/* Helper: Record a finished call in provider telemetry
+ *
+ * One-shot runs fill turn the way a session turn does; the plain-text
+ * CLI output carries no usage, so only session turns report tokens.
+ */
+static void record_call(const claude_code_context_t* ctx, int result, bool streamed,
+                        long long started_ms, const claude_session_turn_t* turn) {
+    provider_call_t call = {
+        .provider = CLAUDE_CODE_PROVIDER_NAME,
+        .model = ctx->model,
+        .result = result,
+        .streamed = streamed,
+        .request_bytes = turn->request_bytes,
+        .response_bytes = turn->response_bytes,
+        .usage = turn->usage,
+        .queue_ms = turn->queue_ms,
+        .ttfb_ms = turn->ttfb_ms,
+        .total_ms = argo_monotonic_ms() - started_ms
+    };
+    provider_telemetry_record(&call);
+}
+
+/* Execute claude -p and deliver the whole answer */
 static int claude_code_query(ci_provider_t* provider, const char* prompt,
                              ci_response_callback callback, void* userdata) {
     ARGO_CHECK_NULL(prompt);
     ARGO_CHECK_NULL(callback);
     ARGO_GET_CONTEXT(provider, claude_code_context_t, ctx);
 
-    /* Execute with streaming - memory via --continue flag, not augmentation */
-    int result = claude_code_execute_with_streaming(ctx, prompt, prompt);
-
+    long long started_ms = argo_monotonic_ms();
+    claude_session_turn_t turn = { .ttfb_ms = -1 };
+    char* content = NULL;
+    int result;
+    if (ctx->session[0]) {
+        result = claude_code_session_turn(ctx, prompt, &content, &turn);
+    } else {
+        /* Memory via --continue flag, not augmentation */
+        claude_code_output_t output = {0};
+        result = claude_code_run(prompt, output_append, &output, &turn);
+        if (result == ARGO_SUCCESS) {
+            result = output.error;
+        }
+        if (result == ARGO_SUCCESS) {
+            content = output_join(&output);
+            result = content ? ARGO_SUCCESS : E_SYSTEM_MEMORY;
+        }
+        output_free(&output);
+    }
+    record_call(ctx, result, false, started_ms, &turn);
     if (result != ARGO_SUCCESS) {
         return result;
     }
 
     /* Build response structure */
     ci_response_t response;
-    build_ci_response(&response, true, ARGO_SUCCESS,
-                     ctx->response_content, CLAUDE_CODE_STREAMING_ID);
-
-    /* Update statistics */
-    ctx->total_queries++;
-    ctx->last_query = time(NULL);
+    build_ci_response(&response, true, ARGO_SUCCESS, content, CLAUDE_CODE_STREAMING_ID);
     ARGO_UPDATE_STATS(ctx);
 
     /* Invoke callback */
     callback(&response, userdata);
+    free(content);
 
     LOG_DEBUG("Claude Code query successful");
     return ARGO_SUCCESS;
 }
 
-/* Execute claude with streaming output visible to user */
-static int claude_code_execute_with_streaming(claude_code_context_t* ctx,
-                                               const char* prompt,
-                                               const char* augmented_prompt) {
-    (void)prompt;  /* Unused - augmented_prompt contains prompt + context */
+/* Run the prompt as the next turn of ctx->session on a long-lived worker */
+static int claude_code_session_turn(claude_code_context_t* ctx, const char* prompt, char** content,
+                                    claude_session_turn_t* turn) {
+    claude_session_pool_t* pool = claude_session_pool_default();
+    if (!pool) {
+        return E_SYSTEM_MEMORY;
+    }
+
+    /* The default model name leaves the choice to the CLI, as the one-shot path does */
+    const char* model = strcmp(ctx->model, CLAUDE_CODE_DEFAULT_MODEL) == 0 ? NULL : ctx->model;
+    int result = claude_session_pool_query(pool, ctx->session, model, prompt,
+                                           CLAUDE_SESSION_POOL_TURN_TIMEOUT_MS, content, turn);
+    if (result != ARGO_SUCCESS) {
+        argo_report_error(result, "claude_code_session_turn", "session %s", ctx->session);
+    }
+    return result;
+}
+
+/* Set the conversation the provider's queries belong to */
+int claude_code_set_session(ci_provider_t* provider, const char* session) {
+    ARGO_GET_CONTEXT(provider, claude_code_context_t, ctx);
+
+    if (session && strlen(session) >= sizeof(ctx->session)) {
+        argo_report_error(E_INPUT_TOO_LARGE, "claude_code_set_session", "session key too long");
+        return E_INPUT_TOO_LARGE;
+    }
+    snprintf(ctx->session, sizeof(ctx->session), "%s", session ? session : "");
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Write all of data to fd */
+static int write_all(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t written = write(fd, data, len);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return E_SYSTEM_PROCESS;
+        }
+        data += written;
+        len -= (size_t)written;
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Run one-shot claude -p, passing its stdout to sink as it arrives (bytes and
+ * time to first output are counted in turn) */
+static int claude_code_run(const char* prompt, ci_stream_callback sink, void* sink_userdata,
+                           claude_session_turn_t* turn) {
     int result = ARGO_SUCCESS;
     int stdin_pipe[2] = {-1, -1};
     int stdout_pipe[2] = {-1, -1};
     pid_t pid = -1;
 
-    /* Create pipes for stdin and stdout */
-    if (pipe(stdin_pipe) < 0) {
-        argo_report_error(E_SYSTEM_PROCESS, "claude_code_execute", "stdin pipe creation failed: %s", strerror(errno));
+    /* Create pipes for stdin and stdout (close-on-exec: dup2 clears it on the
+     * child's copies, and other children forked meanwhile must not inherit them) */
+    if (pipe2(stdin_pipe, O_CLOEXEC) < 0) {
+        argo_report_error(E_SYSTEM_PROCESS, "claude_code_run", "stdin pipe creation failed: %s", strerror(errno));
         return E_SYSTEM_PROCESS;
     }
 
-    if (pipe(stdout_pipe) < 0) {
-        argo_report_error(E_SYSTEM_PROCESS, "claude_code_execute", "stdout pipe creation failed: %s", strerror(errno));
+    if (pipe2(stdout_pipe, O_CLOEXEC) < 0) {
+        argo_report_error(E_SYSTEM_PROCESS, "claude_code_run", "stdout pipe creation failed: %s", strerror(errno));
         close(stdin_pipe[0]);
         close(stdin_pipe[1]);
         return E_SYSTEM_PROCESS;
@@ -197,7 +348,7 @@ static int claude_code_execute_with_streaming(claude_code_context_t* ctx,
     /* Fork subprocess */
     pid = fork();
     if (pid < 0) {
-        argo_report_error(E_SYSTEM_FORK, "claude_code_execute", "fork failed: %s", strerror(errno));
+        argo_report_error(E_SYSTEM_FORK, "claude_code_run", "fork failed: %s", strerror(errno));
         result = E_SYSTEM_FORK;
         goto cleanup_pipes;
     }
@@ -219,89 +370,71 @@ static int claude_code_execute_with_streaming(claude_code_context_t* ctx,
         /* If exec fails */
         /* GUIDELINE_APPROVED: Child process error before exit */
         fprintf(stderr, "Failed to exec claude: %s\n", strerror(errno));
-        exit(EXIT_CODE_COMMAND_NOT_FOUND);
+        _exit(EXIT_CODE_COMMAND_NOT_FOUND);
     }
 
     /* Parent process: write prompt to stdin, then read stdout */
     close(stdin_pipe[0]);
+    stdin_pipe[0] = -1;
     close(stdout_pipe[1]);
+    stdout_pipe[1] = -1;
 
-    /* Write prompt to stdin */
-    size_t prompt_len = strlen(augmented_prompt);
+    size_t prompt_len = strlen(prompt);
     LOG_DEBUG("Writing %zu bytes to Claude stdin", prompt_len);
-
-    ssize_t written = write(stdin_pipe[1], augmented_prompt, prompt_len);
-    if (written < 0 || (size_t)written != prompt_len) {
-        argo_report_error(E_SYSTEM_PROCESS, "claude_code_execute", "failed to write prompt (wrote %zd of %zu): %s",
-                         written, prompt_len, strerror(errno));
-        close(stdin_pipe[1]);
-        close(stdout_pipe[0]);
+    if (write_all(stdin_pipe[1], prompt, prompt_len) != ARGO_SUCCESS) {
+        argo_report_error(E_SYSTEM_PROCESS, "claude_code_run", "failed to write prompt: %s", strerror(errno));
         result = E_SYSTEM_PROCESS;
         goto cleanup_pipes;
     }
 
-    LOG_DEBUG("Successfully wrote prompt to stdin, closing pipe");
-
     /* Close stdin to signal EOF to Claude */
     close(stdin_pipe[1]);
+    stdin_pipe[1] = -1;
+    turn->request_bytes = prompt_len;
+    long long sent_ms = argo_monotonic_ms();
 
-    /* Read response with streaming to stdout */
+    /* Pass each read straight to the sink; nothing is buffered here */
     size_t total_read = 0;
-    ssize_t bytes_read;
     char read_buf[CLAUDE_CODE_READ_CHUNK_SIZE];
-
-    LOG_USER_INFO("\n[Claude streaming...]\n");
-    fflush(stdout);
-
-    while ((bytes_read = read(stdout_pipe[0], read_buf, sizeof(read_buf))) > 0) {
-        /* Write to stdout for user visibility */
-        size_t written = fwrite(read_buf, 1, bytes_read, stdout); /* GUIDELINE_APPROVED: stdout streaming */
-        (void)written; /* Intentionally ignore - best effort streaming to user */
-        fflush(stdout);
-
-        /* Copy to response buffer */
-        size_t space_left = ctx->response_capacity - total_read - 1;
-        size_t to_copy = (bytes_read < (ssize_t)space_left) ? bytes_read : space_left;
-
-        if (to_copy > 0) {
-            memcpy(ctx->response_content + total_read, read_buf, to_copy);
-            total_read += to_copy;
+    while (true) {
+        ssize_t bytes_read = read(stdout_pipe[0], read_buf, sizeof(read_buf));
+        if (bytes_read == 0) break;
+        if (bytes_read < 0) {
+            if (errno == EINTR) continue;
+            argo_report_error(E_SYSTEM_PROCESS, "claude_code_run", "read failed: %s", strerror(errno));
+            result = E_SYSTEM_PROCESS;
+            goto cleanup_pipes;
         }
-
-        /* Check buffer overflow */
-        if (total_read >= ctx->response_capacity - 1) {
-            LOG_WARN("Response buffer full, output truncated");
-            break;
+        if (turn->ttfb_ms < 0) {
+            turn->ttfb_ms = argo_monotonic_ms() - sent_ms;
         }
+        sink(read_buf, (size_t)bytes_read, sink_userdata);
+        total_read += (size_t)bytes_read;
+        turn->response_bytes = total_read;
     }
 
-    /* Null-terminate response */
-    ctx->response_content[total_read] = '\0';
-
-    LOG_USER_INFO("\n[End of Claude response]\n");
-    fflush(stdout);
-
-    /* Close pipe */
     close(stdout_pipe[0]);
     stdout_pipe[0] = -1;
 
     /* Wait for child */
     int status;
-    if (waitpid(pid, &status, 0) < 0) {
-        argo_report_error(E_SYSTEM_PROCESS, "claude_code_execute", "waitpid failed: %s", strerror(errno));
-        result = E_SYSTEM_PROCESS;
-        goto cleanup;
+    pid_t waited;
+    while ((waited = waitpid(pid, &status, 0)) < 0 && errno == EINTR) {
+        /* Retry */
+    }
+    if (waited < 0) {
+        argo_report_error(E_SYSTEM_PROCESS, "claude_code_run", "waitpid failed: %s", strerror(errno));
+        return E_SYSTEM_PROCESS;
     }
 
     /* Check exit status */
     if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
         int exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
-        argo_report_error(E_CI_CONFUSED, "claude_code_execute", "claude exited with code %d", exit_code);
-        result = E_CI_CONFUSED;
-        goto cleanup;
+        argo_report_error(E_CI_CONFUSED, "claude_code_run", "claude exited with code %d", exit_code);
+        return E_CI_CONFUSED;
     }
 
-    LOG_DEBUG("Claude streaming complete (%zu bytes)", total_read);
+    LOG_DEBUG("Claude output complete (%zu bytes)", total_read);
     return ARGO_SUCCESS;
 
 cleanup_pipes:
@@ -313,21 +446,39 @@ cleanup_pipes:
     if (stdin_pipe[1] >= 0) close(stdin_pipe[1]);
     if (stdout_pipe[0] >= 0) close(stdout_pipe[0]);
     if (stdout_pipe[1] >= 0) close(stdout_pipe[1]);
-
-cleanup:
     return result;
 }
 
-/* Streaming interface (same as query for Claude Code) */
+/* Stream answer chunks to callback as claude writes them */
 static int claude_code_stream(ci_provider_t* provider, const char* prompt,
                               ci_stream_callback callback, void* userdata) {
-    /* For Claude Code, streaming is built into query */
-    (void)callback;
-    (void)userdata;
+    ARGO_CHECK_NULL(prompt);
+    ARGO_CHECK_NULL(callback);
+    ARGO_GET_CONTEXT(provider, claude_code_context_t, ctx);
 
-    /* Just use the query interface which already streams */
-    return claude_code_query(provider, prompt,
-                            (ci_response_callback)callback, userdata);
+    long long started_ms = argo_monotonic_ms();
+    claude_session_turn_t turn = { .ttfb_ms = -1 };
+    int result;
+    if (ctx->session[0]) {
+        /* A session turn is answered by one result frame */
+        char* content = NULL;
+        result = claude_code_session_turn(ctx, prompt, &content, &turn);
+        record_call(ctx, result, true, started_ms, &turn);
+        if (result == ARGO_SUCCESS) {
+            callback(content, strlen(content), userdata);
+            free(content);
+        }
+    } else {
+        result = claude_code_run(prompt, callback, userdata, &turn);
+        record_call(ctx, result, true, started_ms, &turn);
+    }
+    if (result != ARGO_SUCCESS) {
+        return result;
+    }
+
+    ARGO_UPDATE_STATS(ctx);
+    LOG_DEBUG("Claude Code stream successful");
+    return ARGO_SUCCESS;
 }
 
 /* Cleanup provider */
@@ -342,7 +493,6 @@ static void claude_code_cleanup(ci_provider_t* provider) {
     /*     memory_digest_destroy(ctx->memory_digest); */
     /* } */
 
-    free(ctx->response_content);
     free(ctx);
 
     LOG_DEBUG("Claude Code provider cleaned up");
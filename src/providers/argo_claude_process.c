@@ -1,5 +1,11 @@
 /* © 2025 Casey Koons All rights reserved */
 
+/* Claude process - long-lived CLI subprocess with line-framed pipes */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* pthread_sigmask(), sigtimedwait() */
+#endif
+
 /* System includes */
 #include <stdio.h>
 #include <stdlib.h>
@@ -10,6 +16,8 @@
 #include <sys/wait.h>
 #include <fcntl.h>
 #include <signal.h>
+#include <pthread.h>
+#include <time.h>
 
 /* Project includes */
 #include "argo_claude_process.h"
@@ -17,14 +25,47 @@
 #include "argo_error_messages.h"
 #include "argo_log.h"
 #include "argo_limits.h"
+#include "argo_time.h"
+
+/* Grace period between SIGTERM and SIGKILL */
+#define CLAUDE_PROCESS_KILL_WAIT_MS 1000
+#define CLAUDE_PROCESS_KILL_POLL_MS 10
+
+/* Helper: Close fd if open and mark it closed */
+static void close_fd(int* fd) {
+    if (*fd >= 0) {
+        close(*fd);
+        *fd = -1;
+    }
+}
+
+/* Helper: Close every pipe end */
+static void close_pipes(claude_context_t* ctx) {
+    close_fd(&ctx->stdin_pipe[0]);
+    close_fd(&ctx->stdin_pipe[1]);
+    close_fd(&ctx->stdout_pipe[0]);
+    close_fd(&ctx->stdout_pipe[1]);
+    close_fd(&ctx->stderr_pipe[0]);
+    close_fd(&ctx->stderr_pipe[1]);
+}
 
 /* Spawn Claude subprocess */
-int spawn_claude_process(claude_context_t* ctx) {
-    /* Create pipes */
-    if (pipe(ctx->stdin_pipe) < 0 ||
-        pipe(ctx->stdout_pipe) < 0 ||
-        pipe(ctx->stderr_pipe) < 0) {
+int spawn_claude_process(claude_context_t* ctx, char* const argv[]) {
+    static char* const default_argv[] = { "claude", NULL };
+    if (!argv) argv = default_argv;
+
+    ctx->stdin_pipe[0] = ctx->stdin_pipe[1] = -1;
+    ctx->stdout_pipe[0] = ctx->stdout_pipe[1] = -1;
+    ctx->stderr_pipe[0] = ctx->stderr_pipe[1] = -1;
+    ctx->response_size = 0;
+    ctx->frame_size = 0;
+
+    /* Create pipes (close-on-exec, so other children never inherit them) */
+    if (pipe2(ctx->stdin_pipe, O_CLOEXEC) < 0 ||
+        pipe2(ctx->stdout_pipe, O_CLOEXEC) < 0 ||
+        pipe2(ctx->stderr_pipe, O_CLOEXEC) < 0) {
         argo_report_error(E_SYSTEM_FORK, "spawn_claude_process", ERR_FMT_SYSCALL_ERROR, ERR_MSG_PIPE_FAILED, strerror(errno));
+        close_pipes(ctx);
         return E_SYSTEM_FORK;
     }
 
@@ -32,37 +73,31 @@ int spawn_claude_process(claude_context_t* ctx) {
     ctx->claude_pid = fork();
     if (ctx->claude_pid < 0) {
         argo_report_error(E_SYSTEM_FORK, "spawn_claude_process", ERR_FMT_SYSCALL_ERROR, ERR_MSG_FORK_FAILED, strerror(errno));
+        close_pipes(ctx);
         return E_SYSTEM_FORK;
     }
 
     if (ctx->claude_pid == 0) {
-        /* Child process - become Claude */
-
-        /* Redirect stdin/stdout/stderr */
+        /* Child process - become Claude (dup2 clears close-on-exec) */
         dup2(ctx->stdin_pipe[0], STDIN_FILENO);
         dup2(ctx->stdout_pipe[1], STDOUT_FILENO);
         dup2(ctx->stderr_pipe[1], STDERR_FILENO);
 
-        /* Close unused pipe ends */
-        close(ctx->stdin_pipe[1]);
-        close(ctx->stdout_pipe[0]);
-        close(ctx->stderr_pipe[0]);
-
         /* Execute Claude */
-        execlp("claude", "claude", NULL);
+        execvp(argv[0], argv);
 
         /* If we get here, exec failed */
         /* GUIDELINE_APPROVED: Child process error before exit, stderr redirected to pipe */
         fprintf(stderr, CLAUDE_EXEC_FAILED_MSG "%s\n", strerror(errno));
-        exit(1);
+        _exit(EXIT_CODE_COMMAND_NOT_FOUND);
     }
 
     /* Parent process - close unused pipe ends */
-    close(ctx->stdin_pipe[0]);
-    close(ctx->stdout_pipe[1]);
-    close(ctx->stderr_pipe[1]);
+    close_fd(&ctx->stdin_pipe[0]);
+    close_fd(&ctx->stdout_pipe[1]);
+    close_fd(&ctx->stderr_pipe[1]);
 
-    /* Make pipes non-blocking */
+    /* Reads are polled; writes block until Claude takes the input */
     fcntl(ctx->stdout_pipe[0], F_SETFL, O_NONBLOCK);
     fcntl(ctx->stderr_pipe[0], F_SETFL, O_NONBLOCK);
 
@@ -72,66 +107,166 @@ int spawn_claude_process(claude_context_t* ctx) {
 
 /* Kill Claude process */
 int kill_claude_process(claude_context_t* ctx) {
+    /* Closing stdin lets Claude finish on its own */
+    close_pipes(ctx);
     if (ctx->claude_pid <= 0) {
         return ARGO_SUCCESS;
     }
 
-    /* Send SIGTERM */
     kill(ctx->claude_pid, SIGTERM);
 
-    /* Wait for process to exit */
-    int status;
-    waitpid(ctx->claude_pid, &status, 0);
-
-    /* Close pipes */
-    if (ctx->stdin_pipe[1] >= 0) close(ctx->stdin_pipe[1]);
-    if (ctx->stdout_pipe[0] >= 0) close(ctx->stdout_pipe[0]);
-    if (ctx->stderr_pipe[0] >= 0) close(ctx->stderr_pipe[0]);
+    /* Wait for exit; the daemon's SIGCHLD handler may reap it first */
+    long long give_up = argo_monotonic_ms() + CLAUDE_PROCESS_KILL_WAIT_MS;
+    struct timespec pause = { 0, CLAUDE_PROCESS_KILL_POLL_MS * NANOSECONDS_PER_MILLISECOND };
+    while (waitpid(ctx->claude_pid, NULL, WNOHANG) == 0) {
+        if (argo_monotonic_ms() >= give_up) {
+            kill(ctx->claude_pid, SIGKILL);
+            waitpid(ctx->claude_pid, NULL, 0);
+            break;
+        }
+        nanosleep(&pause, NULL);
+    }
 
     ctx->claude_pid = -1;
     LOG_DEBUG("Claude process terminated");
     return ARGO_SUCCESS;
 }
 
+/* True if the subprocess is still running */
+bool claude_process_alive(claude_context_t* ctx) {
+    if (!ctx || ctx->claude_pid <= 0) return false;
+
+    /* 0 = still running; anything else means it exited or was reaped */
+    if (waitpid(ctx->claude_pid, NULL, WNOHANG) == 0) {
+        return true;
+    }
+    ctx->claude_pid = -1;
+    return false;
+}
+
+/* Helper: Write all of data */
+static int write_all(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t written = write(fd, data, len);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return errno == EPIPE ? E_CI_DISCONNECTED : E_SYSTEM_SOCKET;
+        }
+        data += written;
+        len -= (size_t)written;
+    }
+    return ARGO_SUCCESS;
+}
+
 /* Write input to Claude */
 int write_to_claude(claude_context_t* ctx, const char* input) {
-    size_t len = strlen(input);
-    ssize_t written = write(ctx->stdin_pipe[1], input, len);
-    if (written != (ssize_t)len) {
-        return E_SYSTEM_SOCKET;
+    if (ctx->stdin_pipe[1] < 0) {
+        return E_CI_DISCONNECTED;
+    }
+
+    /* A dead process must not take the caller down with SIGPIPE */
+    sigset_t pipe_set;
+    sigset_t old_set;
+    sigemptyset(&pipe_set);
+    sigaddset(&pipe_set, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipe_set, &old_set);
+
+    int result = write_all(ctx->stdin_pipe[1], input, strlen(input));
+    if (result == ARGO_SUCCESS) {
+        result = write_all(ctx->stdin_pipe[1], "\n", 1);
     }
-    write(ctx->stdin_pipe[1], "\n", 1);
+    if (result == E_CI_DISCONNECTED) {
+        struct timespec no_wait = { 0, 0 };
+        sigtimedwait(&pipe_set, NULL, &no_wait);
+    }
+
+    pthread_sigmask(SIG_SETMASK, &old_set, NULL);
+    return result;
+}
+
+/* Helper: Discard whatever Claude wrote to stderr */
+static void drain_stderr(claude_context_t* ctx) {
+    char buffer[ARGO_BUFFER_STANDARD];
+    ssize_t bytes;
+    while ((bytes = read(ctx->stderr_pipe[0], buffer, sizeof(buffer) - 1)) > 0) {
+        buffer[bytes] = '\0';
+        LOG_DEBUG("Claude stderr: %s", buffer);
+    }
+    if (bytes == 0) {
+        close_fd(&ctx->stderr_pipe[0]);
+    }
+}
+
+/* Helper: Room for one more read chunk */
+static int reserve_buffer(claude_context_t* ctx) {
+    if (ctx->response_buffer && ctx->response_size + CLAUDE_CODE_READ_CHUNK_SIZE < ctx->response_capacity) {
+        return ARGO_SUCCESS;
+    }
+    size_t capacity = ctx->response_capacity ? ctx->response_capacity * 2 : CLAUDE_PROCESS_BUFFER_INITIAL;
+    while (capacity <= ctx->response_size + CLAUDE_CODE_READ_CHUNK_SIZE) {
+        capacity *= 2;
+    }
+    char* grown = realloc(ctx->response_buffer, capacity);
+    if (!grown) {
+        return E_SYSTEM_MEMORY;
+    }
+    ctx->response_buffer = grown;
+    ctx->response_capacity = capacity;
     return ARGO_SUCCESS;
 }
 
 /* Read response from Claude */
 int read_from_claude(claude_context_t* ctx, char** output, int timeout_ms) {
-    /* Poll for response */
-    struct pollfd pfd = {
-        .fd = ctx->stdout_pipe[0],
-        .events = POLLIN
-    };
-
-    /* Simple implementation - real version would accumulate response */
-    if (poll(&pfd, 1, timeout_ms) <= 0) {
-        return E_CI_TIMEOUT;
+    /* Drop the frame handed out last time */
+    if (ctx->frame_size > 0) {
+        ctx->response_size -= ctx->frame_size;
+        memmove(ctx->response_buffer, ctx->response_buffer + ctx->frame_size, ctx->response_size);
+        ctx->frame_size = 0;
     }
 
-    ctx->response_size = 0;
-    char buffer[ARGO_BUFFER_STANDARD];
-    ssize_t bytes;
+    long long deadline = argo_monotonic_ms() + timeout_ms;
+    while (true) {
+        char* newline = ctx->response_buffer ? memchr(ctx->response_buffer, '\n', ctx->response_size) : NULL;
+        if (newline) {
+            *newline = '\0';
+            ctx->frame_size = (size_t)(newline - ctx->response_buffer) + 1;
+            *output = ctx->response_buffer;
+            return ARGO_SUCCESS;
+        }
 
-    while ((bytes = read(ctx->stdout_pipe[0], buffer, sizeof(buffer) - 1)) > 0) {
-        /* Grow response buffer if needed */
-        if (ctx->response_size + bytes >= ctx->response_capacity) {
-            ctx->response_capacity *= 2;
-            ctx->response_buffer = realloc(ctx->response_buffer, ctx->response_capacity);
+        if (reserve_buffer(ctx) != ARGO_SUCCESS) {
+            return E_SYSTEM_MEMORY;
+        }
+        long long remaining = deadline - argo_monotonic_ms();
+        if (remaining <= 0) {
+            return E_CI_TIMEOUT;
+        }
+        if (ctx->stdout_pipe[0] < 0) {
+            return E_CI_DISCONNECTED;
         }
-        memcpy(ctx->response_buffer + ctx->response_size, buffer, bytes);
-        ctx->response_size += bytes;
-    }
 
-    ctx->response_buffer[ctx->response_size] = '\0';
-    *output = ctx->response_buffer;
-    return ARGO_SUCCESS;
+        struct pollfd fds[2] = {
+            { .fd = ctx->stdout_pipe[0], .events = POLLIN },
+            { .fd = ctx->stderr_pipe[0], .events = POLLIN }     /* Ignored by poll when -1 */
+        };
+        int ready = poll(fds, 2, (int)remaining);
+        if (ready < 0 && errno != EINTR) {
+            return E_SYSTEM_SOCKET;
+        }
+        if (ready <= 0) continue;
+
+        if (fds[1].revents) {
+            drain_stderr(ctx);
+        }
+        if (fds[0].revents) {
+            ssize_t bytes = read(ctx->stdout_pipe[0], ctx->response_buffer + ctx->response_size,
+                                 ctx->response_capacity - ctx->response_size - 1);
+            if (bytes == 0 || (bytes < 0 && errno != EAGAIN && errno != EINTR)) {
+                return E_CI_DISCONNECTED;
+            }
+            if (bytes > 0) {
+                ctx->response_size += (size_t)bytes;
+            }
+        }
+    }
 }
@@ -0,0 +1,565 @@
+/* © 2025 Casey Koons All rights reserved */
+
+/* Claude session pool - long-lived claude CLI workers with session affinity */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* clock_gettime() */
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+/* Project includes */
+#include "argo_claude_session_pool.h"
+#include "argo_claude_process.h"
+#include "argo_api_providers.h"
+#include "argo_json_builder.h"
+#include "argo_json_doc.h"
+#include "argo_config.h"
+#include "argo_env_utils.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_log.h"
+#include "argo_limits.h"
+#include "argo_time.h"
+
+/* Base command words kept, plus --model m --resume id NULL */
+#define CLAUDE_SESSION_COMMAND_MAX 32
+#define CLAUDE_SESSION_EXTRA_ARGS 5
+
+/* One claude process and the session it serves */
+typedef struct claude_worker {
+    claude_context_t process;               /* claude_pid <= 0 when stopped */
+    char session[CLAUDE_SESSION_KEY_SIZE];
+    char model[CLAUDE_CODE_MODEL_SIZE];     /* "" = CLI default */
+    int turns;                              /* On the current process */
+    bool busy;
+    bool restart;                           /* Stop the process before the next turn */
+    time_t last_used;
+    struct claude_worker* next;
+} claude_worker_t;
+
+/* CLI session id of a conversation, for --resume after recycling */
+typedef struct {
+    char session[CLAUDE_SESSION_KEY_SIZE];
+    char id[CLAUDE_SESSION_ID_SIZE];
+    unsigned long long used;                /* LRU tick, 0 = free */
+} resume_slot_t;
+
+struct claude_session_pool {
+    pthread_mutex_t lock;       /* Guards everything below */
+    pthread_cond_t idle;        /* A worker finished a turn */
+    char** command;
+    int command_count;
+    int max_workers;
+    int max_turns;
+    claude_worker_t* workers;
+    int worker_count;
+    resume_slot_t resume[CLAUDE_SESSION_POOL_RESUME_SLOTS];
+    unsigned long long tick;
+    claude_session_pool_stats_t stats;
+};
+
+static claude_session_pool_t* g_default_pool = NULL;
+static pthread_mutex_t g_default_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Helper: Positive integer from config, then environment */
+static int config_int(const char* config_key, const char* env_name, int fallback) {
+    const char* sources[] = { argo_config_get(config_key), argo_getenv(env_name) };
+
+    for (size_t i = 0; i < sizeof(sources) / sizeof(sources[0]); i++) {
+        if (!sources[i] || !*sources[i]) continue;
+        int value = atoi(sources[i]);
+        if (value > 0) {
+            return value;
+        }
+        LOG_WARN("Ignoring invalid %s: %s", config_key, sources[i]);
+    }
+    return fallback;
+}
+
+/* Helper: Resume slot for session (caller holds lock) */
+static resume_slot_t* find_resume(claude_session_pool_t* pool, const char* session) {
+    for (int i = 0; i < CLAUDE_SESSION_POOL_RESUME_SLOTS; i++) {
+        if (pool->resume[i].used && strcmp(pool->resume[i].session, session) == 0) {
+            return &pool->resume[i];
+        }
+    }
+    return NULL;
+}
+
+/* Helper: Remember the CLI session id, replacing the oldest slot (caller holds lock) */
+static void remember_resume(claude_session_pool_t* pool, const char* session, const char* id) {
+    resume_slot_t* slot = find_resume(pool, session);
+    if (!slot) {
+        slot = &pool->resume[0];
+        for (int i = 1; i < CLAUDE_SESSION_POOL_RESUME_SLOTS; i++) {
+            if (pool->resume[i].used < slot->used) {
+                slot = &pool->resume[i];
+            }
+        }
+    }
+    snprintf(slot->session, sizeof(slot->session), "%s", session);
+    snprintf(slot->id, sizeof(slot->id), "%s", id);
+    slot->used = ++pool->tick;
+}
+
+/* Helper: New stopped worker */
+static claude_worker_t* worker_new(void) {
+    claude_worker_t* worker = calloc(1, sizeof(claude_worker_t));
+    if (!worker) return NULL;
+    worker->process.claude_pid = -1;
+    worker->process.stdin_pipe[0] = worker->process.stdin_pipe[1] = -1;
+    worker->process.stdout_pipe[0] = worker->process.stdout_pipe[1] = -1;
+    worker->process.stderr_pipe[0] = worker->process.stderr_pipe[1] = -1;
+    return worker;
+}
+
+/* Helper: Stop and free worker (not in the list) */
+static void worker_free(claude_worker_t* worker) {
+    kill_claude_process(&worker->process);
+    free(worker->process.response_buffer);
+    free(worker);
+}
+
+/* Create pool */
+claude_session_pool_t* claude_session_pool_create(const char* const* command, int max_workers,
+                                                  int max_turns) {
+    static const char* const default_command[] = {
+        CLAUDE_CLI_COMMAND, CLAUDE_CLI_ARG_PIPE,
+        CLAUDE_SESSION_ARG_INPUT_FORMAT, CLAUDE_SESSION_FORMAT_STREAM_JSON,
+        CLAUDE_SESSION_ARG_OUTPUT_FORMAT, CLAUDE_SESSION_FORMAT_STREAM_JSON,
+        CLAUDE_SESSION_ARG_VERBOSE, NULL
+    };
+    if (!command) command = default_command;
+
+    claude_session_pool_t* pool = calloc(1, sizeof(claude_session_pool_t));
+    if (!pool) {
+        argo_report_error(E_SYSTEM_MEMORY, "claude_session_pool_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return NULL;
+    }
+
+    while (command[pool->command_count]) pool->command_count++;
+    pool->command = calloc((size_t)pool->command_count + 1, sizeof(char*));
+    for (int i = 0; pool->command && i < pool->command_count; i++) {
+        pool->command[i] = strdup(command[i]);
+        if (!pool->command[i]) {
+            pool->command_count = i;
+            claude_session_pool_destroy(pool);
+            argo_report_error(E_SYSTEM_MEMORY, "claude_session_pool_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+            return NULL;
+        }
+    }
+    if (!pool->command) {
+        free(pool);
+        argo_report_error(E_SYSTEM_MEMORY, "claude_session_pool_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return NULL;
+    }
+
+    if (max_workers <= 0) {
+        max_workers = config_int(CLAUDE_SESSION_WORKERS_CONFIG_KEY, CLAUDE_SESSION_WORKERS_ENV,
+                                 CLAUDE_SESSION_POOL_DEFAULT_WORKERS);
+    }
+    if (max_turns <= 0) {
+        max_turns = config_int(CLAUDE_SESSION_MAX_TURNS_CONFIG_KEY, CLAUDE_SESSION_MAX_TURNS_ENV,
+                               CLAUDE_SESSION_POOL_DEFAULT_MAX_TURNS);
+    }
+    pool->max_workers = max_workers < CLAUDE_SESSION_POOL_MAX_WORKERS ? max_workers : CLAUDE_SESSION_POOL_MAX_WORKERS;
+    pool->max_turns = max_turns;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->idle, NULL);
+    return pool;
+}
+
+/* Destroy pool */
+void claude_session_pool_destroy(claude_session_pool_t* pool) {
+    if (!pool) return;
+
+    claude_worker_t* worker = pool->workers;
+    while (worker) {
+        claude_worker_t* next = worker->next;
+        worker_free(worker);
+        worker = next;
+    }
+    for (int i = 0; pool->command && i < pool->command_count; i++) {
+        free(pool->command[i]);
+    }
+    free(pool->command);
+    pthread_cond_destroy(&pool->idle);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+/* Helper: Wait for a worker to go idle; false once deadline passes (caller holds lock) */
+static bool wait_idle(claude_session_pool_t* pool, long long deadline) {
+    long long remaining = deadline - argo_monotonic_ms();
+    if (remaining <= 0) return false;
+
+    struct timespec until;
+    clock_gettime(CLOCK_REALTIME, &until);
+    until.tv_sec += remaining / MILLISECONDS_PER_SECOND;
+    until.tv_nsec += (long)(remaining % MILLISECONDS_PER_SECOND) * NANOSECONDS_PER_MILLISECOND;
+    if (until.tv_nsec >= NANOSECONDS_PER_MILLISECOND * MILLISECONDS_PER_SECOND) {
+        until.tv_sec++;
+        until.tv_nsec -= NANOSECONDS_PER_MILLISECOND * MILLISECONDS_PER_SECOND;
+    }
+    pthread_cond_timedwait(&pool->idle, &pool->lock, &until);
+    return true;
+}
+
+/* Helper: Claim a worker for session (caller holds lock)
+ *
+ * Prefers the session's own worker, then a new one, then the least
+ * recently used idle worker of another session.
+ */
+static int claim_worker(claude_session_pool_t* pool, const char* session, const char* model,
+                        long long deadline, claude_worker_t** claimed) {
+    while (true) {
+        claude_worker_t* own = NULL;
+        claude_worker_t* victim = NULL;
+        for (claude_worker_t* worker = pool->workers; worker; worker = worker->next) {
+            if (strcmp(worker->session, session) == 0) {
+                own = worker;
+                break;
+            }
+            if (!worker->busy && (!victim || worker->last_used < victim->last_used)) {
+                victim = worker;
+            }
+        }
+
+        claude_worker_t* worker = NULL;
+        if (own) {
+            worker = own->busy ? NULL : own;    /* Turns of one session run in order */
+        } else if (pool->worker_count < pool->max_workers) {
+            worker = worker_new();
+            if (!worker) {
+                return E_SYSTEM_MEMORY;
+            }
+            worker->next = pool->workers;
+            pool->workers = worker;
+            pool->worker_count++;
+        } else if (victim) {
+            worker = victim;
+            worker->restart = true;             /* Holds another conversation */
+        }
+
+        if (worker) {
+            if (strcmp(worker->model, model) != 0) {
+                worker->restart = true;
+            }
+            snprintf(worker->session, sizeof(worker->session), "%s", session);
+            snprintf(worker->model, sizeof(worker->model), "%s", model);
+            worker->busy = true;
+            *claimed = worker;
+            return ARGO_SUCCESS;
+        }
+        if (!wait_idle(pool, deadline)) {
+            return E_CI_TIMEOUT;
+        }
+    }
+}
+
+/* Helper: Start the worker's process, resuming the session if known */
+static int start_worker(claude_session_pool_t* pool, claude_worker_t* worker, const char* session,
+                        const char* resume_id) {
+    char* argv[CLAUDE_SESSION_COMMAND_MAX + CLAUDE_SESSION_EXTRA_ARGS];
+    int argc = 0;
+    for (int i = 0; i < pool->command_count && i < CLAUDE_SESSION_COMMAND_MAX; i++) {
+        argv[argc++] = pool->command[i];
+    }
+    if (worker->model[0]) {
+        argv[argc++] = CLAUDE_SESSION_ARG_MODEL;
+        argv[argc++] = worker->model;
+    }
+    if (resume_id[0]) {
+        argv[argc++] = CLAUDE_SESSION_ARG_RESUME;
+        argv[argc++] = (char*)resume_id;
+    }
+    argv[argc] = NULL;
+
+    worker->turns = 0;
+    int result = spawn_claude_process(&worker->process, argv);
+    if (result == ARGO_SUCCESS) {
+        LOG_INFO("Claude session %s: worker %d started%s", session,
+                 worker->process.claude_pid, resume_id[0] ? " (resumed)" : "");
+    }
+    return result;
+}
+
+/* Helper: Request line {"type":"user","message":{"role":"user","content":prompt}} */
+static char* build_turn(const char* prompt) {
+    json_builder_t json;
+    if (json_builder_init(&json, strlen(prompt) + ARGO_BUFFER_SMALL) != ARGO_SUCCESS) {
+        return NULL;
+    }
+    json_builder_object_begin(&json);
+    json_builder_key_string(&json, "type", "user");
+    json_builder_key(&json, "message");
+    json_builder_object_begin(&json);
+    json_builder_key_string(&json, "role", "user");
+    json_builder_key_string(&json, "content", prompt);
+    json_builder_object_end(&json);
+    json_builder_object_end(&json);
+    return json_builder_take(&json, NULL);
+}
+
+/* Helper: Read frames until the turn's result (other frames are progress) */
+static int read_result(claude_worker_t* worker, const char* session, long long deadline,
+                       char** response, char* session_id, claude_session_turn_t* turn) {
+    long long sent_ms = argo_monotonic_ms();
+    while (true) {
+        long long remaining = deadline - argo_monotonic_ms();
+        if (remaining <= 0) {
+            return E_CI_TIMEOUT;
+        }
+
+        char* line = NULL;
+        int result = read_from_claude(&worker->process, &line, (int)remaining);
+        if (result != ARGO_SUCCESS) {
+            return result;
+        }
+        if (turn->ttfb_ms < 0) {
+            turn->ttfb_ms = argo_monotonic_ms() - sent_ms;
+        }
+        turn->response_bytes += strlen(line) + 1;      /* Newline included */
+
+        json_node_t* frame = NULL;
+        if (json_doc_parse(line, strlen(line), &frame) != ARGO_SUCCESS) {
+            json_doc_free(frame);
+            continue;       /* Not a protocol line */
+        }
+        json_node_t* type = json_doc_get(frame, "/type");
+        if (!type || type->type != JSON_DOC_STRING || strcmp(type->text, CLAUDE_SESSION_TYPE_RESULT) != 0) {
+            json_doc_free(frame);
+            continue;
+        }
+
+        provider_usage_read(frame, &turn->usage);
+        json_node_t* id = json_doc_get(frame, "/session_id");
+        if (id && id->type == JSON_DOC_STRING) {
+            snprintf(session_id, CLAUDE_SESSION_ID_SIZE, "%s", id->text);
+        }
+        json_node_t* is_error = json_doc_get(frame, "/is_error");
+        json_node_t* text = json_doc_get(frame, "/result");
+        if ((is_error && is_error->type == JSON_DOC_BOOL && is_error->boolean) ||
+            !text || text->type != JSON_DOC_STRING) {
+            LOG_WARN("Claude session %s: turn failed", session);
+            json_doc_free(frame);
+            return E_CI_CONFUSED;
+        }
+        *response = strdup(text->text);
+        json_doc_free(frame);
+        return *response ? ARGO_SUCCESS : E_SYSTEM_MEMORY;
+    }
+}
+
+/* Run one turn of a session */
+int claude_session_pool_query(claude_session_pool_t* pool, const char* session, const char* model,
+                              const char* prompt, int timeout_ms, char** response,
+                              claude_session_turn_t* turn) {
+    ARGO_CHECK_NULL(pool);
+    ARGO_CHECK_NULL(session);
+    ARGO_CHECK_NULL(prompt);
+    ARGO_CHECK_NULL(response);
+    *response = NULL;
+
+    claude_session_turn_t unused;
+    if (!turn) turn = &unused;
+    memset(turn, 0, sizeof(*turn));
+    turn->ttfb_ms = -1;
+
+    if (timeout_ms <= 0) timeout_ms = CLAUDE_SESSION_POOL_TURN_TIMEOUT_MS;
+    long long started_ms = argo_monotonic_ms();
+    long long deadline = started_ms + timeout_ms;
+    claude_worker_t* worker = NULL;
+    char resume_id[CLAUDE_SESSION_ID_SIZE] = "";
+    char session_id[CLAUDE_SESSION_ID_SIZE] = "";
+    char* line = NULL;
+    bool restart = false;
+    bool spawned = false;
+    bool recycled = false;
+
+    pthread_mutex_lock(&pool->lock);
+    int result = claim_worker(pool, session, model ? model : "", deadline, &worker);
+    if (result == ARGO_SUCCESS) {
+        restart = worker->restart;
+        worker->restart = false;
+        resume_slot_t* slot = find_resume(pool, session);
+        if (slot) {
+            snprintf(resume_id, sizeof(resume_id), "%s", slot->id);
+            slot->used = ++pool->tick;
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    if (result != ARGO_SUCCESS) {
+        return result;
+    }
+
+    /* Health check: replace a process that exited or must not be reused */
+    bool warm = !restart && claude_process_alive(&worker->process);
+    if (!warm) {
+        kill_claude_process(&worker->process);
+        result = start_worker(pool, worker, session, resume_id);
+        if (result != ARGO_SUCCESS) {
+            goto done;
+        }
+        spawned = true;
+    }
+
+    line = build_turn(prompt);
+    if (!line) {
+        result = E_SYSTEM_MEMORY;
+        goto done;
+    }
+    turn->queue_ms = argo_monotonic_ms() - started_ms;
+    turn->request_bytes = strlen(line) + 1;             /* Newline included */
+    result = write_to_claude(&worker->process, line);
+    if (result == ARGO_SUCCESS) {
+        result = read_result(worker, session, deadline, response, session_id, turn);
+    }
+
+done:
+    free(line);
+    worker->turns++;
+
+    /* A failed turn leaves the stream in an unknown state */
+    if (worker->process.claude_pid > 0 &&
+        (result != ARGO_SUCCESS || worker->turns >= pool->max_turns)) {
+        kill_claude_process(&worker->process);
+        recycled = true;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    if (session_id[0]) {
+        remember_resume(pool, session, session_id);
+    }
+    if (spawned) pool->stats.spawns++;
+    if (recycled) pool->stats.recycles++;
+    if (result == ARGO_SUCCESS) {
+        pool->stats.turns++;
+        if (warm) pool->stats.warm_turns++;
+    } else {
+        pool->stats.failures++;
+    }
+    worker->busy = false;
+    worker->last_used = time(NULL);
+    pthread_cond_broadcast(&pool->idle);
+    pthread_mutex_unlock(&pool->lock);
+    return result;
+}
+
+/* Helper: Unlink worker from the list (caller holds lock) */
+static void unlink_worker(claude_session_pool_t* pool, claude_worker_t* worker) {
+    claude_worker_t** link = &pool->workers;
+    while (*link && *link != worker) link = &(*link)->next;
+    if (*link) {
+        *link = worker->next;
+        pool->worker_count--;
+    }
+}
+
+/* Forget a session */
+void claude_session_pool_end(claude_session_pool_t* pool, const char* session) {
+    if (!pool || !session) return;
+
+    claude_worker_t* stopped = NULL;
+    pthread_mutex_lock(&pool->lock);
+    resume_slot_t* slot = find_resume(pool, session);
+    if (slot) {
+        memset(slot, 0, sizeof(*slot));
+    }
+    for (claude_worker_t* worker = pool->workers; worker; worker = worker->next) {
+        if (strcmp(worker->session, session) != 0) continue;
+        if (worker->busy) {
+            worker->session[0] = '\0';  /* Unclaimable once the turn ends */
+            worker->restart = true;
+        } else {
+            unlink_worker(pool, worker);
+            stopped = worker;
+        }
+        break;
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    if (stopped) {
+        worker_free(stopped);
+    }
+}
+
+/* Stop idle and dead workers */
+int claude_session_pool_reap(claude_session_pool_t* pool, int idle_seconds) {
+    if (!pool) return 0;
+    if (idle_seconds <= 0) idle_seconds = CLAUDE_SESSION_POOL_DEFAULT_IDLE_SECONDS;
+
+    claude_worker_t* stopped = NULL;
+    time_t now = time(NULL);
+    pthread_mutex_lock(&pool->lock);
+    claude_worker_t* worker = pool->workers;
+    while (worker) {
+        claude_worker_t* next = worker->next;
+        if (!worker->busy && (now - worker->last_used >= idle_seconds ||
+                              !claude_process_alive(&worker->process))) {
+            unlink_worker(pool, worker);
+            worker->next = stopped;
+            stopped = worker;
+            pool->stats.recycles++;
+        }
+        worker = next;
+    }
+    pthread_cond_broadcast(&pool->idle);
+    pthread_mutex_unlock(&pool->lock);
+
+    int count = 0;
+    while (stopped) {
+        claude_worker_t* next = stopped->next;
+        worker_free(stopped);
+        stopped = next;
+        count++;
+    }
+    if (count > 0) {
+        LOG_DEBUG("Claude session pool: stopped %d idle workers", count);
+    }
+    return count;
+}
+
+/* Snapshot of counters */
+void claude_session_pool_get_stats(claude_session_pool_t* pool, claude_session_pool_stats_t* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    *stats = pool->stats;
+    stats->workers = 0;
+    stats->busy = 0;
+    for (claude_worker_t* worker = pool->workers; worker; worker = worker->next) {
+        /* A busy worker's process belongs to its turn; it is running or starting */
+        if (worker->busy || worker->process.claude_pid > 0) stats->workers++;
+        if (worker->busy) stats->busy++;
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/* Process-wide pool */
+claude_session_pool_t* claude_session_pool_default(void) {
+    pthread_mutex_lock(&g_default_pool_lock);
+    if (!g_default_pool) {
+        g_default_pool = claude_session_pool_create(NULL, 0, 0);
+    }
+    claude_session_pool_t* pool = g_default_pool;
+    pthread_mutex_unlock(&g_default_pool_lock);
+    return pool;
+}
+
+/* Destroy the process-wide pool */
+void claude_session_pool_cleanup(void) {
+    pthread_mutex_lock(&g_default_pool_lock);
+    claude_session_pool_destroy(g_default_pool);
+    g_default_pool = NULL;
+    pthread_mutex_unlock(&g_default_pool_lock);
+}
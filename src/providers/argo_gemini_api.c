@@ -10,24 +10,35 @@
 #include "argo_api_providers.h"
 #include "argo_api_keys.h"
 #include "argo_api_common.h"
+#include "argo_stream_decoder.h"
 
 /* Gemini-specific JSON request builder */
-static int gemini_build_request(char* json_body, size_t buffer_size,
-                                const char* model, const char* prompt) {
-    (void)model;  /* Model is in URL, not request body */
-    return snprintf(json_body, buffer_size,
-                   "{" /* GUIDELINE_APPROVED: Gemini API JSON template */
-                   "\"contents\":[{" /* GUIDELINE_APPROVED: Gemini API JSON template */
-                   "\"parts\":[{" /* GUIDELINE_APPROVED: Gemini API JSON template */
-                   "\"text\":\"%s\"" /* GUIDELINE_APPROVED: Gemini API JSON template */
-                   "}]" /* GUIDELINE_APPROVED: Gemini API JSON template */
-                   "}]," /* GUIDELINE_APPROVED: Gemini API JSON template */
-                   "\"generationConfig\":{" /* GUIDELINE_APPROVED: Gemini API JSON template */
-                   "\"maxOutputTokens\":%d," /* GUIDELINE_APPROVED: Gemini API JSON template */
-                   "\"temperature\":0.7" /* GUIDELINE_APPROVED: Gemini API JSON template */
-                   "}" /* GUIDELINE_APPROVED: Gemini API JSON template */
-                   "}", /* GUIDELINE_APPROVED: Gemini API JSON template */
-                   prompt, API_MAX_TOKENS);
+static int gemini_build_request(json_builder_t* json, const char* model,
+                                const char* prompt, bool stream) {
+    (void)model;   /* Model is in URL, not request body */
+    (void)stream;  /* Streaming is selected by URL method */
+
+    json_builder_object_begin(json);
+    json_builder_key(json, "contents"); /* GUIDELINE_APPROVED: Gemini API JSON field */
+    json_builder_array_begin(json);
+    json_builder_object_begin(json);
+    json_builder_key(json, "parts"); /* GUIDELINE_APPROVED: Gemini API JSON field */
+    json_builder_array_begin(json);
+    json_builder_object_begin(json);
+    json_builder_key_string(json, "text", prompt); /* GUIDELINE_APPROVED: Gemini API JSON field */
+    json_builder_object_end(json);
+    json_builder_array_end(json);
+    json_builder_object_end(json);
+    json_builder_array_end(json);
+
+    json_builder_key(json, "generationConfig"); /* GUIDELINE_APPROVED: Gemini API JSON field */
+    json_builder_object_begin(json);
+    json_builder_key_int(json, "maxOutputTokens", API_MAX_TOKENS); /* GUIDELINE_APPROVED: Gemini API JSON field */
+    json_builder_key(json, "temperature"); /* GUIDELINE_APPROVED: Gemini API JSON field */
+    json_builder_double(json, API_DEFAULT_TEMPERATURE);
+    json_builder_object_end(json);
+    json_builder_object_end(json);
+    return json_builder_error(json);
 }
 
 /* Gemini API configuration */
@@ -48,6 +59,7 @@ static const api_provider_config_t gemini_config = {
     .response_path_depth = 2,
     .build_request = gemini_build_request,
     .supports_streaming = true,
+    .stream_delta_pointer = STREAM_DELTA_GEMINI,
     .max_context = GEMINI_MAX_CONTEXT
 };
 
@@ -0,0 +1,439 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Memory Digest - digest lifecycle, item arena and content-hash index */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Project includes */
+#include "argo_memory.h"
+#include "argo_memory_internal.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_log.h"
+
+/* FNV-1a */
+#define FNV32_OFFSET_BASIS 0x811c9dc5U
+#define FNV32_PRIME 0x01000193U
+
+#define MEMORY_ARENA_ALIGN 8
+#define MEMORY_INDEX_SCORE_SCALE 65535.0f
+
+/* Bump allocator chunk */
+typedef struct memory_arena_chunk {
+    struct memory_arena_chunk* next;
+    size_t used;
+    size_t capacity;
+    char data[];
+} memory_arena_chunk_t;
+
+struct memory_arena {
+    memory_arena_chunk_t* chunks;   /* Current chunk first */
+};
+
+/* Helper: Allocate from the arena (freed only with the digest) */
+static void* arena_alloc(struct memory_arena* arena, size_t size) {
+    size = (size + MEMORY_ARENA_ALIGN - 1) & ~(size_t)(MEMORY_ARENA_ALIGN - 1);
+    memory_arena_chunk_t* chunk = arena->chunks;
+    if (!chunk || chunk->capacity - chunk->used < size) {
+        size_t capacity = size > MEMORY_ARENA_CHUNK_SIZE ? size : MEMORY_ARENA_CHUNK_SIZE;
+        chunk = malloc(sizeof(memory_arena_chunk_t) + capacity);
+        if (!chunk) {
+            argo_report_error(E_SYSTEM_MEMORY, "memory_add_item", ERR_MSG_MEMORY_ALLOC_FAILED);
+            return NULL;
+        }
+        chunk->used = 0;
+        chunk->capacity = capacity;
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+    }
+    void* ptr = chunk->data + chunk->used;
+    chunk->used += size;
+    return ptr;
+}
+
+/* Helper: Copy a string into the arena */
+static char* arena_strdup(struct memory_arena* arena, const char* text, size_t len) {
+    char* copy = arena_alloc(arena, len + 1);
+    if (copy) {
+        memcpy(copy, text, len);
+        copy[len] = '\0';
+    }
+    return copy;
+}
+
+/* Helper: Content hash over type and text, never 0 (free slot marker) */
+static uint32_t content_hash(memory_type_t type, const char* content) {
+    uint32_t hash = FNV32_OFFSET_BASIS;
+    hash = (hash ^ (uint32_t)type) * FNV32_PRIME;
+    for (const unsigned char* p = (const unsigned char*)content; *p; p++) {
+        hash = (hash ^ *p) * FNV32_PRIME;
+    }
+    return hash ? hash : 1;
+}
+
+/* Helper: Clamp a stored score to 0..1 */
+static float clamp_score(float score) {
+    if (score < 0.0f) return 0.0f;
+    if (score > 1.0f) return 1.0f;
+    return score;
+}
+
+/* Helper: Index slot holding this content, or the free slot to put it in */
+static size_t index_probe(ci_memory_digest_t* digest, uint32_t hash,
+                          memory_type_t type, const char* content, bool* found) {
+    size_t mask = digest->index_size - 1;
+    size_t slot = hash & mask;
+    *found = false;
+    while (digest->index[slot].hash != 0) {
+        if (digest->index[slot].hash == hash) {
+            memory_item_t* item = digest->by_id[digest->index[slot].memory_id];
+            if (item->type == type && strcmp(item->content, content) == 0) {
+                *found = true;
+                return slot;
+            }
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/* Helper: Take a private copy of an index still mapped from a store file */
+static int own_index(ci_memory_digest_t* digest) {
+    if (!digest->index_mapped) return ARGO_SUCCESS;
+
+    memory_index_t* index = malloc(digest->index_size * sizeof(memory_index_t));
+    if (!index) {
+        argo_report_error(E_SYSTEM_MEMORY, "memory_add_item", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return E_SYSTEM_MEMORY;
+    }
+    memcpy(index, digest->index, digest->index_size * sizeof(memory_index_t));
+    digest->index = index;
+    digest->index_mapped = false;
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Double the index and reinsert */
+static int index_grow(ci_memory_digest_t* digest) {
+    size_t size = digest->index_size * 2;
+    memory_index_t* index = calloc(size, sizeof(memory_index_t));
+    if (!index) {
+        argo_report_error(E_SYSTEM_MEMORY, "memory_add_item", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return E_SYSTEM_MEMORY;
+    }
+    for (size_t i = 0; i < digest->index_size; i++) {
+        if (digest->index[i].hash == 0) continue;
+        size_t slot = digest->index[i].hash & (size - 1);
+        while (index[slot].hash != 0) slot = (slot + 1) & (size - 1);
+        index[slot] = digest->index[i];
+    }
+    free(digest->index);
+    digest->index = index;
+    digest->index_size = size;
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Make room for memory_id in the id table */
+static int ensure_id_capacity(ci_memory_digest_t* digest, uint32_t memory_id) {
+    if (memory_id < digest->by_id_capacity) return ARGO_SUCCESS;
+
+    size_t capacity = digest->by_id_capacity ? digest->by_id_capacity : MEMORY_INDEX_INITIAL;
+    while (capacity <= memory_id) capacity *= 2;
+    memory_item_t** by_id = realloc(digest->by_id, capacity * sizeof(memory_item_t*));
+    if (!by_id) {
+        argo_report_error(E_SYSTEM_MEMORY, "memory_add_item", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return E_SYSTEM_MEMORY;
+    }
+    memset(by_id + digest->by_id_capacity, 0,
+           (capacity - digest->by_id_capacity) * sizeof(memory_item_t*));
+    digest->by_id = by_id;
+    digest->by_id_capacity = capacity;
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Note a repeated memory - the boost lands on the decayed score */
+static void touch_item(ci_memory_digest_t* digest, memory_item_t* item) {
+    time_t now = time(NULL);
+    float score = memory_stored_relevance(digest, item, now) + MEMORY_ACCESS_BOOST;
+    item->relevance.access_count++;
+    item->relevance.last_accessed = now;
+    memory_set_score(digest, item, clamp_score(score), memory_decay_clock(digest, now));
+}
+
+/* Helper: Store new content, or return the item already holding it */
+static memory_item_t* store_item(ci_memory_digest_t* digest, uint32_t memory_id,
+                                 memory_type_t type, const char* content,
+                                 const char* creator_ci, time_t created, bool* merged) {
+    *merged = false;
+    if (own_index(digest) != ARGO_SUCCESS) return NULL;
+    if ((digest->index_count + 1) * 100 > digest->index_size * MEMORY_INDEX_LOAD_PERCENT &&
+        index_grow(digest) != ARGO_SUCCESS) {
+        return NULL;
+    }
+
+    uint32_t hash = content_hash(type, content);
+    bool found = false;
+    size_t slot = index_probe(digest, hash, type, content, &found);
+    if (found) {
+        *merged = true;
+        return digest->by_id[digest->index[slot].memory_id];
+    }
+    if (ensure_id_capacity(digest, memory_id) != ARGO_SUCCESS) return NULL;
+
+    size_t length = strlen(content);
+    memory_item_t* item = arena_alloc(digest->arena, sizeof(memory_item_t));
+    if (!item) return NULL;
+    memset(item, 0, sizeof(*item));
+    item->content = arena_strdup(digest->arena, content, length);
+    item->creator_ci = creator_ci ? arena_strdup(digest->arena, creator_ci, strlen(creator_ci)) : NULL;
+    if (!item->content || (creator_ci && !item->creator_ci)) return NULL;
+
+    item->id = memory_id;
+    item->type = type;
+    item->content_size = length;
+    item->tokens = (uint32_t)memory_estimate_tokens(content, length);
+    item->created = created;
+    item->relevance.last_accessed = created;
+    memory_set_score(digest, item, MEMORY_DEFAULT_RELEVANCE, memory_decay_clock(digest, time(NULL)));
+    if (digest->terms && memory_terms_add(digest->terms, item) != ARGO_SUCCESS) return NULL;
+    if (digest->ranking && memory_ranking_add(digest->ranking, item) != ARGO_SUCCESS) return NULL;
+    if (digest->near && memory_near_add(digest->near, item) != ARGO_SUCCESS) return NULL;
+
+    item->next = digest->items;
+    digest->items = item;
+    digest->item_count++;
+    digest->by_id[memory_id] = item;
+    if (memory_id >= digest->next_id) digest->next_id = memory_id + 1;
+
+    digest->index[slot].hash = hash;
+    digest->index[slot].memory_id = memory_id;
+    digest->index[slot].offset = 0;
+    digest->index[slot].relevance_score = (uint16_t)(item->relevance.score * MEMORY_INDEX_SCORE_SCALE);
+    digest->index_count++;
+    return item;
+}
+
+/* Create digest */
+ci_memory_digest_t* memory_digest_create(size_t context_limit) {
+    ci_memory_digest_t* digest = calloc(1, sizeof(ci_memory_digest_t));
+    if (!digest) goto fail;
+
+    digest->arena = calloc(1, sizeof(struct memory_arena));
+    digest->index = calloc(MEMORY_INDEX_INITIAL, sizeof(memory_index_t));
+    digest->terms = memory_terms_create();
+    digest->ranking = memory_ranking_create();
+    digest->near = memory_near_create();
+    if (!digest->arena || !digest->index || !digest->terms || !digest->ranking || !digest->near) goto fail;
+
+    digest->index_size = MEMORY_INDEX_INITIAL;
+    digest->max_allowed_size = context_limit * MEMORY_MAX_PERCENTAGE / 100;
+    digest->next_id = 1;
+    digest->created = time(NULL);
+    return digest;
+
+fail:
+    argo_report_error(E_SYSTEM_MEMORY, "memory_digest_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+    memory_digest_destroy(digest);
+    return NULL;
+}
+
+/* Destroy digest */
+void memory_digest_destroy(ci_memory_digest_t* digest) {
+    if (!digest) return;
+
+    for (int i = 0; i < digest->breadcrumb_count; i++) {
+        free(digest->breadcrumbs[i]);
+    }
+    if (digest->arena) {
+        memory_arena_chunk_t* chunk = digest->arena->chunks;
+        while (chunk) {
+            memory_arena_chunk_t* next = chunk->next;
+            free(chunk);
+            chunk = next;
+        }
+        free(digest->arena);
+    }
+    free(digest->sunset_notes);
+    free(digest->sunrise_brief);
+    free(digest->json_content);
+    memory_terms_destroy(digest->terms);
+    memory_ranking_destroy(digest->ranking);
+    memory_near_destroy(digest->near);
+    memory_store_release(digest->store);
+    if (!digest->index_mapped) free(digest->index);
+    free(digest->by_id);
+    free(digest);
+}
+
+/* Add memory item */
+int memory_add_item(ci_memory_digest_t* digest, memory_type_t type,
+                    const char* content, const char* creator_ci) {
+    ARGO_CHECK_NULL(digest);
+    ARGO_CHECK_NULL(content);
+
+    bool merged = true;
+    memory_item_t* item = memory_find_near(digest, type, content);
+    if (!item) {
+        item = store_item(digest, digest->next_id, type, content, creator_ci, time(NULL), &merged);
+    }
+    if (!item) return E_SYSTEM_MEMORY;
+
+    if (merged) {
+        touch_item(digest, item);
+        LOG_DEBUG("Memory %u repeated (%d times)", item->id, item->relevance.access_count);
+    }
+    digest->last_item_id = item->id;
+    return ARGO_SUCCESS;
+}
+
+/* Restore item under a known id */
+memory_item_t* memory_restore_item(ci_memory_digest_t* digest, uint32_t memory_id,
+                                   memory_type_t type, const char* content,
+                                   const char* creator_ci, time_t created) {
+    if (!digest || !content || memory_id == 0) return NULL;
+    bool merged = false;
+    return store_item(digest, memory_id, type, content, creator_ci, created, &merged);
+}
+
+/* Restore selection */
+int memory_restore_selection(ci_memory_digest_t* digest, memory_item_t* item) {
+    ARGO_CHECK_NULL(digest);
+    ARGO_CHECK_NULL(item);
+    if (item->selected) return ARGO_SUCCESS;
+    if (digest->selected_count >= MEMORY_MAX_ITEMS) return E_RESOURCE_LIMIT;
+
+    item->selected = true;
+    digest->selected[digest->selected_count++] = item;
+    return ARGO_SUCCESS;
+}
+
+/* Add breadcrumb - the oldest goes when full */
+int memory_add_breadcrumb(ci_memory_digest_t* digest, const char* breadcrumb) {
+    ARGO_CHECK_NULL(digest);
+    ARGO_CHECK_NULL(breadcrumb);
+
+    char* copy = strdup(breadcrumb);
+    if (!copy) {
+        argo_report_error(E_SYSTEM_MEMORY, "memory_add_breadcrumb", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return E_SYSTEM_MEMORY;
+    }
+
+    /* Drop a near duplicate, else the oldest when full */
+    uint64_t fingerprint = memory_fingerprint(breadcrumb);
+    int drop = memory_find_near_breadcrumb(digest, breadcrumb, fingerprint);
+    if (drop < 0 && digest->breadcrumb_count == MEMORY_BREADCRUMB_MAX) drop = 0;
+    if (drop >= 0) {
+        int after = digest->breadcrumb_count - drop - 1;
+        free(digest->breadcrumbs[drop]);
+        memmove(digest->breadcrumbs + drop, digest->breadcrumbs + drop + 1, after * sizeof(char*));
+        memmove(digest->breadcrumb_fingerprints + drop, digest->breadcrumb_fingerprints + drop + 1,
+                after * sizeof(uint64_t));
+        memmove(digest->breadcrumb_tokens + drop, digest->breadcrumb_tokens + drop + 1,
+                after * sizeof(uint32_t));
+        digest->breadcrumb_count--;
+    }
+    digest->breadcrumb_fingerprints[digest->breadcrumb_count] = fingerprint;
+    digest->breadcrumb_tokens[digest->breadcrumb_count] = (uint32_t)memory_estimate_tokens(copy, strlen(copy));
+    digest->breadcrumbs[digest->breadcrumb_count++] = copy;
+    return ARGO_SUCCESS;
+}
+
+/* Find item by id */
+memory_item_t* memory_find_item(ci_memory_digest_t* digest, uint32_t memory_id) {
+    if (!digest || memory_id >= digest->by_id_capacity) return NULL;
+    return digest->by_id[memory_id];
+}
+
+/* Select item */
+int memory_select_item(ci_memory_digest_t* digest, uint32_t memory_id) {
+    ARGO_CHECK_NULL(digest);
+
+    memory_item_t* item = memory_find_item(digest, memory_id);
+    if (!item) return E_NOT_FOUND;
+    if (item->selected) return ARGO_SUCCESS;
+    if (digest->selected_count >= MEMORY_MAX_ITEMS) return E_RESOURCE_LIMIT;
+    if (memory_calculate_size(digest) + item->content_size > digest->max_allowed_size) {
+        return E_INPUT_TOO_LARGE;
+    }
+
+    touch_item(digest, item);
+    return memory_restore_selection(digest, item);
+}
+
+/* Select suggestions by position */
+int memory_select_suggested(ci_memory_digest_t* digest, int suggestion_indices[], int count) {
+    ARGO_CHECK_NULL(digest);
+    ARGO_CHECK_NULL(suggestion_indices);
+
+    for (int i = 0; i < count; i++) {
+        int at = suggestion_indices[i];
+        if (at < 0 || at >= digest->suggestion_count) return E_INPUT_RANGE;
+        int result = memory_select_item(digest, digest->suggested[at]->id);
+        if (result != ARGO_SUCCESS) return result;
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Replace an owned string and its token estimate */
+static int replace_text(char** field, uint32_t* tokens, const char* text, const char* func) {
+    char* copy = strdup(text);
+    if (!copy) {
+        argo_report_error(E_SYSTEM_MEMORY, func, ERR_MSG_MEMORY_ALLOC_FAILED);
+        return E_SYSTEM_MEMORY;
+    }
+    free(*field);
+    *field = copy;
+    *tokens = (uint32_t)memory_estimate_tokens(copy, strlen(copy));
+    return ARGO_SUCCESS;
+}
+
+/* Set sunset notes */
+int memory_set_sunset_notes(ci_memory_digest_t* digest, const char* notes) {
+    ARGO_CHECK_NULL(digest);
+    ARGO_CHECK_NULL(notes);
+    return replace_text(&digest->sunset_notes, &digest->sunset_tokens, notes, "memory_set_sunset_notes");
+}
+
+/* Set sunrise brief */
+int memory_set_sunrise_brief(ci_memory_digest_t* digest, const char* brief) {
+    ARGO_CHECK_NULL(digest);
+    ARGO_CHECK_NULL(brief);
+    return replace_text(&digest->sunrise_brief, &digest->sunrise_tokens, brief, "memory_set_sunrise_brief");
+}
+
+/* Size of what the CI is handed: notes, breadcrumbs and selected items */
+size_t memory_calculate_size(ci_memory_digest_t* digest) {
+    if (!digest) return 0;
+
+    size_t size = 0;
+    if (digest->sunset_notes) size += strlen(digest->sunset_notes);
+    if (digest->sunrise_brief) size += strlen(digest->sunrise_brief);
+    for (int i = 0; i < digest->breadcrumb_count; i++) {
+        size += strlen(digest->breadcrumbs[i]);
+    }
+    for (int i = 0; i < digest->selected_count; i++) {
+        size += digest->selected[i]->content_size;
+    }
+    return size;
+}
+
+/* Check the 50% context rule */
+bool memory_check_size_limit(ci_memory_digest_t* digest) {
+    return digest && memory_calculate_size(digest) <= digest->max_allowed_size;
+}
+
+/* Display name of an item type */
+const char* memory_type_name(memory_type_t type) {
+    switch (type) {
+        case MEMORY_TYPE_FACT: return "Fact";
+        case MEMORY_TYPE_DECISION: return "Decision";
+        case MEMORY_TYPE_APPROACH: return "Approach";
+        case MEMORY_TYPE_ERROR: return "Error";
+        case MEMORY_TYPE_SUCCESS: return "Success";
+        case MEMORY_TYPE_BREADCRUMB: return "Breadcrumb";
+        case MEMORY_TYPE_RELATIONSHIP: return "Relationship";
+    }
+    return "Unknown";
+}
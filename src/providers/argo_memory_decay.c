@@ -0,0 +1,250 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Memory Decay - lazy relevance decay and the top-k ranking heap */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/* Project includes */
+#include "argo_memory.h"
+#include "argo_memory_internal.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_log.h"
+
+#define MEMORY_RANKING_INITIAL 256
+
+/* Items ordered by rank_key (max-heap, item->rank_slot is the position)
+ *
+ * rank_key = log2(score) + decay_stamp, and the decayed score is
+ * 2^(rank_key - clock), so decay lowers every item alike and never
+ * reorders the heap: only a score change moves an item.
+ */
+struct memory_ranking {
+    memory_item_t** heap;
+    size_t count;
+    size_t capacity;
+    uint32_t* frontier;         /* Scratch for memory_ranking_top */
+    size_t frontier_capacity;
+};
+
+/* Helper: Place an item at a heap slot */
+static void heap_place(struct memory_ranking* ranking, size_t slot, memory_item_t* item) {
+    ranking->heap[slot] = item;
+    item->rank_slot = (uint32_t)slot;
+}
+
+/* Helper: Move an item toward the root while it outranks its parent */
+static void sift_up(struct memory_ranking* ranking, size_t slot) {
+    memory_item_t* item = ranking->heap[slot];
+    while (slot > 0) {
+        size_t parent = (slot - 1) / 2;
+        if (ranking->heap[parent]->rank_key >= item->rank_key) break;
+        heap_place(ranking, slot, ranking->heap[parent]);
+        slot = parent;
+    }
+    heap_place(ranking, slot, item);
+}
+
+/* Helper: Move an item toward the leaves while a child outranks it */
+static void sift_down(struct memory_ranking* ranking, size_t slot) {
+    memory_item_t* item = ranking->heap[slot];
+    for (;;) {
+        size_t best = 2 * slot + 1;
+        if (best >= ranking->count) break;
+        if (best + 1 < ranking->count &&
+            ranking->heap[best + 1]->rank_key > ranking->heap[best]->rank_key) {
+            best++;
+        }
+        if (ranking->heap[best]->rank_key <= item->rank_key) break;
+        heap_place(ranking, slot, ranking->heap[best]);
+        slot = best;
+    }
+    heap_place(ranking, slot, item);
+}
+
+/* Create ranking */
+struct memory_ranking* memory_ranking_create(void) {
+    struct memory_ranking* ranking = calloc(1, sizeof(struct memory_ranking));
+    if (ranking) ranking->heap = malloc(MEMORY_RANKING_INITIAL * sizeof(memory_item_t*));
+    if (!ranking || !ranking->heap) {
+        argo_report_error(E_SYSTEM_MEMORY, "memory_ranking_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+        free(ranking);
+        return NULL;
+    }
+    ranking->capacity = MEMORY_RANKING_INITIAL;
+    return ranking;
+}
+
+/* Destroy ranking */
+void memory_ranking_destroy(struct memory_ranking* ranking) {
+    if (!ranking) return;
+    free(ranking->heap);
+    free(ranking->frontier);
+    free(ranking);
+}
+
+/* Add a new item */
+int memory_ranking_add(struct memory_ranking* ranking, memory_item_t* item) {
+    if (ranking->count == ranking->capacity) {
+        size_t capacity = ranking->capacity * 2;
+        memory_item_t** heap = realloc(ranking->heap, capacity * sizeof(memory_item_t*));
+        if (!heap) {
+            argo_report_error(E_SYSTEM_MEMORY, "memory_ranking_add", ERR_MSG_MEMORY_ALLOC_FAILED);
+            return E_SYSTEM_MEMORY;
+        }
+        ranking->heap = heap;
+        ranking->capacity = capacity;
+    }
+    heap_place(ranking, ranking->count++, item);
+    sift_up(ranking, item->rank_slot);
+    return ARGO_SUCCESS;
+}
+
+/* Build the digest's ranking from its items (first ranked query after a mapped load) */
+int memory_ranking_build(ci_memory_digest_t* digest) {
+    ARGO_CHECK_NULL(digest);
+    struct memory_ranking* ranking = memory_ranking_create();
+    if (!ranking) return E_SYSTEM_MEMORY;
+
+    size_t capacity = ranking->capacity;
+    while (capacity < (size_t)digest->item_count) capacity *= 2;
+    memory_item_t** heap = realloc(ranking->heap, capacity * sizeof(memory_item_t*));
+    if (!heap) {
+        argo_report_error(E_SYSTEM_MEMORY, "memory_ranking_build", ERR_MSG_MEMORY_ALLOC_FAILED);
+        memory_ranking_destroy(ranking);
+        return E_SYSTEM_MEMORY;
+    }
+    ranking->heap = heap;
+    ranking->capacity = capacity;
+
+    for (memory_item_t* item = digest->items; item; item = item->next) {
+        heap_place(ranking, ranking->count++, item);
+    }
+    for (size_t slot = ranking->count / 2; slot-- > 0;) {
+        sift_down(ranking, slot);
+    }
+    digest->ranking = ranking;
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Push a heap slot onto the frontier (a max-heap of slots) */
+static int frontier_push(struct memory_ranking* ranking, size_t* pending, uint32_t slot) {
+    if (*pending == ranking->frontier_capacity) {
+        size_t capacity = ranking->frontier_capacity ? ranking->frontier_capacity * 2 : MEMORY_RANKING_INITIAL;
+        uint32_t* frontier = realloc(ranking->frontier, capacity * sizeof(uint32_t));
+        if (!frontier) {
+            argo_report_error(E_SYSTEM_MEMORY, "memory_ranking_top", ERR_MSG_MEMORY_ALLOC_FAILED);
+            return E_SYSTEM_MEMORY;
+        }
+        ranking->frontier = frontier;
+        ranking->frontier_capacity = capacity;
+    }
+
+    uint32_t* frontier = ranking->frontier;
+    size_t at = (*pending)++;
+    while (at > 0 && ranking->heap[frontier[(at - 1) / 2]]->rank_key < ranking->heap[slot]->rank_key) {
+        frontier[at] = frontier[(at - 1) / 2];
+        at = (at - 1) / 2;
+    }
+    frontier[at] = slot;
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Pop the best slot off the frontier */
+static uint32_t frontier_pop(struct memory_ranking* ranking, size_t* pending) {
+    uint32_t* frontier = ranking->frontier;
+    uint32_t top = frontier[0];
+    uint32_t last = frontier[--(*pending)];
+    double key = ranking->heap[last]->rank_key;
+    size_t at = 0;
+    for (;;) {
+        size_t best = 2 * at + 1;
+        if (best >= *pending) break;
+        if (best + 1 < *pending &&
+            ranking->heap[frontier[best + 1]]->rank_key > ranking->heap[frontier[best]]->rank_key) {
+            best++;
+        }
+        if (ranking->heap[frontier[best]]->rank_key <= key) break;
+        frontier[at] = frontier[best];
+        at = best;
+    }
+    if (*pending > 0) frontier[at] = last;
+    return top;
+}
+
+/* Best unselected items by decayed stored score, best first
+ *
+ * Walks the heap best-first from the root, so only the part of the
+ * tree above the cut is visited. type < 0 takes any type.
+ */
+int memory_ranking_top(ci_memory_digest_t* digest, int type, uint32_t* ids, int max) {
+    if (!digest || max <= 0) return 0;
+    if (!digest->ranking && memory_ranking_build(digest) != ARGO_SUCCESS) return 0;
+    struct memory_ranking* ranking = digest->ranking;
+
+    int found = 0;
+    size_t pending = 0;
+    if (ranking->count > 0 && frontier_push(ranking, &pending, 0) != ARGO_SUCCESS) return 0;
+    while (pending > 0 && found < max) {
+        uint32_t slot = frontier_pop(ranking, &pending);
+        memory_item_t* item = ranking->heap[slot];
+        if (!item->selected && (type < 0 || item->type == (memory_type_t)type)) {
+            ids[found++] = item->id;
+        }
+        for (size_t child = 2 * (size_t)slot + 1; child <= 2 * (size_t)slot + 2 && child < ranking->count; child++) {
+            if (frontier_push(ranking, &pending, (uint32_t)child) != ARGO_SUCCESS) return found;
+        }
+    }
+    return found;
+}
+
+/* Decay clock - half-lives of elapsed time plus explicit decay */
+double memory_decay_clock(const ci_memory_digest_t* digest, time_t now) {
+    return digest->decay_epoch + (double)now / MEMORY_HALF_LIFE_SECONDS;
+}
+
+/* Set an item's stored score as of a clock reading */
+void memory_set_score(ci_memory_digest_t* digest, memory_item_t* item, float score, double stamp) {
+    double before = item->rank_key;
+    item->relevance.score = score;
+    item->relevance.decay_stamp = stamp;
+    item->rank_key = score > 0.0f ? log2(score) + stamp : -INFINITY;
+
+    struct memory_ranking* ranking = digest->ranking;
+    if (!ranking || item->rank_slot >= ranking->count || ranking->heap[item->rank_slot] != item) return;
+    if (item->rank_key > before) {
+        sift_up(ranking, item->rank_slot);
+    } else {
+        sift_down(ranking, item->rank_slot);
+    }
+}
+
+/* Stored score with decay applied */
+float memory_stored_relevance(const ci_memory_digest_t* digest, const memory_item_t* item, time_t now) {
+    if (!digest || !item) return 0.0f;
+    double elapsed = memory_decay_clock(digest, now) - item->relevance.decay_stamp;
+    if (elapsed <= 0.0) return item->relevance.score;
+    return (float)(item->relevance.score * exp2(-elapsed));
+}
+
+/* Set stored relevance */
+int memory_update_relevance(ci_memory_digest_t* digest, memory_item_t* item, float new_score) {
+    ARGO_CHECK_NULL(digest);
+    ARGO_CHECK_NULL(item);
+    if (new_score < 0.0f || new_score > 1.0f) return E_INPUT_RANGE;
+    memory_set_score(digest, item, new_score, memory_decay_clock(digest, time(NULL)));
+    return ARGO_SUCCESS;
+}
+
+/* Decay every stored score - one clock step, no item is touched */
+int memory_decay_relevance(ci_memory_digest_t* digest, float decay_factor) {
+    ARGO_CHECK_NULL(digest);
+    if (decay_factor < 0.0f || decay_factor > 1.0f) return E_INPUT_RANGE;
+
+    digest->decay_epoch += decay_factor > 0.0f ? -log2(decay_factor) : MEMORY_DECAY_FORGET;
+    return ARGO_SUCCESS;
+}
@@ -0,0 +1,237 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Memory JSON - digest serialization, restore and summary printing */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Project includes */
+#include "argo_memory.h"
+#include "argo_memory_internal.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_json_builder.h"
+#include "argo_json_doc.h"
+
+#define MEMORY_FORMAT_VERSION 1
+
+/* Helper: Copy a JSON string member into a fixed field */
+static void copy_member(json_node_t* root, const char* pointer, char* out, size_t size) {
+    json_node_t* node = json_doc_get(root, pointer);
+    if (node && node->type == JSON_DOC_STRING) {
+        snprintf(out, size, "%s", node->text);
+    }
+}
+
+/* Helper: Integer member or fallback */
+static long long integer_member(json_node_t* object, const char* pointer, long long fallback) {
+    long long value = fallback;
+    json_node_t* node = json_doc_get(object, pointer);
+    if (node) json_doc_get_integer(node, &value);
+    return value;
+}
+
+/* Helper: String member or NULL */
+static const char* string_member(json_node_t* object, const char* pointer) {
+    json_node_t* node = json_doc_get(object, pointer);
+    return node && node->type == JSON_DOC_STRING ? node->text : NULL;
+}
+
+/* Helper: Number member or fallback */
+static double number_member(json_node_t* object, const char* pointer, double fallback) {
+    json_node_t* node = json_doc_get(object, pointer);
+    return node && node->type == JSON_DOC_NUMBER ? strtod(node->text, NULL) : fallback;
+}
+
+/* Helper: Rebuild one stored item */
+static int restore_item(ci_memory_digest_t* digest, json_node_t* object) {
+    const char* content = string_member(object, "/content");
+    long long id = integer_member(object, "/id", 0);
+    long long type = integer_member(object, "/type", MEMORY_TYPE_FACT);
+    if (!content || id <= 0 || id > UINT32_MAX ||
+        type < MEMORY_TYPE_FACT || type > MEMORY_TYPE_RELATIONSHIP) {
+        return E_INPUT_FORMAT;
+    }
+
+    memory_item_t* item = memory_restore_item(digest, (uint32_t)id, (memory_type_t)type, content,
+                                              string_member(object, "/creator"),
+                                              (time_t)integer_member(object, "/created", 0));
+    if (!item) return E_SYSTEM_MEMORY;
+
+    /* Files without a stamp predate lazy decay: their scores are current */
+    float score = (float)number_member(object, "/score", MEMORY_DEFAULT_RELEVANCE);
+    if (score >= 0.0f && score <= 1.0f) {
+        memory_set_score(digest, item, score,
+                         number_member(object, "/decay_stamp", memory_decay_clock(digest, time(NULL))));
+    }
+    json_node_t* important = json_doc_get(object, "/important");
+    item->relevance.ci_marked_important = important && important->type == JSON_DOC_BOOL &&
+                                          important->boolean;
+    item->relevance.access_count = (int)integer_member(object, "/access_count", 0);
+    item->relevance.last_accessed = (time_t)integer_member(object, "/last_accessed", item->created);
+    return ARGO_SUCCESS;
+}
+
+/* Serialize digest to JSON */
+char* memory_digest_to_json(ci_memory_digest_t* digest) {
+    if (!digest) return NULL;
+
+    json_builder_t json;
+    if (json_builder_init(&json, MEMORY_JSON_BUFFER_SIZE) != ARGO_SUCCESS) return NULL;
+
+    json_builder_object_begin(&json);
+    json_builder_key_int(&json, "version", MEMORY_FORMAT_VERSION);
+    json_builder_key_string(&json, "session_id", digest->session_id);
+    json_builder_key_string(&json, "ci_name", digest->ci_name);
+    json_builder_key_int(&json, "created", (long long)digest->created);
+    json_builder_key(&json, "decay_epoch");
+    json_builder_double(&json, digest->decay_epoch);
+    json_builder_key_string(&json, "sunset_notes", digest->sunset_notes);
+    json_builder_key_string(&json, "sunrise_brief", digest->sunrise_brief);
+
+    json_builder_key(&json, "breadcrumbs");
+    json_builder_array_begin(&json);
+    for (int i = 0; i < digest->breadcrumb_count; i++) {
+        json_builder_string(&json, digest->breadcrumbs[i]);
+    }
+    json_builder_array_end(&json);
+
+    /* Oldest first, so ids reload in order */
+    json_builder_key(&json, "items");
+    json_builder_array_begin(&json);
+    for (uint32_t id = 1; id < digest->next_id; id++) {
+        memory_item_t* item = memory_find_item(digest, id);
+        if (!item) continue;
+        json_builder_object_begin(&json);
+        json_builder_key_int(&json, "id", item->id);
+        json_builder_key_int(&json, "type", item->type);
+        json_builder_key_string(&json, "content", item->content);
+        json_builder_key_string(&json, "creator", item->creator_ci);
+        json_builder_key_int(&json, "created", (long long)item->created);
+        json_builder_key(&json, "score");
+        json_builder_double(&json, item->relevance.score);
+        json_builder_key(&json, "decay_stamp");
+        json_builder_double(&json, item->relevance.decay_stamp);
+        json_builder_key_int(&json, "access_count", item->relevance.access_count);
+        json_builder_key_int(&json, "last_accessed", (long long)item->relevance.last_accessed);
+        json_builder_key_bool(&json, "important", item->relevance.ci_marked_important);
+        json_builder_object_end(&json);
+    }
+    json_builder_array_end(&json);
+
+    json_builder_key(&json, "selected");
+    json_builder_array_begin(&json);
+    for (int i = 0; i < digest->selected_count; i++) {
+        json_builder_int(&json, digest->selected[i]->id);
+    }
+    json_builder_array_end(&json);
+    json_builder_object_end(&json);
+
+    if (json_builder_error(&json) != ARGO_SUCCESS) {
+        argo_report_error(json_builder_error(&json), "memory_digest_to_json", ERR_MSG_MEMORY_ALLOC_FAILED);
+        json_builder_free(&json);
+        return NULL;
+    }
+    return json_builder_take(&json, NULL);
+}
+
+/* Rebuild digest from JSON */
+ci_memory_digest_t* memory_digest_from_json(const char* json, size_t context_limit) {
+    json_node_t* root = NULL;
+    ci_memory_digest_t* digest = NULL;
+    int result = ARGO_SUCCESS;
+
+    if (!json) return NULL;
+    result = json_doc_parse(json, strlen(json), &root);
+    if (result != ARGO_SUCCESS || root->type != JSON_DOC_OBJECT) {
+        result = E_INPUT_FORMAT;
+        goto cleanup;
+    }
+
+    digest = memory_digest_create(context_limit);
+    if (!digest) {
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
+    copy_member(root, "/session_id", digest->session_id, sizeof(digest->session_id));
+    copy_member(root, "/ci_name", digest->ci_name, sizeof(digest->ci_name));
+    digest->created = (time_t)integer_member(root, "/created", (long long)digest->created);
+    digest->decay_epoch = number_member(root, "/decay_epoch", 0.0);
+
+    const char* notes = string_member(root, "/sunset_notes");
+    if (notes && (result = memory_set_sunset_notes(digest, notes)) != ARGO_SUCCESS) goto cleanup;
+    const char* brief = string_member(root, "/sunrise_brief");
+    if (brief && (result = memory_set_sunrise_brief(digest, brief)) != ARGO_SUCCESS) goto cleanup;
+
+    json_node_t* breadcrumbs = json_doc_get(root, "/breadcrumbs");
+    for (int i = 0; breadcrumbs && breadcrumbs->type == JSON_DOC_ARRAY && i < breadcrumbs->count; i++) {
+        json_node_t* crumb = breadcrumbs->children[i];
+        if (crumb->type != JSON_DOC_STRING) continue;
+        result = memory_add_breadcrumb(digest, crumb->text);
+        if (result != ARGO_SUCCESS) goto cleanup;
+    }
+
+    json_node_t* items = json_doc_get(root, "/items");
+    for (int i = 0; items && items->type == JSON_DOC_ARRAY && i < items->count; i++) {
+        result = restore_item(digest, items->children[i]);
+        if (result != ARGO_SUCCESS) goto cleanup;
+    }
+
+    json_node_t* selected = json_doc_get(root, "/selected");
+    for (int i = 0; selected && selected->type == JSON_DOC_ARRAY && i < selected->count; i++) {
+        long long id = 0;
+        memory_item_t* item = json_doc_get_integer(selected->children[i], &id) && id > 0 && id <= UINT32_MAX
+                              ? memory_find_item(digest, (uint32_t)id) : NULL;
+        if (item) memory_restore_selection(digest, item);
+    }
+
+cleanup:
+    json_doc_free(root);
+    if (result != ARGO_SUCCESS) {
+        argo_report_error(result, "memory_digest_from_json", "invalid memory digest");
+        memory_digest_destroy(digest);
+        return NULL;
+    }
+    return digest;
+}
+
+/* Print summary */
+void memory_print_summary(ci_memory_digest_t* digest) {
+    if (!digest) return;
+
+    printf("Memory Digest %s (%s): %d items, %d selected, %d suggested, %d breadcrumbs\n",
+           digest->session_id, digest->ci_name, digest->item_count, digest->selected_count,
+           digest->suggestion_count, digest->breadcrumb_count);
+    printf("  Size: %zu of %zu bytes\n", memory_calculate_size(digest), digest->max_allowed_size);
+    for (int i = 0; i < digest->selected_count; i++) {
+        memory_print_item(digest->selected[i]);
+    }
+}
+
+/* Print item */
+void memory_print_item(memory_item_t* item) {
+    if (!item) return;
+
+    printf("  #%u [%s] %.2f x%d%s: %s\n", item->id, memory_type_name(item->type),
+           item->relevance.score, item->relevance.access_count,
+           item->relevance.ci_marked_important ? " important" : "", item->content);
+}
+
+/* Validate digest invariants */
+int memory_validate_digest(ci_memory_digest_t* digest) {
+    ARGO_CHECK_NULL(digest);
+
+    if (digest->selected_count < 0 || digest->selected_count > MEMORY_MAX_ITEMS ||
+        digest->suggestion_count < 0 || digest->suggestion_count > MEMORY_SUGGESTION_MAX ||
+        digest->breadcrumb_count < 0 || digest->breadcrumb_count > MEMORY_BREADCRUMB_MAX ||
+        digest->index_count != (size_t)digest->item_count) {
+        return E_INTERNAL_CORRUPT;
+    }
+    for (int i = 0; i < digest->selected_count; i++) {
+        if (!digest->selected[i] || !digest->selected[i]->selected) return E_INTERNAL_CORRUPT;
+    }
+    if (!memory_check_size_limit(digest)) return E_INPUT_TOO_LARGE;
+    return ARGO_SUCCESS;
+}
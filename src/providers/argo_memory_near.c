@@ -0,0 +1,298 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Memory Near-Duplicates - SimHash fingerprints and banded lookup */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project includes */
+#include "argo_memory.h"
+#include "argo_memory_internal.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_log.h"
+
+#define MEMORY_SIMHASH_BITS 64
+#define MEMORY_BAND_BITS (MEMORY_SIMHASH_BITS / MEMORY_SIMHASH_BANDS)
+#define MEMORY_BAND_MASK ((1ULL << MEMORY_BAND_BITS) - 1)
+#define MEMORY_NEAR_BUCKETS_INITIAL 64
+#define MEMORY_NEAR_BUCKETS_MAX (1U << MEMORY_BAND_BITS)
+#define MEMORY_NEAR_BUCKET_LOAD 4           /* Items per bucket before doubling */
+#define MEMORY_NEAR_BUCKET_INITIAL 4
+#define MEMORY_NEAR_SCAN_CHUNK 64
+
+/* Band bucket - fingerprints stay contiguous for the popcount scan */
+typedef struct {
+    uint64_t* fingerprints;
+    uint32_t* ids;
+    uint32_t count;
+    uint32_t capacity;
+} memory_near_bucket_t;
+
+/* Fingerprint table, one bucket array per band
+ *
+ * Two fingerprints within MEMORY_SIMHASH_DISTANCE bits agree exactly on
+ * at least one of the MEMORY_SIMHASH_BANDS bands (pigeonhole), so a
+ * lookup only scans the buckets its own bands land in.
+ */
+struct memory_near {
+    memory_near_bucket_t* bands[MEMORY_SIMHASH_BANDS];
+    size_t bucket_count;        /* Per band, power of two */
+    size_t items;
+};
+
+/* Helper: Spread a word hash over all 64 bits (splitmix64 finalizer) */
+static uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/* Helper: SimHash of sorted word hashes (repeats weigh more) */
+static uint64_t simhash(const uint64_t* words, size_t count) {
+    int weights[MEMORY_SIMHASH_BITS] = {0};
+    for (size_t i = 0; i < count; i++) {
+        uint64_t h = mix64(words[i]);
+        for (int bit = 0; bit < MEMORY_SIMHASH_BITS; bit++) {
+            weights[bit] += (int)((h >> bit) & 1) * 2 - 1;
+        }
+    }
+    uint64_t fingerprint = 0;
+    for (int bit = 0; bit < MEMORY_SIMHASH_BITS; bit++) {
+        if (weights[bit] > 0) fingerprint |= 1ULL << bit;
+    }
+    return fingerprint;
+}
+
+/* Helper: Jaccard similarity of two sorted word lists (repeats ignored) */
+static float word_similarity(const uint64_t* a, size_t a_count, const uint64_t* b, size_t b_count) {
+    size_t i = 0, j = 0, shared = 0, total = 0;
+    while (i < a_count || j < b_count) {
+        uint64_t word;
+        if (j == b_count || (i < a_count && a[i] < b[j])) {
+            word = a[i];
+        } else if (i == a_count || b[j] < a[i]) {
+            word = b[j];
+        } else {
+            word = a[i];
+            shared++;
+        }
+        total++;
+        while (i < a_count && a[i] == word) i++;
+        while (j < b_count && b[j] == word) j++;
+    }
+    return total ? (float)shared / (float)total : 1.0f;
+}
+
+/* Helper: Hamming distance from fingerprint to each table entry
+ *
+ * A flat loop with no branches, which compilers vectorize on targets
+ * with a vector popcount and unroll to scalar popcount elsewhere.
+ */
+static void hamming_scan(const uint64_t* table, size_t count, uint64_t fingerprint, uint8_t* distance) {
+    for (size_t i = 0; i < count; i++) {
+        distance[i] = (uint8_t)__builtin_popcountll(table[i] ^ fingerprint);
+    }
+}
+
+/* Helper: Bucket a fingerprint falls in for a band */
+static memory_near_bucket_t* band_bucket(const struct memory_near* near, int band, uint64_t fingerprint) {
+    uint64_t value = (fingerprint >> (band * MEMORY_BAND_BITS)) & MEMORY_BAND_MASK;
+    return &near->bands[band][value & (near->bucket_count - 1)];
+}
+
+/* Helper: Append to a bucket */
+static int bucket_push(memory_near_bucket_t* bucket, uint64_t fingerprint, uint32_t memory_id) {
+    if (bucket->count == bucket->capacity) {
+        uint32_t capacity = bucket->capacity ? bucket->capacity * 2 : MEMORY_NEAR_BUCKET_INITIAL;
+        uint64_t* fingerprints = realloc(bucket->fingerprints, capacity * sizeof(uint64_t));
+        if (fingerprints) bucket->fingerprints = fingerprints;
+        uint32_t* ids = realloc(bucket->ids, capacity * sizeof(uint32_t));
+        if (ids) bucket->ids = ids;
+        if (!fingerprints || !ids) {
+            argo_report_error(E_SYSTEM_MEMORY, "memory_add_item", ERR_MSG_MEMORY_ALLOC_FAILED);
+            return E_SYSTEM_MEMORY;
+        }
+        bucket->capacity = capacity;
+    }
+    bucket->fingerprints[bucket->count] = fingerprint;
+    bucket->ids[bucket->count] = memory_id;
+    bucket->count++;
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Free one band's buckets */
+static void free_band(memory_near_bucket_t* buckets, size_t count) {
+    for (size_t i = 0; buckets && i < count; i++) {
+        free(buckets[i].fingerprints);
+        free(buckets[i].ids);
+    }
+    free(buckets);
+}
+
+/* Helper: Double the buckets of every band and redistribute */
+static int near_grow(struct memory_near* near) {
+    struct memory_near grown = { .bucket_count = near->bucket_count * 2, .items = near->items };
+    int result = ARGO_SUCCESS;
+    for (int band = 0; band < MEMORY_SIMHASH_BANDS && result == ARGO_SUCCESS; band++) {
+        grown.bands[band] = calloc(grown.bucket_count, sizeof(memory_near_bucket_t));
+        if (!grown.bands[band]) {
+            argo_report_error(E_SYSTEM_MEMORY, "memory_add_item", ERR_MSG_MEMORY_ALLOC_FAILED);
+            result = E_SYSTEM_MEMORY;
+            break;
+        }
+        for (size_t i = 0; i < near->bucket_count && result == ARGO_SUCCESS; i++) {
+            const memory_near_bucket_t* old = &near->bands[band][i];
+            for (uint32_t e = 0; e < old->count && result == ARGO_SUCCESS; e++) {
+                result = bucket_push(band_bucket(&grown, band, old->fingerprints[e]),
+                                     old->fingerprints[e], old->ids[e]);
+            }
+        }
+    }
+
+    /* Swap only once every band moved */
+    struct memory_near* discard = result == ARGO_SUCCESS ? near : &grown;
+    for (int band = 0; band < MEMORY_SIMHASH_BANDS; band++) {
+        free_band(discard->bands[band], discard->bucket_count);
+    }
+    if (result == ARGO_SUCCESS) *near = grown;
+    return result;
+}
+
+/* Fingerprint text */
+uint64_t memory_fingerprint(const char* text) {
+    size_t count = 0;
+    uint64_t* words = memory_text_words(text, &count);
+    uint64_t fingerprint = words ? simhash(words, count) : 0;
+    free(words);
+    return fingerprint;
+}
+
+/* Create fingerprint table */
+struct memory_near* memory_near_create(void) {
+    struct memory_near* near = calloc(1, sizeof(struct memory_near));
+    if (!near) goto fail;
+    near->bucket_count = MEMORY_NEAR_BUCKETS_INITIAL;
+    for (int band = 0; band < MEMORY_SIMHASH_BANDS; band++) {
+        near->bands[band] = calloc(near->bucket_count, sizeof(memory_near_bucket_t));
+        if (!near->bands[band]) goto fail;
+    }
+    return near;
+
+fail:
+    argo_report_error(E_SYSTEM_MEMORY, "memory_near_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+    memory_near_destroy(near);
+    return NULL;
+}
+
+/* Destroy fingerprint table */
+void memory_near_destroy(struct memory_near* near) {
+    if (!near) return;
+    for (int band = 0; band < MEMORY_SIMHASH_BANDS; band++) {
+        free_band(near->bands[band], near->bucket_count);
+    }
+    free(near);
+}
+
+/* Fingerprint a new item and file it under each band */
+int memory_near_add(struct memory_near* near, memory_item_t* item) {
+    if (near->items >= near->bucket_count * MEMORY_NEAR_BUCKET_LOAD &&
+        near->bucket_count < MEMORY_NEAR_BUCKETS_MAX) {
+        int result = near_grow(near);
+        if (result != ARGO_SUCCESS) return result;
+    }
+
+    item->fingerprint = memory_fingerprint(item->content);
+    for (int band = 0; band < MEMORY_SIMHASH_BANDS; band++) {
+        int result = bucket_push(band_bucket(near, band, item->fingerprint), item->fingerprint, item->id);
+        if (result != ARGO_SUCCESS) return result;
+    }
+    near->items++;
+    return ARGO_SUCCESS;
+}
+
+/* Build the digest's table from its items (first add after a mapped load) */
+int memory_near_build(ci_memory_digest_t* digest) {
+    ARGO_CHECK_NULL(digest);
+    struct memory_near* near = memory_near_create();
+    if (!near) return E_SYSTEM_MEMORY;
+
+    for (memory_item_t* item = digest->items; item; item = item->next) {
+        int result = memory_near_add(near, item);
+        if (result != ARGO_SUCCESS) {
+            memory_near_destroy(near);
+            return result;
+        }
+    }
+    digest->near = near;
+    return ARGO_SUCCESS;
+}
+
+/* Most similar item of the type within the SimHash distance and above
+ * MEMORY_NEAR_SIMILARITY, or NULL */
+memory_item_t* memory_find_near(ci_memory_digest_t* digest, memory_type_t type, const char* content) {
+    uint8_t distance[MEMORY_NEAR_SCAN_CHUNK];
+    memory_item_t* best = NULL;
+    float best_similarity = MEMORY_NEAR_SIMILARITY;
+
+    if (!digest || !content) return NULL;
+    if (!digest->near && memory_near_build(digest) != ARGO_SUCCESS) return NULL;
+
+    size_t word_count = 0;
+    uint64_t* words = memory_text_words(content, &word_count);
+    if (!words) return NULL;
+    uint64_t fingerprint = simhash(words, word_count);
+
+    for (int band = 0; band < MEMORY_SIMHASH_BANDS; band++) {
+        const memory_near_bucket_t* bucket = band_bucket(digest->near, band, fingerprint);
+        for (uint32_t start = 0; start < bucket->count; start += MEMORY_NEAR_SCAN_CHUNK) {
+            uint32_t chunk = bucket->count - start;
+            if (chunk > MEMORY_NEAR_SCAN_CHUNK) chunk = MEMORY_NEAR_SCAN_CHUNK;
+            hamming_scan(bucket->fingerprints + start, chunk, fingerprint, distance);
+
+            for (uint32_t i = 0; i < chunk; i++) {
+                if (distance[i] > MEMORY_SIMHASH_DISTANCE) continue;
+                memory_item_t* item = memory_find_item(digest, bucket->ids[start + i]);
+                if (!item || item == best || item->type != type) continue;
+
+                /* SimHash only nominates: the word sets decide */
+                size_t item_count = 0;
+                uint64_t* item_words = memory_text_words(item->content, &item_count);
+                float similarity = item_words ? word_similarity(words, word_count, item_words, item_count) : 0.0f;
+                free(item_words);
+                if (similarity >= best_similarity) {
+                    best = item;
+                    best_similarity = similarity;
+                }
+            }
+        }
+    }
+    free(words);
+    return best;
+}
+
+/* Breadcrumb near the text, or -1 */
+int memory_find_near_breadcrumb(ci_memory_digest_t* digest, const char* breadcrumb, uint64_t fingerprint) {
+    uint8_t distance[MEMORY_BREADCRUMB_MAX];
+    int found = -1;
+
+    hamming_scan(digest->breadcrumb_fingerprints, (size_t)digest->breadcrumb_count, fingerprint, distance);
+    size_t word_count = 0;
+    uint64_t* words = NULL;
+    for (int i = digest->breadcrumb_count - 1; i >= 0 && found < 0; i--) {
+        if (distance[i] > MEMORY_SIMHASH_DISTANCE) continue;
+        if (!words && !(words = memory_text_words(breadcrumb, &word_count))) break;
+
+        size_t crumb_count = 0;
+        uint64_t* crumb_words = memory_text_words(digest->breadcrumbs[i], &crumb_count);
+        if (crumb_words && word_similarity(words, word_count, crumb_words, crumb_count) >= MEMORY_NEAR_SIMILARITY) {
+            found = i;
+        }
+        free(crumb_words);
+    }
+    free(words);
+    return found;
+}
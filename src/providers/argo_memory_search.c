@@ -0,0 +1,501 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Memory Search - BM25 ranking over an inverted term index */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <time.h>
+
+/* Project includes */
+#include "argo_memory.h"
+#include "argo_memory_internal.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_log.h"
+
+/* FNV-1a 64 */
+#define FNV64_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV64_PRIME 0x100000001b3ULL
+
+#define MEMORY_POSTINGS_INITIAL 4
+
+/* BM25 posting - one item containing the term */
+typedef struct {
+    uint32_t memory_id;
+    uint32_t frequency;         /* Occurrences in the item */
+} memory_posting_t;
+
+/* Term slot (open addressing on the 64-bit term hash, 0 marks a free slot;
+ * terms are identified by hash alone) */
+typedef struct {
+    uint64_t hash;
+    memory_posting_t* postings;
+    uint32_t count;
+    uint32_t capacity;
+} memory_term_t;
+
+/* Inverted index */
+struct memory_terms {
+    memory_term_t* table;
+    size_t size;
+    size_t used;
+
+    /* Per item, by id */
+    uint32_t* doc_length;       /* Indexed terms */
+    float* accum;               /* Query scratch: BM25 sum */
+    uint32_t* touched;          /* Query scratch: ids with accum set */
+    size_t doc_capacity;
+
+    uint32_t docs;
+    uint64_t total_length;
+};
+
+/* Ranked candidate */
+typedef struct {
+    float score;
+    uint32_t memory_id;
+} memory_rank_t;
+
+/* Query term */
+typedef struct {
+    uint64_t hash;
+    const memory_term_t* term;
+} memory_query_term_t;
+
+/* Helper: Next word of min_length or more (lowercased FNV-1a); returns 0 when done */
+static size_t next_term(const char** cursor, uint64_t* hash, size_t min_length) {
+    const unsigned char* p = (const unsigned char*)*cursor;
+    for (;;) {
+        while (*p && !isalnum(*p)) p++;
+        if (!*p) break;
+
+        uint64_t h = FNV64_OFFSET_BASIS;
+        size_t length = 0;
+        while (*p && isalnum(*p)) {
+            h = (h ^ (uint64_t)tolower(*p)) * FNV64_PRIME;
+            length++;
+            p++;
+        }
+        if (length >= min_length) {
+            *cursor = (const char*)p;
+            *hash = h ? h : 1;
+            return length;
+        }
+    }
+    *cursor = (const char*)p;
+    return 0;
+}
+
+/* Helper: qsort order for term hashes */
+static int compare_hash(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* Helper: Hashes of all words of min_length or more, sorted (caller frees) */
+static uint64_t* collect_words(const char* text, size_t* count, size_t min_length) {
+    size_t capacity = strlen(text) / (min_length + 1) + 1;
+    uint64_t* hashes = malloc(capacity * sizeof(uint64_t));
+    *count = 0;
+    if (!hashes) return NULL;
+
+    uint64_t hash = 0;
+    while (next_term(&text, &hash, min_length) > 0) {
+        hashes[(*count)++] = hash;
+    }
+    qsort(hashes, *count, sizeof(uint64_t), compare_hash);
+    return hashes;
+}
+
+/* Helper: Hashes of all indexed words, sorted (caller frees) */
+static uint64_t* collect_terms(const char* text, size_t* count) {
+    return collect_words(text, count, MEMORY_TERM_MIN_LENGTH);
+}
+
+/* Every word, short ones included, as sorted hashes (caller frees) */
+uint64_t* memory_text_words(const char* text, size_t* count) {
+    return collect_words(text, count, 1);
+}
+
+/* Helper: Slot for a term hash (existing or free) */
+static memory_term_t* term_slot(const struct memory_terms* terms, uint64_t hash) {
+    size_t mask = terms->size - 1;
+    size_t slot = (size_t)hash & mask;
+    while (terms->table[slot].hash != 0 && terms->table[slot].hash != hash) {
+        slot = (slot + 1) & mask;
+    }
+    return &terms->table[slot];
+}
+
+/* Helper: Double the term table */
+static int grow_table(struct memory_terms* terms) {
+    struct memory_terms grown = *terms;
+    grown.size = terms->size * 2;
+    grown.table = calloc(grown.size, sizeof(memory_term_t));
+    if (!grown.table) return E_SYSTEM_MEMORY;
+
+    for (size_t i = 0; i < terms->size; i++) {
+        if (terms->table[i].hash != 0) {
+            *term_slot(&grown, terms->table[i].hash) = terms->table[i];
+        }
+    }
+    free(terms->table);
+    terms->table = grown.table;
+    terms->size = grown.size;
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Make room for memory_id in the per-item arrays */
+static int ensure_docs(struct memory_terms* terms, uint32_t memory_id) {
+    if (memory_id < terms->doc_capacity) return ARGO_SUCCESS;
+
+    size_t capacity = terms->doc_capacity * 2;
+    while (capacity <= memory_id) capacity *= 2;
+    uint32_t* doc_length = realloc(terms->doc_length, capacity * sizeof(uint32_t));
+    if (doc_length) terms->doc_length = doc_length;
+    float* accum = realloc(terms->accum, capacity * sizeof(float));
+    if (accum) terms->accum = accum;
+    uint32_t* touched = realloc(terms->touched, capacity * sizeof(uint32_t));
+    if (touched) terms->touched = touched;
+    if (!doc_length || !accum || !touched) return E_SYSTEM_MEMORY;
+
+    size_t added = capacity - terms->doc_capacity;
+    memset(terms->doc_length + terms->doc_capacity, 0, added * sizeof(uint32_t));
+    memset(terms->accum + terms->doc_capacity, 0, added * sizeof(float));
+    terms->doc_capacity = capacity;
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Append one posting */
+static int add_posting(struct memory_terms* terms, uint64_t hash, uint32_t memory_id, uint32_t frequency) {
+    if ((terms->used + 1) * 100 > terms->size * MEMORY_INDEX_LOAD_PERCENT &&
+        grow_table(terms) != ARGO_SUCCESS) {
+        return E_SYSTEM_MEMORY;
+    }
+
+    memory_term_t* term = term_slot(terms, hash);
+    if (term->count == term->capacity) {
+        uint32_t capacity = term->capacity ? term->capacity * 2 : MEMORY_POSTINGS_INITIAL;
+        memory_posting_t* postings = realloc(term->postings, capacity * sizeof(memory_posting_t));
+        if (!postings) return E_SYSTEM_MEMORY;
+        term->postings = postings;
+        term->capacity = capacity;
+    }
+    if (term->hash == 0) {
+        term->hash = hash;
+        terms->used++;
+    }
+    term->postings[term->count++] = (memory_posting_t){ memory_id, frequency };
+    return ARGO_SUCCESS;
+}
+
+/* Create inverted index */
+struct memory_terms* memory_terms_create(void) {
+    struct memory_terms* terms = calloc(1, sizeof(struct memory_terms));
+    if (!terms) return NULL;
+
+    terms->size = MEMORY_TERMS_INITIAL;
+    terms->doc_capacity = MEMORY_INDEX_INITIAL;
+    terms->table = calloc(terms->size, sizeof(memory_term_t));
+    terms->doc_length = calloc(terms->doc_capacity, sizeof(uint32_t));
+    terms->accum = calloc(terms->doc_capacity, sizeof(float));
+    terms->touched = calloc(terms->doc_capacity, sizeof(uint32_t));
+    if (!terms->table || !terms->doc_length || !terms->accum || !terms->touched) {
+        memory_terms_destroy(terms);
+        return NULL;
+    }
+    return terms;
+}
+
+/* Destroy inverted index */
+void memory_terms_destroy(struct memory_terms* terms) {
+    if (!terms) return;
+    for (size_t i = 0; terms->table && i < terms->size; i++) {
+        free(terms->table[i].postings);
+    }
+    free(terms->table);
+    free(terms->doc_length);
+    free(terms->accum);
+    free(terms->touched);
+    free(terms);
+}
+
+/* Index one item's content */
+int memory_terms_add(struct memory_terms* terms, const memory_item_t* item) {
+    ARGO_CHECK_NULL(terms);
+    ARGO_CHECK_NULL(item);
+
+    size_t count = 0;
+    uint64_t* hashes = collect_terms(item->content, &count);
+    int result = hashes ? ensure_docs(terms, item->id) : E_SYSTEM_MEMORY;
+
+    /* Sorted hashes: each run is one term and its frequency */
+    for (size_t start = 0; result == ARGO_SUCCESS && start < count;) {
+        size_t end = start + 1;
+        while (end < count && hashes[end] == hashes[start]) end++;
+        result = add_posting(terms, hashes[start], item->id, (uint32_t)(end - start));
+        start = end;
+    }
+    free(hashes);
+    if (result != ARGO_SUCCESS) {
+        argo_report_error(E_SYSTEM_MEMORY, "memory_add_item", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return result;
+    }
+
+    terms->doc_length[item->id] = (uint32_t)count;
+    terms->docs++;
+    terms->total_length += count;
+    return ARGO_SUCCESS;
+}
+
+/* Index every stored item (first search after a mapped load) */
+int memory_terms_build(ci_memory_digest_t* digest) {
+    ARGO_CHECK_NULL(digest);
+    struct memory_terms* terms = memory_terms_create();
+    if (!terms) {
+        argo_report_error(E_SYSTEM_MEMORY, "memory_suggest_relevant", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return E_SYSTEM_MEMORY;
+    }
+    for (uint32_t id = 1; id < digest->next_id; id++) {
+        memory_item_t* item = memory_find_item(digest, id);
+        int result = item ? memory_terms_add(terms, item) : ARGO_SUCCESS;
+        if (result != ARGO_SUCCESS) {
+            memory_terms_destroy(terms);
+            return result;
+        }
+    }
+    digest->terms = terms;
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Accumulate BM25 for the query into accum/touched
+ *
+ * Only terms in at most half the items count: the others have an idf
+ * near zero and the longest postings. Returns the number of touched items.
+ */
+static uint32_t score_query(struct memory_terms* terms, const char* query) {
+    memory_query_term_t unique[MEMORY_QUERY_TERMS_MAX];
+    int count = 0;
+    uint64_t hash = 0;
+
+    while (count < MEMORY_QUERY_TERMS_MAX && next_term(&query, &hash, MEMORY_TERM_MIN_LENGTH) > 0) {
+        bool seen = false;
+        for (int i = 0; i < count && !seen; i++) seen = unique[i].hash == hash;
+        if (seen) continue;
+        const memory_term_t* term = term_slot(terms, hash);
+        if (term->hash != 0 && term->count * 2 <= terms->docs) {
+            unique[count++] = (memory_query_term_t){ hash, term };
+        }
+    }
+
+    uint32_t touched = 0;
+    float average = terms->docs ? (float)terms->total_length / (float)terms->docs : 1.0f;
+    for (int i = 0; i < count; i++) {
+        const memory_term_t* term = unique[i].term;
+        float idf = logf(1.0f + ((float)terms->docs - (float)term->count + 0.5f) /
+                                ((float)term->count + 0.5f));
+        for (uint32_t p = 0; p < term->count; p++) {
+            uint32_t id = term->postings[p].memory_id;
+            float frequency = (float)term->postings[p].frequency;
+            float norm = 1.0f - MEMORY_BM25_B + MEMORY_BM25_B * (float)terms->doc_length[id] / average;
+            if (terms->accum[id] == 0.0f) terms->touched[touched++] = id;
+            terms->accum[id] += idf * frequency * (MEMORY_BM25_K1 + 1.0f) /
+                                (frequency + MEMORY_BM25_K1 * norm);
+        }
+    }
+    return touched;
+}
+
+/* Helper: Blend text match (0..1) with what the digest knows about the item */
+static float blend_score(const ci_memory_digest_t* digest, const memory_item_t* item,
+                         float match, time_t now) {
+    double age = difftime(now, item->relevance.last_accessed);
+    float recency = 1.0f / (1.0f + (float)(age > 0 ? age : 0) / MEMORY_RECENCY_SECONDS);
+    float access = (float)item->relevance.access_count /
+                   ((float)item->relevance.access_count + MEMORY_ACCESS_SATURATION);
+    return MEMORY_WEIGHT_MATCH * match +
+           MEMORY_WEIGHT_STORED * memory_stored_relevance(digest, item, now) +
+           MEMORY_WEIGHT_RECENCY * recency +
+           MEMORY_WEIGHT_ACCESS * access +
+           (item->relevance.ci_marked_important ? MEMORY_WEIGHT_IMPORTANT : 0.0f);
+}
+
+/* Helper: Sift a min-heap entry down (worst candidate at the root) */
+static void heap_sift_down(memory_rank_t* heap, int count, int at) {
+    for (;;) {
+        int worst = at;
+        int left = 2 * at + 1;
+        int right = left + 1;
+        if (left < count && heap[left].score < heap[worst].score) worst = left;
+        if (right < count && heap[right].score < heap[worst].score) worst = right;
+        if (worst == at) return;
+        memory_rank_t swap = heap[at];
+        heap[at] = heap[worst];
+        heap[worst] = swap;
+        at = worst;
+    }
+}
+
+/* Helper: Offer a candidate to the bounded heap of the k best */
+static void heap_offer(memory_rank_t* heap, int* count, int k, float score, uint32_t memory_id) {
+    if (*count < k) {
+        int at = (*count)++;
+        heap[at] = (memory_rank_t){ score, memory_id };
+        while (at > 0 && heap[(at - 1) / 2].score > heap[at].score) {
+            memory_rank_t swap = heap[at];
+            heap[at] = heap[(at - 1) / 2];
+            heap[(at - 1) / 2] = swap;
+            at = (at - 1) / 2;
+        }
+    } else if (score > heap[0].score) {
+        heap[0] = (memory_rank_t){ score, memory_id };
+        heap_sift_down(heap, *count, 0);
+    }
+}
+
+/* Helper: Rerank candidates on the blend into the k best unselected */
+static int rerank(ci_memory_digest_t* digest, const memory_rank_t* candidates, int candidate_count,
+                  float best_match, memory_rank_t* heap, int k) {
+    int count = 0;
+    time_t now = time(NULL);
+    for (int i = 0; i < candidate_count; i++) {
+        memory_item_t* item = memory_find_item(digest, candidates[i].memory_id);
+        if (!item || item->selected) continue;
+        float match = best_match > 0.0f ? candidates[i].score / best_match : 0.0f;
+        heap_offer(heap, &count, k, blend_score(digest, item, match, now), item->id);
+    }
+    return count;
+}
+
+/* Helper: Candidates from the ranking, best decayed stored score first */
+static int top_candidates(ci_memory_digest_t* digest, int type, memory_rank_t* candidates) {
+    uint32_t ids[MEMORY_RERANK_CANDIDATES];
+    int count = memory_ranking_top(digest, type, ids, MEMORY_RERANK_CANDIDATES);
+    for (int i = 0; i < count; i++) {
+        candidates[i] = (memory_rank_t){ 0.0f, ids[i] };
+    }
+    return count;
+}
+
+/* Helper: Fill suggested[] best first within the remaining budget */
+static int fill_suggestions(ci_memory_digest_t* digest, memory_rank_t* heap, int count) {
+    /* Pop worst to the back: heap[] ends up best first */
+    for (int end = count - 1; end > 0; end--) {
+        memory_rank_t swap = heap[0];
+        heap[0] = heap[end];
+        heap[end] = swap;
+        heap_sift_down(heap, end, 0);
+    }
+
+    size_t used = memory_calculate_size(digest);
+    for (int i = 0; i < count; i++) {
+        memory_item_t* item = memory_find_item(digest, heap[i].memory_id);
+        if (used + item->content_size > digest->max_allowed_size) continue;
+        used += item->content_size;
+        digest->suggested[digest->suggestion_count++] = item;
+    }
+    return digest->suggestion_count;
+}
+
+/* Suggest items relevant to the task
+ *
+ * Two stages: BM25 over the inverted index keeps the best
+ * MEMORY_RERANK_CANDIDATES text matches, which are then reranked with
+ * their match (relative to the best) blended with stored relevance,
+ * recency and use. A task with no selective word reranks the
+ * MEMORY_RERANK_CANDIDATES items with the best decayed stored score on
+ * the blend alone.
+ */
+int memory_suggest_relevant(ci_memory_digest_t* digest, const char* task_context,
+                            int max_suggestions) {
+    memory_rank_t candidates[MEMORY_RERANK_CANDIDATES];
+    memory_rank_t heap[MEMORY_SUGGESTION_MAX];
+    int candidate_count = 0;
+    float best = 0.0f;
+
+    if (!digest) return 0;
+    digest->suggestion_count = 0;
+    int k = max_suggestions < MEMORY_SUGGESTION_MAX ? max_suggestions : MEMORY_SUGGESTION_MAX;
+    if (k <= 0) return 0;
+
+    if (!digest->terms && memory_terms_build(digest) != ARGO_SUCCESS) return 0;
+    struct memory_terms* terms = digest->terms;
+    uint32_t touched = task_context ? score_query(terms, task_context) : 0;
+    for (uint32_t i = 0; i < touched; i++) {
+        uint32_t id = terms->touched[i];
+        float value = terms->accum[id];
+        terms->accum[id] = 0.0f;
+        if (value > best) best = value;
+        heap_offer(candidates, &candidate_count, MEMORY_RERANK_CANDIDATES, value, id);
+    }
+    if (touched == 0) {
+        candidate_count = top_candidates(digest, -1, candidates);
+    }
+
+    int count = rerank(digest, candidates, candidate_count, best, heap, k);
+    return fill_suggestions(digest, heap, count);
+}
+
+/* Suggest items of one type - the best stored scores of the type,
+ * reranked on the blend alone */
+int memory_suggest_by_type(ci_memory_digest_t* digest, memory_type_t type,
+                           int max_suggestions) {
+    memory_rank_t candidates[MEMORY_RERANK_CANDIDATES];
+    memory_rank_t heap[MEMORY_SUGGESTION_MAX];
+
+    if (!digest) return 0;
+    digest->suggestion_count = 0;
+    int k = max_suggestions < MEMORY_SUGGESTION_MAX ? max_suggestions : MEMORY_SUGGESTION_MAX;
+    if (k <= 0) return 0;
+
+    int candidate_count = top_candidates(digest, (int)type, candidates);
+    int count = rerank(digest, candidates, candidate_count, 0.0f, heap, k);
+    return fill_suggestions(digest, heap, count);
+}
+
+/* Relevance of one item to a task - share of task words in the item */
+float memory_calculate_relevance(ci_memory_digest_t* digest, memory_item_t* item,
+                                 const char* current_task) {
+    if (!digest || !item) return 0.0f;
+
+    float match = 0.0f;
+    size_t task_count = 0;
+    size_t item_count = 0;
+    uint64_t* task = current_task ? collect_terms(current_task, &task_count) : NULL;
+    uint64_t* words = task_count > 0 ? collect_terms(item->content, &item_count) : NULL;
+    if (task && words) {
+        size_t found = 0;
+        for (size_t i = 0; i < task_count; i++) {
+            if (bsearch(&task[i], words, item_count, sizeof(uint64_t), compare_hash)) found++;
+        }
+        match = (float)found / (float)task_count;
+    }
+    free(task);
+    free(words);
+
+    float score = blend_score(digest, item, match, time(NULL));
+    return score > 1.0f ? 1.0f : score;
+}
+
+/* Approximate token count - words by length, marks and newlines one each */
+size_t memory_estimate_tokens(const char* text, size_t length) {
+    if (!text) return 0;
+
+    size_t tokens = 0;
+    size_t run = 0;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (isalnum(c) || c >= 0x80) {
+            run++;
+            continue;
+        }
+        tokens += (run + MEMORY_TOKEN_BYTES - 1) / MEMORY_TOKEN_BYTES;
+        run = 0;
+        if (c == '\n' || !isspace(c)) tokens++;
+    }
+    return tokens + (run + MEMORY_TOKEN_BYTES - 1) / MEMORY_TOKEN_BYTES;
+}
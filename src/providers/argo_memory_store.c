@@ -0,0 +1,566 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Memory Store - memory-mapped binary digest format */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <math.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Project includes */
+#include "argo_memory.h"
+#include "argo_memory_internal.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_log.h"
+#include "argo_limits.h"
+#include "argo_filesystem.h"
+#include "argo_file_utils.h"
+
+#define MEMORY_STORE_NONE UINT64_MAX            /* String offset of an unset field */
+#define MEMORY_STORE_RECORD_MAGIC 0x4d454d52U   /* Journal record marker */
+#define MEMORY_STORE_TEMP_SUFFIX ".XXXXXX"
+#define MEMORY_STORE_ALIGN 8
+#define MEMORY_STORE_IMPORTANT 0x1U
+#define MEMORY_STORE_SELECTED 0x2U
+
+/* File header */
+typedef struct {
+    char magic[8];                  /* MEMORY_STORE_MAGIC */
+    uint32_t version;
+    uint32_t item_count;
+    uint32_t next_id;
+    uint32_t journal_next_id;       /* Items below this id are on disk */
+    uint32_t index_size;
+    uint32_t breadcrumb_count;
+    int64_t created;
+    double decay_epoch;
+    uint64_t items_offset;          /* memory_store_item_t[item_count] */
+    uint64_t index_offset;          /* memory_index_t[index_size] */
+    uint64_t breadcrumbs_offset;    /* uint64_t string offsets */
+    uint64_t strings_offset;
+    uint64_t strings_size;
+    uint64_t sunset_offset;
+    uint64_t sunrise_offset;
+    uint64_t base_size;             /* Journal records follow */
+    char session_id[32];
+    char ci_name[32];
+} memory_store_header_t;
+
+/* Item table entry (string offsets are into the pool, or the record's
+ * strings for journal records) */
+typedef struct {
+    uint32_t id;
+    uint32_t type;
+    uint64_t content_offset;
+    uint64_t content_size;
+    uint64_t creator_offset;
+    uint64_t creator_size;
+    int64_t created;
+    int64_t last_accessed;
+    float score;
+    int32_t access_count;
+    uint32_t flags;
+    uint32_t tokens;                /* Cached token estimate of the content */
+    double decay_stamp;
+} memory_store_item_t;
+
+/* Journal record - followed by content and creator, NUL-terminated */
+typedef struct {
+    uint32_t magic;
+    uint32_t length;                /* String bytes after the record */
+    memory_store_item_t item;
+} memory_store_record_t;
+
+/* Mapping backing a loaded digest */
+struct memory_store {
+    void* map;
+    size_t size;
+    memory_item_t* items;           /* One block for all base items */
+};
+
+/* Release mapping */
+void memory_store_release(struct memory_store* store) {
+    if (!store) return;
+    if (store->map) munmap(store->map, store->size);
+    free(store->items);
+    free(store);
+}
+
+/* Helper: Round up to MEMORY_STORE_ALIGN */
+static size_t store_align(size_t size) {
+    return (size + MEMORY_STORE_ALIGN - 1) & ~(size_t)(MEMORY_STORE_ALIGN - 1);
+}
+
+/* Helper: Write the whole buffer */
+static bool write_all(int fd, const char* data, size_t len) {
+    size_t written = 0;
+    while (written < len) {
+        ssize_t n = write(fd, data + written, len - written);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        written += (size_t)n;
+    }
+    return true;
+}
+
+/* Helper: Copy text into the pool, return its offset */
+static uint64_t pool_put(char* pool, size_t* used, const char* text, size_t len) {
+    uint64_t offset = *used;
+    memcpy(pool + offset, text, len + 1);
+    *used += len + 1;
+    return offset;
+}
+
+/* Helper: NUL-terminated string of len bytes at offset, NULL if out of bounds */
+static const char* pool_string(const char* pool, uint64_t pool_size, uint64_t offset, uint64_t len) {
+    if (offset >= pool_size || len >= pool_size - offset || pool[offset + len] != '\0') return NULL;
+    return pool + offset;
+}
+
+/* Helper: NUL-terminated string at offset of unknown length */
+static const char* pool_text(const char* pool, uint64_t pool_size, uint64_t offset) {
+    if (offset >= pool_size || !memchr(pool + offset, '\0', pool_size - offset)) return NULL;
+    return pool + offset;
+}
+
+/* Helper: Item table entry for an item */
+static void pack_item(const memory_item_t* item, memory_store_item_t* record,
+                      uint64_t content_offset, uint64_t creator_offset) {
+    record->id = item->id;
+    record->type = (uint32_t)item->type;
+    record->content_offset = content_offset;
+    record->content_size = item->content_size;
+    record->tokens = item->tokens;
+    record->creator_offset = creator_offset;
+    record->creator_size = item->creator_ci ? strlen(item->creator_ci) : 0;
+    record->created = (int64_t)item->created;
+    record->last_accessed = (int64_t)item->relevance.last_accessed;
+    record->score = item->relevance.score;
+    record->decay_stamp = item->relevance.decay_stamp;
+    record->access_count = item->relevance.access_count;
+    record->flags = (item->relevance.ci_marked_important ? MEMORY_STORE_IMPORTANT : 0) |
+                    (item->selected ? MEMORY_STORE_SELECTED : 0);
+}
+
+/* Helper: Score and stamp are usable */
+static bool relevance_valid(const memory_store_item_t* record) {
+    return record->score >= 0.0f && record->score <= 1.0f && isfinite(record->decay_stamp);
+}
+
+/* Helper: Apply an entry's relevance to an item */
+static void unpack_relevance(ci_memory_digest_t* digest, memory_item_t* item,
+                             const memory_store_item_t* record) {
+    memory_set_score(digest, item, record->score, record->decay_stamp);
+    item->relevance.access_count = record->access_count;
+    item->relevance.last_accessed = (time_t)record->last_accessed;
+    item->relevance.ci_marked_important = (record->flags & MEMORY_STORE_IMPORTANT) != 0;
+}
+
+/* Helper: Bytes of pool needed for a string (0 when unset) */
+static size_t pool_need(const char* text) {
+    return text ? strlen(text) + 1 : 0;
+}
+
+/* Helper: Lay out a compacted store image (caller frees) */
+static char* build_image(ci_memory_digest_t* digest, size_t* image_size) {
+    size_t pool_size = pool_need(digest->sunset_notes) + pool_need(digest->sunrise_brief);
+    for (int i = 0; i < digest->breadcrumb_count; i++) pool_size += pool_need(digest->breadcrumbs[i]);
+    for (memory_item_t* item = digest->items; item; item = item->next) {
+        pool_size += item->content_size + 1 + pool_need(item->creator_ci);
+    }
+
+    size_t items_offset = store_align(sizeof(memory_store_header_t));
+    size_t index_offset = store_align(items_offset + (size_t)digest->item_count * sizeof(memory_store_item_t));
+    size_t crumbs_offset = store_align(index_offset + digest->index_size * sizeof(memory_index_t));
+    size_t strings_offset = crumbs_offset + (size_t)digest->breadcrumb_count * sizeof(uint64_t);
+    size_t size = store_align(strings_offset + pool_size);
+
+    char* image = calloc(1, size);
+    uint32_t* position = calloc(digest->next_id, sizeof(uint32_t));
+    if (!image || !position) {
+        argo_report_error(E_SYSTEM_MEMORY, "memory_save_to_file", ERR_MSG_MEMORY_ALLOC_FAILED);
+        free(image);
+        free(position);
+        return NULL;
+    }
+
+    memory_store_header_t* header = (memory_store_header_t*)image;
+    memcpy(header->magic, MEMORY_STORE_MAGIC, sizeof(header->magic));
+    header->version = MEMORY_STORE_VERSION;
+    header->item_count = (uint32_t)digest->item_count;
+    header->next_id = digest->next_id;
+    header->journal_next_id = digest->next_id;
+    header->index_size = (uint32_t)digest->index_size;
+    header->breadcrumb_count = (uint32_t)digest->breadcrumb_count;
+    header->created = (int64_t)digest->created;
+    header->decay_epoch = digest->decay_epoch;
+    header->items_offset = items_offset;
+    header->index_offset = index_offset;
+    header->breadcrumbs_offset = crumbs_offset;
+    header->strings_offset = strings_offset;
+    header->strings_size = pool_size;
+    header->base_size = size;
+    memcpy(header->session_id, digest->session_id, sizeof(header->session_id));
+    memcpy(header->ci_name, digest->ci_name, sizeof(header->ci_name));
+
+    char* pool = image + strings_offset;
+    size_t used = 0;
+    header->sunset_offset = digest->sunset_notes
+        ? pool_put(pool, &used, digest->sunset_notes, strlen(digest->sunset_notes)) : MEMORY_STORE_NONE;
+    header->sunrise_offset = digest->sunrise_brief
+        ? pool_put(pool, &used, digest->sunrise_brief, strlen(digest->sunrise_brief)) : MEMORY_STORE_NONE;
+    uint64_t* crumbs = (uint64_t*)(image + crumbs_offset);
+    for (int i = 0; i < digest->breadcrumb_count; i++) {
+        crumbs[i] = pool_put(pool, &used, digest->breadcrumbs[i], strlen(digest->breadcrumbs[i]));
+    }
+
+    /* Items in id order; the index records where each entry lives */
+    memory_store_item_t* records = (memory_store_item_t*)(image + items_offset);
+    uint32_t count = 0;
+    for (uint32_t id = 1; id < digest->next_id; id++) {
+        memory_item_t* item = memory_find_item(digest, id);
+        if (!item) continue;
+        uint64_t content = pool_put(pool, &used, item->content, item->content_size);
+        uint64_t creator = item->creator_ci
+            ? pool_put(pool, &used, item->creator_ci, strlen(item->creator_ci)) : MEMORY_STORE_NONE;
+        pack_item(item, &records[count], content, creator);
+        position[id] = (uint32_t)(items_offset + count * sizeof(memory_store_item_t));
+        count++;
+    }
+
+    time_t now = time(NULL);
+    memory_index_t* index = (memory_index_t*)(image + index_offset);
+    memcpy(index, digest->index, digest->index_size * sizeof(memory_index_t));
+    for (size_t i = 0; i < digest->index_size; i++) {
+        if (index[i].hash == 0) continue;
+        index[i].offset = position[index[i].memory_id];
+        index[i].relevance_score = (uint16_t)(memory_stored_relevance(digest, digest->by_id[index[i].memory_id], now) *
+                                              UINT16_MAX);
+    }
+
+    free(position);
+    *image_size = size;
+    return image;
+}
+
+/* Save compacted store via temp file + rename */
+int memory_save_to_file(ci_memory_digest_t* digest, const char* filepath) {
+    ARGO_CHECK_NULL(digest);
+    ARGO_CHECK_NULL(filepath);
+
+    size_t size = 0;
+    char* image = build_image(digest, &size);
+    if (!image) return E_SYSTEM_MEMORY;
+
+    char temp[ARGO_PATH_MAX];
+    snprintf(temp, sizeof(temp), "%s%s", filepath, MEMORY_STORE_TEMP_SUFFIX);
+    int fd = mkstemp(temp);
+    if (fd < 0) {
+        argo_report_error(E_SYSTEM_FILE, "memory_save_to_file", ERR_FMT_SYSCALL_ERROR, temp, strerror(errno));
+        free(image);
+        return E_SYSTEM_FILE;
+    }
+    fchmod(fd, ARGO_FILE_MODE_PRIVATE);
+
+    bool ok = write_all(fd, image, size);
+    ok = (close(fd) == 0) && ok;
+    free(image);
+
+    if (!ok || rename(temp, filepath) != 0) {
+        argo_report_error(E_SYSTEM_FILE, "memory_save_to_file", ERR_FMT_SYSCALL_ERROR, filepath, strerror(errno));
+        unlink(temp);
+        return E_SYSTEM_FILE;
+    }
+    LOG_DEBUG("Saved memory digest to %s (%d items, %zu bytes)", filepath, digest->item_count, size);
+    return ARGO_SUCCESS;
+}
+
+/* Append items created since the file was written */
+int memory_store_append(ci_memory_digest_t* digest, const char* filepath) {
+    ARGO_CHECK_NULL(digest);
+    ARGO_CHECK_NULL(filepath);
+
+    int fd = open(filepath, O_RDWR);
+    if (fd < 0) return memory_save_to_file(digest, filepath);
+
+    memory_store_header_t header;
+    struct stat st;
+    bool ours = pread(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header) &&
+                memcmp(header.magic, MEMORY_STORE_MAGIC, sizeof(header.magic)) == 0 &&
+                header.version == MEMORY_STORE_VERSION &&
+                fstat(fd, &st) == 0 && (uint64_t)st.st_size >= header.base_size;
+    if (!ours) {
+        close(fd);
+        return memory_save_to_file(digest, filepath);
+    }
+
+    size_t pending = 0;
+    for (uint32_t id = header.journal_next_id; id < digest->next_id; id++) {
+        memory_item_t* item = memory_find_item(digest, id);
+        if (item) {
+            pending += store_align(sizeof(memory_store_record_t) + item->content_size + 1 +
+                                   pool_need(item->creator_ci));
+        }
+    }
+    uint64_t journal = (uint64_t)st.st_size - header.base_size;
+    if (pending == 0) {
+        close(fd);
+        return ARGO_SUCCESS;
+    }
+    /* A torn tail leaves the journal unaligned; rewriting drops it */
+    if (journal % MEMORY_STORE_ALIGN != 0 ||
+        (journal + pending) * 100 > header.base_size * MEMORY_STORE_COMPACT_PERCENT) {
+        close(fd);
+        LOG_DEBUG("Compacting memory store %s", filepath);
+        return memory_save_to_file(digest, filepath);
+    }
+
+    char* buffer = calloc(1, pending);
+    if (!buffer) {
+        close(fd);
+        argo_report_error(E_SYSTEM_MEMORY, "memory_store_append", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return E_SYSTEM_MEMORY;
+    }
+    size_t at = 0;
+    for (uint32_t id = header.journal_next_id; id < digest->next_id; id++) {
+        memory_item_t* item = memory_find_item(digest, id);
+        if (!item) continue;
+        memory_store_record_t* record = (memory_store_record_t*)(buffer + at);
+        char* strings = buffer + at + sizeof(memory_store_record_t);
+        size_t used = 0;
+        uint64_t content = pool_put(strings, &used, item->content, item->content_size);
+        uint64_t creator = item->creator_ci
+            ? pool_put(strings, &used, item->creator_ci, strlen(item->creator_ci)) : MEMORY_STORE_NONE;
+        record->magic = MEMORY_STORE_RECORD_MAGIC;
+        record->length = (uint32_t)used;
+        pack_item(item, &record->item, content, creator);
+        at += store_align(sizeof(memory_store_record_t) + used);
+    }
+
+    /* Records first, then the header that admits them */
+    header.journal_next_id = digest->next_id;
+    bool ok = lseek(fd, st.st_size, SEEK_SET) == st.st_size && write_all(fd, buffer, pending) &&
+              pwrite(fd, &header.journal_next_id, sizeof(header.journal_next_id),
+                     offsetof(memory_store_header_t, journal_next_id)) == (ssize_t)sizeof(uint32_t);
+    ok = (close(fd) == 0) && ok;
+    free(buffer);
+    if (!ok) {
+        argo_report_error(E_SYSTEM_FILE, "memory_store_append", ERR_FMT_SYSCALL_ERROR, filepath, strerror(errno));
+        return E_SYSTEM_FILE;
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Check header offsets against the mapping */
+static bool header_valid(const memory_store_header_t* header, size_t size) {
+    return size >= sizeof(*header) &&
+           memcmp(header->magic, MEMORY_STORE_MAGIC, sizeof(header->magic)) == 0 &&
+           header->version == MEMORY_STORE_VERSION && isfinite(header->decay_epoch) &&
+           header->base_size <= size &&
+           header->strings_offset <= header->base_size &&
+           header->strings_size <= header->base_size - header->strings_offset &&
+           header->base_size % MEMORY_STORE_ALIGN == 0 &&
+           header->items_offset + (uint64_t)header->item_count * sizeof(memory_store_item_t) <= header->index_offset &&
+           header->index_offset + (uint64_t)header->index_size * sizeof(memory_index_t) <= header->breadcrumbs_offset &&
+           header->breadcrumbs_offset + (uint64_t)header->breadcrumb_count * sizeof(uint64_t) <= header->strings_offset &&
+           header->index_size > 0 && (header->index_size & (header->index_size - 1)) == 0 &&
+           header->item_count < header->next_id && header->item_count <= header->index_size &&
+           header->breadcrumb_count <= MEMORY_BREADCRUMB_MAX;
+}
+
+/* Helper: Point the digest at the mapped item table and index */
+static int attach_base(ci_memory_digest_t* digest, const char* map, const memory_store_header_t* header) {
+    const memory_store_item_t* records = (const memory_store_item_t*)(map + header->items_offset);
+    const char* pool = map + header->strings_offset;
+    memory_item_t* items = digest->store->items;
+
+    digest->by_id = calloc(header->next_id, sizeof(memory_item_t*));
+    if (!digest->by_id) return E_SYSTEM_MEMORY;
+    digest->by_id_capacity = header->next_id;
+
+    for (uint32_t i = 0; i < header->item_count; i++) {
+        const memory_store_item_t* record = &records[i];
+        memory_item_t* item = &items[i];
+        const char* content = pool_string(pool, header->strings_size, record->content_offset, record->content_size);
+        const char* creator = record->creator_offset == MEMORY_STORE_NONE ? NULL
+            : pool_string(pool, header->strings_size, record->creator_offset, record->creator_size);
+        if (record->id == 0 || record->id >= header->next_id || digest->by_id[record->id] ||
+            record->type > MEMORY_TYPE_RELATIONSHIP || !content || !relevance_valid(record) ||
+            record->tokens > record->content_size ||
+            (record->creator_offset != MEMORY_STORE_NONE && !creator)) {
+            return E_INPUT_FORMAT;
+        }
+
+        item->id = record->id;
+        item->type = (memory_type_t)record->type;
+        item->content = (char*)content;         /* Read-only mapping, never written */
+        item->content_size = record->content_size;
+        item->tokens = record->tokens;
+        item->creator_ci = (char*)creator;
+        item->created = (time_t)record->created;
+        unpack_relevance(digest, item, record);
+        item->next = digest->items;
+        digest->items = item;
+        digest->by_id[item->id] = item;
+        if (record->flags & MEMORY_STORE_SELECTED) memory_restore_selection(digest, item);
+    }
+    digest->item_count = (int)header->item_count;
+    digest->next_id = header->next_id;
+
+    /* Every occupied slot must name a loaded item before the index is trusted */
+    const memory_index_t* index = (const memory_index_t*)(map + header->index_offset);
+    uint32_t occupied = 0;
+    for (uint32_t i = 0; i < header->index_size; i++) {
+        if (index[i].hash == 0) continue;
+        if (index[i].memory_id >= header->next_id || !digest->by_id[index[i].memory_id]) return E_INPUT_FORMAT;
+        occupied++;
+    }
+    if (occupied != header->item_count) return E_INPUT_FORMAT;
+
+    free(digest->index);
+    digest->index = (memory_index_t*)index;
+    digest->index_mapped = true;
+    digest->index_size = header->index_size;
+    digest->index_count = occupied;
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Notes and breadcrumbs are few; the digest owns copies */
+static int attach_notes(ci_memory_digest_t* digest, const char* map, const memory_store_header_t* header) {
+    const char* pool = map + header->strings_offset;
+    const char* notes = header->sunset_offset == MEMORY_STORE_NONE ? NULL
+        : pool_text(pool, header->strings_size, header->sunset_offset);
+    const char* brief = header->sunrise_offset == MEMORY_STORE_NONE ? NULL
+        : pool_text(pool, header->strings_size, header->sunrise_offset);
+    if ((header->sunset_offset != MEMORY_STORE_NONE && !notes) ||
+        (header->sunrise_offset != MEMORY_STORE_NONE && !brief)) {
+        return E_INPUT_FORMAT;
+    }
+    int result = notes ? memory_set_sunset_notes(digest, notes) : ARGO_SUCCESS;
+    if (result == ARGO_SUCCESS && brief) result = memory_set_sunrise_brief(digest, brief);
+
+    const uint64_t* crumbs = (const uint64_t*)(map + header->breadcrumbs_offset);
+    for (uint32_t i = 0; result == ARGO_SUCCESS && i < header->breadcrumb_count; i++) {
+        const char* crumb = pool_text(pool, header->strings_size, crumbs[i]);
+        result = crumb ? memory_add_breadcrumb(digest, crumb) : E_INPUT_FORMAT;
+    }
+    return result;
+}
+
+/* Helper: Replay journal records after the base; a torn tail ends the replay */
+static int replay_journal(ci_memory_digest_t* digest, const char* map, size_t size, uint64_t at) {
+    while (at + sizeof(memory_store_record_t) <= size) {
+        const memory_store_record_t* record = (const memory_store_record_t*)(map + at);
+        if (record->magic != MEMORY_STORE_RECORD_MAGIC ||
+            record->length > size - at - sizeof(memory_store_record_t)) {
+            break;
+        }
+        const char* strings = map + at + sizeof(memory_store_record_t);
+        const memory_store_item_t* entry = &record->item;
+        const char* content = pool_string(strings, record->length, entry->content_offset, entry->content_size);
+        const char* creator = entry->creator_offset == MEMORY_STORE_NONE ? NULL
+            : pool_string(strings, record->length, entry->creator_offset, entry->creator_size);
+        if (!content || entry->type > MEMORY_TYPE_RELATIONSHIP || !relevance_valid(entry)) return E_INPUT_FORMAT;
+
+        memory_item_t* item = memory_restore_item(digest, entry->id, (memory_type_t)entry->type,
+                                                  content, creator, (time_t)entry->created);
+        if (!item) return E_SYSTEM_MEMORY;
+        unpack_relevance(digest, item, entry);
+        if (entry->flags & MEMORY_STORE_SELECTED) memory_restore_selection(digest, item);
+        at += store_align(sizeof(memory_store_record_t) + record->length);
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Load digest - mapped store, or JSON from older files */
+ci_memory_digest_t* memory_load_from_file(const char* filepath, size_t context_limit) {
+    ci_memory_digest_t* digest = NULL;
+    int result = ARGO_SUCCESS;
+
+    if (!filepath) return NULL;
+    int fd = open(filepath, O_RDONLY);
+    if (fd < 0) {
+        LOG_DEBUG("Memory store not found: %s", filepath);
+        return NULL;
+    }
+
+    struct stat st;
+    char first = '\0';
+    if (fstat(fd, &st) != 0 || st.st_size == 0 || pread(fd, &first, 1, 0) != 1) {
+        close(fd);
+        return NULL;
+    }
+    if (first == '{') {
+        close(fd);
+        char* text = NULL;
+        if (file_read_all(filepath, &text, NULL) != ARGO_SUCCESS) return NULL;
+        digest = memory_digest_from_json(text, context_limit);
+        free(text);
+        return digest;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        argo_report_error(E_SYSTEM_MEMORY, "memory_load_from_file", ERR_FMT_SYSCALL_ERROR,
+                          ERR_MSG_MMAP_FAILED, strerror(errno));
+        return NULL;
+    }
+
+    const memory_store_header_t* header = (const memory_store_header_t*)map;
+    if (!header_valid(header, size)) {
+        munmap(map, size);
+        result = E_INPUT_FORMAT;
+        goto cleanup;
+    }
+
+    digest = memory_digest_create(context_limit);
+    struct memory_store* store = digest ? calloc(1, sizeof(struct memory_store)) : NULL;
+    if (!store) {
+        munmap(map, size);
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
+    store->map = map;
+    store->size = size;
+    digest->store = store;
+    memory_terms_destroy(digest->terms);      /* Built on first use, not on load */
+    digest->terms = NULL;
+    memory_ranking_destroy(digest->ranking);
+    digest->ranking = NULL;
+    memory_near_destroy(digest->near);
+    digest->near = NULL;
+    store->items = calloc(header->item_count ? header->item_count : 1, sizeof(memory_item_t));
+    if (!store->items) {
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
+
+    memcpy(digest->session_id, header->session_id, sizeof(digest->session_id));
+    digest->session_id[sizeof(digest->session_id) - 1] = '\0';
+    memcpy(digest->ci_name, header->ci_name, sizeof(digest->ci_name));
+    digest->ci_name[sizeof(digest->ci_name) - 1] = '\0';
+    digest->created = (time_t)header->created;
+    digest->decay_epoch = header->decay_epoch;
+
+    result = attach_base(digest, map, header);
+    if (result == ARGO_SUCCESS) result = attach_notes(digest, map, header);
+    if (result == ARGO_SUCCESS) result = replay_journal(digest, map, size, header->base_size);
+
+cleanup:
+    if (result != ARGO_SUCCESS) {
+        argo_report_error(result, "memory_load_from_file", ERR_FMT_FAILED_TO_OPEN, filepath);
+        memory_digest_destroy(digest);
+        return NULL;
+    }
+    return digest;
+}
@@ -4,14 +4,6 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <unistd.h>
-#include <errno.h>
-#include <poll.h>
-#include <sys/socket.h>
-#include <netinet/in.h>
-#include <arpa/inet.h>
-#include <netdb.h>
-#include <fcntl.h>
 
 /* Project includes */
 #include "argo_ci.h"
@@ -21,30 +13,34 @@
 #include "argo_error_messages.h"
 #include "argo_log.h"
 #include "argo_ollama.h"
-#include "argo_urls.h"
+#include "argo_ollama_transport.h"
 #include "argo_http.h"
-#include "argo_json.h"
+#include "argo_json_doc.h"
+#include "argo_json_builder.h"
+#include "argo_stream_decoder.h"
+#include "argo_provider_telemetry.h"
+#include "argo_time.h"
+#include "argo_limits.h"
 
 /* Ollama context structure */
 typedef struct ollama_context {
     /* Configuration */
-    char endpoint[OLLAMA_ENDPOINT_SIZE];
     char model[OLLAMA_MODEL_SIZE];
-    int port;
     bool use_streaming;  /* Default true */
 
-    /* Connection state */
-    int socket_fd;
-    bool connected;
-
-    /* Streaming buffer */
-    char buffer[OLLAMA_BUFFER_SIZE];
-    size_t buffer_pos;
+    /* Keep-alive connection to the server */
+    ollama_conn_t conn;
 
     /* Response accumulator */
     char* response_content;
     size_t response_size;
     size_t response_capacity;
+    bool response_truncated;    /* Accumulator could not grow */
+
+    /* Current request, for telemetry */
+    long long started_ms;       /* Monotonic */
+    long long first_byte_ms;    /* 0 until the body starts */
+    size_t received_bytes;      /* Raw body */
 
     /* Statistics */
     uint64_t total_queries;
@@ -55,6 +51,15 @@ typedef struct ollama_context {
     ci_provider_t provider;
 } ollama_context_t;
 
+/* Streaming state for one request */
+typedef struct {
+    ollama_context_t* ctx;
+    stream_decoder_t* decoder;
+    ci_stream_callback callback;
+    void* userdata;
+    provider_usage_t usage;
+} ollama_stream_state_t;
+
 /* Static function declarations */
 static int ollama_init(ci_provider_t* provider);
 static int ollama_connect(ci_provider_t* provider);
@@ -63,12 +68,11 @@ static int ollama_query(ci_provider_t* provider, const char* prompt,
 static int ollama_stream(ci_provider_t* provider, const char* prompt,
                         ci_stream_callback callback, void* userdata);
 static void ollama_cleanup(ci_provider_t* provider);
-static int ollama_disconnect(ollama_context_t* ctx);
 
-/* HTTP helpers */
-static int build_http_request(char* buffer, size_t size,
-                             const char* model, const char* prompt, bool streaming);
-static int connect_to_ollama(const char* host, int port);
+/* Request helpers */
+static char* build_generate_body(const char* model, const char* prompt, bool streaming,
+                                 size_t* body_len);
+static int check_http_status(ollama_context_t* ctx, int status, const char* func);
 
 /* Create Ollama provider */
 ci_provider_t* ollama_create_provider(const char* model_name) {
@@ -96,13 +100,14 @@ ci_provider_t* ollama_create_provider(const char* model_name) {
     ctx->provider.supports_memory = false;
     ctx->provider.max_context = OLLAMA_DEFAULT_CONTEXT_SIZE;
 
-    /* Set endpoint */
-    strncpy(ctx->endpoint, OLLAMA_DEFAULT_ENDPOINT, sizeof(ctx->endpoint) - 1);
-    ctx->port = OLLAMA_DEFAULT_PORT;
-    ctx->socket_fd = -1;
+    /* Server address from config / OLLAMA_HOST */
+    char host[OLLAMA_HOST_SIZE];
+    int port = OLLAMA_DEFAULT_PORT;
+    ollama_resolve_address(host, sizeof(host), &port);
+    ollama_conn_init(&ctx->conn, host, port);
     ctx->use_streaming = true;  /* Default to streaming */
 
-    LOG_INFO("Created Ollama provider for model %s", ctx->model);
+    LOG_INFO("Created Ollama provider for model %s at %s:%d", ctx->model, host, port);
     return &ctx->provider;
 }
 
@@ -122,150 +127,139 @@ static int ollama_init(ci_provider_t* provider) {
     return ARGO_SUCCESS;
 }
 
-/* Connect to Ollama server */
+/* Connect to Ollama server (connection is then kept alive across queries) */
 static int ollama_connect(ci_provider_t* provider) {
     ARGO_GET_CONTEXT(provider, ollama_context_t, ctx);
 
-    if (ctx->connected) {
+    if (ollama_conn_is_open(&ctx->conn)) {
         return ARGO_SUCCESS;
     }
 
-    /* Connect to Ollama */
-    ctx->socket_fd = connect_to_ollama(DEFAULT_DAEMON_HOST, ctx->port);
-    if (ctx->socket_fd < 0) {
-        argo_report_error(E_CI_NO_PROVIDER, "ollama_connect", ERR_FMT_FAILED_AT_PORT, ctx->port);
-        return E_CI_NO_PROVIDER;
+    int result = ollama_conn_open(&ctx->conn, OLLAMA_CONNECT_TIMEOUT_MS);
+    if (result != ARGO_SUCCESS) {
+        return result;
     }
 
-    ctx->connected = true;
-    LOG_INFO("Connected to Ollama at %s:%d", DEFAULT_DAEMON_HOST, ctx->port);
+    LOG_INFO("Connected to Ollama at %s:%d", ctx->conn.host, ctx->conn.port);
     return ARGO_SUCCESS;
 }
 
-/* Query Ollama (async with callback) */
-static int ollama_query(ci_provider_t* provider, const char* prompt,
-                       ci_response_callback callback, void* userdata) {
-    ARGO_CHECK_NULL(prompt);
-    ARGO_CHECK_NULL(callback);
-    ARGO_GET_CONTEXT(provider, ollama_context_t, ctx);
+/* Helper: Count raw body bytes of the current request */
+static void note_body(ollama_context_t* ctx, size_t len) {
+    if (ctx->first_byte_ms == 0) {
+        ctx->first_byte_ms = argo_monotonic_ms();
+    }
+    ctx->received_bytes += len;
+}
 
-    /* Ensure connected */
-    ARGO_ENSURE_CONNECTED(provider, ctx);
+/* Helper: Record a finished request in provider telemetry and the totals */
+static void record_call(ollama_context_t* ctx, int result, bool streamed, size_t request_bytes,
+                        const provider_usage_t* usage) {
+    provider_call_t call = {
+        .provider = OLLAMA_PROVIDER_NAME,
+        .model = ctx->model,
+        .result = result,
+        .streamed = streamed,
+        .request_bytes = request_bytes,
+        .response_bytes = ctx->received_bytes,
+        .usage = *usage,
+        .ttfb_ms = ctx->first_byte_ms ? ctx->first_byte_ms - ctx->started_ms : -1,
+        .total_ms = argo_monotonic_ms() - ctx->started_ms
+    };
+    provider_telemetry_record(&call);
+    ctx->total_tokens += (uint64_t)(usage->prompt_tokens + usage->completion_tokens);
+}
 
-    /* Build HTTP request - use non-streaming for regular query */
-    char request[OLLAMA_REQUEST_BUFFER_SIZE];
-    int req_len = build_http_request(request, sizeof(request), ctx->model, prompt, false);
-    if (req_len < 0) {
-        return E_PROTOCOL_SIZE;
-    }
+/* Helper: Append response body bytes to the accumulator */
+static void accumulate_body(const char* data, size_t len, void* userdata) {
+    ollama_context_t* ctx = (ollama_context_t*)userdata;
 
-    /* Send request */
-    ssize_t sent = send(ctx->socket_fd, request, req_len, MSG_NOSIGNAL);
-    if (sent != req_len) {
-        argo_report_error(E_SYSTEM_SOCKET, "ollama_query", ERR_FMT_SYSCALL_ERROR, ERR_MSG_SOCKET_SEND_FAILED, strerror(errno));
-        ollama_disconnect(ctx);
-        return E_SYSTEM_SOCKET;
+    if (ctx->response_truncated ||
+        ensure_buffer_capacity(&ctx->response_content, &ctx->response_capacity,
+                               ctx->response_size + len + 1) != ARGO_SUCCESS) {
+        ctx->response_truncated = true;
+        return;
     }
+    memcpy(ctx->response_content + ctx->response_size, data, len);
+    ctx->response_size += len;
+    ctx->response_content[ctx->response_size] = '\0';
+}
+
+/* Helper: Raw query body - count it and keep it */
+static void query_on_body(const char* data, size_t len, void* userdata) {
+    note_body((ollama_context_t*)userdata, len);
+    accumulate_body(data, len, userdata);
+}
 
-    /* Clear buffers */
+/* Helper: Reset the accumulator and request counters before a request */
+static void reset_response(ollama_context_t* ctx) {
     ctx->response_size = 0;
-    ctx->buffer_pos = 0;
-    memset(ctx->buffer, 0, sizeof(ctx->buffer));
+    ctx->response_truncated = false;
+    ctx->started_ms = argo_monotonic_ms();
+    ctx->first_byte_ms = 0;
+    ctx->received_bytes = 0;
     if (ctx->response_content) {
         ctx->response_content[0] = '\0';
     }
+}
 
-    /* Read the complete HTTP response */
-    time_t start = time(NULL);
-    bool headers_complete = false;
-    char* json_start = NULL;
-
-    while (time(NULL) - start < OLLAMA_TIMEOUT_SECONDS) {
-        ssize_t bytes = recv(ctx->socket_fd,
-                           ctx->buffer + ctx->buffer_pos,
-                           sizeof(ctx->buffer) - ctx->buffer_pos - 1,
-                           MSG_DONTWAIT);
-
-        if (bytes > 0) {
-            ctx->buffer_pos += bytes;
-            ctx->buffer[ctx->buffer_pos] = '\0';
-
-            /* Look for end of HTTP headers if not found yet */
-            if (!headers_complete) {
-                char* header_end = strstr(ctx->buffer, HTTP_HEADER_DELIMITER);
-                if (header_end) {
-                    json_start = header_end + 4;
-                    headers_complete = true;
-                }
-            }
-
-            /* If we have headers and see closing brace, we're done */
-            if (headers_complete && json_start) {
-                /* Simple check for complete JSON - look for final } */
-                char* last_brace = strrchr(json_start, '}');
-                if (last_brace) {
-                    /* Null terminate right after the closing brace */
-                    *(last_brace + 1) = '\0';
-                    break;
-                }
-            }
-        } else if (bytes == 0) {
-            break;
-        } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
-            argo_report_error(E_SYSTEM_SOCKET, "ollama_query", ERR_FMT_SYSCALL_ERROR, ERR_MSG_RECV_ERROR, strerror(errno));
-            ollama_disconnect(ctx);
-            return E_SYSTEM_SOCKET;
-        }
+/* Query Ollama (async with callback) */
+static int ollama_query(ci_provider_t* provider, const char* prompt,
+                       ci_response_callback callback, void* userdata) {
+    ARGO_CHECK_NULL(prompt);
+    ARGO_CHECK_NULL(callback);
+    ARGO_GET_CONTEXT(provider, ollama_context_t, ctx);
 
-        usleep(OLLAMA_POLL_DELAY_US);
-    }
+    int result = ARGO_SUCCESS;
+    json_node_t* root = NULL;
+    size_t body_len = 0;
+    provider_usage_t usage = {0};
 
-    if (!json_start) {
-        argo_report_error(E_PROTOCOL_FORMAT, "ollama_query", ERR_MSG_NO_JSON_IN_RESPONSE);
-        ollama_disconnect(ctx);
-        return E_PROTOCOL_FORMAT;
+    /* Non-streaming request: one JSON object in the body */
+    char* body = build_generate_body(ctx->model, prompt, false, &body_len);
+    if (!body) {
+        return E_SYSTEM_MEMORY;
     }
 
-    /* Simple extraction of response field - jsmn has issues with emojis */
-    char* response_start = strstr(json_start, JSON_RESPONSE_FIELD);
-    if (!response_start) {
-        argo_report_error(E_PROTOCOL_FORMAT, "ollama_query", ERR_MSG_NO_RESPONSE_FIELD);
-        ollama_disconnect(ctx);
-        return E_PROTOCOL_FORMAT;
+    reset_response(ctx);
+    int status = 0;
+    result = ollama_conn_request(&ctx->conn, "POST", OLLAMA_GENERATE_PATH, body, body_len,
+                                 query_on_body, ctx, &status);
+    if (result != ARGO_SUCCESS) {
+        goto cleanup;
     }
-
-    response_start += OLLAMA_RESPONSE_FIELD_OFFSET;
-
-    /* Find the closing quote, handling escapes */
-    char* p = response_start;
-    while (*p) {
-        if (*p == '"' && *(p-1) != '\\') {
-            break;
-        }
-        p++;
+    result = check_http_status(ctx, status, "ollama_query");
+    if (result != ARGO_SUCCESS) {
+        goto cleanup;
     }
-
-    if (*p != '"') {
-        argo_report_error(E_PROTOCOL_FORMAT, "ollama_query", ERR_MSG_UNTERMINATED_STRING);
-        ollama_disconnect(ctx);
-        return E_PROTOCOL_FORMAT;
+    if (ctx->response_truncated) {
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
     }
 
-    /* Copy response */
-    size_t response_len = p - response_start;
-    int result = ensure_buffer_capacity(&ctx->response_content, &ctx->response_capacity,
-                                       response_len + 1);
+    result = json_doc_parse(ctx->response_content, ctx->response_size, &root);
     if (result != ARGO_SUCCESS) {
-        ollama_disconnect(ctx);
-        return result;
+        argo_report_error(E_PROTOCOL_FORMAT, "ollama_query", ERR_MSG_NO_JSON_IN_RESPONSE);
+        result = E_PROTOCOL_FORMAT;
+        goto cleanup;
     }
 
-    strncpy(ctx->response_content, response_start, response_len);
-    ctx->response_content[response_len] = '\0';
-    ctx->response_size = response_len;
+    json_node_t* text = json_doc_get(root, OLLAMA_RESPONSE_POINTER);
+    if (!text || text->type != JSON_DOC_STRING) {
+        argo_report_error(E_PROTOCOL_FORMAT, "ollama_query", ERR_MSG_NO_RESPONSE_FIELD);
+        result = E_PROTOCOL_FORMAT;
+        goto cleanup;
+    }
+    provider_usage_read(root, &usage);
 
-    /* Disconnect after each query (Ollama doesn't keep connections) */
-    ollama_disconnect(ctx);
+    /* Replace the raw body with the decoded answer */
+    size_t text_len = strlen(text->text);
+    result = ensure_buffer_capacity(&ctx->response_content, &ctx->response_capacity, text_len + 1);
+    if (result != ARGO_SUCCESS) {
+        goto cleanup;
+    }
+    memcpy(ctx->response_content, text->text, text_len + 1);
+    ctx->response_size = text_len;
 
     /* Build response */
     ci_response_t response;
@@ -279,7 +273,34 @@ static int ollama_query(ci_provider_t* provider, const char* prompt,
     callback(&response, userdata);
 
     LOG_DEBUG("Ollama query completed, response size: %zu", ctx->response_size);
-    return ARGO_SUCCESS;
+
+cleanup:
+    record_call(ctx, result, false, body_len, &usage);
+    json_doc_free(root);
+    free(body);
+    return result;
+}
+
+/* Helper: Decoded token - keep a copy and pass it on */
+static void stream_on_delta(const char* text, size_t len, void* userdata) {
+    ollama_stream_state_t* state = (ollama_stream_state_t*)userdata;
+    accumulate_body(text, len, state->ctx);
+    state->callback(text, len, state->userdata);
+}
+
+/* Helper: Parsed NDJSON event - the final one carries the token counts */
+static void stream_on_event(json_node_t* event, void* userdata) {
+    ollama_stream_state_t* state = (ollama_stream_state_t*)userdata;
+    provider_usage_read(event, &state->usage);
+}
+
+/* Helper: Raw body bytes - feed the NDJSON decoder */
+static void stream_on_body(const char* data, size_t len, void* userdata) {
+    ollama_stream_state_t* state = (ollama_stream_state_t*)userdata;
+    note_body(state->ctx, len);
+    if (!stream_decoder_done(state->decoder)) {
+        stream_decoder_feed(state->decoder, data, len);
+    }
 }
 
 /* Stream response from Ollama */
@@ -289,125 +310,47 @@ static int ollama_stream(ci_provider_t* provider, const char* prompt,
     ARGO_CHECK_NULL(callback);
     ARGO_GET_CONTEXT(provider, ollama_context_t, ctx);
 
-    /* Ensure connected */
-    ARGO_ENSURE_CONNECTED(provider, ctx);
-
-    /* Build HTTP request with streaming enabled */
-    char request[OLLAMA_REQUEST_BUFFER_SIZE];
-    int req_len = build_http_request(request, sizeof(request), ctx->model, prompt, true);
-    if (req_len < 0) {
-        return E_PROTOCOL_SIZE;
+    size_t body_len = 0;
+    char* body = build_generate_body(ctx->model, prompt, true, &body_len);
+    if (!body) {
+        return E_SYSTEM_MEMORY;
     }
 
-    /* Send request */
-    ssize_t sent = send(ctx->socket_fd, request, req_len, MSG_NOSIGNAL);
-    if (sent != req_len) {
-        argo_report_error(E_SYSTEM_SOCKET, "ollama_stream", ERR_FMT_SYSCALL_ERROR, ERR_MSG_SOCKET_SEND_FAILED, strerror(errno));
-        ollama_disconnect(ctx);
-        return E_SYSTEM_SOCKET;
+    ollama_stream_state_t state = {
+        .ctx = ctx,
+        .callback = callback,
+        .userdata = userdata
+    };
+    state.decoder = stream_decoder_create(STREAM_FORMAT_NDJSON, OLLAMA_RESPONSE_POINTER,
+                                          stream_on_delta, &state);
+    if (!state.decoder) {
+        free(body);
+        return E_SYSTEM_MEMORY;
     }
+    stream_decoder_set_event_fn(state.decoder, stream_on_event, &state);
+
+    reset_response(ctx);
+    int status = 0;
+    int result = ollama_conn_request(&ctx->conn, "POST", OLLAMA_GENERATE_PATH, body, body_len,
+                                     stream_on_body, &state, &status);
+    if (result == ARGO_SUCCESS && status != HTTP_STATUS_OK) {
+        argo_report_error(E_PROTOCOL_HTTP, "ollama_stream", "HTTP %d", status);
+        result = E_PROTOCOL_HTTP;
+    }
+    if (result == ARGO_SUCCESS) {
+        result = stream_decoder_finish(state.decoder);
+    }
+    stream_decoder_destroy(state.decoder);
+    record_call(ctx, result, true, body_len, &state.usage);
+    free(body);
 
-    /* Clear buffers */
-    ctx->buffer_pos = 0;
-    memset(ctx->buffer, 0, sizeof(ctx->buffer));
-
-    /* Read streaming response */
-    time_t start = time(NULL);
-    bool headers_complete = false;
-    char line_buffer[OLLAMA_LINE_BUFFER_SIZE];
-
-    while (time(NULL) - start < OLLAMA_TIMEOUT_SECONDS) {
-        ssize_t bytes = recv(ctx->socket_fd,
-                           ctx->buffer + ctx->buffer_pos,
-                           sizeof(ctx->buffer) - ctx->buffer_pos - 1,
-                           MSG_DONTWAIT);
-
-        if (bytes > 0) {
-            ctx->buffer_pos += bytes;
-            ctx->buffer[ctx->buffer_pos] = '\0';
-
-            /* Skip headers if not done yet */
-            if (!headers_complete) {
-                char* header_end = strstr(ctx->buffer, HTTP_HEADER_DELIMITER);
-                if (header_end) {
-                    /* Move past headers */
-                    char* json_start = header_end + 4;
-                    size_t remaining = ctx->buffer_pos - (json_start - ctx->buffer);
-                    memmove(ctx->buffer, json_start, remaining);
-                    ctx->buffer_pos = remaining;
-                    headers_complete = true;
-                }
-            }
-
-            if (headers_complete) {
-                /* Process lines from buffer */
-                char* p = ctx->buffer;
-                char* line_start = ctx->buffer;
-
-                while (p < ctx->buffer + ctx->buffer_pos) {
-                    if (*p == '\n') {
-                        /* Complete line found - copy to line buffer */
-                        size_t line_len = p - line_start;
-                        if (line_len > 0 && line_len < sizeof(line_buffer)) {
-                            memcpy(line_buffer, line_start, line_len);
-                            line_buffer[line_len] = '\0';
-
-                            /* Parse JSON line and extract response */
-                            char* response_field = strstr(line_buffer, OLLAMA_JSON_RESPONSE);
-                            if (response_field) {
-                                response_field += strlen(OLLAMA_JSON_RESPONSE);
-                                char* end = response_field;
-                                while (*end && !(*end == '"' && *(end-1) != '\\')) end++;
-
-                                /* Extract the chunk */
-                                size_t chunk_len = end - response_field;
-                                char chunk[OLLAMA_CHUNK_SIZE];
-                                if (chunk_len < sizeof(chunk)) {
-                                    strncpy(chunk, response_field, chunk_len);
-                                    chunk[chunk_len] = '\0';
-
-                                    /* Call callback with chunk */
-                                    callback(chunk, chunk_len, userdata);
-                                }
-                            }
-
-                            /* Check if done */
-                            if (strstr(line_buffer, JSON_DONE_FIELD)) {
-                                /* Streaming complete */
-                                ollama_disconnect(ctx);
-                                ARGO_UPDATE_STATS(ctx);
-                                return ARGO_SUCCESS;
-                            }
-                        }
-
-                        /* Move to next line */
-                        line_start = p + 1;
-                    }
-                    p++;
-                }
-
-                /* Move remaining partial line to start of buffer */
-                size_t remaining = ctx->buffer + ctx->buffer_pos - line_start;
-                if (remaining > 0) {
-                    memmove(ctx->buffer, line_start, remaining);
-                    ctx->buffer_pos = remaining;
-                } else {
-                    ctx->buffer_pos = 0;
-                }
-            }
-        } else if (bytes == 0) {
-            break;
-        } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
-            argo_report_error(E_SYSTEM_SOCKET, "ollama_stream", ERR_FMT_SYSCALL_ERROR, ERR_MSG_RECV_ERROR, strerror(errno));
-            ollama_disconnect(ctx);
-            return E_SYSTEM_SOCKET;
-        }
-
-        usleep(OLLAMA_POLL_DELAY_US);
+    if (result != ARGO_SUCCESS) {
+        return result;
     }
 
-    ollama_disconnect(ctx);
-    return E_CI_TIMEOUT;
+    ARGO_UPDATE_STATS(ctx);
+    LOG_DEBUG("Ollama stream completed, response size: %zu", ctx->response_size);
+    return ARGO_SUCCESS;
 }
 
 /* Cleanup Ollama provider */
@@ -417,60 +360,59 @@ static void ollama_cleanup(ci_provider_t* provider) {
     ollama_context_t* ctx = (ollama_context_t*)provider->context;
     if (!ctx) return;
 
-    /* Disconnect if connected */
-    if (ctx->connected) {
-        ollama_disconnect(ctx);
-    }
+    LOG_INFO("Ollama provider cleanup: queries=%llu tokens=%llu connections=%llu",
+             ctx->total_queries, ctx->total_tokens, (unsigned long long)ctx->conn.connects);
+
+    /* Close keep-alive connection */
+    ollama_conn_free(&ctx->conn);
 
     /* Free response buffer */
     if (ctx->response_content) {
         free(ctx->response_content);
     }
 
-    LOG_INFO("Ollama provider cleanup: queries=%llu tokens=%llu",
-             ctx->total_queries, ctx->total_tokens);
-
     free(ctx);
 }
 
-/* Disconnect from Ollama */
-static int ollama_disconnect(ollama_context_t* ctx) {
-    if (ctx->socket_fd >= 0) {
-        close(ctx->socket_fd);
-        ctx->socket_fd = -1;
+/* Build /api/generate JSON body (caller frees) */
+static char* build_generate_body(const char* model, const char* prompt, bool streaming,
+                                 size_t* body_len) {
+    json_builder_t json;
+    if (json_builder_init(&json, strlen(prompt)) != ARGO_SUCCESS) {
+        return NULL;
     }
-    ctx->connected = false;
-    return ARGO_SUCCESS;
-}
 
-/* Build HTTP POST request for Ollama */
-static int build_http_request(char* buffer, size_t size,
-                             const char* model, const char* prompt, bool streaming) {
-    /* Build JSON body */
-    char json_body[OLLAMA_JSON_BODY_SIZE];
-    int json_len = snprintf(json_body, sizeof(json_body),
-                           OLLAMA_REQUEST_FORMAT,
-                           model, prompt, streaming ? "true" : "false"); /* GUIDELINE_APPROVED: JSON boolean */
-
-    if (json_len >= (int)sizeof(json_body)) {
-        return -1;
+    json_builder_object_begin(&json);
+    json_builder_key_string(&json, OLLAMA_JSON_MODEL, model);
+    json_builder_key_string(&json, OLLAMA_JSON_PROMPT, prompt);
+    json_builder_key_bool(&json, OLLAMA_JSON_STREAM, streaming);
+    json_builder_object_end(&json);
+
+    char* body = json_builder_take(&json, body_len);
+    if (!body) {
+        argo_report_error(json_builder_error(&json), "build_generate_body", ERR_MSG_JSON_BUILD_FAILED);
     }
+    return body;
+}
 
-    /* Build HTTP request */
-    int req_len = snprintf(buffer, size,
-                          "POST /api/generate HTTP/1.1\r\n" /* GUIDELINE_APPROVED: HTTP/1.1 protocol headers */
-                          "Host: %s\r\n" /* GUIDELINE_APPROVED: HTTP/1.1 protocol headers */
-                          "Content-Type: application/json\r\n" /* GUIDELINE_APPROVED: HTTP/1.1 protocol headers */
-                          "Content-Length: %d\r\n" /* GUIDELINE_APPROVED: HTTP/1.1 protocol headers */
-                          "\r\n" /* GUIDELINE_APPROVED: HTTP/1.1 protocol headers */
-                          "%s", /* GUIDELINE_APPROVED: HTTP/1.1 protocol headers */
-                          DEFAULT_DAEMON_HOST, json_len, json_body);
-
-    if (req_len >= (int)size) {
-        return -1;
+/* Helper: Non-200 answer - report Ollama's error message if it sent one */
+static int check_http_status(ollama_context_t* ctx, int status, const char* func) {
+    if (status == HTTP_STATUS_OK) {
+        return ARGO_SUCCESS;
     }
 
-    return req_len;
+    json_node_t* root = NULL;
+    const char* message = "no error message";
+    if (ctx->response_size > 0 &&
+        json_doc_parse(ctx->response_content, ctx->response_size, &root) == ARGO_SUCCESS) {
+        json_node_t* error = json_doc_get(root, OLLAMA_ERROR_POINTER);
+        if (error && error->type == JSON_DOC_STRING) {
+            message = error->text;
+        }
+    }
+    argo_report_error(E_PROTOCOL_HTTP, func, "HTTP %d: %s", status, message);
+    json_doc_free(root);
+    return E_PROTOCOL_HTTP;
 }
 
 /* Streaming control functions */
@@ -491,54 +433,15 @@ bool ollama_get_streaming(ci_provider_t* provider) {
  * or direct streaming. The fallback logic here was never exercised.
  */
 
-/* Connect to Ollama server */
-static int connect_to_ollama(const char* host, int port) {
-    (void)host;  /* Always using localhost */
-    struct sockaddr_in addr;
-    int sock_fd;
-
-    /* Create socket */
-    sock_fd = socket(AF_INET, SOCK_STREAM, 0);
-    if (sock_fd < 0) {
-        argo_report_error(E_SYSTEM_SOCKET, "connect_to_ollama", ERR_FMT_SYSCALL_ERROR, ERR_MSG_SOCKET_CREATE_FAILED, strerror(errno));
-        return -1;
-    }
-
-    /* Set socket options */
-    int opt = 1;
-    setsockopt(sock_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
-
-    /* Setup address */
-    memset(&addr, 0, sizeof(addr));
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(port);
-    addr.sin_addr.s_addr = inet_addr(LOCALHOST_IP);
-
-    /* Connect */
-    if (connect(sock_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
-        argo_report_error(E_SYSTEM_SOCKET, "connect_to_ollama", ERR_FMT_SYSCALL_ERROR, ERR_MSG_SOCKET_CONNECT_FAILED, strerror(errno));
-        close(sock_fd);
-        return -1;
-    }
-
-    return sock_fd;
-}
-
-/* Check if Ollama server is running */
+/* Check if Ollama server is running (configured address) */
 bool ollama_is_running(void) {
-    int sock = socket(AF_INET, SOCK_STREAM, 0);
-    if (sock < 0) return false;
-
-    struct sockaddr_in addr;
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(OLLAMA_DEFAULT_PORT);
-    addr.sin_addr.s_addr = inet_addr(LOCALHOST_IP);
-
-    /* Set timeout for connect */
-    struct timeval tv = {1, 0};
-    setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
-
-    int result = connect(sock, (struct sockaddr*)&addr, sizeof(addr));
-    close(sock);
-    return result == 0;
-}
\ No newline at end of file
+    char host[OLLAMA_HOST_SIZE];
+    int port = OLLAMA_DEFAULT_PORT;
+    ollama_resolve_address(host, sizeof(host), &port);
+
+    ollama_conn_t probe;
+    ollama_conn_init(&probe, host, port);
+    bool running = ollama_conn_open(&probe, OLLAMA_PROBE_TIMEOUT_MS) == ARGO_SUCCESS;
+    ollama_conn_free(&probe);
+    return running;
+}
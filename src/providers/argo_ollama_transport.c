@@ -0,0 +1,566 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Ollama transport - keep-alive HTTP/1.1 over poll() with proper framing */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* getaddrinfo(), MSG_NOSIGNAL */
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+/* Project includes */
+#include "argo_ollama_transport.h"
+#include "argo_ollama.h"
+#include "argo_config.h"
+#include "argo_env_utils.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_limits.h"
+#include "argo_log.h"
+
+#define HTTP_SCHEME_PREFIX "http://"
+#define HEX_BASE 16
+#define CRLF_LEN 2
+
+/* Parsed response head */
+typedef struct {
+    int status;
+    bool chunked;
+    bool has_length;
+    size_t content_length;
+    bool close;                 /* Server will not reuse the connection */
+} response_head_t;
+
+/* Parse "host", "host:port" or "http://host:port" */
+int ollama_parse_address(const char* spec, char* host, size_t host_size, int* port) {
+    ARGO_CHECK_NULL(spec);
+    ARGO_CHECK_NULL(host);
+    ARGO_CHECK_NULL(port);
+
+    if (strncasecmp(spec, HTTP_SCHEME_PREFIX, strlen(HTTP_SCHEME_PREFIX)) == 0) {
+        spec += strlen(HTTP_SCHEME_PREFIX);
+    }
+
+    size_t host_len = strcspn(spec, ":/");
+    if (host_len == 0 || host_len >= host_size) {
+        return E_INPUT_FORMAT;
+    }
+
+    int parsed_port = *port;
+    if (spec[host_len] == ':') {
+        const char* port_str = spec + host_len + 1;
+        char* endptr = NULL;
+        long value = strtol(port_str, &endptr, DECIMAL_BASE);
+        if (endptr == port_str || (*endptr && *endptr != '/') ||
+            value <= 0 || value > MAX_VALID_PORT) {
+            return E_INPUT_FORMAT;
+        }
+        parsed_port = (int)value;
+    }
+
+    memcpy(host, spec, host_len);
+    host[host_len] = '\0';
+    *port = parsed_port;
+    return ARGO_SUCCESS;
+}
+
+/* Configured server address */
+void ollama_resolve_address(char* host, size_t host_size, int* port) {
+    snprintf(host, host_size, "%s", OLLAMA_DEFAULT_HOST);
+    *port = OLLAMA_DEFAULT_PORT;
+
+    /* 1. Config file, 2. environment */
+    const char* sources[] = { argo_config_get(OLLAMA_HOST_CONFIG_KEY), argo_getenv(OLLAMA_HOST_ENV) };
+    for (size_t i = 0; i < sizeof(sources) / sizeof(sources[0]); i++) {
+        if (!sources[i] || !sources[i][0]) continue;
+
+        int candidate_port = OLLAMA_DEFAULT_PORT;
+        char candidate[OLLAMA_HOST_SIZE];
+        if (ollama_parse_address(sources[i], candidate, sizeof(candidate), &candidate_port) == ARGO_SUCCESS) {
+            snprintf(host, host_size, "%s", candidate);
+            *port = candidate_port;
+            return;
+        }
+        LOG_WARN("Ignoring invalid Ollama address: %s", sources[i]);
+    }
+}
+
+/* Prepare connection */
+void ollama_conn_init(ollama_conn_t* conn, const char* host, int port) {
+    if (!conn) return;
+    memset(conn, 0, sizeof(*conn));
+    snprintf(conn->host, sizeof(conn->host), "%s", host ? host : OLLAMA_DEFAULT_HOST);
+    conn->port = port > 0 ? port : OLLAMA_DEFAULT_PORT;
+    conn->fd = -1;
+    conn->timeout_ms = OLLAMA_TIMEOUT_SECONDS * MILLISECONDS_PER_SECOND;
+}
+
+/* Helper: poll() one descriptor, retrying on EINTR */
+static int wait_for(int fd, short events, int timeout_ms) {
+    struct pollfd pfd = { .fd = fd, .events = events };
+    int ready;
+    do {
+        ready = poll(&pfd, 1, timeout_ms);
+    } while (ready < 0 && errno == EINTR);
+    return ready;
+}
+
+/* Helper: Non-blocking connect bounded by timeout; returns blocking fd or -1 */
+static int connect_with_timeout(const struct addrinfo* ai, int timeout_ms) {
+    int fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (fd < 0) return -1;
+
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+
+    if (connect(fd, ai->ai_addr, ai->ai_addrlen) < 0) {
+        int error = 0;
+        socklen_t error_len = sizeof(error);
+        if (errno != EINPROGRESS ||
+            wait_for(fd, POLLOUT, timeout_ms) <= 0 ||
+            getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &error_len) < 0 ||
+            error != 0) {
+            close(fd);
+            return -1;
+        }
+    }
+
+    fcntl(fd, F_SETFL, flags);
+    int nodelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+    return fd;
+}
+
+/* Connect if not already connected */
+int ollama_conn_open(ollama_conn_t* conn, int connect_timeout_ms) {
+    ARGO_CHECK_NULL(conn);
+    if (conn->fd >= 0) {
+        return ARGO_SUCCESS;
+    }
+
+    char port_str[16];
+    snprintf(port_str, sizeof(port_str), "%d", conn->port);
+
+    struct addrinfo hints = { .ai_family = AF_UNSPEC, .ai_socktype = SOCK_STREAM };
+    struct addrinfo* list = NULL;
+    int rc = getaddrinfo(conn->host, port_str, &hints, &list);
+    if (rc != 0) {
+        argo_report_error(E_CI_NO_PROVIDER, "ollama_conn_open", "%s: %s", conn->host, gai_strerror(rc));
+        return E_CI_NO_PROVIDER;
+    }
+
+    int fd = -1;
+    for (struct addrinfo* ai = list; ai && fd < 0; ai = ai->ai_next) {
+        fd = connect_with_timeout(ai, connect_timeout_ms);
+    }
+    freeaddrinfo(list);
+
+    if (fd < 0) {
+        argo_report_error(E_CI_NO_PROVIDER, "ollama_conn_open", "%s at %s:%d",
+                         ERR_MSG_OLLAMA_CONNECT_FAILED, conn->host, conn->port);
+        return E_CI_NO_PROVIDER;
+    }
+
+    conn->fd = fd;
+    conn->length = 0;
+    conn->connects++;
+    LOG_DEBUG("Connected to Ollama at %s:%d", conn->host, conn->port);
+    return ARGO_SUCCESS;
+}
+
+/* True while a socket is open */
+bool ollama_conn_is_open(const ollama_conn_t* conn) {
+    return conn && conn->fd >= 0;
+}
+
+/* Close the socket */
+void ollama_conn_close(ollama_conn_t* conn) {
+    if (!conn) return;
+    if (conn->fd >= 0) {
+        close(conn->fd);
+        conn->fd = -1;
+    }
+    conn->length = 0;
+}
+
+/* Close the socket and free the buffer */
+void ollama_conn_free(ollama_conn_t* conn) {
+    if (!conn) return;
+    ollama_conn_close(conn);
+    free(conn->buffer);
+    conn->buffer = NULL;
+    conn->capacity = 0;
+}
+
+/* Helper: Idle keep-alive socket the server already closed (or sent junk on) */
+static bool conn_is_stale(ollama_conn_t* conn) {
+    return conn->length > 0 || wait_for(conn->fd, POLLIN, 0) != 0;
+}
+
+/* Helper: Drop n consumed bytes from the front of the buffer */
+static void conn_consume(ollama_conn_t* conn, size_t n) {
+    memmove(conn->buffer, conn->buffer + n, conn->length - n);
+    conn->length -= n;
+    conn->buffer[conn->length] = '\0';
+}
+
+/* Helper: Block until more bytes arrive; *eof set if the server closed */
+static int conn_fill(ollama_conn_t* conn, bool* eof) {
+    *eof = false;
+
+    if (conn->capacity - conn->length < OLLAMA_READ_CHUNK + 1) {
+        size_t capacity = conn->capacity ? conn->capacity : OLLAMA_READ_CHUNK + 1;
+        while (capacity - conn->length < OLLAMA_READ_CHUNK + 1) capacity *= 2;
+        char* grown = realloc(conn->buffer, capacity);
+        if (!grown) {
+            argo_report_error(E_SYSTEM_MEMORY, "ollama_conn_fill", ERR_MSG_MEMORY_ALLOC_FAILED);
+            return E_SYSTEM_MEMORY;
+        }
+        conn->buffer = grown;
+        conn->capacity = capacity;
+    }
+
+    int ready = wait_for(conn->fd, POLLIN, conn->timeout_ms);
+    if (ready == 0) {
+        argo_report_error(E_CI_TIMEOUT, "ollama_conn_fill", "no data from Ollama for %d ms", conn->timeout_ms);
+        return E_CI_TIMEOUT;
+    }
+    if (ready < 0) {
+        argo_report_error(E_SYSTEM_SOCKET, "ollama_conn_fill", ERR_FMT_SYSCALL_ERROR, "poll", strerror(errno));
+        return E_SYSTEM_SOCKET;
+    }
+
+    ssize_t bytes;
+    do {
+        bytes = recv(conn->fd, conn->buffer + conn->length, conn->capacity - conn->length - 1, 0);
+    } while (bytes < 0 && errno == EINTR);
+
+    if (bytes < 0 && errno != ECONNRESET) {
+        argo_report_error(E_SYSTEM_SOCKET, "ollama_conn_fill", ERR_FMT_SYSCALL_ERROR, ERR_MSG_RECV_ERROR, strerror(errno));
+        return E_SYSTEM_SOCKET;
+    }
+    if (bytes <= 0) {
+        *eof = true;
+        return ARGO_SUCCESS;
+    }
+
+    conn->length += (size_t)bytes;
+    conn->buffer[conn->length] = '\0';
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Offset of the first CRLF in the buffer, or -1 */
+static long find_crlf(const ollama_conn_t* conn, size_t from) {
+    for (size_t i = from; i + 1 < conn->length; i++) {
+        if (conn->buffer[i] == '\r' && conn->buffer[i + 1] == '\n') return (long)i;
+    }
+    return -1;
+}
+
+/* Helper: Read until the buffer starts with a complete CRLF-terminated line */
+static int read_line(ollama_conn_t* conn, size_t limit, size_t* line_len) {
+    long end;
+    while ((end = find_crlf(conn, 0)) < 0) {
+        if (conn->length > limit) {
+            argo_report_error(E_PROTOCOL_SIZE, "ollama_read_line", "line exceeds %zu bytes", limit);
+            return E_PROTOCOL_SIZE;
+        }
+        bool eof = false;
+        int result = conn_fill(conn, &eof);
+        if (result != ARGO_SUCCESS) return result;
+        if (eof) return E_SYSTEM_NETWORK;
+    }
+    *line_len = (size_t)end;
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Comma-separated header value contains token (case-insensitive) */
+static bool header_has_token(const char* value, size_t len, const char* token) {
+    size_t token_len = strlen(token);
+    size_t i = 0;
+    while (i < len) {
+        while (i < len && (value[i] == ' ' || value[i] == '\t' || value[i] == ',')) i++;
+        size_t start = i;
+        while (i < len && value[i] != ',') i++;
+        size_t end = i;
+        while (end > start && (value[end - 1] == ' ' || value[end - 1] == '\t')) end--;
+        if (end - start == token_len && strncasecmp(value + start, token, token_len) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Helper: Header line is "name: ..." - returns value or NULL */
+static const char* header_value(const char* line, size_t len, const char* name, size_t* value_len) {
+    size_t name_len = strlen(name);
+    if (len <= name_len || line[name_len] != ':' || strncasecmp(line, name, name_len) != 0) {
+        return NULL;
+    }
+    const char* value = line + name_len + 1;
+    while (value < line + len && (*value == ' ' || *value == '\t')) value++;
+    *value_len = (size_t)(line + len - value);
+    return value;
+}
+
+/* Helper: Read status line and headers */
+static int read_head(ollama_conn_t* conn, response_head_t* head, bool* got_bytes) {
+    memset(head, 0, sizeof(*head));
+    *got_bytes = false;
+
+    /* Wait for the blank line ending the header block */
+    long end = -1;
+    for (;;) {
+        for (long at = find_crlf(conn, 0); at >= 0; at = find_crlf(conn, (size_t)at + CRLF_LEN)) {
+            if ((size_t)at + 2 * CRLF_LEN <= conn->length &&
+                conn->buffer[at + 2] == '\r' && conn->buffer[at + 3] == '\n') {
+                end = at;
+                break;
+            }
+        }
+        if (end >= 0) break;
+        if (conn->length > OLLAMA_HEADER_MAX) {
+            argo_report_error(E_PROTOCOL_SIZE, "ollama_read_head", "headers exceed %d bytes", OLLAMA_HEADER_MAX);
+            return E_PROTOCOL_SIZE;
+        }
+        bool eof = false;
+        int result = conn_fill(conn, &eof);
+        if (result != ARGO_SUCCESS) return result;
+        if (eof) return E_SYSTEM_NETWORK;
+        *got_bytes = true;
+    }
+    *got_bytes = true;
+
+    int major = 0;
+    int minor = 0;
+    if (sscanf(conn->buffer, "HTTP/%d.%d %d", &major, &minor, &head->status) != 3 ||
+        head->status < 100) {
+        argo_report_error(E_PROTOCOL_FORMAT, "ollama_read_head", "malformed status line");
+        return E_PROTOCOL_FORMAT;
+    }
+    head->close = (major == 1 && minor == 0);
+
+    /* Header lines between the status line and the blank line */
+    size_t pos = (size_t)find_crlf(conn, 0) + CRLF_LEN;
+    while (pos < (size_t)end + CRLF_LEN) {
+        size_t line_end = (size_t)find_crlf(conn, pos);
+        const char* line = conn->buffer + pos;
+        size_t len = line_end - pos;
+        size_t value_len = 0;
+        const char* value;
+
+        if ((value = header_value(line, len, "Content-Length", &value_len))) {
+            char* endptr = NULL;
+            head->content_length = strtoull(value, &endptr, DECIMAL_BASE);
+            if (endptr == value) {
+                argo_report_error(E_PROTOCOL_FORMAT, "ollama_read_head", "bad Content-Length");
+                return E_PROTOCOL_FORMAT;
+            }
+            head->has_length = true;
+        } else if ((value = header_value(line, len, "Transfer-Encoding", &value_len))) {
+            head->chunked = header_has_token(value, value_len, "chunked");
+        } else if ((value = header_value(line, len, "Connection", &value_len))) {
+            if (header_has_token(value, value_len, "close")) head->close = true;
+            if (header_has_token(value, value_len, "keep-alive")) head->close = false;
+        }
+        pos = line_end + CRLF_LEN;
+    }
+
+    conn_consume(conn, (size_t)end + 2 * CRLF_LEN);
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Deliver exactly want body bytes */
+static int read_exact(ollama_conn_t* conn, size_t want, ollama_body_fn on_body, void* userdata) {
+    while (want > 0) {
+        if (conn->length == 0) {
+            bool eof = false;
+            int result = conn_fill(conn, &eof);
+            if (result != ARGO_SUCCESS) return result;
+            if (eof) {
+                argo_report_error(E_PROTOCOL_FORMAT, "ollama_read_body", "connection closed mid-body");
+                return E_PROTOCOL_FORMAT;
+            }
+        }
+        size_t take = conn->length < want ? conn->length : want;
+        if (on_body) on_body(conn->buffer, take, userdata);
+        conn_consume(conn, take);
+        want -= take;
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Chunked transfer encoding */
+static int read_chunked(ollama_conn_t* conn, ollama_body_fn on_body, void* userdata) {
+    for (;;) {
+        size_t line_len = 0;
+        int result = read_line(conn, OLLAMA_HEADER_MAX, &line_len);
+        if (result != ARGO_SUCCESS) return result;
+
+        char* endptr = NULL;
+        unsigned long long size = strtoull(conn->buffer, &endptr, HEX_BASE);
+        if (endptr == conn->buffer) {
+            argo_report_error(E_PROTOCOL_FORMAT, "ollama_read_chunked", "bad chunk size");
+            return E_PROTOCOL_FORMAT;
+        }
+        conn_consume(conn, line_len + CRLF_LEN);
+
+        if (size == 0) {
+            /* Trailer section ends with an empty line */
+            do {
+                result = read_line(conn, OLLAMA_HEADER_MAX, &line_len);
+                if (result != ARGO_SUCCESS) return result;
+                conn_consume(conn, line_len + CRLF_LEN);
+            } while (line_len > 0);
+            return ARGO_SUCCESS;
+        }
+
+        result = read_exact(conn, (size_t)size, on_body, userdata);
+        if (result != ARGO_SUCCESS) return result;
+
+        result = read_line(conn, CRLF_LEN, &line_len);
+        if (result != ARGO_SUCCESS) return result;
+        if (line_len != 0) {
+            argo_report_error(E_PROTOCOL_FORMAT, "ollama_read_chunked", "chunk not followed by CRLF");
+            return E_PROTOCOL_FORMAT;
+        }
+        conn_consume(conn, CRLF_LEN);
+    }
+}
+
+/* Helper: Body delimited by connection close */
+static int read_to_eof(ollama_conn_t* conn, ollama_body_fn on_body, void* userdata) {
+    for (;;) {
+        if (conn->length > 0) {
+            if (on_body) on_body(conn->buffer, conn->length, userdata);
+            conn_consume(conn, conn->length);
+        }
+        bool eof = false;
+        int result = conn_fill(conn, &eof);
+        if (result != ARGO_SUCCESS || eof) return result;
+    }
+}
+
+/* Helper: Write all bytes */
+static int send_all(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t sent = send(fd, data, len, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return E_SYSTEM_SOCKET;
+        }
+        data += sent;
+        len -= (size_t)sent;
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Request line, headers and body */
+static int send_request(ollama_conn_t* conn, const char* method, const char* path,
+                        const char* body, size_t body_len) {
+    char head[OLLAMA_HOST_SIZE + 256];
+    int head_len;
+    if (body) {
+        head_len = snprintf(head, sizeof(head),
+                           "%s %s HTTP/1.1\r\n" /* GUIDELINE_APPROVED: HTTP/1.1 protocol headers */
+                           "Host: %s:%d\r\n" /* GUIDELINE_APPROVED: HTTP/1.1 protocol headers */
+                           "Content-Type: application/json\r\n" /* GUIDELINE_APPROVED: HTTP/1.1 protocol headers */
+                           "Content-Length: %zu\r\n" /* GUIDELINE_APPROVED: HTTP/1.1 protocol headers */
+                           "\r\n", /* GUIDELINE_APPROVED: HTTP/1.1 protocol headers */
+                           method, path, conn->host, conn->port, body_len);
+    } else {
+        head_len = snprintf(head, sizeof(head),
+                           "%s %s HTTP/1.1\r\n" /* GUIDELINE_APPROVED: HTTP/1.1 protocol headers */
+                           "Host: %s:%d\r\n" /* GUIDELINE_APPROVED: HTTP/1.1 protocol headers */
+                           "\r\n", /* GUIDELINE_APPROVED: HTTP/1.1 protocol headers */
+                           method, path, conn->host, conn->port);
+    }
+    if (head_len < 0 || head_len >= (int)sizeof(head)) {
+        return E_PROTOCOL_SIZE;
+    }
+
+    int result = send_all(conn->fd, head, (size_t)head_len);
+    if (result == ARGO_SUCCESS && body) {
+        result = send_all(conn->fd, body, body_len);
+    }
+    return result;
+}
+
+/* Send one request and read the complete response */
+int ollama_conn_request(ollama_conn_t* conn, const char* method, const char* path,
+                        const char* body, size_t body_len,
+                        ollama_body_fn on_body, void* userdata, int* status) {
+    ARGO_CHECK_NULL(conn);
+    ARGO_CHECK_NULL(method);
+    ARGO_CHECK_NULL(path);
+
+    response_head_t head;
+    int result = ARGO_SUCCESS;
+    for (int attempt = 0; ; attempt++) {
+        if (conn->fd >= 0 && conn_is_stale(conn)) {
+            LOG_DEBUG("Ollama keep-alive connection went stale, reconnecting");
+            ollama_conn_close(conn);
+        }
+        bool reused = conn->fd >= 0;
+        result = ollama_conn_open(conn, OLLAMA_CONNECT_TIMEOUT_MS);
+        if (result != ARGO_SUCCESS) {
+            return result;
+        }
+
+        bool got_bytes = false;
+        result = send_request(conn, method, path, body, body_len);
+        if (result == ARGO_SUCCESS) {
+            result = read_head(conn, &head, &got_bytes);
+        }
+        if (result == ARGO_SUCCESS) break;
+
+        ollama_conn_close(conn);
+        bool dead_reused = reused && !got_bytes && attempt == 0 &&
+                           (result == E_SYSTEM_SOCKET || result == E_SYSTEM_NETWORK);
+        if (dead_reused) {
+            LOG_DEBUG("Ollama closed reused connection, retrying once");
+            continue;
+        }
+        if (result == E_SYSTEM_SOCKET || result == E_SYSTEM_NETWORK) {
+            argo_report_error(result, "ollama_conn_request", "%s %s: %s",
+                             method, path, got_bytes ? "connection closed mid-response" : ERR_MSG_SOCKET_SEND_FAILED);
+        }
+        return result;
+    }
+
+    if (status) *status = head.status;
+
+    /* 1xx, 204 and 304 carry no body */
+    bool no_body = head.status < 200 || head.status == 204 || head.status == 304;
+    if (no_body) {
+        result = ARGO_SUCCESS;
+    } else if (head.chunked) {
+        result = read_chunked(conn, on_body, userdata);
+    } else if (head.has_length) {
+        result = read_exact(conn, head.content_length, on_body, userdata);
+    } else {
+        result = read_to_eof(conn, on_body, userdata);
+        head.close = true;
+    }
+
+    if (result != ARGO_SUCCESS || head.close) {
+        ollama_conn_close(conn);
+    }
+    if (result == ARGO_SUCCESS) {
+        conn->requests++;
+    } else if (result == E_SYSTEM_NETWORK) {
+        argo_report_error(result, "ollama_conn_request", "%s %s: connection closed mid-response", method, path);
+    }
+    return result;
+}
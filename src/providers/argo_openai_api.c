@@ -10,18 +10,28 @@
 #include "argo_api_providers.h"
 #include "argo_api_keys.h"
 #include "argo_api_common.h"
+#include "argo_stream_decoder.h"
 
 /* OpenAI-specific JSON request builder */
-static int openai_build_request(char* json_body, size_t buffer_size,
-                                const char* model, const char* prompt) {
-    return snprintf(json_body, buffer_size,
-                   "{" /* GUIDELINE_APPROVED: OpenAI API JSON template */
-                   "\"model\":\"%s\"," /* GUIDELINE_APPROVED: OpenAI API JSON template */
-                   "\"messages\":[{\"role\":\"user\",\"content\":\"%s\"}]," /* GUIDELINE_APPROVED: OpenAI API JSON template */
-                   "\"max_tokens\":%d," /* GUIDELINE_APPROVED: OpenAI API JSON template */
-                   "\"temperature\":0.7" /* GUIDELINE_APPROVED: OpenAI API JSON template */
-                   "}", /* GUIDELINE_APPROVED: OpenAI API JSON template */
-                   model, prompt, API_MAX_TOKENS);
+static int openai_build_request(json_builder_t* json, const char* model,
+                                const char* prompt, bool stream) {
+    api_chat_message_t message = { API_ROLE_USER, prompt };
+
+    json_builder_object_begin(json);
+    json_builder_key_string(json, "model", model); /* GUIDELINE_APPROVED: OpenAI API JSON field */
+    if (stream) {
+        json_builder_key_bool(json, API_STREAM_FIELD, true);
+        json_builder_key(json, API_STREAM_OPTIONS_FIELD);
+        json_builder_object_begin(json);
+        json_builder_key_bool(json, API_STREAM_INCLUDE_USAGE_FIELD, true);
+        json_builder_object_end(json);
+    }
+    api_json_chat_messages(json, &message, 1);
+    json_builder_key_int(json, "max_tokens", API_MAX_TOKENS); /* GUIDELINE_APPROVED: OpenAI API JSON field */
+    json_builder_key(json, "temperature"); /* GUIDELINE_APPROVED: OpenAI API JSON field */
+    json_builder_double(json, API_DEFAULT_TEMPERATURE);
+    json_builder_object_end(json);
+    return json_builder_error(json);
 }
 
 /* OpenAI API configuration */
@@ -41,6 +51,7 @@ static const api_provider_config_t openai_config = {
     .response_path_depth = 2,
     .build_request = openai_build_request,
     .supports_streaming = true,
+    .stream_delta_pointer = STREAM_DELTA_OPENAI,
     .max_context = OPENAI_MAX_CONTEXT
 };
 
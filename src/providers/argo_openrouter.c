@@ -11,6 +11,7 @@
 #include "argo_api_providers.h"
 #include "argo_api_keys.h"
 #include "argo_api_common.h"
+#include "argo_stream_decoder.h"
 #include "argo_error.h"
 #include "argo_log.h"
 #include "argo_limits.h"
@@ -37,16 +38,19 @@ bool openrouter_is_available(void) {
 }
 
 /* OpenRouter-specific JSON request builder */
-static int openrouter_build_request(char* json_body, size_t buffer_size,
-                                    const char* model, const char* prompt) {
-    return snprintf(json_body, buffer_size,
-                   "{" /* GUIDELINE_APPROVED: OpenRouter API JSON template */
-                   "\"model\":\"%s\"," /* GUIDELINE_APPROVED: OpenRouter API JSON template */
-                   "\"messages\":[{\"role\":\"user\",\"content\":\"%s\"}]," /* GUIDELINE_APPROVED: OpenRouter API JSON template */
-                   "\"max_tokens\":%d," /* GUIDELINE_APPROVED: OpenRouter API JSON template */
-                   "\"stream\":false" /* GUIDELINE_APPROVED: OpenRouter API JSON template */
-                   "}", /* GUIDELINE_APPROVED: OpenRouter API JSON template */
-                   model, prompt, API_MAX_TOKENS);
+static int openrouter_build_request(json_builder_t* json, const char* model,
+                                    const char* prompt, bool stream) {
+    api_chat_message_t message = { API_ROLE_USER, prompt };
+
+    json_builder_object_begin(json);
+    json_builder_key_string(json, "model", model); /* GUIDELINE_APPROVED: OpenRouter API JSON field */
+    if (stream) {
+        json_builder_key_bool(json, API_STREAM_FIELD, true);
+    }
+    api_json_chat_messages(json, &message, 1);
+    json_builder_key_int(json, "max_tokens", API_MAX_TOKENS); /* GUIDELINE_APPROVED: OpenRouter API JSON field */
+    json_builder_object_end(json);
+    return json_builder_error(json);
 }
 
 /* Response path for JSON extraction */
@@ -67,6 +71,7 @@ static api_provider_config_t openrouter_config = {
     .response_path_depth = 3,
     .build_request = openrouter_build_request,
     .supports_streaming = true,
+    .stream_delta_pointer = STREAM_DELTA_OPENAI,
     .max_context = OPENROUTER_DEFAULT_CONTEXT
 };
 
@@ -0,0 +1,310 @@
+/* © 2025 Casey Koons All rights reserved */
+
+/* Provider Pool - warm providers keyed by (provider, model) with checkout/checkin */
+
+/* System includes */
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+/* Project includes */
+#include "argo_provider_pool.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_log.h"
+
+typedef enum {
+    POOL_SLOT_EMPTY = 0,
+    POOL_SLOT_RESERVED,         /* Provider being created for a checkout */
+    POOL_SLOT_IDLE,
+    POOL_SLOT_BUSY
+} pool_slot_state_t;
+
+typedef struct {
+    pool_slot_state_t state;
+    ci_provider_t* provider;
+    char name[CI_NAME_MAX];
+    char model[CI_MODEL_MAX];   /* "" for provider default */
+    time_t created;
+    time_t last_used;
+} pool_slot_t;
+
+struct provider_pool {
+    pthread_mutex_t lock;       /* Guards slots and counters */
+    provider_factory_fn factory;
+    pool_slot_t* slots;
+    int max_size;
+    int idle_seconds;
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long evictions;
+};
+
+/* Helper: Clean up a provider outside the pool lock */
+static void destroy_provider(ci_provider_t* provider) {
+    if (provider && provider->cleanup) {
+        provider->cleanup(provider);
+    }
+}
+
+/* Helper: Idle slot past its idle limit or maximum age */
+static bool slot_expired(const provider_pool_t* pool, const pool_slot_t* slot, time_t now) {
+    return slot->state == POOL_SLOT_IDLE &&
+           (now - slot->last_used >= pool->idle_seconds ||
+            now - slot->created >= PROVIDER_POOL_MAX_AGE_SECONDS);
+}
+
+/* Helper: Empty a slot, handing back its provider (caller holds lock) */
+static ci_provider_t* evict_slot(provider_pool_t* pool, pool_slot_t* slot) {
+    ci_provider_t* provider = slot->provider;
+    memset(slot, 0, sizeof(*slot));
+    pool->evictions++;
+    return provider;
+}
+
+/* Helper: Provider may be reused after this result */
+static bool result_is_healthy(int result) {
+    return result == ARGO_SUCCESS ||
+           result == E_CI_TIMEOUT ||
+           result == E_CI_CANCELLED ||
+           ARGO_ERROR_TYPE(result) == ERR_PROTOCOL;  /* Remote answered with an error */
+}
+
+/* Helper: Find a warm match, or reserve a slot (caller holds lock)
+ *
+ * Returns the slot (IDLE→BUSY match, or RESERVED), or NULL when the pool
+ * is full of busy providers. *evicted receives an LRU provider to clean up.
+ */
+static pool_slot_t* claim_slot(provider_pool_t* pool, const char* name, const char* model,
+                               time_t now, bool* warm, ci_provider_t** evicted) {
+    pool_slot_t* empty = NULL;
+    pool_slot_t* lru = NULL;
+
+    for (int i = 0; i < pool->max_size; i++) {
+        pool_slot_t* slot = &pool->slots[i];
+        if (slot->state == POOL_SLOT_IDLE &&
+            strcmp(slot->name, name) == 0 && strcmp(slot->model, model) == 0 &&
+            !slot_expired(pool, slot, now)) {
+            slot->state = POOL_SLOT_BUSY;
+            *warm = true;
+            return slot;
+        }
+        if (slot->state == POOL_SLOT_EMPTY && !empty) {
+            empty = slot;
+        } else if (slot->state == POOL_SLOT_IDLE && (!lru || slot->last_used < lru->last_used)) {
+            lru = slot;
+        }
+    }
+
+    pool_slot_t* slot = empty;
+    if (!slot && lru) {
+        *evicted = evict_slot(pool, lru);
+        slot = lru;
+    }
+    if (slot) {
+        slot->state = POOL_SLOT_RESERVED;
+        strncpy(slot->name, name, sizeof(slot->name) - 1);
+        strncpy(slot->model, model, sizeof(slot->model) - 1);
+    }
+    *warm = false;
+    return slot;
+}
+
+/* Helper: Create, init and connect a provider */
+static int start_provider(provider_pool_t* pool, const char* name, const char* model,
+                          ci_provider_t** out) {
+    ci_provider_t* provider = pool->factory(name, model);
+    if (!provider) {
+        return E_NOT_FOUND;
+    }
+
+    int result = ARGO_SUCCESS;
+    if (provider->init) {
+        result = provider->init(provider);
+    }
+    if (result == ARGO_SUCCESS && provider->connect) {
+        result = provider->connect(provider);
+    }
+    if (result != ARGO_SUCCESS) {
+        destroy_provider(provider);
+        return result;
+    }
+
+    *out = provider;
+    return ARGO_SUCCESS;
+}
+
+/* Create pool */
+provider_pool_t* provider_pool_create(provider_factory_fn factory, int max_size, int idle_seconds) {
+    if (!factory) {
+        argo_report_error(E_INPUT_NULL, "provider_pool_create", "factory required");
+        return NULL;
+    }
+
+    provider_pool_t* pool = calloc(1, sizeof(provider_pool_t));
+    if (!pool) {
+        argo_report_error(E_SYSTEM_MEMORY, "provider_pool_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return NULL;
+    }
+
+    pool->max_size = max_size > 0 ? max_size : PROVIDER_POOL_DEFAULT_MAX_SIZE;
+    pool->idle_seconds = idle_seconds > 0 ? idle_seconds : PROVIDER_POOL_DEFAULT_IDLE_SECONDS;
+    pool->slots = calloc((size_t)pool->max_size, sizeof(pool_slot_t));
+    if (!pool->slots) {
+        argo_report_error(E_SYSTEM_MEMORY, "provider_pool_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+        free(pool);
+        return NULL;
+    }
+
+    pool->factory = factory;
+    pthread_mutex_init(&pool->lock, NULL);
+    return pool;
+}
+
+/* Check out a ready provider */
+int provider_pool_checkout(provider_pool_t* pool, const char* provider_name,
+                           const char* model, ci_provider_t** provider) {
+    ARGO_CHECK_NULL(pool);
+    ARGO_CHECK_NULL(provider_name);
+    ARGO_CHECK_NULL(provider);
+
+    const char* key_model = model ? model : "";
+    time_t now = time(NULL);
+    bool warm = false;
+    ci_provider_t* evicted = NULL;
+
+    pthread_mutex_lock(&pool->lock);
+    pool_slot_t* slot = claim_slot(pool, provider_name, key_model, now, &warm, &evicted);
+    if (warm) {
+        pool->hits++;
+        slot->last_used = now;
+        *provider = slot->provider;
+        pthread_mutex_unlock(&pool->lock);
+        return ARGO_SUCCESS;
+    }
+    pool->misses++;
+    pthread_mutex_unlock(&pool->lock);
+
+    destroy_provider(evicted);
+
+    /* Setup runs unlocked: connect may fork (claude_code) */
+    ci_provider_t* created = NULL;
+    int result = start_provider(pool, provider_name, model, &created);
+
+    pthread_mutex_lock(&pool->lock);
+    if (slot && result == ARGO_SUCCESS) {
+        slot->state = POOL_SLOT_BUSY;
+        slot->provider = created;
+        slot->created = now;
+        slot->last_used = now;
+    } else if (slot) {
+        memset(slot, 0, sizeof(*slot));
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    if (result == ARGO_SUCCESS) {
+        if (!slot) {
+            LOG_DEBUG("Provider pool full, %s checked out unpooled", provider_name);
+        }
+        *provider = created;
+    }
+    return result;
+}
+
+/* Return a provider */
+void provider_pool_checkin(provider_pool_t* pool, ci_provider_t* provider, int result) {
+    if (!pool || !provider) return;
+
+    bool keep = result_is_healthy(result);
+    bool pooled = false;
+
+    pthread_mutex_lock(&pool->lock);
+    for (int i = 0; i < pool->max_size; i++) {
+        pool_slot_t* slot = &pool->slots[i];
+        if (slot->state != POOL_SLOT_BUSY || slot->provider != provider) continue;
+
+        pooled = true;
+        if (keep) {
+            slot->state = POOL_SLOT_IDLE;
+            slot->last_used = time(NULL);
+        } else {
+            evict_slot(pool, slot);
+        }
+        break;
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    if (!pooled || !keep) {
+        if (!keep) {
+            LOG_DEBUG("Discarding %s provider after error %d", provider->name, result);
+        }
+        destroy_provider(provider);
+    }
+}
+
+/* Evict idle providers past their limits */
+int provider_pool_evict_idle(provider_pool_t* pool) {
+    if (!pool) return 0;
+
+    ci_provider_t** evicted = calloc((size_t)pool->max_size, sizeof(ci_provider_t*));
+    if (!evicted) return 0;
+
+    int count = 0;
+    time_t now = time(NULL);
+    pthread_mutex_lock(&pool->lock);
+    for (int i = 0; i < pool->max_size; i++) {
+        if (slot_expired(pool, &pool->slots[i], now)) {
+            evicted[count++] = evict_slot(pool, &pool->slots[i]);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < count; i++) {
+        destroy_provider(evicted[i]);
+    }
+    free(evicted);
+
+    if (count > 0) {
+        LOG_DEBUG("Provider pool evicted %d idle providers", count);
+    }
+    return count;
+}
+
+/* Snapshot of pool counters */
+void provider_pool_get_stats(provider_pool_t* pool, provider_pool_stats_t* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    for (int i = 0; i < pool->max_size; i++) {
+        if (pool->slots[i].state == POOL_SLOT_IDLE) {
+            stats->idle++;
+        } else if (pool->slots[i].state != POOL_SLOT_EMPTY) {
+            stats->busy++;
+        }
+    }
+    stats->hits = pool->hits;
+    stats->misses = pool->misses;
+    stats->evictions = pool->evictions;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/* Destroy pool */
+void provider_pool_destroy(provider_pool_t* pool) {
+    if (!pool) return;
+
+    for (int i = 0; i < pool->max_size; i++) {
+        pool_slot_t* slot = &pool->slots[i];
+        if (slot->state == POOL_SLOT_IDLE) {
+            destroy_provider(slot->provider);
+        } else if (slot->state != POOL_SLOT_EMPTY) {
+            LOG_WARN("Provider pool destroyed with %s still checked out", slot->name);
+        }
+    }
+
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->slots);
+    free(pool);
+}
@@ -0,0 +1,596 @@
+/* © 2025 Casey Koons All rights reserved */
+
+/* Provider Router - latency-aware candidate ranking, failover and hedging */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* clock_gettime(), strtok_r(), strcasecmp() */
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+/* Project includes */
+#include "argo_provider_router.h"
+#include "argo_config.h"
+#include "argo_env_utils.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_log.h"
+#include "argo_limits.h"
+#include "argo_time.h"
+
+/* Candidates that have only failed rank as if this slow */
+#define ROUTER_FAILED_LATENCY_MS PROVIDER_ROUTER_DEFAULT_HEDGE_MS
+#define ROUTER_CONFIG_LIST_SIZE 1024
+
+/* Running statistics of one provider/model, shared by every route */
+typedef struct router_endpoint {
+    provider_route_stats_t stats;           /* p95_ms and healthy filled on snapshot */
+    int samples[PROVIDER_ROUTER_SAMPLES];   /* Ring of success latencies */
+    int sample_count;
+    int sample_next;
+    long long failed_at_ms;                 /* Monotonic, last failure */
+    struct router_endpoint* next;
+} router_endpoint_t;
+
+typedef struct {
+    char name[PROVIDER_ROUTER_NAME_SIZE];
+    router_endpoint_t* candidates[PROVIDER_ROUTER_MAX_CANDIDATES];   /* Config order */
+    int count;
+} router_route_t;
+
+struct provider_router {
+    pthread_mutex_t lock;       /* Guards routes and endpoints */
+    router_route_t routes[PROVIDER_ROUTER_MAX_ROUTES];
+    int route_count;
+    router_endpoint_t* endpoints;
+};
+
+/* Completion signal shared by the attempts of one query */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+} route_wait_t;
+
+/* One candidate started for a query */
+typedef struct {
+    route_wait_t* wait;
+    const provider_route_stats_t* candidate;
+    ci_future_t* future;
+    long long started_ms;
+    long long finished_ms;
+    bool finished;              /* Callback ran (under wait->lock) */
+    bool settled;               /* Outcome handled by the query */
+} route_attempt_t;
+
+/* Helper: Endpoint for provider/model, created on first use (caller holds lock) */
+static router_endpoint_t* find_endpoint(provider_router_t* router, const char* provider,
+                                        const char* model, bool create) {
+    if (!model) model = "";
+    for (router_endpoint_t* endpoint = router->endpoints; endpoint; endpoint = endpoint->next) {
+        if (strcmp(endpoint->stats.provider, provider) == 0 &&
+            strcmp(endpoint->stats.model, model) == 0) {
+            return endpoint;
+        }
+    }
+    if (!create) return NULL;
+
+    router_endpoint_t* endpoint = calloc(1, sizeof(router_endpoint_t));
+    if (!endpoint) return NULL;
+    snprintf(endpoint->stats.provider, sizeof(endpoint->stats.provider), "%s", provider);
+    snprintf(endpoint->stats.model, sizeof(endpoint->stats.model), "%s", model);
+    endpoint->next = router->endpoints;
+    router->endpoints = endpoint;
+    return endpoint;
+}
+
+/* Helper: Route by name (caller holds lock) */
+static router_route_t* find_route(provider_router_t* router, const char* name) {
+    for (int i = 0; i < router->route_count; i++) {
+        if (strcasecmp(router->routes[i].name, name) == 0) {
+            return &router->routes[i];
+        }
+    }
+    return NULL;
+}
+
+/* Helper: 95th percentile of the latency ring */
+static int percentile_95(const router_endpoint_t* endpoint) {
+    int count = endpoint->sample_count;
+    if (count == 0) return 0;
+
+    int sorted[PROVIDER_ROUTER_SAMPLES];
+    memcpy(sorted, endpoint->samples, (size_t)count * sizeof(int));
+    for (int i = 1; i < count; i++) {
+        int value = sorted[i];
+        int j = i - 1;
+        while (j >= 0 && sorted[j] > value) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = value;
+    }
+    return sorted[(count * 95 + 99) / 100 - 1];
+}
+
+/* Helper: Copy of stats with derived fields (caller holds lock) */
+static provider_route_stats_t snapshot(const router_endpoint_t* endpoint, long long now) {
+    provider_route_stats_t stats = endpoint->stats;
+    stats.p95_ms = percentile_95(endpoint);
+    stats.healthy = stats.consecutive_failures < PROVIDER_ROUTER_FAILURE_THRESHOLD ||
+                    now - endpoint->failed_at_ms >= PROVIDER_ROUTER_COOLDOWN_MS;
+    return stats;
+}
+
+/* Helper: Expected cost; never-tried candidates score 0 so they get explored */
+static double score(const provider_route_stats_t* stats) {
+    double latency = stats->successes ? stats->latency_ms
+                   : (stats->failures ? ROUTER_FAILED_LATENCY_MS : 0.0);
+    return latency * (1.0 + PROVIDER_ROUTER_ERROR_WEIGHT * stats->error_rate);
+}
+
+/* Helper: True if a should be tried before b */
+static bool ranks_before(const provider_route_stats_t* a, const provider_route_stats_t* b) {
+    if (a->healthy != b->healthy) return a->healthy;
+    return score(a) < score(b);
+}
+
+/* Create router */
+provider_router_t* provider_router_create(void) {
+    provider_router_t* router = calloc(1, sizeof(provider_router_t));
+    if (!router) {
+        argo_report_error(E_SYSTEM_MEMORY, "provider_router_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return NULL;
+    }
+    pthread_mutex_init(&router->lock, NULL);
+    return router;
+}
+
+/* Destroy router */
+void provider_router_destroy(provider_router_t* router) {
+    if (!router) return;
+
+    router_endpoint_t* endpoint = router->endpoints;
+    while (endpoint) {
+        router_endpoint_t* next = endpoint->next;
+        free(endpoint);
+        endpoint = next;
+    }
+    pthread_mutex_destroy(&router->lock);
+    free(router);
+}
+
+/* Helper: Trim spaces in place */
+static char* trim(char* text) {
+    while (isspace((unsigned char)*text)) text++;
+    char* end = text + strlen(text);
+    while (end > text && isspace((unsigned char)end[-1])) end--;
+    *end = '\0';
+    return text;
+}
+
+/* Add or replace a route */
+int provider_router_add_route(provider_router_t* router, const char* name, const char* candidates) {
+    ARGO_CHECK_NULL(router);
+    ARGO_CHECK_NULL(name);
+    ARGO_CHECK_NULL(candidates);
+
+    router_route_t route = {0};
+    int result = ARGO_SUCCESS;
+    char* list = strdup(candidates);
+    if (!list) {
+        return E_SYSTEM_MEMORY;
+    }
+    if (!*name || strlen(name) >= sizeof(route.name)) {
+        result = E_INVALID_PARAMS;
+        goto cleanup;
+    }
+    snprintf(route.name, sizeof(route.name), "%s", name);
+
+    pthread_mutex_lock(&router->lock);
+    char* save = NULL;
+    for (char* item = strtok_r(list, ",", &save); item; item = strtok_r(NULL, ",", &save)) {
+        char* provider = trim(item);
+        if (!*provider) continue;
+        if (route.count == PROVIDER_ROUTER_MAX_CANDIDATES) {
+            result = E_INVALID_PARAMS;
+            break;
+        }
+
+        /* Model follows the first '/', so "openrouter/vendor/model" keeps its slash */
+        char* model = strchr(provider, '/');
+        if (model) {
+            *model++ = '\0';
+            provider = trim(provider);
+            model = trim(model);
+        }
+        router_endpoint_t* endpoint = find_endpoint(router, provider, model, true);
+        if (!endpoint) {
+            result = E_SYSTEM_MEMORY;
+            break;
+        }
+        route.candidates[route.count++] = endpoint;
+    }
+    if (result == ARGO_SUCCESS && route.count == 0) {
+        result = E_INVALID_PARAMS;
+    }
+
+    if (result == ARGO_SUCCESS) {
+        router_route_t* existing = find_route(router, name);
+        if (existing) {
+            *existing = route;
+        } else if (router->route_count < PROVIDER_ROUTER_MAX_ROUTES) {
+            router->routes[router->route_count++] = route;
+        } else {
+            result = E_RESOURCE_LIMIT;
+        }
+    }
+    pthread_mutex_unlock(&router->lock);
+
+    if (result == ARGO_SUCCESS) {
+        LOG_INFO("Provider route %s: %d candidates", name, route.count);
+    }
+
+cleanup:
+    free(list);
+    return result;
+}
+
+/* Helper: Value from config, then environment */
+static const char* config_value(const char* key) {
+    const char* value = argo_config_get(key);
+    return (value && *value) ? value : argo_getenv(key);
+}
+
+/* Load routes named in CI_ROUTES */
+int provider_router_load_config(provider_router_t* router, int* loaded) {
+    if (loaded) *loaded = 0;
+    ARGO_CHECK_NULL(router);
+
+    const char* names = config_value(PROVIDER_ROUTER_ROUTES_CONFIG_KEY);
+    if (!names || !*names) return ARGO_SUCCESS;
+
+    char list[ROUTER_CONFIG_LIST_SIZE];
+    int needed = snprintf(list, sizeof(list), "%s", names);
+    if (needed < 0 || (size_t)needed >= sizeof(list)) {
+        argo_report_error(E_INPUT_TOO_LARGE, "provider_router_load_config",
+                          PROVIDER_ROUTER_ROUTES_CONFIG_KEY);
+        return E_INPUT_TOO_LARGE;
+    }
+
+    int result = ARGO_SUCCESS;
+    char* save = NULL;
+    for (char* item = strtok_r(list, ",", &save); item; item = strtok_r(NULL, ",", &save)) {
+        char* name = trim(item);
+        if (!*name) continue;
+
+        char key[ARGO_BUFFER_MEDIUM];
+        size_t prefix = strlen(PROVIDER_ROUTER_ROUTE_CONFIG_PREFIX);
+        snprintf(key, sizeof(key), "%s%s", PROVIDER_ROUTER_ROUTE_CONFIG_PREFIX, name);
+        for (char* c = key + prefix; *c; c++) {
+            *c = (char)toupper((unsigned char)*c);
+        }
+
+        const char* candidates = config_value(key);
+        if (!candidates) {
+            LOG_WARN("Route %s listed in %s but %s is not set", name,
+                     PROVIDER_ROUTER_ROUTES_CONFIG_KEY, key);
+            result = E_INVALID_PARAMS;
+            continue;
+        }
+        if (provider_router_add_route(router, name, candidates) != ARGO_SUCCESS) {
+            LOG_WARN("Ignoring invalid %s: %s", key, candidates);
+            result = E_INVALID_PARAMS;
+            continue;
+        }
+        if (loaded) (*loaded)++;
+    }
+    return result;
+}
+
+/* True if name is a defined route */
+bool provider_router_has_route(provider_router_t* router, const char* name) {
+    if (!router || !name) return false;
+
+    pthread_mutex_lock(&router->lock);
+    bool found = find_route(router, name) != NULL;
+    pthread_mutex_unlock(&router->lock);
+    return found;
+}
+
+/* Record one finished query */
+void provider_router_record(provider_router_t* router, const char* provider, const char* model,
+                            int result, long long latency_ms) {
+    if (!router || !provider) return;
+
+    pthread_mutex_lock(&router->lock);
+    router_endpoint_t* endpoint = find_endpoint(router, provider, model, true);
+    if (endpoint) {
+        provider_route_stats_t* stats = &endpoint->stats;
+        double alpha = PROVIDER_ROUTER_EWMA_ALPHA;
+        if (result == ARGO_SUCCESS) {
+            if (latency_ms < 0) latency_ms = 0;
+            stats->latency_ms = stats->successes ? (1.0 - alpha) * stats->latency_ms + alpha * (double)latency_ms
+                                                 : (double)latency_ms;
+            stats->error_rate = (1.0 - alpha) * stats->error_rate;
+            stats->consecutive_failures = 0;
+            stats->successes++;
+            endpoint->samples[endpoint->sample_next] = (int)latency_ms;
+            endpoint->sample_next = (endpoint->sample_next + 1) % PROVIDER_ROUTER_SAMPLES;
+            if (endpoint->sample_count < PROVIDER_ROUTER_SAMPLES) endpoint->sample_count++;
+        } else {
+            stats->error_rate = (1.0 - alpha) * stats->error_rate + alpha;
+            stats->consecutive_failures++;
+            stats->failures++;
+            endpoint->failed_at_ms = argo_monotonic_ms();
+            if (stats->consecutive_failures == PROVIDER_ROUTER_FAILURE_THRESHOLD) {
+                LOG_WARN("Provider %s/%s unhealthy after %d failures", provider,
+                         model ? model : "default", stats->consecutive_failures);
+            }
+        }
+    }
+    pthread_mutex_unlock(&router->lock);
+}
+
+/* Candidates of a route, best first */
+int provider_router_rank(provider_router_t* router, const char* route,
+                         provider_route_stats_t* ranked, int max, int* count) {
+    ARGO_CHECK_NULL(router);
+    ARGO_CHECK_NULL(route);
+    ARGO_CHECK_NULL(ranked);
+    ARGO_CHECK_NULL(count);
+    *count = 0;
+
+    pthread_mutex_lock(&router->lock);
+    router_route_t* found = find_route(router, route);
+    if (!found) {
+        pthread_mutex_unlock(&router->lock);
+        return E_NOT_FOUND;
+    }
+
+    /* Stable insertion sort: config order breaks ties */
+    long long now = argo_monotonic_ms();
+    int n = found->count < max ? found->count : max;
+    for (int i = 0; i < n; i++) {
+        provider_route_stats_t stats = snapshot(found->candidates[i], now);
+        int j = i - 1;
+        while (j >= 0 && ranks_before(&stats, &ranked[j])) {
+            ranked[j + 1] = ranked[j];
+            j--;
+        }
+        ranked[j + 1] = stats;
+    }
+    pthread_mutex_unlock(&router->lock);
+
+    *count = n;
+    return ARGO_SUCCESS;
+}
+
+/* Milliseconds to wait before hedging */
+int provider_router_hedge_delay(provider_router_t* router, const char* provider, const char* model) {
+    if (!router || !provider) return PROVIDER_ROUTER_DEFAULT_HEDGE_MS;
+
+    int delay = PROVIDER_ROUTER_DEFAULT_HEDGE_MS;
+    pthread_mutex_lock(&router->lock);
+    router_endpoint_t* endpoint = find_endpoint(router, provider, model, false);
+    if (endpoint && endpoint->sample_count >= PROVIDER_ROUTER_MIN_HEDGE_SAMPLES) {
+        delay = percentile_95(endpoint);
+    }
+    pthread_mutex_unlock(&router->lock);
+
+    return delay < PROVIDER_ROUTER_MIN_HEDGE_MS ? PROVIDER_ROUTER_MIN_HEDGE_MS : delay;
+}
+
+/* Helper: Future callback - note completion and wake the query */
+static void on_attempt_done(const ci_response_t* response, void* userdata) {
+    (void)response;
+    route_attempt_t* attempt = (route_attempt_t*)userdata;
+
+    pthread_mutex_lock(&attempt->wait->lock);
+    attempt->finished = true;
+    attempt->finished_ms = argo_monotonic_ms();
+    pthread_cond_signal(&attempt->wait->changed);
+    pthread_mutex_unlock(&attempt->wait->lock);
+}
+
+/* Helper: Candidate model, NULL for the provider default */
+static const char* candidate_model(const provider_route_stats_t* candidate) {
+    return candidate->model[0] ? candidate->model : NULL;
+}
+
+/* Helper: Start candidate; a failed start is settled as a failure */
+static int start_attempt(provider_router_t* router, route_attempt_t* attempt,
+                         provider_router_submit_fn submit, void* context, int timeout_ms) {
+    const provider_route_stats_t* candidate = attempt->candidate;
+    const char* model = candidate_model(candidate);
+
+    attempt->started_ms = argo_monotonic_ms();
+    int result = submit(context, candidate->provider, model, timeout_ms,
+                        on_attempt_done, attempt, &attempt->future);
+    if (result != ARGO_SUCCESS) {
+        attempt->future = NULL;
+        attempt->settled = true;
+        provider_router_record(router, candidate->provider, model, result, 0);
+        LOG_WARN("Route candidate %s/%s failed to start: %d", candidate->provider,
+                 model ? model : "default", result);
+    }
+    return result;
+}
+
+/* Helper: Wall-clock time ms from now, for pthread_cond_timedwait */
+static struct timespec wait_until(long long ms) {
+    struct timespec until;
+    clock_gettime(CLOCK_REALTIME, &until);
+    until.tv_sec += ms / MILLISECONDS_PER_SECOND;
+    until.tv_nsec += (long)(ms % MILLISECONDS_PER_SECOND) * NANOSECONDS_PER_MILLISECOND;
+    if (until.tv_nsec >= NANOSECONDS_PER_MILLISECOND * MILLISECONDS_PER_SECOND) {
+        until.tv_sec++;
+        until.tv_nsec -= NANOSECONDS_PER_MILLISECOND * MILLISECONDS_PER_SECOND;
+    }
+    return until;
+}
+
+/* Helper: Sleep until an attempt finishes or wake_ms (0 = no limit) passes */
+static void wait_for_change(route_wait_t* wait, route_attempt_t* attempts, int started,
+                            long long wake_ms) {
+    pthread_mutex_lock(&wait->lock);
+    while (true) {
+        for (int i = 0; i < started; i++) {
+            if (attempts[i].finished && !attempts[i].settled) {
+                pthread_mutex_unlock(&wait->lock);
+                return;
+            }
+        }
+        if (wake_ms == 0) {
+            pthread_cond_wait(&wait->changed, &wait->lock);
+            continue;
+        }
+        long long remaining = wake_ms - argo_monotonic_ms();
+        if (remaining <= 0) break;
+        struct timespec until = wait_until(remaining);
+        if (pthread_cond_timedwait(&wait->changed, &wait->lock, &until) == ETIMEDOUT) break;
+    }
+    pthread_mutex_unlock(&wait->lock);
+}
+
+/* Run a query on a route, failing over until one candidate answers */
+int provider_router_query(provider_router_t* router, const char* route,
+                          provider_router_submit_fn submit, void* context,
+                          int timeout_ms, bool hedge, router_result_t* result) {
+    ARGO_CHECK_NULL(router);
+    ARGO_CHECK_NULL(route);
+    ARGO_CHECK_NULL(submit);
+    ARGO_CHECK_NULL(result);
+    memset(result, 0, sizeof(*result));
+
+    provider_route_stats_t ranked[PROVIDER_ROUTER_MAX_CANDIDATES];
+    int count = 0;
+    int status = provider_router_rank(router, route, ranked, PROVIDER_ROUTER_MAX_CANDIDATES, &count);
+    if (status != ARGO_SUCCESS) {
+        return status;
+    }
+
+    route_wait_t wait;
+    pthread_mutex_init(&wait.lock, NULL);
+    pthread_cond_init(&wait.changed, NULL);
+    route_attempt_t attempts[PROVIDER_ROUTER_MAX_CANDIDATES];
+    memset(attempts, 0, sizeof(attempts));
+
+    if (timeout_ms <= 0) timeout_ms = CI_ENGINE_DEFAULT_TIMEOUT_MS;
+    long long deadline = argo_monotonic_ms() + timeout_ms;
+    long long hedge_at = 0;
+    int started = 0;
+    int active = 0;
+    int winner = -1;
+    status = E_CI_TIMEOUT;
+
+    while (winner < 0) {
+        /* Settle finished attempts */
+        for (int i = 0; i < started; i++) {
+            route_attempt_t* attempt = &attempts[i];
+            pthread_mutex_lock(&wait.lock);
+            bool finished = attempt->finished && !attempt->settled;
+            pthread_mutex_unlock(&wait.lock);
+            if (!finished) continue;
+
+            ci_future_wait(attempt->future, CI_ENGINE_NO_TIMEOUT);
+            const ci_response_t* response = ci_future_response(attempt->future);
+            const provider_route_stats_t* candidate = attempt->candidate;
+            int outcome = response->success ? ARGO_SUCCESS : response->error_code;
+            attempt->settled = true;
+            active--;
+            if (outcome != E_CI_CANCELLED) {
+                provider_router_record(router, candidate->provider, candidate_model(candidate),
+                                       outcome, attempt->finished_ms - attempt->started_ms);
+            }
+            if (outcome == ARGO_SUCCESS) {
+                winner = i;
+                break;
+            }
+            status = outcome;
+            LOG_WARN("Route %s: %s/%s failed (%d)", route, candidate->provider,
+                     candidate->model[0] ? candidate->model : "default", outcome);
+        }
+        if (winner >= 0 || status == E_CI_CANCELLED) break;
+
+        /* Next candidate when nothing is running, or hedge a slow one */
+        long long now = argo_monotonic_ms();
+        if (now >= deadline) hedge_at = 0;
+        bool hedge_due = hedge_at && now >= hedge_at && active > 0;
+        if ((active == 0 || hedge_due) && started < count && now < deadline) {
+            route_attempt_t* attempt = &attempts[started];
+            attempt->wait = &wait;
+            attempt->candidate = &ranked[started];
+            int share = (int)((deadline - now) / (count - started));
+            if (hedge_due) {
+                result->hedged = true;
+                LOG_INFO("Route %s: hedging %s with %s", route, ranked[started - 1].provider,
+                         attempt->candidate->provider);
+            }
+            started++;
+            result->attempts++;
+            hedge_at = 0;
+            int start_result = start_attempt(router, attempt, submit, context, share > 0 ? share : 1);
+            if (start_result != ARGO_SUCCESS) {
+                status = start_result;
+                continue;
+            }
+            active++;
+            if (hedge && !result->hedged && started < count) {
+                hedge_at = argo_monotonic_ms() + provider_router_hedge_delay(router, attempt->candidate->provider,
+                                                                        candidate_model(attempt->candidate));
+            }
+            continue;
+        }
+        if (active == 0) break;
+
+        /* The engine completes every attempt by its deadline */
+        wait_for_change(&wait, attempts, started, hedge_at);
+    }
+
+    /* Cancel losers and wait out their callbacks, which reference attempts */
+    for (int i = 0; i < started; i++) {
+        if (!attempts[i].future) continue;
+        if (!attempts[i].settled) {
+            ci_future_cancel(attempts[i].future);
+            ci_future_wait(attempts[i].future, CI_ENGINE_NO_TIMEOUT);
+        }
+    }
+
+    if (winner >= 0) {
+        const ci_response_t* response = ci_future_response(attempts[winner].future);
+        result->content = strdup(response->content ? response->content : "");
+        snprintf(result->provider, sizeof(result->provider), "%s", ranked[winner].provider);
+        snprintf(result->model, sizeof(result->model), "%s", ranked[winner].model);
+        status = result->content ? ARGO_SUCCESS : E_SYSTEM_MEMORY;
+    }
+
+    for (int i = 0; i < started; i++) {
+        if (attempts[i].future) ci_future_release(attempts[i].future);
+    }
+    pthread_cond_destroy(&wait.changed);
+    pthread_mutex_destroy(&wait.lock);
+    return status;
+}
+
+/* Snapshot of every provider/model seen */
+int provider_router_get_stats(provider_router_t* router, provider_route_stats_t* stats, int max) {
+    if (!router || !stats) return 0;
+
+    int count = 0;
+    long long now = argo_monotonic_ms();
+    pthread_mutex_lock(&router->lock);
+    for (router_endpoint_t* endpoint = router->endpoints; endpoint && count < max;
+         endpoint = endpoint->next) {
+        stats[count++] = snapshot(endpoint, now);
+    }
+    pthread_mutex_unlock(&router->lock);
+    return count;
+}
@@ -0,0 +1,203 @@
+/* © 2025 Casey Koons All rights reserved */
+
+/* Provider Telemetry - per provider/model usage counters and latency histogram */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+/* Project includes */
+#include "argo_provider_telemetry.h"
+#include "argo_error.h"
+#include "argo_log.h"
+
+/* Usage fields of the known wire formats (JSON pointers) */
+static const char* const PROMPT_TOKEN_POINTERS[] = {
+    "/usage/prompt_tokens",                 /* OpenAI-compatible */
+    "/usage/input_tokens",                  /* Anthropic, message_delta */
+    "/message/usage/input_tokens",          /* Anthropic, message_start */
+    "/usageMetadata/promptTokenCount",      /* Gemini */
+    "/prompt_eval_count"                    /* Ollama */
+};
+
+static const char* const COMPLETION_TOKEN_POINTERS[] = {
+    "/usage/completion_tokens",
+    "/usage/output_tokens",
+    "/message/usage/output_tokens",
+    "/usageMetadata/candidatesTokenCount",
+    "/eval_count"
+};
+
+#define POINTER_COUNT(list) (sizeof(list) / sizeof(list[0]))
+
+static const long long BUCKET_BOUNDS_MS[PROVIDER_TELEMETRY_BUCKETS - 1] =
+    PROVIDER_TELEMETRY_BUCKET_BOUNDS_MS;
+
+typedef struct telemetry_entry {
+    provider_telemetry_stats_t stats;
+    struct telemetry_entry* next;
+} telemetry_entry_t;
+
+static pthread_mutex_t g_telemetry_lock = PTHREAD_MUTEX_INITIALIZER;
+static telemetry_entry_t* g_entries = NULL;
+static int g_entry_count = 0;
+static bool g_full_logged = false;
+
+/* Helper: Entry for provider/model, created on first use (caller holds lock) */
+static telemetry_entry_t* find_entry(const char* provider, const char* model) {
+    if (!model) model = "";
+
+    for (telemetry_entry_t* entry = g_entries; entry; entry = entry->next) {
+        if (strcmp(entry->stats.provider, provider) == 0 && strcmp(entry->stats.model, model) == 0) {
+            return entry;
+        }
+    }
+
+    if (g_entry_count >= PROVIDER_TELEMETRY_MAX_ENTRIES) {
+        if (!g_full_logged) {
+            LOG_WARN("Provider telemetry full (%d provider/models), not recording %s/%s",
+                     PROVIDER_TELEMETRY_MAX_ENTRIES, provider, model);
+            g_full_logged = true;
+        }
+        return NULL;
+    }
+
+    telemetry_entry_t* entry = calloc(1, sizeof(telemetry_entry_t));
+    if (!entry) return NULL;
+    snprintf(entry->stats.provider, sizeof(entry->stats.provider), "%s", provider);
+    snprintf(entry->stats.model, sizeof(entry->stats.model), "%s", model);
+    entry->next = g_entries;
+    g_entries = entry;
+    g_entry_count++;
+    return entry;
+}
+
+/* Helper: Histogram bucket of a latency */
+static int bucket_for(long long ms) {
+    for (int i = 0; i < PROVIDER_TELEMETRY_BUCKETS - 1; i++) {
+        if (ms <= BUCKET_BOUNDS_MS[i]) return i;
+    }
+    return PROVIDER_TELEMETRY_BUCKETS - 1;
+}
+
+/* Helper: Non-negative value, or 0 */
+static unsigned long long clamp_ms(long long ms) {
+    return ms > 0 ? (unsigned long long)ms : 0;
+}
+
+/* Record one finished call */
+void provider_telemetry_record(const provider_call_t* call) {
+    if (!call || !call->provider) return;
+
+    pthread_mutex_lock(&g_telemetry_lock);
+    telemetry_entry_t* entry = find_entry(call->provider, call->model);
+    if (entry) {
+        provider_telemetry_stats_t* stats = &entry->stats;
+        stats->calls++;
+        if (call->result != ARGO_SUCCESS) stats->failures++;
+        if (call->streamed) stats->streamed++;
+        stats->request_bytes += call->request_bytes;
+        stats->response_bytes += call->response_bytes;
+        stats->prompt_tokens += (unsigned long long)(call->usage.prompt_tokens > 0 ? call->usage.prompt_tokens : 0);
+        stats->completion_tokens += (unsigned long long)(call->usage.completion_tokens > 0 ? call->usage.completion_tokens : 0);
+        stats->queue_ms += clamp_ms(call->queue_ms);
+        if (call->ttfb_ms >= 0) {
+            stats->ttfb_ms += (unsigned long long)call->ttfb_ms;
+            stats->ttfb_samples++;
+        }
+        stats->total_ms += clamp_ms(call->total_ms);
+        if (call->total_ms > stats->max_ms) stats->max_ms = call->total_ms;
+        stats->histogram[bucket_for(call->total_ms)]++;
+        stats->last_call = time(NULL);
+    }
+    pthread_mutex_unlock(&g_telemetry_lock);
+}
+
+/* Helper: Last positive integer found at any of the pointers */
+static void read_counter(json_node_t* root, const char* const* pointers, size_t count, long long* value) {
+    for (size_t i = 0; i < count; i++) {
+        long long found = 0;
+        if (json_doc_get_integer(json_doc_get(root, pointers[i]), &found) && found > 0) {
+            *value = found;
+        }
+    }
+}
+
+/* Merge usage counters of a parsed response or stream event */
+void provider_usage_read(json_node_t* root, provider_usage_t* usage) {
+    if (!root || !usage) return;
+
+    read_counter(root, PROMPT_TOKEN_POINTERS, POINTER_COUNT(PROMPT_TOKEN_POINTERS),
+                 &usage->prompt_tokens);
+    read_counter(root, COMPLETION_TOKEN_POINTERS, POINTER_COUNT(COMPLETION_TOKEN_POINTERS),
+                 &usage->completion_tokens);
+}
+
+/* Merge usage counters of a JSON response body */
+int provider_usage_parse(const char* json, size_t len, provider_usage_t* usage) {
+    ARGO_CHECK_NULL(json);
+    ARGO_CHECK_NULL(usage);
+
+    json_node_t* root = NULL;
+    if (json_doc_parse(json, len, &root) != ARGO_SUCCESS) {
+        return E_INPUT_FORMAT;
+    }
+    provider_usage_read(root, usage);
+    json_doc_free(root);
+    return ARGO_SUCCESS;
+}
+
+/* Snapshot of every provider/model recorded */
+int provider_telemetry_get_stats(provider_telemetry_stats_t* stats, int max) {
+    if (!stats) return 0;
+
+    int count = 0;
+    pthread_mutex_lock(&g_telemetry_lock);
+    for (telemetry_entry_t* entry = g_entries; entry && count < max; entry = entry->next) {
+        stats[count++] = entry->stats;
+    }
+    pthread_mutex_unlock(&g_telemetry_lock);
+    return count;
+}
+
+/* Latency below which pct percent of calls finished */
+long long provider_telemetry_percentile(const provider_telemetry_stats_t* stats, double pct) {
+    if (!stats || stats->calls == 0) return 0;
+
+    /* Nearest rank, 1-based */
+    unsigned long long rank = (unsigned long long)(pct / 100.0 * (double)stats->calls + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > stats->calls) rank = stats->calls;
+
+    unsigned long long seen = 0;
+    for (int i = 0; i < PROVIDER_TELEMETRY_BUCKETS - 1; i++) {
+        seen += stats->histogram[i];
+        if (seen >= rank) {
+            return BUCKET_BOUNDS_MS[i] < stats->max_ms ? BUCKET_BOUNDS_MS[i] : stats->max_ms;
+        }
+    }
+    return stats->max_ms;
+}
+
+/* Histogram bucket upper bounds */
+const long long* provider_telemetry_bucket_bounds(void) {
+    return BUCKET_BOUNDS_MS;
+}
+
+/* Forget everything recorded */
+void provider_telemetry_reset(void) {
+    pthread_mutex_lock(&g_telemetry_lock);
+    telemetry_entry_t* entry = g_entries;
+    while (entry) {
+        telemetry_entry_t* next = entry->next;
+        free(entry);
+        entry = next;
+    }
+    g_entries = NULL;
+    g_entry_count = 0;
+    g_full_logged = false;
+    pthread_mutex_unlock(&g_telemetry_lock);
+}
@@ -0,0 +1,505 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Rate Limit - token buckets, Retry-After and 429 retry per endpoint and key */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* strptime(), timegm() */
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+/* Project includes */
+#include "argo_rate_limit.h"
+#include "argo_config.h"
+#include "argo_env_utils.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_limits.h"
+#include "argo_log.h"
+#include "argo_time.h"
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+#define API_KEY_HEADER_SUFFIX "api-key"      /* x-api-key, x-goog-api-key, api-key */
+#define URL_KEY_PARAM "key="
+#define HTTP_DATE_FORMAT "%a, %d %b %Y %H:%M:%S"
+#define BACKOFF_MAX_SHIFT 6
+#define SECONDS_PER_MINUTE 60
+#define MINUTES_PER_HOUR 60
+
+/* Continuously refilled bucket; per_minute 0 = unlimited */
+typedef struct {
+    double per_minute;
+    double level;               /* Available now; negative = reserved ahead */
+    long long updated_ms;
+} bucket_t;
+
+struct rate_limiter {
+    char key[RATE_LIMIT_KEY_SIZE];      /* host:port#fingerprint */
+    pthread_mutex_t lock;
+    bucket_t requests;
+    bucket_t tokens;
+    double configured_rpm;
+    double configured_tpm;
+    double reported_rpm;                /* From response headers, 0 = unknown */
+    double reported_tpm;
+    long long paused_until_ms;
+    int strikes;                        /* Consecutive 429s */
+    unsigned int seed;                  /* Jitter */
+    rate_limit_stats_t stats;
+    struct rate_limiter* next;
+};
+
+static pthread_mutex_t g_limiters_lock = PTHREAD_MUTEX_INITIALIZER;
+static rate_limiter_t* g_limiters = NULL;
+
+/* Helper: FNV-1a over len bytes, continuing from hash */
+static unsigned long long fnv1a(unsigned long long hash, const char* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+/* Helper: Fingerprint of the request's credential (0 if none) */
+static unsigned long long credential_fingerprint(const http_request_t* req) {
+    unsigned long long hash = FNV_OFFSET_BASIS;
+    bool found = false;
+    size_t suffix_len = strlen(API_KEY_HEADER_SUFFIX);
+
+    for (const http_header_t* h = req->headers; h; h = h->next) {
+        size_t name_len = strlen(h->name);
+        bool key_header = name_len >= suffix_len &&
+                          strcasecmp(h->name + name_len - suffix_len, API_KEY_HEADER_SUFFIX) == 0;
+        if (key_header || strcasecmp(h->name, HTTP_HEADER_AUTHORIZATION) == 0) {
+            hash = fnv1a(hash, h->value, strlen(h->value));
+            found = true;
+        }
+    }
+
+    /* Key in the URL (Gemini): only the key itself, not alt=sse etc. */
+    for (const char* param = strchr(req->url, '?'); param; param = strchr(param, '&')) {
+        param++;
+        if (strncmp(param, URL_KEY_PARAM, strlen(URL_KEY_PARAM)) == 0) {
+            hash = fnv1a(hash, param, strcspn(param, "&#"));
+            found = true;
+        }
+    }
+    return found ? hash : 0;
+}
+
+/* Helper: Non-negative number from config, then environment */
+static double config_number(const char* config_key, const char* env_name, double fallback) {
+    const char* sources[] = { argo_config_get(config_key), argo_getenv(env_name) };
+
+    for (size_t i = 0; i < sizeof(sources) / sizeof(sources[0]); i++) {
+        if (!sources[i] || !*sources[i]) continue;
+        char* end = NULL;
+        double value = strtod(sources[i], &end);
+        if (end != sources[i] && value >= 0) {
+            return value;
+        }
+        LOG_WARN("Ignoring invalid %s: %s", config_key, sources[i]);
+    }
+    return fallback;
+}
+
+/* Helper: Refill bucket up to now */
+static void bucket_refill(bucket_t* bucket, long long now) {
+    if (bucket->per_minute <= 0 || now <= bucket->updated_ms) return;
+
+    bucket->level += (double)(now - bucket->updated_ms) * bucket->per_minute / RATE_LIMIT_WINDOW_MS;
+    if (bucket->level > bucket->per_minute) {
+        bucket->level = bucket->per_minute;
+    }
+    bucket->updated_ms = now;
+}
+
+/* Helper: Milliseconds until amount is available */
+static long long bucket_wait(const bucket_t* bucket, double amount) {
+    if (bucket->per_minute <= 0) return 0;
+
+    /* More than a minute's budget: wait for a full bucket */
+    if (amount > bucket->per_minute) amount = bucket->per_minute;
+    double deficit = amount - bucket->level;
+    if (deficit <= 0) return 0;
+    return (long long)(deficit * RATE_LIMIT_WINDOW_MS / bucket->per_minute) + 1;
+}
+
+/* Helper: Take amount (may go negative: reserved ahead) */
+static void bucket_take(bucket_t* bucket, double amount) {
+    if (bucket->per_minute <= 0) return;
+    if (amount > bucket->per_minute) amount = bucket->per_minute;
+    bucket->level -= amount;
+}
+
+/* Helper: Change rate, keeping what is already reserved */
+static void bucket_set_rate(bucket_t* bucket, double per_minute, long long now) {
+    if (per_minute == bucket->per_minute) return;
+
+    if (bucket->per_minute <= 0) {
+        bucket->level = per_minute;         /* Newly limited: start full */
+    } else if (bucket->level > per_minute) {
+        bucket->level = per_minute;
+    }
+    bucket->per_minute = per_minute;
+    bucket->updated_ms = now;
+}
+
+/* Helper: Tightest known limit (0 = unlimited) */
+static double effective_limit(double configured, double reported) {
+    if (configured <= 0) return reported;
+    if (reported <= 0) return configured;
+    return configured < reported ? configured : reported;
+}
+
+/* Helper: Apply configured and reported limits (locked) */
+static void apply_limits(rate_limiter_t* limiter, long long now) {
+    bucket_refill(&limiter->requests, now);
+    bucket_refill(&limiter->tokens, now);
+    bucket_set_rate(&limiter->requests,
+                    effective_limit(limiter->configured_rpm, limiter->reported_rpm), now);
+    bucket_set_rate(&limiter->tokens,
+                    effective_limit(limiter->configured_tpm, limiter->reported_tpm), now);
+}
+
+/* Limiter for request endpoint and credential */
+rate_limiter_t* rate_limit_for_request(const http_request_t* req) {
+    if (!req || !req->url) return NULL;
+
+    char* host = NULL;
+    char* path = NULL;
+    int port = 0;
+    if (http_parse_url(req->url, &host, &port, &path) != ARGO_SUCCESS) {
+        return NULL;
+    }
+    char key[RATE_LIMIT_KEY_SIZE];
+    snprintf(key, sizeof(key), "%s:%d#%016llx", host, port, credential_fingerprint(req));
+    free(host);
+    free(path);
+
+    pthread_mutex_lock(&g_limiters_lock);
+    rate_limiter_t* limiter = g_limiters;
+    while (limiter && strcmp(limiter->key, key) != 0) {
+        limiter = limiter->next;
+    }
+
+    if (!limiter) {
+        limiter = calloc(1, sizeof(rate_limiter_t));
+        if (!limiter) {
+            pthread_mutex_unlock(&g_limiters_lock);
+            argo_report_error(E_SYSTEM_MEMORY, "rate_limit_for_request", ERR_MSG_MEMORY_ALLOC_FAILED);
+            return NULL;
+        }
+        snprintf(limiter->key, sizeof(limiter->key), "%s", key);
+        pthread_mutex_init(&limiter->lock, NULL);
+        limiter->configured_rpm = config_number(RATE_LIMIT_RPM_CONFIG_KEY, RATE_LIMIT_RPM_ENV, 0);
+        limiter->configured_tpm = config_number(RATE_LIMIT_TPM_CONFIG_KEY, RATE_LIMIT_TPM_ENV, 0);
+        limiter->seed = (unsigned int)fnv1a(FNV_OFFSET_BASIS, key, strlen(key));
+        apply_limits(limiter, argo_monotonic_ms());
+        limiter->next = g_limiters;
+        g_limiters = limiter;
+        LOG_DEBUG("Rate limiter %s: rpm=%.0f tpm=%.0f", key,
+                  limiter->configured_rpm, limiter->configured_tpm);
+    }
+    pthread_mutex_unlock(&g_limiters_lock);
+    return limiter;
+}
+
+/* Prompt token estimate */
+int rate_limit_estimate_tokens(size_t body_len) {
+    return (int)(body_len / RATE_LIMIT_BYTES_PER_TOKEN) + 1;
+}
+
+/* Reserve a slot */
+int rate_limit_reserve(rate_limiter_t* limiter, int tokens, long long deadline_ms,
+                       long long* start_ms) {
+    ARGO_CHECK_NULL(limiter);
+    ARGO_CHECK_NULL(start_ms);
+
+    long long now = argo_monotonic_ms();
+    pthread_mutex_lock(&limiter->lock);
+    bucket_refill(&limiter->requests, now);
+    bucket_refill(&limiter->tokens, now);
+
+    long long start = now;
+    if (limiter->paused_until_ms > start) {
+        start = limiter->paused_until_ms;
+    }
+    long long wait = bucket_wait(&limiter->requests, 1);
+    if (now + wait > start) start = now + wait;
+    wait = bucket_wait(&limiter->tokens, tokens);
+    if (now + wait > start) start = now + wait;
+
+    if (start > deadline_ms) {
+        limiter->stats.rejected++;
+        pthread_mutex_unlock(&limiter->lock);
+        return E_HTTP_RATE_LIMIT;
+    }
+
+    bucket_take(&limiter->requests, 1);
+    bucket_take(&limiter->tokens, tokens);
+    limiter->stats.granted++;
+    if (start > now) {
+        limiter->stats.delayed++;
+    }
+    pthread_mutex_unlock(&limiter->lock);
+
+    *start_ms = start;
+    return ARGO_SUCCESS;
+}
+
+/* Reserve and wait for the slot */
+int rate_limit_acquire(rate_limiter_t* limiter, int tokens, long long deadline_ms) {
+    long long start = 0;
+    int result = rate_limit_reserve(limiter, tokens, deadline_ms, &start);
+    if (result != ARGO_SUCCESS) return result;
+
+    long long wait;
+    while ((wait = start - argo_monotonic_ms()) > 0) {
+        struct timespec ts = {
+            .tv_sec = wait / MILLISECONDS_PER_SECOND,
+            .tv_nsec = (wait % MILLISECONDS_PER_SECOND) * NANOSECONDS_PER_MILLISECOND
+        };
+        nanosleep(&ts, NULL);
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Numeric header value */
+static bool header_number(const http_response_t* resp, const char* name, double* value) {
+    const char* text = http_response_get_header(resp, name);
+    if (!text) return false;
+
+    char* end = NULL;
+    double parsed = strtod(text, &end);
+    if (end == text || parsed < 0) return false;
+    *value = parsed;
+    return true;
+}
+
+/* Helper: "1s", "6m0s", "250ms", "1.5" (seconds) to milliseconds, -1 if invalid */
+static long long parse_duration_ms(const char* text) {
+    if (!text) return -1;
+
+    double total = 0;
+    bool any = false;
+    const char* p = text;
+    while (*p) {
+        char* end = NULL;
+        double value = strtod(p, &end);
+        if (end == p || value < 0) return -1;
+        p = end;
+
+        if (strncmp(p, "ms", 2) == 0) {
+            p += 2;
+        } else if (*p == 's' || *p == '\0') {
+            value *= MILLISECONDS_PER_SECOND;
+            if (*p) p++;
+        } else if (*p == 'm') {
+            value *= (double)SECONDS_PER_MINUTE * MILLISECONDS_PER_SECOND;
+            p++;
+        } else if (*p == 'h') {
+            value *= (double)MINUTES_PER_HOUR * SECONDS_PER_MINUTE * MILLISECONDS_PER_SECOND;
+            p++;
+        } else {
+            return -1;
+        }
+        total += value;
+        any = true;
+    }
+    return any ? (long long)total : -1;
+}
+
+/* Helper: Retry-After in milliseconds (delta seconds or HTTP-date), -1 if absent */
+static long long retry_after_ms(const http_response_t* resp) {
+    double value = 0;
+    if (header_number(resp, RATE_LIMIT_HEADER_RETRY_AFTER_MS, &value)) {
+        return (long long)value;
+    }
+
+    const char* text = http_response_get_header(resp, RATE_LIMIT_HEADER_RETRY_AFTER);
+    if (!text) return -1;
+    if (isdigit((unsigned char)*text)) {
+        return (long long)(strtod(text, NULL) * MILLISECONDS_PER_SECOND);
+    }
+
+    struct tm tm = {0};
+    if (!strptime(text, HTTP_DATE_FORMAT, &tm)) return -1;
+    long long seconds = (long long)(timegm(&tm) - time(NULL));
+    return seconds > 0 ? seconds * MILLISECONDS_PER_SECOND : 0;
+}
+
+/* Helper: Pause new slots until at least until_ms (locked) */
+static void pause_until(rate_limiter_t* limiter, long long until_ms) {
+    if (until_ms > limiter->paused_until_ms) {
+        limiter->paused_until_ms = until_ms;
+    }
+}
+
+/* Helper: Server's view of one bucket (locked) */
+static void observe_bucket(rate_limiter_t* limiter, const http_response_t* resp, bucket_t* bucket,
+                           const char* remaining_header, const char* anthropic_remaining_header,
+                           const char* reset_header, long long now) {
+    double remaining = 0;
+    if (!header_number(resp, remaining_header, &remaining) &&
+        !header_number(resp, anthropic_remaining_header, &remaining)) {
+        return;
+    }
+
+    /* Other clients share the key: never assume more than the server has */
+    if (bucket->per_minute > 0 && bucket->level > remaining) {
+        bucket->level = remaining;
+    }
+    if (remaining < 1) {
+        long long reset = parse_duration_ms(http_response_get_header(resp, reset_header));
+        if (reset > 0) {
+            pause_until(limiter, now + reset);
+        }
+    }
+}
+
+/* Learn from response */
+bool rate_limit_observe(rate_limiter_t* limiter, const http_response_t* resp) {
+    if (!limiter || !resp) return false;
+
+    long long now = argo_monotonic_ms();
+    double value = 0;
+    pthread_mutex_lock(&limiter->lock);
+
+    if (header_number(resp, RATE_LIMIT_HEADER_LIMIT_REQUESTS, &value) ||
+        header_number(resp, RATE_LIMIT_HEADER_ANTHROPIC_LIMIT_REQUESTS, &value)) {
+        limiter->reported_rpm = value;
+    }
+    if (header_number(resp, RATE_LIMIT_HEADER_LIMIT_TOKENS, &value) ||
+        header_number(resp, RATE_LIMIT_HEADER_ANTHROPIC_LIMIT_TOKENS, &value)) {
+        limiter->reported_tpm = value;
+    }
+    apply_limits(limiter, now);
+
+    observe_bucket(limiter, resp, &limiter->requests, RATE_LIMIT_HEADER_REMAINING_REQUESTS,
+                   RATE_LIMIT_HEADER_ANTHROPIC_REMAINING_REQUESTS, RATE_LIMIT_HEADER_RESET_REQUESTS, now);
+    observe_bucket(limiter, resp, &limiter->tokens, RATE_LIMIT_HEADER_REMAINING_TOKENS,
+                   RATE_LIMIT_HEADER_ANTHROPIC_REMAINING_TOKENS, RATE_LIMIT_HEADER_RESET_TOKENS, now);
+
+    bool throttled = (resp->status_code == HTTP_STATUS_RATE_LIMIT);
+    if (throttled) {
+        long long delay = retry_after_ms(resp);
+        if (delay >= 0) {
+            /* Everyone got the same Retry-After: spread the retries */
+            delay += rand_r(&limiter->seed) % (RATE_LIMIT_JITTER_MS + 1);
+        } else {
+            int shift = limiter->strikes < BACKOFF_MAX_SHIFT ? limiter->strikes : BACKOFF_MAX_SHIFT;
+            long long backoff = (long long)RATE_LIMIT_BACKOFF_BASE_MS << shift;
+            if (backoff > RATE_LIMIT_BACKOFF_MAX_MS) backoff = RATE_LIMIT_BACKOFF_MAX_MS;
+            delay = backoff / 2 + rand_r(&limiter->seed) % (backoff / 2 + 1);
+        }
+        limiter->strikes++;
+        limiter->stats.throttled++;
+        pause_until(limiter, now + delay);
+        LOG_WARN("Rate limited by %s, pausing %lld ms", limiter->key, delay);
+    } else if (resp->status_code >= HTTP_STATUS_OK && resp->status_code < HTTP_STATUS_SUCCESS_END) {
+        limiter->strikes = 0;
+    }
+
+    pthread_mutex_unlock(&limiter->lock);
+    return throttled;
+}
+
+/* Override configured limits */
+void rate_limit_set_limits(rate_limiter_t* limiter, double requests_per_minute,
+                           double tokens_per_minute) {
+    if (!limiter) return;
+
+    pthread_mutex_lock(&limiter->lock);
+    limiter->configured_rpm = requests_per_minute > 0 ? requests_per_minute : 0;
+    limiter->configured_tpm = tokens_per_minute > 0 ? tokens_per_minute : 0;
+    apply_limits(limiter, argo_monotonic_ms());
+    pthread_mutex_unlock(&limiter->lock);
+}
+
+/* Snapshot of counters */
+void rate_limit_get_stats(rate_limiter_t* limiter, rate_limit_stats_t* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!limiter) return;
+
+    pthread_mutex_lock(&limiter->lock);
+    *stats = limiter->stats;
+    stats->requests_per_minute = limiter->requests.per_minute;
+    stats->tokens_per_minute = limiter->tokens.per_minute;
+    stats->paused_until_ms = limiter->paused_until_ms > argo_monotonic_ms() ? limiter->paused_until_ms : 0;
+    pthread_mutex_unlock(&limiter->lock);
+}
+
+/* Deadline for blocking callers */
+long long rate_limit_default_deadline(void) {
+    double max_wait = config_number(RATE_LIMIT_MAX_WAIT_CONFIG_KEY, RATE_LIMIT_MAX_WAIT_ENV,
+                                    RATE_LIMIT_DEFAULT_MAX_WAIT_MS);
+    return argo_monotonic_ms() + (long long)max_wait;
+}
+
+/* Execute under the request's limiter */
+int rate_limit_execute(const http_request_t* req, long long deadline_ms,
+                       void (*on_chunk)(const char* chunk, size_t len, void* userdata),
+                       void* userdata, http_response_t** resp) {
+    ARGO_CHECK_NULL(req);
+    ARGO_CHECK_NULL(resp);
+    *resp = NULL;
+
+    rate_limiter_t* limiter = rate_limit_for_request(req);
+    int tokens = rate_limit_estimate_tokens(req->body_len);
+    http_response_t* last = NULL;
+    int result = ARGO_SUCCESS;
+
+    for (int attempt = 0; ; attempt++) {
+        if (limiter) {
+            result = rate_limit_acquire(limiter, tokens, deadline_ms);
+            if (result != ARGO_SUCCESS) {
+                if (last) {
+                    result = ARGO_SUCCESS;      /* Out of time: caller sees the 429 */
+                } else {
+                    argo_report_error(result, "rate_limit_execute",
+                                      "no request slot before deadline");
+                }
+                break;
+            }
+        }
+
+        http_response_free(last);
+        last = NULL;
+        result = on_chunk ? http_execute_streaming(req, on_chunk, userdata, &last)
+                          : http_execute(req, &last);
+        if (result != ARGO_SUCCESS || !rate_limit_observe(limiter, last) ||
+            attempt >= RATE_LIMIT_MAX_RETRIES) {
+            break;
+        }
+        LOG_DEBUG("Retrying after 429 (attempt %d)", attempt + 1);
+    }
+
+    *resp = last;
+    return result;
+}
+
+/* Free all limiters */
+void rate_limit_cleanup(void) {
+    pthread_mutex_lock(&g_limiters_lock);
+    rate_limiter_t* limiter = g_limiters;
+    g_limiters = NULL;
+    pthread_mutex_unlock(&g_limiters_lock);
+
+    while (limiter) {
+        rate_limiter_t* next = limiter->next;
+        pthread_mutex_destroy(&limiter->lock);
+        free(limiter);
+        limiter = next;
+    }
+}
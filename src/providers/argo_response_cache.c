@@ -0,0 +1,492 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Response cache - content-addressed CI responses, LRU memory tier over a disk tier */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* mkstemp(), fchmod(), strdup() */
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+/* Project includes */
+#include "argo_response_cache.h"
+#include "argo_json_doc.h"
+#include "argo_file_utils.h"
+#include "argo_filesystem.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_limits.h"
+#include "argo_log.h"
+
+/* One cached response (key fields stored "" when absent) */
+typedef struct cache_entry {
+    uint64_t hash;
+    char* provider;
+    char* model;
+    char* params;
+    char* prompt;
+    char* response;
+    time_t stored;
+    struct cache_entry* chain;      /* Bucket chain */
+    struct cache_entry* prev;       /* LRU list, most recent first */
+    struct cache_entry* next;
+} cache_entry_t;
+
+struct response_cache {
+    pthread_mutex_t lock;           /* Guards the memory tier and counters */
+    char dir[ARGO_PATH_MAX];
+    int max_entries;
+    int ttl_seconds;
+    cache_entry_t* buckets[RESPONSE_CACHE_BUCKETS];
+    cache_entry_t* head;
+    cache_entry_t* tail;
+    int count;
+    response_cache_stats_t stats;
+};
+
+/* Helper: Absent key field as "" */
+static const char* field(const char* value) {
+    return value ? value : "";
+}
+
+/* Helper: FNV-1a 64 over all key fields, NUL-separated */
+static uint64_t hash_key(const response_cache_key_t* key) {
+    const char* fields[] = {field(key->provider), field(key->model), field(key->params), field(key->prompt)};
+    uint64_t hash = RESPONSE_CACHE_HASH_SEED;
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        for (const unsigned char* p = (const unsigned char*)fields[i]; ; p++) {
+            hash ^= *p;
+            hash *= RESPONSE_CACHE_HASH_PRIME;
+            if (*p == '\0') break;
+        }
+    }
+    return hash;
+}
+
+/* Helper: Entry holds exactly this key */
+static bool key_matches(const cache_entry_t* entry, const response_cache_key_t* key) {
+    return strcmp(entry->provider, field(key->provider)) == 0 &&
+           strcmp(entry->model, field(key->model)) == 0 &&
+           strcmp(entry->params, field(key->params)) == 0 &&
+           strcmp(entry->prompt, field(key->prompt)) == 0;
+}
+
+/* Helper: Disk tier file for a hash; false if the path does not fit */
+static bool entry_path(const response_cache_t* cache, uint64_t hash, char* path, size_t size) {
+    int written = snprintf(path, size, "%s/%016llx%s", cache->dir, (unsigned long long)hash,
+                           RESPONSE_CACHE_FILE_SUFFIX);
+    return written >= 0 && (size_t)written < size;
+}
+
+/* Helper: Free entry and its strings */
+static void entry_free(cache_entry_t* entry) {
+    if (!entry) return;
+    free(entry->provider);
+    free(entry->model);
+    free(entry->params);
+    free(entry->prompt);
+    free(entry->response);
+    free(entry);
+}
+
+/* Helper: New unlinked entry */
+static cache_entry_t* entry_new(uint64_t hash, const response_cache_key_t* key,
+                                const char* response, time_t stored) {
+    cache_entry_t* entry = calloc(1, sizeof(cache_entry_t));
+    if (!entry) return NULL;
+
+    entry->hash = hash;
+    entry->stored = stored;
+    entry->provider = strdup(field(key->provider));
+    entry->model = strdup(field(key->model));
+    entry->params = strdup(field(key->params));
+    entry->prompt = strdup(field(key->prompt));
+    entry->response = strdup(response);
+    if (!entry->provider || !entry->model || !entry->params || !entry->prompt || !entry->response) {
+        entry_free(entry);
+        return NULL;
+    }
+    return entry;
+}
+
+/* Helper: Remove entry from bucket and LRU list (caller holds lock) */
+static void entry_unlink(response_cache_t* cache, cache_entry_t* entry) {
+    cache_entry_t** link = &cache->buckets[entry->hash & (RESPONSE_CACHE_BUCKETS - 1)];
+    while (*link && *link != entry) link = &(*link)->chain;
+    if (*link) *link = entry->chain;
+
+    if (entry->prev) entry->prev->next = entry->next;
+    else cache->head = entry->next;
+    if (entry->next) entry->next->prev = entry->prev;
+    else cache->tail = entry->prev;
+
+    entry->prev = entry->next = entry->chain = NULL;
+    cache->count--;
+}
+
+/* Helper: Put entry at LRU head (caller holds lock) */
+static void lru_push_front(response_cache_t* cache, cache_entry_t* entry) {
+    entry->prev = NULL;
+    entry->next = cache->head;
+    if (cache->head) cache->head->prev = entry;
+    cache->head = entry;
+    if (!cache->tail) cache->tail = entry;
+}
+
+/* Helper: Move entry to LRU head (caller holds lock) */
+static void lru_touch(response_cache_t* cache, cache_entry_t* entry) {
+    if (cache->head == entry) return;
+    entry->prev->next = entry->next;
+    if (entry->next) entry->next->prev = entry->prev;
+    else cache->tail = entry->prev;
+    lru_push_front(cache, entry);
+}
+
+/* Helper: Find entry by key (caller holds lock) */
+static cache_entry_t* find_entry(response_cache_t* cache, uint64_t hash, const response_cache_key_t* key) {
+    cache_entry_t* entry = cache->buckets[hash & (RESPONSE_CACHE_BUCKETS - 1)];
+    while (entry && !(entry->hash == hash && key_matches(entry, key))) {
+        entry = entry->chain;
+    }
+    return entry;
+}
+
+/* Helper: Insert entry, replacing any with the same key and trimming to
+ * max_entries. Returns the displaced entries as a list to free unlocked.
+ * (caller holds lock) */
+static cache_entry_t* insert_entry(response_cache_t* cache, cache_entry_t* entry,
+                                   const response_cache_key_t* key) {
+    cache_entry_t* displaced = NULL;
+    cache_entry_t* old = find_entry(cache, entry->hash, key);
+    if (old) {
+        entry_unlink(cache, old);
+        old->next = displaced;
+        displaced = old;
+    }
+
+    size_t slot = entry->hash & (RESPONSE_CACHE_BUCKETS - 1);
+    entry->chain = cache->buckets[slot];
+    cache->buckets[slot] = entry;
+    lru_push_front(cache, entry);
+    cache->count++;
+
+    while (cache->count > cache->max_entries && cache->tail) {
+        cache_entry_t* victim = cache->tail;
+        entry_unlink(cache, victim);
+        victim->next = displaced;
+        displaced = victim;
+        cache->stats.evictions++;
+    }
+    return displaced;
+}
+
+/* Helper: Free a displaced list */
+static void free_list(cache_entry_t* list) {
+    while (list) {
+        cache_entry_t* next = list->next;
+        entry_free(list);
+        list = next;
+    }
+}
+
+/* Helper: Read a disk tier entry; NULL on miss, mismatch or expiry */
+static char* disk_read(response_cache_t* cache, uint64_t hash, const response_cache_key_t* key,
+                       time_t now, time_t* stored) {
+    char path[ARGO_PATH_MAX];
+    if (!entry_path(cache, hash, path, sizeof(path))) return NULL;  /* Never stored: a miss */
+
+    struct stat st;
+    if (stat(path, &st) != 0) return NULL;
+    if (now - st.st_mtime >= cache->ttl_seconds) {
+        unlink(path);
+        return NULL;
+    }
+
+    char* text = NULL;
+    size_t len = 0;
+    json_node_t* doc = NULL;
+    char* response = NULL;
+    if (file_read_all(path, &text, &len) != ARGO_SUCCESS ||
+        json_doc_parse(text, len, &doc) != ARGO_SUCCESS) {
+        goto cleanup;
+    }
+
+    const char* pointers[] = {"/provider", "/model", "/params", "/prompt"};
+    const char* expected[] = {field(key->provider), field(key->model), field(key->params), field(key->prompt)};
+    for (size_t i = 0; i < sizeof(pointers) / sizeof(pointers[0]); i++) {
+        json_node_t* node = json_doc_get(doc, pointers[i]);
+        if (!node || node->type != JSON_DOC_STRING || strcmp(node->text, expected[i]) != 0) {
+            goto cleanup;  /* Hash collision */
+        }
+    }
+
+    json_node_t* node = json_doc_get(doc, "/response");
+    if (node && node->type == JSON_DOC_STRING) {
+        response = strdup(node->text);
+        *stored = st.st_mtime;
+    }
+
+cleanup:
+    json_doc_free(doc);
+    free(text);
+    return response;
+}
+
+/* Helper: Write a disk tier entry via temp file + rename */
+static int disk_write(response_cache_t* cache, uint64_t hash, const response_cache_key_t* key,
+                      const char* response) {
+    char path[ARGO_PATH_MAX];
+    char temp[ARGO_PATH_MAX];
+    int needed = entry_path(cache, hash, path, sizeof(path))
+                     ? snprintf(temp, sizeof(temp), "%s%s", path, RESPONSE_CACHE_TEMP_SUFFIX)
+                     : -1;
+    if (needed < 0 || (size_t)needed >= sizeof(temp)) {
+        argo_report_error(E_INPUT_TOO_LARGE, "response_cache_store", ERR_FMT_FAILED_TO_OPEN, cache->dir);
+        return E_INPUT_TOO_LARGE;
+    }
+
+    json_node_t* doc = json_doc_new_object();
+    if (!doc) return E_SYSTEM_MEMORY;
+    json_doc_append(doc, "provider", json_doc_new_string(field(key->provider)));
+    json_doc_append(doc, "model", json_doc_new_string(field(key->model)));
+    json_doc_append(doc, "params", json_doc_new_string(field(key->params)));
+    json_doc_append(doc, "prompt", json_doc_new_string(field(key->prompt)));
+    json_doc_append(doc, "response", json_doc_new_string(response));
+    char* text = json_doc_serialize(doc);
+    json_doc_free(doc);
+    if (!text) return E_SYSTEM_MEMORY;
+
+    int result = ARGO_SUCCESS;
+    int fd = mkstemp(temp);
+    if (fd < 0) {
+        argo_report_error(E_SYSTEM_FILE, "response_cache_store", ERR_FMT_SYSCALL_ERROR, temp, strerror(errno));
+        free(text);
+        return E_SYSTEM_FILE;
+    }
+    fchmod(fd, ARGO_FILE_MODE_PRIVATE);  /* Prompts may be sensitive */
+
+    size_t len = strlen(text);
+    size_t written = 0;
+    while (written < len) {
+        ssize_t n = write(fd, text + written, len - written);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        written += (size_t)n;
+    }
+    bool ok = (written == len);
+    ok = (close(fd) == 0) && ok;
+
+    if (!ok || rename(temp, path) != 0) {
+        argo_report_error(E_SYSTEM_FILE, "response_cache_store", ERR_FMT_SYSCALL_ERROR, path, strerror(errno));
+        unlink(temp);
+        result = E_SYSTEM_FILE;
+    }
+    free(text);
+    return result;
+}
+
+/* Create cache */
+response_cache_t* response_cache_create(const char* dir, int max_entries, int ttl_seconds) {
+    response_cache_t* cache = calloc(1, sizeof(response_cache_t));
+    if (!cache) {
+        argo_report_error(E_SYSTEM_MEMORY, "response_cache_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return NULL;
+    }
+
+    if (dir) {
+        snprintf(cache->dir, sizeof(cache->dir), "%s", dir);
+    } else {
+        const char* home = getenv("HOME");
+        char argo_dir[ARGO_PATH_MAX];
+        snprintf(argo_dir, sizeof(argo_dir), "%s/.argo", home ? home : ".");
+        mkdir(argo_dir, ARGO_DIR_PERMISSIONS);  /* Ignore EEXIST */
+        snprintf(cache->dir, sizeof(cache->dir), "%s/%s", home ? home : ".", RESPONSE_CACHE_DIR);
+    }
+    mkdir(cache->dir, ARGO_DIR_MODE_PRIVATE);  /* Ignore EEXIST */
+
+    cache->max_entries = max_entries > 0 ? max_entries : RESPONSE_CACHE_DEFAULT_MAX_ENTRIES;
+    cache->ttl_seconds = ttl_seconds > 0 ? ttl_seconds : RESPONSE_CACHE_DEFAULT_TTL_SECONDS;
+    pthread_mutex_init(&cache->lock, NULL);
+    return cache;
+}
+
+/* Parse cache mode */
+int response_cache_parse_mode(const char* text, response_cache_mode_t* mode) {
+    ARGO_CHECK_NULL(text);
+    ARGO_CHECK_NULL(mode);
+
+    if (strcmp(text, "bypass") == 0) {
+        *mode = RESPONSE_CACHE_BYPASS;
+    } else if (strcmp(text, "prefer") == 0) {
+        *mode = RESPONSE_CACHE_PREFER;
+    } else if (strcmp(text, "only") == 0) {
+        *mode = RESPONSE_CACHE_ONLY;
+    } else {
+        return E_INVALID_PARAMS;
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Look up response */
+int response_cache_lookup(response_cache_t* cache, const response_cache_key_t* key, char** response) {
+    ARGO_CHECK_NULL(cache);
+    ARGO_CHECK_NULL(key);
+    ARGO_CHECK_NULL(response);
+
+    uint64_t hash = hash_key(key);
+    time_t now = time(NULL);
+    cache_entry_t* expired = NULL;
+
+    /* Memory tier */
+    pthread_mutex_lock(&cache->lock);
+    cache_entry_t* entry = find_entry(cache, hash, key);
+    if (entry && now - entry->stored >= cache->ttl_seconds) {
+        entry_unlink(cache, entry);
+        cache->stats.evictions++;
+        expired = entry;
+        entry = NULL;
+    }
+    if (entry) {
+        *response = strdup(entry->response);
+        if (*response) {
+            lru_touch(cache, entry);
+            cache->stats.memory_hits++;
+        }
+    }
+    pthread_mutex_unlock(&cache->lock);
+    entry_free(expired);
+    if (entry && *response) {
+        return ARGO_SUCCESS;
+    }
+
+    /* Disk tier (read unlocked) */
+    time_t stored = 0;
+    char* text = disk_read(cache, hash, key, now, &stored);
+    cache_entry_t* promoted = text ? entry_new(hash, key, text, stored) : NULL;
+
+    pthread_mutex_lock(&cache->lock);
+    cache_entry_t* displaced = NULL;
+    if (text) {
+        cache->stats.disk_hits++;
+        if (promoted) {
+            displaced = insert_entry(cache, promoted, key);
+        }
+    } else {
+        cache->stats.misses++;
+    }
+    pthread_mutex_unlock(&cache->lock);
+    free_list(displaced);
+
+    if (!text) {
+        return E_NOT_FOUND;
+    }
+    *response = text;
+    return ARGO_SUCCESS;
+}
+
+/* Store response */
+int response_cache_store(response_cache_t* cache, const response_cache_key_t* key, const char* response) {
+    ARGO_CHECK_NULL(cache);
+    ARGO_CHECK_NULL(key);
+    ARGO_CHECK_NULL(response);
+
+    uint64_t hash = hash_key(key);
+    cache_entry_t* entry = entry_new(hash, key, response, time(NULL));
+    if (!entry) {
+        return E_SYSTEM_MEMORY;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+    cache_entry_t* displaced = insert_entry(cache, entry, key);
+    cache->stats.stores++;
+    pthread_mutex_unlock(&cache->lock);
+    free_list(displaced);
+
+    return disk_write(cache, hash, key, response);
+}
+
+/* Remove expired entries */
+int response_cache_purge_expired(response_cache_t* cache) {
+    if (!cache) return 0;
+
+    time_t now = time(NULL);
+    cache_entry_t* expired = NULL;
+
+    pthread_mutex_lock(&cache->lock);
+    cache_entry_t* entry = cache->tail;
+    while (entry) {
+        cache_entry_t* prev = entry->prev;
+        if (now - entry->stored >= cache->ttl_seconds) {
+            entry_unlink(cache, entry);
+            entry->next = expired;
+            expired = entry;
+            cache->stats.evictions++;
+        }
+        entry = prev;
+    }
+    pthread_mutex_unlock(&cache->lock);
+    free_list(expired);
+
+    DIR* dir = opendir(cache->dir);
+    if (!dir) return 0;
+
+    int removed = 0;
+    size_t suffix_len = strlen(RESPONSE_CACHE_FILE_SUFFIX);
+    struct dirent* item;
+    while ((item = readdir(dir)) != NULL) {
+        size_t len = strlen(item->d_name);
+        if (len <= suffix_len || strcmp(item->d_name + len - suffix_len, RESPONSE_CACHE_FILE_SUFFIX) != 0) {
+            continue;
+        }
+
+        char path[ARGO_PATH_MAX];
+        int needed = snprintf(path, sizeof(path), "%s/%s", cache->dir, item->d_name);
+        if (needed < 0 || (size_t)needed >= sizeof(path)) continue;
+        struct stat st;
+        if (stat(path, &st) == 0 && now - st.st_mtime >= cache->ttl_seconds && unlink(path) == 0) {
+            removed++;
+        }
+    }
+    closedir(dir);
+
+    if (removed > 0) {
+        LOG_DEBUG("Response cache purged %d expired entries", removed);
+    }
+    return removed;
+}
+
+/* Snapshot of cache counters */
+void response_cache_get_stats(response_cache_t* cache, response_cache_stats_t* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!cache) return;
+
+    pthread_mutex_lock(&cache->lock);
+    *stats = cache->stats;
+    stats->entries = cache->count;
+    pthread_mutex_unlock(&cache->lock);
+}
+
+/* Destroy cache */
+void response_cache_destroy(response_cache_t* cache) {
+    if (!cache) return;
+
+    cache_entry_t* entry = cache->head;
+    while (entry) {
+        cache_entry_t* next = entry->next;
+        entry_free(entry);
+        entry = next;
+    }
+
+    pthread_mutex_destroy(&cache->lock);
+    free(cache);
+}
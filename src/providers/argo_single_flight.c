@@ -0,0 +1,187 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Single flight - identical in-flight CI queries share one future */
+
+/* System includes */
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/* Project includes */
+#include "argo_single_flight.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_log.h"
+
+/* One running query and its participants */
+struct single_flight_call {
+    char* key;
+    ci_future_t* future;        /* NULL while starting or if start failed */
+    int start_result;
+    bool starting;              /* First caller is inside start() */
+    bool in_table;              /* Joinable by key */
+    int refs;                   /* Participants not yet left */
+    struct single_flight_call* next;
+};
+
+struct single_flight {
+    pthread_mutex_t lock;
+    pthread_cond_t started;     /* A call left the starting state */
+    single_flight_call_t* calls;
+    single_flight_stats_t stats;
+};
+
+/* Helper: Drop call from the key table (caller holds lock) */
+static void unlist(single_flight_t* group, single_flight_call_t* call) {
+    if (!call->in_table) return;
+    single_flight_call_t** link = &group->calls;
+    while (*link && *link != call) link = &(*link)->next;
+    if (*link) *link = call->next;
+    call->in_table = false;
+    group->stats.in_flight--;
+}
+
+/* Helper: Running call for key; finished calls are unlisted (caller holds lock) */
+static single_flight_call_t* find_running(single_flight_t* group, const char* key) {
+    single_flight_call_t* call = group->calls;
+    while (call) {
+        single_flight_call_t* next = call->next;
+        if (strcmp(call->key, key) == 0) {
+            if (call->starting || (call->future && !ci_future_done(call->future))) {
+                return call;
+            }
+            unlist(group, call);
+        }
+        call = next;
+    }
+    return NULL;
+}
+
+/* Create group */
+single_flight_t* single_flight_create(void) {
+    single_flight_t* group = calloc(1, sizeof(single_flight_t));
+    if (!group) {
+        argo_report_error(E_SYSTEM_MEMORY, "single_flight_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return NULL;
+    }
+    pthread_mutex_init(&group->lock, NULL);
+    pthread_cond_init(&group->started, NULL);
+    return group;
+}
+
+/* Run or join the query for key */
+int single_flight_do(single_flight_t* group, const char* key,
+                     single_flight_start_fn start, void* context,
+                     single_flight_call_t** call, bool* shared) {
+    ARGO_CHECK_NULL(group);
+    ARGO_CHECK_NULL(key);
+    ARGO_CHECK_NULL(start);
+    ARGO_CHECK_NULL(call);
+
+    pthread_mutex_lock(&group->lock);
+    single_flight_call_t* running = find_running(group, key);
+    if (running) {
+        running->refs++;
+        group->stats.joined++;
+        while (running->starting) {
+            pthread_cond_wait(&group->started, &group->lock);
+        }
+        int result = running->start_result;
+        pthread_mutex_unlock(&group->lock);
+
+        if (shared) *shared = true;
+        if (result != ARGO_SUCCESS) {
+            single_flight_leave(group, running);
+            return result;
+        }
+        LOG_DEBUG("Joined in-flight query (%zu byte key)", strlen(key));
+        *call = running;
+        return ARGO_SUCCESS;
+    }
+
+    single_flight_call_t* leader = calloc(1, sizeof(single_flight_call_t));
+    char* key_copy = leader ? strdup(key) : NULL;
+    if (!key_copy) {
+        pthread_mutex_unlock(&group->lock);
+        free(leader);
+        return E_SYSTEM_MEMORY;
+    }
+    leader->key = key_copy;
+    leader->starting = true;
+    leader->in_table = true;
+    leader->refs = 1;
+    leader->next = group->calls;
+    group->calls = leader;
+    group->stats.in_flight++;
+    group->stats.started++;
+    pthread_mutex_unlock(&group->lock);
+
+    /* Start unlocked: provider checkout may connect */
+    ci_future_t* future = NULL;
+    int result = start(context, &future);
+
+    pthread_mutex_lock(&group->lock);
+    leader->starting = false;
+    leader->start_result = result;
+    leader->future = (result == ARGO_SUCCESS) ? future : NULL;
+    if (result != ARGO_SUCCESS) {
+        unlist(group, leader);
+    }
+    pthread_cond_broadcast(&group->started);
+    pthread_mutex_unlock(&group->lock);
+
+    if (shared) *shared = false;
+    if (result != ARGO_SUCCESS) {
+        single_flight_leave(group, leader);
+        return result;
+    }
+    *call = leader;
+    return ARGO_SUCCESS;
+}
+
+/* Shared future */
+ci_future_t* single_flight_future(single_flight_call_t* call) {
+    return call ? call->future : NULL;
+}
+
+/* Stop participating */
+void single_flight_leave(single_flight_t* group, single_flight_call_t* call) {
+    if (!group || !call) return;
+
+    pthread_mutex_lock(&group->lock);
+    bool last = (--call->refs == 0);
+    if (last) {
+        unlist(group, call);
+    }
+    pthread_mutex_unlock(&group->lock);
+
+    if (!last) return;
+    if (call->future) {
+        ci_future_cancel(call->future);  /* E_INVALID_STATE if already done */
+        ci_future_release(call->future);
+    }
+    free(call->key);
+    free(call);
+}
+
+/* Snapshot of counters */
+void single_flight_get_stats(single_flight_t* group, single_flight_stats_t* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!group) return;
+
+    pthread_mutex_lock(&group->lock);
+    *stats = group->stats;
+    pthread_mutex_unlock(&group->lock);
+}
+
+/* Destroy group */
+void single_flight_destroy(single_flight_t* group) {
+    if (!group) return;
+
+    if (group->calls) {
+        LOG_WARN("Single flight destroyed with queries still in flight");
+    }
+    pthread_cond_destroy(&group->started);
+    pthread_mutex_destroy(&group->lock);
+    free(group);
+}
@@ -0,0 +1,122 @@
+/* © 2025 Casey Koons All rights reserved */
+/* argo-dag-run - Run (or order) the tasks of a tasks.json file as a DAG */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+
+/* Project includes */
+#include "argo_task_graph.h"
+#include "argo_error.h"
+#include "argo_log.h"
+
+/* Exit codes */
+#define DAG_RUN_EXIT_OK 0
+#define DAG_RUN_EXIT_FAILED 1       /* A task failed or was skipped */
+#define DAG_RUN_EXIT_INVALID 2      /* Usage error, unreadable file or invalid graph */
+
+/* Set by SIGTERM/SIGINT - the runner stops running tasks and returns */
+static volatile sig_atomic_t g_cancel = 0;
+
+/* Helper: Cancel handler */
+static void cancel_handler(int sig) {
+    (void)sig;
+    g_cancel = 1;
+}
+
+/* Helper: Print usage */
+static void print_usage(const char* prog) {
+    fprintf(stderr, "Usage:\n");
+    fprintf(stderr, "  %s [options] <tasks.json>\n", prog);
+    fprintf(stderr, "  %s --order <tasks.json>\n", prog);
+    fprintf(stderr, "\nOptions:\n");
+    fprintf(stderr, "  --max-parallel N   Concurrent tasks (default %d)\n", TASK_GRAPH_DEFAULT_PARALLEL);
+    fprintf(stderr, "  --runner PATH      Script run with the task id for tasks without \"script\"\n");
+    fprintf(stderr, "  --log-dir DIR      Per-task logs <DIR>/<prefix><id>.log\n");
+    fprintf(stderr, "  --log-prefix P     Log file name prefix\n");
+    fprintf(stderr, "  --status PATH      Per-node state JSON, rewritten on every transition\n");
+    fprintf(stderr, "  --order            Validate and print task ids in dependency order\n");
+    fprintf(stderr, "\nExit: 0 all completed, 1 a task failed, 2 invalid graph or usage\n");
+}
+
+/* Helper: Install the cancel handler (the runner delivers it inside its wait) */
+static void install_cancel_handler(void) {
+    struct sigaction sa = {0};
+    sa.sa_handler = cancel_handler;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = 0;
+    sigaction(SIGTERM, &sa, NULL);
+    sigaction(SIGINT, &sa, NULL);
+}
+
+int main(int argc, char** argv) {
+    task_graph_run_config_t config = {0};
+    const char* tasks_file = NULL;
+    bool order_only = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool has_value = (i + 1 < argc);
+
+        if (strcmp(arg, "--order") == 0) {
+            order_only = true;
+        } else if (strcmp(arg, "--max-parallel") == 0 && has_value) {
+            config.max_parallel = atoi(argv[++i]);
+        } else if (strcmp(arg, "--runner") == 0 && has_value) {
+            config.runner = argv[++i];
+        } else if (strcmp(arg, "--log-dir") == 0 && has_value) {
+            config.log_dir = argv[++i];
+        } else if (strcmp(arg, "--log-prefix") == 0 && has_value) {
+            config.log_prefix = argv[++i];
+        } else if (strcmp(arg, "--status") == 0 && has_value) {
+            config.status_path = argv[++i];
+        } else if (arg[0] != '-' && !tasks_file) {
+            tasks_file = arg;
+        } else {
+            print_usage(argv[0]);
+            return DAG_RUN_EXIT_INVALID;
+        }
+    }
+
+    if (!tasks_file) {
+        print_usage(argv[0]);
+        return DAG_RUN_EXIT_INVALID;
+    }
+
+    /* Errors are reported on stderr below; keep the library log quiet */
+    log_enable(false);
+
+    task_graph_t* graph = NULL;
+    if (task_graph_load(tasks_file, &graph) != ARGO_SUCCESS) {
+        fprintf(stderr, "Error: Cannot read tasks file: %s\n", tasks_file);
+        return DAG_RUN_EXIT_INVALID;
+    }
+    if (graph->count == 0) {
+        fprintf(stderr, "Error: No tasks found\n");
+        task_graph_destroy(graph);
+        return DAG_RUN_EXIT_INVALID;
+    }
+    if (task_graph_validate(graph) != ARGO_SUCCESS) {
+        fprintf(stderr, "Error: %s\n", graph->error[0] ? graph->error : "Invalid task graph");
+        task_graph_destroy(graph);
+        return DAG_RUN_EXIT_INVALID;
+    }
+
+    int exit_code = DAG_RUN_EXIT_OK;
+    if (order_only) {
+        for (int i = 0; i < graph->count; i++) {
+            printf("%s\n", graph->nodes[graph->order[i]].id);
+        }
+    } else {
+        install_cancel_handler();
+        config.cancel = &g_cancel;
+        if (task_graph_run(graph, &config) != ARGO_SUCCESS) {
+            exit_code = DAG_RUN_EXIT_FAILED;
+        }
+    }
+
+    task_graph_destroy(graph);
+    return exit_code;
+}
@@ -0,0 +1,241 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Process waiter - wait on many children at once (pidfd+epoll / kqueue) */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* syscall() */
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#else
+#include <sys/event.h>
+#endif
+
+/* Project includes */
+#include "argo_process_waiter.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_limits.h"
+#include "argo_log.h"
+#include "argo_time.h"
+
+#if defined(__linux__) && !defined(SYS_pidfd_open)
+#define SYS_pidfd_open 434  /* Same number on every architecture */
+#endif
+
+/* One watched child */
+typedef struct {
+    pid_t pid;
+    int fd;             /* pidfd (Linux), -1 otherwise */
+} watched_proc_t;
+
+struct process_waiter {
+    int event_fd;       /* epoll (Linux) or kqueue (macOS) */
+    bool polling;       /* Linux without pidfd_open: check children on a tick */
+    watched_proc_t procs[PROCESS_WAITER_MAX_PROCS];
+    int count;
+};
+
+/* Create waiter */
+process_waiter_t* process_waiter_create(void) {
+    process_waiter_t* waiter = calloc(1, sizeof(process_waiter_t));
+    if (!waiter) {
+        argo_report_error(E_SYSTEM_MEMORY, "process_waiter_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return NULL;
+    }
+
+#ifdef __linux__
+    waiter->event_fd = epoll_create1(EPOLL_CLOEXEC);
+#else
+    waiter->event_fd = kqueue();
+#endif
+    if (waiter->event_fd < 0) {
+        argo_report_error(E_SYSTEM_PROCESS, "process_waiter_create",
+                         ERR_FMT_SYSCALL_ERROR, "event queue", strerror(errno));
+        free(waiter);
+        return NULL;
+    }
+    return waiter;
+}
+
+/* Helper: Register a child with the event queue */
+static int watch_proc(process_waiter_t* waiter, watched_proc_t* proc) {
+    proc->fd = -1;
+
+#ifdef __linux__
+    if (waiter->polling) {
+        return ARGO_SUCCESS;
+    }
+
+    int fd = (int)syscall(SYS_pidfd_open, proc->pid, 0);
+    if (fd < 0) {
+        if (errno == ENOSYS) {
+            LOG_WARN("pidfd_open unavailable, falling back to polling child processes");
+            waiter->polling = true;
+            return ARGO_SUCCESS;
+        }
+        return E_SYSTEM_PROCESS;
+    }
+
+    struct epoll_event ev = {0};
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    if (epoll_ctl(waiter->event_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        close(fd);
+        return E_SYSTEM_PROCESS;
+    }
+    proc->fd = fd;
+#else
+    struct kevent ev;
+    EV_SET(&ev, proc->pid, EVFILT_PROC, EV_ADD | EV_ONESHOT, NOTE_EXIT, 0, NULL);
+    if (kevent(waiter->event_fd, &ev, 1, NULL, 0, NULL) < 0) {
+        /* ESRCH: already exited - wait reaps it before blocking */
+        if (errno != ESRCH) {
+            return E_SYSTEM_PROCESS;
+        }
+    }
+#endif
+    return ARGO_SUCCESS;
+}
+
+/* Watch a child process */
+int process_waiter_add(process_waiter_t* waiter, pid_t pid) {
+    ARGO_CHECK_NULL(waiter);
+    if (waiter->count >= PROCESS_WAITER_MAX_PROCS) {
+        argo_report_error(E_INPUT_TOO_LARGE, "process_waiter_add", ERR_FMT_SIZE_VALUE,
+                         (size_t)waiter->count);
+        return E_INPUT_TOO_LARGE;
+    }
+
+    watched_proc_t* proc = &waiter->procs[waiter->count];
+    proc->pid = pid;
+    int result = watch_proc(waiter, proc);
+    if (result != ARGO_SUCCESS) {
+        argo_report_error(result, "process_waiter_add", ERR_FMT_SYSCALL_ERROR,
+                         "watch child", strerror(errno));
+        return result;
+    }
+
+    waiter->count++;
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Reap watched child at index if it has exited
+ *
+ * Returns ARGO_SUCCESS if reaped, E_SYSTEM_PROCESS if it vanished
+ * (reaped by someone else), E_TIMEOUT if it is still running.
+ */
+static int reap_proc(process_waiter_t* waiter, int index, pid_t* pid_out, int* status_out) {
+    watched_proc_t* proc = &waiter->procs[index];
+    int status = 0;
+
+    pid_t reaped = waitpid(proc->pid, &status, WNOHANG);
+    if (reaped == 0 || (reaped < 0 && errno == EINTR)) {
+        return E_TIMEOUT;
+    }
+
+    int result = ARGO_SUCCESS;
+    if (reaped < 0) {
+        argo_report_error(E_SYSTEM_PROCESS, "process_waiter_wait", ERR_FMT_SYSCALL_ERROR,
+                         "waitpid", strerror(errno));
+        result = E_SYSTEM_PROCESS;
+    }
+    *pid_out = proc->pid;
+    *status_out = status;
+
+    if (proc->fd >= 0) {
+        close(proc->fd);  /* Also drops it from the epoll set */
+    }
+    waiter->procs[index] = waiter->procs[--waiter->count];
+    return result;
+}
+
+/* Helper: Block in the event queue until an exit event or timeout */
+static int wait_event(process_waiter_t* waiter, int timeout_ms) {
+#ifdef __linux__
+    struct epoll_event ev;
+    return epoll_wait(waiter->event_fd, &ev, 1, timeout_ms);
+#else
+    struct kevent ev;
+    struct timespec ts;
+    struct timespec* tsp = NULL;
+    if (timeout_ms >= 0) {
+        ts.tv_sec = timeout_ms / MILLISECONDS_PER_SECOND;
+        ts.tv_nsec = (long)(timeout_ms % MILLISECONDS_PER_SECOND) * NANOSECONDS_PER_MILLISECOND;
+        tsp = &ts;
+    }
+    return kevent(waiter->event_fd, NULL, 0, &ev, 1, tsp);
+#endif
+}
+
+/* Wait for a watched child to exit and reap it */
+int process_waiter_wait(process_waiter_t* waiter, int timeout_ms,
+                        pid_t* pid_out, int* status_out) {
+    ARGO_CHECK_NULL(waiter);
+    ARGO_CHECK_NULL(pid_out);
+    ARGO_CHECK_NULL(status_out);
+
+    if (waiter->count == 0) {
+        return E_INVALID_STATE;
+    }
+
+    long long deadline = (timeout_ms >= 0) ? argo_monotonic_ms() + timeout_ms : -1;
+
+    while (1) {
+        /* Event queues only say something exited - find out which */
+        for (int i = 0; i < waiter->count; i++) {
+            int result = reap_proc(waiter, i, pid_out, status_out);
+            if (result != E_TIMEOUT) {
+                return result;
+            }
+        }
+
+        int wait_ms = -1;
+        if (deadline >= 0) {
+            long long remaining = deadline - argo_monotonic_ms();
+            if (remaining <= 0) {
+                return E_TIMEOUT;
+            }
+            wait_ms = (int)remaining;
+        }
+        if (waiter->polling) {
+            int tick_ms = WORKFLOW_POLL_INTERVAL_USEC / MICROSECONDS_PER_MILLISECOND;
+            if (wait_ms < 0 || wait_ms > tick_ms) wait_ms = tick_ms;
+        }
+
+        if (wait_event(waiter, wait_ms) < 0 && errno != EINTR) {
+            argo_report_error(E_SYSTEM_PROCESS, "process_waiter_wait",
+                             ERR_FMT_SYSCALL_ERROR, "event wait", strerror(errno));
+            return E_SYSTEM_PROCESS;
+        }
+    }
+}
+
+/* Number of children currently watched */
+int process_waiter_count(const process_waiter_t* waiter) {
+    return waiter ? waiter->count : 0;
+}
+
+/* Destroy waiter */
+void process_waiter_destroy(process_waiter_t* waiter) {
+    if (!waiter) return;
+
+    for (int i = 0; i < waiter->count; i++) {
+        if (waiter->procs[i].fd >= 0) {
+            close(waiter->procs[i].fd);
+        }
+    }
+    close(waiter->event_fd);
+    free(waiter);
+}
@@ -0,0 +1,532 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Task graph - parse tasks.json, validate the DAG, compute critical-path priorities */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+/* Project includes */
+#include "argo_task_graph.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_file_utils.h"
+#include "argo_log.h"
+#define JSMN_STATIC  /* Private copy - keeps the workflow library off argo_socket.o */
+#include "jsmn.h"
+
+/* Helper: Index one past the subtree rooted at token i */
+static int token_skip(const jsmntok_t* tokens, int count, int i) {
+    int end = tokens[i].end;
+    int j = i + 1;
+    while (j < count && tokens[j].start < end) {
+        j++;
+    }
+    return j;
+}
+
+/* Helper: Compare token text with a literal */
+static bool token_equals(const char* json, const jsmntok_t* tok, const char* str) {
+    int len = tok->end - tok->start;
+    return tok->type == JSMN_STRING && (int)strlen(str) == len &&
+           strncmp(json + tok->start, str, len) == 0;
+}
+
+/* Helper: Copy token text into a fixed buffer */
+static bool token_copy(const char* json, const jsmntok_t* tok, char* out, size_t size) {
+    int len = tok->end - tok->start;
+    if (len < 0 || (size_t)len >= size) {
+        return false;
+    }
+    memcpy(out, json + tok->start, len);
+    out[len] = '\0';
+    return true;
+}
+
+/* Helper: Parse depends_on array into node->dep_ids */
+static int parse_depends(const char* json, const jsmntok_t* tokens, int count,
+                        int arr, task_node_t* node) {
+    if (tokens[arr].type != JSMN_ARRAY) {
+        return E_INPUT_FORMAT;
+    }
+    if (tokens[arr].size == 0) {
+        return ARGO_SUCCESS;
+    }
+
+    node->dep_ids = calloc(tokens[arr].size, sizeof(char*));
+    if (!node->dep_ids) {
+        return E_SYSTEM_MEMORY;
+    }
+
+    int i = arr + 1;
+    for (int d = 0; d < tokens[arr].size && i < count; d++) {
+        if (tokens[i].type != JSMN_STRING) {
+            return E_INPUT_FORMAT;
+        }
+        node->dep_ids[d] = strndup(json + tokens[i].start, tokens[i].end - tokens[i].start);
+        if (!node->dep_ids[d]) {
+            return E_SYSTEM_MEMORY;
+        }
+        node->dep_count++;
+        i = token_skip(tokens, count, i);
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Parse one task object into node */
+static int parse_task(const char* json, const jsmntok_t* tokens, int count,
+                     int obj, task_node_t* node) {
+    if (tokens[obj].type != JSMN_OBJECT) {
+        return E_INPUT_FORMAT;
+    }
+
+    node->estimate = TASK_GRAPH_DEFAULT_ESTIMATE;
+
+    int i = obj + 1;
+    for (int k = 0; k < tokens[obj].size && i + 1 < count; k++) {
+        const jsmntok_t* key = &tokens[i];
+        const jsmntok_t* val = &tokens[i + 1];
+        int result = ARGO_SUCCESS;
+
+        if (token_equals(json, key, TASK_GRAPH_JSON_ID)) {
+            if (!token_copy(json, val, node->id, sizeof(node->id))) result = E_INPUT_TOO_LARGE;
+        } else if (token_equals(json, key, TASK_GRAPH_JSON_NAME)) {
+            if (!token_copy(json, val, node->name, sizeof(node->name))) result = E_INPUT_TOO_LARGE;
+        } else if (token_equals(json, key, TASK_GRAPH_JSON_SCRIPT)) {
+            if (!token_copy(json, val, node->script, sizeof(node->script))) result = E_INPUT_TOO_LARGE;
+        } else if (token_equals(json, key, TASK_GRAPH_JSON_ESTIMATE)) {
+            long estimate = strtol(json + val->start, NULL, DECIMAL_BASE);
+            if (estimate > 0) node->estimate = (int)estimate;
+        } else if (token_equals(json, key, TASK_GRAPH_JSON_DEPENDS)) {
+            result = parse_depends(json, tokens, count, i + 1, node);
+        }
+
+        if (result != ARGO_SUCCESS) {
+            return result;
+        }
+        i = token_skip(tokens, count, i + 1);
+    }
+
+    if (node->name[0] == '\0') {
+        strncpy(node->name, node->id, sizeof(node->name) - 1);
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Locate the tasks array in the top-level object */
+static int find_tasks_array(const char* json, const jsmntok_t* tokens, int count) {
+    if (count < 1 || tokens[0].type != JSMN_OBJECT) {
+        return -1;
+    }
+
+    int i = 1;
+    for (int k = 0; k < tokens[0].size && i + 1 < count; k++) {
+        if (token_equals(json, &tokens[i], TASK_GRAPH_JSON_TASKS) &&
+            tokens[i + 1].type == JSMN_ARRAY) {
+            return i + 1;
+        }
+        i = token_skip(tokens, count, i + 1);
+    }
+    return -1;
+}
+
+/* Parse tasks.json content */
+int task_graph_parse(const char* json, task_graph_t** graph_out) {
+    int result = ARGO_SUCCESS;
+    jsmntok_t* tokens = NULL;
+    task_graph_t* graph = NULL;
+
+    ARGO_CHECK_NULL(json);
+    ARGO_CHECK_NULL(graph_out);
+    *graph_out = NULL;
+
+    /* Size the token array from the document itself */
+    size_t len = strlen(json);
+    jsmn_parser parser;
+    jsmn_init(&parser);
+    int count = jsmn_parse(&parser, json, len, NULL, 0);
+    if (count <= 0) {
+        argo_report_error(E_INPUT_FORMAT, "task_graph_parse", "malformed tasks JSON");
+        return E_INPUT_FORMAT;
+    }
+
+    tokens = malloc(sizeof(jsmntok_t) * count);
+    if (!tokens) {
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
+    jsmn_init(&parser);
+    count = jsmn_parse(&parser, json, len, tokens, count);
+
+    int arr = find_tasks_array(json, tokens, count);
+    if (arr < 0) {
+        argo_report_error(E_INPUT_FORMAT, "task_graph_parse", "no \"%s\" array", TASK_GRAPH_JSON_TASKS);
+        result = E_INPUT_FORMAT;
+        goto cleanup;
+    }
+    if (tokens[arr].size > TASK_GRAPH_MAX_TASKS) {
+        argo_report_error(E_INPUT_TOO_LARGE, "task_graph_parse", "%d tasks", tokens[arr].size);
+        result = E_INPUT_TOO_LARGE;
+        goto cleanup;
+    }
+
+    graph = calloc(1, sizeof(task_graph_t));
+    if (!graph) {
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
+    if (tokens[arr].size > 0) {
+        graph->nodes = calloc(tokens[arr].size, sizeof(task_node_t));
+        if (!graph->nodes) {
+            result = E_SYSTEM_MEMORY;
+            goto cleanup;
+        }
+    }
+
+    int i = arr + 1;
+    for (int t = 0; t < tokens[arr].size && i < count; t++) {
+        graph->count++;
+        result = parse_task(json, tokens, count, i, &graph->nodes[t]);
+        if (result != ARGO_SUCCESS) {
+            argo_report_error(result, "task_graph_parse", "task %d", t);
+            goto cleanup;
+        }
+        i = token_skip(tokens, count, i);
+    }
+
+    *graph_out = graph;
+    graph = NULL;
+
+cleanup:
+    if (result == E_SYSTEM_MEMORY) {
+        argo_report_error(result, "task_graph_parse", ERR_MSG_MEMORY_ALLOC_FAILED);
+    }
+    task_graph_destroy(graph);
+    free(tokens);
+    return result;
+}
+
+/* Load and parse a tasks.json file */
+int task_graph_load(const char* path, task_graph_t** graph_out) {
+    ARGO_CHECK_NULL(path);
+    ARGO_CHECK_NULL(graph_out);
+
+    char* json = NULL;
+    int result = file_read_all(path, &json, NULL);
+    if (result != ARGO_SUCCESS) {
+        return result;
+    }
+
+    result = task_graph_parse(json, graph_out);
+    free(json);
+    return result;
+}
+
+/* Helper: Order nodes by id for duplicate detection and lookup */
+static int compare_node_id(const void* a, const void* b) {
+    const task_node_t* na = *(const task_node_t* const*)a;
+    const task_node_t* nb = *(const task_node_t* const*)b;
+    return strcmp(na->id, nb->id);
+}
+
+/* Helper: Resolve dependency ids to node indices via a sorted index */
+static int resolve_dependencies(task_graph_t* graph) {
+    int result = ARGO_SUCCESS;
+    task_node_t** sorted = malloc(sizeof(task_node_t*) * graph->count);
+    if (!sorted) {
+        return E_SYSTEM_MEMORY;
+    }
+
+    for (int i = 0; i < graph->count; i++) {
+        if (graph->nodes[i].id[0] == '\0') {
+            snprintf(graph->error, sizeof(graph->error), "Task %d has no id", i);
+            result = E_WORKFLOW_INVALID;
+            goto cleanup;
+        }
+        sorted[i] = &graph->nodes[i];
+    }
+
+    qsort(sorted, graph->count, sizeof(task_node_t*), compare_node_id);
+    for (int i = 1; i < graph->count; i++) {
+        if (strcmp(sorted[i - 1]->id, sorted[i]->id) == 0) {
+            snprintf(graph->error, sizeof(graph->error), "Duplicate task id '%s'", sorted[i]->id);
+            result = E_WORKFLOW_INVALID;
+            goto cleanup;
+        }
+    }
+
+    for (int i = 0; i < graph->count; i++) {
+        task_node_t* node = &graph->nodes[i];
+        if (node->dep_count == 0) continue;
+
+        free(node->deps);
+        node->deps = malloc(sizeof(int) * node->dep_count);
+        if (!node->deps) {
+            result = E_SYSTEM_MEMORY;
+            goto cleanup;
+        }
+
+        for (int d = 0; d < node->dep_count; d++) {
+            task_node_t key;
+            task_node_t* key_ptr = &key;
+            strncpy(key.id, node->dep_ids[d], sizeof(key.id) - 1);
+            key.id[sizeof(key.id) - 1] = '\0';
+
+            task_node_t** found = bsearch(&key_ptr, sorted, graph->count,
+                                          sizeof(task_node_t*), compare_node_id);
+            if (!found) {
+                snprintf(graph->error, sizeof(graph->error),
+                        "Task '%s' depends on unknown task '%s'", node->id, node->dep_ids[d]);
+                result = E_WORKFLOW_INVALID;
+                goto cleanup;
+            }
+            node->deps[d] = (int)(*found - graph->nodes);
+        }
+    }
+
+cleanup:
+    free(sorted);
+    return result;
+}
+
+/* Helper: Build reverse edges (dependency -> dependents) */
+static int build_dependents(task_graph_t* graph) {
+    for (int i = 0; i < graph->count; i++) {
+        for (int d = 0; d < graph->nodes[i].dep_count; d++) {
+            graph->nodes[graph->nodes[i].deps[d]].dependent_count++;
+        }
+    }
+
+    for (int i = 0; i < graph->count; i++) {
+        task_node_t* node = &graph->nodes[i];
+        free(node->dependents);
+        node->dependents = NULL;
+        if (node->dependent_count > 0) {
+            node->dependents = malloc(sizeof(int) * node->dependent_count);
+            if (!node->dependents) {
+                return E_SYSTEM_MEMORY;
+            }
+        }
+        node->dependent_count = 0;
+    }
+
+    for (int i = 0; i < graph->count; i++) {
+        for (int d = 0; d < graph->nodes[i].dep_count; d++) {
+            task_node_t* dep = &graph->nodes[graph->nodes[i].deps[d]];
+            dep->dependents[dep->dependent_count++] = i;
+        }
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Helper: Describe one cycle among nodes Kahn's algorithm could not order
+ *
+ * Every unordered node still has an unordered dependency, so following
+ * those edges from any of them must revisit a node; that loop is the cycle.
+ */
+static void describe_cycle(task_graph_t* graph, const int* indegree) {
+    int* visited = calloc(graph->count, sizeof(int));
+    int* next = malloc(sizeof(int) * graph->count);
+    if (!visited || !next) {
+        snprintf(graph->error, sizeof(graph->error), "Dependency cycle detected");
+        goto cleanup;
+    }
+
+    int cur = 0;
+    while (cur < graph->count && indegree[cur] == 0) cur++;
+    if (cur == graph->count) goto cleanup;
+
+    while (!visited[cur]) {
+        visited[cur] = 1;
+        next[cur] = cur;
+        for (int d = 0; d < graph->nodes[cur].dep_count; d++) {
+            if (indegree[graph->nodes[cur].deps[d]] > 0) {
+                next[cur] = graph->nodes[cur].deps[d];
+                break;
+            }
+        }
+        cur = next[cur];
+    }
+
+    /* cur is on the cycle - print it from there back to itself */
+    int start = cur;
+    int written = snprintf(graph->error, sizeof(graph->error), "Dependency cycle: %s",
+                           graph->nodes[start].id);
+    do {
+        cur = next[cur];
+        if (written >= 0 && (size_t)written < sizeof(graph->error)) {
+            written += snprintf(graph->error + written, sizeof(graph->error) - written,
+                               " -> %s", graph->nodes[cur].id);
+        }
+    } while (cur != start);
+
+cleanup:
+    free(visited);
+    free(next);
+}
+
+/* Helper: Kahn's algorithm - topological order, or the cycle that prevents one */
+static int topological_sort(task_graph_t* graph) {
+    int* indegree = malloc(sizeof(int) * graph->count);
+    free(graph->order);
+    graph->order = malloc(sizeof(int) * graph->count);
+    if (!indegree || !graph->order) {
+        free(indegree);
+        return E_SYSTEM_MEMORY;
+    }
+
+    int tail = 0;
+    for (int i = 0; i < graph->count; i++) {
+        indegree[i] = graph->nodes[i].dep_count;
+        if (indegree[i] == 0) graph->order[tail++] = i;
+    }
+
+    for (int head = 0; head < tail; head++) {
+        task_node_t* node = &graph->nodes[graph->order[head]];
+        for (int d = 0; d < node->dependent_count; d++) {
+            if (--indegree[node->dependents[d]] == 0) {
+                graph->order[tail++] = node->dependents[d];
+            }
+        }
+    }
+
+    int result = ARGO_SUCCESS;
+    if (tail < graph->count) {
+        describe_cycle(graph, indegree);
+        result = E_WORKFLOW_INVALID;
+    }
+    free(indegree);
+    return result;
+}
+
+/* Validate graph and compute schedule */
+int task_graph_validate(task_graph_t* graph) {
+    ARGO_CHECK_NULL(graph);
+    graph->validated = false;
+    graph->error[0] = '\0';
+
+    int result = resolve_dependencies(graph);
+    if (result == ARGO_SUCCESS) result = build_dependents(graph);
+    if (result == ARGO_SUCCESS) result = topological_sort(graph);
+
+    if (result == E_SYSTEM_MEMORY) {
+        argo_report_error(result, "task_graph_validate", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return result;
+    }
+    if (result != ARGO_SUCCESS) {
+        argo_report_error(result, "task_graph_validate", "%s", graph->error);
+        return result;
+    }
+
+    /* Critical path: a node's priority is its own estimate plus the longest
+     * chain hanging below it. Reverse topological order sees dependents first. */
+    graph->critical_path = 0;
+    for (int k = graph->count - 1; k >= 0; k--) {
+        task_node_t* node = &graph->nodes[graph->order[k]];
+        long longest = 0;
+        for (int d = 0; d < node->dependent_count; d++) {
+            long p = graph->nodes[node->dependents[d]].priority;
+            if (p > longest) longest = p;
+        }
+        node->priority = node->estimate + longest;
+        if (node->priority > graph->critical_path) {
+            graph->critical_path = node->priority;
+        }
+    }
+
+    graph->validated = true;
+    LOG_DEBUG("Task graph: %d tasks, critical path %ld", graph->count, graph->critical_path);
+    return ARGO_SUCCESS;
+}
+
+/* Find node index by id */
+int task_graph_find(const task_graph_t* graph, const char* id) {
+    if (!graph || !id) return -1;
+
+    for (int i = 0; i < graph->count; i++) {
+        if (strcmp(graph->nodes[i].id, id) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Write per-node state as JSON */
+int task_graph_write_status(const task_graph_t* graph, const char* path) {
+    ARGO_CHECK_NULL(graph);
+    ARGO_CHECK_NULL(path);
+
+    char tmp_path[ARGO_PATH_MAX];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+    FILE* fp = fopen(tmp_path, "w");
+    if (!fp) {
+        argo_report_error(E_SYSTEM_FILE, "task_graph_write_status",
+                         ERR_FMT_SYSCALL_ERROR, tmp_path, strerror(errno));
+        return E_SYSTEM_FILE;
+    }
+
+    int counts[TASK_NODE_SKIPPED + 1] = {0};
+    for (int i = 0; i < graph->count; i++) {
+        counts[graph->nodes[i].state]++;
+    }
+
+    /* Ids and names are copied verbatim from tasks.json, so already JSON-escaped */
+    fprintf(fp, "{\"total\":%d,\"pending\":%d,\"ready\":%d,\"running\":%d,"
+                "\"completed\":%d,\"failed\":%d,\"skipped\":%d,\"critical_path\":%ld,\"nodes\":[",
+            graph->count, counts[TASK_NODE_PENDING], counts[TASK_NODE_READY],
+            counts[TASK_NODE_RUNNING], counts[TASK_NODE_COMPLETED],
+            counts[TASK_NODE_FAILED], counts[TASK_NODE_SKIPPED], graph->critical_path);
+
+    for (int i = 0; i < graph->count; i++) {
+        const task_node_t* node = &graph->nodes[i];
+        fprintf(fp, "%s{\"id\":\"%s\",\"name\":\"%s\",\"state\":\"%s\",\"priority\":%ld,"
+                    "\"pid\":%d,\"exit_code\":%d,\"start_time\":%ld,\"end_time\":%ld}",
+                i > 0 ? "," : "", node->id, node->name,
+                task_node_state_to_string(node->state), node->priority,
+                (int)node->pid, node->exit_code,
+                (long)node->start_time, (long)node->end_time);
+    }
+    fprintf(fp, "]}\n");
+
+    if (fclose(fp) != 0 || rename(tmp_path, path) != 0) {
+        argo_report_error(E_SYSTEM_FILE, "task_graph_write_status",
+                         ERR_FMT_SYSCALL_ERROR, path, strerror(errno));
+        unlink(tmp_path);
+        return E_SYSTEM_FILE;
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Convert node state to string */
+const char* task_node_state_to_string(task_node_state_t state) {
+    switch (state) {
+        case TASK_NODE_PENDING:   return "pending";
+        case TASK_NODE_READY:     return "ready";
+        case TASK_NODE_RUNNING:   return "running";
+        case TASK_NODE_COMPLETED: return "completed";
+        case TASK_NODE_FAILED:    return "failed";
+        case TASK_NODE_SKIPPED:   return "skipped";
+        default:                  return "unknown";
+    }
+}
+
+/* Free graph */
+void task_graph_destroy(task_graph_t* graph) {
+    if (!graph) return;
+
+    for (int i = 0; i < graph->count; i++) {
+        task_node_t* node = &graph->nodes[i];
+        for (int d = 0; d < node->dep_count; d++) {
+            free(node->dep_ids[d]);
+        }
+        free(node->dep_ids);
+        free(node->deps);
+        free(node->dependents);
+    }
+    free(graph->nodes);
+    free(graph->order);
+    free(graph);
+}
@@ -0,0 +1,369 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Task graph runner - parallel, critical-path-first execution of a validated DAG */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+/* Project includes */
+#include "argo_task_graph.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_limits.h"
+#include "argo_log.h"
+
+/* Run state shared by the scheduler helpers */
+typedef struct {
+    task_graph_t* graph;
+    const task_graph_run_config_t* config;
+    int* heap;              /* Ready nodes, max-heap on priority */
+    int heap_count;
+    int* running;           /* Node indices with a live process */
+    int running_count;
+    int max_parallel;
+    int* stack;             /* Scratch for skipping downstream nodes */
+    sigset_t orig_mask;     /* Caller's signal mask, restored in each task */
+} run_state_t;
+
+/* Helper: Wake sigsuspend() when a task exits */
+static void child_handler(int sig) {
+    (void)sig;
+}
+
+/* Helper: Heap order - higher priority first, then tasks.json order */
+static bool heap_before(const run_state_t* rs, int a, int b) {
+    long pa = rs->graph->nodes[a].priority;
+    long pb = rs->graph->nodes[b].priority;
+    return pa > pb || (pa == pb && a < b);
+}
+
+/* Helper: Push a ready node */
+static void heap_push(run_state_t* rs, int node) {
+    int i = rs->heap_count++;
+    rs->heap[i] = node;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!heap_before(rs, rs->heap[i], rs->heap[parent])) break;
+        int tmp = rs->heap[i];
+        rs->heap[i] = rs->heap[parent];
+        rs->heap[parent] = tmp;
+        i = parent;
+    }
+}
+
+/* Helper: Pop the ready node heading the longest remaining chain */
+static int heap_pop(run_state_t* rs) {
+    int top = rs->heap[0];
+    rs->heap[0] = rs->heap[--rs->heap_count];
+
+    int i = 0;
+    while (1) {
+        int best = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+        if (left < rs->heap_count && heap_before(rs, rs->heap[left], rs->heap[best])) best = left;
+        if (right < rs->heap_count && heap_before(rs, rs->heap[right], rs->heap[best])) best = right;
+        if (best == i) break;
+        int tmp = rs->heap[i];
+        rs->heap[i] = rs->heap[best];
+        rs->heap[best] = tmp;
+        i = best;
+    }
+    return top;
+}
+
+/* Helper: Persist node states if a status file was requested */
+static void publish_status(const run_state_t* rs) {
+    if (rs->config->status_path) {
+        task_graph_write_status(rs->graph, rs->config->status_path);
+    }
+}
+
+/* Helper: Redirect task output to its own log file (child only) */
+static void redirect_task_output(const run_state_t* rs, const task_node_t* node) {
+    int null_fd = open(TASK_GRAPH_NULL_DEVICE, O_RDONLY);
+    if (null_fd >= 0) {
+        dup2(null_fd, STDIN_FILENO);
+        close(null_fd);
+    }
+
+    if (!rs->config->log_dir) return;
+
+    /* Keep the log inside log_dir whatever the id contains */
+    char leaf[TASK_GRAPH_ID_MAX];
+    strncpy(leaf, node->id, sizeof(leaf) - 1);
+    leaf[sizeof(leaf) - 1] = '\0';
+    for (char* p = leaf; *p; p++) {
+        if (*p == '/') *p = '_';
+    }
+
+    char log_path[ARGO_PATH_MAX];
+    snprintf(log_path, sizeof(log_path), "%s/%s%s%s", rs->config->log_dir,
+             rs->config->log_prefix ? rs->config->log_prefix : "", leaf, TASK_GRAPH_LOG_SUFFIX);
+
+    int log_fd = open(log_path, O_CREAT | O_WRONLY | O_APPEND, ARGO_FILE_PERMISSIONS);
+    if (log_fd >= 0) {
+        dup2(log_fd, STDOUT_FILENO);
+        dup2(log_fd, STDERR_FILENO);
+        close(log_fd);
+    }
+}
+
+/* Helper: Fork and exec one task in its own process group */
+static pid_t spawn_task(const run_state_t* rs, const task_node_t* node) {
+    pid_t pid = fork();
+    if (pid != 0) {
+        if (pid > 0) setpgid(pid, pid);  /* Also set by the child; whichever runs first wins */
+        return pid;
+    }
+
+    setpgid(0, 0);
+    sigprocmask(SIG_SETMASK, &rs->orig_mask, NULL);
+    if (rs->config->working_dir && chdir(rs->config->working_dir) != 0) {
+        _exit(TASK_GRAPH_EXEC_FAILED_EXIT);
+    }
+    redirect_task_output(rs, node);
+
+    setenv(TASK_GRAPH_ENV_TASK_ID, node->id, 1);
+    setenv(TASK_GRAPH_ENV_TASK_NAME, node->name, 1);
+
+    if (node->script[0]) {
+        execl(SHELL_PATH_BASH, SHELL_PATH_BASH, node->script, (char*)NULL);
+    } else {
+        execl(SHELL_PATH_BASH, SHELL_PATH_BASH, rs->config->runner, node->id, (char*)NULL);
+    }
+
+    /* GUIDELINE_APPROVED: Child process error before _exit */
+    fprintf(stderr, "Failed to execute task %s\n", node->id);
+    _exit(TASK_GRAPH_EXEC_FAILED_EXIT);
+}
+
+/* Helper: Mark everything downstream of a failed node as skipped */
+static void skip_downstream(run_state_t* rs, int failed) {
+    int top = 0;
+    rs->stack[top++] = failed;
+
+    while (top > 0) {
+        task_node_t* node = &rs->graph->nodes[rs->stack[--top]];
+        for (int d = 0; d < node->dependent_count; d++) {
+            task_node_t* dep = &rs->graph->nodes[node->dependents[d]];
+            if (dep->state == TASK_NODE_PENDING) {
+                dep->state = TASK_NODE_SKIPPED;
+                LOG_INFO("Task %s skipped (depends on %s)", dep->id, node->id);
+                rs->stack[top++] = node->dependents[d];
+            }
+        }
+    }
+}
+
+/* Helper: Start ready tasks until the parallelism limit is reached */
+static void start_ready_tasks(run_state_t* rs) {
+    while (rs->running_count < rs->max_parallel && rs->heap_count > 0) {
+        int idx = heap_pop(rs);
+        task_node_t* node = &rs->graph->nodes[idx];
+
+        pid_t pid = spawn_task(rs, node);
+        if (pid < 0) {
+            argo_report_error(E_SYSTEM_FORK, "task_graph_run", ERR_FMT_SYSCALL_ERROR,
+                             node->id, strerror(errno));
+            node->state = TASK_NODE_FAILED;
+            node->exit_code = TASK_GRAPH_EXEC_FAILED_EXIT;
+            skip_downstream(rs, idx);
+            continue;
+        }
+
+        node->state = TASK_NODE_RUNNING;
+        node->pid = pid;
+        node->start_time = time(NULL);
+        rs->running[rs->running_count++] = idx;
+        LOG_INFO("Task %s started (PID %d, priority %ld)", node->id, pid, node->priority);
+    }
+}
+
+/* Helper: Record a task's exit and release or skip its dependents */
+static void finish_task(run_state_t* rs, int slot, int status) {
+    int idx = rs->running[slot];
+    task_node_t* node = &rs->graph->nodes[idx];
+    rs->running[slot] = rs->running[--rs->running_count];
+
+    node->end_time = time(NULL);
+    node->exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : -WTERMSIG(status);
+    node->state = (node->exit_code == 0) ? TASK_NODE_COMPLETED : TASK_NODE_FAILED;
+    LOG_INFO("Task %s %s (exit %d, %lds)", node->id, task_node_state_to_string(node->state),
+            node->exit_code, (long)(node->end_time - node->start_time));
+
+    if (node->state == TASK_NODE_FAILED) {
+        skip_downstream(rs, idx);
+        return;
+    }
+
+    for (int d = 0; d < node->dependent_count; d++) {
+        task_node_t* dep = &rs->graph->nodes[node->dependents[d]];
+        if (--dep->pending_deps == 0 && dep->state == TASK_NODE_PENDING) {
+            dep->state = TASK_NODE_READY;
+            heap_push(rs, node->dependents[d]);
+        }
+    }
+}
+
+/* Helper: Ask every running task's process group to stop */
+static void terminate_running(const run_state_t* rs) {
+    for (int i = 0; i < rs->running_count; i++) {
+        pid_t pid = rs->graph->nodes[rs->running[i]].pid;
+        LOG_INFO("Stopping task %s (PID %d)", rs->graph->nodes[rs->running[i]].id, pid);
+        kill(-pid, SIGTERM);
+    }
+}
+
+/* Helper: Schedule until nothing is running and nothing more can start
+ *
+ * SIGCHLD and the cancel signals stay blocked except inside sigsuspend(),
+ * so a cancel or exit arriving after the checks below still wakes the wait.
+ */
+static void schedule(run_state_t* rs) {
+    bool stopping = false;
+
+    sigset_t block;
+    sigemptyset(&block);
+    sigaddset(&block, SIGCHLD);
+    sigaddset(&block, SIGINT);
+    sigaddset(&block, SIGTERM);
+    sigprocmask(SIG_BLOCK, &block, &rs->orig_mask);
+    sigset_t wait_mask = rs->orig_mask;
+    sigdelset(&wait_mask, SIGCHLD);
+
+    struct sigaction sa = {0};
+    struct sigaction old_sa;
+    sa.sa_handler = child_handler;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_NOCLDSTOP;
+    sigaction(SIGCHLD, &sa, &old_sa);
+
+    for (int i = 0; i < rs->graph->count; i++) {
+        task_node_t* node = &rs->graph->nodes[i];
+        node->state = TASK_NODE_PENDING;
+        node->pending_deps = node->dep_count;
+        node->pid = 0;
+        node->exit_code = 0;
+        node->start_time = 0;
+        node->end_time = 0;
+        if (node->dep_count == 0) {
+            node->state = TASK_NODE_READY;
+            heap_push(rs, i);
+        }
+    }
+
+    while (1) {
+        if (!stopping && rs->config->cancel && *rs->config->cancel) {
+            LOG_WARN("Task graph run cancelled");
+            stopping = true;
+            terminate_running(rs);
+        }
+        if (!stopping) {
+            start_ready_tasks(rs);
+        }
+        publish_status(rs);
+
+        if (rs->running_count == 0) break;
+
+        /* Reap an exited task, or sleep until SIGCHLD or a cancel signal */
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, WNOHANG);
+        if (pid == 0) {
+            sigsuspend(&wait_mask);
+            continue;
+        }
+        if (pid < 0) {
+            if (errno == EINTR) continue;
+            argo_report_error(E_SYSTEM_PROCESS, "task_graph_run", ERR_FMT_SYSCALL_ERROR,
+                             "waitpid", strerror(errno));
+            break;
+        }
+
+        for (int slot = 0; slot < rs->running_count; slot++) {
+            if (rs->graph->nodes[rs->running[slot]].pid == pid) {
+                finish_task(rs, slot, status);
+                break;
+            }
+        }
+    }
+
+    sigaction(SIGCHLD, &old_sa, NULL);
+    sigprocmask(SIG_SETMASK, &rs->orig_mask, NULL);
+}
+
+/* Run all tasks */
+int task_graph_run(task_graph_t* graph, const task_graph_run_config_t* config) {
+    int result = ARGO_SUCCESS;
+    run_state_t rs = {0};
+
+    ARGO_CHECK_NULL(graph);
+    ARGO_CHECK_NULL(config);
+    if (!graph->validated) {
+        argo_report_error(E_WORKFLOW_INVALID, "task_graph_run", "graph not validated");
+        return E_WORKFLOW_INVALID;
+    }
+
+    rs.graph = graph;
+    rs.config = config;
+    rs.max_parallel = config->max_parallel > 0 ? config->max_parallel : TASK_GRAPH_DEFAULT_PARALLEL;
+    if (rs.max_parallel > TASK_GRAPH_MAX_PARALLEL) {
+        rs.max_parallel = TASK_GRAPH_MAX_PARALLEL;
+    }
+    for (int i = 0; i < graph->count; i++) {
+        if (graph->nodes[i].script[0] == '\0' && !config->runner) {
+            argo_report_error(E_WORKFLOW_INVALID, "task_graph_run",
+                             "task %s has no script and no runner given", graph->nodes[i].id);
+            return E_WORKFLOW_INVALID;
+        }
+    }
+    if (graph->count == 0) {
+        publish_status(&rs);
+        return ARGO_SUCCESS;
+    }
+
+    rs.heap = malloc(sizeof(int) * graph->count);
+    rs.running = malloc(sizeof(int) * rs.max_parallel);
+    rs.stack = malloc(sizeof(int) * graph->count);
+    if (!rs.heap || !rs.running || !rs.stack) {
+        argo_report_error(E_SYSTEM_MEMORY, "task_graph_run", ERR_MSG_MEMORY_ALLOC_FAILED);
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
+
+    LOG_INFO("Task graph run: %d tasks, max %d parallel, critical path %ld",
+            graph->count, rs.max_parallel, graph->critical_path);
+    schedule(&rs);
+
+    /* Whatever never started (cancel) is skipped; anything still marked
+     * running was lost to a waitpid failure */
+    int completed = 0;
+    for (int i = 0; i < graph->count; i++) {
+        task_node_t* node = &graph->nodes[i];
+        if (node->state == TASK_NODE_PENDING || node->state == TASK_NODE_READY) {
+            node->state = TASK_NODE_SKIPPED;
+        } else if (node->state == TASK_NODE_RUNNING) {
+            node->state = TASK_NODE_FAILED;
+        }
+        if (node->state == TASK_NODE_COMPLETED) completed++;
+    }
+    publish_status(&rs);
+
+    LOG_INFO("Task graph run finished: %d of %d tasks completed", completed, graph->count);
+    if (completed != graph->count) {
+        result = E_WORKFLOW_FAILED;
+    }
+
+cleanup:
+    free(rs.heap);
+    free(rs.running);
+    free(rs.stack);
+    return result;
+}
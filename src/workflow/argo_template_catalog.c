@@ -0,0 +1,491 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Template catalog - in-memory workflow template index kept fresh by inotify */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* realpath() */
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+#include <pthread.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+/* Project includes */
+#include "argo_template_catalog.h"
+#include "argo_error.h"
+#include "argo_error_messages.h"
+#include "argo_limits.h"
+#include "argo_log.h"
+
+#ifdef __linux__
+#define CATALOG_ROOT_EVENTS (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | \
+                             IN_DELETE_SELF | IN_MOVE_SELF)
+#define CATALOG_DIR_EVENTS (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | \
+                            IN_CLOSE_WRITE | IN_ATTRIB)
+#endif
+
+/* One directory under a root (watched even before it holds workflow.sh) */
+typedef struct {
+    template_catalog_item_t item;
+    int root;
+    int watch;          /* inotify descriptor, -1 if none */
+    bool valid;         /* Holds workflow.sh */
+} catalog_entry_t;
+
+typedef struct {
+    char path[ARGO_PATH_MAX];
+    char source[TEMPLATE_CATALOG_SOURCE_MAX];
+    int watch;          /* inotify descriptor, -1 if none */
+    bool present;
+    time_t mtime;       /* Change detection without inotify: */
+    nlink_t nlink;      /* link count tracks subdirectories within one mtime tick */
+} catalog_root_t;
+
+struct template_catalog {
+    pthread_mutex_t lock;
+    catalog_root_t roots[TEMPLATE_CATALOG_MAX_ROOTS];
+    int root_count;
+    catalog_entry_t* entries;
+    int entry_count;
+    int entry_capacity;
+    int* index;         /* Open addressing: entry position or -1 */
+    size_t index_size;  /* Power of two */
+    bool index_stale;
+    int notify_fd;      /* inotify (Linux), -1 when unavailable */
+};
+
+/* Helper: FNV-1a hash of a template name */
+static uint32_t hash_name(const char* name) {
+    uint32_t hash = TEMPLATE_CATALOG_HASH_SEED;
+    for (const unsigned char* p = (const unsigned char*)name; *p; p++) {
+        hash ^= *p;
+        hash *= TEMPLATE_CATALOG_HASH_PRIME;
+    }
+    return hash;
+}
+
+/* Helper: First meaningful README line, as shown by 'arc workflow templates' */
+static bool read_summary(const char* readme_path, char* summary, size_t size) {
+    FILE* fp = fopen(readme_path, "r");
+    if (!fp) return false;
+
+    char line[ARGO_BUFFER_MEDIUM];
+    bool found = false;
+    while (!found && fgets(line, sizeof(line), fp)) {
+        char* start = line;
+        while (*start == ' ' || *start == '\t' || *start == '#' || *start == '\n') {
+            start++;
+        }
+        if (strlen(start) > TEMPLATE_CATALOG_MIN_SUMMARY_LEN) {
+            start[strcspn(start, "\r\n")] = '\0';
+            snprintf(summary, size, "%s", start);
+            found = true;
+        }
+    }
+    fclose(fp);
+    return found;
+}
+
+/* Helper: Build <root>/<name>[/<leaf>]; false if it does not fit */
+static bool template_path(const template_catalog_t* catalog, int root, const char* name,
+                          const char* leaf, char* path, size_t size) {
+    int written = leaf ? snprintf(path, size, "%s/%s/%s", catalog->roots[root].path, name, leaf)
+                       : snprintf(path, size, "%s/%s", catalog->roots[root].path, name);
+    return written >= 0 && (size_t)written < size;
+}
+
+/* Helper: Load template directory into entry, setting valid */
+static void load_entry(template_catalog_t* catalog, catalog_entry_t* entry) {
+    char path[ARGO_PATH_MAX];
+    struct stat st;
+
+    entry->valid = template_path(catalog, entry->root, entry->item.name,
+                                 TEMPLATE_CATALOG_SCRIPT_NAME, path, sizeof(path)) &&
+                   stat(path, &st) == 0 && S_ISREG(st.st_mode);
+    if (!entry->valid) return;
+
+    template_path(catalog, entry->root, entry->item.name, NULL, path, sizeof(path));
+    if (workflow_template_load(path, &entry->item.info) != ARGO_SUCCESS) {
+        entry->valid = false;
+        return;
+    }
+
+    if (!entry->item.info.has_readme ||
+        !read_summary(entry->item.info.readme_path, entry->item.summary, sizeof(entry->item.summary))) {
+        snprintf(entry->item.summary, sizeof(entry->item.summary), "%s",
+                 entry->item.info.description[0] ? entry->item.info.description
+                                                 : TEMPLATE_CATALOG_NO_DESCRIPTION);
+    }
+}
+
+/* Helper: Position of the entry for root/name, or -1 */
+static int find_entry(const template_catalog_t* catalog, int root, const char* name) {
+    for (int i = 0; i < catalog->entry_count; i++) {
+        if (catalog->entries[i].root == root && strcmp(catalog->entries[i].item.name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Helper: Drop entry at position */
+static void remove_entry(template_catalog_t* catalog, int pos) {
+#ifdef __linux__
+    if (catalog->entries[pos].watch >= 0) {
+        inotify_rm_watch(catalog->notify_fd, catalog->entries[pos].watch);
+    }
+#endif
+    catalog->entries[pos] = catalog->entries[--catalog->entry_count];
+    catalog->index_stale = true;
+}
+
+/* Helper: Add, reload or drop the directory root/name after a change */
+static void refresh_entry(template_catalog_t* catalog, int root, const char* name) {
+    if (name[0] == '.' || strlen(name) >= TEMPLATE_NAME_MAX) return;
+
+    char path[ARGO_PATH_MAX];
+    struct stat st;
+    bool is_dir = template_path(catalog, root, name, NULL, path, sizeof(path)) &&
+                  stat(path, &st) == 0 && S_ISDIR(st.st_mode);
+
+    int pos = find_entry(catalog, root, name);
+    if (!is_dir) {
+        if (pos >= 0) remove_entry(catalog, pos);
+        return;
+    }
+
+    if (pos < 0) {
+        if (catalog->entry_count == catalog->entry_capacity) {
+            int capacity = catalog->entry_capacity ? catalog->entry_capacity * 2
+                                                   : TEMPLATE_CATALOG_INITIAL_CAPACITY;
+            catalog_entry_t* grown = realloc(catalog->entries, capacity * sizeof(catalog_entry_t));
+            if (!grown) {
+                argo_report_error(E_SYSTEM_MEMORY, "template_catalog", ERR_MSG_MEMORY_ALLOC_FAILED);
+                return;
+            }
+            catalog->entries = grown;
+            catalog->entry_capacity = capacity;
+        }
+        pos = catalog->entry_count++;
+        catalog_entry_t* entry = &catalog->entries[pos];
+        memset(entry, 0, sizeof(*entry));
+        snprintf(entry->item.name, sizeof(entry->item.name), "%s", name);
+        snprintf(entry->item.source, sizeof(entry->item.source), "%s", catalog->roots[root].source);
+        entry->root = root;
+        entry->watch = -1;
+#ifdef __linux__
+        /* Watch before loading so files written meanwhile still raise events */
+        if (catalog->notify_fd >= 0) {
+            entry->watch = inotify_add_watch(catalog->notify_fd, path, CATALOG_DIR_EVENTS);
+        }
+#endif
+    }
+
+    catalog_entry_t* entry = &catalog->entries[pos];
+    memset(&entry->item.info, 0, sizeof(entry->item.info));
+    entry->item.summary[0] = '\0';
+    load_entry(catalog, entry);
+    catalog->index_stale = true;
+}
+
+/* Helper: Forget everything under a root and load it again */
+static void rescan_root(template_catalog_t* catalog, int root) {
+    catalog_root_t* r = &catalog->roots[root];
+
+    for (int i = catalog->entry_count - 1; i >= 0; i--) {
+        if (catalog->entries[i].root == root) {
+            remove_entry(catalog, i);
+        }
+    }
+
+    struct stat st;
+    r->present = (stat(r->path, &st) == 0 && S_ISDIR(st.st_mode));
+    if (!r->present) return;
+    r->mtime = st.st_mtime;
+    r->nlink = st.st_nlink;
+
+#ifdef __linux__
+    if (catalog->notify_fd >= 0) {
+        r->watch = inotify_add_watch(catalog->notify_fd, r->path, CATALOG_ROOT_EVENTS);
+    }
+#endif
+
+    DIR* dir = opendir(r->path);
+    if (!dir) return;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        refresh_entry(catalog, root, entry->d_name);
+    }
+    closedir(dir);
+}
+
+#ifdef __linux__
+/* Helper: Apply one inotify event */
+static void apply_event(template_catalog_t* catalog, const struct inotify_event* ev) {
+    for (int r = 0; r < catalog->root_count; r++) {
+        if (catalog->roots[r].watch != ev->wd) continue;
+
+        if (ev->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+            inotify_rm_watch(catalog->notify_fd, ev->wd);
+            catalog->roots[r].watch = -1;
+            rescan_root(catalog, r);
+        } else if (ev->len > 0) {
+            refresh_entry(catalog, r, ev->name);
+        }
+        return;
+    }
+
+    for (int i = 0; i < catalog->entry_count; i++) {
+        catalog_entry_t* entry = &catalog->entries[i];
+        if (entry->watch != ev->wd) continue;
+
+        if (ev->mask & IN_IGNORED) {
+            entry->watch = -1;  /* Directory gone; its root reports the removal */
+        } else {
+            char name[TEMPLATE_NAME_MAX];
+            snprintf(name, sizeof(name), "%s", entry->item.name);
+            refresh_entry(catalog, entry->root, name);
+        }
+        return;
+    }
+}
+#endif
+
+/* Helper: Bring the catalog up to date (lock held) */
+static void sync_catalog(template_catalog_t* catalog) {
+#ifdef __linux__
+    if (catalog->notify_fd >= 0) {
+        _Alignas(struct inotify_event) char buffer[ARGO_BUFFER_STANDARD];
+        ssize_t len;
+        while ((len = read(catalog->notify_fd, buffer, sizeof(buffer))) > 0) {
+            for (char* p = buffer; p < buffer + len; ) {
+                const struct inotify_event* ev = (const struct inotify_event*)p;
+                if (ev->mask & IN_Q_OVERFLOW) {
+                    for (int r = 0; r < catalog->root_count; r++) {
+                        rescan_root(catalog, r);
+                    }
+                } else {
+                    apply_event(catalog, ev);
+                }
+                p += sizeof(struct inotify_event) + ev->len;
+            }
+        }
+    }
+#endif
+
+    /* Unwatched roots (missing, or no inotify): one stat each */
+    for (int r = 0; r < catalog->root_count; r++) {
+        catalog_root_t* root = &catalog->roots[r];
+        if (root->watch >= 0) continue;
+
+        struct stat st;
+        bool present = (stat(root->path, &st) == 0 && S_ISDIR(st.st_mode));
+        if (present != root->present || (present && (st.st_mtime != root->mtime || st.st_nlink != root->nlink))) {
+            rescan_root(catalog, r);
+        }
+    }
+
+    if (!catalog->index_stale) return;
+
+    /* Rebuild name index: size >= 2x entries keeps probes short */
+    size_t size = TEMPLATE_CATALOG_MIN_INDEX_SIZE;
+    while (size < (size_t)catalog->entry_count * 2) size *= 2;
+    if (size != catalog->index_size) {
+        int* index = malloc(size * sizeof(int));
+        if (!index) {
+            argo_report_error(E_SYSTEM_MEMORY, "template_catalog", ERR_MSG_MEMORY_ALLOC_FAILED);
+            return;
+        }
+        free(catalog->index);
+        catalog->index = index;
+        catalog->index_size = size;
+    }
+    memset(catalog->index, -1, size * sizeof(int));
+
+    /* Earlier roots shadow later ones */
+    for (int r = 0; r < catalog->root_count; r++) {
+        for (int i = 0; i < catalog->entry_count; i++) {
+            const catalog_entry_t* entry = &catalog->entries[i];
+            if (entry->root != r || !entry->valid) continue;
+
+            size_t slot = hash_name(entry->item.name) & (size - 1);
+            while (catalog->index[slot] >= 0 &&
+                   strcmp(catalog->entries[catalog->index[slot]].item.name, entry->item.name) != 0) {
+                slot = (slot + 1) & (size - 1);
+            }
+            if (catalog->index[slot] < 0) {
+                catalog->index[slot] = i;
+            }
+        }
+    }
+    catalog->index_stale = false;
+}
+
+/* Create empty catalog */
+template_catalog_t* template_catalog_create(void) {
+    template_catalog_t* catalog = calloc(1, sizeof(template_catalog_t));
+    if (!catalog) {
+        argo_report_error(E_SYSTEM_MEMORY, "template_catalog_create", ERR_MSG_MEMORY_ALLOC_FAILED);
+        return NULL;
+    }
+
+    pthread_mutex_init(&catalog->lock, NULL);
+    catalog->notify_fd = -1;
+#ifdef __linux__
+    catalog->notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (catalog->notify_fd < 0) {
+        LOG_WARN("inotify unavailable (%s), template catalog checks roots on lookup",
+                 strerror(errno));
+    }
+#endif
+    return catalog;
+}
+
+/* Add a template root and load its templates */
+int template_catalog_add_root(template_catalog_t* catalog, const char* path, const char* source) {
+    ARGO_CHECK_NULL(catalog);
+    ARGO_CHECK_NULL(path);
+    ARGO_CHECK_NULL(source);
+
+    pthread_mutex_lock(&catalog->lock);
+    if (catalog->root_count >= TEMPLATE_CATALOG_MAX_ROOTS) {
+        pthread_mutex_unlock(&catalog->lock);
+        argo_report_error(E_RESOURCE_LIMIT, "template_catalog_add_root", "too many roots");
+        return E_RESOURCE_LIMIT;
+    }
+
+    int r = catalog->root_count++;
+    catalog_root_t* root = &catalog->roots[r];
+    /* Absolute path so template paths stay valid for any working directory */
+    if (!realpath(path, root->path)) {
+        snprintf(root->path, sizeof(root->path), "%s", path);
+    }
+    snprintf(root->source, sizeof(root->source), "%s", source);
+    root->watch = -1;
+
+    rescan_root(catalog, r);
+    sync_catalog(catalog);
+    LOG_DEBUG("Template root %s (%s) loaded", root->path, source);
+    pthread_mutex_unlock(&catalog->lock);
+    return ARGO_SUCCESS;
+}
+
+/* Add the standard roots */
+int template_catalog_add_default_roots(template_catalog_t* catalog) {
+    ARGO_CHECK_NULL(catalog);
+
+    const char* home = getenv("HOME");
+    if (home) {
+        char user_dir[ARGO_PATH_MAX];
+        snprintf(user_dir, sizeof(user_dir), "%s/%s", home, TEMPLATE_CATALOG_USER_DIR);
+        int result = template_catalog_add_root(catalog, user_dir, TEMPLATE_CATALOG_SOURCE_USER);
+        if (result != ARGO_SUCCESS) return result;
+    }
+    return template_catalog_add_root(catalog, TEMPLATE_CATALOG_SYSTEM_DIR,
+                                     TEMPLATE_CATALOG_SOURCE_SYSTEM);
+}
+
+/* Find template by name */
+int template_catalog_find(template_catalog_t* catalog, const char* name,
+                          template_catalog_item_t* item) {
+    ARGO_CHECK_NULL(catalog);
+    ARGO_CHECK_NULL(name);
+    ARGO_CHECK_NULL(item);
+
+    pthread_mutex_lock(&catalog->lock);
+    sync_catalog(catalog);
+
+    int result = E_WORKFLOW_NOT_FOUND;
+    if (catalog->index) {
+        size_t slot = hash_name(name) & (catalog->index_size - 1);
+        while (catalog->index[slot] >= 0) {
+            const catalog_entry_t* entry = &catalog->entries[catalog->index[slot]];
+            if (strcmp(entry->item.name, name) == 0) {
+                *item = entry->item;
+                result = ARGO_SUCCESS;
+                break;
+            }
+            slot = (slot + 1) & (catalog->index_size - 1);
+        }
+    }
+    pthread_mutex_unlock(&catalog->lock);
+    return result;
+}
+
+/* Helper: qsort comparator - root order, then name */
+static int compare_entries(const void* a, const void* b) {
+    const catalog_entry_t* ea = *(const catalog_entry_t* const*)a;
+    const catalog_entry_t* eb = *(const catalog_entry_t* const*)b;
+    if (ea->root != eb->root) return ea->root - eb->root;
+    return strcmp(ea->item.name, eb->item.name);
+}
+
+/* List all templates */
+int template_catalog_list(template_catalog_t* catalog, template_catalog_item_t** items, int* count) {
+    ARGO_CHECK_NULL(catalog);
+    ARGO_CHECK_NULL(items);
+    ARGO_CHECK_NULL(count);
+
+    *items = NULL;
+    *count = 0;
+
+    int result = ARGO_SUCCESS;
+    const catalog_entry_t** sorted = NULL;
+
+    pthread_mutex_lock(&catalog->lock);
+    sync_catalog(catalog);
+
+    int valid = 0;
+    for (int i = 0; i < catalog->entry_count; i++) {
+        if (catalog->entries[i].valid) valid++;
+    }
+    if (valid == 0) goto cleanup;
+
+    sorted = malloc(valid * sizeof(*sorted));
+    *items = malloc(valid * sizeof(template_catalog_item_t));
+    if (!sorted || !*items) {
+        free(*items);
+        *items = NULL;
+        argo_report_error(E_SYSTEM_MEMORY, "template_catalog_list", ERR_MSG_MEMORY_ALLOC_FAILED);
+        result = E_SYSTEM_MEMORY;
+        goto cleanup;
+    }
+
+    int n = 0;
+    for (int i = 0; i < catalog->entry_count; i++) {
+        if (catalog->entries[i].valid) sorted[n++] = &catalog->entries[i];
+    }
+    qsort(sorted, n, sizeof(*sorted), compare_entries);
+    for (int i = 0; i < n; i++) {
+        (*items)[i] = sorted[i]->item;
+    }
+    *count = n;
+
+cleanup:
+    pthread_mutex_unlock(&catalog->lock);
+    free(sorted);
+    return result;
+}
+
+/* Destroy catalog */
+void template_catalog_destroy(template_catalog_t* catalog) {
+    if (!catalog) return;
+
+    if (catalog->notify_fd >= 0) {
+        close(catalog->notify_fd);  /* Drops every watch */
+    }
+    pthread_mutex_destroy(&catalog->lock);
+    free(catalog->entries);
+    free(catalog->index);
+    free(catalog);
+}
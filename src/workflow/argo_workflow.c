@@ -16,10 +16,21 @@
 
 /* Project includes */
 #include "argo_workflow.h"
+#include "argo_process_waiter.h"
+#include "argo_time.h"
 #include "argo_error.h"
 #include "argo_log.h"
 #include "argo_limits.h"
 
+/* Helper: Exit code from a waitpid() status */
+static int exit_code_from_status(int status) {
+    if (WIFEXITED(status)) {
+        return WEXITSTATUS(status);
+    }
+    /* Abnormal termination (signal, etc.) */
+    return 1;
+}
+
 /* Wait for child process with timeout enforcement */
 process_wait_result_t process_wait_with_timeout(pid_t pid, int timeout_seconds, int timeout_exit_code) {
     process_wait_result_t result = {
@@ -28,62 +39,43 @@ process_wait_result_t process_wait_with_timeout(pid_t pid, int timeout_seconds,
         .wait_failed = false
     };
 
-    time_t start_time = time(NULL);
-    int status = 0;
-
-    while (1) {
-        pid_t wait_result = waitpid(pid, &status, WNOHANG);
-
-        if (wait_result == pid) {
-            /* Child exited normally */
-            if (WIFEXITED(status)) {
-                result.exit_code = WEXITSTATUS(status);
-            } else {
-                /* Abnormal termination (signal, etc.) */
-                result.exit_code = 1;
-            }
-            break;
-        } else if (wait_result < 0) {
-            /* Wait failed */
-            if (errno == EINTR) {
-                continue;  /* Interrupted by signal, retry */
-            }
-            /* Real error */
-            argo_report_error(E_SYSTEM_PROCESS, "process_wait_with_timeout",
-                             "waitpid failed: %s", strerror(errno));
-            result.exit_code = -1;
-            result.wait_failed = true;
-            break;
-        }
-
-        /* Check timeout */
-        if (timeout_seconds > 0) {
-            time_t elapsed = time(NULL) - start_time;
-            if (elapsed >= timeout_seconds) {
-                /* Timeout reached - terminate process */
-                LOG_WARN("Process timed out after %d seconds, killing PID %d",
-                        timeout_seconds, (int)pid);
-
-                /* Try graceful termination first */
-                kill(pid, SIGTERM);
-                sleep(1);
-
-                /* Force kill if still running */
-                kill(pid, SIGKILL);
+    process_waiter_t* waiter = process_waiter_create();
+    if (!waiter || process_waiter_add(waiter, pid) != ARGO_SUCCESS) {
+        process_waiter_destroy(waiter);
+        result.exit_code = -1;
+        result.wait_failed = true;
+        return result;
+    }
 
-                /* Wait for process to die */
-                waitpid(pid, &status, 0);
+    int timeout_ms = (timeout_seconds > 0) ? timeout_seconds * MILLISECONDS_PER_SECOND : -1;
+    pid_t exited = 0;
+    int status = 0;
 
-                result.exit_code = timeout_exit_code;
-                result.timed_out = true;
-                break;
-            }
+    int wait_result = process_waiter_wait(waiter, timeout_ms, &exited, &status);
+    if (wait_result == E_TIMEOUT) {
+        /* Timeout reached - terminate gracefully, force only if ignored */
+        LOG_WARN("Process timed out after %d seconds, killing PID %d",
+                timeout_seconds, (int)pid);
+        kill(pid, SIGTERM);
+
+        wait_result = process_waiter_wait(waiter, WORKFLOW_KILL_GRACE_MS, &exited, &status);
+        if (wait_result == E_TIMEOUT) {
+            kill(pid, SIGKILL);
+            wait_result = process_waiter_wait(waiter, -1, &exited, &status);
         }
+        result.timed_out = true;
+    }
 
-        /* Sleep briefly before next check */
-        usleep(WORKFLOW_POLL_INTERVAL_USEC);
+    if (result.timed_out) {
+        result.exit_code = timeout_exit_code;
+    } else if (wait_result == ARGO_SUCCESS) {
+        result.exit_code = exit_code_from_status(status);
+    } else {
+        result.exit_code = -1;
+        result.wait_failed = true;
     }
 
+    process_waiter_destroy(waiter);
     return result;
 }
 
@@ -243,6 +235,181 @@ cleanup:
     return result;
 }
 
+/* Batch slot - one launched workflow */
+typedef struct {
+    workflow_t* workflow;
+    pid_t pid;
+    long long deadline_ms;      /* SIGTERM due (0 = no timeout) */
+    long long kill_at_ms;       /* SIGKILL due (0 = none pending) */
+    bool timed_out;
+} batch_slot_t;
+
+/* Helper: Fork one workflow of a batch and watch it */
+static int batch_launch(workflow_t* workflow, process_waiter_t* waiter, batch_slot_t* slot) {
+    if (workflow->script_path[0] == '\0') {
+        argo_report_error(E_INPUT_FORMAT, "workflow_execute_many",
+                         "No script path specified");
+        workflow->state = WORKFLOW_STATE_FAILED;
+        return E_INPUT_FORMAT;
+    }
+
+    workflow->state = WORKFLOW_STATE_RUNNING;
+    workflow->start_time = time(NULL);
+    LOG_INFO("Starting workflow '%s' (ID: %s, script: %s)",
+            workflow->workflow_name, workflow->workflow_id, workflow->script_path);
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        argo_report_error(E_SYSTEM_FORK, "workflow_execute_many", "fork failed");
+        workflow->state = WORKFLOW_STATE_FAILED;
+        return E_SYSTEM_FORK;
+    }
+    if (pid == 0) {
+        execute_child_process(workflow, -1);
+        /* Not reached */
+    }
+
+    workflow->executor_pid = pid;
+    *slot = (batch_slot_t){ .workflow = workflow, .pid = pid };
+    if (workflow->timeout_seconds > 0) {
+        slot->deadline_ms = argo_monotonic_ms() +
+                            (long long)workflow->timeout_seconds * MILLISECONDS_PER_SECOND;
+    }
+
+    int result = process_waiter_add(waiter, pid);
+    if (result != ARGO_SUCCESS) {
+        /* Cannot supervise it - do not leave it running unsupervised */
+        kill(pid, SIGKILL);
+        waitpid(pid, NULL, 0);
+        workflow->state = WORKFLOW_STATE_FAILED;
+    }
+    return result;
+}
+
+/* Helper: Milliseconds until the next deadline or kill timer (-1 = none) */
+static int batch_next_timer_ms(const batch_slot_t* slots, int count, long long now) {
+    long long next = -1;
+    for (int i = 0; i < count; i++) {
+        long long due = slots[i].kill_at_ms ? slots[i].kill_at_ms : slots[i].deadline_ms;
+        if (due && (next < 0 || due < next)) {
+            next = due;
+        }
+    }
+    if (next < 0) return -1;
+    return (next > now) ? (int)(next - now) : 0;
+}
+
+/* Helper: Send SIGTERM past deadline, SIGKILL past the grace period */
+static void batch_fire_timers(batch_slot_t* slots, int count, long long now) {
+    for (int i = 0; i < count; i++) {
+        batch_slot_t* slot = &slots[i];
+        if (slot->kill_at_ms && now >= slot->kill_at_ms) {
+            LOG_WARN("Workflow '%s' ignored SIGTERM, killing PID %d",
+                    slot->workflow->workflow_name, (int)slot->pid);
+            kill(slot->pid, SIGKILL);
+            slot->kill_at_ms = 0;
+        } else if (slot->deadline_ms && now >= slot->deadline_ms) {
+            LOG_WARN("Workflow '%s' timed out after %d seconds, terminating PID %d",
+                    slot->workflow->workflow_name, slot->workflow->timeout_seconds, (int)slot->pid);
+            kill(slot->pid, SIGTERM);
+            slot->deadline_ms = 0;
+            slot->kill_at_ms = now + WORKFLOW_KILL_GRACE_MS;
+            slot->timed_out = true;
+        }
+    }
+}
+
+/* Helper: Record a reaped workflow and free its slot */
+static int batch_finish(batch_slot_t* slots, int* count, int index, int status, bool wait_failed) {
+    batch_slot_t* slot = &slots[index];
+    process_wait_result_t wait_result = {
+        .exit_code = slot->timed_out ? WORKFLOW_TIMEOUT_EXIT_CODE : exit_code_from_status(status),
+        .timed_out = slot->timed_out,
+        .wait_failed = wait_failed
+    };
+    if (wait_failed) {
+        wait_result.exit_code = -1;
+    }
+
+    int result = handle_execution_results(slot->workflow, wait_result, -1);
+    slots[index] = slots[--(*count)];
+    return result;
+}
+
+/* Execute many workflows concurrently from one thread */
+int workflow_execute_many(workflow_t** workflows, int count, int max_parallel) {
+    ARGO_CHECK_NULL(workflows);
+    if (count <= 0) {
+        return ARGO_SUCCESS;
+    }
+    if (max_parallel <= 0) max_parallel = WORKFLOW_BATCH_DEFAULT_PARALLEL;
+    if (max_parallel > PROCESS_WAITER_MAX_PROCS) max_parallel = PROCESS_WAITER_MAX_PROCS;
+
+    int result = ARGO_SUCCESS;
+    batch_slot_t* slots = calloc(max_parallel, sizeof(batch_slot_t));
+    process_waiter_t* waiter = process_waiter_create();
+    if (!slots || !waiter) {
+        free(slots);
+        process_waiter_destroy(waiter);
+        return E_SYSTEM_MEMORY;
+    }
+
+    int next = 0;
+    int running = 0;
+    while (next < count || running > 0) {
+        /* Fill free slots */
+        while (running < max_parallel && next < count) {
+            workflow_t* workflow = workflows[next++];
+            if (!workflow) continue;
+
+            int launched = batch_launch(workflow, waiter, &slots[running]);
+            if (launched == ARGO_SUCCESS) {
+                running++;
+            } else if (result == ARGO_SUCCESS) {
+                result = launched;
+            }
+        }
+        if (running == 0) continue;
+
+        /* Sleep until an exit or the nearest timer - never on a fixed tick */
+        pid_t exited = 0;
+        int status = 0;
+        int timeout_ms = batch_next_timer_ms(slots, running, argo_monotonic_ms());
+        int wait_result = process_waiter_wait(waiter, timeout_ms, &exited, &status);
+
+        if (wait_result == E_TIMEOUT) {
+            batch_fire_timers(slots, running, argo_monotonic_ms());
+            continue;
+        }
+
+        int index = -1;
+        for (int i = 0; i < running && exited > 0; i++) {
+            if (slots[i].pid == exited) index = i;
+        }
+        if (index < 0) {
+            /* Waiter failed outright - stop everything rather than orphan it */
+            for (int i = 0; i < running; i++) {
+                kill(slots[i].pid, SIGKILL);
+                waitpid(slots[i].pid, NULL, 0);
+            }
+            while (running > 0) {
+                batch_finish(slots, &running, 0, 0, true);
+            }
+            if (result == ARGO_SUCCESS) result = E_SYSTEM_PROCESS;
+            continue;
+        }
+
+        int finished = batch_finish(slots, &running, index, status, wait_result != ARGO_SUCCESS);
+        if (finished != ARGO_SUCCESS && result == ARGO_SUCCESS) {
+            result = finished;
+        }
+    }
+
+    process_waiter_destroy(waiter);
+    free(slots);
+    return result;
+}
+
 /* Convert workflow state to string */
 const char* workflow_state_to_string(workflow_state_t state) {
     switch (state) {
@@ -0,0 +1,425 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Provider benchmark - the full query path against the local mock LLM server
+ *
+ * Starts bin/tests/mock_llm_server, points every provider at it
+ * (ARGO_<PROVIDER>_URL, OLLAMA_HOST) and measures two paths:
+ *   query  - api_ci_query -> provider pool -> provider -> HTTP, as the
+ *            daemon serves POST /api/ci/query (whole answers)
+ *   stream - provider->stream -> HTTP, time to first token per request
+ * and reports throughput with p50/p99 time to first token and latency.
+ * Options not listed below are passed to the mock server.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+/* Project includes */
+#include "argo_daemon.h"
+#include "argo_daemon_api.h"
+#include "argo_daemon_ci_api.h"
+#include "argo_http_server.h"
+#include "argo_ci.h"
+#include "argo_ollama.h"
+#include "argo_ollama_transport.h"
+#include "argo_env_utils.h"
+#include "argo_provider_telemetry.h"
+#include "argo_error.h"
+
+#define BENCH_DEFAULT_REQUESTS 200
+#define BENCH_DEFAULT_CONCURRENCY 8
+#define BENCH_MOCK_PORT 9880
+#define BENCH_DAEMON_PORT 9881        /* Never listened on - api_ci_query is called directly */
+#define BENCH_MOCK_BINARY "bin/tests/mock_llm_server"
+#define BENCH_READY_TIMEOUT_MS 5000
+#define BENCH_READY_POLL_MS 20
+#define BENCH_MOCK_ARGS_MAX 64
+#define BENCH_BODY_SIZE 256
+#define BENCH_URL_SIZE 128
+
+/* Benchmarked paths */
+typedef enum {
+    BENCH_PATH_QUERY,
+    BENCH_PATH_STREAM
+} bench_path_t;
+
+/* Provider under test */
+typedef struct {
+    const char* provider;
+    const char* endpoint_env;       /* Endpoint override */
+    const char* endpoint_path;      /* On the mock; NULL for host:port */
+    bool via_daemon;                /* Created by api_ci_create_provider */
+} bench_target_t;
+
+static const bench_target_t g_targets[] = {
+    { "claude_api", "ARGO_CLAUDE_API_URL", "/v1/messages", true },
+    { "openai_api", "ARGO_OPENAI_API_URL", "/v1/chat/completions", true },
+    { "gemini_api", "ARGO_GEMINI_API_URL", "/v1beta/models", true },
+    { "ollama", OLLAMA_HOST_ENV, NULL, false }
+};
+#define BENCH_TARGET_COUNT (sizeof(g_targets) / sizeof(g_targets[0]))
+
+/* One measured run */
+typedef struct {
+    const bench_target_t* target;
+    bench_path_t path;
+    int requests;
+    pthread_mutex_t lock;
+    int next;                       /* Next request number */
+    int succeeded;
+    int failed;
+    unsigned long long tokens;      /* Streamed deltas */
+    double* latency_ms;             /* Successful requests */
+    double* ttft_ms;
+} bench_run_t;
+
+/* Per-request stream state */
+typedef struct {
+    struct timespec started;
+    double ttft_ms;
+    unsigned long long tokens;
+} bench_stream_t;
+
+/* Helper: Milliseconds since start */
+static double elapsed_ms(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) * 1000.0 + (double)(now.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+/* Helper: Claim the next request number, or -1 when done */
+static int claim_request(bench_run_t* run) {
+    pthread_mutex_lock(&run->lock);
+    int request = run->next < run->requests ? run->next++ : -1;
+    pthread_mutex_unlock(&run->lock);
+    return request;
+}
+
+/* Helper: Record one outcome */
+static void record(bench_run_t* run, bool ok, double latency_ms, double ttft_ms, unsigned long long tokens) {
+    pthread_mutex_lock(&run->lock);
+    if (ok) {
+        run->latency_ms[run->succeeded] = latency_ms;
+        run->ttft_ms[run->succeeded] = ttft_ms;
+        run->succeeded++;
+        run->tokens += tokens;
+    } else {
+        run->failed++;
+    }
+    pthread_mutex_unlock(&run->lock);
+}
+
+/* Helper: One POST /api/ci/query, called as the daemon's router would */
+static void query_once(bench_run_t* run, int request) {
+    char body[BENCH_BODY_SIZE];
+    http_request_t req = {0};
+    http_response_t resp = {0};
+
+    /* Distinct text per request so single-flight never coalesces */
+    int length = snprintf(body, sizeof(body), "{\"query\":\"bench %s request %d\",\"provider\":\"%s\"}",
+                          run->target->provider, request, run->target->provider);
+    req.method = HTTP_METHOD_POST;
+    snprintf(req.path, sizeof(req.path), "/api/ci/query");
+    req.body = body;
+    req.body_length = (size_t)length;
+
+    struct timespec started;
+    clock_gettime(CLOCK_MONOTONIC, &started);
+    int result = api_ci_query(&req, &resp);
+    double latency = elapsed_ms(&started);
+    record(run, result == ARGO_SUCCESS && resp.status_code == HTTP_STATUS_OK, latency, latency, 0);
+    free(resp.body);
+}
+
+/* Helper: Stream delta - first one stamps time to first token */
+static void on_delta(const char* chunk, size_t len, void* userdata) {
+    (void)chunk;
+    (void)len;
+    bench_stream_t* stream = (bench_stream_t*)userdata;
+    if (stream->tokens++ == 0) {
+        stream->ttft_ms = elapsed_ms(&stream->started);
+    }
+}
+
+/* Helper: Provider for the stream path, initialized and connected */
+static ci_provider_t* create_provider(const bench_target_t* target) {
+    ci_provider_t* provider = target->via_daemon ? api_ci_create_provider(target->provider, NULL)
+                                                 : ollama_create_provider(NULL);
+    if (!provider) return NULL;
+    if ((provider->init && provider->init(provider) != ARGO_SUCCESS) ||
+        (provider->connect && provider->connect(provider) != ARGO_SUCCESS)) {
+        provider->cleanup(provider);
+        return NULL;
+    }
+    return provider;
+}
+
+/* Worker thread */
+static void* bench_worker(void* arg) {
+    bench_run_t* run = (bench_run_t*)arg;
+    ci_provider_t* provider = NULL;
+
+    if (run->path == BENCH_PATH_STREAM) {
+        provider = create_provider(run->target);
+        if (!provider) {
+            for (int request = claim_request(run); request >= 0; request = claim_request(run)) {
+                record(run, false, 0.0, 0.0, 0);
+            }
+            return NULL;
+        }
+    }
+
+    for (int request = claim_request(run); request >= 0; request = claim_request(run)) {
+        if (run->path == BENCH_PATH_QUERY) {
+            query_once(run, request);
+            continue;
+        }
+
+        char prompt[BENCH_BODY_SIZE];
+        snprintf(prompt, sizeof(prompt), "bench %s stream %d", run->target->provider, request);
+        bench_stream_t stream = {0};
+        clock_gettime(CLOCK_MONOTONIC, &stream.started);
+        int result = provider->stream(provider, prompt, on_delta, &stream);
+        double latency = elapsed_ms(&stream.started);
+        record(run, result == ARGO_SUCCESS && stream.tokens > 0, latency, stream.ttft_ms, stream.tokens);
+    }
+
+    if (provider) provider->cleanup(provider);
+    return NULL;
+}
+
+/* Helper: Ascending order */
+static int compare_ms(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* Helper: Nearest-rank percentile of sorted values */
+static double percentile(const double* sorted, int count, double pct) {
+    if (count == 0) return 0.0;
+    int rank = (int)(pct / 100.0 * count + 0.999999);
+    if (rank < 1) rank = 1;
+    return sorted[rank - 1];
+}
+
+/* Helper: Run one target on one path and print its row */
+static int bench_run(const bench_target_t* target, bench_path_t path, int requests, int concurrency) {
+    bench_run_t run = {
+        .target = target,
+        .path = path,
+        .requests = requests,
+        .latency_ms = calloc((size_t)requests, sizeof(double)),
+        .ttft_ms = calloc((size_t)requests, sizeof(double))
+    };
+    pthread_t* threads = calloc((size_t)concurrency, sizeof(pthread_t));
+    if (!run.latency_ms || !run.ttft_ms || !threads) {
+        free(run.latency_ms);
+        free(run.ttft_ms);
+        free(threads);
+        return E_SYSTEM_MEMORY;
+    }
+    pthread_mutex_init(&run.lock, NULL);
+
+    struct timespec started;
+    clock_gettime(CLOCK_MONOTONIC, &started);
+    int workers = 0;
+    while (workers < concurrency && pthread_create(&threads[workers], NULL, bench_worker, &run) == 0) {
+        workers++;
+    }
+    for (int i = 0; i < workers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double wall_s = elapsed_ms(&started) / 1000.0;
+
+    qsort(run.latency_ms, (size_t)run.succeeded, sizeof(double), compare_ms);
+    qsort(run.ttft_ms, (size_t)run.succeeded, sizeof(double), compare_ms);
+    char rate[32] = "        -";
+    char ttft[64] = "       -        -";
+    if (path == BENCH_PATH_STREAM) {
+        snprintf(rate, sizeof(rate), "%9.0f", wall_s > 0.0 ? (double)run.tokens / wall_s : 0.0);
+        snprintf(ttft, sizeof(ttft), "%8.2f %8.2f", percentile(run.ttft_ms, run.succeeded, 50.0),
+                 percentile(run.ttft_ms, run.succeeded, 99.0));
+    }
+    printf("%-12s %-6s %6d %6d %9.1f %s %s %8.2f %8.2f\n",
+           target->provider, path == BENCH_PATH_QUERY ? "query" : "stream",
+           run.succeeded, run.failed, wall_s > 0.0 ? run.succeeded / wall_s : 0.0,
+           rate, ttft,
+           percentile(run.latency_ms, run.succeeded, 50.0), percentile(run.latency_ms, run.succeeded, 99.0));
+    fflush(stdout);
+
+    int result = workers == concurrency && run.succeeded > 0 ? ARGO_SUCCESS : E_PROTOCOL_HTTP;
+    pthread_mutex_destroy(&run.lock);
+    free(run.latency_ms);
+    free(run.ttft_ms);
+    free(threads);
+    return result;
+}
+
+/* Helper: Wait until the mock accepts connections (or has exited) */
+static bool wait_for_mock(pid_t pid, int port) {
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons((uint16_t)port),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK)
+    };
+    for (int waited = 0; waited < BENCH_READY_TIMEOUT_MS; waited += BENCH_READY_POLL_MS) {
+        if (waitpid(pid, NULL, WNOHANG) == pid) return false;
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        bool ready = fd >= 0 && connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == 0;
+        if (fd >= 0) close(fd);
+        if (ready) return true;
+        usleep(BENCH_READY_POLL_MS * 1000);
+    }
+    return false;
+}
+
+/* Helper: Start the mock server with the pass-through options */
+static pid_t start_mock(const char* binary, int port, char** mock_args, int mock_arg_count) {
+    char port_text[16];
+    snprintf(port_text, sizeof(port_text), "%d", port);
+    char* argv[BENCH_MOCK_ARGS_MAX + 4];
+    int argc = 0;
+    argv[argc++] = (char*)binary;
+    argv[argc++] = "--port";
+    argv[argc++] = port_text;
+    for (int i = 0; i < mock_arg_count; i++) argv[argc++] = mock_args[i];
+    argv[argc] = NULL;
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        execv(binary, argv);
+        fprintf(stderr, "bench_providers: cannot run %s: %s\n", binary, strerror(errno));
+        _exit(127);
+    }
+    return pid;
+}
+
+/* Helper: Point every provider at the mock */
+static void point_providers_at(int port) {
+    char value[BENCH_URL_SIZE];
+    for (size_t i = 0; i < BENCH_TARGET_COUNT; i++) {
+        if (g_targets[i].endpoint_path) {
+            snprintf(value, sizeof(value), "http://127.0.0.1:%d%s", port, g_targets[i].endpoint_path);
+        } else {
+            snprintf(value, sizeof(value), "127.0.0.1:%d", port);
+        }
+        argo_setenv(g_targets[i].endpoint_env, value);
+    }
+}
+
+/* Helper: What providers recorded about the same calls (GET /api/providers/stats) */
+static void print_telemetry(void) {
+    provider_telemetry_stats_t stats[PROVIDER_TELEMETRY_MAX_ENTRIES];
+    int count = provider_telemetry_get_stats(stats, PROVIDER_TELEMETRY_MAX_ENTRIES);
+
+    printf("Provider telemetry\n");
+    printf("%-12s %7s %6s %10s %10s %8s %8s %8s %8s\n",
+           "provider", "calls", "failed", "prompt", "completion", "queue", "ttfb", "p50", "p95");
+    for (int i = 0; i < count; i++) {
+        const provider_telemetry_stats_t* s = &stats[i];
+        unsigned long long calls = s->calls ? s->calls : 1;
+        printf("%-12s %7llu %6llu %10llu %10llu %8llu %8llu %8lld %8lld\n",
+               s->provider, s->calls, s->failures, s->prompt_tokens, s->completion_tokens,
+               s->queue_ms / calls, s->ttfb_samples ? s->ttfb_ms / s->ttfb_samples : 0,
+               provider_telemetry_percentile(s, 50.0), provider_telemetry_percentile(s, 95.0));
+    }
+    printf("(tokens as reported by the server; times in ms, percentiles are histogram bounds)\n\n");
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [--requests N] [--concurrency N] [--port N] [--mock PATH] [mock options]\n"
+            "  --requests N       Requests per provider and path (default %d)\n"
+            "  --concurrency N    Client threads (default %d)\n"
+            "  --port N           Mock server port (default %d)\n"
+            "  --mock PATH        Mock server binary (default %s)\n"
+            "  Mock options: --latency-ms, --jitter-ms, --dist, --tokens, --tokens-per-sec,\n"
+            "                --error-429, --error-500, --retry-after-ms, --seed\n",
+            program, BENCH_DEFAULT_REQUESTS, BENCH_DEFAULT_CONCURRENCY, BENCH_MOCK_PORT, BENCH_MOCK_BINARY);
+}
+
+int main(int argc, char** argv) {
+    int requests = BENCH_DEFAULT_REQUESTS;
+    int concurrency = BENCH_DEFAULT_CONCURRENCY;
+    int port = BENCH_MOCK_PORT;
+    const char* binary = BENCH_MOCK_BINARY;
+    char* mock_args[BENCH_MOCK_ARGS_MAX];
+    int mock_arg_count = 0;
+
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 2;
+        }
+        if (strcmp(argv[i], "--requests") == 0) requests = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--concurrency") == 0) concurrency = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--port") == 0) port = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--mock") == 0) binary = argv[i + 1];
+        else if (mock_arg_count + 2 <= BENCH_MOCK_ARGS_MAX) {
+            mock_args[mock_arg_count++] = argv[i];
+            mock_args[mock_arg_count++] = argv[i + 1];
+        }
+    }
+    if (requests <= 0 || concurrency <= 0 || port <= 0 || port > 65535) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    pid_t mock = start_mock(binary, port, mock_args, mock_arg_count);
+    if (mock < 0 || !wait_for_mock(mock, port)) {
+        fprintf(stderr, "bench_providers: mock server did not start on port %d\n", port);
+        if (mock > 0) kill(mock, SIGTERM);
+        return 1;
+    }
+    point_providers_at(port);
+
+    argo_daemon_t* daemon = argo_daemon_create(BENCH_DAEMON_PORT);
+    if (!daemon) {
+        fprintf(stderr, "bench_providers: daemon creation failed\n");
+        kill(mock, SIGTERM);
+        waitpid(mock, NULL, 0);
+        return 1;
+    }
+    g_api_daemon = daemon;
+
+    printf("\n==========================================\n");
+    printf("Provider Benchmark (%d requests, %d clients, mock on port %d)\n", requests, concurrency, port);
+    printf("==========================================\n");
+    printf("%-12s %-6s %6s %6s %9s %9s %8s %8s %8s %8s\n",
+           "provider", "path", "ok", "failed", "req/s", "tok/s", "ttft50", "ttft99", "lat50", "lat99");
+
+    int failures = 0;
+    for (size_t i = 0; i < BENCH_TARGET_COUNT; i++) {
+        if (g_targets[i].via_daemon &&
+            bench_run(&g_targets[i], BENCH_PATH_QUERY, requests, concurrency) != ARGO_SUCCESS) {
+            failures++;
+        }
+        if (bench_run(&g_targets[i], BENCH_PATH_STREAM, requests, concurrency) != ARGO_SUCCESS) {
+            failures++;
+        }
+    }
+    printf("(times in ms; query answers arrive whole, so only streams report tok/s and ttft)\n\n");
+    print_telemetry();
+
+    argo_daemon_destroy(daemon);
+    g_api_daemon = NULL;
+    kill(mock, SIGTERM);
+    waitpid(mock, NULL, 0);
+    return failures == 0 ? 0 : 1;
+}
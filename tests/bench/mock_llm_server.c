@@ -0,0 +1,585 @@
+/* © 2025 Casey Koons All rights reserved */
+/* Mock LLM server - OpenAI, Anthropic, Gemini and Ollama wire formats for offline benchmarks
+ *
+ * Answers every request with generated text after a sampled latency,
+ * streaming it at a token rate when the request asks to stream, and
+ * injects 429/500 responses at configured rates. Keep-alive HTTP/1.1;
+ * streams are chunked. One thread per connection.
+ *
+ * Routes (POST):
+ *   .../chat/completions                    OpenAI (SSE when "stream":true)
+ *   .../messages                            Anthropic (SSE when "stream":true)
+ *   .../<model>:generateContent             Gemini
+ *   .../<model>:streamGenerateContent       Gemini SSE
+ *   /api/generate                           Ollama (NDJSON unless "stream":false)
+ * GET /health answers 200 once listening.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+/* Project includes */
+#include "argo_http_server.h"
+
+#define MOCK_DEFAULT_PORT 9880
+#define MOCK_DEFAULT_TOKENS 64
+#define MOCK_DEFAULT_RETRY_AFTER_MS 50
+#define MOCK_HEADER_MAX (64 * 1024)
+#define MOCK_BODY_MAX (64 * 1024 * 1024)
+#define MOCK_READ_CHUNK 16384
+#define MOCK_EVENT_SIZE 512
+#define MOCK_LISTEN_BACKLOG 512
+#define MOCK_BYTES_PER_TOKEN 4         /* Reported prompt tokens = body bytes / 4 */
+#define MOCK_STREAM_ON "\"stream\":true"
+#define MOCK_STREAM_OFF "\"stream\":false"
+
+/* Latency distributions */
+typedef enum {
+    LATENCY_FIXED,          /* Always the mean */
+    LATENCY_UNIFORM,        /* mean +- jitter */
+    LATENCY_NORMAL,         /* mean, jitter as standard deviation */
+    LATENCY_EXPONENTIAL     /* mean, long tail */
+} latency_dist_t;
+
+/* Wire formats */
+typedef enum {
+    WIRE_OPENAI,
+    WIRE_ANTHROPIC,
+    WIRE_GEMINI,
+    WIRE_OLLAMA
+} wire_format_t;
+
+/* Options (read-only once serving) */
+typedef struct {
+    int port;
+    latency_dist_t dist;
+    double latency_ms;
+    double jitter_ms;
+    double tokens_per_sec;      /* 0 = no pacing */
+    int response_tokens;
+    double error_429_percent;
+    double error_500_percent;
+    int retry_after_ms;
+    uint64_t seed;
+} mock_options_t;
+
+/* Counters */
+typedef struct {
+    pthread_mutex_t lock;
+    unsigned long long requests;
+    unsigned long long streamed;
+    unsigned long long throttled;
+    unsigned long long failed;
+    unsigned long long connections;
+} mock_stats_t;
+
+/* Connection */
+typedef struct {
+    int fd;
+    uint64_t rng;
+    char* buffer;               /* Received, not yet consumed */
+    size_t length;
+    size_t capacity;
+} mock_conn_t;
+
+static mock_options_t g_options = {
+    .port = MOCK_DEFAULT_PORT,
+    .dist = LATENCY_FIXED,
+    .response_tokens = MOCK_DEFAULT_TOKENS,
+    .retry_after_ms = MOCK_DEFAULT_RETRY_AFTER_MS,
+    .seed = 1
+};
+static mock_stats_t g_stats = { .lock = PTHREAD_MUTEX_INITIALIZER };
+static volatile sig_atomic_t g_stop = 0;
+
+static const char* const g_words[] = {
+    "the", "mock", "model", "answers", "with", "steady", "generated", "text",
+    "so", "benchmarks", "measure", "only", "the", "client", "path", "overhead"
+};
+#define MOCK_WORD_COUNT (sizeof(g_words) / sizeof(g_words[0]))
+
+/* Helper: xorshift64* */
+static uint64_t next_random(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/* Helper: Uniform in (0, 1) */
+static double next_unit(uint64_t* state) {
+    return ((double)(next_random(state) >> 11) + 0.5) / 9007199254740992.0;
+}
+
+/* Helper: Sampled latency in milliseconds */
+static double sample_latency(uint64_t* rng) {
+    double mean = g_options.latency_ms;
+    double jitter = g_options.jitter_ms;
+    double value = mean;
+
+    switch (g_options.dist) {
+        case LATENCY_FIXED:
+            break;
+        case LATENCY_UNIFORM:
+            value = mean + (2.0 * next_unit(rng) - 1.0) * jitter;
+            break;
+        case LATENCY_NORMAL:
+            value = mean + jitter * sqrt(-2.0 * log(next_unit(rng))) * cos(2.0 * M_PI * next_unit(rng));
+            break;
+        case LATENCY_EXPONENTIAL:
+            value = -mean * log(next_unit(rng));
+            break;
+    }
+    return value > 0.0 ? value : 0.0;
+}
+
+/* Helper: Sleep for fractional milliseconds */
+static void sleep_ms(double ms) {
+    if (ms <= 0.0) return;
+    struct timespec ts = {
+        .tv_sec = (time_t)(ms / 1000.0),
+        .tv_nsec = (long)(fmod(ms, 1000.0) * 1000000.0)
+    };
+    while (nanosleep(&ts, &ts) < 0 && errno == EINTR) {}
+}
+
+/* Helper: Count one outcome */
+static void count(unsigned long long* counter) {
+    pthread_mutex_lock(&g_stats.lock);
+    (*counter)++;
+    pthread_mutex_unlock(&g_stats.lock);
+}
+
+/* Helper: Write the whole buffer */
+static bool send_all(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t n = send(fd, data, len, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+/* Helper: Complete response with a body */
+static bool send_response(int fd, int status, const char* reason, const char* content_type,
+                          const char* extra_header, const char* body, size_t body_len) {
+    char head[MOCK_EVENT_SIZE];
+    int n = snprintf(head, sizeof(head),
+                     "HTTP/1.1 %d %s\r\nContent-Type: %s\r\nContent-Length: %zu\r\n%s\r\n",
+                     status, reason, content_type, body_len, extra_header ? extra_header : "");
+    return n > 0 && (size_t)n < sizeof(head) && send_all(fd, head, (size_t)n) && send_all(fd, body, body_len);
+}
+
+/* Helper: One chunk of a chunked body (empty ends it) */
+static bool send_chunk(int fd, const char* data, size_t len) {
+    char size[32];
+    int n = snprintf(size, sizeof(size), "%zx\r\n", len);
+    return send_all(fd, size, (size_t)n) && send_all(fd, data, len) && send_all(fd, "\r\n", 2);
+}
+
+/* Helper: Generated text of response_tokens words */
+static char* generate_text(size_t* length) {
+    size_t capacity = (size_t)g_options.response_tokens * 16 + 1;
+    char* text = malloc(capacity);
+    if (!text) return NULL;
+
+    size_t used = 0;
+    for (int i = 0; i < g_options.response_tokens; i++) {
+        used += (size_t)snprintf(text + used, capacity - used, "%s ", g_words[(size_t)i % MOCK_WORD_COUNT]);
+    }
+    text[used] = '\0';
+    *length = used;
+    return text;
+}
+
+/* Helper: Whole-answer body in the wire format */
+static char* format_answer(wire_format_t wire, const char* text, int prompt_tokens, size_t* length) {
+    size_t capacity = strlen(text) + MOCK_EVENT_SIZE;
+    char* body = malloc(capacity);
+    if (!body) return NULL;
+
+    int tokens = g_options.response_tokens;
+    int n = 0;
+    switch (wire) {
+        case WIRE_OPENAI:
+            n = snprintf(body, capacity,
+                         "{\"id\":\"mock\",\"object\":\"chat.completion\",\"model\":\"mock\","
+                         "\"choices\":[{\"index\":0,\"message\":{\"role\":\"assistant\",\"content\":\"%s\"},"
+                         "\"finish_reason\":\"stop\"}],\"usage\":{\"prompt_tokens\":%d,\"completion_tokens\":%d}}",
+                         text, prompt_tokens, tokens);
+            break;
+        case WIRE_ANTHROPIC:
+            n = snprintf(body, capacity,
+                         "{\"id\":\"mock\",\"type\":\"message\",\"role\":\"assistant\",\"model\":\"mock\","
+                         "\"content\":[{\"type\":\"text\",\"text\":\"%s\"}],\"stop_reason\":\"end_turn\","
+                         "\"usage\":{\"input_tokens\":%d,\"output_tokens\":%d}}", text, prompt_tokens, tokens);
+            break;
+        case WIRE_GEMINI:
+            n = snprintf(body, capacity,
+                         "{\"candidates\":[{\"content\":{\"parts\":[{\"text\":\"%s\"}],\"role\":\"model\"},"
+                         "\"finishReason\":\"STOP\"}],\"usageMetadata\":{\"promptTokenCount\":%d,"
+                         "\"candidatesTokenCount\":%d}}", text, prompt_tokens, tokens);
+            break;
+        case WIRE_OLLAMA:
+            n = snprintf(body, capacity,
+                         "{\"model\":\"mock\",\"response\":\"%s\",\"done\":true,"
+                         "\"prompt_eval_count\":%d,\"eval_count\":%d}", text, prompt_tokens, tokens);
+            break;
+    }
+    *length = (size_t)n;
+    return body;
+}
+
+/* Helper: One streamed token in the wire format */
+static int format_delta(wire_format_t wire, const char* word, char* out, size_t size) {
+    switch (wire) {
+        case WIRE_OPENAI:
+            return snprintf(out, size, "data: {\"object\":\"chat.completion.chunk\","
+                            "\"choices\":[{\"index\":0,\"delta\":{\"content\":\"%s \"}}]}\n\n", word);
+        case WIRE_ANTHROPIC:
+            return snprintf(out, size, "event: content_block_delta\ndata: {\"type\":\"content_block_delta\","
+                            "\"index\":0,\"delta\":{\"type\":\"text_delta\",\"text\":\"%s \"}}\n\n", word);
+        case WIRE_GEMINI:
+            return snprintf(out, size, "data: {\"candidates\":[{\"content\":{\"parts\":[{\"text\":\"%s \"}],"
+                            "\"role\":\"model\"}}]}\n\n", word);
+        case WIRE_OLLAMA:
+            return snprintf(out, size, "{\"model\":\"mock\",\"response\":\"%s \",\"done\":false}\n", word);
+    }
+    return 0;
+}
+
+/* Helper: Events before the first token (0 = none) */
+static int stream_prologue(wire_format_t wire, int prompt_tokens, char* out, size_t size) {
+    if (wire != WIRE_ANTHROPIC) return 0;
+    return snprintf(out, size, "event: message_start\ndata: {\"type\":\"message_start\",\"message\":"
+                    "{\"id\":\"mock\",\"usage\":{\"input_tokens\":%d,\"output_tokens\":1}}}\n\n", prompt_tokens);
+}
+
+/* Helper: Events after the last token, usage included as each API sends it */
+static int stream_epilogue(wire_format_t wire, int prompt_tokens, char* out, size_t size) {
+    int tokens = g_options.response_tokens;
+    switch (wire) {
+        case WIRE_OPENAI:
+            return snprintf(out, size, "data: {\"choices\":[{\"index\":0,\"delta\":{},\"finish_reason\":\"stop\"}]}\n\n"
+                            "data: {\"choices\":[],\"usage\":{\"prompt_tokens\":%d,\"completion_tokens\":%d}}\n\n"
+                            "data: [DONE]\n\n", prompt_tokens, tokens);
+        case WIRE_ANTHROPIC:
+            return snprintf(out, size, "event: message_delta\ndata: {\"type\":\"message_delta\","
+                            "\"delta\":{\"stop_reason\":\"end_turn\"},\"usage\":{\"output_tokens\":%d}}\n\n"
+                            "event: message_stop\ndata: {\"type\":\"message_stop\"}\n\n", tokens);
+        case WIRE_GEMINI:
+            return snprintf(out, size, "data: {\"candidates\":[{\"content\":{\"parts\":[{\"text\":\"\"}],"
+                            "\"role\":\"model\"},\"finishReason\":\"STOP\"}],\"usageMetadata\":"
+                            "{\"promptTokenCount\":%d,\"candidatesTokenCount\":%d}}\n\n", prompt_tokens, tokens);
+        case WIRE_OLLAMA:
+            return snprintf(out, size, "{\"model\":\"mock\",\"response\":\"\",\"done\":true,"
+                            "\"prompt_eval_count\":%d,\"eval_count\":%d}\n", prompt_tokens, tokens);
+    }
+    return 0;
+}
+
+/* Helper: Stream the answer one token at a time */
+static bool stream_answer(int fd, wire_format_t wire, int prompt_tokens) {
+    const char* type = wire == WIRE_OLLAMA ? "application/x-ndjson" : "text/event-stream";
+    char head[MOCK_EVENT_SIZE];
+    int n = snprintf(head, sizeof(head),
+                     "HTTP/1.1 200 OK\r\nContent-Type: %s\r\nTransfer-Encoding: chunked\r\n\r\n", type);
+    if (!send_all(fd, head, (size_t)n)) return false;
+
+    char event[MOCK_EVENT_SIZE];
+    n = stream_prologue(wire, prompt_tokens, event, sizeof(event));
+    if (n > 0 && !send_chunk(fd, event, (size_t)n)) return false;
+
+    double gap_ms = g_options.tokens_per_sec > 0.0 ? 1000.0 / g_options.tokens_per_sec : 0.0;
+    for (int i = 0; i < g_options.response_tokens; i++) {
+        if (i > 0) sleep_ms(gap_ms);
+        n = format_delta(wire, g_words[(size_t)i % MOCK_WORD_COUNT], event, sizeof(event));
+        if (!send_chunk(fd, event, (size_t)n)) return false;
+    }
+
+    n = stream_epilogue(wire, prompt_tokens, event, sizeof(event));
+    if (n > 0 && !send_chunk(fd, event, (size_t)n)) return false;
+    return send_all(fd, "0\r\n\r\n", 5);
+}
+
+/* Helper: Answer one request; false closes the connection */
+static bool answer(mock_conn_t* conn, const char* method, const char* target,
+                   const char* body, size_t body_len) {
+    if (strcmp(method, HTTP_METHOD_STR_GET) == 0 && strcmp(target, "/health") == 0) {
+        return send_response(conn->fd, HTTP_STATUS_OK, "OK", "text/plain", NULL, "ok", 2);
+    }
+
+    wire_format_t wire;
+    bool stream = body && memmem(body, body_len, MOCK_STREAM_ON, strlen(MOCK_STREAM_ON)) != NULL;
+    if (strstr(target, ":streamGenerateContent")) {
+        wire = WIRE_GEMINI;
+        stream = true;
+    } else if (strstr(target, ":generateContent")) {
+        wire = WIRE_GEMINI;
+    } else if (strstr(target, "/chat/completions")) {
+        wire = WIRE_OPENAI;
+    } else if (strstr(target, "/messages")) {
+        wire = WIRE_ANTHROPIC;
+    } else if (strstr(target, "/api/generate")) {
+        wire = WIRE_OLLAMA;
+        stream = !(body && memmem(body, body_len, MOCK_STREAM_OFF, strlen(MOCK_STREAM_OFF)));
+    } else {
+        const char* error = "{\"error\":{\"message\":\"unknown route\"}}";
+        return send_response(conn->fd, HTTP_STATUS_NOT_FOUND, "Not Found", HTTP_CONTENT_TYPE_JSON,
+                             NULL, error, strlen(error));
+    }
+    count(&g_stats.requests);
+
+    /* Time to first byte, then injected failures */
+    sleep_ms(sample_latency(&conn->rng));
+    double roll = next_unit(&conn->rng) * 100.0;
+    if (roll < g_options.error_429_percent) {
+        count(&g_stats.throttled);
+        char retry[64];
+        snprintf(retry, sizeof(retry), "retry-after-ms: %d\r\n", g_options.retry_after_ms);
+        const char* error = "{\"error\":{\"type\":\"rate_limit_error\",\"message\":\"mock rate limit\"}}";
+        return send_response(conn->fd, HTTP_STATUS_RATE_LIMIT, "Too Many Requests", HTTP_CONTENT_TYPE_JSON,
+                             retry, error, strlen(error));
+    }
+    if (roll < g_options.error_429_percent + g_options.error_500_percent) {
+        count(&g_stats.failed);
+        const char* error = "{\"error\":{\"type\":\"api_error\",\"message\":\"mock server error\"}}";
+        return send_response(conn->fd, HTTP_STATUS_SERVER_ERROR, "Internal Server Error",
+                             HTTP_CONTENT_TYPE_JSON, NULL, error, strlen(error));
+    }
+
+    int prompt_tokens = (int)(body_len / MOCK_BYTES_PER_TOKEN) + 1;
+    if (stream) {
+        count(&g_stats.streamed);
+        return stream_answer(conn->fd, wire, prompt_tokens);
+    }
+
+    /* Whole answer once all tokens would have been generated */
+    if (g_options.tokens_per_sec > 0.0) {
+        sleep_ms(1000.0 * (g_options.response_tokens - 1) / g_options.tokens_per_sec);
+    }
+    size_t text_len = 0;
+    size_t answer_len = 0;
+    char* text = generate_text(&text_len);
+    char* reply = text ? format_answer(wire, text, prompt_tokens, &answer_len) : NULL;
+    bool sent = reply && send_response(conn->fd, HTTP_STATUS_OK, "OK", HTTP_CONTENT_TYPE_JSON,
+                                       NULL, reply, answer_len);
+    free(text);
+    free(reply);
+    return sent;
+}
+
+/* Helper: Read more bytes into the connection buffer */
+static bool receive_more(mock_conn_t* conn) {
+    if (conn->capacity - conn->length < MOCK_READ_CHUNK) {
+        size_t capacity = conn->capacity * 2 + MOCK_READ_CHUNK;
+        char* buffer = realloc(conn->buffer, capacity + 1);
+        if (!buffer) return false;
+        conn->buffer = buffer;
+        conn->capacity = capacity;
+    }
+    ssize_t n;
+    do {
+        n = recv(conn->fd, conn->buffer + conn->length, conn->capacity - conn->length, 0);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) return false;
+    conn->length += (size_t)n;
+    conn->buffer[conn->length] = '\0';
+    return true;
+}
+
+/* Helper: Serve requests on one connection until it closes */
+static void serve_connection(mock_conn_t* conn) {
+    for (;;) {
+        char* end = NULL;
+        while (!(end = conn->buffer ? strstr(conn->buffer, "\r\n\r\n") : NULL)) {
+            if (conn->length > MOCK_HEADER_MAX || !receive_more(conn)) return;
+        }
+        size_t header_len = (size_t)(end - conn->buffer) + 4;
+
+        char method[16];
+        char target[1024];
+        if (sscanf(conn->buffer, "%15s %1023s", method, target) != 2) return;
+
+        size_t body_len = 0;
+        bool keep_alive = true;
+        for (char* line = strstr(conn->buffer, "\r\n"); line && line < end; line = strstr(line + 2, "\r\n")) {
+            if (strncasecmp(line + 2, "Content-Length:", 15) == 0) {
+                body_len = strtoul(line + 17, NULL, 10);
+            } else if (strncasecmp(line + 2, "Connection: close", 17) == 0) {
+                keep_alive = false;
+            }
+        }
+        if (body_len > MOCK_BODY_MAX) return;
+        while (conn->length < header_len + body_len) {
+            if (!receive_more(conn)) return;
+        }
+
+        char* body = conn->buffer + header_len;
+        char saved = body[body_len];
+        body[body_len] = '\0';
+        bool open = answer(conn, method, target, body, body_len);
+        body[body_len] = saved;
+
+        /* Keep what the client sent past this request */
+        size_t used = header_len + body_len;
+        memmove(conn->buffer, conn->buffer + used, conn->length - used);
+        conn->length -= used;
+        conn->buffer[conn->length] = '\0';
+        if (!open || !keep_alive) return;
+    }
+}
+
+/* Connection thread */
+static void* connection_thread(void* arg) {
+    mock_conn_t* conn = (mock_conn_t*)arg;
+    serve_connection(conn);
+    close(conn->fd);
+    free(conn->buffer);
+    free(conn);
+    return NULL;
+}
+
+/* Helper: Stop on SIGINT/SIGTERM */
+static void on_signal(int sig) {
+    (void)sig;
+    g_stop = 1;
+}
+
+/* Helper: Latency distribution by name */
+static bool parse_dist(const char* name, latency_dist_t* dist) {
+    static const struct { const char* name; latency_dist_t dist; } dists[] = {
+        { "fixed", LATENCY_FIXED }, { "uniform", LATENCY_UNIFORM },
+        { "normal", LATENCY_NORMAL }, { "exponential", LATENCY_EXPONENTIAL }
+    };
+    for (size_t i = 0; i < sizeof(dists) / sizeof(dists[0]); i++) {
+        if (strcmp(name, dists[i].name) == 0) {
+            *dist = dists[i].dist;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --port N               Listen port (default %d)\n"
+            "  --latency-ms MS        Mean time to first byte (default 0)\n"
+            "  --jitter-ms MS         Spread for uniform/normal (default 0)\n"
+            "  --dist NAME            fixed, uniform, normal or exponential (default fixed)\n"
+            "  --tokens N             Tokens per answer (default %d)\n"
+            "  --tokens-per-sec R     Generation rate, 0 = instant (default 0)\n"
+            "  --error-429 PCT        Share of requests rate limited (default 0)\n"
+            "  --error-500 PCT        Share of requests failed (default 0)\n"
+            "  --retry-after-ms MS    retry-after-ms on 429 (default %d)\n"
+            "  --seed N               Random seed (default 1)\n",
+            program, MOCK_DEFAULT_PORT, MOCK_DEFAULT_TOKENS, MOCK_DEFAULT_RETRY_AFTER_MS);
+}
+
+/* Helper: Parse command line into g_options */
+static bool parse_options(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        const char* name = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!value) return false;
+        i++;
+
+        if (strcmp(name, "--port") == 0) g_options.port = atoi(value);
+        else if (strcmp(name, "--latency-ms") == 0) g_options.latency_ms = atof(value);
+        else if (strcmp(name, "--jitter-ms") == 0) g_options.jitter_ms = atof(value);
+        else if (strcmp(name, "--tokens") == 0) g_options.response_tokens = atoi(value);
+        else if (strcmp(name, "--tokens-per-sec") == 0) g_options.tokens_per_sec = atof(value);
+        else if (strcmp(name, "--error-429") == 0) g_options.error_429_percent = atof(value);
+        else if (strcmp(name, "--error-500") == 0) g_options.error_500_percent = atof(value);
+        else if (strcmp(name, "--retry-after-ms") == 0) g_options.retry_after_ms = atoi(value);
+        else if (strcmp(name, "--seed") == 0) g_options.seed = strtoull(value, NULL, 10);
+        else if (strcmp(name, "--dist") == 0) {
+            if (!parse_dist(value, &g_options.dist)) return false;
+        } else {
+            return false;
+        }
+    }
+    return g_options.port > 0 && g_options.port < 65536 && g_options.response_tokens > 0 &&
+           g_options.latency_ms >= 0.0 && g_options.jitter_ms >= 0.0 && g_options.tokens_per_sec >= 0.0;
+}
+
+int main(int argc, char** argv) {
+    if (!parse_options(argc, argv)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    int on = 1;
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons((uint16_t)g_options.port),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK)
+    };
+    if (listen_fd < 0 || bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 ||
+        listen(listen_fd, MOCK_LISTEN_BACKLOG) < 0) {
+        fprintf(stderr, "mock_llm_server: cannot listen on port %d: %s\n", g_options.port, strerror(errno));
+        return 1;
+    }
+
+    /* No SA_RESTART: accept() returns on a stop signal */
+    struct sigaction sa = { .sa_handler = on_signal };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);   /* Clients may hang up mid-stream */
+    fprintf(stderr, "mock_llm_server: listening on 127.0.0.1:%d\n", g_options.port);
+
+    uint64_t connections = 0;
+    while (!g_stop) {
+        int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0) continue;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+        mock_conn_t* conn = calloc(1, sizeof(mock_conn_t));
+        pthread_t thread;
+        if (!conn) {
+            close(fd);
+            continue;
+        }
+        conn->fd = fd;
+        conn->rng = (g_options.seed ^ (++connections * 0x9E3779B97F4A7C15ULL)) | 1;
+        count(&g_stats.connections);
+        if (pthread_create(&thread, NULL, connection_thread, conn) != 0) {
+            close(fd);
+            free(conn);
+            continue;
+        }
+        pthread_detach(thread);
+    }
+
+    close(listen_fd);
+    pthread_mutex_lock(&g_stats.lock);
+    fprintf(stderr, "mock_llm_server: %llu requests (%llu streamed, %llu 429, %llu 500) on %llu connections\n",
+            g_stats.requests, g_stats.streamed, g_stats.throttled, g_stats.failed, g_stats.connections);
+    pthread_mutex_unlock(&g_stats.lock);
+    return 0;
+}
@@ -218,6 +218,75 @@ static void test_memory_augmentation_null_params(void) {
     PASS();
 }
 
+/* Test prompt assembly into a token budget */
+static void test_prompt_budget(void) {
+    TEST("Prompt assembly within a token budget");
+
+    ci_memory_digest_t* digest = memory_digest_create(1000000);
+    if (!digest) {
+        FAIL("Failed to create memory digest");
+        return;
+    }
+
+    char text[128];
+    for (int i = 0; i < 8; i++) {
+        snprintf(text, sizeof(text), "Budget fact %d about the parser and its error recovery paths", i);
+        memory_add_item(digest, MEMORY_TYPE_FACT, text, "test-ci");
+        memory_select_item(digest, digest->last_item_id);
+        snprintf(text, sizeof(text), "checkpoint %d reached", i);
+        memory_add_breadcrumb(digest, text);
+    }
+    memory_set_sunrise_brief(digest, "Continue the parser work");
+    memory_set_sunset_notes(digest, "Yesterday the parser lost its place after a bad token");
+
+    /* Unlimited keeps everything and counts it */
+    char* full = NULL;
+    api_prompt_report_t report;
+    int result = api_assemble_prompt(digest, "Fix the parser", 0, &full, &report);
+    if (result != ARGO_SUCCESS || !full || report.items_packed != 8 || report.breadcrumbs_packed != 8 ||
+        report.used_tokens != memory_estimate_tokens(full, strlen(full))) {
+        FAIL("Unlimited assembly should keep and count every section");
+        memory_digest_destroy(digest);
+        free(full);
+        return;
+    }
+
+    /* Half the full size drops the lowest priority entries, whole */
+    char* packed = NULL;
+    size_t budget = report.used_tokens / 2 + report.task_tokens;
+    result = api_assemble_prompt(digest, "Fix the parser", budget, &packed, &report);
+    bool ok = result == ARGO_SUCCESS && packed && !report.over_budget &&
+              report.used_tokens <= budget &&
+              report.used_tokens - report.task_tokens <= budget / 2 &&
+              report.used_tokens == memory_estimate_tokens(packed, strlen(packed)) &&
+              report.items_dropped + report.breadcrumbs_dropped > 0 &&
+              report.items_packed + report.items_dropped == 8 &&
+              !report.sunrise_dropped && report.sunset_dropped &&
+              strstr(packed, "Budget fact 0 ") && strstr(packed, "Continue the parser") &&
+              !strstr(packed, "Yesterday") && strstr(packed, "## Current Task\nFix the parser");
+    free(full);
+    free(packed);
+    if (!ok) {
+        FAIL("Budgeted assembly should drop whole entries by priority");
+        memory_digest_destroy(digest);
+        return;
+    }
+
+    /* A task over budget goes alone and is reported */
+    char* alone = NULL;
+    result = api_assemble_prompt(digest, "Fix the parser", 2, &alone, &report);
+    ok = result == ARGO_SUCCESS && alone && report.over_budget && report.items_packed == 0 &&
+         report.breadcrumbs_packed == 0 && strcmp(alone, "## Current Task\nFix the parser") == 0;
+    free(alone);
+    memory_digest_destroy(digest);
+    if (!ok) {
+        FAIL("Over-budget task should be sent alone and reported");
+        return;
+    }
+
+    PASS();
+}
+
 /* Test buffer allocation with zero size */
 static void test_buffer_allocation_zero_size(void) {
     TEST("Buffer allocation with zero size");
@@ -285,6 +354,7 @@ int main(void) {
     test_memory_augmentation();
     test_memory_augmentation_no_digest();
     test_memory_augmentation_null_params();
+    test_prompt_budget();
 
     /* Print summary */
     printf("\n");
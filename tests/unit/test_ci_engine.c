@@ -0,0 +1,318 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* usleep() */
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+/* Project includes */
+#include "argo_ci_engine.h"
+#include "argo_api_common.h"
+#include "argo_mock.h"
+#include "argo_error.h"
+#include "argo_limits.h"
+#include "argo_time.h"
+
+/* Test utilities */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "FAIL: %s\n", message); \
+            return 1; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        return 0; \
+    } while(0)
+
+#define FAN_OUT_QUERIES 8
+#define FAN_OUT_MAX_DELAY_MS 400
+#define SLOW_DELAY_MS 3000
+#define SHORT_DEADLINE_MS 200
+#define WORKER_DELAY_MS 500
+#define REQUEST_BUFFER_SIZE 8192
+
+/* Slow loopback model server: POST /delay/<ms> answers after <ms> */
+static int g_listen_fd = -1;
+static int g_port = 0;
+
+static const char* g_response_path[] = {"message", "content"};
+static char g_urls[FAN_OUT_QUERIES + 2][ARGO_BUFFER_MEDIUM];
+static api_provider_config_t g_configs[FAN_OUT_QUERIES + 2];
+
+/* Helper: Serve one keep-alive connection */
+static void* connection_thread(void* arg) {
+    int fd = (int)(intptr_t)arg;
+    char buf[REQUEST_BUFFER_SIZE];
+    size_t used = 0;
+
+    while (true) {
+        ssize_t n = read(fd, buf + used, sizeof(buf) - used - 1);
+        if (n <= 0) break;
+        used += (size_t)n;
+        buf[used] = '\0';
+
+        char* end = strstr(buf, "\r\n\r\n");
+        if (!end) continue;
+        char* length = strstr(buf, "Content-Length: ");
+        size_t body_len = length && length < end ? (size_t)atoi(length + 16) : 0;
+        size_t header_len = (size_t)(end + 4 - buf);
+        if (used < header_len + body_len) continue;
+
+        int delay = 0;
+        char* path = strstr(buf, "/delay/");
+        if (path) delay = atoi(path + 7);
+        usleep((useconds_t)delay * 1000);
+
+        char body[ARGO_BUFFER_SMALL];
+        int body_size = snprintf(body, sizeof(body),
+                                 "{\"choices\":[{\"message\":{\"content\":\"reply %d\"}}]}", delay);
+        char reply[ARGO_BUFFER_MEDIUM];
+        int len = snprintf(reply, sizeof(reply),
+                           "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+                           "Content-Length: %d\r\n\r\n%s", body_size, body);
+        if (write(fd, reply, (size_t)len) != len) break;
+
+        used -= header_len + body_len;
+        memmove(buf, buf + header_len + body_len, used);
+    }
+
+    close(fd);
+    return NULL;
+}
+
+/* Helper: Accept loop, one thread per connection */
+static void* accept_thread(void* arg) {
+    (void)arg;
+    while (true) {
+        int fd = accept(g_listen_fd, NULL, NULL);
+        if (fd < 0) break;
+
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, connection_thread, (void*)(intptr_t)fd) == 0) {
+            pthread_detach(thread);
+        } else {
+            close(fd);
+        }
+    }
+    return NULL;
+}
+
+/* Helper: Start server on an ephemeral loopback port */
+static int start_server(pthread_t* thread) {
+    struct sockaddr_in addr = {0};
+    socklen_t addr_len = sizeof(addr);
+
+    g_listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (g_listen_fd < 0) return -1;
+
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(g_listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(g_listen_fd, 64) != 0 ||
+        getsockname(g_listen_fd, (struct sockaddr*)&addr, &addr_len) != 0) {
+        close(g_listen_fd);
+        return -1;
+    }
+    g_port = ntohs(addr.sin_port);
+
+    return pthread_create(thread, NULL, accept_thread, NULL);
+}
+
+/* Helper: OpenAI-style request body */
+static int build_request(json_builder_t* json, const char* model, const char* prompt, bool stream) {
+    api_chat_message_t message = { API_ROLE_USER, prompt };
+    (void)stream;
+    json_builder_object_begin(json);
+    json_builder_key_string(json, "model", model);
+    api_json_chat_messages(json, &message, 1);
+    json_builder_object_end(json);
+    return json_builder_error(json);
+}
+
+/* Helper: HTTP provider answering after delay_ms */
+static ci_provider_t* http_provider(int slot, int delay_ms) {
+    snprintf(g_urls[slot], sizeof(g_urls[slot]), "http://127.0.0.1:%d/delay/%d", g_port, delay_ms);
+    g_configs[slot] = (api_provider_config_t){
+        .provider_name = "loopback",
+        .default_model = "test-model",
+        .api_url = g_urls[slot],
+        .auth = {.type = API_AUTH_BEARER, .value = "test-key"},
+        .response_path = g_response_path,
+        .response_path_depth = 2,
+        .build_request = build_request,
+        .max_context = ARGO_BUFFER_STANDARD
+    };
+    return generic_api_create_provider(&g_configs[slot], NULL);
+}
+
+/* Blocking provider for the worker lane */
+static int slow_query(ci_provider_t* provider, const char* prompt,
+                      ci_response_callback callback, void* userdata) {
+    (void)prompt;
+    usleep(WORKER_DELAY_MS * 1000);
+    ci_response_t response = {.success = true, .content = "slow", .model_used = provider->model};
+    callback(&response, userdata);
+    return ARGO_SUCCESS;
+}
+
+static void slow_cleanup(ci_provider_t* provider) {
+    free(provider);
+}
+
+static ci_provider_t* slow_provider(void) {
+    ci_provider_t* provider = calloc(1, sizeof(ci_provider_t));
+    if (provider) {
+        strncpy(provider->name, "slow", sizeof(provider->name) - 1);
+        provider->query = slow_query;
+        provider->cleanup = slow_cleanup;
+    }
+    return provider;
+}
+
+/* Completion counter */
+typedef struct {
+    pthread_mutex_t lock;
+    int calls;
+    int last_error;
+} counter_t;
+
+static void count_completion(const ci_response_t* response, void* userdata) {
+    counter_t* counter = (counter_t*)userdata;
+    pthread_mutex_lock(&counter->lock);
+    counter->calls++;
+    counter->last_error = response->error_code;
+    pthread_mutex_unlock(&counter->lock);
+}
+
+/* Test: Fan-out completes in max(latency), results in order */
+static int test_fan_out(ci_engine_t* engine) {
+    ci_future_t* futures[FAN_OUT_QUERIES];
+    int delays[FAN_OUT_QUERIES];
+    long long sum = 0;
+    long long start = argo_monotonic_ms();
+
+    for (int i = 0; i < FAN_OUT_QUERIES; i++) {
+        delays[i] = FAN_OUT_MAX_DELAY_MS - (i % 4) * 100;
+        sum += delays[i];
+        futures[i] = ci_engine_submit(engine, http_provider(i, delays[i]), "hello", 0, NULL, NULL);
+        TEST_ASSERT(futures[i] != NULL, "Should submit");
+    }
+
+    for (int i = 0; i < FAN_OUT_QUERIES; i++) {
+        TEST_ASSERT(ci_future_wait(futures[i], CI_ENGINE_NO_TIMEOUT) == ARGO_SUCCESS, "Should complete");
+        const ci_response_t* response = ci_future_response(futures[i]);
+        char expected[ARGO_BUFFER_TINY];
+        snprintf(expected, sizeof(expected), "reply %d", delays[i]);
+        TEST_ASSERT(response->success && strcmp(response->content, expected) == 0,
+                    "Each future holds its own reply");
+        ci_future_release(futures[i]);
+    }
+
+    long long elapsed = argo_monotonic_ms() - start;
+    printf("  %d queries: %lld ms (sum of latencies %lld ms)\n", FAN_OUT_QUERIES, elapsed, sum);
+    TEST_ASSERT(elapsed < FAN_OUT_MAX_DELAY_MS * 2, "Fan-out takes max, not sum, of latencies");
+    TEST_PASS("Concurrent fan-out");
+}
+
+/* Test: Deadlines on both lanes */
+static int test_deadline(ci_engine_t* engine) {
+    counter_t counter = {.lock = PTHREAD_MUTEX_INITIALIZER};
+    long long start = argo_monotonic_ms();
+
+    ci_future_t* http = ci_engine_submit(engine, http_provider(FAN_OUT_QUERIES, SLOW_DELAY_MS),
+                                         "hello", SHORT_DEADLINE_MS, count_completion, &counter);
+    ci_future_t* worker = ci_engine_submit(engine, slow_provider(), "hello",
+                                           SHORT_DEADLINE_MS, count_completion, &counter);
+    TEST_ASSERT(http && worker, "Should submit");
+
+    ci_future_wait(http, CI_ENGINE_NO_TIMEOUT);
+    ci_future_wait(worker, CI_ENGINE_NO_TIMEOUT);
+    long long elapsed = argo_monotonic_ms() - start;
+
+    TEST_ASSERT(ci_future_response(http)->error_code == E_CI_TIMEOUT, "HTTP query times out");
+    TEST_ASSERT(ci_future_response(worker)->error_code == E_CI_TIMEOUT, "Worker query times out");
+    TEST_ASSERT(elapsed < WORKER_DELAY_MS, "Deadline does not wait for the provider");
+    TEST_ASSERT(counter.calls == 2, "Callback runs once per query");
+
+    ci_future_release(http);
+    ci_future_release(worker);
+    TEST_PASS("Deadlines");
+}
+
+/* Test: Cancellation and the worker lane */
+static int test_cancel(ci_engine_t* engine) {
+    counter_t counter = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+    ci_future_t* future = ci_engine_submit(engine, http_provider(FAN_OUT_QUERIES + 1, SLOW_DELAY_MS),
+                                           "hello", 0, count_completion, &counter);
+    TEST_ASSERT(future != NULL, "Should submit");
+    TEST_ASSERT(ci_future_wait(future, 50) == E_SYSTEM_TIMEOUT, "Wait can time out without completing");
+    TEST_ASSERT(!ci_future_done(future), "Still pending");
+
+    TEST_ASSERT(ci_future_cancel(future) == ARGO_SUCCESS, "Should cancel");
+    TEST_ASSERT(ci_future_cancel(future) == E_INVALID_STATE, "Second cancel refused");
+    TEST_ASSERT(ci_future_response(future)->error_code == E_CI_CANCELLED, "Completes as cancelled");
+    ci_future_release(future);
+
+    ci_provider_t* mock = mock_provider_create("mock-model");
+    mock_provider_set_response(mock, "from mock");
+    future = ci_engine_submit(engine, mock, "hello", 0, count_completion, &counter);
+    ci_future_wait(future, CI_ENGINE_NO_TIMEOUT);
+    TEST_ASSERT(strcmp(ci_future_response(future)->content, "from mock") == 0, "Worker lane answers");
+    ci_future_release(future);
+
+    TEST_ASSERT(counter.calls == 2, "Cancelled query notified once");
+    TEST_PASS("Cancellation and worker lane");
+}
+
+/* Main test runner */
+int main(void) {
+    int failed = 0;
+
+    printf("Running CI engine tests...\n\n");
+
+    pthread_t server;
+    if (start_server(&server) != 0) {
+        fprintf(stderr, "FAIL: could not start loopback server\n");
+        return 1;
+    }
+
+    ci_engine_t* engine = ci_engine_create(2);
+    if (!engine) {
+        fprintf(stderr, "FAIL: could not create engine\n");
+        return 1;
+    }
+
+    failed += test_fan_out(engine);
+    failed += test_deadline(engine);
+    failed += test_cancel(engine);
+
+    ci_engine_destroy(engine);
+    shutdown(g_listen_fd, SHUT_RDWR);
+    close(g_listen_fd);
+    pthread_join(server, NULL);
+
+    printf("\n");
+    if (failed == 0) {
+        printf("All CI engine tests passed!\n");
+        return 0;
+    } else {
+        printf("%d CI engine tests failed\n", failed);
+        return 1;
+    }
+}
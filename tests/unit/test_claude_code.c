@@ -0,0 +1,245 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* mkdtemp(), setenv() */
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/* Project includes */
+#include "argo_ci.h"
+#include "argo_api_providers.h"
+#include "argo_claude_session_pool.h"
+#include "argo_provider_telemetry.h"
+#include "argo_error.h"
+#include "argo_limits.h"
+
+/* Test utilities */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "FAIL: %s\n", message); \
+            return 1; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        return 0; \
+    } while(0)
+
+/* Past the old fixed 1MB response buffer */
+#define LARGE_OUTPUT_BYTES 3000000
+#define LARGE_PROMPT_BYTES 300000
+#define OUTPUT_END_MARKER "END"
+
+/* Fake claude: "echo" prompts come back as-is, "fail" exits 1,
+ * anything else is answered with LARGE_OUTPUT_BYTES of 'x'. In
+ * stream-json (session) mode every turn gets a result frame with usage. */
+static const char* FAKE_CLAUDE =
+    "#!/bin/sh\n"
+    "case \"$*\" in\n"
+    "  *stream-json*)\n"
+    "    while read line; do\n"
+    "      printf '{\"type\":\"result\",\"is_error\":false,\"result\":\"ok\",'\n"
+    "      printf '\"session_id\":\"t1\",\"usage\":{\"input_tokens\":11,\"output_tokens\":5}}\\n'\n"
+    "    done\n"
+    "    exit 0 ;;\n"
+    "esac\n"
+    "prompt=$(cat)\n"
+    "case \"$prompt\" in\n"
+    "  echo*) printf '%s' \"$prompt\" ;;\n"
+    "  fail*) exit 1 ;;\n"
+    "  *) head -c 3000000 /dev/zero | tr '\\000' x; printf END ;;\n"
+    "esac\n";
+
+static char g_fake_dir[ARGO_PATH_MAX];
+
+/* Captured query answer */
+typedef struct {
+    char* content;
+    bool success;
+} answer_t;
+
+/* Captured stream */
+typedef struct {
+    size_t total;
+    int chunks;
+    bool all_x;
+    char tail[sizeof(OUTPUT_END_MARKER)];
+} stream_capture_t;
+
+static void on_answer(const ci_response_t* response, void* userdata) {
+    answer_t* answer = (answer_t*)userdata;
+    answer->success = response->success;
+    answer->content = response->content ? strdup(response->content) : NULL;
+}
+
+static void on_chunk(const char* chunk, size_t len, void* userdata) {
+    stream_capture_t* capture = (stream_capture_t*)userdata;
+    for (size_t i = 0; i < len; i++) {
+        size_t position = capture->total + i;
+        if (position < LARGE_OUTPUT_BYTES) {
+            capture->all_x = capture->all_x && chunk[i] == 'x';
+        } else if (position - LARGE_OUTPUT_BYTES < sizeof(capture->tail) - 1) {
+            capture->tail[position - LARGE_OUTPUT_BYTES] = chunk[i];
+        }
+    }
+    capture->total += len;
+    capture->chunks++;
+}
+
+/* Helper: Put the fake claude first on PATH */
+static int install_fake_claude(void) {
+    snprintf(g_fake_dir, sizeof(g_fake_dir), "/tmp/argo_test_claude_code_XXXXXX");
+    if (!mkdtemp(g_fake_dir)) return -1;
+
+    char path[ARGO_PATH_MAX];
+    snprintf(path, sizeof(path), "%s/%s", g_fake_dir, CLAUDE_CLI_COMMAND);
+    FILE* script = fopen(path, "w");
+    if (!script) return -1;
+    fputs(FAKE_CLAUDE, script);
+    fclose(script);
+    chmod(path, 0700);
+
+    char search[ARGO_BUFFER_STANDARD];
+    const char* old_path = getenv("PATH");
+    snprintf(search, sizeof(search), "%s:%s", g_fake_dir, old_path ? old_path : "/usr/bin:/bin");
+    return setenv("PATH", search, 1);
+}
+
+/* Helper: Remove the fake claude */
+static void remove_fake_claude(void) {
+    char path[ARGO_PATH_MAX];
+    snprintf(path, sizeof(path), "%s/%s", g_fake_dir, CLAUDE_CLI_COMMAND);
+    unlink(path);
+    rmdir(g_fake_dir);
+}
+
+/* Test: Answers past the old 1MB buffer come back whole */
+static int test_large_query(ci_provider_t* provider) {
+    answer_t answer = {0};
+    int result = provider->query(provider, "generate", on_answer, &answer);
+    TEST_ASSERT(result == ARGO_SUCCESS && answer.success, "Query failed");
+
+    size_t length = answer.content ? strlen(answer.content) : 0;
+    bool complete = length == LARGE_OUTPUT_BYTES + strlen(OUTPUT_END_MARKER) &&
+                    strcmp(answer.content + LARGE_OUTPUT_BYTES, OUTPUT_END_MARKER) == 0;
+    free(answer.content);
+    TEST_ASSERT(complete, "Answer should not be truncated");
+    TEST_PASS("Large answer is returned whole");
+}
+
+/* Test: Stream delivers the answer in chunks as it arrives */
+static int test_stream_chunks(ci_provider_t* provider) {
+    stream_capture_t capture = { .all_x = true };
+    int result = provider->stream(provider, "generate", on_chunk, &capture);
+    TEST_ASSERT(result == ARGO_SUCCESS, "Stream failed");
+    TEST_ASSERT(capture.total == LARGE_OUTPUT_BYTES + strlen(OUTPUT_END_MARKER), "Stream lost bytes");
+    TEST_ASSERT(capture.all_x && strcmp(capture.tail, OUTPUT_END_MARKER) == 0, "Stream corrupted bytes");
+    TEST_ASSERT(capture.chunks > 1, "Stream should deliver more than one chunk");
+    TEST_PASS("Stream delivers chunks incrementally");
+}
+
+/* Test: A large prompt is written whole */
+static int test_large_prompt(ci_provider_t* provider) {
+    char* prompt = malloc(LARGE_PROMPT_BYTES + 1);
+    TEST_ASSERT(prompt != NULL, "Allocation failed");
+    memcpy(prompt, "echo", 4);
+    memset(prompt + 4, 'p', LARGE_PROMPT_BYTES - 4);
+    prompt[LARGE_PROMPT_BYTES] = '\0';
+
+    answer_t answer = {0};
+    int result = provider->query(provider, prompt, on_answer, &answer);
+    bool echoed = result == ARGO_SUCCESS && answer.content && strcmp(answer.content, prompt) == 0;
+    free(answer.content);
+    free(prompt);
+    TEST_ASSERT(echoed, "Prompt should round-trip");
+    TEST_PASS("Large prompt is written whole");
+}
+
+/* Test: A failing CLI fails the query */
+static int test_cli_failure(ci_provider_t* provider) {
+    answer_t answer = {0};
+    int result = provider->query(provider, "fail", on_answer, &answer);
+    TEST_ASSERT(result == E_CI_CONFUSED, "Non-zero exit should fail the query");
+    TEST_ASSERT(answer.content == NULL, "Callback should not run on failure");
+    TEST_PASS("CLI failure is reported");
+}
+
+/* Test: Every call, one-shot or session, lands in provider telemetry */
+static int test_telemetry(ci_provider_t* provider) {
+    provider_telemetry_reset();
+
+    answer_t answer = {0};
+    TEST_ASSERT(provider->query(provider, "echo hi", on_answer, &answer) == ARGO_SUCCESS, "Query failed");
+    free(answer.content);
+    TEST_ASSERT(provider->query(provider, "fail", on_answer, &answer) == E_CI_CONFUSED, "Failure expected");
+
+    TEST_ASSERT(claude_code_set_session(provider, "telemetry") == ARGO_SUCCESS, "Set session failed");
+    stream_capture_t capture = {0};
+    int result = provider->stream(provider, "hello", on_chunk, &capture);
+    claude_code_set_session(provider, NULL);
+    TEST_ASSERT(result == ARGO_SUCCESS && capture.total == strlen("ok"), "Session turn failed");
+
+    provider_telemetry_stats_t stats[PROVIDER_TELEMETRY_MAX_ENTRIES];
+    int count = provider_telemetry_get_stats(stats, PROVIDER_TELEMETRY_MAX_ENTRIES);
+    const provider_telemetry_stats_t* entry = NULL;
+    for (int i = 0; i < count; i++) {
+        if (strcmp(stats[i].provider, CLAUDE_CODE_PROVIDER_NAME) == 0) entry = &stats[i];
+    }
+    TEST_ASSERT(entry != NULL, "Stats should have a claude_code entry");
+    TEST_ASSERT(entry->calls == 3 && entry->failures == 1 && entry->streamed == 1,
+                "Calls, failures and streams should be counted");
+    TEST_ASSERT(entry->prompt_tokens == 11 && entry->completion_tokens == 5,
+                "Session usage should be recorded");
+    TEST_ASSERT(entry->request_bytes >= strlen("echo hi") + strlen("fail") + strlen("hello"),
+                "Prompt bytes should be recorded");
+    TEST_ASSERT(entry->response_bytes >= strlen("echo hi") + strlen("ok"), "Response bytes should be recorded");
+    TEST_PASS("Calls are recorded in provider telemetry");
+}
+
+int main(void) {
+    int failed = 0;
+
+    printf("==========================================\n");
+    printf("Claude Code Provider Tests\n");
+    printf("==========================================\n\n");
+
+    if (install_fake_claude() != 0) {
+        fprintf(stderr, "FAIL: could not install fake claude\n");
+        return 1;
+    }
+    ci_provider_t* provider = claude_code_create_provider(NULL);
+    if (!provider) {
+        fprintf(stderr, "FAIL: could not create provider\n");
+        remove_fake_claude();
+        return 1;
+    }
+
+    failed += test_large_query(provider);
+    failed += test_stream_chunks(provider);
+    failed += test_large_prompt(provider);
+    failed += test_cli_failure(provider);
+    failed += test_telemetry(provider);
+
+    provider->cleanup(provider);
+    claude_session_pool_cleanup();
+    remove_fake_claude();
+
+    printf("\n");
+    if (failed == 0) {
+        printf("All claude code provider tests passed!\n");
+        return 0;
+    } else {
+        printf("%d claude code provider tests failed\n", failed);
+        return 1;
+    }
+}
@@ -0,0 +1,321 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* mkstemp() */
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/types.h>
+
+/* Project includes */
+#include "argo_claude_session_pool.h"
+#include "argo_error.h"
+#include "argo_limits.h"
+
+/* Test utilities */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "FAIL: %s\n", message); \
+            return 1; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        return 0; \
+    } while(0)
+
+#define TURN_TIMEOUT_MS 5000
+#define SILENT_TIMEOUT_MS 300
+#define CONCURRENT_THREADS 4
+#define CONCURRENT_TURNS 5
+
+/* Fake CLI: answers each line with a progress frame, then a result naming
+ * the turn on this process, its pid and its arguments, with usage */
+static const char* ECHO_SCRIPT =
+    "n=0\n"
+    "while read line; do\n"
+    "  n=$((n+1))\n"
+    "  printf '{\"type\":\"system\",\"subtype\":\"init\"}\\n'\n"
+    "  printf '{\"type\":\"result\",\"subtype\":\"success\",\"is_error\":false,"
+    "\"result\":\"turn %d pid %d args %s\",\"session_id\":\"s%d\","
+    "\"usage\":{\"input_tokens\":7,\"output_tokens\":3}}\\n' \"$n\" \"$$\" \"$*\" \"$$\"\n"
+    "done\n";
+
+/* Fake CLI that reads but never answers */
+static const char* SILENT_SCRIPT = "while read line; do :; done\n";
+
+/* Fake CLI whose turns all fail */
+static const char* ERROR_SCRIPT =
+    "while read line; do\n"
+    "  printf '{\"type\":\"result\",\"subtype\":\"error\",\"is_error\":true,\"result\":\"bad\"}\\n'\n"
+    "done\n";
+
+static char g_script_path[ARGO_PATH_MAX];
+
+/* Helper: Write script to a temp file and create a pool running it */
+static claude_session_pool_t* script_pool(const char* script, int max_workers, int max_turns) {
+    snprintf(g_script_path, sizeof(g_script_path), "/tmp/argo_test_claude_XXXXXX");
+    int fd = mkstemp(g_script_path);
+    if (fd < 0) return NULL;
+    ssize_t written = write(fd, script, strlen(script));
+    close(fd);
+    if (written != (ssize_t)strlen(script)) return NULL;
+
+    const char* command[] = { "/bin/sh", g_script_path, NULL };
+    return claude_session_pool_create(command, max_workers, max_turns);
+}
+
+/* Helper: Destroy pool and remove its script */
+static void script_pool_destroy(claude_session_pool_t* pool) {
+    claude_session_pool_destroy(pool);
+    unlink(g_script_path);
+}
+
+/* Helper: Run a turn and parse "turn N pid P" from the answer */
+static int run_turn(claude_session_pool_t* pool, const char* session, int* turn, int* pid, char** args) {
+    char* response = NULL;
+    int result = claude_session_pool_query(pool, session, NULL, "hello", TURN_TIMEOUT_MS, &response, NULL);
+    if (result != ARGO_SUCCESS) return result;
+
+    if (sscanf(response, "turn %d pid %d", turn, pid) != 2) {
+        free(response);
+        return E_PROTOCOL_FORMAT;
+    }
+    if (args) {
+        *args = response;
+    } else {
+        free(response);
+    }
+    return ARGO_SUCCESS;
+}
+
+/* Test: Turns of one session reuse one warm process */
+static int test_affinity(void) {
+    claude_session_pool_t* pool = script_pool(ECHO_SCRIPT, 2, 10);
+    TEST_ASSERT(pool != NULL, "Pool creation failed");
+
+    int turn1 = 0, pid1 = 0, turn2 = 0, pid2 = 0;
+    TEST_ASSERT(run_turn(pool, "a", &turn1, &pid1, NULL) == ARGO_SUCCESS, "First turn failed");
+    TEST_ASSERT(run_turn(pool, "a", &turn2, &pid2, NULL) == ARGO_SUCCESS, "Second turn failed");
+    TEST_ASSERT(pid1 == pid2, "Session should stay on its worker");
+    TEST_ASSERT(turn1 == 1 && turn2 == 2, "Process should see both turns");
+
+    claude_session_pool_stats_t stats;
+    claude_session_pool_get_stats(pool, &stats);
+    TEST_ASSERT(stats.turns == 2 && stats.warm_turns == 1, "Second turn should be warm");
+    TEST_ASSERT(stats.spawns == 1 && stats.workers == 1 && stats.busy == 0, "One worker expected");
+
+    script_pool_destroy(pool);
+    TEST_PASS("Turns of a session reuse one process");
+}
+
+/* Test: Different sessions get different workers */
+static int test_separate_sessions(void) {
+    claude_session_pool_t* pool = script_pool(ECHO_SCRIPT, 2, 10);
+    TEST_ASSERT(pool != NULL, "Pool creation failed");
+
+    int turn_a = 0, pid_a = 0, turn_b = 0, pid_b = 0;
+    TEST_ASSERT(run_turn(pool, "a", &turn_a, &pid_a, NULL) == ARGO_SUCCESS, "Turn of a failed");
+    TEST_ASSERT(run_turn(pool, "b", &turn_b, &pid_b, NULL) == ARGO_SUCCESS, "Turn of b failed");
+    TEST_ASSERT(pid_a != pid_b, "Sessions should not share a process");
+    TEST_ASSERT(turn_a == 1 && turn_b == 1, "Each process should start fresh");
+
+    script_pool_destroy(pool);
+    TEST_PASS("Different sessions get different workers");
+}
+
+/* Test: Recycling after max_turns resumes the conversation */
+static int test_recycle_resumes(void) {
+    claude_session_pool_t* pool = script_pool(ECHO_SCRIPT, 2, 2);
+    TEST_ASSERT(pool != NULL, "Pool creation failed");
+
+    int turn = 0, pid1 = 0, pid2 = 0, pid3 = 0;
+    char* args = NULL;
+    TEST_ASSERT(run_turn(pool, "a", &turn, &pid1, NULL) == ARGO_SUCCESS, "Turn 1 failed");
+    TEST_ASSERT(run_turn(pool, "a", &turn, &pid2, NULL) == ARGO_SUCCESS, "Turn 2 failed");
+    TEST_ASSERT(run_turn(pool, "a", &turn, &pid3, &args) == ARGO_SUCCESS, "Turn 3 failed");
+    TEST_ASSERT(pid1 == pid2, "Process should serve max_turns turns");
+    TEST_ASSERT(pid3 != pid1 && turn == 1, "Process should be recycled after max_turns");
+
+    char expected[ARGO_BUFFER_SMALL];
+    snprintf(expected, sizeof(expected), "%s s%d", CLAUDE_SESSION_ARG_RESUME, pid2);
+    bool resumed = strstr(args, expected) != NULL;
+    free(args);
+    TEST_ASSERT(resumed, "Replacement should resume the last CLI session id");
+
+    claude_session_pool_stats_t stats;
+    claude_session_pool_get_stats(pool, &stats);
+    TEST_ASSERT(stats.recycles == 1 && stats.spawns == 2, "One recycle expected");
+
+    script_pool_destroy(pool);
+    TEST_PASS("Recycled worker resumes the session");
+}
+
+/* Test: A dead process is replaced on the next turn */
+static int test_dead_process(void) {
+    claude_session_pool_t* pool = script_pool(ECHO_SCRIPT, 2, 10);
+    TEST_ASSERT(pool != NULL, "Pool creation failed");
+
+    int turn = 0, pid1 = 0, pid2 = 0;
+    TEST_ASSERT(run_turn(pool, "a", &turn, &pid1, NULL) == ARGO_SUCCESS, "First turn failed");
+    kill((pid_t)pid1, SIGKILL);
+    usleep(50000);
+
+    TEST_ASSERT(run_turn(pool, "a", &turn, &pid2, NULL) == ARGO_SUCCESS, "Turn after crash failed");
+    TEST_ASSERT(pid2 != pid1 && turn == 1, "Dead process should be replaced");
+
+    kill((pid_t)pid2, SIGKILL);
+    usleep(50000);
+    TEST_ASSERT(claude_session_pool_reap(pool, CLAUDE_SESSION_POOL_DEFAULT_IDLE_SECONDS) == 1,
+                "Reap should stop the dead worker");
+
+    script_pool_destroy(pool);
+    TEST_PASS("Dead process replaced and reaped");
+}
+
+/* Test: With every worker taken, a new session takes over the idle one */
+static int test_takeover(void) {
+    claude_session_pool_t* pool = script_pool(ECHO_SCRIPT, 1, 10);
+    TEST_ASSERT(pool != NULL, "Pool creation failed");
+
+    int turn = 0, pid_a = 0, pid_b = 0, pid_a2 = 0;
+    char* args = NULL;
+    TEST_ASSERT(run_turn(pool, "a", &turn, &pid_a, NULL) == ARGO_SUCCESS, "Turn of a failed");
+    TEST_ASSERT(run_turn(pool, "b", &turn, &pid_b, NULL) == ARGO_SUCCESS, "Turn of b failed");
+    TEST_ASSERT(pid_b != pid_a && turn == 1, "b should not see a's conversation");
+    TEST_ASSERT(run_turn(pool, "a", &turn, &pid_a2, &args) == ARGO_SUCCESS, "Second turn of a failed");
+
+    char expected[ARGO_BUFFER_SMALL];
+    snprintf(expected, sizeof(expected), "%s s%d", CLAUDE_SESSION_ARG_RESUME, pid_a);
+    bool resumed = strstr(args, expected) != NULL;
+    free(args);
+    TEST_ASSERT(resumed, "a should resume on the taken-over worker");
+
+    script_pool_destroy(pool);
+    TEST_PASS("New session takes over the idle worker");
+}
+
+/* Thread arguments for concurrent turns */
+typedef struct {
+    claude_session_pool_t* pool;
+    const char* session;
+    int failures;
+} turn_thread_t;
+
+/* Helper: Run CONCURRENT_TURNS turns of one session */
+static void* turn_thread(void* arg) {
+    turn_thread_t* args = (turn_thread_t*)arg;
+    for (int i = 0; i < CONCURRENT_TURNS; i++) {
+        int turn = 0, pid = 0;
+        if (run_turn(args->pool, args->session, &turn, &pid, NULL) != ARGO_SUCCESS) {
+            args->failures++;
+        }
+    }
+    return NULL;
+}
+
+/* Test: Concurrent turns of a session run in order on its worker */
+static int test_concurrent_turns(void) {
+    claude_session_pool_t* pool = script_pool(ECHO_SCRIPT, 2, 50);
+    TEST_ASSERT(pool != NULL, "Pool creation failed");
+
+    pthread_t threads[CONCURRENT_THREADS];
+    turn_thread_t args[CONCURRENT_THREADS];
+    for (int i = 0; i < CONCURRENT_THREADS; i++) {
+        args[i] = (turn_thread_t){ pool, i % 2 ? "a" : "b", 0 };
+        pthread_create(&threads[i], NULL, turn_thread, &args[i]);
+    }
+    int failures = 0;
+    for (int i = 0; i < CONCURRENT_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+        failures += args[i].failures;
+    }
+    TEST_ASSERT(failures == 0, "Concurrent turns failed");
+
+    claude_session_pool_stats_t stats;
+    claude_session_pool_get_stats(pool, &stats);
+    TEST_ASSERT(stats.turns == CONCURRENT_THREADS * CONCURRENT_TURNS, "Every turn should be answered");
+    TEST_ASSERT(stats.spawns == 2, "Each session should keep its own process");
+
+    script_pool_destroy(pool);
+    TEST_PASS("Concurrent turns share their session's worker");
+}
+
+/* Test: A turn reports the result frame's usage and its bytes */
+static int test_turn_usage(void) {
+    claude_session_pool_t* pool = script_pool(ECHO_SCRIPT, 1, 10);
+    TEST_ASSERT(pool != NULL, "Pool creation failed");
+
+    char* response = NULL;
+    claude_session_turn_t turn;
+    int result = claude_session_pool_query(pool, "a", NULL, "hello", TURN_TIMEOUT_MS, &response, &turn);
+    TEST_ASSERT(result == ARGO_SUCCESS, "Turn failed");
+    TEST_ASSERT(turn.usage.prompt_tokens == 7 && turn.usage.completion_tokens == 3,
+                "Usage should come from the result frame");
+    TEST_ASSERT(turn.request_bytes > strlen("hello"), "Turn line bytes should be counted");
+    TEST_ASSERT(turn.response_bytes > strlen(response), "Progress and result frames should be counted");
+    TEST_ASSERT(turn.ttfb_ms >= 0 && turn.queue_ms >= 0, "Timings should be set");
+    free(response);
+
+    script_pool_destroy(pool);
+    TEST_PASS("Turn reports usage and bytes");
+}
+
+/* Test: Silent or failing CLI reports errors and is recycled */
+static int test_failures(void) {
+    claude_session_pool_t* pool = script_pool(SILENT_SCRIPT, 1, 10);
+    TEST_ASSERT(pool != NULL, "Pool creation failed");
+
+    char* response = NULL;
+    int result = claude_session_pool_query(pool, "a", NULL, "hello", SILENT_TIMEOUT_MS, &response, NULL);
+    TEST_ASSERT(result == E_CI_TIMEOUT && response == NULL, "Silent CLI should time out");
+
+    claude_session_pool_stats_t stats;
+    claude_session_pool_get_stats(pool, &stats);
+    TEST_ASSERT(stats.failures == 1 && stats.workers == 0, "Timed out worker should be stopped");
+    script_pool_destroy(pool);
+
+    pool = script_pool(ERROR_SCRIPT, 1, 10);
+    TEST_ASSERT(pool != NULL, "Pool creation failed");
+    result = claude_session_pool_query(pool, "a", NULL, "hello", TURN_TIMEOUT_MS, &response, NULL);
+    TEST_ASSERT(result == E_CI_CONFUSED && response == NULL, "Error result should fail the turn");
+    script_pool_destroy(pool);
+
+    TEST_PASS("Timeouts and error results fail the turn");
+}
+
+int main(void) {
+    int failed = 0;
+
+    printf("==========================================\n");
+    printf("Claude Session Pool Tests\n");
+    printf("==========================================\n\n");
+
+    failed += test_affinity();
+    failed += test_separate_sessions();
+    failed += test_recycle_resumes();
+    failed += test_dead_process();
+    failed += test_takeover();
+    failed += test_concurrent_turns();
+    failed += test_turn_usage();
+    failed += test_failures();
+
+    printf("\n");
+    if (failed == 0) {
+        printf("All claude session pool tests passed!\n");
+        return 0;
+    } else {
+        printf("%d claude session pool tests failed\n", failed);
+        return 1;
+    }
+}
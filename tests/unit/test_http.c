@@ -6,6 +6,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
 #include "../include/argo_http.h"
 #include "../include/argo_error.h"
 
@@ -338,6 +343,223 @@ static void test_null_parameter_handling(void) {
     PASS();
 }
 
+/* Keep-alive echo server: answers a fixed number of requests, counts connections.
+ * The body and any X-Argo-Echo request header are sent back. */
+#define ECHO_SERVER_REQUESTS 3
+#define ECHO_BUFFER_SIZE 8192
+#define ECHO_REQUEST_TIMEOUT 2
+#define ECHO_HEADER "X-Argo-Echo: "
+#define LONG_HEADER_LEN 3000      /* Well past the old 1024-byte header line */
+
+typedef struct {
+    int listen_fd;
+    int port;
+    int requests;
+    int connections;
+} echo_server_t;
+
+static void* echo_server_thread(void* arg) {
+    echo_server_t* server = (echo_server_t*)arg;
+    char buf[ECHO_BUFFER_SIZE];
+    int served = 0;
+
+    while (served < server->requests) {
+        int fd = accept(server->listen_fd, NULL, NULL);
+        if (fd < 0) break;
+        server->connections++;
+
+        size_t used = 0;
+        while (served < server->requests) {
+            ssize_t n = read(fd, buf + used, sizeof(buf) - used - 1);
+            if (n <= 0) break;
+            used += (size_t)n;
+            buf[used] = '\0';
+
+            char* end = strstr(buf, "\r\n\r\n");
+            if (!end) continue;
+            char* length = strstr(buf, "Content-Length: ");
+            size_t body_len = length && length < end ? (size_t)atoi(length + 16) : 0;
+            size_t header_len = (size_t)(end + 4 - buf);
+            if (used < header_len + body_len) continue;
+
+            char* echo = strstr(buf, ECHO_HEADER);
+            int echo_len = 0;
+            if (echo && echo < end) {
+                echo += strlen(ECHO_HEADER);
+                echo_len = (int)(strstr(echo, "\r\n") - echo);
+            }
+
+            char reply[ECHO_BUFFER_SIZE];
+            int len = snprintf(reply, sizeof(reply),
+                               "HTTP/1.1 200 OK\r\nX-Argo-Test: yes\r\n"
+                               ECHO_HEADER "%.*s\r\n"
+                               "Content-Length: %zu\r\n\r\n%.*s",
+                               echo_len, echo ? echo : "",
+                               body_len, (int)body_len, buf + header_len);
+            if (write(fd, reply, (size_t)len) != len) break;
+            served++;
+
+            used -= header_len + body_len;
+            memmove(buf, buf + header_len + body_len, used);
+        }
+        close(fd);
+    }
+
+    close(server->listen_fd);
+    return NULL;
+}
+
+static int echo_server_start(echo_server_t* server, pthread_t* thread, int requests) {
+    struct sockaddr_in addr = {0};
+    socklen_t addr_len = sizeof(addr);
+
+    memset(server, 0, sizeof(*server));
+    server->requests = requests;
+    server->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (server->listen_fd < 0) return -1;
+
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    if (bind(server->listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(server->listen_fd, 4) != 0 ||
+        getsockname(server->listen_fd, (struct sockaddr*)&addr, &addr_len) != 0) {
+        close(server->listen_fd);
+        return -1;
+    }
+    server->port = ntohs(addr.sin_port);
+
+    return pthread_create(thread, NULL, echo_server_thread, server);
+}
+
+/* Streamed body collector */
+typedef struct {
+    char data[ECHO_BUFFER_SIZE];
+    size_t len;
+} streamed_t;
+
+static void collect_chunk(const char* chunk, size_t len, void* userdata) {
+    streamed_t* out = (streamed_t*)userdata;
+    if (out->len + len < sizeof(out->data)) {
+        memcpy(out->data + out->len, chunk, len);
+        out->len += len;
+        out->data[out->len] = '\0';
+    }
+}
+
+/* Test in-process execution (plain and streaming) reuses one kept-alive connection */
+static void test_http_execute_keepalive(void) {
+    TEST("HTTP execute with connection reuse");
+
+    echo_server_t server;
+    pthread_t thread;
+    if (echo_server_start(&server, &thread, ECHO_SERVER_REQUESTS) != 0) {
+        FAIL("Failed to start echo server");
+        return;
+    }
+
+    char url[128];
+    snprintf(url, sizeof(url), "http://127.0.0.1:%d/echo", server.port);
+
+    /* Quotes would have broken the old shell command line */
+    const char* bodies[ECHO_SERVER_REQUESTS] = {
+        "{\"prompt\":\"it's 'quoted'\"}", "{\"n\":2}", "{\"n\":3}"
+    };
+    bool ok = true;
+    for (int i = 0; i < ECHO_SERVER_REQUESTS && ok; i++) {
+        http_request_t* req = http_request_new(HTTP_POST, url);
+        http_request_add_header(req, "Content-Type", "application/json");
+        http_request_set_body(req, bodies[i], strlen(bodies[i]));
+        req->timeout_seconds = ECHO_REQUEST_TIMEOUT;
+
+        /* Last request streams its body through the callback */
+        http_response_t* resp = NULL;
+        streamed_t streamed = {0};
+        if (i < ECHO_SERVER_REQUESTS - 1) {
+            ok = http_execute(req, &resp) == ARGO_SUCCESS &&
+                 resp->body_len == strlen(bodies[i]) &&
+                 strcmp(resp->body, bodies[i]) == 0;
+        } else {
+            ok = http_execute_streaming(req, collect_chunk, &streamed, &resp) == ARGO_SUCCESS &&
+                 resp->body_len == 0 &&
+                 strcmp(streamed.data, bodies[i]) == 0;
+        }
+        ok = ok && resp->status_code == HTTP_STATUS_OK &&
+             http_response_get_header(resp, "x-argo-test") != NULL;
+        http_response_free(resp);
+        http_request_free(req);
+    }
+
+    /* Closing pooled connections lets the server thread finish */
+    http_cleanup();
+    pthread_join(thread, NULL);
+
+    if (!ok) {
+        FAIL("Request or echoed response incorrect");
+        return;
+    }
+    if (server.connections != 1) {
+        FAIL("Requests did not share one connection");
+        return;
+    }
+
+    /* Server is gone: transport failure is an error, not an empty 200 */
+    http_request_t* req = http_request_new(HTTP_GET, url);
+    req->timeout_seconds = ECHO_REQUEST_TIMEOUT;
+    http_response_t* resp = NULL;
+    int result = http_execute(req, &resp);
+    http_request_free(req);
+    if (result != E_SYSTEM_NETWORK || resp != NULL) {
+        http_response_free(resp);
+        FAIL("Refused connection should fail with E_SYSTEM_NETWORK");
+        return;
+    }
+
+    PASS();
+}
+
+/* Test a request header longer than any fixed line buffer is sent whole */
+static void test_http_long_header(void) {
+    TEST("HTTP long request header");
+
+    echo_server_t server;
+    pthread_t thread;
+    if (echo_server_start(&server, &thread, 1) != 0) {
+        FAIL("Failed to start echo server");
+        return;
+    }
+
+    char url[128];
+    snprintf(url, sizeof(url), "http://127.0.0.1:%d/echo", server.port);
+
+    char value[LONG_HEADER_LEN + 1];
+    for (int i = 0; i < LONG_HEADER_LEN; i++) {
+        value[i] = (char)('a' + i % 26);
+    }
+    value[LONG_HEADER_LEN] = '\0';
+
+    http_request_t* req = http_request_new(HTTP_GET, url);
+    http_request_add_header(req, "X-Argo-Echo", value);
+    req->timeout_seconds = ECHO_REQUEST_TIMEOUT;
+
+    http_response_t* resp = NULL;
+    int result = http_execute(req, &resp);
+    const char* echoed = (result == ARGO_SUCCESS) ? http_response_get_header(resp, "x-argo-echo") : NULL;
+    bool ok = echoed && strcmp(echoed, value) == 0;
+    http_response_free(resp);
+    http_request_free(req);
+
+    http_cleanup();
+    pthread_join(thread, NULL);
+
+    if (!ok) {
+        FAIL("Long header was not sent intact");
+        return;
+    }
+
+    PASS();
+}
+
 /* Main test runner */
 int main(void) {
     printf("\n");
@@ -355,6 +577,9 @@ int main(void) {
     test_http_status_codes();
     test_url_encoding();
     test_null_parameter_handling();
+    test_http_execute_keepalive();
+    test_http_long_header();
+    http_cleanup();
 
     /* Print summary */
     printf("\n");
@@ -218,10 +218,8 @@ static void test_json_escape_newline(void) {
         return;
     }
 
-    /* Current implementation may not escape newlines - that's OK for now */
-    /* Just verify it doesn't crash and produces some output */
-    if (offset == 0) {
-        FAIL("No output produced");
+    if (strcmp(buffer, "Line 1\\nLine 2") != 0) {
+        FAIL("Newline not escaped");
         return;
     }
 
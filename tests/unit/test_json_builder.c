@@ -0,0 +1,174 @@
+/* © 2025 Casey Koons All rights reserved */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project includes */
+#include "argo_json_builder.h"
+#include "argo_json_doc.h"
+#include "argo_api_common.h"
+#include "argo_error.h"
+
+/* Test utilities */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "FAIL: %s\n", message); \
+            return 1; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        return 0; \
+    } while(0)
+
+#define LARGE_PROMPT_SIZE (512 * 1024)
+
+/* Helper: String at pointer in parsed document equals expected */
+static bool string_at(const char* json, const char* pointer, const char* expected) {
+    json_node_t* root = NULL;
+    if (json_doc_parse(json, strlen(json), &root) != ARGO_SUCCESS) return false;
+    json_node_t* node = json_doc_get(root, pointer);
+    bool same = node && node->type == JSON_DOC_STRING && strcmp(node->text, expected) == 0;
+    json_doc_free(root);
+    return same;
+}
+
+/* Test: Commas, colons and scalar values */
+static int test_structure(void) {
+    json_builder_t json;
+    TEST_ASSERT(json_builder_init(&json, 0) == ARGO_SUCCESS, "Init");
+
+    json_builder_object_begin(&json);
+    json_builder_key_string(&json, "model", "m");
+    json_builder_key_int(&json, "max_tokens", 4096);
+    json_builder_key_bool(&json, "stream", true);
+    json_builder_key(&json, "temperature");
+    json_builder_double(&json, 0.7);
+    json_builder_key(&json, "stop");
+    json_builder_array_begin(&json);
+    json_builder_string(&json, "a");
+    json_builder_null(&json);
+    json_builder_raw(&json, "{\"x\":1}");
+    json_builder_array_end(&json);
+    json_builder_key(&json, "empty");
+    json_builder_array_begin(&json);
+    json_builder_array_end(&json);
+    json_builder_object_end(&json);
+
+    size_t length = 0;
+    char* out = json_builder_take(&json, &length);
+    TEST_ASSERT(out != NULL, "Take document");
+    TEST_ASSERT(strcmp(out, "{\"model\":\"m\",\"max_tokens\":4096,\"stream\":true,\"temperature\":0.7,"
+                            "\"stop\":[\"a\",null,{\"x\":1}],\"empty\":[]}") == 0, "Exact output");
+    TEST_ASSERT(length == strlen(out), "Length reported");
+    free(out);
+    TEST_PASS("Commas, colons and scalar values");
+}
+
+/* Test: Every string comes out as valid, lossless JSON */
+static int test_escaping(void) {
+    const char* nasty = "say \"hi\"\\\n\ttab\r\b\f\x01\x1f caf\xc3\xa9 </script>";
+    json_builder_t json;
+    json_builder_init(&json, strlen(nasty));
+    json_builder_object_begin(&json);
+    json_builder_key_string(&json, "we\"ird\nkey", nasty);
+    json_builder_object_end(&json);
+
+    char* out = json_builder_take(&json, NULL);
+    TEST_ASSERT(out != NULL, "Take document");
+    TEST_ASSERT(strstr(out, "\\u0001") && strstr(out, "\\u001f") && strstr(out, "\\n") &&
+                strstr(out, "\\\"hi\\\""), "Control characters and quotes escaped");
+    TEST_ASSERT(!strchr(out, '\n') && !strchr(out, '\t'), "No raw control characters");
+    TEST_ASSERT(string_at(out, "/we\"ird\nkey", nasty), "Round-trips through the parser");
+    free(out);
+    TEST_PASS("Every string comes out as valid, lossless JSON");
+}
+
+/* Test: Large multi-message chat request */
+static int test_large_chat(void) {
+    char* prompt = malloc(LARGE_PROMPT_SIZE + 1);
+    TEST_ASSERT(prompt != NULL, "Allocate prompt");
+    for (size_t i = 0; i < LARGE_PROMPT_SIZE; i++) {
+        prompt[i] = (i % 61 == 60) ? '\n' : (i % 97 == 0) ? '"' : (char)('a' + i % 26);
+    }
+    prompt[LARGE_PROMPT_SIZE] = '\0';
+
+    api_chat_message_t messages[] = {
+        { API_ROLE_SYSTEM, "Be brief." },
+        { API_ROLE_USER, prompt },
+        { API_ROLE_ASSISTANT, "Done." }
+    };
+    json_builder_t json;
+    json_builder_init(&json, LARGE_PROMPT_SIZE);
+    json_builder_object_begin(&json);
+    json_builder_key_string(&json, "model", "m");
+    TEST_ASSERT(api_json_chat_messages(&json, messages, 3) == ARGO_SUCCESS, "Messages written");
+    json_builder_object_end(&json);
+
+    char* out = json_builder_take(&json, NULL);
+    TEST_ASSERT(out != NULL, "Take large document");
+    TEST_ASSERT(string_at(out, "/messages/0/role", "system"), "System message first");
+    TEST_ASSERT(string_at(out, "/messages/1/content", prompt), "Large prompt intact");
+    TEST_ASSERT(string_at(out, "/messages/2/content", "Done."), "Assistant message last");
+    free(out);
+    free(prompt);
+    TEST_PASS("Large multi-message chat request");
+}
+
+/* Test: Misuse is reported and sticky */
+static int test_misuse(void) {
+    json_builder_t json;
+
+    json_builder_init(&json, 0);
+    json_builder_array_begin(&json);
+    json_builder_key(&json, "k");
+    json_builder_string(&json, "v");
+    TEST_ASSERT(json_builder_error(&json) == E_INPUT_INVALID, "Key inside array rejected");
+    json_builder_array_end(&json);
+    TEST_ASSERT(json_builder_take(&json, NULL) == NULL, "No document after error");
+
+    json_builder_init(&json, 0);
+    json_builder_object_begin(&json);
+    json_builder_string(&json, "no key");
+    TEST_ASSERT(json_builder_error(&json) == E_INPUT_INVALID, "Value without key rejected");
+    json_builder_free(&json);
+
+    json_builder_init(&json, 0);
+    json_builder_object_begin(&json);
+    TEST_ASSERT(json_builder_take(&json, NULL) == NULL, "Unclosed object rejected");
+
+    json_builder_init(&json, 0);
+    for (int i = 0; i <= JSON_BUILDER_MAX_DEPTH; i++) {
+        json_builder_array_begin(&json);
+    }
+    TEST_ASSERT(json_builder_error(&json) == E_INPUT_INVALID, "Depth limit enforced");
+    json_builder_free(&json);
+    TEST_PASS("Misuse is reported and sticky");
+}
+
+int main(void) {
+    int failed = 0;
+
+    printf("==========================================\n");
+    printf("JSON Builder Tests\n");
+    printf("==========================================\n\n");
+
+    failed += test_structure();
+    failed += test_escaping();
+    failed += test_large_chat();
+    failed += test_misuse();
+
+    printf("\n");
+    if (failed == 0) {
+        printf("All JSON builder tests passed!\n");
+        return 0;
+    } else {
+        printf("%d JSON builder tests failed\n", failed);
+        return 1;
+    }
+}
@@ -0,0 +1,600 @@
+/* © 2025 Casey Koons All rights reserved */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Project includes */
+#include "argo_memory.h"
+#include "argo_api_common.h"
+#include "argo_error.h"
+#include "argo_limits.h"
+
+/* Test utilities */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "FAIL: %s\n", message); \
+            return 1; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        return 0; \
+    } while(0)
+
+#define TEST_CONTEXT_LIMIT 8000
+#define LARGE_ITEM_COUNT 5000
+#define LARGE_CONTEXT_LIMIT 200000
+#define AUGMENT_ROUNDS 100
+#define AUGMENT_BUDGET_US 1000.0
+#define SEARCH_ITEM_COUNT 100000
+#define SEARCH_ROUNDS 50
+#define SEARCH_BUDGET_US 1000.0
+#define DECAY_ROUNDS 100000
+#define DECAY_BUDGET_US 1.0
+#define DECAY_TOLERANCE 1e-4f
+#define NEAR_ROUNDS 1000
+#define NEAR_BUDGET_US 100.0
+#define STORE_PATH_FORMAT "/tmp/argo_test_memory_%d.store"   /* Per PID: parallel runs */
+#define STORE_LOAD_BUDGET_US 50000.0
+
+static char g_store_path[ARGO_PATH_MAX];
+
+/* Helper: Microseconds since start */
+static double elapsed_us(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) * 1e6 + (double)(now.tv_nsec - start->tv_nsec) / 1e3;
+}
+
+/* Helper: Print a timing against its target. Informational only: wall-clock
+ * numbers depend on the machine and its load, so they never fail a test */
+static void report_timing(const char* what, int items, double us, double target_us) {
+    printf("  %s over %d items: %.3f us (target < %.0f us)%s\n", what, items, us, target_us,
+           us < target_us ? "" : " - over target");
+}
+
+/* Test: Same content is merged, other types are not */
+static int test_dedup(void) {
+    ci_memory_digest_t* digest = memory_digest_create(TEST_CONTEXT_LIMIT);
+    TEST_ASSERT(digest != NULL, "Create failed");
+
+    memory_add_item(digest, MEMORY_TYPE_FACT, "Build uses make", "Argo");
+    uint32_t first = digest->last_item_id;
+    memory_add_item(digest, MEMORY_TYPE_FACT, "Build uses make", "Maia");
+    bool merged = digest->last_item_id == first && digest->item_count == 1;
+    memory_item_t* item = memory_find_item(digest, first);
+    bool counted = item && item->relevance.access_count == 1;
+    memory_add_item(digest, MEMORY_TYPE_DECISION, "Build uses make", "Argo");
+    bool typed = digest->item_count == 2 && digest->last_item_id != first;
+    bool valid = memory_validate_digest(digest) == ARGO_SUCCESS;
+    memory_digest_destroy(digest);
+
+    TEST_ASSERT(merged, "Repeated content should merge");
+    TEST_ASSERT(counted, "Merge should count the repeat");
+    TEST_ASSERT(typed, "Same text of another type is a separate memory");
+    TEST_ASSERT(valid, "Digest should validate");
+    TEST_PASS("Repeated memories are merged");
+}
+
+/* Test: Suggestions are best first and skip selected items */
+static int test_suggest_order(void) {
+    ci_memory_digest_t* digest = memory_digest_create(TEST_CONTEXT_LIMIT);
+    TEST_ASSERT(digest != NULL, "Create failed");
+
+    memory_add_item(digest, MEMORY_TYPE_FACT, "Daemon listens on port 9876", "Argo");
+    memory_add_item(digest, MEMORY_TYPE_ERROR, "Socket bind fails when the daemon port is taken", "Argo");
+    uint32_t bind_id = digest->last_item_id;
+    memory_add_item(digest, MEMORY_TYPE_DECISION, "Workflows are written in JSON", "Maia");
+    memory_add_item(digest, MEMORY_TYPE_FACT, "Tests run with make test-quick", "Maia");
+
+    int count = memory_suggest_relevant(digest, "why does the daemon socket bind fail", 2);
+    bool best = count == 2 && digest->suggested[0]->id == bind_id;
+    bool ordered = count == 2 && strstr(digest->suggested[1]->content, "Daemon") != NULL;
+
+    memory_select_item(digest, bind_id);
+    count = memory_suggest_relevant(digest, "why does the daemon socket bind fail", MEMORY_SUGGESTION_MAX);
+    bool skipped = count == 1 && digest->suggested[0]->id != bind_id;
+
+    count = memory_suggest_relevant(digest, "unrelated words only", MEMORY_SUGGESTION_MAX);
+    bool fallback = count == 3;
+    memory_digest_destroy(digest);
+
+    TEST_ASSERT(best, "Best match should come first");
+    TEST_ASSERT(ordered, "Partial match should come second");
+    TEST_ASSERT(skipped, "Selected and unmatched items should not be suggested");
+    TEST_ASSERT(fallback, "Without a match every unselected item is ranked");
+    TEST_PASS("Suggestions are ranked");
+}
+
+/* Test: Equal matches are ordered by use */
+static int test_access_boost(void) {
+    ci_memory_digest_t* digest = memory_digest_create(TEST_CONTEXT_LIMIT);
+    TEST_ASSERT(digest != NULL, "Create failed");
+
+    memory_add_item(digest, MEMORY_TYPE_FACT, "Parser handles yaml anchors", "Argo");
+    uint32_t used = digest->last_item_id;
+    memory_add_item(digest, MEMORY_TYPE_FACT, "Parser handles json pointers", "Argo");
+    for (int i = 0; i < 3; i++) {
+        memory_add_item(digest, MEMORY_TYPE_FACT, "Parser handles yaml anchors", "Argo");
+    }
+    memory_update_relevance(digest, memory_find_item(digest, used), MEMORY_DEFAULT_RELEVANCE);
+
+    int count = memory_suggest_relevant(digest, "parser handles", MEMORY_SUGGESTION_MAX);
+    bool boosted = count == 2 && digest->suggested[0]->id == used;
+    memory_digest_destroy(digest);
+
+    TEST_ASSERT(boosted, "More used memory should rank first");
+    TEST_PASS("Use breaks ties between equal matches");
+}
+
+/* Test: BM25 top-k over 100k items stays under a millisecond */
+static int test_search_large(void) {
+    static const char* words[] = {
+        "socket", "parser", "workflow", "daemon", "registry", "template", "provider",
+        "cache", "timeout", "buffer", "session", "router", "thread", "signal"
+    };
+    int word_count = (int)(sizeof(words) / sizeof(words[0]));
+    ci_memory_digest_t* digest = memory_digest_create(LARGE_CONTEXT_LIMIT);
+    TEST_ASSERT(digest != NULL, "Create failed");
+
+    char content[ARGO_BUFFER_STANDARD];
+    for (int i = 0; i < SEARCH_ITEM_COUNT; i++) {
+        snprintf(content, sizeof(content), "The %s talks to the %s through item%d and %s",
+                 words[i % word_count], words[(i / word_count) % word_count], i,
+                 words[(i * 7) % word_count]);
+        memory_add_item(digest, MEMORY_TYPE_FACT, content, "Argo");
+    }
+    TEST_ASSERT(digest->item_count == SEARCH_ITEM_COUNT, "Items should be stored");
+
+    int count = 0;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < SEARCH_ROUNDS; i++) {
+        count = memory_suggest_relevant(digest, "why does item4242 time out in the daemon", MEMORY_SUGGESTION_MAX);
+    }
+    report_timing("top-k", SEARCH_ITEM_COUNT, elapsed_us(&start) / SEARCH_ROUNDS, SEARCH_BUDGET_US);
+
+    bool found = count > 0 && strstr(digest->suggested[0]->content, "item4242 ") != NULL;
+    memory_digest_destroy(digest);
+
+    TEST_ASSERT(found, "Rare term should rank its item first");
+    TEST_PASS("Search scales to 100k items");
+}
+
+/* Test: Suggestions and selection respect half the context */
+static int test_budget(void) {
+    ci_memory_digest_t* digest = memory_digest_create(100);
+    TEST_ASSERT(digest != NULL, "Create failed");
+    TEST_ASSERT(digest->max_allowed_size == 50, "Budget should be half the context");
+
+    memory_add_item(digest, MEMORY_TYPE_FACT, "thirty bytes of budget items..", "Argo");
+    uint32_t first = digest->last_item_id;
+    memory_add_item(digest, MEMORY_TYPE_FACT, "another thirty bytes of items.", "Argo");
+    uint32_t second = digest->last_item_id;
+
+    int count = memory_suggest_relevant(digest, "budget items", MEMORY_SUGGESTION_MAX);
+    int selected = memory_select_item(digest, first);
+    int over = memory_select_item(digest, second);
+    int missing = memory_select_item(digest, 9999);
+    bool within = memory_check_size_limit(digest);
+    memory_digest_destroy(digest);
+
+    TEST_ASSERT(count == 1, "Only one item fits the budget");
+    TEST_ASSERT(selected == ARGO_SUCCESS, "First item should select");
+    TEST_ASSERT(over == E_INPUT_TOO_LARGE, "Second item should not fit");
+    TEST_ASSERT(missing == E_NOT_FOUND, "Unknown id should be reported");
+    TEST_ASSERT(within, "Digest should stay within budget");
+    TEST_PASS("Budget is enforced");
+}
+
+/* Test: Breadcrumbs keep the most recent */
+static int test_breadcrumbs(void) {
+    ci_memory_digest_t* digest = memory_digest_create(TEST_CONTEXT_LIMIT);
+    TEST_ASSERT(digest != NULL, "Create failed");
+
+    char crumb[ARGO_BUFFER_TINY];
+    for (int i = 0; i < MEMORY_BREADCRUMB_MAX + 5; i++) {
+        snprintf(crumb, sizeof(crumb), "step %d", i);
+        memory_add_breadcrumb(digest, crumb);
+    }
+    bool full = digest->breadcrumb_count == MEMORY_BREADCRUMB_MAX;
+    bool oldest = strcmp(digest->breadcrumbs[0], "step 5") == 0;
+    memory_digest_destroy(digest);
+
+    TEST_ASSERT(full, "Breadcrumbs should stay bounded");
+    TEST_ASSERT(oldest, "Oldest breadcrumbs should go first");
+    TEST_PASS("Breadcrumbs roll over");
+}
+
+/* Test: JSON keeps items, scores and selection */
+static int test_json_round_trip(void) {
+    ci_memory_digest_t* digest = memory_digest_create(TEST_CONTEXT_LIMIT);
+    TEST_ASSERT(digest != NULL, "Create failed");
+
+    memory_add_item(digest, MEMORY_TYPE_FACT, "Line \"one\"\nwith escapes", "Argo");
+    memory_add_item(digest, MEMORY_TYPE_SUCCESS, "Caching fixed the latency", "Maia");
+    uint32_t chosen = digest->last_item_id;
+    memory_select_item(digest, chosen);
+    memory_update_relevance(digest, memory_find_item(digest, chosen), 0.75f);
+
+    char* json = memory_digest_to_json(digest);
+    ci_memory_digest_t* loaded = json ? memory_digest_from_json(json, TEST_CONTEXT_LIMIT) : NULL;
+    free(json);
+    memory_digest_destroy(digest);
+    TEST_ASSERT(loaded != NULL, "Round trip failed");
+
+    memory_item_t* first = memory_find_item(loaded, 1);
+    memory_item_t* second = memory_find_item(loaded, chosen);
+    bool items = loaded->item_count == 2 && first &&
+                 strcmp(first->content, "Line \"one\"\nwith escapes") == 0;
+    bool kept = second && second->type == MEMORY_TYPE_SUCCESS && second->relevance.score == 0.75f &&
+                loaded->selected_count == 1 && loaded->selected[0] == second;
+    memory_add_item(loaded, MEMORY_TYPE_FACT, "Added after load", "Argo");
+    bool next_id = loaded->last_item_id == chosen + 1;
+    memory_digest_destroy(loaded);
+
+    TEST_ASSERT(items, "Items should reload");
+    TEST_ASSERT(kept, "Scores and selection should reload");
+    TEST_ASSERT(next_id, "New ids should follow loaded ones");
+    TEST_PASS("JSON round trip");
+}
+
+/* Test: Augmenting with thousands of items stays in microseconds */
+static int test_augment_large(void) {
+    ci_memory_digest_t* digest = memory_digest_create(LARGE_CONTEXT_LIMIT);
+    TEST_ASSERT(digest != NULL, "Create failed");
+
+    char content[ARGO_BUFFER_SMALL];
+    for (int i = 0; i < LARGE_ITEM_COUNT; i++) {
+        snprintf(content, sizeof(content), "Module %d handles request parsing batch %d", i, i % 97);
+        memory_add_item(digest, MEMORY_TYPE_FACT, content, "Argo");
+    }
+    memory_add_item(digest, MEMORY_TYPE_ERROR, "Zeppelin telemetry overflowed the ring buffer", "Argo");
+    memory_add_breadcrumb(digest, "Profiling telemetry");
+
+    char* augmented = NULL;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < AUGMENT_ROUNDS; i++) {
+        free(augmented);
+        augmented = NULL;
+        api_augment_prompt_with_memory(digest, "fix zeppelin telemetry overflow", &augmented);
+    }
+    report_timing("augment", LARGE_ITEM_COUNT, elapsed_us(&start) / AUGMENT_ROUNDS, AUGMENT_BUDGET_US);
+
+    bool relevant = augmented && strstr(augmented, "Zeppelin telemetry") != NULL;
+    bool exact = augmented && strstr(augmented, "## Current Task\nfix zeppelin telemetry overflow") != NULL;
+    bool bounded = digest->suggestion_count <= MEMORY_SUGGESTION_MAX;
+    free(augmented);
+    memory_digest_destroy(digest);
+
+    TEST_ASSERT(relevant, "Matching memory should be included");
+    TEST_ASSERT(exact, "Prompt should end the augmentation");
+    TEST_ASSERT(bounded, "Suggestions should stay bounded");
+    TEST_PASS("Augmentation scales to thousands of items");
+}
+
+/* Test: Rewordings merge, different facts do not */
+static int test_near_duplicates(void) {
+    ci_memory_digest_t* digest = memory_digest_create(TEST_CONTEXT_LIMIT);
+    TEST_ASSERT(digest != NULL, "Create failed");
+
+    memory_add_item(digest, MEMORY_TYPE_FACT, "The daemon listens on port 9876", "Argo");
+    uint32_t first = digest->last_item_id;
+    memory_add_item(digest, MEMORY_TYPE_FACT, "the Daemon listens on port 9876.", "Maia");
+    memory_add_item(digest, MEMORY_TYPE_FACT, "Port 9876: the daemon listens on", "Argo");
+    memory_item_t* item = memory_find_item(digest, first);
+    bool merged = digest->item_count == 1 && digest->last_item_id == first && item &&
+                  item->relevance.access_count == 2 &&
+                  strcmp(item->content, "The daemon listens on port 9876") == 0;
+
+    memory_add_item(digest, MEMORY_TYPE_FACT, "The daemon listens on port 9877", "Argo");
+    memory_add_item(digest, MEMORY_TYPE_ERROR, "The daemon listens on port 9876", "Argo");
+    bool distinct = digest->item_count == 3;
+
+    memory_add_breadcrumb(digest, "Check the parser tests");
+    memory_add_breadcrumb(digest, "Rebuild the daemon");
+    memory_add_breadcrumb(digest, "check the PARSER tests!");
+    bool crumbs = digest->breadcrumb_count == 2 &&
+                  strcmp(digest->breadcrumbs[1], "check the PARSER tests!") == 0;
+    memory_digest_destroy(digest);
+
+    TEST_ASSERT(merged, "Rewordings should merge into the stored item");
+    TEST_ASSERT(distinct, "Other values and types should stay separate");
+    TEST_ASSERT(crumbs, "Repeated breadcrumb should replace the old one");
+    TEST_PASS("Near duplicates are merged");
+}
+
+/* Test: Near-duplicate checks stay cheap as memory grows */
+static int test_near_large(void) {
+    ci_memory_digest_t* digest = memory_digest_create(LARGE_CONTEXT_LIMIT);
+    TEST_ASSERT(digest != NULL, "Create failed");
+
+    char content[ARGO_BUFFER_SMALL];
+    for (int i = 0; i < SEARCH_ITEM_COUNT; i++) {
+        snprintf(content, sizeof(content), "Worker %d owns queue %d", i, i % 509);
+        memory_add_item(digest, MEMORY_TYPE_FACT, content, "Argo");
+    }
+    TEST_ASSERT(digest->item_count == SEARCH_ITEM_COUNT, "Distinct facts should be kept");
+
+    /* Reworded repeats of existing facts */
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < NEAR_ROUNDS; i++) {
+        int n = (i * 97) % SEARCH_ITEM_COUNT;
+        snprintf(content, sizeof(content), "queue %d owns WORKER %d.", n % 509, n);
+        memory_add_item(digest, MEMORY_TYPE_FACT, content, "Argo");
+    }
+    report_timing("near-duplicate add", SEARCH_ITEM_COUNT, elapsed_us(&start) / NEAR_ROUNDS, NEAR_BUDGET_US);
+
+    bool compact = digest->item_count == SEARCH_ITEM_COUNT;
+    memory_digest_destroy(digest);
+
+    TEST_ASSERT(compact, "Repeats should merge");
+    TEST_PASS("Near-duplicate checks scale to 100k items");
+}
+
+/* Test: Decay is applied when scores are read, not stored */
+static int test_decay_lazy(void) {
+    ci_memory_digest_t* digest = memory_digest_create(TEST_CONTEXT_LIMIT);
+    TEST_ASSERT(digest != NULL, "Create failed");
+
+    memory_add_item(digest, MEMORY_TYPE_FACT, "Half life applies per week", "Argo");
+    memory_item_t* kept = memory_find_item(digest, digest->last_item_id);
+    memory_add_item(digest, MEMORY_TYPE_FACT, "Touched again after decay", "Argo");
+    memory_item_t* touched = memory_find_item(digest, digest->last_item_id);
+    memory_update_relevance(digest, kept, 0.8f);
+
+    time_t now = time(NULL);
+    memory_decay_relevance(digest, 0.5f);
+    bool lazy = kept->relevance.score == 0.8f &&
+                fabsf(memory_stored_relevance(digest, kept, now) - 0.4f) < DECAY_TOLERANCE;
+    bool timed = fabsf(memory_stored_relevance(digest, kept, now + (time_t)MEMORY_HALF_LIFE_SECONDS) -
+                       0.2f) < DECAY_TOLERANCE;
+
+    memory_add_item(digest, MEMORY_TYPE_FACT, "Touched again after decay", "Argo");
+    bool boosted = fabsf(memory_stored_relevance(digest, touched, time(NULL)) -
+                         (0.25f + MEMORY_ACCESS_BOOST)) < DECAY_TOLERANCE;
+
+    char* json = memory_digest_to_json(digest);
+    ci_memory_digest_t* loaded = json ? memory_digest_from_json(json, TEST_CONTEXT_LIMIT) : NULL;
+    free(json);
+    bool persisted = loaded &&
+                     fabsf(memory_stored_relevance(loaded, memory_find_item(loaded, kept->id), now) - 0.4f) <
+                     DECAY_TOLERANCE;
+    memory_digest_destroy(loaded);
+
+    bool ranged = memory_decay_relevance(digest, 1.5f) == E_INPUT_RANGE &&
+                  memory_update_relevance(digest, kept, -0.1f) == E_INPUT_RANGE;
+    memory_decay_relevance(digest, 0.0f);
+    bool forgotten = memory_stored_relevance(digest, kept, now) < DECAY_TOLERANCE;
+    memory_digest_destroy(digest);
+
+    TEST_ASSERT(lazy, "Decay should not rewrite stored scores");
+    TEST_ASSERT(timed, "Scores should halve per idle half-life");
+    TEST_ASSERT(boosted, "Use should boost the decayed score");
+    TEST_ASSERT(persisted, "Decay should survive a round trip");
+    TEST_ASSERT(ranged, "Out of range values should be rejected");
+    TEST_ASSERT(forgotten, "A factor of 0 should clear scores");
+    TEST_PASS("Lazy relevance decay");
+}
+
+/* Test: Decay ticks are O(1) and keep the stored-score ranking */
+static int test_decay_large(void) {
+    ci_memory_digest_t* digest = memory_digest_create(LARGE_CONTEXT_LIMIT);
+    TEST_ASSERT(digest != NULL, "Create failed");
+
+    char content[ARGO_BUFFER_SMALL];
+    for (int i = 0; i < SEARCH_ITEM_COUNT; i++) {
+        snprintf(content, sizeof(content), "Decaying memory %d", i);
+        memory_add_item(digest, MEMORY_TYPE_FACT, content, "Argo");
+    }
+    /* A few favorites, best last */
+    uint32_t favorites[] = { 77, 40000, 99999 };
+    int favorite_count = (int)(sizeof(favorites) / sizeof(favorites[0]));
+    for (int i = 0; i < favorite_count; i++) {
+        memory_update_relevance(digest, memory_find_item(digest, favorites[i]), 0.7f + 0.1f * (float)i);
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < DECAY_ROUNDS; i++) {
+        memory_decay_relevance(digest, 0.99999f);
+    }
+    report_timing("decay tick", SEARCH_ITEM_COUNT, elapsed_us(&start) / DECAY_ROUNDS, DECAY_BUDGET_US);
+
+    int count = memory_suggest_relevant(digest, NULL, favorite_count);
+    bool ordered = count == favorite_count;
+    for (int i = 0; ordered && i < favorite_count; i++) {
+        ordered = digest->suggested[i]->id == favorites[favorite_count - 1 - i];
+    }
+    memory_item_t* item = memory_find_item(digest, favorites[0]);
+    float expected = 0.7f * (float)pow(0.99999f, DECAY_ROUNDS);
+    bool decayed = fabsf(memory_stored_relevance(digest, item, time(NULL)) - expected) < DECAY_TOLERANCE * 10;
+    memory_digest_destroy(digest);
+
+    TEST_ASSERT(ordered, "Favorites should rank first, best first");
+    TEST_ASSERT(decayed, "Ticks should lower stored scores");
+    TEST_PASS("Decay ticks are constant time");
+}
+
+/* Test: Binary store reloads in place and stays writable */
+static int test_store_round_trip(void) {
+    ci_memory_digest_t* digest = memory_digest_create(TEST_CONTEXT_LIMIT);
+    TEST_ASSERT(digest != NULL, "Create failed");
+
+    snprintf(digest->ci_name, sizeof(digest->ci_name), "Argo");
+    memory_add_item(digest, MEMORY_TYPE_FACT, "Build uses make", "Argo");
+    memory_add_item(digest, MEMORY_TYPE_DECISION, "Use mmap for the memory store", NULL);
+    uint32_t chosen = digest->last_item_id;
+    memory_select_item(digest, chosen);
+    memory_update_relevance(digest, memory_find_item(digest, chosen), 0.75f);
+    memory_add_breadcrumb(digest, "Wrote the store");
+    memory_set_sunset_notes(digest, "Next: journal");
+
+    int saved = memory_save_to_file(digest, g_store_path);
+    memory_digest_destroy(digest);
+    ci_memory_digest_t* loaded = saved == ARGO_SUCCESS ? memory_load_from_file(g_store_path, TEST_CONTEXT_LIMIT) : NULL;
+    TEST_ASSERT(loaded != NULL, "Store round trip failed");
+
+    memory_item_t* item = memory_find_item(loaded, chosen);
+    bool kept = loaded->item_count == 2 && item && strcmp(item->content, "Use mmap for the memory store") == 0 &&
+                item->creator_ci == NULL && item->relevance.score == 0.75f &&
+                loaded->selected_count == 1 && loaded->selected[0] == item &&
+                strcmp(loaded->ci_name, "Argo") == 0 && loaded->breadcrumb_count == 1 &&
+                loaded->sunset_notes && strcmp(loaded->sunset_notes, "Next: journal") == 0;
+    bool mapped = loaded->index_mapped;
+
+    memory_add_item(loaded, MEMORY_TYPE_FACT, "Build uses make", "Maia");
+    bool merged = loaded->item_count == 2 && loaded->last_item_id == 1;
+    memory_add_item(loaded, MEMORY_TYPE_FACT, "Added after load", "Argo");
+    bool added = loaded->item_count == 3 && loaded->last_item_id == chosen + 1;
+    int suggested = memory_suggest_relevant(loaded, "how does the build run make", MEMORY_SUGGESTION_MAX);
+    bool valid = memory_validate_digest(loaded) == ARGO_SUCCESS;
+    memory_digest_destroy(loaded);
+    unlink(g_store_path);
+
+    TEST_ASSERT(kept, "Items, selection and notes should reload");
+    TEST_ASSERT(mapped, "Index should be used in place");
+    TEST_ASSERT(merged, "Dedup should see mapped items");
+    TEST_ASSERT(added, "New ids should follow loaded ones");
+    TEST_ASSERT(suggested >= 1, "Search should cover mapped items");
+    TEST_ASSERT(valid, "Loaded digest should validate");
+    TEST_PASS("Binary store round trip");
+}
+
+/* Test: Appends journal new items and compact when the journal grows */
+static int test_store_append(void) {
+    ci_memory_digest_t* digest = memory_digest_create(TEST_CONTEXT_LIMIT);
+    TEST_ASSERT(digest != NULL, "Create failed");
+
+    char content[ARGO_BUFFER_SMALL];
+    for (int i = 0; i < 20; i++) {
+        snprintf(content, sizeof(content), "Base memory number %d", i);
+        memory_add_item(digest, MEMORY_TYPE_FACT, content, "Argo");
+    }
+    int result = memory_save_to_file(digest, g_store_path);
+    memory_add_item(digest, MEMORY_TYPE_ERROR, "Journaled after save", "Maia");
+    if (result == ARGO_SUCCESS) result = memory_store_append(digest, g_store_path);
+    memory_digest_destroy(digest);
+
+    ci_memory_digest_t* loaded = result == ARGO_SUCCESS ? memory_load_from_file(g_store_path, TEST_CONTEXT_LIMIT) : NULL;
+    TEST_ASSERT(loaded != NULL, "Reload after append failed");
+    memory_item_t* item = memory_find_item(loaded, 21);
+    bool journaled = loaded->item_count == 21 && item && item->type == MEMORY_TYPE_ERROR &&
+                     strcmp(item->content, "Journaled after save") == 0 && strcmp(item->creator_ci, "Maia") == 0;
+
+    /* Outgrow the journal so the next append rewrites the base */
+    for (int i = 0; i < 40; i++) {
+        snprintf(content, sizeof(content), "Late memory number %d", i);
+        memory_add_item(loaded, MEMORY_TYPE_FACT, content, "Argo");
+    }
+    result = memory_store_append(loaded, g_store_path);
+    memory_digest_destroy(loaded);
+    loaded = result == ARGO_SUCCESS ? memory_load_from_file(g_store_path, TEST_CONTEXT_LIMIT) : NULL;
+    TEST_ASSERT(loaded != NULL, "Reload after compaction failed");
+    bool compacted = loaded->item_count == 61 && loaded->index_mapped && memory_find_item(loaded, 61);
+    memory_digest_destroy(loaded);
+    unlink(g_store_path);
+
+    TEST_ASSERT(journaled, "Appended item should reload");
+    TEST_ASSERT(compacted, "Compaction should fold the journal into the base");
+    TEST_PASS("Store append and compaction");
+}
+
+/* Test: JSON files from older releases still load */
+static int test_store_legacy_json(void) {
+    ci_memory_digest_t* digest = memory_digest_create(TEST_CONTEXT_LIMIT);
+    TEST_ASSERT(digest != NULL, "Create failed");
+    memory_add_item(digest, MEMORY_TYPE_FACT, "Saved as JSON", "Argo");
+    char* json = memory_digest_to_json(digest);
+    memory_digest_destroy(digest);
+    TEST_ASSERT(json != NULL, "Serialize failed");
+
+    FILE* file = fopen(g_store_path, "w");
+    bool written = file && fputs(json, file) >= 0;
+    if (file) fclose(file);
+    free(json);
+    ci_memory_digest_t* loaded = written ? memory_load_from_file(g_store_path, TEST_CONTEXT_LIMIT) : NULL;
+    bool kept = loaded && loaded->item_count == 1 && !loaded->index_mapped &&
+                strcmp(memory_find_item(loaded, 1)->content, "Saved as JSON") == 0;
+    memory_digest_destroy(loaded);
+    unlink(g_store_path);
+
+    TEST_ASSERT(kept, "Legacy JSON should load");
+    TEST_PASS("Legacy JSON store");
+}
+
+/* Test: Loading a large store costs a mapping, not a parse */
+static int test_store_load_large(void) {
+    ci_memory_digest_t* digest = memory_digest_create(LARGE_CONTEXT_LIMIT);
+    TEST_ASSERT(digest != NULL, "Create failed");
+
+    char content[ARGO_BUFFER_SMALL];
+    for (int i = 0; i < SEARCH_ITEM_COUNT; i++) {
+        snprintf(content, sizeof(content), "Stored memory %d about subsystem %d", i, i % 211);
+        memory_add_item(digest, MEMORY_TYPE_FACT, content, "Argo");
+    }
+    int saved = memory_save_to_file(digest, g_store_path);
+    memory_digest_destroy(digest);
+    TEST_ASSERT(saved == ARGO_SUCCESS, "Save failed");
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    ci_memory_digest_t* loaded = memory_load_from_file(g_store_path, LARGE_CONTEXT_LIMIT);
+    report_timing("store load", SEARCH_ITEM_COUNT, elapsed_us(&start), STORE_LOAD_BUDGET_US);
+
+    bool complete = loaded && loaded->item_count == SEARCH_ITEM_COUNT &&
+                    strcmp(memory_find_item(loaded, SEARCH_ITEM_COUNT)->content,
+                           "Stored memory 99999 about subsystem 196") == 0;
+    memory_digest_destroy(loaded);
+    unlink(g_store_path);
+
+    TEST_ASSERT(complete, "All items should load");
+    TEST_PASS("Large store loads without parsing");
+}
+
+int main(void) {
+    int failed = 0;
+
+    printf("==========================================\n");
+    printf("Memory Digest Tests\n");
+    printf("==========================================\n\n");
+
+    snprintf(g_store_path, sizeof(g_store_path), STORE_PATH_FORMAT, getpid());
+
+    failed += test_dedup();
+    failed += test_suggest_order();
+    failed += test_access_boost();
+    failed += test_search_large();
+    failed += test_budget();
+    failed += test_breadcrumbs();
+    failed += test_json_round_trip();
+    failed += test_augment_large();
+    failed += test_near_duplicates();
+    failed += test_near_large();
+    failed += test_decay_lazy();
+    failed += test_decay_large();
+    failed += test_store_round_trip();
+    failed += test_store_append();
+    failed += test_store_legacy_json();
+    failed += test_store_load_large();
+
+    printf("\n");
+    if (failed == 0) {
+        printf("All memory digest tests passed!\n");
+        return 0;
+    } else {
+        printf("%d memory digest tests failed\n", failed);
+        return 1;
+    }
+}
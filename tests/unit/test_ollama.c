@@ -0,0 +1,393 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* usleep(), MSG_NOSIGNAL */
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/* Project includes */
+#include "argo_ollama.h"
+#include "argo_ollama_transport.h"
+#include "argo_env_utils.h"
+#include "argo_error.h"
+
+/* Test utilities */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "FAIL: %s\n", message); \
+            return 1; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        return 0; \
+    } while(0)
+
+#define SERVER_POLL_MS 50
+#define SPLIT_DELAY_USEC 20000      /* Let the client see a partial response */
+#define REQUEST_MAX 65536
+
+/* Fake Ollama server behaviours */
+typedef enum {
+    SERVE_KEEP_ALIVE,           /* Normal HTTP/1.1 keep-alive */
+    SERVE_CLOSE_HEADER,         /* Connection: close, then close */
+    SERVE_SILENT_CLOSE,         /* Keep-alive headers, then close anyway */
+    SERVE_NOT_FOUND             /* 404 with an Ollama error body */
+} serve_mode_t;
+
+static int g_listen_fd = -1;
+static int g_port = 0;
+static bool g_stop = false;
+static pthread_mutex_t g_server_lock = PTHREAD_MUTEX_INITIALIZER;
+static serve_mode_t g_mode = SERVE_KEEP_ALIVE;
+static int g_accepts = 0;
+static int g_requests = 0;
+
+/* Non-streaming answer: escapes must be decoded by the client */
+static const char* QUERY_BODY =
+    "{\"model\":\"test\",\"response\":\"Hello \\\"world\\\"\\n\",\"done\":true}";
+
+/* Streaming answer, chunk boundaries deliberately inside lines */
+static const char* STREAM_CHUNKS[] = {
+    "{\"response\":\"Hel\",\"done\":false}\n{\"resp",
+    "onse\":\"lo \",\"done\":false}\n",
+    "{\"response\":\"world\",\"done\":false}\n{\"response\":\"\",\"done\":true}\n"
+};
+
+static const char* NOT_FOUND_BODY = "{\"error\":\"model 'missing' not found\"}";
+
+/* Helper: Server-side snapshot */
+static void server_counts(int* accepts, int* requests) {
+    pthread_mutex_lock(&g_server_lock);
+    *accepts = g_accepts;
+    *requests = g_requests;
+    pthread_mutex_unlock(&g_server_lock);
+}
+
+static bool stopping(void) {
+    pthread_mutex_lock(&g_server_lock);
+    bool stop = g_stop;
+    pthread_mutex_unlock(&g_server_lock);
+    return stop;
+}
+
+static void set_mode(serve_mode_t mode) {
+    pthread_mutex_lock(&g_server_lock);
+    g_mode = mode;
+    pthread_mutex_unlock(&g_server_lock);
+}
+
+/* Helper: Read one request; false when the client closed */
+static bool read_request(int fd, char* request, size_t size) {
+    size_t length = 0;
+    char* body = NULL;
+    size_t content_length = 0;
+
+    while (!body || length < (size_t)(body - request) + content_length) {
+        ssize_t n = recv(fd, request + length, size - length - 1, 0);
+        if (n <= 0) return false;
+        length += (size_t)n;
+        request[length] = '\0';
+        if (!body && (body = strstr(request, "\r\n\r\n"))) {
+            body += 4;
+            const char* header = strstr(request, "Content-Length: ");
+            content_length = header ? strtoul(header + 16, NULL, 10) : 0;
+        }
+    }
+    return true;
+}
+
+/* Helper: Send one response according to the mode */
+static void send_response(int fd, serve_mode_t mode, bool streaming) {
+    char head[256];
+
+    if (mode == SERVE_NOT_FOUND) {
+        snprintf(head, sizeof(head),
+                 "HTTP/1.1 404 Not Found\r\nContent-Type: application/json\r\n"
+                 "Content-Length: %zu\r\n\r\n", strlen(NOT_FOUND_BODY));
+        send(fd, head, strlen(head), MSG_NOSIGNAL);
+        send(fd, NOT_FOUND_BODY, strlen(NOT_FOUND_BODY), MSG_NOSIGNAL);
+        return;
+    }
+
+    const char* connection = mode == SERVE_CLOSE_HEADER ? "Connection: close\r\n" : "";
+    if (streaming) {
+        snprintf(head, sizeof(head),
+                 "HTTP/1.1 200 OK\r\nContent-Type: application/x-ndjson\r\n"
+                 "%sTransfer-Encoding: chunked\r\n\r\n", connection);
+        send(fd, head, strlen(head), MSG_NOSIGNAL);
+        for (size_t i = 0; i < sizeof(STREAM_CHUNKS) / sizeof(STREAM_CHUNKS[0]); i++) {
+            char chunk[256];
+            snprintf(chunk, sizeof(chunk), "%zx\r\n%s\r\n", strlen(STREAM_CHUNKS[i]), STREAM_CHUNKS[i]);
+            send(fd, chunk, strlen(chunk), MSG_NOSIGNAL);
+            usleep(SPLIT_DELAY_USEC);
+        }
+        send(fd, "0\r\n\r\n", 5, MSG_NOSIGNAL);
+        return;
+    }
+
+    /* Headers and body in separate writes, body split in two */
+    size_t body_len = strlen(QUERY_BODY);
+    snprintf(head, sizeof(head),
+             "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+             "%sContent-Length: %zu\r\n\r\n", connection, body_len);
+    send(fd, head, strlen(head), MSG_NOSIGNAL);
+    usleep(SPLIT_DELAY_USEC);
+    send(fd, QUERY_BODY, body_len / 2, MSG_NOSIGNAL);
+    usleep(SPLIT_DELAY_USEC);
+    send(fd, QUERY_BODY + body_len / 2, body_len - body_len / 2, MSG_NOSIGNAL);
+}
+
+/* Fake Ollama: one connection at a time, requests served in order */
+static void* server_thread(void* arg) {
+    (void)arg;
+    char* request = malloc(REQUEST_MAX);
+
+    while (!stopping()) {
+        struct pollfd pfd = { .fd = g_listen_fd, .events = POLLIN };
+        if (poll(&pfd, 1, SERVER_POLL_MS) <= 0) continue;
+
+        int fd = accept(g_listen_fd, NULL, NULL);
+        if (fd < 0) continue;
+        pthread_mutex_lock(&g_server_lock);
+        g_accepts++;
+        pthread_mutex_unlock(&g_server_lock);
+
+        while (!stopping() && read_request(fd, request, REQUEST_MAX)) {
+            pthread_mutex_lock(&g_server_lock);
+            serve_mode_t mode = g_mode;
+            g_requests++;
+            pthread_mutex_unlock(&g_server_lock);
+
+            send_response(fd, mode, strstr(request, "\"stream\":true") != NULL);
+            if (mode == SERVE_CLOSE_HEADER || mode == SERVE_SILENT_CLOSE) break;
+        }
+        close(fd);
+    }
+
+    free(request);
+    return NULL;
+}
+
+/* Query result capture */
+static char g_answer[256];
+
+static void capture_response(const ci_response_t* response, void* userdata) {
+    (void)userdata;
+    snprintf(g_answer, sizeof(g_answer), "%s", response->content ? response->content : "");
+}
+
+static void capture_delta(const char* chunk, size_t len, void* userdata) {
+    (void)userdata;
+    strncat(g_answer, chunk, len);
+}
+
+/* Helper: Provider pointed at the fake server */
+static ci_provider_t* create_provider(void) {
+    ci_provider_t* provider = ollama_create_provider("test");
+    if (provider && provider->init(provider) != ARGO_SUCCESS) {
+        provider->cleanup(provider);
+        return NULL;
+    }
+    return provider;
+}
+
+/* Test: Address parsing */
+static int test_parse_address(void) {
+    char host[OLLAMA_HOST_SIZE];
+    int port = OLLAMA_DEFAULT_PORT;
+
+    TEST_ASSERT(ollama_parse_address("gpu-box", host, sizeof(host), &port) == ARGO_SUCCESS &&
+                strcmp(host, "gpu-box") == 0 && port == OLLAMA_DEFAULT_PORT, "Bare host keeps default port");
+    TEST_ASSERT(ollama_parse_address("10.0.0.5:8080", host, sizeof(host), &port) == ARGO_SUCCESS &&
+                strcmp(host, "10.0.0.5") == 0 && port == 8080, "host:port");
+    TEST_ASSERT(ollama_parse_address("http://ollama.local:11500/", host, sizeof(host), &port) == ARGO_SUCCESS &&
+                strcmp(host, "ollama.local") == 0 && port == 11500, "URL form");
+    TEST_ASSERT(ollama_parse_address("host:99999", host, sizeof(host), &port) == E_INPUT_FORMAT,
+                "Out-of-range port rejected");
+    TEST_ASSERT(ollama_parse_address(":80", host, sizeof(host), &port) == E_INPUT_FORMAT, "Empty host rejected");
+    TEST_PASS("Address parsing");
+}
+
+/* Test: Content-Length responses over one keep-alive connection */
+static int test_keep_alive(void) {
+    int accepts_before, requests_before, accepts, requests;
+    server_counts(&accepts_before, &requests_before);
+    set_mode(SERVE_KEEP_ALIVE);
+
+    ci_provider_t* provider = create_provider();
+    TEST_ASSERT(provider != NULL, "Create provider");
+
+    for (int i = 0; i < 3; i++) {
+        g_answer[0] = '\0';
+        TEST_ASSERT(provider->query(provider, "hi", capture_response, NULL) == ARGO_SUCCESS, "Query succeeds");
+        TEST_ASSERT(strcmp(g_answer, "Hello \"world\"\n") == 0, "Answer decoded from split body");
+    }
+
+    server_counts(&accepts, &requests);
+    TEST_ASSERT(requests - requests_before == 3, "Three requests served");
+    TEST_ASSERT(accepts - accepts_before == 1, "One connection reused");
+
+    provider->cleanup(provider);
+    TEST_PASS("Content-Length responses over one keep-alive connection");
+}
+
+/* Test: Chunked NDJSON streaming */
+static int test_chunked_stream(void) {
+    int accepts_before, requests_before, accepts, requests;
+    server_counts(&accepts_before, &requests_before);
+    set_mode(SERVE_KEEP_ALIVE);
+
+    ci_provider_t* provider = create_provider();
+    TEST_ASSERT(provider != NULL, "Create provider");
+
+    for (int i = 0; i < 2; i++) {
+        g_answer[0] = '\0';
+        TEST_ASSERT(provider->stream(provider, "hi", capture_delta, NULL) == ARGO_SUCCESS, "Stream succeeds");
+        TEST_ASSERT(strcmp(g_answer, "Hello world") == 0, "Deltas joined across chunk boundaries");
+    }
+    g_answer[0] = '\0';
+    TEST_ASSERT(provider->query(provider, "hi", capture_response, NULL) == ARGO_SUCCESS &&
+                strcmp(g_answer, "Hello \"world\"\n") == 0, "Query after streams on same connection");
+
+    server_counts(&accepts, &requests);
+    TEST_ASSERT(requests - requests_before == 3 && accepts - accepts_before == 1,
+                "Chunked bodies fully consumed, connection reused");
+
+    provider->cleanup(provider);
+    TEST_PASS("Chunked NDJSON streaming");
+}
+
+/* Test: Reconnect when the server closes */
+static int test_reconnect(void) {
+    int accepts_before, requests_before, accepts, requests;
+    ci_provider_t* provider = create_provider();
+    TEST_ASSERT(provider != NULL, "Create provider");
+
+    serve_mode_t modes[] = { SERVE_CLOSE_HEADER, SERVE_SILENT_CLOSE };
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        set_mode(modes[m]);
+        server_counts(&accepts_before, &requests_before);
+        for (int i = 0; i < 2; i++) {
+            g_answer[0] = '\0';
+            TEST_ASSERT(provider->query(provider, "hi", capture_response, NULL) == ARGO_SUCCESS,
+                        "Query succeeds after server close");
+            TEST_ASSERT(strcmp(g_answer, "Hello \"world\"\n") == 0, "Answer intact");
+            usleep(SPLIT_DELAY_USEC);
+        }
+        server_counts(&accepts, &requests);
+        TEST_ASSERT(requests - requests_before == 2 && accepts - accepts_before == 2,
+                    "One connection per request when the server closes");
+    }
+
+    provider->cleanup(provider);
+    TEST_PASS("Reconnect when the server closes");
+}
+
+/* Test: HTTP errors surface and keep the connection */
+static int test_http_error(void) {
+    int accepts_before, requests_before, accepts, requests;
+    server_counts(&accepts_before, &requests_before);
+    ci_provider_t* provider = create_provider();
+    TEST_ASSERT(provider != NULL, "Create provider");
+
+    set_mode(SERVE_NOT_FOUND);
+    TEST_ASSERT(provider->query(provider, "hi", capture_response, NULL) == E_PROTOCOL_HTTP,
+                "404 reported as HTTP error");
+    set_mode(SERVE_KEEP_ALIVE);
+    g_answer[0] = '\0';
+    TEST_ASSERT(provider->query(provider, "hi", capture_response, NULL) == ARGO_SUCCESS &&
+                strcmp(g_answer, "Hello \"world\"\n") == 0, "Next query succeeds");
+
+    server_counts(&accepts, &requests);
+    TEST_ASSERT(accepts - accepts_before == 1, "Error body consumed, connection reused");
+
+    provider->cleanup(provider);
+    TEST_PASS("HTTP errors surface and keep the connection");
+}
+
+/* Test: Unreachable server */
+static int test_unreachable(void) {
+    argo_setenv(OLLAMA_HOST_ENV, "127.0.0.1:1");
+    ci_provider_t* provider = create_provider();
+    TEST_ASSERT(provider != NULL, "Create provider");
+    TEST_ASSERT(provider->query(provider, "hi", capture_response, NULL) == E_CI_NO_PROVIDER,
+                "Unreachable server reported");
+    TEST_ASSERT(!ollama_is_running(), "Probe sees no server");
+    provider->cleanup(provider);
+
+    char address[64];
+    snprintf(address, sizeof(address), "127.0.0.1:%d", g_port);
+    argo_setenv(OLLAMA_HOST_ENV, address);
+    TEST_ASSERT(ollama_is_running(), "Probe finds configured server");
+    TEST_PASS("Unreachable server");
+}
+
+/* Helper: Listen on an ephemeral loopback port */
+static int start_server(pthread_t* thread) {
+    struct sockaddr_in addr = { .sin_family = AF_INET };
+    socklen_t addr_len = sizeof(addr);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    g_listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (g_listen_fd < 0 ||
+        bind(g_listen_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 ||
+        listen(g_listen_fd, 8) < 0 ||
+        getsockname(g_listen_fd, (struct sockaddr*)&addr, &addr_len) < 0) {
+        return -1;
+    }
+    g_port = ntohs(addr.sin_port);
+    return pthread_create(thread, NULL, server_thread, NULL);
+}
+
+int main(void) {
+    int failed = 0;
+    pthread_t thread;
+
+    printf("==========================================\n");
+    printf("Ollama Transport Tests\n");
+    printf("==========================================\n\n");
+
+    if (start_server(&thread) != 0) {
+        fprintf(stderr, "FAIL: could not start fake Ollama server\n");
+        return 1;
+    }
+    char address[64];
+    snprintf(address, sizeof(address), "http://127.0.0.1:%d", g_port);
+    argo_setenv(OLLAMA_HOST_ENV, address);
+
+    failed += test_parse_address();
+    failed += test_keep_alive();
+    failed += test_chunked_stream();
+    failed += test_reconnect();
+    failed += test_http_error();
+    failed += test_unreachable();
+
+    pthread_mutex_lock(&g_server_lock);
+    g_stop = true;
+    pthread_mutex_unlock(&g_server_lock);
+    pthread_join(thread, NULL);
+    close(g_listen_fd);
+
+    printf("\n");
+    if (failed == 0) {
+        printf("All Ollama transport tests passed!\n");
+        return 0;
+    } else {
+        printf("%d Ollama transport tests failed\n", failed);
+        return 1;
+    }
+}
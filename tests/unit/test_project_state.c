@@ -0,0 +1,229 @@
+/* © 2025 Casey Koons All rights reserved */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/* Project includes */
+#include "argo_project_state.h"
+#include "argo_json_doc.h"
+#include "argo_error.h"
+#include "argo_limits.h"
+
+/* Test utilities */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "FAIL: %s\n", message); \
+            return 1; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        return 0; \
+    } while(0)
+
+#define TEST_DIR_FORMAT "/tmp/argo_test_project_state_%d"
+#define TEST_PROJECT_ID "demo-1"
+
+static char g_test_dir[ARGO_PATH_MAX];
+static char g_registry[ARGO_PATH_MAX];
+static char g_state_file[ARGO_PATH_MAX];
+
+/* Helper: Write whole file */
+static void write_file(const char* path, const char* content) {
+    FILE* fp = fopen(path, "w");
+    if (!fp) return;
+    fprintf(fp, "%s", content);
+    fclose(fp);
+}
+
+/* Helper: Parse ops literal */
+static json_node_t* ops(const char* json) {
+    json_node_t* node = NULL;
+    json_doc_parse(json, strlen(json), &node);
+    return node;
+}
+
+/* Test: Parse, pointer access, serialize round trip */
+static int test_json_doc(void) {
+    const char* text = "{\"a\":{\"b/c\":[1,2.5e3,\"x\\ny\"]},\"t\":true,\"n\":null,\"u\":\"\\u00e9\\ud83d\\ude00\"}";
+    json_node_t* doc = NULL;
+    TEST_ASSERT(json_doc_parse(text, strlen(text), &doc) == ARGO_SUCCESS, "Should parse");
+
+    json_node_t* node = json_doc_get(doc, "/a/b~1c/2");
+    TEST_ASSERT(node && node->type == JSON_DOC_STRING && strcmp(node->text, "x\ny") == 0,
+                "Escaped key and array index resolve");
+    node = json_doc_get(doc, "/u");
+    TEST_ASSERT(node && strcmp(node->text, "\xc3\xa9\xf0\x9f\x98\x80") == 0, "Unicode escapes decode to UTF-8");
+    TEST_ASSERT(json_doc_get(doc, "/a/b~1c/3") == NULL, "Out of range index is absent");
+    TEST_ASSERT(json_doc_get(doc, "") == doc, "Empty pointer is the document");
+
+    TEST_ASSERT(json_doc_set(doc, "/x/y/z", json_doc_new_integer(7)) == ARGO_SUCCESS,
+                "Set creates intermediate objects");
+    TEST_ASSERT(json_doc_set(doc, "/a/b~1c/-", json_doc_new_string("end")) == ARGO_SUCCESS, "Append to array");
+    TEST_ASSERT(json_doc_remove(doc, "/t") == ARGO_SUCCESS, "Remove member");
+    TEST_ASSERT(json_doc_remove(doc, "/t") == E_NOT_FOUND, "Second remove fails");
+
+    char* out = json_doc_serialize(doc);
+    TEST_ASSERT(out != NULL, "Should serialize");
+    TEST_ASSERT(strcmp(out, "{\"a\":{\"b/c\":[1,2.5e3,\"x\\ny\",\"end\"]},\"n\":null,"
+                            "\"u\":\"\xc3\xa9\xf0\x9f\x98\x80\",\"x\":{\"y\":{\"z\":7}}}") == 0,
+                "Serialized output matches");
+
+    json_node_t* again = NULL;
+    TEST_ASSERT(json_doc_parse(out, strlen(out), &again) == ARGO_SUCCESS, "Output parses");
+    TEST_ASSERT(json_doc_equal(doc, again), "Round trip is equal");
+    free(out);
+    json_doc_free(again);
+    json_doc_free(doc);
+
+    TEST_ASSERT(json_doc_parse("{\"a\":tru}", 9, &doc) != ARGO_SUCCESS, "Bad literal rejected");
+    TEST_ASSERT(json_doc_parse("[1] [2]", 7, &doc) != ARGO_SUCCESS, "Trailing value rejected");
+    TEST_PASS("JSON document and pointers work");
+}
+
+/* Test: Read whole state and batched pointers */
+static int test_get(void) {
+    project_state_store_t* store = project_state_store_create(g_registry);
+    TEST_ASSERT(store != NULL, "Should create store");
+
+    char* json = NULL;
+    long long version = -1;
+    TEST_ASSERT(project_state_get(store, "unknown", NULL, 0, &json, &version) == E_NOT_FOUND,
+                "Unregistered project not found");
+
+    TEST_ASSERT(project_state_get(store, TEST_PROJECT_ID, NULL, 0, &json, &version) == ARGO_SUCCESS,
+                "Should read state");
+    TEST_ASSERT(version == 0, "Fresh file is version 0");
+    TEST_ASSERT(strstr(json, "\"phase\":\"init\"") != NULL, "Whole state returned");
+    free(json);
+
+    const char* pointers[] = {"/phase", "/limits/max", "/missing"};
+    TEST_ASSERT(project_state_get(store, TEST_PROJECT_ID, pointers, 3, &json, &version) == ARGO_SUCCESS,
+                "Should read pointers");
+    TEST_ASSERT(strcmp(json, "[\"init\",3,null]") == 0, "One value per pointer");
+    free(json);
+
+    project_state_store_destroy(store);
+    TEST_PASS("Get works");
+}
+
+/* Test: Atomic patches with compare-and-swap */
+static int test_patch(void) {
+    project_state_store_t* store = project_state_store_create(g_registry);
+    TEST_ASSERT(store != NULL, "Should create store");
+
+    long long version = -1;
+    json_node_t* patch = ops("[{\"op\":\"replace\",\"path\":\"/phase\",\"value\":\"design\"},"
+                             "{\"op\":\"add\",\"path\":\"/design/status\",\"value\":\"started\"}]");
+    TEST_ASSERT(project_state_patch(store, TEST_PROJECT_ID, patch, 0, &version) == ARGO_SUCCESS,
+                "CAS patch at current version applies");
+    TEST_ASSERT(version == 1, "Version bumped");
+    json_doc_free(patch);
+
+    patch = ops("[{\"op\":\"replace\",\"path\":\"/phase\",\"value\":\"stale\"}]");
+    TEST_ASSERT(project_state_patch(store, TEST_PROJECT_ID, patch, 0, &version) == E_PROTOCOL_VERSION,
+                "Stale version conflicts");
+    TEST_ASSERT(version == 1, "Conflict reports current version");
+    json_doc_free(patch);
+
+    patch = ops("[{\"op\":\"replace\",\"path\":\"/phase\",\"value\":\"half\"},"
+                "{\"op\":\"replace\",\"path\":\"/nope\",\"value\":1}]");
+    TEST_ASSERT(project_state_patch(store, TEST_PROJECT_ID, patch, PROJECT_STATE_ANY_VERSION, &version) ==
+                E_INPUT_INVALID, "Replace of missing path fails");
+    json_doc_free(patch);
+
+    patch = ops("[{\"op\":\"test\",\"path\":\"/phase\",\"value\":\"init\"}]");
+    TEST_ASSERT(project_state_patch(store, TEST_PROJECT_ID, patch, PROJECT_STATE_ANY_VERSION, &version) ==
+                E_PROTOCOL_VERSION, "Failed test op conflicts");
+    json_doc_free(patch);
+
+    const char* pointers[] = {"/phase", "/design/status", "/" PROJECT_STATE_VERSION_FIELD};
+    char* json = NULL;
+    project_state_get(store, TEST_PROJECT_ID, pointers, 3, &json, &version);
+    TEST_ASSERT(json && strcmp(json, "[\"design\",\"started\",1]") == 0,
+                "Failed patches left no partial changes");
+    free(json);
+    project_state_store_destroy(store);
+
+    /* Version persists in the file across store instances */
+    store = project_state_store_create(g_registry);
+    project_state_get(store, TEST_PROJECT_ID, NULL, 0, &json, &version);
+    TEST_ASSERT(version == 1, "Version survives restart");
+    free(json);
+    project_state_store_destroy(store);
+    TEST_PASS("Patch works");
+}
+
+/* Test: Outside writes are picked up and bump the version */
+static int test_external_write(void) {
+    project_state_store_t* store = project_state_store_create(g_registry);
+    char* json = NULL;
+    long long before = -1;
+    long long after = -1;
+    project_state_get(store, TEST_PROJECT_ID, NULL, 0, &json, &before);
+    free(json);
+
+    /* Same state_version, as a jq update_state would leave it */
+    char temp[ARGO_PATH_MAX];
+    snprintf(temp, sizeof(temp), "%s.tmp", g_state_file);
+    write_file(temp, "{\"phase\":\"jq\",\"state_version\":1}");
+    rename(temp, g_state_file);
+
+    const char* pointers[] = {"/phase"};
+    TEST_ASSERT(project_state_get(store, TEST_PROJECT_ID, pointers, 1, &json, &after) == ARGO_SUCCESS,
+                "Should read after outside write");
+    TEST_ASSERT(strcmp(json, "[\"jq\"]") == 0, "Outside write visible");
+    TEST_ASSERT(after == before + 1, "Outside write is a new version");
+    free(json);
+
+    project_state_store_destroy(store);
+    TEST_PASS("External writes detected");
+}
+
+/* Main test runner */
+int main(void) {
+    int failed = 0;
+
+    printf("Running project state tests...\n\n");
+
+    char path[ARGO_PATH_MAX];
+    snprintf(g_test_dir, sizeof(g_test_dir), TEST_DIR_FORMAT, (int)getpid());
+    snprintf(g_registry, sizeof(g_registry), "%s/projects.json", g_test_dir);
+    snprintf(path, sizeof(path), "%s/.argo-project", g_test_dir);
+    snprintf(g_state_file, sizeof(g_state_file), "%s/%s", g_test_dir, PROJECT_STATE_FILE);
+    mkdir(g_test_dir, ARGO_DIR_PERMISSIONS);
+    mkdir(path, ARGO_DIR_PERMISSIONS);
+
+    char registry[ARGO_PATH_MAX * 2];
+    snprintf(registry, sizeof(registry),
+             "{\"projects\":{\"" TEST_PROJECT_ID "\":{\"name\":\"demo\",\"path\":\"%s\"}}}", g_test_dir);
+    write_file(g_registry, registry);
+    write_file(g_state_file, "{\n  \"phase\": \"init\",\n  \"limits\": {\"max\": 3}\n}\n");
+
+    failed += test_json_doc();
+    failed += test_get();
+    failed += test_patch();
+    failed += test_external_write();
+
+    char cmd[ARGO_PATH_MAX];
+    snprintf(cmd, sizeof(cmd), "rm -rf %s", g_test_dir);
+    if (system(cmd) != 0) {
+        fprintf(stderr, "Warning: could not remove %s\n", g_test_dir);
+    }
+
+    printf("\n");
+    if (failed == 0) {
+        printf("All project state tests passed!\n");
+        return 0;
+    } else {
+        printf("%d project state tests failed\n", failed);
+        return 1;
+    }
+}
@@ -0,0 +1,218 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* usleep() */
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Project includes */
+#include "argo_provider_pool.h"
+#include "argo_ci_engine.h"
+#include "argo_mock.h"
+#include "argo_error.h"
+
+/* Test utilities */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "FAIL: %s\n", message); \
+            return 1; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        return 0; \
+    } while(0)
+
+#define IDLE_SECONDS 1
+#define IDLE_WAIT_USEC 1100000       /* Just past IDLE_SECONDS */
+
+/* Factory: mock providers only, counting creations */
+static int g_created = 0;
+
+static ci_provider_t* mock_factory(const char* provider_name, const char* model) {
+    if (strcmp(provider_name, "mock") != 0) {
+        return NULL;
+    }
+    g_created++;
+    ci_provider_t* provider = mock_provider_create(model);
+    if (provider) {
+        mock_provider_set_response(provider, "pooled");
+    }
+    return provider;
+}
+
+/* Helper: Engine hands a borrowed provider back */
+static void return_to_pool(ci_provider_t* provider, int result, void* context) {
+    provider_pool_checkin((provider_pool_t*)context, provider, result);
+}
+
+/* Test: Checked-in provider is reused for the same key */
+static int test_reuse(void) {
+    provider_pool_t* pool = provider_pool_create(mock_factory, 4, 0);
+    ci_provider_t* first = NULL;
+    ci_provider_t* second = NULL;
+    ci_provider_t* other = NULL;
+    provider_pool_stats_t stats;
+
+    g_created = 0;
+    TEST_ASSERT(pool != NULL, "Create pool");
+    TEST_ASSERT(provider_pool_checkout(pool, "mock", "m1", &first) == ARGO_SUCCESS, "Checkout");
+    provider_pool_checkin(pool, first, ARGO_SUCCESS);
+    TEST_ASSERT(provider_pool_checkout(pool, "mock", "m1", &second) == ARGO_SUCCESS, "Checkout again");
+    TEST_ASSERT(second == first, "Same provider reused");
+    TEST_ASSERT(provider_pool_checkout(pool, "mock", "m2", &other) == ARGO_SUCCESS, "Checkout other model");
+    TEST_ASSERT(other != first, "Model is part of the key");
+    TEST_ASSERT(g_created == 2, "Two providers created");
+
+    provider_pool_get_stats(pool, &stats);
+    TEST_ASSERT(stats.hits == 1 && stats.misses == 2 && stats.busy == 2, "Stats count hit and misses");
+
+    provider_pool_checkin(pool, second, ARGO_SUCCESS);
+    provider_pool_checkin(pool, other, ARGO_SUCCESS);
+    provider_pool_destroy(pool);
+    TEST_PASS("Checked-in provider is reused for the same key");
+}
+
+/* Test: Health on checkin decides reuse */
+static int test_health(void) {
+    provider_pool_t* pool = provider_pool_create(mock_factory, 4, 0);
+    ci_provider_t* provider = NULL;
+    ci_provider_t* first = NULL;
+    provider_pool_stats_t stats;
+
+    g_created = 0;
+    TEST_ASSERT(provider_pool_checkout(pool, "nosuch", NULL, &provider) == E_NOT_FOUND,
+                "Unknown provider is E_NOT_FOUND");
+
+    provider_pool_checkout(pool, "mock", NULL, &first);
+    provider_pool_checkin(pool, first, E_PROTOCOL_HTTP);
+    provider_pool_checkout(pool, "mock", NULL, &provider);
+    TEST_ASSERT(provider == first, "Kept after remote HTTP error");
+
+    provider_pool_checkin(pool, provider, E_SYSTEM_NETWORK);
+    provider_pool_get_stats(pool, &stats);
+    TEST_ASSERT(stats.idle == 0 && stats.evictions == 1, "Discarded after network error");
+
+    provider_pool_checkout(pool, "mock", NULL, &provider);
+    TEST_ASSERT(g_created == 2, "Replacement created");
+
+    provider_pool_checkin(pool, provider, ARGO_SUCCESS);
+    provider_pool_destroy(pool);
+    TEST_PASS("Health on checkin decides reuse");
+}
+
+/* Test: Size limit with LRU eviction and unpooled overflow */
+static int test_max_size(void) {
+    provider_pool_t* pool = provider_pool_create(mock_factory, 2, 0);
+    ci_provider_t* busy[3] = {NULL};
+    ci_provider_t* provider = NULL;
+    provider_pool_stats_t stats;
+
+    g_created = 0;
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT(provider_pool_checkout(pool, "mock", NULL, &busy[i]) == ARGO_SUCCESS,
+                    "Checkout past max size still succeeds");
+    }
+    provider_pool_get_stats(pool, &stats);
+    TEST_ASSERT(stats.busy == 2, "Only max size pooled");
+
+    for (int i = 0; i < 3; i++) {
+        provider_pool_checkin(pool, busy[i], ARGO_SUCCESS);
+    }
+    provider_pool_get_stats(pool, &stats);
+    TEST_ASSERT(stats.idle == 2 && stats.busy == 0, "Overflow provider not kept");
+
+    /* Full of idle "mock/default": a new key evicts the least recently used */
+    TEST_ASSERT(provider_pool_checkout(pool, "mock", "other", &provider) == ARGO_SUCCESS,
+                "Checkout new key when full");
+    provider_pool_get_stats(pool, &stats);
+    TEST_ASSERT(stats.idle == 1 && stats.busy == 1 && stats.evictions == 1, "LRU idle evicted");
+
+    provider_pool_checkin(pool, provider, ARGO_SUCCESS);
+    provider_pool_destroy(pool);
+    TEST_PASS("Size limit with LRU eviction and unpooled overflow");
+}
+
+/* Test: Idle providers expire */
+static int test_idle_eviction(void) {
+    provider_pool_t* pool = provider_pool_create(mock_factory, 4, IDLE_SECONDS);
+    ci_provider_t* provider = NULL;
+    provider_pool_stats_t stats;
+
+    provider_pool_checkout(pool, "mock", NULL, &provider);
+    provider_pool_checkin(pool, provider, ARGO_SUCCESS);
+    TEST_ASSERT(provider_pool_evict_idle(pool) == 0, "Fresh provider kept");
+
+    usleep(IDLE_WAIT_USEC);
+    TEST_ASSERT(provider_pool_evict_idle(pool) == 1, "Idle provider evicted");
+    provider_pool_get_stats(pool, &stats);
+    TEST_ASSERT(stats.idle == 0 && stats.busy == 0, "Pool empty after eviction");
+
+    provider_pool_destroy(pool);
+    TEST_PASS("Idle providers expire");
+}
+
+/* Test: Engine queries a borrowed provider and checks it back in */
+static int test_engine_borrow(void) {
+    provider_pool_t* pool = provider_pool_create(mock_factory, 4, 0);
+    ci_engine_t* engine = ci_engine_create(1);
+    provider_pool_stats_t stats;
+
+    g_created = 0;
+    TEST_ASSERT(engine != NULL, "Create engine");
+    for (int i = 0; i < 3; i++) {
+        ci_provider_t* provider = NULL;
+        TEST_ASSERT(provider_pool_checkout(pool, "mock", NULL, &provider) == ARGO_SUCCESS, "Checkout");
+        ci_future_t* future = ci_engine_submit_borrowed(engine, provider, return_to_pool, pool,
+                                                        "hello", 0, NULL, NULL);
+        TEST_ASSERT(future != NULL, "Submit borrowed");
+        ci_future_wait(future, CI_ENGINE_NO_TIMEOUT);
+        const ci_response_t* answer = ci_future_response(future);
+        TEST_ASSERT(answer->success && strcmp(answer->content, "pooled") == 0, "Borrowed provider answers");
+        ci_future_release(future);
+
+        /* Checkin happens on the engine thread after completion */
+        for (int spin = 0; spin < 100 && ci_engine_pending(engine) > 0; spin++) {
+            usleep(1000);
+        }
+    }
+
+    ci_engine_destroy(engine);
+    provider_pool_get_stats(pool, &stats);
+    TEST_ASSERT(g_created == 1, "One provider served every query");
+    TEST_ASSERT(stats.idle == 1 && stats.hits == 2, "Provider returned after each query");
+
+    provider_pool_destroy(pool);
+    TEST_PASS("Engine queries a borrowed provider and checks it back in");
+}
+
+int main(void) {
+    int failed = 0;
+
+    printf("==========================================\n");
+    printf("Provider Pool Tests\n");
+    printf("==========================================\n\n");
+
+    failed += test_reuse();
+    failed += test_health();
+    failed += test_max_size();
+    failed += test_idle_eviction();
+    failed += test_engine_borrow();
+
+    printf("\n");
+    if (failed == 0) {
+        printf("All provider pool tests passed!\n");
+        return 0;
+    } else {
+        printf("%d provider pool tests failed\n", failed);
+        return 1;
+    }
+}
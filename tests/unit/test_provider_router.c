@@ -0,0 +1,260 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* usleep() */
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Project includes */
+#include "argo_provider_router.h"
+#include "argo_ci_engine.h"
+#include "argo_error.h"
+#include "argo_limits.h"
+#include "argo_time.h"
+
+/* Test utilities */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "FAIL: %s\n", message); \
+            return 1; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        return 0; \
+    } while(0)
+
+#define TEST_WORKERS 4
+#define FAST_DELAY_MS 10
+#define SLOW_DELAY_MS 1500
+#define SHORT_DEADLINE_MS 600
+#define LONG_DEADLINE_MS 5000
+#define HISTORY_SAMPLES 5
+
+/* Fake blocking provider: "down*" fails, "slow" takes SLOW_DELAY_MS, others are fast */
+static int fake_query(ci_provider_t* provider, const char* prompt,
+                      ci_response_callback callback, void* userdata) {
+    (void)prompt;
+    if (strncmp(provider->name, "down", 4) == 0) {
+        return E_CI_DISCONNECTED;
+    }
+    int delay = strcmp(provider->name, "slow") == 0 ? SLOW_DELAY_MS : FAST_DELAY_MS;
+    usleep((useconds_t)delay * 1000);
+
+    char content[ARGO_BUFFER_SMALL];
+    snprintf(content, sizeof(content), "from %s", provider->name);
+    ci_response_t response = {0};
+    response.success = true;
+    response.content = content;
+    response.content_len = strlen(content);
+    response.model_used = provider->model;
+    callback(&response, userdata);
+    return ARGO_SUCCESS;
+}
+
+static void fake_cleanup(ci_provider_t* provider) {
+    free(provider);
+}
+
+/* Helper: Router submit function - fresh fake provider on the engine */
+static int submit_fake(void* context, const char* provider_name, const char* model, int timeout_ms,
+                       ci_response_callback callback, void* userdata, ci_future_t** future) {
+    ci_provider_t* provider = calloc(1, sizeof(ci_provider_t));
+    if (!provider) return E_SYSTEM_MEMORY;
+    snprintf(provider->name, sizeof(provider->name), "%s", provider_name);
+    snprintf(provider->model, sizeof(provider->model), "%s", model ? model : "default");
+    provider->query = fake_query;
+    provider->cleanup = fake_cleanup;
+
+    *future = ci_engine_submit((ci_engine_t*)context, provider, "prompt", timeout_ms, callback, userdata);
+    return *future ? ARGO_SUCCESS : E_SYSTEM_MEMORY;
+}
+
+/* Helper: Record the same latency several times */
+static void record_history(provider_router_t* router, const char* provider, long long latency_ms) {
+    for (int i = 0; i < HISTORY_SAMPLES; i++) {
+        provider_router_record(router, provider, NULL, ARGO_SUCCESS, latency_ms);
+    }
+}
+
+/* Test: Ranking by latency, health and config order */
+static int test_rank(void) {
+    provider_router_t* router = provider_router_create();
+    provider_route_stats_t ranked[PROVIDER_ROUTER_MAX_CANDIDATES];
+    int count = 0;
+    TEST_ASSERT(router != NULL, "Router created");
+
+    TEST_ASSERT(provider_router_add_route(router, "fast", "a, b , openrouter/vendor/model") == ARGO_SUCCESS,
+                "Route added");
+    TEST_ASSERT(provider_router_add_route(router, "empty", " , ") == E_INVALID_PARAMS, "Empty route rejected");
+    TEST_ASSERT(provider_router_has_route(router, "FAST"), "Route names ignore case");
+    TEST_ASSERT(provider_router_rank(router, "missing", ranked, PROVIDER_ROUTER_MAX_CANDIDATES, &count) == E_NOT_FOUND,
+                "Unknown route");
+
+    /* Untried candidates keep config order */
+    provider_router_rank(router, "fast", ranked, PROVIDER_ROUTER_MAX_CANDIDATES, &count);
+    TEST_ASSERT(count == 3 && strcmp(ranked[0].provider, "a") == 0 && strcmp(ranked[1].provider, "b") == 0,
+                "Config order breaks ties");
+    TEST_ASSERT(strcmp(ranked[2].provider, "openrouter") == 0 && strcmp(ranked[2].model, "vendor/model") == 0,
+                "Model follows the first slash");
+
+    /* Faster history ranks first */
+    record_history(router, "a", 100);
+    record_history(router, "b", 20);
+    provider_router_record(router, "openrouter", "vendor/model", ARGO_SUCCESS, 500);
+    provider_router_rank(router, "fast", ranked, PROVIDER_ROUTER_MAX_CANDIDATES, &count);
+    TEST_ASSERT(strcmp(ranked[0].provider, "b") == 0 && strcmp(ranked[2].provider, "openrouter") == 0,
+                "Lowest latency first");
+    TEST_ASSERT(provider_router_hedge_delay(router, "b", NULL) == 20, "Hedge after p95");
+    TEST_ASSERT(provider_router_hedge_delay(router, "openrouter", "vendor/model") == PROVIDER_ROUTER_DEFAULT_HEDGE_MS,
+                "Default hedge delay without enough samples");
+
+    /* Consecutive failures make a candidate unhealthy */
+    for (int i = 0; i < PROVIDER_ROUTER_FAILURE_THRESHOLD; i++) {
+        provider_router_record(router, "b", NULL, E_CI_TIMEOUT, 0);
+    }
+    provider_router_rank(router, "fast", ranked, PROVIDER_ROUTER_MAX_CANDIDATES, &count);
+    TEST_ASSERT(strcmp(ranked[0].provider, "a") == 0 && strcmp(ranked[2].provider, "b") == 0 && !ranked[2].healthy,
+                "Unhealthy candidate ranks last");
+    TEST_ASSERT(ranked[2].error_rate > 0.0 && ranked[2].failures == PROVIDER_ROUTER_FAILURE_THRESHOLD,
+                "Failures tracked");
+
+    provider_route_stats_t stats[PROVIDER_ROUTER_MAX_CANDIDATES];
+    TEST_ASSERT(provider_router_get_stats(router, stats, PROVIDER_ROUTER_MAX_CANDIDATES) == 3, "Stats per provider/model");
+
+    provider_router_destroy(router);
+    TEST_PASS("Candidates ranked by health and latency");
+}
+
+/* Test: Error on the first candidate fails over */
+static int test_failover(ci_engine_t* engine) {
+    provider_router_t* router = provider_router_create();
+    router_result_t result;
+    provider_router_add_route(router, "r", "down, fast");
+
+    int status = provider_router_query(router, "r", submit_fake, engine, LONG_DEADLINE_MS, false, &result);
+    TEST_ASSERT(status == ARGO_SUCCESS, "Query answered");
+    TEST_ASSERT(strcmp(result.provider, "fast") == 0 && strcmp(result.content, "from fast") == 0,
+                "Answer from the second candidate");
+    TEST_ASSERT(result.attempts == 2 && !result.hedged, "Two attempts, no hedge");
+    free(result.content);
+
+    provider_route_stats_t ranked[PROVIDER_ROUTER_MAX_CANDIDATES];
+    int count = 0;
+    provider_router_rank(router, "r", ranked, PROVIDER_ROUTER_MAX_CANDIDATES, &count);
+    TEST_ASSERT(strcmp(ranked[0].provider, "fast") == 0, "Failed candidate demoted");
+
+    provider_router_destroy(router);
+    TEST_PASS("Fails over on provider error");
+}
+
+/* Test: Timeout on the first candidate leaves time for the next */
+static int test_timeout_failover(ci_engine_t* engine) {
+    provider_router_t* router = provider_router_create();
+    router_result_t result;
+    provider_router_add_route(router, "r", "slow, fast");
+
+    long long start = argo_monotonic_ms();
+    int status = provider_router_query(router, "r", submit_fake, engine, SHORT_DEADLINE_MS, false, &result);
+    long long elapsed = argo_monotonic_ms() - start;
+    TEST_ASSERT(status == ARGO_SUCCESS && strcmp(result.provider, "fast") == 0, "Second candidate answered");
+    TEST_ASSERT(elapsed < SHORT_DEADLINE_MS, "Within the query deadline");
+    free(result.content);
+
+    provider_route_stats_t stats[PROVIDER_ROUTER_MAX_CANDIDATES];
+    int count = provider_router_get_stats(router, stats, PROVIDER_ROUTER_MAX_CANDIDATES);
+    bool slow_failed = false;
+    for (int i = 0; i < count; i++) {
+        if (strcmp(stats[i].provider, "slow") == 0) slow_failed = stats[i].failures == 1;
+    }
+    TEST_ASSERT(slow_failed, "Timeout recorded as a failure");
+
+    provider_router_destroy(router);
+    TEST_PASS("Fails over on timeout");
+}
+
+/* Test: Hedge after p95 takes the first answer */
+static int test_hedge(ci_engine_t* engine) {
+    provider_router_t* router = provider_router_create();
+    router_result_t result;
+    provider_router_add_route(router, "r", "fast, slow");
+
+    /* History says slow is quick, so it goes first and is hedged at 20ms */
+    record_history(router, "slow", 20);
+    record_history(router, "fast", 100);
+
+    long long start = argo_monotonic_ms();
+    int status = provider_router_query(router, "r", submit_fake, engine, LONG_DEADLINE_MS, true, &result);
+    long long elapsed = argo_monotonic_ms() - start;
+    TEST_ASSERT(status == ARGO_SUCCESS, "Hedged query answered");
+    TEST_ASSERT(strcmp(result.provider, "fast") == 0 && result.hedged && result.attempts == 2,
+                "Hedge won");
+    TEST_ASSERT(elapsed < SLOW_DELAY_MS, "Did not wait for the slow candidate");
+    free(result.content);
+
+    /* Cancelled loser is not penalised; without hedging it answers */
+    status = provider_router_query(router, "r", submit_fake, engine, LONG_DEADLINE_MS, false, &result);
+    TEST_ASSERT(status == ARGO_SUCCESS && strcmp(result.provider, "slow") == 0 && !result.hedged,
+                "No hedge unless asked");
+    free(result.content);
+
+    provider_router_destroy(router);
+    TEST_PASS("Hedged request takes the first answer");
+}
+
+/* Test: Every candidate failing reports the last error */
+static int test_all_fail(ci_engine_t* engine) {
+    provider_router_t* router = provider_router_create();
+    router_result_t result;
+    provider_router_add_route(router, "r", "down, down2");
+
+    int status = provider_router_query(router, "r", submit_fake, engine, LONG_DEADLINE_MS, true, &result);
+    TEST_ASSERT(status == E_CI_DISCONNECTED, "Last error returned");
+    TEST_ASSERT(result.content == NULL && result.attempts == 2, "No answer after two attempts");
+    TEST_ASSERT(provider_router_query(router, "missing", submit_fake, engine, 0, false, &result) == E_NOT_FOUND,
+                "Unknown route");
+
+    provider_router_destroy(router);
+    TEST_PASS("All candidates failing is an error");
+}
+
+int main(void) {
+    int failed = 0;
+
+    printf("==========================================\n");
+    printf("Provider Router Tests\n");
+    printf("==========================================\n\n");
+
+    ci_engine_t* engine = ci_engine_create(TEST_WORKERS);
+    if (!engine) {
+        fprintf(stderr, "FAIL: could not create engine\n");
+        return 1;
+    }
+
+    failed += test_rank();
+    failed += test_failover(engine);
+    failed += test_timeout_failover(engine);
+    failed += test_hedge(engine);
+    failed += test_all_fail(engine);
+
+    ci_engine_destroy(engine);
+
+    printf("\n");
+    if (failed == 0) {
+        printf("All provider router tests passed!\n");
+        return 0;
+    } else {
+        printf("%d provider router tests failed\n", failed);
+        return 1;
+    }
+}
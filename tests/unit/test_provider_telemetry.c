@@ -0,0 +1,203 @@
+/* © 2025 Casey Koons All rights reserved */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/* Project includes */
+#include "argo_provider_telemetry.h"
+#include "argo_stream_decoder.h"
+#include "argo_error.h"
+
+/* Test utilities */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "FAIL: %s\n", message); \
+            return 1; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        return 0; \
+    } while(0)
+
+#define MAX_STATS 8
+
+/* Helper: Usage of one response body */
+static provider_usage_t parse(const char* json) {
+    provider_usage_t usage = {0};
+    provider_usage_parse(json, strlen(json), &usage);
+    return usage;
+}
+
+/* Helper: Stats of provider/model, or NULL */
+static const provider_telemetry_stats_t* find(provider_telemetry_stats_t* stats, int count,
+                                              const char* provider, const char* model) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(stats[i].provider, provider) == 0 && strcmp(stats[i].model, model) == 0) {
+            return &stats[i];
+        }
+    }
+    return NULL;
+}
+
+/* Test: Usage fields of every known wire format */
+static int test_usage_formats(void) {
+    provider_usage_t usage = parse("{\"choices\":[],\"usage\":{\"prompt_tokens\":12,\"completion_tokens\":34}}");
+    TEST_ASSERT(usage.prompt_tokens == 12 && usage.completion_tokens == 34, "OpenAI usage");
+
+    usage = parse("{\"content\":[],\"usage\":{\"input_tokens\":5,\"output_tokens\":7}}");
+    TEST_ASSERT(usage.prompt_tokens == 5 && usage.completion_tokens == 7, "Anthropic usage");
+
+    usage = parse("{\"usageMetadata\":{\"promptTokenCount\":9,\"candidatesTokenCount\":11}}");
+    TEST_ASSERT(usage.prompt_tokens == 9 && usage.completion_tokens == 11, "Gemini usage");
+
+    usage = parse("{\"response\":\"hi\",\"done\":true,\"prompt_eval_count\":3,\"eval_count\":4}");
+    TEST_ASSERT(usage.prompt_tokens == 3 && usage.completion_tokens == 4, "Ollama usage");
+
+    usage = parse("{\"choices\":[{\"message\":{\"content\":\"no usage\"}}]}");
+    TEST_ASSERT(usage.prompt_tokens == 0 && usage.completion_tokens == 0, "Absent usage stays 0");
+
+    TEST_ASSERT(provider_usage_parse("not json", 8, &usage) == E_INPUT_FORMAT, "Invalid body rejected");
+    TEST_PASS("Usage read from OpenAI, Anthropic, Gemini and Ollama answers");
+}
+
+static void on_delta(const char* text, size_t len, void* userdata) {
+    (void)text;
+    *(size_t*)userdata += len;
+}
+
+static void on_event(json_node_t* event, void* userdata) {
+    provider_usage_read(event, (provider_usage_t*)userdata);
+}
+
+/* Test: Anthropic stream - input in message_start, output in message_delta */
+static int test_stream_usage(void) {
+    const char* stream =
+        "event: message_start\n"
+        "data: {\"type\":\"message_start\",\"message\":{\"usage\":{\"input_tokens\":21,\"output_tokens\":1}}}\n\n"
+        "event: content_block_delta\n"
+        "data: {\"type\":\"content_block_delta\",\"delta\":{\"text\":\"Hello\"}}\n\n"
+        "event: message_delta\n"
+        "data: {\"type\":\"message_delta\",\"usage\":{\"output_tokens\":15}}\n\n";
+
+    size_t text = 0;
+    provider_usage_t usage = {0};
+    stream_decoder_t* decoder = stream_decoder_create(STREAM_FORMAT_SSE, STREAM_DELTA_CLAUDE,
+                                                      on_delta, &text);
+    TEST_ASSERT(decoder != NULL, "Create decoder");
+    stream_decoder_set_event_fn(decoder, on_event, &usage);
+
+    int result = stream_decoder_feed(decoder, stream, strlen(stream));
+    stream_decoder_destroy(decoder);
+
+    TEST_ASSERT(result == ARGO_SUCCESS, "Stream decoded");
+    TEST_ASSERT(text == strlen("Hello"), "Deltas still delivered");
+    TEST_ASSERT(usage.prompt_tokens == 21, "Prompt tokens from message_start");
+    TEST_ASSERT(usage.completion_tokens == 15, "Final output count replaces the first");
+    TEST_PASS("Stream usage collected from decoder events");
+}
+
+/* Test: Calls add up per provider/model */
+static int test_record_totals(void) {
+    provider_telemetry_reset();
+
+    provider_call_t call = {
+        .provider = "openai-api", .model = "gpt-4o", .result = ARGO_SUCCESS,
+        .request_bytes = 100, .response_bytes = 400,
+        .usage = { .prompt_tokens = 25, .completion_tokens = 80 },
+        .queue_ms = 10, .ttfb_ms = 40, .total_ms = 90
+    };
+    provider_telemetry_record(&call);
+
+    call.result = E_SYSTEM_NETWORK;
+    call.streamed = true;
+    call.usage = (provider_usage_t){0};
+    call.response_bytes = 0;
+    call.ttfb_ms = -1;
+    call.queue_ms = 30;
+    call.total_ms = 30;
+    provider_telemetry_record(&call);
+
+    call.model = NULL;
+    call.result = ARGO_SUCCESS;
+    provider_telemetry_record(&call);
+
+    provider_telemetry_stats_t stats[MAX_STATS];
+    int count = provider_telemetry_get_stats(stats, MAX_STATS);
+    TEST_ASSERT(count == 2, "Model and default model tracked apart");
+
+    const provider_telemetry_stats_t* s = find(stats, count, "openai-api", "gpt-4o");
+    TEST_ASSERT(s != NULL, "Entry found");
+    TEST_ASSERT(s->calls == 2 && s->failures == 1 && s->streamed == 1, "Call counts");
+    TEST_ASSERT(s->request_bytes == 200 && s->response_bytes == 400, "Byte counts");
+    TEST_ASSERT(s->prompt_tokens == 25 && s->completion_tokens == 80, "Token counts");
+    TEST_ASSERT(s->queue_ms == 40 && s->total_ms == 120, "Time sums");
+    TEST_ASSERT(s->ttfb_samples == 1 && s->ttfb_ms == 40, "Unknown ttfb not averaged in");
+    TEST_ASSERT(s->max_ms == 90, "Max latency");
+    TEST_ASSERT(find(stats, count, "openai-api", "") != NULL, "Default model entry");
+
+    provider_telemetry_reset();
+    TEST_ASSERT(provider_telemetry_get_stats(stats, MAX_STATS) == 0, "Reset forgets entries");
+    TEST_PASS("Calls add up per provider/model");
+}
+
+/* Test: Histogram buckets and percentile estimates */
+static int test_histogram(void) {
+    provider_telemetry_reset();
+    const long long* bounds = provider_telemetry_bucket_bounds();
+
+    /* 90 fast calls, 9 medium, 1 very slow */
+    provider_call_t call = { .provider = "claude-api", .model = "m", .result = ARGO_SUCCESS, .ttfb_ms = -1 };
+    for (int i = 0; i < 100; i++) {
+        call.total_ms = i < 90 ? 3 : (i < 99 ? 700 : 200000);
+        provider_telemetry_record(&call);
+    }
+
+    provider_telemetry_stats_t stats[MAX_STATS];
+    int count = provider_telemetry_get_stats(stats, MAX_STATS);
+    TEST_ASSERT(count == 1, "One entry");
+
+    unsigned long long total = 0;
+    for (int i = 0; i < PROVIDER_TELEMETRY_BUCKETS; i++) {
+        total += stats[0].histogram[i];
+    }
+    TEST_ASSERT(total == 100, "Every call in one bucket");
+    TEST_ASSERT(stats[0].histogram[0] == 90, "Fast calls in the first bucket");
+    TEST_ASSERT(stats[0].histogram[PROVIDER_TELEMETRY_BUCKETS - 1] == 1, "Slowest call in the open bucket");
+
+    TEST_ASSERT(provider_telemetry_percentile(&stats[0], 50.0) == bounds[0], "p50 in the fast bucket");
+    long long p95 = provider_telemetry_percentile(&stats[0], 95.0);
+    TEST_ASSERT(p95 >= 700 && p95 <= 1000, "p95 is the medium bucket bound");
+    TEST_ASSERT(provider_telemetry_percentile(&stats[0], 100.0) == 200000, "Open bucket reports the max");
+
+    provider_telemetry_reset();
+    TEST_PASS("Latency histogram and percentiles");
+}
+
+int main(void) {
+    int failed = 0;
+
+    printf("==========================================\n");
+    printf("Provider Telemetry Tests\n");
+    printf("==========================================\n\n");
+
+    failed += test_usage_formats();
+    failed += test_stream_usage();
+    failed += test_record_totals();
+    failed += test_histogram();
+
+    printf("\n");
+    if (failed == 0) {
+        printf("All provider telemetry tests passed!\n");
+        return 0;
+    } else {
+        printf("%d provider telemetry tests failed\n", failed);
+        return 1;
+    }
+}
@@ -0,0 +1,439 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* strdup(), usleep() */
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/* Project includes */
+#include "argo_rate_limit.h"
+#include "argo_ci_engine.h"
+#include "argo_api_common.h"
+#include "argo_http.h"
+#include "argo_error.h"
+#include "argo_limits.h"
+#include "argo_time.h"
+
+/* Test utilities */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "FAIL: %s\n", message); \
+            return 1; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        return 0; \
+    } while(0)
+
+#define FAR_DEADLINE_MS 1000000
+#define SLACK_MS 50
+#define REQUEST_BUFFER_SIZE 8192
+#define ENGINE_TIMEOUT_MS 10000
+
+/* Loopback server: the next g_throttle requests get 429 + g_retry_header */
+static int g_listen_fd = -1;
+static int g_port = 0;
+static pthread_mutex_t g_server_lock = PTHREAD_MUTEX_INITIALIZER;
+static int g_throttle = 0;
+static int g_requests = 0;
+static const char* g_retry_header = "Retry-After-ms: 30\r\n";
+
+static const char* g_response_path[] = {"message", "content"};
+static char g_url[ARGO_BUFFER_MEDIUM];
+static api_provider_config_t g_config;
+
+/* Helper: Arm the server */
+static void set_throttle(int count, const char* retry_header) {
+    pthread_mutex_lock(&g_server_lock);
+    g_throttle = count;
+    g_requests = 0;
+    g_retry_header = retry_header;
+    pthread_mutex_unlock(&g_server_lock);
+}
+
+static int served_requests(void) {
+    pthread_mutex_lock(&g_server_lock);
+    int requests = g_requests;
+    pthread_mutex_unlock(&g_server_lock);
+    return requests;
+}
+
+/* Helper: Serve one keep-alive connection */
+static void* connection_thread(void* arg) {
+    int fd = (int)(intptr_t)arg;
+    char buf[REQUEST_BUFFER_SIZE];
+    size_t used = 0;
+
+    while (true) {
+        ssize_t n = read(fd, buf + used, sizeof(buf) - used - 1);
+        if (n <= 0) break;
+        used += (size_t)n;
+        buf[used] = '\0';
+
+        char* end = strstr(buf, "\r\n\r\n");
+        if (!end) continue;
+        char* length = strstr(buf, "Content-Length: ");
+        size_t body_len = length && length < end ? (size_t)atoi(length + 16) : 0;
+        size_t header_len = (size_t)(end + 4 - buf);
+        if (used < header_len + body_len) continue;
+
+        pthread_mutex_lock(&g_server_lock);
+        g_requests++;
+        bool throttled = g_throttle > 0;
+        if (throttled) g_throttle--;
+        const char* retry = g_retry_header;
+        pthread_mutex_unlock(&g_server_lock);
+
+        const char* body = throttled ? "{\"error\":\"slow down\"}"
+                                     : "{\"choices\":[{\"message\":{\"content\":\"ok\"}}]}";
+        char reply[ARGO_BUFFER_MEDIUM];
+        int len = snprintf(reply, sizeof(reply),
+                           "HTTP/1.1 %s\r\nContent-Type: application/json\r\n%s"
+                           "Content-Length: %zu\r\n\r\n%s",
+                           throttled ? "429 Too Many Requests" : "200 OK",
+                           throttled ? retry : "x-ratelimit-limit-requests: 6000\r\n",
+                           strlen(body), body);
+        if (write(fd, reply, (size_t)len) != len) break;
+
+        used -= header_len + body_len;
+        memmove(buf, buf + header_len + body_len, used);
+    }
+
+    close(fd);
+    return NULL;
+}
+
+/* Helper: Accept loop, one thread per connection */
+static void* accept_thread(void* arg) {
+    (void)arg;
+    while (true) {
+        int fd = accept(g_listen_fd, NULL, NULL);
+        if (fd < 0) break;
+
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, connection_thread, (void*)(intptr_t)fd) == 0) {
+            pthread_detach(thread);
+        } else {
+            close(fd);
+        }
+    }
+    return NULL;
+}
+
+/* Helper: Start server on an ephemeral loopback port */
+static int start_server(pthread_t* thread) {
+    struct sockaddr_in addr = {0};
+    socklen_t addr_len = sizeof(addr);
+
+    g_listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (g_listen_fd < 0) return -1;
+
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(g_listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(g_listen_fd, 16) != 0 ||
+        getsockname(g_listen_fd, (struct sockaddr*)&addr, &addr_len) != 0) {
+        close(g_listen_fd);
+        return -1;
+    }
+    g_port = ntohs(addr.sin_port);
+
+    return pthread_create(thread, NULL, accept_thread, NULL);
+}
+
+/* Helper: Limiter for url and Authorization value */
+static rate_limiter_t* limiter_for(const char* url, const char* header, const char* value) {
+    http_request_t* req = http_request_new(HTTP_POST, url);
+    if (!req) return NULL;
+    if (header) http_request_add_header(req, header, value);
+    rate_limiter_t* limiter = rate_limit_for_request(req);
+    http_request_free(req);
+    return limiter;
+}
+
+/* Helper: Response with one or two headers */
+static http_response_t* fake_response(int status, const char* name1, const char* value1,
+                                      const char* name2, const char* value2) {
+    http_response_t* resp = calloc(1, sizeof(http_response_t));
+    const char* names[] = { name1, name2 };
+    const char* values[] = { value1, value2 };
+    resp->status_code = status;
+    for (int i = 1; i >= 0; i--) {
+        if (!names[i]) continue;
+        http_header_t* header = calloc(1, sizeof(http_header_t));
+        header->name = strdup(names[i]);
+        header->value = strdup(values[i]);
+        header->next = resp->headers;
+        resp->headers = header;
+    }
+    return resp;
+}
+
+/* Helper: OpenAI-style request body */
+static int build_request(json_builder_t* json, const char* model, const char* prompt, bool stream) {
+    api_chat_message_t message = { API_ROLE_USER, prompt };
+    (void)stream;
+    json_builder_object_begin(json);
+    json_builder_key_string(json, "model", model);
+    api_json_chat_messages(json, &message, 1);
+    json_builder_object_end(json);
+    return json_builder_error(json);
+}
+
+/* Test: A burst is spread out at the sustainable rate, in order */
+static int test_smoothing(void) {
+    rate_limiter_t* limiter = limiter_for("http://127.0.0.1:1/v1", "Authorization", "Bearer smooth");
+    TEST_ASSERT(limiter != NULL, "Limiter created");
+    rate_limit_set_limits(limiter, 3, 0);
+
+    long long now = argo_monotonic_ms();
+    long long start = 0;
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT(rate_limit_reserve(limiter, 1, now + FAR_DEADLINE_MS, &start) == ARGO_SUCCESS,
+                    "Burst within budget reserved");
+        TEST_ASSERT(start <= argo_monotonic_ms(), "Burst within budget starts now");
+    }
+    TEST_ASSERT(rate_limit_reserve(limiter, 1, now + FAR_DEADLINE_MS, &start) == ARGO_SUCCESS,
+                "Fourth request queued");
+    TEST_ASSERT(start >= now + 20000 - SLACK_MS && start <= now + 20000 + SLACK_MS,
+                "Fourth request waits one refill interval");
+    TEST_ASSERT(rate_limit_reserve(limiter, 1, now + FAR_DEADLINE_MS, &start) == ARGO_SUCCESS,
+                "Fifth request queued");
+    TEST_ASSERT(start >= now + 40000 - SLACK_MS && start <= now + 40000 + SLACK_MS,
+                "Fifth request queued behind the fourth");
+    TEST_ASSERT(rate_limit_reserve(limiter, 1, now + 1000, &start) == E_HTTP_RATE_LIMIT,
+                "Slot after the deadline refused");
+
+    rate_limit_stats_t stats;
+    rate_limit_get_stats(limiter, &stats);
+    TEST_ASSERT(stats.granted == 5 && stats.delayed == 2 && stats.rejected == 1, "Counters");
+    TEST_ASSERT(stats.requests_per_minute == 3, "Effective request limit");
+    TEST_PASS("A burst is spread out at the sustainable rate, in order");
+}
+
+/* Test: Prompt tokens are budgeted per minute */
+static int test_token_bucket(void) {
+    rate_limiter_t* limiter = limiter_for("http://127.0.0.1:1/v1", "Authorization", "Bearer tokens");
+    TEST_ASSERT(limiter != NULL, "Limiter created");
+    rate_limit_set_limits(limiter, 0, 1000);
+
+    long long now = argo_monotonic_ms();
+    long long start = 0;
+    TEST_ASSERT(rate_limit_reserve(limiter, 800, now + FAR_DEADLINE_MS, &start) == ARGO_SUCCESS &&
+                start <= argo_monotonic_ms(), "Request within token budget starts now");
+    TEST_ASSERT(rate_limit_reserve(limiter, 400, now + FAR_DEADLINE_MS, &start) == ARGO_SUCCESS,
+                "Over-budget request queued");
+    TEST_ASSERT(start >= now + 12000 - SLACK_MS && start <= now + 12000 + SLACK_MS,
+                "Waits until 200 more tokens have refilled");
+    TEST_ASSERT(rate_limit_estimate_tokens(4000) == 1001, "Body bytes to tokens");
+    TEST_PASS("Prompt tokens are budgeted per minute");
+}
+
+/* Test: One limiter per endpoint and credential */
+static int test_keys(void) {
+    rate_limiter_t* a = limiter_for("https://api.example.com/v1/chat", "Authorization", "Bearer k1");
+    rate_limiter_t* b = limiter_for("https://api.example.com/v1/other", "Authorization", "Bearer k1");
+    rate_limiter_t* c = limiter_for("https://api.example.com/v1/chat", "Authorization", "Bearer k2");
+    rate_limiter_t* d = limiter_for("https://api.example.com/v1/chat", "x-api-key", "k1");
+    rate_limiter_t* e = limiter_for("https://other.example.com/v1/chat", "Authorization", "Bearer k1");
+    TEST_ASSERT(a && a == b, "Same key and endpoint share a limiter across paths");
+    TEST_ASSERT(a != c && a != d && a != e && c != d, "Different keys or hosts are separate");
+
+    rate_limiter_t* f = limiter_for("https://g.example.com/m:streamGenerateContent?alt=sse&key=K1", NULL, NULL);
+    rate_limiter_t* g = limiter_for("https://g.example.com/m:generateContent?key=K1", NULL, NULL);
+    rate_limiter_t* h = limiter_for("https://g.example.com/m:generateContent?key=K2", NULL, NULL);
+    TEST_ASSERT(f && f == g && g != h, "URL key parameter identifies the credential");
+    TEST_ASSERT(limiter_for("not a url", NULL, NULL) == NULL, "Invalid URL has no limiter");
+    TEST_PASS("One limiter per endpoint and credential");
+}
+
+/* Test: Server headers set limits and pauses */
+static int test_headers(void) {
+    rate_limiter_t* limiter = limiter_for("http://127.0.0.1:2/v1", "Authorization", "Bearer headers");
+    TEST_ASSERT(limiter != NULL, "Limiter created");
+
+    http_response_t* resp = fake_response(HTTP_STATUS_OK, "x-ratelimit-limit-requests", "60",
+                                          "x-ratelimit-remaining-requests", "5");
+    long long now = argo_monotonic_ms();
+    TEST_ASSERT(!rate_limit_observe(limiter, resp), "200 is not retried");
+    http_response_free(resp);
+
+    rate_limit_stats_t stats;
+    rate_limit_get_stats(limiter, &stats);
+    TEST_ASSERT(stats.requests_per_minute == 60 && stats.paused_until_ms == 0, "Reported limit adopted");
+
+    long long start = 0;
+    for (int i = 0; i < 5; i++) {
+        rate_limit_reserve(limiter, 1, now + FAR_DEADLINE_MS, &start);
+    }
+    TEST_ASSERT(start <= argo_monotonic_ms(), "Remaining budget usable immediately");
+    rate_limit_reserve(limiter, 1, now + FAR_DEADLINE_MS, &start);
+    TEST_ASSERT(start >= now + 1000 - SLACK_MS, "Beyond the server's remaining count waits");
+
+    resp = fake_response(HTTP_STATUS_OK, "x-ratelimit-remaining-tokens", "0",
+                         "x-ratelimit-reset-tokens", "6m0s");
+    now = argo_monotonic_ms();
+    rate_limit_observe(limiter, resp);
+    http_response_free(resp);
+    rate_limit_get_stats(limiter, &stats);
+    TEST_ASSERT(stats.paused_until_ms >= now + 360000 - SLACK_MS, "Exhausted budget pauses until reset");
+
+    limiter = limiter_for("http://127.0.0.1:2/v1", "Authorization", "Bearer retry-after");
+    resp = fake_response(HTTP_STATUS_RATE_LIMIT, "Retry-After", "2", NULL, NULL);
+    now = argo_monotonic_ms();
+    TEST_ASSERT(rate_limit_observe(limiter, resp), "429 is retried");
+    http_response_free(resp);
+    rate_limit_get_stats(limiter, &stats);
+    TEST_ASSERT(stats.throttled == 1, "Throttle counted");
+    TEST_ASSERT(stats.paused_until_ms >= now + 2000 &&
+                stats.paused_until_ms <= now + 2000 + RATE_LIMIT_JITTER_MS + SLACK_MS,
+                "Retry-After honored with bounded jitter");
+    TEST_ASSERT(rate_limit_reserve(limiter, 1, now + 1000, &start) == E_HTTP_RATE_LIMIT,
+                "No slot while paused past the deadline");
+
+    limiter = limiter_for("http://127.0.0.1:2/v1", "Authorization", "Bearer backoff");
+    resp = fake_response(HTTP_STATUS_RATE_LIMIT, NULL, NULL, NULL, NULL);
+    now = argo_monotonic_ms();
+    rate_limit_observe(limiter, resp);
+    rate_limit_get_stats(limiter, &stats);
+    long long first = stats.paused_until_ms - now;
+    rate_limit_observe(limiter, resp);
+    http_response_free(resp);
+    rate_limit_get_stats(limiter, &stats);
+    long long second = stats.paused_until_ms - now;
+    TEST_ASSERT(first >= RATE_LIMIT_BACKOFF_BASE_MS / 2 && first <= RATE_LIMIT_BACKOFF_BASE_MS + SLACK_MS,
+                "Jittered backoff without Retry-After");
+    TEST_ASSERT(second >= RATE_LIMIT_BACKOFF_BASE_MS - SLACK_MS, "Backoff grows on repeated 429s");
+    TEST_PASS("Server headers set limits and pauses");
+}
+
+/* Test: Blocking execute retries 429s and gives up at the deadline */
+static int test_execute(void) {
+    char url[ARGO_BUFFER_MEDIUM];
+    snprintf(url, sizeof(url), "http://127.0.0.1:%d/v1/chat", g_port);
+    http_request_t* req = http_request_new(HTTP_POST, url);
+    http_request_add_header(req, HTTP_HEADER_AUTHORIZATION, "Bearer execute");
+    http_request_set_body(req, "{}", 2);
+
+    set_throttle(2, "Retry-After-ms: 30\r\n");
+    http_response_t* resp = NULL;
+    long long started = argo_monotonic_ms();
+    int result = rate_limit_execute(req, argo_monotonic_ms() + FAR_DEADLINE_MS, NULL, NULL, &resp);
+    TEST_ASSERT(result == ARGO_SUCCESS && resp && resp->status_code == HTTP_STATUS_OK,
+                "Succeeds after two 429s");
+    TEST_ASSERT(served_requests() == 3, "Server saw the retries");
+    TEST_ASSERT(argo_monotonic_ms() - started >= 60, "Waited out each Retry-After");
+    http_response_free(resp);
+
+    rate_limit_stats_t stats;
+    rate_limit_get_stats(rate_limit_for_request(req), &stats);
+    TEST_ASSERT(stats.throttled == 2 && stats.requests_per_minute == 6000, "Limits learned from replies");
+
+    set_throttle(1, "Retry-After: 30\r\n");
+    resp = NULL;
+    started = argo_monotonic_ms();
+    result = rate_limit_execute(req, argo_monotonic_ms() + 500, NULL, NULL, &resp);
+    TEST_ASSERT(result == ARGO_SUCCESS && resp && resp->status_code == HTTP_STATUS_RATE_LIMIT,
+                "Retry past the deadline returns the 429");
+    TEST_ASSERT(argo_monotonic_ms() - started < 500 && served_requests() == 1, "Gave up without waiting");
+    TEST_ASSERT(api_check_http_status(resp->status_code, "test") == E_HTTP_RATE_LIMIT, "Maps to rate limit");
+    http_response_free(resp);
+
+    resp = NULL;
+    result = rate_limit_execute(req, argo_monotonic_ms() + 500, NULL, NULL, &resp);
+    TEST_ASSERT(result == E_HTTP_RATE_LIMIT && resp == NULL, "Still paused: no request sent");
+    http_request_free(req);
+    TEST_PASS("Blocking execute retries 429s and gives up at the deadline");
+}
+
+/* Test: Engine retries a 429 without holding a thread */
+static int test_engine(void) {
+    snprintf(g_url, sizeof(g_url), "http://127.0.0.1:%d/v1/engine", g_port);
+    g_config = (api_provider_config_t){
+        .provider_name = "loopback",
+        .default_model = "test-model",
+        .api_url = g_url,
+        .auth = {.type = API_AUTH_BEARER, .value = "engine-key"},
+        .response_path = g_response_path,
+        .response_path_depth = 2,
+        .build_request = build_request,
+        .max_context = ARGO_BUFFER_STANDARD
+    };
+
+    ci_engine_t* engine = ci_engine_create(1);
+    TEST_ASSERT(engine != NULL, "Engine created");
+
+    set_throttle(1, "Retry-After-ms: 50\r\n");
+    ci_future_t* future = ci_engine_submit(engine, generic_api_create_provider(&g_config, NULL),
+                                           "hello", ENGINE_TIMEOUT_MS, NULL, NULL);
+    TEST_ASSERT(future != NULL, "Submitted");
+    TEST_ASSERT(ci_future_wait(future, ENGINE_TIMEOUT_MS) == ARGO_SUCCESS, "Completed");
+    const ci_response_t* response = ci_future_response(future);
+    TEST_ASSERT(response->success && strcmp(response->content, "ok") == 0, "Retried to success");
+    TEST_ASSERT(served_requests() == 2, "One 429, one success");
+    ci_future_release(future);
+
+    /* Deferred query is cancelled cleanly at shutdown */
+    set_throttle(1, "Retry-After: 60\r\n");
+    future = ci_engine_submit(engine, generic_api_create_provider(&g_config, NULL),
+                              "hello", ENGINE_TIMEOUT_MS * 10, NULL, NULL);
+    TEST_ASSERT(future != NULL, "Submitted");
+    while (served_requests() < 1) usleep(1000);
+    usleep(20000);
+    TEST_ASSERT(!ci_future_done(future), "Waiting for Retry-After");
+    ci_engine_destroy(engine);
+    TEST_ASSERT(ci_future_done(future) && ci_future_response(future)->error_code == E_CI_CANCELLED,
+                "Cancelled at shutdown");
+    ci_future_release(future);
+    TEST_PASS("Engine retries a 429 without holding a thread");
+}
+
+int main(void) {
+    int failed = 0;
+
+    printf("==========================================\n");
+    printf("Rate Limit Tests\n");
+    printf("==========================================\n\n");
+
+    pthread_t server;
+    if (start_server(&server) != 0) {
+        fprintf(stderr, "FAIL: could not start loopback server\n");
+        return 1;
+    }
+
+    failed += test_smoothing();
+    failed += test_token_bucket();
+    failed += test_keys();
+    failed += test_headers();
+    failed += test_execute();
+    failed += test_engine();
+
+    shutdown(g_listen_fd, SHUT_RDWR);
+    close(g_listen_fd);
+    pthread_join(server, NULL);
+    rate_limit_cleanup();
+
+    printf("\n");
+    if (failed == 0) {
+        printf("All rate limit tests passed!\n");
+        return 0;
+    } else {
+        printf("%d rate limit tests failed\n", failed);
+        return 1;
+    }
+}
@@ -0,0 +1,190 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* usleep() */
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Project includes */
+#include "argo_response_cache.h"
+#include "argo_error.h"
+#include "argo_limits.h"
+
+/* Test utilities */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "FAIL: %s\n", message); \
+            return 1; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        return 0; \
+    } while(0)
+
+#define TEST_DIR_FORMAT "/tmp/argo_test_response_cache_%d"
+#define TTL_SECONDS 1
+#define TTL_WAIT_USEC 1100000       /* Just past TTL_SECONDS */
+
+static char g_test_dir[ARGO_PATH_MAX];
+
+/* Helper: Lookup matches expected response */
+static bool cached_as(response_cache_t* cache, const response_cache_key_t* key, const char* expected) {
+    char* response = NULL;
+    if (response_cache_lookup(cache, key, &response) != ARGO_SUCCESS) return false;
+    bool same = strcmp(response, expected) == 0;
+    free(response);
+    return same;
+}
+
+/* Test: Mode parsing */
+static int test_modes(void) {
+    response_cache_mode_t mode = RESPONSE_CACHE_BYPASS;
+    TEST_ASSERT(response_cache_parse_mode("prefer", &mode) == ARGO_SUCCESS && mode == RESPONSE_CACHE_PREFER,
+                "prefer parses");
+    TEST_ASSERT(response_cache_parse_mode("only", &mode) == ARGO_SUCCESS && mode == RESPONSE_CACHE_ONLY,
+                "only parses");
+    TEST_ASSERT(response_cache_parse_mode("bypass", &mode) == ARGO_SUCCESS && mode == RESPONSE_CACHE_BYPASS,
+                "bypass parses");
+    TEST_ASSERT(response_cache_parse_mode("always", &mode) == E_INVALID_PARAMS, "Unknown mode rejected");
+    TEST_PASS("Mode parsing");
+}
+
+/* Test: Every key field addresses a distinct entry */
+static int test_keys(void) {
+    response_cache_t* cache = response_cache_create(g_test_dir, 0, 0);
+    response_cache_key_t key = {"claude_api", "m1", NULL, "summarize"};
+    response_cache_key_t other_model = {"claude_api", "m2", NULL, "summarize"};
+    response_cache_key_t other_params = {"claude_api", "m1", "{\"temperature\":0}", "summarize"};
+    response_cache_key_t split = {"claude_ap", "im1", NULL, "summarize"};
+    char* response = NULL;
+
+    TEST_ASSERT(cache != NULL, "Create cache");
+    TEST_ASSERT(response_cache_lookup(cache, &key, &response) == E_NOT_FOUND, "Empty cache misses");
+    TEST_ASSERT(response_cache_store(cache, &key, "short summary") == ARGO_SUCCESS, "Store");
+    TEST_ASSERT(cached_as(cache, &key, "short summary"), "Same key hits");
+    TEST_ASSERT(!cached_as(cache, &other_model, "short summary"), "Model is part of the key");
+    TEST_ASSERT(!cached_as(cache, &other_params, "short summary"), "Params are part of the key");
+    TEST_ASSERT(!cached_as(cache, &split, "short summary"), "Field boundaries are part of the key");
+
+    response_cache_stats_t stats;
+    response_cache_get_stats(cache, &stats);
+    TEST_ASSERT(stats.memory_hits == 1 && stats.misses == 4 && stats.stores == 1, "Counters track lookups");
+
+    response_cache_destroy(cache);
+    TEST_PASS("Every key field addresses a distinct entry");
+}
+
+/* Test: Disk tier survives restart and LRU bounds memory */
+static int test_tiers(void) {
+    response_cache_key_t a = {"openai_api", NULL, NULL, "prompt a"};
+    response_cache_key_t b = {"openai_api", NULL, NULL, "prompt b"};
+    response_cache_key_t c = {"openai_api", NULL, NULL, "prompt c"};
+    response_cache_stats_t stats;
+
+    response_cache_t* cache = response_cache_create(g_test_dir, 2, 0);
+    response_cache_store(cache, &a, "answer a");
+    response_cache_store(cache, &b, "answer b");
+    TEST_ASSERT(cached_as(cache, &a, "answer a"), "a hits, now most recent");
+    response_cache_store(cache, &c, "answer c");
+
+    response_cache_get_stats(cache, &stats);
+    TEST_ASSERT(stats.entries == 2 && stats.evictions == 1, "Memory tier holds max entries");
+    TEST_ASSERT(cached_as(cache, &b, "answer b"), "Evicted b still served from disk");
+    response_cache_get_stats(cache, &stats);
+    TEST_ASSERT(stats.disk_hits == 1, "b was a disk hit");
+    response_cache_destroy(cache);
+
+    /* New instance, e.g. after a daemon restart */
+    cache = response_cache_create(g_test_dir, 2, 0);
+    TEST_ASSERT(cached_as(cache, &c, "answer c"), "Disk hit after restart");
+    TEST_ASSERT(cached_as(cache, &c, "answer c"), "Promoted to memory");
+    response_cache_get_stats(cache, &stats);
+    TEST_ASSERT(stats.disk_hits == 1 && stats.memory_hits == 1, "Second lookup from memory");
+
+    response_cache_destroy(cache);
+    TEST_PASS("Disk tier survives restart and LRU bounds memory");
+}
+
+/* Test: Entries expire after the TTL */
+static int test_ttl(void) {
+    char dir[ARGO_PATH_MAX];
+    snprintf(dir, sizeof(dir), "%s/ttl", g_test_dir);
+    response_cache_t* cache = response_cache_create(dir, 0, TTL_SECONDS);
+    response_cache_key_t a = {"grok_api", NULL, NULL, "fresh"};
+    response_cache_key_t b = {"grok_api", NULL, NULL, "stale"};
+
+    response_cache_store(cache, &a, "a");
+    response_cache_store(cache, &b, "b");
+    TEST_ASSERT(response_cache_purge_expired(cache) == 0, "Fresh entries kept");
+
+    usleep(TTL_WAIT_USEC);
+    TEST_ASSERT(!cached_as(cache, &a, "a"), "Expired entry misses");
+    TEST_ASSERT(response_cache_purge_expired(cache) == 1, "Purge removes remaining expired file");
+
+    response_cache_stats_t stats;
+    response_cache_get_stats(cache, &stats);
+    TEST_ASSERT(stats.entries == 0, "Memory tier emptied");
+
+    response_cache_destroy(cache);
+    TEST_PASS("Entries expire after the TTL");
+}
+
+/* Test: A directory too long for entry paths disables only the disk tier */
+static int test_long_dir(void) {
+    char dir[ARGO_PATH_MAX - 8];    /* Fits the cache, not "<dir>/<hash>.json" */
+    memset(dir, 'd', sizeof(dir) - 1);
+    dir[0] = '/';
+    dir[sizeof(dir) - 1] = '\0';
+    response_cache_t* cache = response_cache_create(dir, 0, 0);
+    response_cache_key_t a = {"grok_api", NULL, NULL, "long dir"};
+
+    TEST_ASSERT(response_cache_store(cache, &a, "a") == E_INPUT_TOO_LARGE, "Disk store rejected");
+    TEST_ASSERT(cached_as(cache, &a, "a"), "Memory tier still serves");
+    response_cache_destroy(cache);
+
+    cache = response_cache_create(dir, 0, 0);
+    TEST_ASSERT(!cached_as(cache, &a, "a"), "Disk lookup is a miss");
+    TEST_ASSERT(response_cache_purge_expired(cache) == 0, "Purge is a no-op");
+    response_cache_destroy(cache);
+    TEST_PASS("Over-long cache directory disables only the disk tier");
+}
+
+int main(void) {
+    int failed = 0;
+
+    printf("==========================================\n");
+    printf("Response Cache Tests\n");
+    printf("==========================================\n\n");
+
+    snprintf(g_test_dir, sizeof(g_test_dir), TEST_DIR_FORMAT, getpid());
+
+    failed += test_modes();
+    failed += test_keys();
+    failed += test_tiers();
+    failed += test_ttl();
+    failed += test_long_dir();
+
+    char cmd[ARGO_PATH_MAX];
+    snprintf(cmd, sizeof(cmd), "rm -rf %s", g_test_dir);
+    if (system(cmd) != 0) {
+        fprintf(stderr, "Warning: could not remove %s\n", g_test_dir);
+    }
+
+    printf("\n");
+    if (failed == 0) {
+        printf("All response cache tests passed!\n");
+        return 0;
+    } else {
+        printf("%d response cache tests failed\n", failed);
+        return 1;
+    }
+}
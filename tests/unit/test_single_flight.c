@@ -0,0 +1,235 @@
+/* © 2025 Casey Koons All rights reserved */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  /* usleep() */
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+/* Project includes */
+#include "argo_single_flight.h"
+#include "argo_ci_engine.h"
+#include "argo_mock.h"
+#include "argo_error.h"
+
+/* Test utilities */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "FAIL: %s\n", message); \
+            return 1; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        return 0; \
+    } while(0)
+
+#define CALLERS 8
+#define SLOW_QUERY_USEC 300000
+#define SLOW_START_USEC 100000
+#define SETTLE_USEC 50000
+
+static ci_engine_t* g_engine = NULL;
+static single_flight_t* g_group = NULL;
+
+/* Slow provider: mock query behind a delay, so callers overlap */
+static int (*g_mock_query)(ci_provider_t*, const char*, ci_response_callback, void*) = NULL;
+
+static int slow_query(ci_provider_t* provider, const char* prompt,
+                      ci_response_callback callback, void* userdata) {
+    usleep(SLOW_QUERY_USEC);
+    return g_mock_query(provider, prompt, callback, userdata);
+}
+
+/* Start function: count starts, submit a slow mock query */
+static pthread_mutex_t g_count_lock = PTHREAD_MUTEX_INITIALIZER;
+static int g_starts = 0;
+static int g_completed_error = ARGO_SUCCESS;
+
+static void record_completion(const ci_response_t* response, void* userdata) {
+    (void)userdata;
+    pthread_mutex_lock(&g_count_lock);
+    g_completed_error = response->error_code;
+    pthread_mutex_unlock(&g_count_lock);
+}
+
+static int start_slow(void* context, ci_future_t** future) {
+    pthread_mutex_lock(&g_count_lock);
+    g_starts++;
+    pthread_mutex_unlock(&g_count_lock);
+
+    ci_provider_t* provider = mock_provider_create(NULL);
+    if (!provider) return E_SYSTEM_MEMORY;
+    mock_provider_set_response(provider, (const char*)context);
+    g_mock_query = provider->query;
+    provider->query = slow_query;
+
+    *future = ci_engine_submit(g_engine, provider, "prompt", 0, record_completion, NULL);
+    return *future ? ARGO_SUCCESS : E_SYSTEM_MEMORY;
+}
+
+static int start_failing(void* context, ci_future_t** future) {
+    (void)context;
+    (void)future;
+    pthread_mutex_lock(&g_count_lock);
+    g_starts++;
+    pthread_mutex_unlock(&g_count_lock);
+    usleep(SLOW_START_USEC);
+    return E_NOT_FOUND;
+}
+
+/* One concurrent caller */
+typedef struct {
+    const char* key;
+    single_flight_start_fn start;
+    int result;
+    bool shared;
+    char answer[64];
+} caller_t;
+
+static void* caller_thread(void* arg) {
+    caller_t* caller = (caller_t*)arg;
+    single_flight_call_t* call = NULL;
+
+    caller->result = single_flight_do(g_group, caller->key, caller->start, "shared answer",
+                                      &call, &caller->shared);
+    if (caller->result == ARGO_SUCCESS) {
+        ci_future_t* future = single_flight_future(call);
+        ci_future_wait(future, CI_ENGINE_NO_TIMEOUT);
+        const ci_response_t* response = ci_future_response(future);
+        if (response->success) {
+            snprintf(caller->answer, sizeof(caller->answer), "%s", response->content);
+        }
+        single_flight_leave(g_group, call);
+    }
+    return NULL;
+}
+
+/* Helper: Run CALLERS concurrent callers */
+static void run_callers(caller_t* callers, const char* key, single_flight_start_fn start) {
+    pthread_t threads[CALLERS];
+    g_starts = 0;
+    for (int i = 0; i < CALLERS; i++) {
+        memset(&callers[i], 0, sizeof(callers[i]));
+        callers[i].key = key;
+        callers[i].start = start;
+        pthread_create(&threads[i], NULL, caller_thread, &callers[i]);
+    }
+    for (int i = 0; i < CALLERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+}
+
+/* Test: Identical concurrent queries share one request */
+static int test_coalesce(void) {
+    caller_t callers[CALLERS];
+    run_callers(callers, "claude_api|m|prompt", start_slow);
+
+    int shared = 0;
+    for (int i = 0; i < CALLERS; i++) {
+        TEST_ASSERT(callers[i].result == ARGO_SUCCESS, "Every caller succeeds");
+        TEST_ASSERT(strcmp(callers[i].answer, "shared answer") == 0, "Every caller gets the answer");
+        shared += callers[i].shared ? 1 : 0;
+    }
+    TEST_ASSERT(g_starts == 1, "One request started");
+    TEST_ASSERT(shared == CALLERS - 1, "Everyone else joined");
+
+    /* Completed query is not reused */
+    run_callers(callers, "claude_api|m|prompt", start_slow);
+    TEST_ASSERT(g_starts == 1, "Next burst starts one fresh request");
+
+    single_flight_stats_t stats;
+    single_flight_get_stats(g_group, &stats);
+    TEST_ASSERT(stats.in_flight == 0 && stats.started == 2 && stats.joined == 2 * (CALLERS - 1),
+                "Stats count started and joined");
+    TEST_PASS("Identical concurrent queries share one request");
+}
+
+/* Test: Different keys run independently */
+static int test_distinct_keys(void) {
+    single_flight_call_t* a = NULL;
+    single_flight_call_t* b = NULL;
+    bool shared = true;
+
+    g_starts = 0;
+    TEST_ASSERT(single_flight_do(g_group, "key-a", start_slow, "a", &a, &shared) == ARGO_SUCCESS && !shared,
+                "First key starts");
+    TEST_ASSERT(single_flight_do(g_group, "key-b", start_slow, "b", &b, &shared) == ARGO_SUCCESS && !shared,
+                "Second key starts");
+    TEST_ASSERT(g_starts == 2 && single_flight_future(a) != single_flight_future(b), "Separate requests");
+
+    ci_future_wait(single_flight_future(a), CI_ENGINE_NO_TIMEOUT);
+    ci_future_wait(single_flight_future(b), CI_ENGINE_NO_TIMEOUT);
+    single_flight_leave(g_group, a);
+    single_flight_leave(g_group, b);
+    TEST_PASS("Different keys run independently");
+}
+
+/* Test: A failed start fails every joined caller */
+static int test_start_failure(void) {
+    caller_t callers[CALLERS];
+    run_callers(callers, "unknown|prompt", start_failing);
+
+    for (int i = 0; i < CALLERS; i++) {
+        TEST_ASSERT(callers[i].result == E_NOT_FOUND, "Start error reaches every caller");
+    }
+    TEST_ASSERT(g_starts == 1, "Failing start ran once");
+    TEST_PASS("A failed start fails every joined caller");
+}
+
+/* Test: Last caller out cancels an unfinished query */
+static int test_last_leave_cancels(void) {
+    single_flight_call_t* call = NULL;
+
+    g_completed_error = ARGO_SUCCESS;
+    TEST_ASSERT(single_flight_do(g_group, "abandoned", start_slow, "x", &call, NULL) == ARGO_SUCCESS,
+                "Start query");
+    single_flight_leave(g_group, call);
+    usleep(SETTLE_USEC);
+
+    pthread_mutex_lock(&g_count_lock);
+    int error = g_completed_error;
+    pthread_mutex_unlock(&g_count_lock);
+    TEST_ASSERT(error == E_CI_CANCELLED, "Abandoned query cancelled");
+    TEST_PASS("Last caller out cancels an unfinished query");
+}
+
+int main(void) {
+    int failed = 0;
+
+    printf("==========================================\n");
+    printf("Single Flight Tests\n");
+    printf("==========================================\n\n");
+
+    g_engine = ci_engine_create(CALLERS);
+    g_group = single_flight_create();
+    if (!g_engine || !g_group) {
+        fprintf(stderr, "FAIL: could not create engine\n");
+        return 1;
+    }
+
+    failed += test_coalesce();
+    failed += test_distinct_keys();
+    failed += test_start_failure();
+    failed += test_last_leave_cancels();
+
+    ci_engine_destroy(g_engine);
+    single_flight_destroy(g_group);
+
+    printf("\n");
+    if (failed == 0) {
+        printf("All single flight tests passed!\n");
+        return 0;
+    } else {
+        printf("%d single flight tests failed\n", failed);
+        return 1;
+    }
+}
@@ -0,0 +1,188 @@
+/* © 2025 Casey Koons All rights reserved */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Project includes */
+#include "argo_stream_decoder.h"
+#include "argo_error.h"
+#include "argo_limits.h"
+
+/* Test utilities */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "FAIL: %s\n", message); \
+            return 1; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        return 0; \
+    } while(0)
+
+/* Collected deltas */
+typedef struct {
+    char text[ARGO_BUFFER_STANDARD];
+    size_t len;
+    int deltas;
+} collected_t;
+
+/* Helper: Append each delta */
+static void collect(const char* text, size_t len, void* userdata) {
+    collected_t* out = (collected_t*)userdata;
+    if (out->len + len < sizeof(out->text)) {
+        memcpy(out->text + out->len, text, len);
+        out->len += len;
+        out->text[out->len] = '\0';
+    }
+    out->deltas++;
+}
+
+/* Helper: Feed a whole stream in fixed-size pieces */
+static int feed_split(stream_decoder_t* decoder, const char* stream, size_t piece) {
+    size_t len = strlen(stream);
+    for (size_t off = 0; off < len; off += piece) {
+        size_t n = (len - off < piece) ? len - off : piece;
+        int result = stream_decoder_feed(decoder, stream + off, n);
+        if (result != ARGO_SUCCESS) return result;
+    }
+    return stream_decoder_finish(decoder);
+}
+
+/* Test: OpenAI-compatible SSE, any split point */
+static int test_openai_sse(void) {
+    const char* stream =
+        ": keep-alive\r\n\r\n"
+        "data: {\"choices\":[{\"delta\":{\"role\":\"assistant\"}}]}\r\n\r\n"
+        "data: {\"choices\":[{\"delta\":{\"content\":\"Hello\"}}]}\r\n\r\n"
+        "data: {\"choices\":[{\"delta\":{\"content\":\" w\\u00f6rld\"}}]}\n\n"
+        "data: {\"choices\":[{\"delta\":{},\"finish_reason\":\"stop\"}]}\n\n"
+        "data: [DONE]\n\n"
+        "data: {\"choices\":[{\"delta\":{\"content\":\"ignored\"}}]}\n\n";
+
+    size_t pieces[] = {1, 2, 7, 64, 4096};
+    for (size_t i = 0; i < sizeof(pieces) / sizeof(pieces[0]); i++) {
+        collected_t out = {0};
+        stream_decoder_t* decoder = stream_decoder_create(STREAM_FORMAT_SSE, STREAM_DELTA_OPENAI,
+                                                          collect, &out);
+        TEST_ASSERT(decoder != NULL, "Should create decoder");
+        TEST_ASSERT(feed_split(decoder, stream, pieces[i]) == ARGO_SUCCESS, "Stream decodes");
+        TEST_ASSERT(strcmp(out.text, "Hello w\xc3\xb6rld") == 0, "Deltas joined in order");
+        TEST_ASSERT(out.deltas == 2, "Role and finish events skipped");
+        TEST_ASSERT(stream_decoder_done(decoder), "[DONE] ends the stream");
+        stream_decoder_destroy(decoder);
+    }
+    TEST_PASS("OpenAI SSE decoding");
+}
+
+/* Test: Claude event stream with typed events */
+static int test_claude_sse(void) {
+    const char* stream =
+        "event: message_start\n"
+        "data: {\"type\":\"message_start\",\"message\":{\"content\":[]}}\n\n"
+        "event: ping\n"
+        "data: {\"type\":\"ping\"}\n\n"
+        "event: content_block_delta\n"
+        "data: {\"type\":\"content_block_delta\",\"index\":0,"
+        "\"delta\":{\"type\":\"text_delta\",\"text\":\"Hi\"}}\n\n"
+        "event: content_block_delta\n"
+        "data: {\"type\":\"content_block_delta\",\"index\":0,"
+        "\"delta\":{\"type\":\"text_delta\",\"text\":\" there\\n\"}}\n\n"
+        "event: message_delta\n"
+        "data: {\"type\":\"message_delta\",\"delta\":{\"stop_reason\":\"end_turn\"}}\n\n";
+
+    collected_t out = {0};
+    stream_decoder_t* decoder = stream_decoder_create(STREAM_FORMAT_SSE, STREAM_DELTA_CLAUDE,
+                                                      collect, &out);
+    TEST_ASSERT(feed_split(decoder, stream, 5) == ARGO_SUCCESS, "Stream decodes");
+    TEST_ASSERT(strcmp(out.text, "Hi there\n") == 0, "Text deltas extracted");
+    TEST_ASSERT(!stream_decoder_done(decoder), "No end marker in Claude streams");
+    stream_decoder_destroy(decoder);
+    TEST_PASS("Claude SSE decoding");
+}
+
+/* Test: Gemini events, multi-line data, unterminated final event */
+static int test_gemini_sse(void) {
+    const char* stream =
+        "data: {\"candidates\":[{\"content\":{\"parts\":[{\"text\":\"One\"}]}}]}\n\n"
+        "data: {\"candidates\":[{\"content\":\n"
+        "data: {\"parts\":[{\"text\":\" two\"}]}}]}\n\n"
+        "data: {\"candidates\":[{\"content\":{\"parts\":[{\"text\":\" three\"}]}}]}";
+
+    collected_t out = {0};
+    stream_decoder_t* decoder = stream_decoder_create(STREAM_FORMAT_SSE, STREAM_DELTA_GEMINI,
+                                                      collect, &out);
+    TEST_ASSERT(feed_split(decoder, stream, 3) == ARGO_SUCCESS, "Stream decodes");
+    TEST_ASSERT(strcmp(out.text, "One two three") == 0, "Data lines joined and final event flushed");
+    stream_decoder_destroy(decoder);
+    TEST_PASS("Gemini SSE decoding");
+}
+
+/* Test: NDJSON with done marker */
+static int test_ndjson(void) {
+    const char* stream =
+        "{\"response\":\"a\",\"done\":false}\n"
+        "\n"
+        "{\"response\":\"b\",\"done\":false}\r\n"
+        "{\"response\":\"\",\"done\":true}\n"
+        "{\"response\":\"late\",\"done\":false}\n";
+
+    collected_t out = {0};
+    stream_decoder_t* decoder = stream_decoder_create(STREAM_FORMAT_NDJSON, STREAM_DELTA_OLLAMA,
+                                                      collect, &out);
+    TEST_ASSERT(feed_split(decoder, stream, 4) == ARGO_SUCCESS, "Stream decodes");
+    TEST_ASSERT(strcmp(out.text, "ab") == 0, "Lines decoded, empty delta skipped");
+    TEST_ASSERT(stream_decoder_done(decoder), "done:true ends the stream");
+    stream_decoder_destroy(decoder);
+    TEST_PASS("NDJSON decoding");
+}
+
+/* Test: Error events and malformed data */
+static int test_errors(void) {
+    collected_t out = {0};
+    stream_decoder_t* decoder = stream_decoder_create(STREAM_FORMAT_SSE, STREAM_DELTA_CLAUDE,
+                                                      collect, &out);
+    const char* error_stream =
+        "data: {\"type\":\"content_block_delta\",\"delta\":{\"text\":\"partial\"}}\n\n"
+        "event: error\n"
+        "data: {\"type\":\"error\",\"error\":{\"type\":\"overloaded_error\",\"message\":\"Overloaded\"}}\n\n";
+    TEST_ASSERT(feed_split(decoder, error_stream, 16) == E_PROTOCOL_HTTP, "Error event fails the stream");
+    TEST_ASSERT(stream_decoder_feed(decoder, "data: {}\n\n", 10) == E_PROTOCOL_HTTP, "Error is sticky");
+    TEST_ASSERT(strcmp(out.text, "partial") == 0, "Deltas before the error delivered");
+    stream_decoder_destroy(decoder);
+
+    decoder = stream_decoder_create(STREAM_FORMAT_NDJSON, STREAM_DELTA_OLLAMA, collect, &out);
+    TEST_ASSERT(feed_split(decoder, "{\"response\":\n", 64) == E_PROTOCOL_FORMAT, "Bad JSON rejected");
+    stream_decoder_destroy(decoder);
+
+    TEST_ASSERT(stream_decoder_create(STREAM_FORMAT_SSE, NULL, collect, &out) == NULL,
+                "Pointer required");
+    TEST_PASS("Errors reported");
+}
+
+/* Main test runner */
+int main(void) {
+    int failed = 0;
+
+    printf("Running stream decoder tests...\n\n");
+
+    failed += test_openai_sse();
+    failed += test_claude_sse();
+    failed += test_gemini_sse();
+    failed += test_ndjson();
+    failed += test_errors();
+
+    printf("\n");
+    if (failed == 0) {
+        printf("All stream decoder tests passed!\n");
+        return 0;
+    } else {
+        printf("%d stream decoder tests failed\n", failed);
+        return 1;
+    }
+}
@@ -0,0 +1,304 @@
+/* © 2025 Casey Koons All rights reserved */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/* Project includes */
+#include "argo_task_graph.h"
+#include "argo_file_utils.h"
+#include "argo_error.h"
+
+/* Test utilities */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "FAIL: %s\n", message); \
+            return 1; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        return 0; \
+    } while(0)
+
+#define TEST_DIR_FORMAT "/tmp/argo_test_task_graph_%d"
+
+static char g_test_dir[ARGO_PATH_MAX];
+static volatile sig_atomic_t g_cancel = 0;
+
+/* Helper: Cancel handler */
+static void cancel_handler(int sig) {
+    (void)sig;
+    g_cancel = 1;
+}
+
+/* Helper: Parse and validate, returning the validate result */
+static int load_graph(const char* json, task_graph_t** graph) {
+    int result = task_graph_parse(json, graph);
+    if (result != ARGO_SUCCESS) return result;
+    return task_graph_validate(*graph);
+}
+
+/* Helper: Write a task script that appends its id to order.txt */
+static void write_script(const char* name, int exit_code) {
+    char path[ARGO_PATH_MAX];
+    snprintf(path, sizeof(path), "%s/%s", g_test_dir, name);
+
+    FILE* fp = fopen(path, "w");
+    if (!fp) return;
+    fprintf(fp, "echo \"$ARGO_TASK_ID\" >> %s/order.txt\nexit %d\n", g_test_dir, exit_code);
+    fclose(fp);
+}
+
+/* Test: Parse tasks.json as written by generate_tasks */
+static int test_parse(void) {
+    const char* json =
+        "{\"project_name\":\"demo\",\"tasks\":["
+        "{\"id\":\"setup\",\"name\":\"Setup\",\"type\":\"setup\",\"depends_on\":[]},"
+        "{\"id\":\"impl_a\",\"description\":\"x\",\"depends_on\":[\"setup\"],\"estimate\":3},"
+        "{\"id\":\"impl_b\",\"depends_on\":[\"setup\"],\"script\":\"/bin/b.sh\"}"
+        "]}";
+    task_graph_t* graph = NULL;
+
+    TEST_ASSERT(load_graph(json, &graph) == ARGO_SUCCESS, "Should parse and validate");
+    TEST_ASSERT(graph->count == 3, "Should have 3 tasks");
+    TEST_ASSERT(strcmp(graph->nodes[0].name, "Setup") == 0, "Should read name");
+    TEST_ASSERT(strcmp(graph->nodes[1].name, "impl_a") == 0, "Name should default to id");
+    TEST_ASSERT(graph->nodes[1].estimate == 3, "Should read estimate");
+    TEST_ASSERT(graph->nodes[0].estimate == TASK_GRAPH_DEFAULT_ESTIMATE, "Estimate should default");
+    TEST_ASSERT(strcmp(graph->nodes[2].script, "/bin/b.sh") == 0, "Should read script");
+    TEST_ASSERT(graph->nodes[0].dependent_count == 2, "Setup should have 2 dependents");
+    TEST_ASSERT(task_graph_find(graph, "impl_b") == 2, "Should find by id");
+
+    task_graph_destroy(graph);
+
+    TEST_ASSERT(task_graph_parse("{\"name\":\"x\"}", &graph) == E_INPUT_FORMAT,
+                "Missing tasks array should fail");
+    TEST_ASSERT(task_graph_parse("{\"tasks\":[", &graph) == E_INPUT_FORMAT,
+                "Malformed JSON should fail");
+    TEST_PASS("Parse tasks.json works");
+}
+
+/* Test: Reject duplicate ids and unknown dependencies */
+static int test_validation_errors(void) {
+    task_graph_t* graph = NULL;
+
+    TEST_ASSERT(load_graph("{\"tasks\":[{\"id\":\"a\"},{\"id\":\"a\"}]}", &graph) == E_WORKFLOW_INVALID,
+                "Duplicate id should fail");
+    TEST_ASSERT(strstr(graph->error, "Duplicate") != NULL, "Error should name duplicate");
+    task_graph_destroy(graph);
+
+    TEST_ASSERT(load_graph("{\"tasks\":[{\"id\":\"a\",\"depends_on\":[\"zz\"]}]}", &graph) == E_WORKFLOW_INVALID,
+                "Unknown dependency should fail");
+    TEST_ASSERT(strstr(graph->error, "'zz'") != NULL, "Error should name unknown dependency");
+    task_graph_destroy(graph);
+
+    TEST_PASS("Validation errors reported");
+}
+
+/* Test: Cycle detection names the cycle */
+static int test_cycle_detection(void) {
+    const char* json =
+        "{\"tasks\":["
+        "{\"id\":\"root\"},"
+        "{\"id\":\"a\",\"depends_on\":[\"root\",\"c\"]},"
+        "{\"id\":\"b\",\"depends_on\":[\"a\"]},"
+        "{\"id\":\"c\",\"depends_on\":[\"b\"]}"
+        "]}";
+    task_graph_t* graph = NULL;
+
+    TEST_ASSERT(load_graph(json, &graph) == E_WORKFLOW_INVALID, "Cycle should fail validation");
+    TEST_ASSERT(strstr(graph->error, "cycle") != NULL, "Error should mention cycle");
+    TEST_ASSERT(strstr(graph->error, "root") == NULL, "Cycle should not include root");
+    TEST_ASSERT(strstr(graph->error, "a") && strstr(graph->error, "b") && strstr(graph->error, "c"),
+                "Cycle should list its members");
+    task_graph_destroy(graph);
+
+    TEST_ASSERT(load_graph("{\"tasks\":[{\"id\":\"s\",\"depends_on\":[\"s\"]}]}", &graph) == E_WORKFLOW_INVALID,
+                "Self dependency should fail");
+    task_graph_destroy(graph);
+
+    TEST_PASS("Cycle detection works");
+}
+
+/* Test: Priorities follow the longest remaining chain */
+static int test_critical_path(void) {
+    const char* json =
+        "{\"tasks\":["
+        "{\"id\":\"short\"},"
+        "{\"id\":\"long1\",\"estimate\":2},"
+        "{\"id\":\"long2\",\"depends_on\":[\"long1\"],\"estimate\":3},"
+        "{\"id\":\"join\",\"depends_on\":[\"short\",\"long2\"]}"
+        "]}";
+    task_graph_t* graph = NULL;
+
+    TEST_ASSERT(load_graph(json, &graph) == ARGO_SUCCESS, "Should validate");
+    TEST_ASSERT(graph->critical_path == 6, "Critical path should be 2+3+1");
+    TEST_ASSERT(graph->nodes[task_graph_find(graph, "long1")].priority == 6, "long1 heads critical path");
+    TEST_ASSERT(graph->nodes[task_graph_find(graph, "short")].priority == 2, "short priority");
+    TEST_ASSERT(graph->nodes[task_graph_find(graph, "join")].priority == 1, "join priority");
+
+    task_graph_destroy(graph);
+    TEST_PASS("Critical path priorities work");
+}
+
+/* Test: Run honours dependencies, picks critical path first, skips after failure */
+static int test_run(void) {
+    write_script("ok.sh", 0);
+    write_script("fail.sh", 1);
+
+    char json[ARGO_BUFFER_LARGE];
+    snprintf(json, sizeof(json),
+        "{\"tasks\":["
+        "{\"id\":\"short\",\"script\":\"%1$s/ok.sh\"},"
+        "{\"id\":\"long1\",\"script\":\"%1$s/ok.sh\",\"estimate\":5},"
+        "{\"id\":\"long2\",\"depends_on\":[\"long1\"],\"script\":\"%1$s/ok.sh\"},"
+        "{\"id\":\"bad\",\"script\":\"%1$s/fail.sh\"},"
+        "{\"id\":\"after_bad\",\"depends_on\":[\"bad\"],\"script\":\"%1$s/ok.sh\"}"
+        "]}", g_test_dir);
+
+    task_graph_t* graph = NULL;
+    TEST_ASSERT(load_graph(json, &graph) == ARGO_SUCCESS, "Should validate");
+
+    char status_path[ARGO_PATH_MAX];
+    snprintf(status_path, sizeof(status_path), "%s/status.json", g_test_dir);
+    task_graph_run_config_t config = {
+        .max_parallel = 1,
+        .log_dir = g_test_dir,
+        .status_path = status_path
+    };
+
+    TEST_ASSERT(task_graph_run(graph, &config) == E_WORKFLOW_FAILED, "Run with a failure should fail");
+    TEST_ASSERT(graph->nodes[task_graph_find(graph, "long2")].state == TASK_NODE_COMPLETED,
+                "Dependent of completed task should complete");
+    TEST_ASSERT(graph->nodes[task_graph_find(graph, "bad")].state == TASK_NODE_FAILED,
+                "Failing task should fail");
+    TEST_ASSERT(graph->nodes[task_graph_find(graph, "after_bad")].state == TASK_NODE_SKIPPED,
+                "Dependent of failed task should be skipped");
+
+    char order_path[ARGO_PATH_MAX];
+    snprintf(order_path, sizeof(order_path), "%s/order.txt", g_test_dir);
+    char* order = NULL;
+    TEST_ASSERT(file_read_all(order_path, &order, NULL) == ARGO_SUCCESS, "Tasks should record order");
+    TEST_ASSERT(strncmp(order, "long1\n", strlen("long1\n")) == 0, "Critical path should start first");
+    TEST_ASSERT(strstr(order, "after_bad") == NULL, "Skipped task should not run");
+    free(order);
+
+    char* status = NULL;
+    TEST_ASSERT(file_read_all(status_path, &status, NULL) == ARGO_SUCCESS, "Status file written");
+    TEST_ASSERT(strstr(status, "\"completed\":3") != NULL, "Status should count completed");
+    TEST_ASSERT(strstr(status, "\"state\":\"skipped\"") != NULL, "Status should show skipped");
+    free(status);
+
+    task_graph_destroy(graph);
+    TEST_PASS("Run works");
+}
+
+/* Test: Independent tasks run concurrently */
+static int test_parallel(void) {
+    char path[ARGO_PATH_MAX];
+    snprintf(path, sizeof(path), "%s/slow.sh", g_test_dir);
+    FILE* fp = fopen(path, "w");
+    TEST_ASSERT(fp != NULL, "Should write script");
+    fprintf(fp, "sleep 1\n");
+    fclose(fp);
+
+    char json[ARGO_BUFFER_LARGE];
+    snprintf(json, sizeof(json),
+        "{\"tasks\":[{\"id\":\"p1\"},{\"id\":\"p2\"},{\"id\":\"p3\"},{\"id\":\"p4\"}]}");
+
+    task_graph_t* graph = NULL;
+    TEST_ASSERT(load_graph(json, &graph) == ARGO_SUCCESS, "Should validate");
+
+    task_graph_run_config_t config = {
+        .max_parallel = 4,
+        .runner = path
+    };
+
+    time_t start = time(NULL);
+    TEST_ASSERT(task_graph_run(graph, &config) == ARGO_SUCCESS, "Run should succeed");
+    TEST_ASSERT(time(NULL) - start < 3, "Four 1s tasks should overlap");
+
+    task_graph_destroy(graph);
+    TEST_PASS("Parallel run works");
+}
+
+/* Test: A cancel signal sent while tasks run stops the run */
+static int test_cancel(void) {
+    char path[ARGO_PATH_MAX];
+    snprintf(path, sizeof(path), "%s/cancel.sh", g_test_dir);
+    FILE* fp = fopen(path, "w");
+    TEST_ASSERT(fp != NULL, "Should write script");
+    fprintf(fp, "kill -TERM $PPID\nexec sleep 30\n");
+    fclose(fp);
+
+    task_graph_t* graph = NULL;
+    TEST_ASSERT(load_graph("{\"tasks\":[{\"id\":\"c1\"},{\"id\":\"c2\",\"depends_on\":[\"c1\"]}]}",
+                           &graph) == ARGO_SUCCESS, "Should validate");
+
+    struct sigaction sa = {0};
+    struct sigaction old_sa;
+    sa.sa_handler = cancel_handler;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGTERM, &sa, &old_sa);
+
+    task_graph_run_config_t config = {
+        .runner = path,
+        .cancel = &g_cancel
+    };
+
+    time_t start = time(NULL);
+    int result = task_graph_run(graph, &config);
+    sigaction(SIGTERM, &old_sa, NULL);
+
+    TEST_ASSERT(result == E_WORKFLOW_FAILED, "Cancelled run should fail");
+    TEST_ASSERT(time(NULL) - start < 10, "Cancel should wake the wait");
+    TEST_ASSERT(g_cancel == 1, "Handler should have run");
+    TEST_ASSERT(graph->nodes[task_graph_find(graph, "c1")].state == TASK_NODE_FAILED,
+                "Running task should be stopped");
+    TEST_ASSERT(graph->nodes[task_graph_find(graph, "c2")].state == TASK_NODE_SKIPPED,
+                "Unstarted task should be skipped");
+
+    task_graph_destroy(graph);
+    TEST_PASS("Cancel stops the run");
+}
+
+/* Main test runner */
+int main(void) {
+    int failed = 0;
+
+    printf("Running task graph tests...\n\n");
+
+    snprintf(g_test_dir, sizeof(g_test_dir), TEST_DIR_FORMAT, (int)getpid());
+    mkdir(g_test_dir, ARGO_DIR_PERMISSIONS);
+
+    failed += test_parse();
+    failed += test_validation_errors();
+    failed += test_cycle_detection();
+    failed += test_critical_path();
+    failed += test_run();
+    failed += test_parallel();
+    failed += test_cancel();
+
+    char cmd[ARGO_PATH_MAX];
+    snprintf(cmd, sizeof(cmd), "rm -rf %s", g_test_dir);
+    if (system(cmd) != 0) {
+        fprintf(stderr, "Warning: could not remove %s\n", g_test_dir);
+    }
+
+    printf("\n");
+    if (failed == 0) {
+        printf("All task graph tests passed!\n");
+        return 0;
+    } else {
+        printf("%d task graph tests failed\n", failed);
+        return 1;
+    }
+}
@@ -0,0 +1,192 @@
+/* © 2025 Casey Koons All rights reserved */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/* Project includes */
+#include "argo_template_catalog.h"
+#include "argo_error.h"
+#include "argo_limits.h"
+
+/* Test utilities */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "FAIL: %s\n", message); \
+            return 1; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        return 0; \
+    } while(0)
+
+#define TEST_DIR_FORMAT "/tmp/argo_test_template_catalog_%d"
+
+static char g_test_dir[ARGO_PATH_MAX];
+static char g_user_root[ARGO_PATH_MAX];
+static char g_system_root[ARGO_PATH_MAX];
+
+/* Helper: Write file under root/name */
+static void write_file(const char* root, const char* name, const char* file, const char* content) {
+    char path[ARGO_PATH_MAX];
+    snprintf(path, sizeof(path), "%s/%s", root, name);
+    mkdir(path, ARGO_DIR_PERMISSIONS);
+    snprintf(path, sizeof(path), "%s/%s/%s", root, name, file);
+
+    FILE* fp = fopen(path, "w");
+    if (!fp) return;
+    fprintf(fp, "%s", content);
+    fclose(fp);
+}
+
+/* Helper: Create a template directory with workflow.sh */
+static void make_template(const char* root, const char* name) {
+    write_file(root, name, TEMPLATE_CATALOG_SCRIPT_NAME, "#!/bin/bash\necho hi\n");
+}
+
+/* Test: Load roots, find by name, user shadows system */
+static int test_load_and_find(void) {
+    make_template(g_system_root, "build");
+    make_template(g_system_root, "deploy");
+    write_file(g_system_root, "deploy", "metadata.yaml", "description: Ship it\nversion: 2.0\n");
+    make_template(g_user_root, "build");
+    write_file(g_user_root, "notes", "README.md", "# Not a template\n");
+
+    template_catalog_t* catalog = template_catalog_create();
+    TEST_ASSERT(catalog != NULL, "Should create catalog");
+    TEST_ASSERT(template_catalog_add_root(catalog, g_user_root, TEMPLATE_CATALOG_SOURCE_USER) == ARGO_SUCCESS,
+                "Should add user root");
+    TEST_ASSERT(template_catalog_add_root(catalog, g_system_root, TEMPLATE_CATALOG_SOURCE_SYSTEM) == ARGO_SUCCESS,
+                "Should add system root");
+
+    template_catalog_item_t item;
+    TEST_ASSERT(template_catalog_find(catalog, "build", &item) == ARGO_SUCCESS, "Should find build");
+    TEST_ASSERT(strcmp(item.source, TEMPLATE_CATALOG_SOURCE_USER) == 0, "User template should win");
+    TEST_ASSERT(strstr(item.info.workflow_script, g_user_root) != NULL, "Path should be under user root");
+
+    TEST_ASSERT(template_catalog_find(catalog, "deploy", &item) == ARGO_SUCCESS, "Should find deploy");
+    TEST_ASSERT(strcmp(item.summary, "Ship it") == 0, "Summary should come from metadata");
+    TEST_ASSERT(strcmp(item.info.version, "2.0") == 0, "Should read version");
+
+    TEST_ASSERT(template_catalog_find(catalog, "notes", &item) == E_WORKFLOW_NOT_FOUND,
+                "Directory without workflow.sh is not a template");
+    TEST_ASSERT(template_catalog_find(catalog, "missing", &item) == E_WORKFLOW_NOT_FOUND,
+                "Unknown name should not be found");
+
+    template_catalog_item_t* items = NULL;
+    int count = 0;
+    TEST_ASSERT(template_catalog_list(catalog, &items, &count) == ARGO_SUCCESS, "Should list");
+    TEST_ASSERT(count == 3, "Should list both build templates and deploy");
+    TEST_ASSERT(strcmp(items[0].source, TEMPLATE_CATALOG_SOURCE_USER) == 0, "User root listed first");
+    TEST_ASSERT(strcmp(items[1].name, "build") == 0 && strcmp(items[2].name, "deploy") == 0,
+                "System templates sorted by name");
+    free(items);
+
+    template_catalog_destroy(catalog);
+    TEST_PASS("Load and find works");
+}
+
+/* Test: Changes on disk show up without a restart */
+static int test_changes(void) {
+    template_catalog_t* catalog = template_catalog_create();
+    TEST_ASSERT(catalog != NULL, "Should create catalog");
+    template_catalog_add_root(catalog, g_user_root, TEMPLATE_CATALOG_SOURCE_USER);
+
+    template_catalog_item_t item;
+    TEST_ASSERT(template_catalog_find(catalog, "fresh", &item) == E_WORKFLOW_NOT_FOUND,
+                "New template not there yet");
+
+    char path[ARGO_PATH_MAX];
+#ifdef __linux__
+    /* Directory first, script later - needs per-directory watches */
+    snprintf(path, sizeof(path), "%s/fresh", g_user_root);
+    mkdir(path, ARGO_DIR_PERMISSIONS);
+    TEST_ASSERT(template_catalog_find(catalog, "fresh", &item) == E_WORKFLOW_NOT_FOUND,
+                "Empty directory is not a template");
+#endif
+    make_template(g_user_root, "fresh");
+    TEST_ASSERT(template_catalog_find(catalog, "fresh", &item) == ARGO_SUCCESS,
+                "Added template should be found");
+
+    write_file(g_user_root, "fresh", "README.md", "# Fresh\n\nA freshly written template.\n");
+    TEST_ASSERT(template_catalog_find(catalog, "fresh", &item) == ARGO_SUCCESS, "Still found");
+#ifdef __linux__
+    TEST_ASSERT(strcmp(item.summary, "A freshly written template.") == 0, "Edited README picked up");
+#endif
+
+    snprintf(path, sizeof(path), "%s/fresh/%s", g_user_root, TEMPLATE_CATALOG_SCRIPT_NAME);
+    unlink(path);
+    snprintf(path, sizeof(path), "%s/fresh/README.md", g_user_root);
+    unlink(path);
+    snprintf(path, sizeof(path), "%s/fresh", g_user_root);
+    rmdir(path);
+    TEST_ASSERT(template_catalog_find(catalog, "fresh", &item) == E_WORKFLOW_NOT_FOUND,
+                "Removed template should be gone");
+    TEST_ASSERT(template_catalog_find(catalog, "build", &item) == ARGO_SUCCESS,
+                "Other templates unaffected");
+
+    template_catalog_destroy(catalog);
+    TEST_PASS("Change notification works");
+}
+
+/* Test: Root created after the catalog */
+static int test_late_root(void) {
+    char late_root[ARGO_PATH_MAX];
+    snprintf(late_root, sizeof(late_root), "%s/late", g_test_dir);
+
+    template_catalog_t* catalog = template_catalog_create();
+    TEST_ASSERT(catalog != NULL, "Should create catalog");
+    TEST_ASSERT(template_catalog_add_root(catalog, late_root, TEMPLATE_CATALOG_SOURCE_USER) == ARGO_SUCCESS,
+                "Missing root is accepted");
+
+    template_catalog_item_t item;
+    TEST_ASSERT(template_catalog_find(catalog, "later", &item) == E_WORKFLOW_NOT_FOUND, "Nothing yet");
+
+    mkdir(late_root, ARGO_DIR_PERMISSIONS);
+    make_template(late_root, "later");
+    TEST_ASSERT(template_catalog_find(catalog, "later", &item) == ARGO_SUCCESS,
+                "Template in new root should be found");
+
+    template_catalog_destroy(catalog);
+    TEST_PASS("Late root works");
+}
+
+/* Main test runner */
+int main(void) {
+    int failed = 0;
+
+    printf("Running template catalog tests...\n\n");
+
+    snprintf(g_test_dir, sizeof(g_test_dir), TEST_DIR_FORMAT, (int)getpid());
+    snprintf(g_user_root, sizeof(g_user_root), "%s/user", g_test_dir);
+    snprintf(g_system_root, sizeof(g_system_root), "%s/system", g_test_dir);
+    mkdir(g_test_dir, ARGO_DIR_PERMISSIONS);
+    mkdir(g_user_root, ARGO_DIR_PERMISSIONS);
+    mkdir(g_system_root, ARGO_DIR_PERMISSIONS);
+
+    failed += test_load_and_find();
+    failed += test_changes();
+    failed += test_late_root();
+
+    char cmd[ARGO_PATH_MAX];
+    snprintf(cmd, sizeof(cmd), "rm -rf %s", g_test_dir);
+    if (system(cmd) != 0) {
+        fprintf(stderr, "Warning: could not remove %s\n", g_test_dir);
+    }
+
+    printf("\n");
+    if (failed == 0) {
+        printf("All template catalog tests passed!\n");
+        return 0;
+    } else {
+        printf("%d template catalog tests failed\n", failed);
+        return 1;
+    }
+}
@@ -0,0 +1,183 @@
+/* © 2025 Casey Koons All rights reserved */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/* Project includes */
+#include "argo_workflow.h"
+#include "argo_time.h"
+#include "argo_error.h"
+
+/* Test utilities */
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "FAIL: %s\n", message); \
+            return 1; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        return 0; \
+    } while(0)
+
+#define TEST_DIR_FORMAT "/tmp/argo_test_workflow_batch_%d"
+#define TEST_BATCH_SIZE 4
+
+static char g_test_dir[ARGO_PATH_MAX];
+
+/* Helper: Write a script into the test directory */
+static void write_script(const char* name, const char* body, char* path, size_t size) {
+    snprintf(path, size, "%s/%s", g_test_dir, name);
+    FILE* fp = fopen(path, "w");
+    if (!fp) return;
+    fprintf(fp, "%s\n", body);
+    fclose(fp);
+}
+
+/* Helper: Create a workflow running script with timeout */
+static workflow_t* make_workflow(const char* id, const char* script, int timeout_seconds) {
+    workflow_t* wf = workflow_create(id, id);
+    if (wf) {
+        strncpy(wf->script_path, script, sizeof(wf->script_path) - 1);
+        wf->timeout_seconds = timeout_seconds;
+    }
+    return wf;
+}
+
+/* Test: Independent workflows overlap up to max_parallel */
+static int test_parallel(void) {
+    char script[ARGO_PATH_MAX];
+    write_script("sleep.sh", "sleep 1", script, sizeof(script));
+
+    workflow_t* wfs[TEST_BATCH_SIZE];
+    char id[ARGO_BUFFER_TINY];
+    for (int i = 0; i < TEST_BATCH_SIZE; i++) {
+        snprintf(id, sizeof(id), "batch_%d", i);
+        wfs[i] = make_workflow(id, script, 0);
+        TEST_ASSERT(wfs[i] != NULL, "Should create workflow");
+    }
+
+    long long start = argo_monotonic_ms();
+    int result = workflow_execute_many(wfs, TEST_BATCH_SIZE, TEST_BATCH_SIZE);
+    long long elapsed = argo_monotonic_ms() - start;
+
+    TEST_ASSERT(result == ARGO_SUCCESS, "Batch should succeed");
+    TEST_ASSERT(elapsed < 2000, "Four 1s workflows should run concurrently");
+    for (int i = 0; i < TEST_BATCH_SIZE; i++) {
+        TEST_ASSERT(wfs[i]->state == WORKFLOW_STATE_COMPLETED, "Each workflow should complete");
+        workflow_destroy(wfs[i]);
+    }
+    TEST_PASS("Parallel batch works");
+}
+
+/* Test: max_parallel limits concurrency */
+static int test_parallel_limit(void) {
+    char script[ARGO_PATH_MAX];
+    write_script("short.sh", "sleep 0.3", script, sizeof(script));
+
+    workflow_t* wfs[TEST_BATCH_SIZE];
+    for (int i = 0; i < TEST_BATCH_SIZE; i++) {
+        wfs[i] = make_workflow("limited", script, 0);
+        TEST_ASSERT(wfs[i] != NULL, "Should create workflow");
+    }
+
+    long long start = argo_monotonic_ms();
+    TEST_ASSERT(workflow_execute_many(wfs, TEST_BATCH_SIZE, 2) == ARGO_SUCCESS, "Batch should succeed");
+    long long elapsed = argo_monotonic_ms() - start;
+
+    TEST_ASSERT(elapsed >= 600, "Two at a time should take two rounds");
+    for (int i = 0; i < TEST_BATCH_SIZE; i++) {
+        workflow_destroy(wfs[i]);
+    }
+    TEST_PASS("Parallel limit respected");
+}
+
+/* Test: Deadlines and kill escalation */
+static int test_timeouts(void) {
+    char slow[ARGO_PATH_MAX];
+    char stubborn[ARGO_PATH_MAX];
+    char failing[ARGO_PATH_MAX];
+    write_script("slow.sh", "sleep 30", slow, sizeof(slow));
+    write_script("stubborn.sh", "trap '' TERM\nfor i in $(seq 60); do sleep 0.5; done", stubborn, sizeof(stubborn));
+    write_script("failing.sh", "exit 3", failing, sizeof(failing));
+
+    workflow_t* wfs[3] = {
+        make_workflow("slow", slow, 1),
+        make_workflow("stubborn", stubborn, 1),
+        make_workflow("failing", failing, 0)
+    };
+    TEST_ASSERT(wfs[0] && wfs[1] && wfs[2], "Should create workflows");
+
+    long long start = argo_monotonic_ms();
+    int result = workflow_execute_many(wfs, 3, 3);
+    long long elapsed = argo_monotonic_ms() - start;
+
+    TEST_ASSERT(result != ARGO_SUCCESS, "Batch with failures should fail");
+    TEST_ASSERT(elapsed < 5000, "Timed-out workflows should be stopped promptly");
+    TEST_ASSERT(wfs[0]->exit_code == WORKFLOW_TIMEOUT_EXIT_CODE, "Slow workflow should time out");
+    TEST_ASSERT(wfs[1]->exit_code == WORKFLOW_TIMEOUT_EXIT_CODE, "Stubborn workflow should be killed");
+    TEST_ASSERT(wfs[2]->exit_code == 3, "Failing workflow keeps its exit code");
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT(wfs[i]->state == WORKFLOW_STATE_FAILED, "Each workflow should fail");
+        workflow_destroy(wfs[i]);
+    }
+    TEST_PASS("Timeouts and kill escalation work");
+}
+
+/* Test: Single-process wait uses the same waiter */
+static int test_process_wait(void) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        _exit(7);
+    }
+    process_wait_result_t result = process_wait_with_timeout(pid, 5, WORKFLOW_TIMEOUT_EXIT_CODE);
+    TEST_ASSERT(!result.timed_out && !result.wait_failed, "Wait should succeed");
+    TEST_ASSERT(result.exit_code == 7, "Should return exit code");
+
+    pid = fork();
+    if (pid == 0) {
+        pause();
+        _exit(0);
+    }
+    result = process_wait_with_timeout(pid, 1, WORKFLOW_TIMEOUT_EXIT_CODE);
+    TEST_ASSERT(result.timed_out, "Should time out");
+    TEST_ASSERT(result.exit_code == WORKFLOW_TIMEOUT_EXIT_CODE, "Should return timeout code");
+    TEST_PASS("Process wait with timeout works");
+}
+
+/* Main test runner */
+int main(void) {
+    int failed = 0;
+
+    printf("Running workflow batch tests...\n\n");
+
+    snprintf(g_test_dir, sizeof(g_test_dir), TEST_DIR_FORMAT, (int)getpid());
+    mkdir(g_test_dir, ARGO_DIR_PERMISSIONS);
+
+    failed += test_parallel();
+    failed += test_parallel_limit();
+    failed += test_timeouts();
+    failed += test_process_wait();
+
+    char cmd[ARGO_PATH_MAX];
+    snprintf(cmd, sizeof(cmd), "rm -rf %s", g_test_dir);
+    if (system(cmd) != 0) {
+        fprintf(stderr, "Warning: could not remove %s\n", g_test_dir);
+    }
+
+    printf("\n");
+    if (failed == 0) {
+        printf("All workflow batch tests passed!\n");
+        return 0;
+    } else {
+        printf("%d workflow batch tests failed\n", failed);
+        return 1;
+    }
+}
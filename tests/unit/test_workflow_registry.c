@@ -9,6 +9,7 @@
 
 /* Project includes */
 #include "argo_workflow_registry.h"
+#include "argo_daemon_workflow_recovery.h"
 #include "argo_error.h"
 
 /* Test utilities */
@@ -342,6 +343,75 @@ static int test_registry_duplicate(void) {
     TEST_PASS("Duplicate workflow ID handling works");
 }
 
+/* Test: Save and load round trip (restart recovery) */
+static int test_registry_load_roundtrip(void) {
+    workflow_registry_t* reg = workflow_registry_create();
+    TEST_ASSERT(reg != NULL, "Should create registry");
+
+    workflow_entry_t entry = {0};
+    strncpy(entry.workflow_id, "resume-123", sizeof(entry.workflow_id) - 1);
+    strncpy(entry.workflow_name, "/tmp/long_build.sh", sizeof(entry.workflow_name) - 1);
+    strncpy(entry.stdin_fifo, "/tmp/resume-123.stdin", sizeof(entry.stdin_fifo) - 1);
+    entry.state = WORKFLOW_STATE_RUNNING;
+    entry.executor_pid = 4242;
+    entry.start_time = 1701234567;
+    entry.timeout_seconds = 7200;
+    entry.retry_count = 1;
+    entry.max_retries = 3;
+    entry.proc_start_ticks = 123456789ULL;
+    entry.stdin_pipe = 9;
+    workflow_registry_add(reg, &entry);
+
+    const char* path = "/tmp/test_workflow_registry_roundtrip.json";
+    TEST_ASSERT(workflow_registry_save(reg, path) == ARGO_SUCCESS, "Should save registry");
+    workflow_registry_destroy(reg);
+
+    reg = workflow_registry_create();
+    TEST_ASSERT(reg != NULL, "Should create second registry");
+    TEST_ASSERT(workflow_registry_load(reg, path) == ARGO_SUCCESS, "Should load registry");
+    TEST_ASSERT(workflow_registry_count(reg, (workflow_state_t)-1) == 1, "Should load 1 workflow");
+
+    const workflow_entry_t* loaded = workflow_registry_find(reg, "resume-123");
+    TEST_ASSERT(loaded != NULL, "Should find loaded workflow");
+    TEST_ASSERT(strcmp(loaded->workflow_name, "/tmp/long_build.sh") == 0, "Name should match");
+    TEST_ASSERT(strcmp(loaded->stdin_fifo, "/tmp/resume-123.stdin") == 0, "FIFO should match");
+    TEST_ASSERT(loaded->state == WORKFLOW_STATE_RUNNING, "State should match");
+    TEST_ASSERT(loaded->executor_pid == 4242, "PID should match");
+    TEST_ASSERT(loaded->start_time == 1701234567, "Start time should match");
+    TEST_ASSERT(loaded->timeout_seconds == 7200, "Timeout should match");
+    TEST_ASSERT(loaded->retry_count == 1 && loaded->max_retries == 3, "Retries should match");
+    TEST_ASSERT(loaded->proc_start_ticks == 123456789ULL, "Start ticks should match");
+    TEST_ASSERT(loaded->stdin_pipe == 0, "FD should not be restored");
+
+    /* Loading again must not duplicate entries */
+    TEST_ASSERT(workflow_registry_load(reg, path) == ARGO_SUCCESS, "Should reload registry");
+    TEST_ASSERT(workflow_registry_count(reg, (workflow_state_t)-1) == 1, "Should not duplicate");
+
+    unlink(path);
+    workflow_registry_destroy(reg);
+    TEST_PASS("Save/load round trip works");
+}
+
+/* Test: Executor identity check guards against PID reuse */
+static int test_executor_identity(void) {
+    workflow_entry_t entry = {0};
+    entry.executor_pid = getpid();
+    entry.proc_start_ticks = workflow_recovery_start_ticks(getpid());
+
+    TEST_ASSERT(workflow_recovery_process_alive(&entry), "Own process should be alive");
+
+    if (entry.proc_start_ticks != 0) {
+        entry.proc_start_ticks++;
+        TEST_ASSERT(!workflow_recovery_process_alive(&entry),
+                    "Mismatched start time should be treated as a different process");
+    }
+
+    entry.executor_pid = 0;
+    TEST_ASSERT(!workflow_recovery_process_alive(&entry), "PID 0 should not be alive");
+
+    TEST_PASS("Executor identity check works");
+}
+
 /* Main test runner */
 int main(void) {
     int failed = 0;
@@ -359,6 +429,8 @@ int main(void) {
     failed += test_registry_save();
     failed += test_registry_prune();
     failed += test_registry_duplicate();
+    failed += test_registry_load_roundtrip();
+    failed += test_executor_identity();
 
     printf("\n");
     if (failed == 0) {
@@ -136,10 +136,13 @@ develop_project() {
                     4)
                         success "Project development complete!"
                         echo ""
+                        local requirements_file architecture_file tasks_file
+                        IFS=$'\x1f' read -r -d '' requirements_file architecture_file tasks_file < <(
+                            get_context_values "$session_id" requirements.file architecture.file architecture.tasks_file)
                         echo "Generated artifacts:"
-                        echo "  - Requirements: $(get_context_value "$session_id" "requirements.file")"
-                        echo "  - Architecture: $(get_context_value "$session_id" "architecture.file")"
-                        echo "  - Tasks: $(get_context_value "$session_id" "architecture.tasks_file")"
+                        echo "  - Requirements: $requirements_file"
+                        echo "  - Architecture: $architecture_file"
+                        echo "  - Tasks: $tasks_file"
                         echo ""
                         echo "Session: $session_id"
                         echo "Context: $context_file"
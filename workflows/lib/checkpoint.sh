@@ -190,13 +190,7 @@ delete_checkpoint() {
     fi
 
     # Remove from state.json checkpoints object
-    if [[ -f ".argo-project/state.json" ]]; then
-        local temp_file=".argo-project/state.json.tmp"
-        jq "del(.checkpoints.\"$name\")" ".argo-project/state.json" > "$temp_file" 2>/dev/null
-        if [[ $? -eq 0 ]]; then
-            mv "$temp_file" ".argo-project/state.json"
-        fi
-    fi
+    delete_state "checkpoints.$name" 2>/dev/null
 
     return 0
 }
@@ -262,13 +256,7 @@ cleanup_old_checkpoints() {
 
                 # Remove from state.json
                 local name=$(echo "$filename" | cut -d'_' -f2-)
-                if [[ -f ".argo-project/state.json" ]]; then
-                    local temp_file=".argo-project/state.json.tmp"
-                    jq "del(.checkpoints.\"$name\")" ".argo-project/state.json" > "$temp_file" 2>/dev/null
-                    if [[ $? -eq 0 ]]; then
-                        mv "$temp_file" ".argo-project/state.json"
-                    fi
-                fi
+                delete_state "checkpoints.$name" 2>/dev/null
             fi
         fi
     done
@@ -105,29 +105,35 @@ auto_resolve_conflicts() {
     info "Attempting auto-resolution for $(label $builder_id)..."
 
     local analysis=$(analyze_merge_conflicts "$builder_id" "$feature_branch" "$builder_branch")
-    local can_auto_resolve=$(echo "$analysis" | jq -r '.can_auto_resolve')
-    local conflict_type=$(echo "$analysis" | jq -r '.conflict_type')
-    local recommendation=$(echo "$analysis" | jq -r '.recommendation')
+    local can_auto_resolve conflict_type recommendation conflict_count
+    read -r can_auto_resolve conflict_type recommendation conflict_count < <(
+        echo "$analysis" |
+        jq -r '"\(.can_auto_resolve) \(.conflict_type) \(.recommendation) \(.conflict_count)"' 2>/dev/null)
 
     if [[ "$can_auto_resolve" != "true" ]]; then
         warning "Conflicts are too complex for auto-resolution"
         return 1
     fi
 
-    # Get conflict details
-    local conflict_count=$(echo "$analysis" | jq -r '.conflict_count')
-    local conflicts=$(echo "$analysis" | jq -r '.conflicts')
+    # Get conflict details: one $'\x1f'-separated record per conflict, one jq call
+    local -a conflict_records
+    mapfile -t conflict_records < <(echo "$analysis" |
+        jq -r '.conflicts // [] | .[]
+               | [.file, .auto_resolvable, .type, .resolution]
+               | map(tostring | gsub("\n"; " ")) | join("\u001f")' 2>/dev/null)
+    local record file auto_resolvable resolution
 
     box_header "Auto-Resolving $conflict_count Conflicts" "$ROBOT"
-    echo "$conflicts" | jq -r '.[] | "  [\(.file)] \(.type) - \(.resolution)"'
+    for record in "${conflict_records[@]}"; do
+        IFS=$'\x1f' read -r file auto_resolvable conflict_type resolution <<< "$record"
+        echo "  [$file] $conflict_type - $resolution"
+    done
     box_footer
 
     # For each auto-resolvable conflict, apply resolution
     local resolved=0
-    for i in $(seq 0 $((conflict_count - 1))); do
-        local file=$(echo "$conflicts" | jq -r ".[$i].file")
-        local auto_resolvable=$(echo "$conflicts" | jq -r ".[$i].auto_resolvable")
-        local conflict_type=$(echo "$conflicts" | jq -r ".[$i].type")
+    for record in "${conflict_records[@]}"; do
+        IFS=$'\x1f' read -r file auto_resolvable conflict_type resolution <<< "$record"
 
         if [[ "$auto_resolvable" == "true" ]] && [[ -f "$file" ]]; then
             case "$conflict_type" in
@@ -282,9 +288,9 @@ handle_merge_conflict() {
 
     # Step 1: Analyze conflicts
     local analysis=$(analyze_merge_conflicts "$builder_id" "$feature_branch" "$builder_branch")
-    local recommendation=$(echo "$analysis" | jq -r '.recommendation')
-    local conflict_type=$(echo "$analysis" | jq -r '.conflict_type')
-    local risk_level=$(echo "$analysis" | jq -r '.risk_level')
+    local recommendation conflict_type risk_level
+    read -r recommendation conflict_type risk_level < <(
+        echo "$analysis" | jq -r '"\(.recommendation) \(.conflict_type) \(.risk_level)"' 2>/dev/null)
 
     echo ""
     box_header "Conflict Analysis: $builder_id" "$WARNING"
@@ -158,6 +158,26 @@ get_context_value() {
     jq -r ".$field_path" "$context_file"
 }
 
+# Get several fields from context.json with one jq call
+# Args: session_id, field_path...
+# Returns: values separated by $'\x1f' (no trailing newline); strings raw,
+#          other values as JSON (null prints "null", like get_context_value)
+# Example: IFS=$'\x1f' read -r -d '' conv file < <(get_context_values "$id" requirements.converged requirements.file)
+get_context_values() {
+    local session_id="$1"
+    shift
+    local context_file=$(get_context_file "$session_id")
+
+    if [[ ! -f "$context_file" ]]; then
+        echo "Error: Context file not found: $context_file" >&2
+        return 1
+    fi
+
+    jq -j '[$ARGS.positional[] as $p | getpath($p | split("."))
+            | if type == "string" then . else tojson end] | join("\u001f")' \
+       "$context_file" --args "$@"
+}
+
 # Append to an array field in context.json
 # Args: session_id, array_path, value
 # Example: append_to_context_array "$session_id" "requirements.features" "calculator"
@@ -259,6 +279,7 @@ export -f get_context_file
 export -f update_context
 export -f set_context_field
 export -f get_context_value
+export -f get_context_values
 export -f append_to_context_array
 export -f add_conversation_message
 export -f add_decision
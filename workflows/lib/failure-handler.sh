@@ -26,16 +26,19 @@ analyze_builder_failure() {
         return 1
     fi
 
-    # Extract failure information
-    local status=$(jq -r '.status' "$builder_file")
-    local tests_failed=$(jq -r '.tests_failed_count' "$builder_file")
-    local failed_tests=$(jq -r '.failed_tests | join(", ")' "$builder_file")
-    local task_description=$(jq -r '.task_description' "$builder_file")
-
-    # Get task details
-    local task=$(jq -r ".[] | select(.task_id == \"$builder_id\")" "$design_dir/tasks.json")
-    local components=$(echo "$task" | jq -r '.components | join(", ")')
-    local expected_tests=$(echo "$task" | jq -r '.tests | join(", ")')
+    # Extract failure information (one jq call, $'\x1f'-separated)
+    local status tests_failed failed_tests task_description
+    IFS=$'\x1f' read -r -d '' status tests_failed failed_tests task_description < <(
+        jq -j '[.status, .tests_failed_count, (.failed_tests // [] | join(", ")), .task_description]
+               | map(tostring) | join("\u001f")' "$builder_file")
+
+    # Get task details (one jq call)
+    local components expected_tests
+    IFS=$'\x1f' read -r -d '' components expected_tests < <(
+        jq -j --arg id "$builder_id" \
+           'first(.[] | select(.task_id == $id))
+            | [(.components // [] | join(", ")), (.tests // [] | join(", "))] | join("\u001f")' \
+           "$design_dir/tasks.json" 2>/dev/null)
 
     # Create analysis context
     cat <<EOF
@@ -103,12 +106,15 @@ refactor_builder_tests() {
     info "Analyzing test failures for $(label $builder_id)..."
 
     local analysis=$(analyze_test_failures "$session_id" "$builder_id" "$design_dir")
-    local problem_type=$(echo "$analysis" | jq -r '.problem_type')
-    local recommended_action=$(echo "$analysis" | jq -r '.recommended_action')
+    local problem_type recommended_action explanation specific_fixes
+    IFS=$'\x1f' read -r -d '' problem_type recommended_action explanation specific_fixes < <(
+        echo "$analysis" |
+        jq -j '[.problem_type, .recommended_action, .explanation, (.specific_fixes // [] | join("\n"))]
+               | map(tostring) | join("\u001f")' 2>/dev/null)
 
     echo ""
     box_header "Failure Analysis: $builder_id" "$WARNING"
-    echo "$analysis" | jq -r '.explanation'
+    echo "$explanation"
     echo ""
     echo -e "${BOLD}Recommended action:${NC} $recommended_action"
     box_footer
@@ -117,9 +123,13 @@ refactor_builder_tests() {
         # AI suggests tests need refactoring
         info "Refactoring tests..."
 
-        local task=$(jq -r ".[] | select(.task_id == \"$builder_id\")" "$design_dir/tasks.json")
-        local original_tests=$(echo "$task" | jq -r '.tests')
-        local specific_fixes=$(echo "$analysis" | jq -r '.specific_fixes | join("\n")')
+        local original_tests task_description task_components
+        IFS=$'\x1f' read -r -d '' original_tests task_description task_components < <(
+            jq -j --arg id "$builder_id" \
+               'first(.[] | select(.task_id == $id))
+                | [(.tests | tojson), .description, (.components // [] | join(", "))]
+                | map(tostring) | join("\u001f")' \
+               "$design_dir/tasks.json" 2>/dev/null)
 
         # Ask AI to create better tests
         local new_tests=$(ci <<EOF
@@ -134,8 +144,8 @@ $specific_fixes
 Requirements:
 $(cat "$design_dir/requirements.md")
 
-Task: $(echo "$task" | jq -r '.description')
-Components: $(echo "$task" | jq -r '.components | join(", ")')
+Task: $task_description
+Components: $task_components
 
 Create better, more realistic tests that:
 1. Test the actual requirements (not overly strict edge cases)
@@ -149,8 +159,8 @@ EOF
 
         # Update task with new tests
         local temp_file=$(mktemp)
-        jq --argjson tests "$new_tests" \
-           "(.[] | select(.task_id == \"$builder_id\").tests) = \$tests" \
+        jq --argjson tests "$new_tests" --arg id "$builder_id" \
+           '(.[] | select(.task_id == $id).tests) = $tests' \
            "$design_dir/tasks.json" > "$temp_file"
         mv "$temp_file" "$design_dir/tasks.json"
 
@@ -180,8 +190,10 @@ respawn_builder() {
 
     local builder_file="$(get_session_dir "$session_id")/builders/$builder_id.json"
 
-    # Check respawn count
-    local respawn_count=$(jq -r '.respawn_count // 0' "$builder_file")
+    # Check respawn count (branch read in the same call)
+    local respawn_count builder_branch
+    read -r respawn_count builder_branch < <(
+        jq -r '"\(.respawn_count // 0) \(.feature_branch)"' "$builder_file")
 
     if [[ $respawn_count -ge $ARGO_MAX_RESPAWN_ATTEMPTS ]]; then
         warning "Max respawn attempts reached for $builder_id"
@@ -197,9 +209,6 @@ respawn_builder() {
 
     info "Respawning $(label $builder_id) (attempt $((respawn_count + 2)))"
 
-    # Get builder branch
-    local builder_branch=$(jq -r '.feature_branch' "$builder_file")
-
     # Reset builder branch to clean state
     if [[ -n "$builder_branch" ]] && [[ "$builder_branch" != "null" ]]; then
         # Delete and recreate branch
@@ -261,8 +270,9 @@ escalate_to_user() {
     box_header "User Escalation Required: $builder_id" "$ALERT"
 
     local builder_file="$(get_session_dir "$session_id")/builders/$builder_id.json"
-    local task_description=$(jq -r '.task_description' "$builder_file")
-    local tests_failed=$(jq -r '.tests_failed_count' "$builder_file")
+    local tests_failed task_description
+    IFS=$'\x1f' read -r -d '' tests_failed task_description < <(
+        jq -j '[.tests_failed_count, .task_description] | map(tostring) | join("\u001f")' "$builder_file")
 
     echo "Builder $(label $builder_id) cannot recover automatically."
     echo ""
@@ -194,6 +194,25 @@ get_context_field() {
     jq -r ".$field" "$context_file"
 }
 
+# Get several context field values with one jq call
+# Args: session_id, field_name...
+# Returns: values separated by $'\x1f' (no trailing newline); strings raw,
+#          other values as JSON (null prints "null", like get_context_field)
+# Example: IFS=$'\x1f' read -r -d '' TYPE DIR < <(get_context_fields "$id" project_type project_dir)
+get_context_fields() {
+    local session_id="$1"
+    shift
+    local context_file="$SESSIONS_DIR/$session_id/context.json"
+
+    if [[ ! -f "$context_file" ]]; then
+        echo "Error: Context file not found for session $session_id" >&2
+        return 1
+    fi
+
+    jq -j '[$ARGS.positional[] as $k | .[$k] | if type == "string" then . else tojson end] | join("\u001f")' \
+       "$context_file" --args "$@"
+}
+
 # Update current phase in context
 # Args: session_id, phase_name
 update_phase() {
@@ -248,20 +267,13 @@ update_builder_status() {
         return 1
     fi
 
+    # Status and (when completed or failed) completion time in one write
     local temp_file=$(mktemp)
-    jq --arg status "$status" \
-       '.status = $status' \
+    jq --arg status "$status" --arg time "$(date -u +"%Y-%m-%dT%H:%M:%SZ")" \
+       '.status = $status
+        | if $status == "completed" or $status == "failed" then .completion_time = $time else . end' \
        "$builder_file" > "$temp_file"
     mv "$temp_file" "$builder_file"
-
-    # If completed or failed, set completion time
-    if [[ "$status" == "completed" ]] || [[ "$status" == "failed" ]]; then
-        local temp_file2=$(mktemp)
-        jq --arg time "$(date -u +"%Y-%m-%dT%H:%M:%SZ")" \
-           '.completion_time = $time' \
-           "$builder_file" > "$temp_file2"
-        mv "$temp_file2" "$builder_file"
-    fi
 }
 
 # Save complete builder state
@@ -361,10 +373,14 @@ get_builder_statistics() {
     local needs_assistance=0
 
     shopt -s nullglob
-    for file in "$builders_dir"/*.json; do
-        if [[ -f "$file" ]]; then
+    local files=("$builders_dir"/*.json)
+    shopt -u nullglob
+
+    # One jq call over all builder files: "<status> <needs_assistance>" per file
+    local status help
+    if [[ ${#files[@]} -gt 0 ]]; then
+        while read -r status help; do
             total=$((total + 1))
-            status=$(jq -r '.status' "$file")
 
             case "$status" in
                 initialized) initialized=$((initialized + 1)) ;;
@@ -375,12 +391,11 @@ get_builder_statistics() {
                 failed) failed=$((failed + 1)) ;;
             esac
 
-            if [[ "$(jq -r '.needs_assistance' "$file")" == "true" ]]; then
+            if [[ "$help" == "true" ]]; then
                 needs_assistance=$((needs_assistance + 1))
             fi
-        fi
-    done
-    shopt -u nullglob
+        done < <(jq -r '"\(.status) \(.needs_assistance)"' "${files[@]}")
+    fi
 
     cat <<EOF
 {
@@ -495,6 +510,7 @@ export -f save_context_field
 export -f save_context
 export -f load_context
 export -f get_context_field
+export -f get_context_fields
 export -f update_phase
 export -f init_builder_state
 export -f update_builder_status
@@ -10,6 +10,44 @@
 STATE_FILE="${STATE_FILE:-.argo-project/state.json}"
 STATE_LOCK="${STATE_LOCK:-.argo-project/state.lock}"
 
+# Daemon-backed state service (argo-state). Used when ARGO_PROJECT_ID names a
+# registered project; reads and writes then go through the daemon's cached,
+# versioned copy instead of forking jq. Falls back to jq when the daemon is
+# unavailable (exit 3) or has no state for the project (exit 4).
+ARGO_STATE_BIN="${ARGO_STATE_BIN:-argo-state}"
+
+#
+# use_state_service - Check whether argo-state should be tried
+#
+# Returns:
+#   0 if ARGO_PROJECT_ID is set and argo-state is on PATH, 1 otherwise
+#
+use_state_service() {
+    [[ -n "$ARGO_PROJECT_ID" ]] && command -v "$ARGO_STATE_BIN" >/dev/null 2>&1
+}
+
+#
+# key_to_pointer - Convert dotted key to JSON pointer
+#
+# Arguments:
+#   key - Dotted path (e.g., "execution.status")
+#
+# Returns:
+#   Pointer to stdout (e.g., "/execution/status")
+#
+key_to_pointer() {
+    local key="$1"
+    local pointer="" segment
+    local -a segments
+    IFS='.' read -ra segments <<< "$key"
+    for segment in "${segments[@]}"; do
+        segment="${segment//'~'/'~0'}"
+        segment="${segment//'/'/'~1'}"
+        pointer+="/$segment"
+    done
+    echo "$pointer"
+}
+
 #
 # init_state_file - Create initial state.json with default structure
 #
@@ -102,6 +140,18 @@ update_state() {
     # Update timestamp
     local timestamp=$(date -u +"%Y-%m-%dT%H:%M:%SZ")
 
+    # Daemon path: value and timestamp applied as one patch
+    if use_state_service; then
+        "$ARGO_STATE_BIN" set "$ARGO_PROJECT_ID" "$(key_to_pointer "$key")" "$value" \
+            /last_update "$timestamp" 2>/dev/null
+        local rc=$?
+        case $rc in
+            0) return 0 ;;
+            3|4) ;;  # Fall back to jq
+            *) echo "ERROR: Failed to update state (argo-state exit $rc)" >&2; return 1 ;;
+        esac
+    fi
+
     # Atomic update: write to temp file, then rename
     jq --arg k "$key" \
        --arg v "$value" \
@@ -145,6 +195,17 @@ read_state() {
         return 1
     fi
 
+    # Daemon path: prints null as empty, like the jq path below
+    if use_state_service; then
+        local service_value
+        service_value=$("$ARGO_STATE_BIN" get "$ARGO_PROJECT_ID" "$(key_to_pointer "$key")" 2>/dev/null)
+        case $? in
+            0) echo "$service_value"; return 0 ;;
+            3|4) ;;  # Fall back to jq
+            *) return 1 ;;
+        esac
+    fi
+
     # Read value
     local value=$(jq -r ".${key}" "$STATE_FILE" 2>/dev/null)
 
@@ -162,6 +223,53 @@ read_state() {
     return 0
 }
 
+#
+# delete_state - Remove a field from state.json atomically
+#
+# Arguments:
+#   key - JSON path to field (dotted; segments may not contain dots)
+#
+# Returns:
+#   0 on success, 1 on failure
+#
+delete_state() {
+    local key="$1"
+
+    # Validate arguments
+    if [[ -z "$key" ]]; then
+        echo "ERROR: key required" >&2
+        return 1
+    fi
+
+    if use_state_service; then
+        local pointer=$(key_to_pointer "$key")
+        pointer="${pointer//\\/\\\\}"
+        pointer="${pointer//\"/\\\"}"
+        "$ARGO_STATE_BIN" patch "$ARGO_PROJECT_ID" \
+            "[{\"op\":\"remove\",\"path\":\"$pointer\"}]" >/dev/null 2>&1
+        case $? in
+            0) return 0 ;;
+            3|4) ;;  # Fall back to jq
+            *) return 1 ;;
+        esac
+    fi
+
+    # Check state file exists
+    if [[ ! -f "$STATE_FILE" ]]; then
+        echo "ERROR: state file not found: $STATE_FILE" >&2
+        return 1
+    fi
+
+    jq --arg k "$key" 'delpaths([$k | split(".")])' "$STATE_FILE" > "${STATE_FILE}.tmp" 2>/dev/null
+    if [[ $? -ne 0 ]]; then
+        rm -f "${STATE_FILE}.tmp"
+        return 1
+    fi
+    mv "${STATE_FILE}.tmp" "$STATE_FILE"
+
+    return 0
+}
+
 #
 # validate_state_file - Validate state.json is well-formed
 #
@@ -230,7 +338,8 @@ with_state_lock() {
     fi
 
     # Export all functions so they're available in subshell
-    export -f read_state update_state init_state_file validate_state_file 2>/dev/null
+    export -f read_state update_state delete_state init_state_file validate_state_file \
+        use_state_service key_to_pointer 2>/dev/null
 
     # Export state file variables
     export STATE_FILE
@@ -258,5 +367,8 @@ with_state_lock() {
 export -f init_state_file
 export -f update_state
 export -f read_state
+export -f delete_state
+export -f use_state_service
+export -f key_to_pointer
 export -f validate_state_file
 export -f with_state_lock
@@ -18,6 +18,7 @@ readonly SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 # Source library modules (state management and logging)
 source "$SCRIPT_DIR/lib/state_file.sh"
 source "$SCRIPT_DIR/lib/logging_enhanced.sh"
+source "$SCRIPT_DIR/lib/project_registry.sh"
 
 # Configuration (readonly to prevent accidental modification)
 readonly WORKFLOWS_DIR="$SCRIPT_DIR"
@@ -59,6 +60,13 @@ main() {
         return 1
     }
 
+    # Registered projects read/write state through the daemon (argo-state);
+    # handlers inherit the ID. Unregistered projects stay on jq.
+    if [[ -z "$ARGO_PROJECT_ID" ]]; then
+        ARGO_PROJECT_ID=$(find_project_by_path "$(pwd)" 2>/dev/null)
+        export ARGO_PROJECT_ID
+    fi
+
     # PID file management (prevents multiple orchestrators for same project)
     local orchestrator_pid_file=".argo-project/orchestrator.pid"
 
@@ -29,8 +29,10 @@ architecture_conversation() {
         return 1
     fi
 
-    # Check if requirements are converged
-    local requirements_converged=$(get_context_value "$session_id" "requirements.converged")
+    # Check if requirements are converged (both fields read in one call)
+    local requirements_converged requirements_file
+    IFS=$'\x1f' read -r -d '' requirements_converged requirements_file < <(
+        get_context_values "$session_id" requirements.converged requirements.file)
     if [[ "$requirements_converged" != "true" ]]; then
         warning "Requirements not converged yet"
         echo "requirements"
@@ -40,7 +42,6 @@ architecture_conversation() {
     info "Starting architecture conversation for $session_id"
 
     # Load requirements for context
-    local requirements_file=$(get_context_value "$session_id" "requirements.file")
     local requirements_content=""
     if [[ -f "$requirements_file" ]]; then
         requirements_content=$(cat "$requirements_file")
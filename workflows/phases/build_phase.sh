@@ -28,16 +28,17 @@ build_phase() {
         return 1
     fi
 
-    # Check if architecture is converged
-    local architecture_converged=$(get_context_value "$session_id" "architecture.converged")
+    # Check if architecture is converged (both fields read in one call)
+    local architecture_converged tasks_file
+    IFS=$'\x1f' read -r -d '' architecture_converged tasks_file < <(
+        get_context_values "$session_id" architecture.converged architecture.tasks_file)
     if [[ "$architecture_converged" != "true" ]]; then
         warning "Architecture not converged yet"
         echo "architecture"
         return 0
     fi
 
-    # Get tasks file
-    local tasks_file=$(get_context_value "$session_id" "architecture.tasks_file")
+    # Check tasks file
     if [[ ! -f "$tasks_file" ]]; then
         error "tasks.json not found: $tasks_file"
         error "Run architecture phase first"
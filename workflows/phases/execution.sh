@@ -3,8 +3,10 @@
 #
 # execution.sh - Parallel builder execution phase
 #
-# Spawns CI sessions for each builder in git worktrees
-# Monitors progress and waits for completion
+# Runs a CI session for each builder in its git worktree and waits for
+# completion. With argo-dag-run installed the builders run as a task graph:
+# all at once (or ordered by an optional "depends_on"), waited on without
+# polling. Otherwise they are spawned in the background and polled.
 # Transitions from execution -> merge_build
 
 # Get script directory
@@ -18,7 +20,11 @@ source "$SCRIPT_DIR/../lib/config.sh"
 # CI tool command (reads from config with fallback to environment variable)
 readonly CI_TOOL="$(get_ci_tool)"
 
-# Poll interval for monitoring builders
+# Builder task runner and the native task graph engine
+readonly RUN_BUILDER="$SCRIPT_DIR/../tools/run_builder"
+readonly ARGO_DAG_RUN_BIN="${ARGO_DAG_RUN_BIN:-argo-dag-run}"
+
+# Poll interval for monitoring builders (fallback path)
 readonly MONITOR_INTERVAL=5
 
 #
@@ -26,33 +32,11 @@ readonly MONITOR_INTERVAL=5
 #
 spawn_builder() {
     local builder_id="$1"
-    local worktree="$2"
-    local description="$3"
 
     log_builder "$builder_id" "starting" "Spawning builder process"
 
-    # Build prompt for CI
-    local prompt="You are building the '$builder_id' component.
-
-Description: $description
-
-Your task:
-1. Implement the component according to the design
-2. Write tests
-3. Ensure all tests pass
-4. Update state when complete
-
-Work in the directory: $worktree
-Commit your changes when done."
-
-    # Spawn CI in background (simplified for Sprint 2)
-    # In full implementation, this would use proper CI session management
     if command -v "$CI_TOOL" >/dev/null 2>&1; then
-        (
-            cd "$worktree" 2>/dev/null || exit 1
-            "$CI_TOOL" "$prompt" >/dev/null 2>&1
-            echo $? > ".build_result"
-        ) &
+        "$RUN_BUILDER" "$builder_id" >/dev/null 2>&1 &
         local pid=$!
 
         echo "$pid"
@@ -62,6 +46,54 @@ Commit your changes when done."
     fi
 }
 
+#
+# run_builders_dag - Run all builders as a task graph with argo-dag-run
+#
+# Blocks until every builder has finished, then records each builder's
+# outcome (completed, failed, or skipped after a failed dependency).
+#
+# Returns:
+#   0 if every builder completed, 1 if any failed, 2 if the graph is invalid
+#
+run_builders_dag() {
+    local builder_count="$1"
+    local tasks_file=".argo-project/builders_tasks.json"
+    local status_file=".argo-project/builders_status.json"
+    local temp_file=".argo-project/state.json.tmp"
+
+    jq '{tasks: [.execution.builders[] | {id, name: .id, depends_on: (.depends_on // [])}]}' \
+       .argo-project/state.json > "$tasks_file" || return 2
+
+    jq --arg started "$(date -u +"%Y-%m-%dT%H:%M:%SZ")" \
+       '.execution.builders[] |= (.status = "running" | .started = $started)' \
+       .argo-project/state.json > "$temp_file" && mv "$temp_file" .argo-project/state.json
+
+    echo "Running $builder_count builders as a task graph..."
+    "$ARGO_DAG_RUN_BIN" --max-parallel "$builder_count" --runner "$RUN_BUILDER" \
+        --status "$status_file" "$tasks_file"
+    local rc=$?
+
+    if [[ -f "$status_file" ]]; then
+        jq --slurpfile run "$status_file" \
+           --arg completed "$(date -u +"%Y-%m-%dT%H:%M:%SZ")" \
+           '($run[0].nodes | map({key: .id, value: .}) | from_entries) as $nodes
+            | .execution.builders[] |= (if $nodes[.id] then
+                  (.status = $nodes[.id].state | .pid = ($nodes[.id].pid | tostring)
+                   | .completed = $completed
+                   | .progress = (if $nodes[.id].state == "completed" then 100 else .progress end))
+              else . end)' \
+           .argo-project/state.json > "$temp_file" && mv "$temp_file" .argo-project/state.json
+
+        while read -r builder_id builder_state; do
+            echo "Builder $builder_id $builder_state"
+            log_builder "$builder_id" "$builder_state" "Process finished"
+        done < <(jq -r '.nodes[] | "\(.id) \(.state)"' "$status_file")
+    fi
+
+    rm -f "$tasks_file"
+    return $rc
+}
+
 #
 # check_builder_status - Check if builder is still running
 #
@@ -80,60 +112,22 @@ check_builder_status() {
 }
 
 #
-# Main function
+# run_builders_polled - Spawn every builder in the background and poll them
 #
-main() {
-    local project_path="$1"
-
-    # Validate argument
-    if [[ -z "$project_path" ]]; then
-        echo "ERROR: Project path required" >&2
-        return 1
-    fi
-
-    # Validate project directory
-    if [[ ! -d "$project_path/.argo-project" ]]; then
-        echo "ERROR: .argo-project not found in $project_path" >&2
-        return 1
-    fi
-
-    cd "$project_path" || {
-        echo "ERROR: Failed to change to project directory" >&2
-        return 1
-    }
-
-    echo "=== execution phase ==="
-
-    # Read builders from state
-    local execution=$(jq -r '.execution' .argo-project/state.json 2>/dev/null)
-    if [[ -z "$execution" ]] || [[ "$execution" == "null" ]]; then
-        echo "ERROR: No execution in state" >&2
-        return 1
-    fi
-
-    local builders=$(echo "$execution" | jq -r '.builders')
-    local builder_count=$(echo "$builders" | jq 'length')
-
-    if [[ $builder_count -eq 0 ]]; then
-        echo "No builders to execute, transitioning to merge..."
-        update_state "phase" "merge_build"
-        return 0
-    fi
+run_builders_polled() {
+    local builder_count="$1"
+    local temp_file=".argo-project/state.json.tmp"
 
     echo "Spawning $builder_count builders..."
 
     # Spawn all builders
     local pids=()
     for ((i=0; i<builder_count; i++)); do
-        local builder=$(echo "$builders" | jq -r ".[$i]")
-        local builder_id=$(echo "$builder" | jq -r '.id')
-        local worktree=$(echo "$builder" | jq -r '.worktree')
-        local description=$(echo "$builder" | jq -r '.description')
+        local builder_id=$(jq -r ".execution.builders[$i].id" .argo-project/state.json)
 
         echo "Spawning builder: $builder_id"
 
         # Update status to running
-        local temp_file=".argo-project/state.json.tmp"
         jq --arg id "$builder_id" \
            --arg status "running" \
            --arg started "$(date -u +"%Y-%m-%dT%H:%M:%SZ")" \
@@ -141,7 +135,7 @@ main() {
            .argo-project/state.json > "$temp_file" && mv "$temp_file" .argo-project/state.json
 
         # Spawn builder
-        local pid=$(spawn_builder "$builder_id" "$worktree" "$description")
+        local pid=$(spawn_builder "$builder_id")
         if [[ -n "$pid" ]]; then
             pids+=("$pid")
 
@@ -188,6 +182,59 @@ main() {
             fi
         done
     done
+}
+
+#
+# Main function
+#
+main() {
+    local project_path="$1"
+
+    # Validate argument
+    if [[ -z "$project_path" ]]; then
+        echo "ERROR: Project path required" >&2
+        return 1
+    fi
+
+    # Validate project directory
+    if [[ ! -d "$project_path/.argo-project" ]]; then
+        echo "ERROR: .argo-project not found in $project_path" >&2
+        return 1
+    fi
+
+    cd "$project_path" || {
+        echo "ERROR: Failed to change to project directory" >&2
+        return 1
+    }
+
+    echo "=== execution phase ==="
+
+    # Read builders from state
+    local execution=$(jq -r '.execution' .argo-project/state.json 2>/dev/null)
+    if [[ -z "$execution" ]] || [[ "$execution" == "null" ]]; then
+        echo "ERROR: No execution in state" >&2
+        return 1
+    fi
+
+    local builders=$(echo "$execution" | jq -r '.builders')
+    local builder_count=$(echo "$builders" | jq 'length')
+
+    if [[ $builder_count -eq 0 ]]; then
+        echo "No builders to execute, transitioning to merge..."
+        update_state "phase" "merge_build"
+        return 0
+    fi
+
+    if command -v "$ARGO_DAG_RUN_BIN" >/dev/null 2>&1; then
+        run_builders_dag "$builder_count"
+        case $? in
+            0) ;;
+            1) echo "WARNING: Some builders failed (see .execution.builders)" >&2 ;;
+            *) echo "ERROR: Builders could not be run as a task graph" >&2; return 1 ;;
+        esac
+    else
+        run_builders_polled "$builder_count"
+    fi
 
     echo "All builders complete!"
 
@@ -70,13 +70,11 @@ load_session_context() {
         if [[ -n "$SESSION_ID" ]] && session_exists "$SESSION_ID"; then
             info "Loading session: $(label $SESSION_ID)"
 
-            # Load context
-            PROJECT_TYPE=$(get_context_field "$SESSION_ID" "project_type")
-            PROJECT_DIR=$(get_context_field "$SESSION_ID" "project_dir")
-            PROGRAM_NAME=$(get_context_field "$SESSION_ID" "project_name")
-            IS_GIT_REPO=$(get_context_field "$SESSION_ID" "is_git_repo")
-            IS_GITHUB_PROJECT=$(get_context_field "$SESSION_ID" "is_github_project")
-            MAIN_BRANCH=$(get_context_field "$SESSION_ID" "main_branch")
+            # Load context (one jq call)
+            IFS=$'\x1f' read -r -d '' PROJECT_TYPE PROJECT_DIR PROGRAM_NAME IS_GIT_REPO \
+                IS_GITHUB_PROJECT MAIN_BRANCH < <(
+                get_context_fields "$SESSION_ID" project_type project_dir project_name \
+                    is_git_repo is_github_project main_branch)
 
             success "Session loaded"
             list_item "Project type:" "$(label $PROJECT_TYPE)"
@@ -145,9 +143,10 @@ load_design() {
 
     success "Loading design: $(path $PROGRAM_NAME)"
 
-    # Parse design.json
-    LANGUAGE=$(jq -r '.language' "$DESIGN_DIR/design.json")
-    PURPOSE=$(jq -r '.purpose' "$DESIGN_DIR/design.json")
+    # Parse design.json (one jq call)
+    IFS=$'\x1f' read -r -d '' LANGUAGE PURPOSE < <(
+        jq -j '[.language, .purpose] | map(if type == "string" then . else tojson end) | join("\u001f")' \
+           "$DESIGN_DIR/design.json")
 
     # Auto-detect language if set to "auto"
     if [[ "$LANGUAGE" == "auto" ]]; then
@@ -321,12 +320,13 @@ spawn_builders() {
         fi
     fi
 
-    # Spawn each builder
-    local task_count=$(echo "$TASK_DECOMPOSITION" | jq '. | length')
-    for i in $(seq 0 $((task_count - 1))); do
-        local task=$(echo "$TASK_DECOMPOSITION" | jq -r ".[$i]")
-        local builder_id=$(echo "$task" | jq -r '.task_id')
-        local description=$(echo "$task" | jq -r '.description')
+    # Spawn each builder (task ids and descriptions read with one jq call)
+    local -a task_lines
+    mapfile -t task_lines < <(echo "$TASK_DECOMPOSITION" |
+        jq -r '.[] | "\(.task_id)\u001f\(.description | tostring | gsub("\n"; " "))"')
+    local task_line builder_id description
+    for task_line in "${task_lines[@]}"; do
+        IFS=$'\x1f' read -r builder_id description <<< "$task_line"
         local builder_branch="$FEATURE_BRANCH/$builder_id"
 
         # Create builder branch if git repo
@@ -359,12 +359,13 @@ monitor_builders() {
         # Display current status
         for builder_id in "${BUILDER_IDS[@]}"; do
             if [[ -n "${BUILDER_PIDS[$builder_id]}" ]]; then
-                local status=$(get_builder_status "$SESSION_ID" "$builder_id" 2>/dev/null || echo "unknown")
                 local state_file=$(get_session_dir "$SESSION_ID")/builders/$builder_id.json
 
                 if [[ -f "$state_file" ]]; then
-                    local passed=$(jq -r '.tests_passed_count' "$state_file")
-                    local failed=$(jq -r '.tests_failed_count' "$state_file")
+                    local status passed failed
+                    read -r status passed failed < <(
+                        jq -r '"\(.status) \(.tests_passed_count) \(.tests_failed_count)"' "$state_file" 2>/dev/null)
+                    status="${status:-unknown}"
                     echo -e "  $(label $builder_id): $status (${GREEN}$passed passed${NC}, ${RED}$failed failed${NC})"
                 fi
             fi
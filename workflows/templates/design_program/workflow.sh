@@ -43,11 +43,9 @@ load_session_context() {
         if [[ -n "$SESSION_ID" ]] && session_exists "$SESSION_ID"; then
             info "Loading session: $(label $SESSION_ID)"
 
-            # Load context
-            PROJECT_TYPE=$(get_context_field "$SESSION_ID" "project_type")
-            PROJECT_DIR=$(get_context_field "$SESSION_ID" "project_dir")
-            PROGRAM_NAME=$(get_context_field "$SESSION_ID" "project_name")
-            IS_GIT_REPO=$(get_context_field "$SESSION_ID" "is_git_repo")
+            # Load context (one jq call)
+            IFS=$'\x1f' read -r -d '' PROJECT_TYPE PROJECT_DIR PROGRAM_NAME IS_GIT_REPO < <(
+                get_context_fields "$SESSION_ID" project_type project_dir project_name is_git_repo)
 
             success "Session loaded"
             list_item "Project type:" "$(label $PROJECT_TYPE)"
@@ -192,13 +190,11 @@ load_existing_design() {
 
 # Modify existing design
 modify_existing_design() {
-    # Load existing values from design.json
-    PURPOSE=$(jq -r '.purpose' "$DESIGN_DIR/design.json")
-    USERS=$(jq -r '.users' "$DESIGN_DIR/design.json")
-    LANGUAGE=$(jq -r '.language' "$DESIGN_DIR/design.json")
-    FEATURES=$(jq -r '.features | join(", ")' "$DESIGN_DIR/design.json")
-    SUCCESS_CRITERIA=$(jq -r '.success_criteria' "$DESIGN_DIR/design.json")
-    CONSTRAINTS=$(jq -r '.constraints' "$DESIGN_DIR/design.json")
+    # Load existing values from design.json (one jq call, $'\x1f'-separated)
+    IFS=$'\x1f' read -r -d '' PURPOSE USERS LANGUAGE FEATURES SUCCESS_CRITERIA CONSTRAINTS < <(
+        jq -j '[.purpose, .users, .language, (.features // [] | join(", ")), .success_criteria, .constraints]
+               | map(if type == "string" then . else tojson end) | join("\u001f")' \
+           "$DESIGN_DIR/design.json")
 
     log_phase "Modify Design"
     info "Current values shown in ${GRAY}gray${NC}. Press Enter to keep, or type new value."
@@ -555,25 +551,36 @@ finalize_design() {
         build_location="$PROJECT_DIR"
     fi
 
-    # Create design.json (structured for build_program)
-    cat > "$DESIGN_DIR/design.json" <<EOF
-{
-  "program_name": "$PROGRAM_NAME",
-  "purpose": $(printf '%s' "$PURPOSE" | jq -Rs .),
-  "language": "$LANGUAGE",
-  "users": $(printf '%s' "$USERS" | jq -Rs .),
-  "features": $(echo "$FEATURES" | jq -Rc 'split(",") | map(gsub("^\\s+|\\s+$";""))'),
-  "success_criteria": $(printf '%s' "$SUCCESS_CRITERIA" | jq -Rs .),
-  "constraints": $(printf '%s' "$CONSTRAINTS" | jq -Rs .),
-  "design_complete": true,
-  "test_suite_generated": $has_test_suite,
-  "test_suite_location": $(printf '%s' "$test_suite_location" | jq -Rs .),
-  "project_type": $(printf '%s' "$PROJECT_TYPE" | jq -Rs .),
-  "session_id": $(printf '%s' "$SESSION_ID" | jq -Rs .),
-  "created": "$(date -u +"%Y-%m-%dT%H:%M:%SZ")",
-  "build_location": $(printf '%s' "$build_location" | jq -Rs .)
-}
-EOF
+    # Create design.json (structured for build_program) with one jq call
+    jq -n --arg program_name "$PROGRAM_NAME" \
+          --arg purpose "$PURPOSE" \
+          --arg language "$LANGUAGE" \
+          --arg users "$USERS" \
+          --arg features "$FEATURES" \
+          --arg success_criteria "$SUCCESS_CRITERIA" \
+          --arg constraints "$CONSTRAINTS" \
+          --argjson test_suite_generated "$has_test_suite" \
+          --arg test_suite_location "$test_suite_location" \
+          --arg project_type "$PROJECT_TYPE" \
+          --arg session_id "$SESSION_ID" \
+          --arg created "$(date -u +"%Y-%m-%dT%H:%M:%SZ")" \
+          --arg build_location "$build_location" \
+       '{
+          program_name: $program_name,
+          purpose: $purpose,
+          language: $language,
+          users: $users,
+          features: ($features | split(",") | map(gsub("^\\s+|\\s+$"; ""))),
+          success_criteria: $success_criteria,
+          constraints: $constraints,
+          design_complete: true,
+          test_suite_generated: $test_suite_generated,
+          test_suite_location: $test_suite_location,
+          project_type: $project_type,
+          session_id: $session_id,
+          created: $created,
+          build_location: $build_location
+        }' > "$DESIGN_DIR/design.json"
 
     # Update session context if available
     if [[ -n "$SESSION_ID" ]] && session_exists "$SESSION_ID"; then